@@ -10,8 +10,20 @@
 //
 //  Imports.
 //
+#include <xap/core/json/arena.h>
+#include <xap/core/json/bind.h>
 #include <xap/core/json/build.h>
+#include <xap/core/json/document_pool.h>
 #include <xap/core/json/error.h>
+#include <xap/core/json/extract.h>
+#include <xap/core/json/key_table.h>
+#include <xap/core/json/lines_reader.h>
+#include <xap/core/json/parser.h>
+#include <xap/core/json/pointer.h>
+#include <xap/core/json/schema.h>
+#include <xap/core/json/status.h>
+#include <xap/core/json/stream_parser.h>
+#include <xap/core/json/string_view.h>
 #include <xap/core/json/traverse.h>
 #include <xap/core/json/version.h>
 
@@ -0,0 +1,159 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+#ifndef XAP_CORE_JSON_ARENA_H__
+#define XAP_CORE_JSON_ARENA_H__
+
+//
+//  Imports.
+//
+#include <memory>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <xap/core/json/build.h>
+
+namespace xap{
+namespace core {
+namespace json {
+
+//
+//  Declare.
+//
+class ArenaPrivate;
+class LinesReader;
+class Parser;
+class StreamParser;
+
+//
+//  Classes.
+//
+
+/**
+ *  Arena (monotonic allocator).
+ *
+ *  @note
+ *      Memory is handed out from large blocks and is never released one by
+ *      one. All blocks are released at once when the arena is no longer
+ *      used, that is, when the last of the following is destructed:
+ *
+ *          - The arena object (and its copies).
+ *          - The parsers that use the arena.
+ *          - The documents parsed with the arena, and every traverse object
+ *            derived from them.
+ *
+ *      So it is always safe to destruct the arena object before the traverse
+ *      objects that use it.
+ *
+ *      Copies of an arena object share the same memory. The arena is
+ *      thread-safe: each thread allocates from a chunk of its own without
+ *      locking, and the arena is only locked when a thread needs another
+ *      chunk. Switching between arenas on one thread takes the lock, so it
+ *      is still best used by one request (or one thread) at a time.
+ */
+class Arena {
+
+public:
+
+    /**
+     *  Construct the object.
+     *
+     *  @param block_size
+     *      The size of each memory block.
+     */
+    explicit Arena(const size_t block_size = 65536U);
+
+    /**
+     *  Construct (Copy) the object.
+     *
+     *  @note
+     *      The copy shares the memory with the source.
+     *  @param src
+     *      The source.
+     */
+    Arena(const Arena &src);
+
+    /**
+     *  Destruct the object.
+     */
+    virtual ~Arena() noexcept;
+
+    //
+    //  Operators.
+    //
+
+    /**
+     *  Assign (Copy) the object.
+     *
+     *  @note
+     *      The object shares the memory with the source.
+     *  @param src
+     *      The source.
+     *  @return
+     *      Self.
+     */
+    xap::core::json::Arena &operator=(const Arena &src);
+
+    //
+    //  Public methods.
+    //
+
+    /**
+     *  Allocate memory.
+     *
+     *  @throw std::bad_alloc
+     *      Raised if memory allocation was failed.
+     *  @param size
+     *      The size.
+     *  @param alignment
+     *      The alignment (must be a power of 2).
+     *  @return
+     *      The memory (owned by the arena).
+     */
+    void *allocate(
+        const size_t size,
+        const size_t alignment = alignof(max_align_t)
+    );
+
+    /**
+     *  Get the size of allocated memory.
+     *
+     *  @note
+     *      The memory allocated by other threads is counted once they switch
+     *      to another chunk (or exit).
+     *  @return
+     *      The size.
+     */
+    size_t get_allocated_size() const noexcept;
+
+    /**
+     *  Get the size of memory blocks reserved by the arena.
+     *
+     *  @return
+     *      The size.
+     */
+    size_t get_reserved_size() const noexcept;
+
+private:
+
+    //
+    //  Friend classes.
+    //
+    friend class LinesReader;
+    friend class Parser;
+    friend class StreamParser;
+
+    //
+    //  Members.
+    //
+    std::shared_ptr<ArenaPrivate> m_arena;
+};
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
+
+#endif  //  #ifndef XAP_CORE_JSON_ARENA_H__
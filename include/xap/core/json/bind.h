@@ -0,0 +1,464 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+#ifndef XAP_CORE_JSON_BIND_H__
+#define XAP_CORE_JSON_BIND_H__
+
+//
+//  Imports.
+//
+#include <memory>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <xap/core/json/build.h>
+#include <xap/core/json/status.h>
+#include <xap/core/json/traverse.h>
+
+//
+//  Macros.
+//
+
+/**
+ *  Bind the members of a structure to the members of JSON objects.
+ *
+ *  @note
+ *      Use the macro in the namespace of the structure (the fields are found
+ *      by argument-dependent lookup), e.g.:
+ *
+ *          XAPCORE_JSON_BIND(
+ *              Device,
+ *              xap::core::json::bind_field("id", &Device::id),
+ *              xap::core::json::bind_field("name", &Device::name, false)
+ *          )
+ *
+ *  @param type
+ *      The structure.
+ *  @param ...
+ *      The fields (see xap::core::json::bind_field()).
+ */
+#define XAPCORE_JSON_BIND(type, ...)                                         \
+    inline auto xap_core_json_bind_fields(const type *) {                    \
+        return std::make_tuple(__VA_ARGS__);                                 \
+    }
+
+namespace xap{
+namespace core {
+namespace json {
+
+//
+//  Declare.
+//
+class BindTablePrivate;
+class TraversePrivate;
+
+//
+//  Structures.
+//
+
+/**
+ *  Field of a bound structure (see bind_field()).
+ */
+template <typename T, typename M>
+struct BindField {
+    //  Key (a static string).
+    const char *key;
+
+    //  Member.
+    M T::*member;
+
+    //  Whether the member must exist (and must not be null).
+    bool required;
+};
+
+//
+//  Classes.
+//
+
+/**
+ *  Binding table of a structure (built once by get_bind_table()).
+ *
+ *  @note
+ *      Binding scans the members of an object once. Each member is
+ *      dispatched by its key (through a hash table) to its field, and its
+ *      value is checked and written into the structure directly, without
+ *      creating traverse objects. Members without a field are skipped, and
+ *      fields without a member are left unchanged.
+ *
+ *      A member of a struct type is bound by the table of its type, so
+ *      structures that contain themselves can't be bound.
+ */
+class BindTable {
+
+public:
+
+    //
+    //  Public types.
+    //
+    enum Kind: uint8_t {
+        int_value,
+        uint_value,
+        int64_value,
+        uint64_value,
+        float_value,
+        double_value,
+        boolean_value,
+        string_value,
+        struct_value
+    };
+
+    /**
+     *  Entry of a field.
+     */
+    struct Entry {
+        //  Key and its length.
+        const char *key;
+        size_t key_length;
+
+        //  Kind of the member.
+        Kind kind;
+
+        //  Whether the member must exist (and must not be null).
+        bool required;
+
+        //  Table of the member (only for struct_value).
+        const BindTable *nested;
+
+        //  Get the address of the member within a structure.
+        void *(*locate)(const void *field, void *object);
+
+        //  The field (passed to locate()).
+        const void *field;
+    };
+
+    /**
+     *  Construct the object.
+     *
+     *  @throw xap::core::json::Exception
+     *      Raised if a key is duplicated (ERROR_PARAMETER).
+     *  @param entries
+     *      The entries of the fields.
+     */
+    explicit BindTable(const std::vector<Entry> &entries);
+
+    /**
+     *  Destruct the object.
+     */
+    virtual ~BindTable() noexcept;
+
+    //
+    //  Public methods.
+    //
+
+    /**
+     *  Bind a structure to a JSON object.
+     *
+     *  @throw xap::core::json::Exception
+     *      Raised in the following situations (the path of the error is the
+     *      path of the first value that failed):
+     *
+     *          - xap::core::json::ERROR_TYPE:
+     *              The object is null or is not an object.
+     *
+     *          - xap::core::json::ERROR_TYPE:
+     *              A member is null (but required) or doesn't fit the type
+     *              of its field (the same way as Traverse::inner_as_int()
+     *              and the like).
+     *
+     *          - xap::core::json::ERROR_NOTFIND:
+     *              A required member is not existed.
+     *
+     *  @param root
+     *      The JSON object.
+     *  @param object
+     *      The structure (partially written if failed).
+     */
+    void bind(xap::core::json::Traverse &root, void *object) const;
+
+    /**
+     *  Bind a structure to a JSON object (without throwing).
+     *
+     *  @param root
+     *      The JSON object.
+     *  @param object
+     *      The structure (partially written if failed).
+     *  @param status
+     *      The status to receive the error (nullptr if not needed).
+     *  @return
+     *      False in the situations that BindTable::bind() throws.
+     */
+    bool try_bind(
+        xap::core::json::Traverse &root,
+        void *object,
+        xap::core::json::Status *status
+    ) const;
+
+private:
+
+    //
+    //  Friend classes.
+    //
+    friend class TraversePrivate;
+
+    //
+    //  Members.
+    //
+    std::unique_ptr<xap::core::json::BindTablePrivate> m_table;
+
+    //
+    //  Private constructor.
+    //
+    BindTable(const BindTable &) = delete;
+    BindTable &operator=(const BindTable &) = delete;
+};
+
+//
+//  Functions.
+//
+
+template <typename T>
+const xap::core::json::BindTable &get_bind_table();
+
+/**
+ *  Traits of the type of a member (struct types).
+ */
+template <typename M>
+struct BindTraits {
+    static constexpr xap::core::json::BindTable::Kind KIND =
+        xap::core::json::BindTable::Kind::struct_value;
+    static const xap::core::json::BindTable *get_nested() {
+        return &(xap::core::json::get_bind_table<M>());
+    }
+};
+
+/**
+ *  Traits of the type of a member (scalar types).
+ */
+template <xap::core::json::BindTable::Kind K>
+struct BindScalarTraits {
+    static constexpr xap::core::json::BindTable::Kind KIND = K;
+    static const xap::core::json::BindTable *get_nested() {
+        return nullptr;
+    }
+};
+
+template <>
+struct BindTraits<int>: BindScalarTraits<
+    xap::core::json::BindTable::Kind::int_value
+> {};
+
+template <>
+struct BindTraits<unsigned int>: BindScalarTraits<
+    xap::core::json::BindTable::Kind::uint_value
+> {};
+
+#if defined(XAPCORE_JSON_INT64)
+
+template <>
+struct BindTraits<int64_t>: BindScalarTraits<
+    xap::core::json::BindTable::Kind::int64_value
+> {};
+
+template <>
+struct BindTraits<uint64_t>: BindScalarTraits<
+    xap::core::json::BindTable::Kind::uint64_value
+> {};
+
+#endif  //  #if defined(XAPCORE_JSON_INT64)
+
+template <>
+struct BindTraits<float>: BindScalarTraits<
+    xap::core::json::BindTable::Kind::float_value
+> {};
+
+template <>
+struct BindTraits<double>: BindScalarTraits<
+    xap::core::json::BindTable::Kind::double_value
+> {};
+
+template <>
+struct BindTraits<bool>: BindScalarTraits<
+    xap::core::json::BindTable::Kind::boolean_value
+> {};
+
+template <>
+struct BindTraits<std::string>: BindScalarTraits<
+    xap::core::json::BindTable::Kind::string_value
+> {};
+
+/**
+ *  Declare a field of a bound structure.
+ *
+ *  @param key
+ *      The key (a static string).
+ *  @param member
+ *      The member.
+ *  @param required
+ *      Whether the member must exist (and must not be null).
+ *  @return
+ *      The field.
+ */
+template <typename T, typename M>
+constexpr xap::core::json::BindField<T, M> bind_field(
+    const char *key,
+    M T::*member,
+    const bool required = true
+) {
+    return xap::core::json::BindField<T, M>{key, member, required};
+}
+
+/**
+ *  Get the address of a member within a structure.
+ *
+ *  @param field
+ *      The field (xap::core::json::BindField<T, M>).
+ *  @param object
+ *      The structure.
+ *  @return
+ *      The address.
+ */
+template <typename T, typename M>
+void *bind_locate(const void *field, void *object) {
+    M T::*member =
+        static_cast<const xap::core::json::BindField<T, M> *>(field)->member;
+    return &(static_cast<T *>(object)->*member);
+}
+
+/**
+ *  Make the entry of a field.
+ *
+ *  @param field
+ *      The field (must outlive the entry).
+ *  @return
+ *      The entry.
+ */
+template <typename T, typename M>
+xap::core::json::BindTable::Entry make_bind_entry(
+    const xap::core::json::BindField<T, M> &field
+) {
+    xap::core::json::BindTable::Entry entry;
+    entry.key = field.key;
+    entry.key_length = strlen(field.key);
+    entry.kind = xap::core::json::BindTraits<M>::KIND;
+    entry.required = field.required;
+    entry.nested = xap::core::json::BindTraits<M>::get_nested();
+    entry.locate = &(xap::core::json::bind_locate<T, M>);
+    entry.field = &field;
+    return entry;
+}
+
+/**
+ *  Make the entries of fields.
+ *
+ *  @param fields
+ *      The fields (a tuple, must outlive the entries).
+ *  @return
+ *      The entries.
+ */
+template <typename Fields, size_t... I>
+std::vector<xap::core::json::BindTable::Entry> make_bind_entries(
+    const Fields &fields,
+    std::index_sequence<I...>
+) {
+    return std::vector<xap::core::json::BindTable::Entry>{
+        xap::core::json::make_bind_entry(std::get<I>(fields))...
+    };
+}
+
+/**
+ *  Get the binding table of a structure (built on first use, see
+ *  XAPCORE_JSON_BIND()).
+ *
+ *  @throw xap::core::json::Exception
+ *      Raised if a key is duplicated (ERROR_PARAMETER).
+ *  @return
+ *      The table.
+ */
+template <typename T>
+const xap::core::json::BindTable &get_bind_table() {
+    static const auto fields =
+        xap_core_json_bind_fields(static_cast<const T *>(nullptr));
+    static const xap::core::json::BindTable table(
+        xap::core::json::make_bind_entries(
+            fields,
+            std::make_index_sequence<
+                std::tuple_size<
+                    typename std::decay<decltype(fields)>::type
+                >::value
+            >()
+        )
+    );
+    return table;
+}
+
+/**
+ *  Bind a structure to a JSON object.
+ *
+ *  @throw xap::core::json::Exception
+ *      Raised in the situations that BindTable::bind() throws.
+ *  @param root
+ *      The JSON object.
+ *  @param object
+ *      The structure (partially written if failed).
+ */
+template <typename T>
+void bind(xap::core::json::Traverse &root, T *object) {
+    xap::core::json::get_bind_table<T>().bind(root, object);
+}
+
+/**
+ *  Bind a structure (constructed by default) to a JSON object.
+ *
+ *  @throw xap::core::json::Exception
+ *      Raised in the situations that BindTable::bind() throws.
+ *  @param root
+ *      The JSON object.
+ *  @return
+ *      The structure.
+ */
+template <typename T>
+T bind(xap::core::json::Traverse &root) {
+    T object;
+    xap::core::json::get_bind_table<T>().bind(root, &object);
+    return object;
+}
+
+/**
+ *  Bind a structure to a JSON object (without throwing).
+ *
+ *  @param root
+ *      The JSON object.
+ *  @param object
+ *      The structure (partially written if failed).
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
+ *  @return
+ *      False in the situations that BindTable::bind() throws.
+ */
+template <typename T>
+bool try_bind(
+    xap::core::json::Traverse &root,
+    T *object,
+    xap::core::json::Status *status = nullptr
+) {
+    return xap::core::json::get_bind_table<T>().try_bind(
+        root,
+        object,
+        status
+    );
+}
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
+
+#endif  //  #ifndef XAP_CORE_JSON_BIND_H__
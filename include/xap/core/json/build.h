@@ -21,4 +21,9 @@
 # define XAPCORE_JSON_INT64
 #endif  //  #if defined(INT64_MAX)
 
+//  std::string_view check (C++17).
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+# define XAPCORE_JSON_STRING_VIEW
+#endif  //  #if __cplusplus >= 201703L || ...
+
 #endif  //  #ifndef XAP_CORE_JSON_BUILD_H__
@@ -0,0 +1,234 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+#ifndef XAP_CORE_JSON_DOCUMENT_POOL_H__
+#define XAP_CORE_JSON_DOCUMENT_POOL_H__
+
+//
+//  Imports.
+//
+#include <memory>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string>
+#include <xap/core/json/build.h>
+#include <xap/core/json/key_table.h>
+#include <xap/core/json/parser.h>
+#include <xap/core/json/traverse.h>
+
+namespace xap{
+namespace core {
+namespace json {
+
+//
+//  Declare.
+//
+class DocumentPoolPrivate;
+
+//
+//  Classes.
+//
+
+/**
+ *  Document pool (a parser whose documents recycle their memory).
+ *
+ *  @note
+ *      Each document is parsed into an arena of the pool. When the document
+ *      and every traverse object derived from it are released (on any
+ *      thread), the arena is rewound instead of being freed and is reused by
+ *      a document parsed afterwards. So the tapes, the strings and the
+ *      traverse objects (including their paths) of a document cost no heap
+ *      allocation once the pool has warmed up, as long as documents are
+ *      released as fast as they are parsed.
+ *
+ *      An arena that has grown to several blocks is merged into one block
+ *      when it is rewound, and the blocks of an arena that has grown beyond
+ *      the retained size are released.
+ *
+ *      With the jsoncpp backend, the contents of Json::Value trees are still
+ *      allocated from the heap (only the documents and the traverse objects
+ *      are recycled), use the native (or lazy) backend to get the most out
+ *      of a pool.
+ *
+ *      Like a parser, a pool is not thread-safe. Use one pool per thread
+ *      (the documents can still be released on other threads).
+ */
+class DocumentPool {
+
+public:
+
+    /**
+     *  Construct the object (with the default backend).
+     */
+    DocumentPool();
+
+    /**
+     *  Construct the object.
+     *
+     *  @param backend
+     *      The backend.
+     *  @param block_size
+     *      The size of the first memory block of each arena.
+     */
+    explicit DocumentPool(
+        const xap::core::json::Backend backend,
+        const size_t block_size = 65536U
+    );
+
+    /**
+     *  Destruct the object.
+     *
+     *  @note
+     *      The arenas of the documents that are still used are released
+     *      with the documents.
+     */
+    virtual ~DocumentPool() noexcept;
+
+    //
+    //  Public methods.
+    //
+
+    /**
+     *  Parse a JSON document (into a recycled arena).
+     *
+     *  @throw xap::core::json::Exception
+     *      Raised if JSON parsing was failed (ERROR_PARAMETER).
+     *  @param data
+     *      The JSON data.
+     *  @param datalen
+     *      The length of JSON data.
+     *  @param path
+     *      The path.
+     *  @return
+     *      Traverse object of the root.
+     */
+    xap::core::json::Traverse parse(
+        const uint8_t *data,
+        const size_t datalen,
+        const std::string &path = "/"
+    );
+
+    /**
+     *  Parse a JSON document (into a recycled arena).
+     *
+     *  @throw xap::core::json::Exception
+     *      Raised if JSON parsing was failed (ERROR_PARAMETER).
+     *  @param data
+     *      The JSON data.
+     *  @param datalen
+     *      The length of JSON data.
+     *  @param path
+     *      The path.
+     *  @return
+     *      Traverse object of the root.
+     */
+    xap::core::json::Traverse parse(
+        const char *data,
+        const size_t datalen,
+        const std::string &path = "/"
+    );
+
+    /**
+     *  Parse a JSON document (into a recycled arena).
+     *
+     *  @throw xap::core::json::Exception
+     *      Raised if JSON parsing was failed (ERROR_PARAMETER).
+     *  @param json_string
+     *      The JSON string.
+     *  @param path
+     *      The path.
+     *  @return
+     *      Traverse object of the root.
+     */
+    xap::core::json::Traverse parse(
+        const std::string &json_string,
+        const std::string &path = "/"
+    );
+
+    /**
+     *  Set the largest size of memory blocks that an arena keeps when it is
+     *  rewound.
+     *
+     *  @param size
+     *      The size (16 MiB by default).
+     */
+    void set_retained_size(const size_t size) noexcept;
+
+    /**
+     *  Get the largest size of memory blocks that an arena keeps when it is
+     *  rewound.
+     *
+     *  @return
+     *      The size.
+     */
+    size_t get_retained_size() const noexcept;
+
+    /**
+     *  Set whether the input is validated as UTF-8.
+     *
+     *  @note
+     *      See xap::core::json::Parser::set_utf8_validation().
+     *  @param validate
+     *      True if so.
+     */
+    void set_utf8_validation(const bool validate) noexcept;
+
+    /**
+     *  Set the key table of documents parsed afterwards.
+     *
+     *  @note
+     *      See xap::core::json::Parser::set_key_table().
+     *  @param keys
+     *      The key table (nullptr to not intern the keys, which is the
+     *      default).
+     */
+    void set_key_table(const xap::core::json::KeyTable *keys) noexcept;
+
+    /**
+     *  Get the count of arenas (documents that are used, and the ones that
+     *  can be recycled).
+     *
+     *  @return
+     *      The count.
+     */
+    size_t get_arena_count() const noexcept;
+
+    /**
+     *  Get the count of arenas that can be recycled (whose documents were
+     *  released).
+     *
+     *  @return
+     *      The count.
+     */
+    size_t get_idle_count() const noexcept;
+
+    /**
+     *  Get the size of memory blocks reserved by all arenas.
+     *
+     *  @return
+     *      The size.
+     */
+    size_t get_reserved_size() const noexcept;
+
+private:
+
+    //
+    //  Private constructor.
+    //
+    DocumentPool(const DocumentPool &) = delete;
+    DocumentPool &operator=(const DocumentPool &) = delete;
+
+    //
+    //  Members.
+    //
+    std::unique_ptr<DocumentPoolPrivate> m_pool;
+};
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
+
+#endif  //  #ifndef XAP_CORE_JSON_DOCUMENT_POOL_H__
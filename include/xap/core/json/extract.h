@@ -0,0 +1,221 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+#ifndef XAP_CORE_JSON_EXTRACT_H__
+#define XAP_CORE_JSON_EXTRACT_H__
+
+//
+//  Imports.
+//
+#include <stdint.h>
+#include <stdlib.h>
+#include <string>
+#include <xap/core/json/bind.h>
+#include <xap/core/json/build.h>
+
+namespace xap{
+namespace core {
+namespace json {
+
+//
+//  Classes.
+//
+
+/**
+ *  Field to be extracted from a JSON object (see Traverse::extract()).
+ *
+ *  @note
+ *      The expected type of the member is given by the type of the
+ *      destination. The key (a static string or a string that outlives the
+ *      extraction) and the destination are not copied.
+ */
+class ExtractField {
+
+public:
+
+    /**
+     *  Construct the object.
+     *
+     *  @param key
+     *      The key of the member.
+     *  @param destination
+     *      The destination (the member must be an integer that fits in int).
+     *  @param required
+     *      Whether the member must exist (and must not be null).
+     */
+    ExtractField(
+        const char *key,
+        int *destination,
+        const bool required = true
+    ) noexcept;
+
+    /**
+     *  Construct the object.
+     *
+     *  @param key
+     *      The key of the member.
+     *  @param destination
+     *      The destination (the member must be an integer that fits in
+     *      uint).
+     *  @param required
+     *      Whether the member must exist (and must not be null).
+     */
+    ExtractField(
+        const char *key,
+        uint *destination,
+        const bool required = true
+    ) noexcept;
+
+#if defined(XAPCORE_JSON_INT64)
+
+    /**
+     *  Construct the object.
+     *
+     *  @param key
+     *      The key of the member.
+     *  @param destination
+     *      The destination (the member must be an integer that fits in
+     *      int64_t).
+     *  @param required
+     *      Whether the member must exist (and must not be null).
+     */
+    ExtractField(
+        const char *key,
+        int64_t *destination,
+        const bool required = true
+    ) noexcept;
+
+    /**
+     *  Construct the object.
+     *
+     *  @param key
+     *      The key of the member.
+     *  @param destination
+     *      The destination (the member must be an integer that fits in
+     *      uint64_t).
+     *  @param required
+     *      Whether the member must exist (and must not be null).
+     */
+    ExtractField(
+        const char *key,
+        uint64_t *destination,
+        const bool required = true
+    ) noexcept;
+
+#endif  //  #if defined(XAPCORE_JSON_INT64)
+
+    /**
+     *  Construct the object.
+     *
+     *  @param key
+     *      The key of the member.
+     *  @param destination
+     *      The destination (the member must be numeric).
+     *  @param required
+     *      Whether the member must exist (and must not be null).
+     */
+    ExtractField(
+        const char *key,
+        float *destination,
+        const bool required = true
+    ) noexcept;
+
+    /**
+     *  Construct the object.
+     *
+     *  @param key
+     *      The key of the member.
+     *  @param destination
+     *      The destination (the member must be numeric).
+     *  @param required
+     *      Whether the member must exist (and must not be null).
+     */
+    ExtractField(
+        const char *key,
+        double *destination,
+        const bool required = true
+    ) noexcept;
+
+    /**
+     *  Construct the object.
+     *
+     *  @param key
+     *      The key of the member.
+     *  @param destination
+     *      The destination (the member must be boolean).
+     *  @param required
+     *      Whether the member must exist (and must not be null).
+     */
+    ExtractField(
+        const char *key,
+        bool *destination,
+        const bool required = true
+    ) noexcept;
+
+    /**
+     *  Construct the object.
+     *
+     *  @param key
+     *      The key of the member.
+     *  @param destination
+     *      The destination (the member must be a string).
+     *  @param required
+     *      Whether the member must exist (and must not be null).
+     */
+    ExtractField(
+        const char *key,
+        std::string *destination,
+        const bool required = true
+    ) noexcept;
+
+    //
+    //  Public methods.
+    //
+
+    /**
+     *  Get the entry of the field.
+     *
+     *  @return
+     *      The entry.
+     */
+    const xap::core::json::BindTable::Entry &get_entry() const noexcept;
+
+private:
+
+    //
+    //  Private methods.
+    //
+
+    /**
+     *  Initialize the entry.
+     *
+     *  @param key
+     *      The key of the member.
+     *  @param kind
+     *      The kind of the destination.
+     *  @param destination
+     *      The destination.
+     *  @param required
+     *      Whether the member must exist (and must not be null).
+     */
+    void initialize(
+        const char *key,
+        const xap::core::json::BindTable::Kind kind,
+        void *destination,
+        const bool required
+    ) noexcept;
+
+    //
+    //  Members.
+    //
+    xap::core::json::BindTable::Entry m_entry;
+};
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
+
+#endif  //  #ifndef XAP_CORE_JSON_EXTRACT_H__
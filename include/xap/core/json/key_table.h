@@ -0,0 +1,168 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+#ifndef XAP_CORE_JSON_KEY_TABLE_H__
+#define XAP_CORE_JSON_KEY_TABLE_H__
+
+//
+//  Imports.
+//
+#include <memory>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <xap/core/json/build.h>
+
+namespace xap{
+namespace core {
+namespace json {
+
+//
+//  Declare.
+//
+class DocumentPool;
+class KeyTablePrivate;
+class LinesReader;
+class Parser;
+class StreamParser;
+
+//
+//  Classes.
+//
+
+/**
+ *  Key table (interned object keys shared by documents).
+ *
+ *  @note
+ *      Each distinct key is stored once in the table and gets an ID. The
+ *      native (and lazy) documents parsed with a key table tag each member
+ *      with the ID of its key, so an object member is looked up (e.g. by
+ *      sub()) by comparing IDs instead of comparing keys.
+ *
+ *      With the global table, the Json::Value trees made by copy-on-write
+ *      (e.g. object_set()) refer to the interned keys instead of copying
+ *      them into each member. The keys of a private table are not shared
+ *      this way, because the Json::Value trees may outlive the table.
+ *      Documents parsed by the jsoncpp backend own their keys anyway.
+ *
+ *      To keep a table from growing without bound (e.g. with inputs whose
+ *      keys are random), keys that are longer than 256 bytes, or that come
+ *      after the table is full, are not interned. Such keys are still
+ *      looked up correctly (by comparing keys).
+ *
+ *      The table (and its copies) stays alive while any document parsed
+ *      with it is used. It is thread-safe, and looking a key up takes no
+ *      lock.
+ */
+class KeyTable {
+
+public:
+
+    /**
+     *  Construct the object (an empty private table).
+     *
+     *  @param capacity
+     *      The largest count of keys.
+     */
+    explicit KeyTable(const size_t capacity = 65536U);
+
+    /**
+     *  Construct (Copy) the object.
+     *
+     *  @note
+     *      The copy shares the keys with the source.
+     *  @param src
+     *      The source.
+     */
+    KeyTable(const KeyTable &src);
+
+    /**
+     *  Destruct the object.
+     */
+    virtual ~KeyTable() noexcept;
+
+    //
+    //  Operators.
+    //
+
+    /**
+     *  Assign (Copy) the object.
+     *
+     *  @note
+     *      The object shares the keys with the source.
+     *  @param src
+     *      The source.
+     *  @return
+     *      Self.
+     */
+    xap::core::json::KeyTable &operator=(const KeyTable &src);
+
+    //
+    //  Public methods.
+    //
+
+    /**
+     *  Get the count of keys.
+     *
+     *  @return
+     *      The count.
+     */
+    size_t get_count() const noexcept;
+
+    /**
+     *  Get the largest count of keys.
+     *
+     *  @return
+     *      The count.
+     */
+    size_t get_capacity() const noexcept;
+
+    /**
+     *  Get whether the table is the global table.
+     *
+     *  @return
+     *      True if so.
+     */
+    bool is_global() const noexcept;
+
+    //
+    //  Public static functions.
+    //
+
+    /**
+     *  Get the global table (process-wide, never released).
+     *
+     *  @return
+     *      The table.
+     */
+    static xap::core::json::KeyTable get_global();
+
+private:
+
+    //
+    //  Private constructor.
+    //
+    explicit KeyTable(const std::shared_ptr<KeyTablePrivate> &table);
+
+    //
+    //  Friend classes.
+    //
+    friend class DocumentPool;
+    friend class LinesReader;
+    friend class Parser;
+    friend class StreamParser;
+
+    //
+    //  Members.
+    //
+    std::shared_ptr<KeyTablePrivate> m_table;
+};
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
+
+#endif  //  #ifndef XAP_CORE_JSON_KEY_TABLE_H__
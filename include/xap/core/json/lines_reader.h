@@ -0,0 +1,216 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+#ifndef XAP_CORE_JSON_LINES_READER_H__
+#define XAP_CORE_JSON_LINES_READER_H__
+
+//
+//  Imports.
+//
+#include <functional>
+#include <memory>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string>
+#include <xap/core/json/arena.h>
+#include <xap/core/json/build.h>
+#include <xap/core/json/parser.h>
+#include <xap/core/json/traverse.h>
+
+namespace xap{
+namespace core {
+namespace json {
+
+//
+//  Declare.
+//
+class LinesReaderPrivate;
+
+//
+//  Classes.
+//
+
+/**
+ *  JSON Lines (NDJSON) reader.
+ *
+ *  @note
+ *      The input is split into batches of whole lines (with memchr()), and
+ *      the batches are parsed by a number of worker threads (one parser per
+ *      worker). The records are handed to the handler in order (of lines),
+ *      on the calling thread, as soon as their batch is parsed, while the
+ *      workers parse the batches that follow.
+ *
+ *      Lines are separated by "\n" ("\r\n" is accepted). Empty (or
+ *      whitespace-only) lines are skipped. The path of each record is the
+ *      (zero-based) index of its line appended to the path of the input,
+ *      e.g. "/12".
+ *
+ *      A reader is not thread-safe, but the handler doesn't need to be
+ *      either (it is never called concurrently).
+ */
+class LinesReader {
+
+public:
+
+    /**
+     *  Construct the object (with the default backend and one worker per
+     *  CPU core).
+     */
+    LinesReader();
+
+    /**
+     *  Construct the object.
+     *
+     *  @param backend
+     *      The backend.
+     *  @param workers
+     *      The count of workers (0 for one worker per CPU core, 1 to parse
+     *      on the calling thread).
+     */
+    explicit LinesReader(
+        const xap::core::json::Backend backend,
+        const size_t workers = 0U
+    );
+
+    /**
+     *  Destruct the object.
+     */
+    virtual ~LinesReader() noexcept;
+
+    //
+    //  Public methods.
+    //
+
+    /**
+     *  Read JSON Lines.
+     *
+     *  @throw xap::core::json::Exception
+     *      Raised if JSON parsing of a record was failed (ERROR_PARAMETER,
+     *      with the path of the record). The records before it are handed
+     *      to the handler first. Exceptions thrown by the handler are
+     *      propagated (the remaining records are dropped).
+     *  @param data
+     *      The JSON Lines data (must be kept until this method returns).
+     *  @param datalen
+     *      The length of JSON Lines data.
+     *  @param handler
+     *      The handler of records (called with the index of the line and
+     *      Traverse object of the record).
+     *  @param path
+     *      The path.
+     *  @return
+     *      The count of records.
+     */
+    size_t read(
+        const char *data,
+        const size_t datalen,
+        std::function<void(const size_t, xap::core::json::Traverse &)> handler,
+        const std::string &path = "/"
+    );
+
+    /**
+     *  Read JSON Lines.
+     *
+     *  @throw xap::core::json::Exception
+     *      See read(const char*, size_t, ...).
+     *  @param data
+     *      The JSON Lines data.
+     *  @param handler
+     *      The handler of records (called with the index of the line and
+     *      Traverse object of the record).
+     *  @param path
+     *      The path.
+     *  @return
+     *      The count of records.
+     */
+    size_t read(
+        const std::string &data,
+        std::function<void(const size_t, xap::core::json::Traverse &)> handler,
+        const std::string &path = "/"
+    );
+
+    /**
+     *  Read a JSON Lines file (memory-mapped).
+     *
+     *  @throw xap::core::json::Exception
+     *      Raised if the file can't be read (ERROR_PARAMETER), otherwise see
+     *      read(const char*, size_t, ...).
+     *  @param filename
+     *      The file name.
+     *  @param handler
+     *      The handler of records (called with the index of the line and
+     *      Traverse object of the record).
+     *  @param path
+     *      The path.
+     *  @return
+     *      The count of records.
+     */
+    size_t read_file(
+        const std::string &filename,
+        std::function<void(const size_t, xap::core::json::Traverse &)> handler,
+        const std::string &path = "/"
+    );
+
+    /**
+     *  Set the count of workers.
+     *
+     *  @param workers
+     *      The count of workers (0 for one worker per CPU core, 1 to parse
+     *      on the calling thread).
+     */
+    void set_workers(const size_t workers);
+
+    /**
+     *  Get the count of workers.
+     *
+     *  @return
+     *      The count of workers.
+     */
+    size_t get_workers() const noexcept;
+
+    /**
+     *  Set the arena of records parsed afterwards.
+     *
+     *  @note
+     *      See xap::core::json::Parser::set_arena(). The arena is shared by
+     *      all workers.
+     *  @param arena
+     *      The arena (nullptr to allocate from the heap, which is the
+     *      default).
+     */
+    void set_arena(const xap::core::json::Arena *arena) noexcept;
+
+    /**
+     *  Set the key table of records parsed afterwards.
+     *
+     *  @note
+     *      See xap::core::json::Parser::set_key_table(). The table is
+     *      shared by all workers.
+     *  @param keys
+     *      The key table (nullptr to not intern the keys, which is the
+     *      default).
+     */
+    void set_key_table(const xap::core::json::KeyTable *keys) noexcept;
+
+private:
+
+    //
+    //  Private constructor.
+    //
+    LinesReader(const LinesReader &) = delete;
+    LinesReader &operator=(const LinesReader &) = delete;
+
+    //
+    //  Members.
+    //
+    std::unique_ptr<LinesReaderPrivate> m_reader;
+};
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
+
+#endif  //  #ifndef XAP_CORE_JSON_LINES_READER_H__
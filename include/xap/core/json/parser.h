@@ -0,0 +1,378 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+#ifndef XAP_CORE_JSON_PARSER_H__
+#define XAP_CORE_JSON_PARSER_H__
+
+//
+//  Imports.
+//
+#include <memory>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string>
+#include <xap/core/json/arena.h>
+#include <xap/core/json/build.h>
+#include <xap/core/json/key_table.h>
+#include <xap/core/json/traverse.h>
+
+namespace xap{
+namespace core {
+namespace json {
+
+//
+//  Declare.
+//
+class ParserPrivate;
+
+//
+//  Enum.
+//
+
+/**
+ *  Parser backend.
+ *
+ *  @note
+ *      jsoncpp:
+ *          Parse into a Json::Value tree.
+ *
+ *      native:
+ *          Parse into a flat node tape, strings are kept within (a copy of)
+ *          the input buffer. It is much faster and uses much less memory
+ *          than jsoncpp, but it only accepts strict JSON (RFC 8259, no
+ *          comments). Modifiers copy the modified object into a Json::Value
+ *          tree first.
+ *
+ *      lazy:
+ *          Like native, but parsing only finds the tokens and validates the
+ *          input (so errors are still raised by the parser). Nodes are
+ *          decoded when they are first visited (the children of an array or
+ *          an object all at once), and the subtrees that are never visited
+ *          are never decoded. A document of this backend must not be
+ *          traversed by more than one thread at the same time.
+ */
+enum Backend: uint8_t {
+    jsoncpp,
+    native,
+    lazy
+};
+
+//
+//  Classes.
+//
+
+/**
+ *  Parser (parsing context).
+ *
+ *  @note
+ *      A parser holds a configured reader and its scratch buffers, so that
+ *      many documents can be parsed without any per-document setup.
+ *
+ *      A parser is not thread-safe. Use one parser per thread, or use the
+ *      thread-local parser returned by Parser::get_default() (which is also
+ *      used by the constructors of xap::core::json::Traverse).
+ */
+class Parser {
+
+public:
+
+    /**
+     *  Construct the object (with the default backend).
+     */
+    Parser();
+
+    /**
+     *  Construct the object.
+     *
+     *  @param backend
+     *      The backend.
+     */
+    explicit Parser(const xap::core::json::Backend backend);
+
+    /**
+     *  Destruct the object.
+     */
+    virtual ~Parser() noexcept;
+
+    //
+    //  Public methods.
+    //
+
+    /**
+     *  Parse a JSON document.
+     *
+     *  @throw xap::core::json::Exception
+     *      Raised if JSON parsing was failed (ERROR_PARAMETER).
+     *  @param data
+     *      The JSON data.
+     *  @param datalen
+     *      The length of JSON data.
+     *  @param path
+     *      The path.
+     *  @return
+     *      Traverse object of the root.
+     */
+    xap::core::json::Traverse parse(
+        const uint8_t *data,
+        const size_t datalen,
+        const std::string &path = "/"
+    );
+
+    /**
+     *  Parse a JSON document.
+     *
+     *  @throw xap::core::json::Exception
+     *      Raised if JSON parsing was failed (ERROR_PARAMETER).
+     *  @param data
+     *      The JSON data.
+     *  @param datalen
+     *      The length of JSON data.
+     *  @param path
+     *      The path.
+     *  @return
+     *      Traverse object of the root.
+     */
+    xap::core::json::Traverse parse(
+        const char *data,
+        const size_t datalen,
+        const std::string &path = "/"
+    );
+
+    /**
+     *  Parse a JSON document.
+     *
+     *  @throw xap::core::json::Exception
+     *      Raised if JSON parsing was failed (ERROR_PARAMETER).
+     *  @param json_string
+     *      The JSON string.
+     *  @param path
+     *      The path.
+     *  @return
+     *      Traverse object of the root.
+     */
+    xap::core::json::Traverse parse(
+        const std::string &json_string,
+        const std::string &path = "/"
+    );
+
+    /**
+     *  Parse a JSON document.
+     *
+     *  @note
+     *      The native backend takes over the string instead of copying it.
+     *  @throw xap::core::json::Exception
+     *      Raised if JSON parsing was failed (ERROR_PARAMETER).
+     *  @param json_string
+     *      The JSON string (moved).
+     *  @param path
+     *      The path.
+     *  @return
+     *      Traverse object of the root.
+     */
+    xap::core::json::Traverse parse(
+        std::string &&json_string,
+        const std::string &path = "/"
+    );
+
+    /**
+     *  Parse a JSON file.
+     *
+     *  @note
+     *      The file is memory-mapped (privately) instead of being read into
+     *      memory. With the native backend, the document refers to the
+     *      mapping (strings are not copied) and keeps it until the document
+     *      is released.
+     *  @throw xap::core::json::Exception
+     *      Raised if the file can't be read or JSON parsing was failed
+     *      (ERROR_PARAMETER).
+     *  @param filename
+     *      The file name.
+     *  @param path
+     *      The path.
+     *  @return
+     *      Traverse object of the root.
+     */
+    xap::core::json::Traverse parse_file(
+        const std::string &filename,
+        const std::string &path = "/"
+    );
+
+    /**
+     *  Set the backend.
+     *
+     *  @param backend
+     *      The backend.
+     */
+    void set_backend(const xap::core::json::Backend backend) noexcept;
+
+    /**
+     *  Get the backend.
+     *
+     *  @return
+     *      The backend.
+     */
+    xap::core::json::Backend get_backend() const noexcept;
+
+    /**
+     *  Set the arena of documents parsed afterwards.
+     *
+     *  @note
+     *      The documents, their strings and tapes (native backend), and every
+     *      traverse object derived from them (including its path) are
+     *      allocated from the arena. Values of the jsoncpp backend still
+     *      allocate their contents from the heap.
+     *
+     *      The parser shares the arena, so the arena object can be destructed
+     *      while it is still set.
+     *  @param arena
+     *      The arena (nullptr to allocate from the heap, which is the
+     *      default).
+     */
+    void set_arena(const xap::core::json::Arena *arena) noexcept;
+
+    /**
+     *  Set the key table of documents parsed afterwards.
+     *
+     *  @note
+     *      The native (and lazy) documents tag their members with the IDs
+     *      of the interned keys, so that members are looked up by comparing
+     *      IDs. With the global table (xap::core::json::KeyTable::
+     *      get_global()), the values modified afterwards (e.g. by
+     *      object_set()) refer to the interned keys instead of copying them.
+     *
+     *      The parser (and each document) shares the table, so the table
+     *      object can be destructed while it is still set.
+     *  @param keys
+     *      The key table (nullptr to not intern the keys, which is the
+     *      default).
+     */
+    void set_key_table(const xap::core::json::KeyTable *keys) noexcept;
+
+    /**
+     *  Set the count of threads that parse a large document whose root is an
+     *  array.
+     *
+     *  @note
+     *      With the native backend, the items of a root array are cut into
+     *      ranges (at least 128 KiB each) after the tokens are found, and the
+     *      ranges are parsed by that many threads (including the calling
+     *      thread) into one document. The document is the same as the one
+     *      parsed on one thread. The jsoncpp (and lazy) backend always
+     *      parses on the calling thread.
+     *  @param workers
+     *      The count of threads (0 for one thread per CPU core, 1 to parse
+     *      on the calling thread only, which is the default).
+     */
+    void set_workers(const size_t workers);
+
+    /**
+     *  Get the count of threads that parse a large document whose root is an
+     *  array.
+     *
+     *  @return
+     *      The count of threads.
+     */
+    size_t get_workers() const noexcept;
+
+    /**
+     *  Set whether the input is validated as UTF-8.
+     *
+     *  @note
+     *      Overlong forms, surrogates, code points beyond U+10FFFF, stray
+     *      continuation bytes and truncated characters are rejected
+     *      (ERROR_PARAMETER, with the offset of the invalid character). The
+     *      native and lazy backends validate each batch of blocks while its
+     *      tokens are found (with SIMD instructions if the CPU supports), the
+     *      jsoncpp backend validates the whole input before parsing.
+     *  @param validate
+     *      True if so (get_default_utf8_validation() by default).
+     */
+    void set_utf8_validation(const bool validate) noexcept;
+
+    /**
+     *  Get whether the input is validated as UTF-8.
+     *
+     *  @return
+     *      True if so.
+     */
+    bool get_utf8_validation() const noexcept;
+
+    //
+    //  Public static functions.
+    //
+
+    /**
+     *  Get the default parser of current thread.
+     *
+     *  @return
+     *      The parser.
+     */
+    static xap::core::json::Parser &get_default();
+
+    /**
+     *  Set the default backend (of parsers constructed afterwards).
+     *
+     *  @note
+     *      The default parser of a thread is constructed when it is used for
+     *      the first time, so call this before any parsing to make the
+     *      constructors of xap::core::json::Traverse use the backend.
+     *  @param backend
+     *      The backend.
+     */
+    static void set_default_backend(
+        const xap::core::json::Backend backend
+    ) noexcept;
+
+    /**
+     *  Get the default backend.
+     *
+     *  @return
+     *      The backend (xap::core::json::Backend::jsoncpp if never set).
+     */
+    static xap::core::json::Backend get_default_backend() noexcept;
+
+    /**
+     *  Set whether parsers constructed afterwards validate the input as
+     *  UTF-8.
+     *
+     *  @note
+     *      Like the default backend, call this before any parsing to make
+     *      the constructors of xap::core::json::Traverse validate the input.
+     *      Stream parsers and lines readers constructed afterwards validate
+     *      the input as well.
+     *  @param validate
+     *      True if so.
+     */
+    static void set_default_utf8_validation(const bool validate) noexcept;
+
+    /**
+     *  Get whether parsers constructed afterwards validate the input as
+     *  UTF-8.
+     *
+     *  @return
+     *      True if so (false if never set).
+     */
+    static bool get_default_utf8_validation() noexcept;
+
+private:
+
+    //
+    //  Private constructor.
+    //
+    Parser(const Parser &) = delete;
+    Parser &operator=(const Parser &) = delete;
+
+    //
+    //  Members.
+    //
+    std::unique_ptr<ParserPrivate> m_parser;
+};
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
+
+#endif  //  #ifndef XAP_CORE_JSON_PARSER_H__
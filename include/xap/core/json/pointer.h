@@ -0,0 +1,124 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+#ifndef XAP_CORE_JSON_POINTER_H__
+#define XAP_CORE_JSON_POINTER_H__
+
+//
+//  Imports.
+//
+#include <memory>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string>
+#include <xap/core/json/build.h>
+
+namespace xap{
+namespace core {
+namespace json {
+
+//
+//  Declare.
+//
+class PointerPrivate;
+class TraversePrivate;
+
+//
+//  Classes.
+//
+
+/**
+ *  Compiled JSON pointer (RFC 6901).
+ *
+ *  @note
+ *      A pointer is parsed once: its segments are unescaped ("~1" to "/" and
+ *      "~0" to "~"), hashed and (for array indices) converted to integers
+ *      ahead of time. Evaluating it with Traverse::at() walks the document
+ *      in a single pass without creating intermediate traverse objects.
+ *
+ *      A pointer is immutable, so it can be shared by multiple threads.
+ *      Copies of a pointer share the compiled segments.
+ */
+class Pointer {
+
+public:
+
+    /**
+     *  Construct the object.
+     *
+     *  @throw xap::core::json::Exception
+     *      Raised if the pointer is invalid (ERROR_PARAMETER).
+     *  @param pointer
+     *      The pointer (e.g. "/request/audio/codec", "" refers to the whole
+     *      document).
+     */
+    explicit Pointer(const std::string &pointer);
+
+    /**
+     *  Construct (Copy) the object.
+     *
+     *  @param src
+     *      The source.
+     */
+    Pointer(const Pointer &src);
+
+    /**
+     *  Destruct the object.
+     */
+    virtual ~Pointer() noexcept;
+
+    //
+    //  Operators.
+    //
+
+    /**
+     *  Assign (Copy) the object.
+     *
+     *  @param src
+     *      The source.
+     *  @return
+     *      Self.
+     */
+    xap::core::json::Pointer &operator=(const Pointer &src);
+
+    //
+    //  Public methods.
+    //
+
+    /**
+     *  Get the pointer string.
+     *
+     *  @return
+     *      The pointer string.
+     */
+    const std::string &to_string() const noexcept;
+
+    /**
+     *  Get the count of segments.
+     *
+     *  @return
+     *      The count.
+     */
+    size_t get_segment_count() const noexcept;
+
+private:
+
+    //
+    //  Friend classes.
+    //
+    friend class TraversePrivate;
+
+    //
+    //  Members.
+    //
+    std::shared_ptr<const PointerPrivate> m_pointer;
+};
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
+
+#endif  //  #ifndef XAP_CORE_JSON_POINTER_H__
@@ -0,0 +1,236 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+#ifndef XAP_CORE_JSON_SCHEMA_H__
+#define XAP_CORE_JSON_SCHEMA_H__
+
+//
+//  Imports.
+//
+#include <memory>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string>
+#include <xap/core/json/build.h>
+#include <xap/core/json/traverse.h>
+
+namespace xap{
+namespace core {
+namespace json {
+
+//
+//  Declare.
+//
+class SchemaPrivate;
+class TraversePrivate;
+
+//
+//  Enum.
+//
+enum Width: uint8_t {
+    //  Any number.
+    any,
+
+    //  Integers that fit in int (see Traverse::integer()).
+    int32,
+
+    //  Integers that fit in uint (see Traverse::unsigned_integer()).
+    uint32,
+
+    //  Integers that fit in int64_t.
+    int64,
+
+    //  Integers that fit in uint64_t.
+    uint64
+};
+
+//
+//  Classes.
+//
+
+/**
+ *  Compiled schema of a JSON object.
+ *
+ *  @note
+ *      A schema is a list of fields (members), each with a name, a type,
+ *      whether it is required and, for numbers, an integer width. The
+ *      members of an object field (or the items of an array field) can be
+ *      checked by a nested schema. Evaluating it with Traverse::validate()
+ *      checks a whole document in a single depth-first pass: members are
+ *      looked up by pre-hashed keys, and neither traverse objects nor paths
+ *      are created unless a check fails.
+ *
+ *      A required field must exist and must not be null. An optional field
+ *      can be non-existed or null. Type::null accepts values of any type.
+ *
+ *      Build a schema once and share it afterwards: a built schema can be
+ *      used by multiple threads. Copies of a schema share the compiled
+ *      fields until one of them is modified.
+ */
+class Schema {
+
+public:
+
+    /**
+     *  Construct the object (without fields).
+     */
+    Schema();
+
+    /**
+     *  Construct (Copy) the object.
+     *
+     *  @param src
+     *      The source.
+     */
+    Schema(const Schema &src);
+
+    /**
+     *  Destruct the object.
+     */
+    virtual ~Schema() noexcept;
+
+    //
+    //  Operators.
+    //
+
+    /**
+     *  Assign (Copy) the object.
+     *
+     *  @param src
+     *      The source.
+     *  @return
+     *      Self.
+     */
+    xap::core::json::Schema &operator=(const Schema &src);
+
+    //
+    //  Public methods.
+    //
+
+    /**
+     *  Add a required field.
+     *
+     *  @throw xap::core::json::Exception
+     *      Raised if the name is duplicated or if an integer width is given
+     *      for a type other than Type::numeric (ERROR_PARAMETER).
+     *  @param name
+     *      The name (key) of the field.
+     *  @param type
+     *      The type.
+     *  @param width
+     *      The integer width (only for Type::numeric).
+     *  @return
+     *      Self.
+     */
+    xap::core::json::Schema &required(
+        const std::string &name,
+        const xap::core::json::Type type,
+        const xap::core::json::Width width = xap::core::json::Width::any
+    );
+
+    /**
+     *  Add a required field that is checked by a nested schema.
+     *
+     *  @throw xap::core::json::Exception
+     *      Raised if the name is duplicated or if the type is neither
+     *      Type::object nor Type::array (ERROR_PARAMETER).
+     *  @param name
+     *      The name (key) of the field.
+     *  @param type
+     *      The type (Type::object to check the members of the field, or
+     *      Type::array to check each item, which must be an object).
+     *  @param schema
+     *      The nested schema (shared, not copied).
+     *  @return
+     *      Self.
+     */
+    xap::core::json::Schema &required(
+        const std::string &name,
+        const xap::core::json::Type type,
+        const Schema &schema
+    );
+
+    /**
+     *  Add an optional field.
+     *
+     *  @throw xap::core::json::Exception
+     *      Raised if the name is duplicated or if an integer width is given
+     *      for a type other than Type::numeric (ERROR_PARAMETER).
+     *  @param name
+     *      The name (key) of the field.
+     *  @param type
+     *      The type.
+     *  @param width
+     *      The integer width (only for Type::numeric).
+     *  @return
+     *      Self.
+     */
+    xap::core::json::Schema &optional(
+        const std::string &name,
+        const xap::core::json::Type type,
+        const xap::core::json::Width width = xap::core::json::Width::any
+    );
+
+    /**
+     *  Add an optional field that is checked by a nested schema.
+     *
+     *  @throw xap::core::json::Exception
+     *      Raised if the name is duplicated or if the type is neither
+     *      Type::object nor Type::array (ERROR_PARAMETER).
+     *  @param name
+     *      The name (key) of the field.
+     *  @param type
+     *      The type (Type::object to check the members of the field, or
+     *      Type::array to check each item, which must be an object).
+     *  @param schema
+     *      The nested schema (shared, not copied).
+     *  @return
+     *      Self.
+     */
+    xap::core::json::Schema &optional(
+        const std::string &name,
+        const xap::core::json::Type type,
+        const Schema &schema
+    );
+
+    /**
+     *  Get the count of fields (excluding the fields of nested schemas).
+     *
+     *  @return
+     *      The count.
+     */
+    size_t get_field_count() const noexcept;
+
+private:
+
+    //
+    //  Friend classes.
+    //
+    friend class TraversePrivate;
+
+    //
+    //  Private methods.
+    //
+
+    /**
+     *  Get the private schema (exclusively owned) for modification.
+     *
+     *  @return
+     *      The private schema.
+     */
+    xap::core::json::SchemaPrivate &mutate();
+
+    //
+    //  Members.
+    //
+    std::shared_ptr<xap::core::json::SchemaPrivate> m_schema;
+};
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
+
+#endif  //  #ifndef XAP_CORE_JSON_SCHEMA_H__
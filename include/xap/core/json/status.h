@@ -0,0 +1,150 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+#ifndef XAP_CORE_JSON_STATUS_H__
+#define XAP_CORE_JSON_STATUS_H__
+
+//
+//  Imports.
+//
+#include <stdint.h>
+#include <stdlib.h>
+#include <string>
+#include <xap/core/json/build.h>
+
+namespace xap{
+namespace core {
+namespace json {
+
+//
+//  Declare.
+//
+class TraversePrivate;
+
+//
+//  Classes.
+//
+
+/**
+ *  Status (the error reported by the non-throwing methods of
+ *  xap::core::json::Traverse, e.g. try_sub() and try_inner_as_int()).
+ *
+ *  @note
+ *      A failed call reports the same error code, message and path as the
+ *      exception that its throwing counterpart would raise.
+ *
+ *      The message refers to a static string, and the path is rendered into
+ *      a buffer owned by the status object. Reuse one status object across
+ *      calls (e.g. for all fields of a message) so that the buffer is reused
+ *      and failures don't allocate memory once it is large enough. Each
+ *      call resets the status first, so a reused status always reports the
+ *      last call.
+ */
+class Status {
+
+public:
+
+    /**
+     *  Construct the object (succeeded).
+     */
+    Status() noexcept;
+
+    /**
+     *  Construct (Copy) the object.
+     *
+     *  @param src
+     *      The source.
+     */
+    Status(const Status &src);
+
+    /**
+     *  Destruct the object.
+     */
+    virtual ~Status() noexcept;
+
+    //
+    //  Operators.
+    //
+
+    /**
+     *  Assign (Copy) the object.
+     *
+     *  @param src
+     *      The source.
+     *  @return
+     *      Self.
+     */
+    xap::core::json::Status &operator=(const Status &src);
+
+    //
+    //  Public methods.
+    //
+
+    /**
+     *  Check whether the last call was succeeded.
+     *
+     *  @return
+     *      True if so.
+     */
+    bool is_ok() const noexcept;
+
+    /**
+     *  Get the error code.
+     *
+     *  @return
+     *      The error code (0 if succeeded).
+     */
+    uint16_t get_code() const noexcept;
+
+    /**
+     *  Get the error message.
+     *
+     *  @return
+     *      The error message ("" if succeeded).
+     */
+    const char *what() const noexcept;
+
+    /**
+     *  Get the path.
+     *
+     *  @return
+     *      The path ("" if succeeded).
+     */
+    const char *get_path() const noexcept;
+
+    /**
+     *  Reset the status to succeeded (the path buffer is kept).
+     */
+    void clear() noexcept;
+
+    /**
+     *  Raise the error as an exception (do nothing if succeeded).
+     *
+     *  @throw xap::core::json::Exception
+     *      Raised if the status is not succeeded.
+     */
+    void raise() const;
+
+private:
+
+    //
+    //  Friend classes.
+    //
+    friend class TraversePrivate;
+
+    //
+    //  Members.
+    //
+    const char *m_message;
+    uint16_t m_code;
+    std::string m_path;
+};
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
+
+#endif  //  #ifndef XAP_CORE_JSON_STATUS_H__
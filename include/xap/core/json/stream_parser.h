@@ -0,0 +1,179 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+#ifndef XAP_CORE_JSON_STREAM_PARSER_H__
+#define XAP_CORE_JSON_STREAM_PARSER_H__
+
+//
+//  Imports.
+//
+#include <memory>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string>
+#include <xap/core/json/arena.h>
+#include <xap/core/json/build.h>
+#include <xap/core/json/parser.h>
+#include <xap/core/json/traverse.h>
+
+namespace xap{
+namespace core {
+namespace json {
+
+//
+//  Declare.
+//
+class ParserPrivate;
+
+//
+//  Classes.
+//
+
+/**
+ *  Stream parser (a parser that accepts a JSON document in pieces, e.g. as
+ *  it is received from a socket).
+ *
+ *  @note
+ *      Each piece is appended to the buffer that becomes the input buffer of
+ *      the document, so the document is not buffered twice. With the native
+ *      (or lazy) backend, the tokens of each piece are found (stage 1 of
+ *      parsing) as soon as it is fed, so most of the parsing overlaps with
+ *      receiving and malformed documents are rejected early. Only the tape
+ *      is built by finish(). The jsoncpp backend parses the whole document
+ *      in finish().
+ *
+ *      A stream parser parses one document at a time and can be reused for
+ *      the next document after finish() (or reset()). It is not thread-safe.
+ */
+class StreamParser {
+
+public:
+
+    /**
+     *  Construct the object (with the default backend).
+     */
+    StreamParser();
+
+    /**
+     *  Construct the object.
+     *
+     *  @param backend
+     *      The backend.
+     */
+    explicit StreamParser(const xap::core::json::Backend backend);
+
+    /**
+     *  Destruct the object.
+     */
+    virtual ~StreamParser() noexcept;
+
+    //
+    //  Public methods.
+    //
+
+    /**
+     *  Feed a piece of the JSON document.
+     *
+     *  @param data
+     *      The piece (copied).
+     *  @param datalen
+     *      The length of the piece.
+     *  @return
+     *      False if the document is already known to be invalid (finish()
+     *      raises the error).
+     */
+    bool feed(const uint8_t *data, const size_t datalen);
+
+    /**
+     *  Feed a piece of the JSON document.
+     *
+     *  @param data
+     *      The piece (copied).
+     *  @param datalen
+     *      The length of the piece.
+     *  @return
+     *      False if the document is already known to be invalid (finish()
+     *      raises the error).
+     */
+    bool feed(const char *data, const size_t datalen);
+
+    /**
+     *  Parse the JSON document that was fed (and get ready for the next
+     *  document).
+     *
+     *  @throw xap::core::json::Exception
+     *      Raised if JSON parsing was failed (ERROR_PARAMETER).
+     *  @param path
+     *      The path.
+     *  @return
+     *      Traverse object of the root.
+     */
+    xap::core::json::Traverse finish(const std::string &path = "/");
+
+    /**
+     *  Discard the JSON document that was fed.
+     */
+    void reset() noexcept;
+
+    /**
+     *  Reserve memory for the JSON document to be fed (e.g. with the
+     *  Content-Length of a request), so that the buffer is not reallocated
+     *  while pieces are fed.
+     *
+     *  @param size
+     *      The (expected) size of the document.
+     */
+    void reserve(const size_t size);
+
+    /**
+     *  Get the size of the JSON document fed so far.
+     *
+     *  @return
+     *      The size.
+     */
+    size_t get_fed_size() const noexcept;
+
+    /**
+     *  Set the arena of documents parsed afterwards.
+     *
+     *  @note
+     *      See xap::core::json::Parser::set_arena().
+     *  @param arena
+     *      The arena (nullptr to allocate from the heap, which is the
+     *      default).
+     */
+    void set_arena(const xap::core::json::Arena *arena) noexcept;
+
+    /**
+     *  Set the key table of documents parsed afterwards.
+     *
+     *  @note
+     *      See xap::core::json::Parser::set_key_table().
+     *  @param keys
+     *      The key table (nullptr to not intern the keys, which is the
+     *      default).
+     */
+    void set_key_table(const xap::core::json::KeyTable *keys) noexcept;
+
+private:
+
+    //
+    //  Private constructor.
+    //
+    StreamParser(const StreamParser &) = delete;
+    StreamParser &operator=(const StreamParser &) = delete;
+
+    //
+    //  Members.
+    //
+    std::unique_ptr<ParserPrivate> m_parser;
+};
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
+
+#endif  //  #ifndef XAP_CORE_JSON_STREAM_PARSER_H__
@@ -0,0 +1,262 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+#ifndef XAP_CORE_JSON_STRING_VIEW_H__
+#define XAP_CORE_JSON_STRING_VIEW_H__
+
+//
+//  Imports.
+//
+#include <stdint.h>
+#include <stdlib.h>
+#include <string>
+#include <xap/core/json/build.h>
+
+#if defined(XAPCORE_JSON_STRING_VIEW)
+# include <string_view>
+#endif  //  #if defined(XAPCORE_JSON_STRING_VIEW)
+
+namespace xap{
+namespace core {
+namespace json {
+
+//
+//  Classes.
+//
+
+/**
+ *  String view (a non-owning reference to a string).
+ *
+ *  @note
+ *      A string view returned by xap::core::json::Traverse refers to the
+ *      storage of the parsed document. It is valid as long as the document
+ *      is alive (that is, as long as any traverse object of the document
+ *      is alive) and the string is not modified.
+ *
+ *      The string may contain NUL characters and is not NUL-terminated.
+ */
+class StringView {
+
+public:
+
+    /**
+     *  Construct the object (empty).
+     */
+    StringView() noexcept;
+
+    /**
+     *  Construct the object.
+     *
+     *  @param data
+     *      The characters.
+     *  @param size
+     *      The count of characters.
+     */
+    StringView(const char *data, const size_t size) noexcept;
+
+    //
+    //  Public methods.
+    //
+
+    /**
+     *  Get the characters.
+     *
+     *  @return
+     *      The characters (not NUL-terminated).
+     */
+    const char *data() const noexcept;
+
+    /**
+     *  Get the count of characters.
+     *
+     *  @return
+     *      The count.
+     */
+    size_t size() const noexcept;
+
+    /**
+     *  Check whether the string is empty.
+     *
+     *  @return
+     *      True if so.
+     */
+    bool empty() const noexcept;
+
+    /**
+     *  Get the first character.
+     *
+     *  @return
+     *      The iterator.
+     */
+    const char *begin() const noexcept;
+
+    /**
+     *  Get the end of the characters.
+     *
+     *  @return
+     *      The iterator.
+     */
+    const char *end() const noexcept;
+
+    /**
+     *  Copy the string.
+     *
+     *  @return
+     *      The copy.
+     */
+    std::string to_string() const;
+
+    /**
+     *  Check whether the string equals to another one.
+     *
+     *  @param other
+     *      The other string.
+     *  @param other_size
+     *      The length of the other string.
+     *  @return
+     *      True if so.
+     */
+    bool equals(const char *other, const size_t other_size) const noexcept;
+
+    //
+    //  Operators.
+    //
+
+    /**
+     *  Get a character.
+     *
+     *  @param index
+     *      The index (must be less than the size).
+     *  @return
+     *      The character.
+     */
+    char operator[](const size_t index) const noexcept;
+
+#if defined(XAPCORE_JSON_STRING_VIEW)
+
+    /**
+     *  Convert to std::string_view.
+     *
+     *  @note
+     *      Defined inline, since it depends on the language standard of the
+     *      caller instead of the one of the library.
+     *  @return
+     *      The view.
+     */
+    operator std::string_view() const noexcept {
+        return std::string_view(this->m_data, this->m_size);
+    }
+
+#endif  //  #if defined(XAPCORE_JSON_STRING_VIEW)
+
+private:
+
+    //
+    //  Members.
+    //
+    const char *m_data;
+    size_t m_size;
+};
+
+//
+//  Operators.
+//
+
+/**
+ *  Check whether two strings are equal.
+ *
+ *  @param a
+ *      The first string.
+ *  @param b
+ *      The second string.
+ *  @return
+ *      True if so.
+ */
+bool operator==(
+    const xap::core::json::StringView &a,
+    const xap::core::json::StringView &b
+) noexcept;
+
+/**
+ *  Check whether two strings are equal.
+ *
+ *  @param a
+ *      The first string.
+ *  @param b
+ *      The second string.
+ *  @return
+ *      True if so.
+ */
+bool operator==(
+    const xap::core::json::StringView &a,
+    const std::string &b
+) noexcept;
+
+/**
+ *  Check whether two strings are equal.
+ *
+ *  @param a
+ *      The first string.
+ *  @param b
+ *      The second string (NUL-terminated).
+ *  @return
+ *      True if so.
+ */
+bool operator==(
+    const xap::core::json::StringView &a,
+    const char *b
+) noexcept;
+
+/**
+ *  Check whether two strings are not equal.
+ *
+ *  @param a
+ *      The first string.
+ *  @param b
+ *      The second string.
+ *  @return
+ *      True if so.
+ */
+bool operator!=(
+    const xap::core::json::StringView &a,
+    const xap::core::json::StringView &b
+) noexcept;
+
+/**
+ *  Check whether two strings are not equal.
+ *
+ *  @param a
+ *      The first string.
+ *  @param b
+ *      The second string.
+ *  @return
+ *      True if so.
+ */
+bool operator!=(
+    const xap::core::json::StringView &a,
+    const std::string &b
+) noexcept;
+
+/**
+ *  Check whether two strings are not equal.
+ *
+ *  @param a
+ *      The first string.
+ *  @param b
+ *      The second string (NUL-terminated).
+ *  @return
+ *      True if so.
+ */
+bool operator!=(
+    const xap::core::json::StringView &a,
+    const char *b
+) noexcept;
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
+
+#endif  //  #ifndef XAP_CORE_JSON_STRING_VIEW_H__
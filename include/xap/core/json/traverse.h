@@ -11,11 +11,16 @@
 //  Imports.
 //
 #include <functional>
+#include <initializer_list>
 #include <memory>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string>
+#include <vector>
 #include <xap/core/json/build.h>
+#include <xap/core/json/pointer.h>
+#include <xap/core/json/status.h>
+#include <xap/core/json/string_view.h>
 
 namespace xap{
 namespace core {
@@ -24,6 +29,12 @@ namespace json {
 //
 //  Declare.
 //
+class BindTable;
+class ExtractField;
+class LinesReader;
+class Parser;
+class Schema;
+class StreamParser;
 class TraversePrivate;
 
 //
@@ -103,6 +114,9 @@ public:
     /**
      *  Construct (Copy) the object.
      * 
+     *  @note
+     *      The copy shares the parsed document with the source (O(1)). The
+     *      document is copied only when one of them is modified.
      *  @param src
      *      The source.
      */
@@ -110,11 +124,51 @@ public:
         const Traverse &src
     );
 
+    /**
+     *  Construct (Move) the object.
+     * 
+     *  @note
+     *      The source can only be assigned or destructed afterwards.
+     *  @param src
+     *      The source.
+     */
+    Traverse(
+        Traverse &&src
+    ) noexcept;
+
     /**
      *  Destruct the object.
      */
     virtual ~Traverse() noexcept;
 
+    //
+    //  Operators.
+    //
+
+    /**
+     *  Assign (Copy) the object.
+     * 
+     *  @note
+     *      The object shares the parsed document with the source (O(1)).
+     *  @param src
+     *      The source.
+     *  @return
+     *      Self.
+     */
+    xap::core::json::Traverse &operator=(const Traverse &src);
+
+    /**
+     *  Assign (Move) the object.
+     * 
+     *  @note
+     *      The source can only be assigned or destructed afterwards.
+     *  @param src
+     *      The source.
+     *  @return
+     *      Self.
+     */
+    xap::core::json::Traverse &operator=(Traverse &&src) noexcept;
+
     //
     //  Public methods.
     //
@@ -340,7 +394,31 @@ public:
      *  @return
      *      Traverse object of sub directory.
      */
-    xap::core::json::Traverse sub(const std::string &name);
+    xap::core::json::Traverse sub(const std::string &name) &;
+
+    /**
+     *  Go to sub directory (of a temporary object).
+     * 
+     *  @note
+     *      The returned object reuses the storage of this object.
+     *  @throw xap::core::json::Exception
+     *      Raised in the following situations:
+     *
+     *          - xap::core::json::ERROR_TYPE:
+     *              The inner is null.
+     * 
+     *          - xap::core::json::ERROR_TYPE:
+     *              The inner is not an object.
+     *  
+     *          - xap::core::json::ERROR_NOTFIND:
+     *              Sub path is not existed.
+     * 
+     *  @param name
+     *      The name (key) of sub directory.
+     *  @return
+     *      Traverse object of sub directory.
+     */
+    xap::core::json::Traverse sub(const std::string &name) &&;
 
     /**
      *  Go to sub directory which can be non-existed.
@@ -637,6 +715,139 @@ public:
         size_t             default_value_len
     );
 
+    /**
+     *  Go to the value that a JSON pointer refers to.
+     * 
+     *  @note
+     *      The pointer is evaluated in a single pass. The path of the returned
+     *      object (and of the errors) is extended with the unescaped segments.
+     *  @throw xap::core::json::Exception
+     *      Raised in the following situations:
+     *
+     *          - xap::core::json::ERROR_TYPE:
+     *              A value on the way is null.
+     * 
+     *          - xap::core::json::ERROR_TYPE:
+     *              A value on the way is neither an object nor an array.
+     *  
+     *          - xap::core::json::ERROR_NOTFIND:
+     *              A member (or an array item) is not existed.
+     * 
+     *  @param pointer
+     *      The compiled pointer.
+     *  @return
+     *      Traverse object of the value.
+     */
+    xap::core::json::Traverse at(
+        const xap::core::json::Pointer &pointer
+    ) &;
+
+    /**
+     *  Go to the value that a JSON pointer refers to (from a temporary
+     *  object).
+     * 
+     *  @note
+     *      The returned object reuses the storage of this object. The pointer
+     *      is evaluated in a single pass. The path of the returned object (and
+     *      of the errors) is extended with the unescaped segments.
+     *  @throw xap::core::json::Exception
+     *      Raised in the following situations:
+     *
+     *          - xap::core::json::ERROR_TYPE:
+     *              A value on the way is null.
+     * 
+     *          - xap::core::json::ERROR_TYPE:
+     *              A value on the way is neither an object nor an array.
+     *  
+     *          - xap::core::json::ERROR_NOTFIND:
+     *              A member (or an array item) is not existed.
+     * 
+     *  @param pointer
+     *      The compiled pointer.
+     *  @return
+     *      Traverse object of the value.
+     */
+    xap::core::json::Traverse at(
+        const xap::core::json::Pointer &pointer
+    ) &&;
+
+    /**
+     *  Go to the value that a JSON pointer refers to, which can be
+     *  non-existed.
+     * 
+     *  @note
+     *      The method will return a Traverse object with 'null' type if any
+     *      member (or array item) on the way is non-existed or null.
+     *  @throw xap::core::json::Exception
+     *      Raised if a value on the way is neither an object nor an array
+     *      (xap::core::json::ERROR_TYPE).
+     *  @param pointer
+     *      The compiled pointer.
+     *  @return
+     *      Traverse object of the value.
+     */
+    xap::core::json::Traverse optional_at(
+        const xap::core::json::Pointer &pointer
+    );
+
+    /**
+     *  Validate the inner object against a schema.
+     * 
+     *  @note
+     *      The whole document is checked in a single depth-first pass (see
+     *      xap::core::json::Schema).
+     *  @throw xap::core::json::Exception
+     *      Raised in the following situations (the path of the error is the
+     *      path of the first value that failed):
+     *
+     *          - xap::core::json::ERROR_TYPE:
+     *              The inner is null or is not an object.
+     * 
+     *          - xap::core::json::ERROR_TYPE:
+     *              A field is null (but required) or has another type.
+     *  
+     *          - xap::core::json::ERROR_NOTFIND:
+     *              A required field is not existed.
+     * 
+     *  @param schema
+     *      The schema.
+     *  @return
+     *      Self.
+     */
+    xap::core::json::Traverse &validate(
+        const xap::core::json::Schema &schema
+    );
+
+    /**
+     *  Extract multiple members of the inner object.
+     * 
+     *  @note
+     *      The members of the object are scanned once, and each member that
+     *      matches a field is converted and written to the destination of
+     *      the field. No traverse object is created.
+     *  @throw xap::core::json::Exception
+     *      Raised in the following situations (the path of the error is the
+     *      path of the first member that failed):
+     *
+     *          - xap::core::json::ERROR_TYPE:
+     *              The inner is null or is not an object.
+     * 
+     *          - xap::core::json::ERROR_TYPE:
+     *              A member is null (but required) or doesn't fit the type
+     *              of its destination.
+     *  
+     *          - xap::core::json::ERROR_NOTFIND:
+     *              A required member is not existed.
+     * 
+     *  @param fields
+     *      The fields (the destinations are partially written if failed).
+     *  @return
+     *      Self.
+     */
+    xap::core::json::Traverse &extract(
+        std::initializer_list<xap::core::json::ExtractField> fields
+    );
+
     /**
      *  Set a key-value pair within an object.
      * 
@@ -879,37 +1090,983 @@ public:
      *  @return
      *      The inner.
      */
-    std::string inner_as_string();
+    std::string inner_as_string() &;
 
-    //
-    //  Public static functions.
-    //
+    /**
+     *  Get the inner (of a temporary object) as string.
+     * 
+     *  @note
+     *      The parsed document is released as soon as the value was read.
+     *  @throw xap::core::json::Exception
+     *      Raised in the following situations:
+     *
+     *          - xap::core::json::ERROR_TYPE:
+     *              The inner is null.
+     * 
+     *          - xap::core::json::ERROR_TYPE:
+     *              The inner is not a string.
+     * 
+     *  @return
+     *      The inner.
+     */
+    std::string inner_as_string() &&;
 
     /**
-     *  Get a 'Traverse' object and its type is 'null'.
+     *  Get the inner as string (without copying it).
+     * 
+     *  @note
+     *      The view refers to the storage of the parsed document, see
+     *      xap::core::json::StringView for its lifetime. It is safe to get
+     *      the view from a temporary object (e.g. root.sub("a")) as long as
+     *      another traverse object (e.g. root) keeps the document alive.
+     *  @throw xap::core::json::Exception
+     *      Raised in the following situations:
      *
-     *  @param path
-     *      The path.
+     *          - xap::core::json::ERROR_TYPE:
+     *              The inner is null.
+     * 
+     *          - xap::core::json::ERROR_TYPE:
+     *              The inner is not a string.
+     * 
      *  @return
-     *      The 'Traverse' object.
+     *      The inner.
      */
-    static xap::core::json::Traverse null(const std::string &path = "/");
+    xap::core::json::StringView inner_as_string_view();
 
-private:
+    /**
+     *  Get the items of the inner array as integers (in bulk).
+     * 
+     *  @note
+     *      Only the first n items are converted (all of them if the array is
+     *      shorter).
+     *  @throw xap::core::json::Exception
+     *      Raised in the following situations (the path of the error is the
+     *      path of the first item that failed):
+     *
+     *          - xap::core::json::ERROR_TYPE:
+     *              The inner is null or is not an array.
+     * 
+     *          - xap::core::json::ERROR_TYPE:
+     *              An item is null or is not an integer that fits in int.
+     * 
+     *  @param out
+     *      The buffer to receive the items (at least n items).
+     *  @param n
+     *      The size of the buffer.
+     *  @return
+     *      The length of the array.
+     */
+    size_t inner_as_int_array(int *out, const size_t n);
 
-    //
-    //  Private constructor.
-    //
+    /**
+     *  Get the items of the inner array as integers (in bulk).
+     * 
+     *  @throw xap::core::json::Exception
+     *      Raised in the following situations (the path of the error is the
+     *      path of the first item that failed):
+     *
+     *          - xap::core::json::ERROR_TYPE:
+     *              The inner is null or is not an array.
+     * 
+     *          - xap::core::json::ERROR_TYPE:
+     *              An item is null or is not an integer that fits in int.
+     * 
+     *  @return
+     *      The items.
+     */
+    std::vector<int> inner_as_int_array();
 
     /**
-     *  Construct the object.
+     *  Get the items of the inner array as unsigned integers (in bulk).
      * 
-     *  @param p_traverse
-     *      The private traverse object.
+     *  @note
+     *      Only the first n items are converted (all of them if the array is
+     *      shorter).
+     *  @throw xap::core::json::Exception
+     *      Raised in the following situations (the path of the error is the
+     *      path of the first item that failed):
+     *
+     *          - xap::core::json::ERROR_TYPE:
+     *              The inner is null or is not an array.
+     * 
+     *          - xap::core::json::ERROR_TYPE:
+     *              An item is null or is not an integer that fits in uint.
+     * 
+     *  @param out
+     *      The buffer to receive the items (at least n items).
+     *  @param n
+     *      The size of the buffer.
+     *  @return
+     *      The length of the array.
      */
-    Traverse(
-        const TraversePrivate &p_traverse
-    );
+    size_t inner_as_uint_array(uint *out, const size_t n);
+
+    /**
+     *  Get the items of the inner array as unsigned integers (in bulk).
+     * 
+     *  @throw xap::core::json::Exception
+     *      Raised in the following situations (the path of the error is the
+     *      path of the first item that failed):
+     *
+     *          - xap::core::json::ERROR_TYPE:
+     *              The inner is null or is not an array.
+     * 
+     *          - xap::core::json::ERROR_TYPE:
+     *              An item is null or is not an integer that fits in uint.
+     * 
+     *  @return
+     *      The items.
+     */
+    std::vector<uint> inner_as_uint_array();
+
+#if defined(XAPCORE_JSON_INT64)
+
+    /**
+     *  Get the items of the inner array as signed 64-bit integers (in bulk).
+     * 
+     *  @note
+     *      Only the first n items are converted (all of them if the array is
+     *      shorter).
+     *  @throw xap::core::json::Exception
+     *      Raised in the following situations (the path of the error is the
+     *      path of the first item that failed):
+     *
+     *          - xap::core::json::ERROR_TYPE:
+     *              The inner is null or is not an array.
+     * 
+     *          - xap::core::json::ERROR_TYPE:
+     *              An item is null or is not an integer that fits in int64_t.
+     * 
+     *  @param out
+     *      The buffer to receive the items (at least n items).
+     *  @param n
+     *      The size of the buffer.
+     *  @return
+     *      The length of the array.
+     */
+    size_t inner_as_int64_array(int64_t *out, const size_t n);
+
+    /**
+     *  Get the items of the inner array as signed 64-bit integers (in bulk).
+     * 
+     *  @throw xap::core::json::Exception
+     *      Raised in the following situations (the path of the error is the
+     *      path of the first item that failed):
+     *
+     *          - xap::core::json::ERROR_TYPE:
+     *              The inner is null or is not an array.
+     * 
+     *          - xap::core::json::ERROR_TYPE:
+     *              An item is null or is not an integer that fits in int64_t.
+     * 
+     *  @return
+     *      The items.
+     */
+    std::vector<int64_t> inner_as_int64_array();
+
+    /**
+     *  Get the items of the inner array as unsigned 64-bit integers (in bulk).
+     * 
+     *  @note
+     *      Only the first n items are converted (all of them if the array is
+     *      shorter).
+     *  @throw xap::core::json::Exception
+     *      Raised in the following situations (the path of the error is the
+     *      path of the first item that failed):
+     *
+     *          - xap::core::json::ERROR_TYPE:
+     *              The inner is null or is not an array.
+     * 
+     *          - xap::core::json::ERROR_TYPE:
+     *              An item is null or is not an integer that fits in uint64_t.
+     * 
+     *  @param out
+     *      The buffer to receive the items (at least n items).
+     *  @param n
+     *      The size of the buffer.
+     *  @return
+     *      The length of the array.
+     */
+    size_t inner_as_uint64_array(uint64_t *out, const size_t n);
+
+    /**
+     *  Get the items of the inner array as unsigned 64-bit integers (in bulk).
+     * 
+     *  @throw xap::core::json::Exception
+     *      Raised in the following situations (the path of the error is the
+     *      path of the first item that failed):
+     *
+     *          - xap::core::json::ERROR_TYPE:
+     *              The inner is null or is not an array.
+     * 
+     *          - xap::core::json::ERROR_TYPE:
+     *              An item is null or is not an integer that fits in uint64_t.
+     * 
+     *  @return
+     *      The items.
+     */
+    std::vector<uint64_t> inner_as_uint64_array();
+
+#endif  //  #if defined(XAPCORE_JSON_INT64)
+
+    /**
+     *  Get the items of the inner array as floats (in bulk).
+     * 
+     *  @note
+     *      Only the first n items are converted (all of them if the array is
+     *      shorter).
+     *  @throw xap::core::json::Exception
+     *      Raised in the following situations (the path of the error is the
+     *      path of the first item that failed):
+     *
+     *          - xap::core::json::ERROR_TYPE:
+     *              The inner is null or is not an array.
+     * 
+     *          - xap::core::json::ERROR_TYPE:
+     *              An item is null or is not numeric.
+     * 
+     *  @param out
+     *      The buffer to receive the items (at least n items).
+     *  @param n
+     *      The size of the buffer.
+     *  @return
+     *      The length of the array.
+     */
+    size_t inner_as_float_array(float *out, const size_t n);
+
+    /**
+     *  Get the items of the inner array as floats (in bulk).
+     * 
+     *  @throw xap::core::json::Exception
+     *      Raised in the following situations (the path of the error is the
+     *      path of the first item that failed):
+     *
+     *          - xap::core::json::ERROR_TYPE:
+     *              The inner is null or is not an array.
+     * 
+     *          - xap::core::json::ERROR_TYPE:
+     *              An item is null or is not numeric.
+     * 
+     *  @return
+     *      The items.
+     */
+    std::vector<float> inner_as_float_array();
+
+    /**
+     *  Get the items of the inner array as doubles (in bulk).
+     * 
+     *  @note
+     *      Only the first n items are converted (all of them if the array is
+     *      shorter).
+     *  @throw xap::core::json::Exception
+     *      Raised in the following situations (the path of the error is the
+     *      path of the first item that failed):
+     *
+     *          - xap::core::json::ERROR_TYPE:
+     *              The inner is null or is not an array.
+     * 
+     *          - xap::core::json::ERROR_TYPE:
+     *              An item is null or is not numeric.
+     * 
+     *  @param out
+     *      The buffer to receive the items (at least n items).
+     *  @param n
+     *      The size of the buffer.
+     *  @return
+     *      The length of the array.
+     */
+    size_t inner_as_double_array(double *out, const size_t n);
+
+    /**
+     *  Get the items of the inner array as doubles (in bulk).
+     * 
+     *  @throw xap::core::json::Exception
+     *      Raised in the following situations (the path of the error is the
+     *      path of the first item that failed):
+     *
+     *          - xap::core::json::ERROR_TYPE:
+     *              The inner is null or is not an array.
+     * 
+     *          - xap::core::json::ERROR_TYPE:
+     *              An item is null or is not numeric.
+     * 
+     *  @return
+     *      The items.
+     */
+    std::vector<double> inner_as_double_array();
+
+    /**
+     *  Get the items of the inner array as 16-bit PCM samples (in bulk).
+     * 
+     *  @note
+     *      Only the first n items are converted (all of them if the array is
+     *      shorter). Numbers are clamped to [-32768, 32767] (and truncated
+     *      toward zero).
+     *  @throw xap::core::json::Exception
+     *      Raised in the following situations (the path of the error is the
+     *      path of the first item that failed):
+     *
+     *          - xap::core::json::ERROR_TYPE:
+     *              The inner is null or is not an array.
+     * 
+     *          - xap::core::json::ERROR_TYPE:
+     *              An item is null or is not numeric.
+     * 
+     *  @param out
+     *      The buffer to receive the items (at least n items).
+     *  @param n
+     *      The size of the buffer.
+     *  @return
+     *      The length of the array.
+     */
+    size_t inner_as_int16_array(int16_t *out, const size_t n);
+
+    /**
+     *  Get the items of the inner array as 16-bit PCM samples (in bulk).
+     * 
+     *  @note
+     *      Numbers are clamped to [-32768, 32767] (and truncated toward zero).
+     *  @throw xap::core::json::Exception
+     *      Raised in the following situations (the path of the error is the
+     *      path of the first item that failed):
+     *
+     *          - xap::core::json::ERROR_TYPE:
+     *              The inner is null or is not an array.
+     * 
+     *          - xap::core::json::ERROR_TYPE:
+     *              An item is null or is not numeric.
+     * 
+     *  @return
+     *      The items.
+     */
+    std::vector<int16_t> inner_as_int16_array();
+
+    /**
+     *  Decode the inner base64 string (RFC 4648) into a buffer.
+     * 
+     *  @note
+     *      Only the first n bytes are written (all of them if the decoded
+     *      data is shorter), but the whole string is always validated. The
+     *      padding is optional. The string is decoded from the storage of
+     *      the document (with SIMD instructions if the CPU supports), no
+     *      intermediate string is made.
+     *  @throw xap::core::json::Exception
+     *      Raised in the following situations:
+     *
+     *          - xap::core::json::ERROR_TYPE:
+     *              The inner is null or is not a string.
+     * 
+     *          - xap::core::json::ERROR_TYPE:
+     *              The inner is not valid base64.
+     * 
+     *  @param out
+     *      The buffer to receive the decoded bytes (at least n bytes).
+     *  @param n
+     *      The size of the buffer.
+     *  @return
+     *      The length of the decoded data.
+     */
+    size_t inner_as_base64(uint8_t *out, const size_t n);
+
+    /**
+     *  Decode the inner base64 string (RFC 4648).
+     * 
+     *  @throw xap::core::json::Exception
+     *      Raised in the following situations:
+     *
+     *          - xap::core::json::ERROR_TYPE:
+     *              The inner is null or is not a string.
+     * 
+     *          - xap::core::json::ERROR_TYPE:
+     *              The inner is not valid base64.
+     * 
+     *  @return
+     *      The decoded bytes.
+     */
+    std::vector<uint8_t> inner_as_base64();
+
+    //
+    //  Public methods (non-throwing).
+    //
+
+    /**
+     *  Check the type of inner object (without throwing).
+     * 
+     *  @note
+     *      The non-throwing methods report the same errors as their throwing
+     *      counterparts through a xap::core::json::Status object instead of
+     *      raising xap::core::json::Exception, so that failures don't pay
+     *      the cost of stack unwinding (e.g. when validating untrusted
+     *      input).
+     *  @param type
+     *      The expected type.
+     *  @param status
+     *      The status to receive the error (nullptr if not needed).
+     *  @return
+     *      False if the type is neither null nor the expected one.
+     */
+    bool try_type_of(
+        const xap::core::json::Type &type,
+        xap::core::json::Status *status = nullptr
+    );
+
+    /**
+     *  Check that the inner object is not null (without throwing).
+     * 
+     *  @param status
+     *      The status to receive the error (nullptr if not needed).
+     *  @return
+     *      False if the inner is null (xap::core::json::ERROR_TYPE).
+     */
+    bool try_not_null(xap::core::json::Status *status = nullptr);
+
+    /**
+     *  Go to sub directory (without throwing).
+     * 
+     *  @throw std::bad_alloc
+     *      Raised if memory allocation was failed.
+     *  @param name
+     *      The name (key) of sub directory.
+     *  @param out
+     *      The object to receive the sub directory (can be this object, left
+     *      unchanged if failed).
+     *  @param status
+     *      The status to receive the error (nullptr if not needed).
+     *  @return
+     *      False in the following situations:
+     *
+     *          - xap::core::json::ERROR_TYPE:
+     *              The inner is null.
+     * 
+     *          - xap::core::json::ERROR_TYPE:
+     *              The inner is not an object.
+     *  
+     *          - xap::core::json::ERROR_NOTFIND:
+     *              Sub path is not existed.
+     */
+    bool try_sub(
+        const std::string &name,
+        xap::core::json::Traverse *out,
+        xap::core::json::Status *status = nullptr
+    );
+
+    /**
+     *  Go to the value that a JSON pointer refers to (without throwing).
+     * 
+     *  @throw std::bad_alloc
+     *      Raised if memory allocation was failed.
+     *  @param pointer
+     *      The compiled pointer.
+     *  @param out
+     *      The object to receive the value (can be this object, left
+     *      unchanged if failed).
+     *  @param status
+     *      The status to receive the error (nullptr if not needed).
+     *  @return
+     *      False in the following situations:
+     *
+     *          - xap::core::json::ERROR_TYPE:
+     *              A value on the way is null.
+     * 
+     *          - xap::core::json::ERROR_TYPE:
+     *              A value on the way is neither an object nor an array.
+     *  
+     *          - xap::core::json::ERROR_NOTFIND:
+     *              A member (or an array item) is not existed.
+     */
+    bool try_at(
+        const xap::core::json::Pointer &pointer,
+        xap::core::json::Traverse *out,
+        xap::core::json::Status *status = nullptr
+    );
+
+    /**
+     *  Validate the inner object against a schema (without throwing).
+     * 
+     *  @param schema
+     *      The schema.
+     *  @param status
+     *      The status to receive the error (nullptr if not needed).
+     *  @return
+     *      False in the situations that Traverse::validate() throws.
+     */
+    bool try_validate(
+        const xap::core::json::Schema &schema,
+        xap::core::json::Status *status = nullptr
+    );
+
+    /**
+     *  Extract multiple members of the inner object (without throwing).
+     * 
+     *  @param fields
+     *      The fields (the destinations are partially written if failed).
+     *  @param status
+     *      The status to receive the error (nullptr if not needed).
+     *  @return
+     *      False in the situations that Traverse::extract() throws.
+     */
+    bool try_extract(
+        std::initializer_list<xap::core::json::ExtractField> fields,
+        xap::core::json::Status *status = nullptr
+    );
+
+    /**
+     *  Get the length of an array (without throwing).
+     * 
+     *  @param length
+     *      The pointer to receive the length.
+     *  @param status
+     *      The status to receive the error (nullptr if not needed).
+     *  @return
+     *      False if the inner is null or is not an array
+     *      (xap::core::json::ERROR_TYPE).
+     */
+    bool try_array_get_length(
+        size_t *length,
+        xap::core::json::Status *status = nullptr
+    );
+
+    /**
+     *  Get inner as a signed integer (without throwing).
+     * 
+     *  @param value
+     *      The pointer to receive the inner.
+     *  @param status
+     *      The status to receive the error (nullptr if not needed).
+     *  @return
+     *      False if the inner is null or is not a signed integer
+     *      (xap::core::json::ERROR_TYPE).
+     */
+    bool try_inner_as_int(
+        int *value,
+        xap::core::json::Status *status = nullptr
+    );
+
+    /**
+     *  Get inner as an unsigned integer (without throwing).
+     * 
+     *  @param value
+     *      The pointer to receive the inner.
+     *  @param status
+     *      The status to receive the error (nullptr if not needed).
+     *  @return
+     *      False if the inner is null or is not an unsigned integer
+     *      (xap::core::json::ERROR_TYPE).
+     */
+    bool try_inner_as_uint(
+        uint *value,
+        xap::core::json::Status *status = nullptr
+    );
+
+#if defined(XAPCORE_JSON_INT64)
+
+    /**
+     *  Get inner as a signed 64-bit integer (without throwing).
+     * 
+     *  @param value
+     *      The pointer to receive the inner.
+     *  @param status
+     *      The status to receive the error (nullptr if not needed).
+     *  @return
+     *      False if the inner is null or is not a signed 64-bit integer
+     *      (xap::core::json::ERROR_TYPE).
+     */
+    bool try_inner_as_int64(
+        int64_t *value,
+        xap::core::json::Status *status = nullptr
+    );
+
+    /**
+     *  Get inner as an unsigned 64-bit integer (without throwing).
+     * 
+     *  @param value
+     *      The pointer to receive the inner.
+     *  @param status
+     *      The status to receive the error (nullptr if not needed).
+     *  @return
+     *      False if the inner is null or is not an unsigned 64-bit integer
+     *      (xap::core::json::ERROR_TYPE).
+     */
+    bool try_inner_as_uint64(
+        uint64_t *value,
+        xap::core::json::Status *status = nullptr
+    );
+
+#endif  //  #if defined(XAPCORE_JSON_INT64)
+
+    /**
+     *  Get inner as float (without throwing).
+     * 
+     *  @param value
+     *      The pointer to receive the inner.
+     *  @param status
+     *      The status to receive the error (nullptr if not needed).
+     *  @return
+     *      False if the inner is null or is not numeric
+     *      (xap::core::json::ERROR_TYPE).
+     */
+    bool try_inner_as_float(
+        float *value,
+        xap::core::json::Status *status = nullptr
+    );
+
+    /**
+     *  Get inner as double (without throwing).
+     * 
+     *  @param value
+     *      The pointer to receive the inner.
+     *  @param status
+     *      The status to receive the error (nullptr if not needed).
+     *  @return
+     *      False if the inner is null or is not numeric
+     *      (xap::core::json::ERROR_TYPE).
+     */
+    bool try_inner_as_double(
+        double *value,
+        xap::core::json::Status *status = nullptr
+    );
+
+    /**
+     *  Get inner as a boolean (without throwing).
+     * 
+     *  @param value
+     *      The pointer to receive the inner.
+     *  @param status
+     *      The status to receive the error (nullptr if not needed).
+     *  @return
+     *      False if the inner is null or is not a boolean
+     *      (xap::core::json::ERROR_TYPE).
+     */
+    bool try_inner_as_boolean(
+        bool *value,
+        xap::core::json::Status *status = nullptr
+    );
+
+    /**
+     *  Get inner as string (without throwing).
+     * 
+     *  @throw std::bad_alloc
+     *      Raised if memory allocation was failed.
+     *  @param value
+     *      The pointer to receive the inner.
+     *  @param status
+     *      The status to receive the error (nullptr if not needed).
+     *  @return
+     *      False if the inner is null or is not a string
+     *      (xap::core::json::ERROR_TYPE).
+     */
+    bool try_inner_as_string(
+        std::string *value,
+        xap::core::json::Status *status = nullptr
+    );
+
+    /**
+     *  Get the inner as string without copying it (without throwing).
+     * 
+     *  @note
+     *      See inner_as_string_view() for the lifetime of the view.
+     *  @param value
+     *      The pointer to receive the inner.
+     *  @param status
+     *      The status to receive the error (nullptr if not needed).
+     *  @return
+     *      False if the inner is null or is not a string
+     *      (xap::core::json::ERROR_TYPE).
+     */
+    bool try_inner_as_string_view(
+        xap::core::json::StringView *value,
+        xap::core::json::Status *status = nullptr
+    );
+
+    /**
+     *  Get the items of the inner array as integers (in bulk, without
+     *  throwing).
+     * 
+     *  @note
+     *      Only the first n items are converted (all of them if the array is
+     *      shorter).
+     *  @param out
+     *      The buffer to receive the items (at least n items).
+     *  @param n
+     *      The size of the buffer.
+     *  @param length
+     *      The pointer to receive the length of the array (nullptr if not
+     *      needed).
+     *  @param status
+     *      The status to receive the error (nullptr if not needed).
+     *  @return
+     *      False in the situations that inner_as_int_array() throws.
+     */
+    bool try_inner_as_int_array(
+        int *out,
+        const size_t n,
+        size_t *length,
+        xap::core::json::Status *status = nullptr
+    );
+
+    /**
+     *  Get the items of the inner array as unsigned integers (in bulk, without
+     *  throwing).
+     * 
+     *  @note
+     *      Only the first n items are converted (all of them if the array is
+     *      shorter).
+     *  @param out
+     *      The buffer to receive the items (at least n items).
+     *  @param n
+     *      The size of the buffer.
+     *  @param length
+     *      The pointer to receive the length of the array (nullptr if not
+     *      needed).
+     *  @param status
+     *      The status to receive the error (nullptr if not needed).
+     *  @return
+     *      False in the situations that inner_as_uint_array() throws.
+     */
+    bool try_inner_as_uint_array(
+        uint *out,
+        const size_t n,
+        size_t *length,
+        xap::core::json::Status *status = nullptr
+    );
+
+#if defined(XAPCORE_JSON_INT64)
+
+    /**
+     *  Get the items of the inner array as signed 64-bit integers (in bulk,
+     *  without throwing).
+     * 
+     *  @note
+     *      Only the first n items are converted (all of them if the array is
+     *      shorter).
+     *  @param out
+     *      The buffer to receive the items (at least n items).
+     *  @param n
+     *      The size of the buffer.
+     *  @param length
+     *      The pointer to receive the length of the array (nullptr if not
+     *      needed).
+     *  @param status
+     *      The status to receive the error (nullptr if not needed).
+     *  @return
+     *      False in the situations that inner_as_int64_array() throws.
+     */
+    bool try_inner_as_int64_array(
+        int64_t *out,
+        const size_t n,
+        size_t *length,
+        xap::core::json::Status *status = nullptr
+    );
+
+    /**
+     *  Get the items of the inner array as unsigned 64-bit integers (in bulk,
+     *  without throwing).
+     * 
+     *  @note
+     *      Only the first n items are converted (all of them if the array is
+     *      shorter).
+     *  @param out
+     *      The buffer to receive the items (at least n items).
+     *  @param n
+     *      The size of the buffer.
+     *  @param length
+     *      The pointer to receive the length of the array (nullptr if not
+     *      needed).
+     *  @param status
+     *      The status to receive the error (nullptr if not needed).
+     *  @return
+     *      False in the situations that inner_as_uint64_array() throws.
+     */
+    bool try_inner_as_uint64_array(
+        uint64_t *out,
+        const size_t n,
+        size_t *length,
+        xap::core::json::Status *status = nullptr
+    );
+
+#endif  //  #if defined(XAPCORE_JSON_INT64)
+
+    /**
+     *  Get the items of the inner array as floats (in bulk, without throwing).
+     * 
+     *  @note
+     *      Only the first n items are converted (all of them if the array is
+     *      shorter).
+     *  @param out
+     *      The buffer to receive the items (at least n items).
+     *  @param n
+     *      The size of the buffer.
+     *  @param length
+     *      The pointer to receive the length of the array (nullptr if not
+     *      needed).
+     *  @param status
+     *      The status to receive the error (nullptr if not needed).
+     *  @return
+     *      False in the situations that inner_as_float_array() throws.
+     */
+    bool try_inner_as_float_array(
+        float *out,
+        const size_t n,
+        size_t *length,
+        xap::core::json::Status *status = nullptr
+    );
+
+    /**
+     *  Get the items of the inner array as doubles (in bulk, without throwing).
+     * 
+     *  @note
+     *      Only the first n items are converted (all of them if the array is
+     *      shorter).
+     *  @param out
+     *      The buffer to receive the items (at least n items).
+     *  @param n
+     *      The size of the buffer.
+     *  @param length
+     *      The pointer to receive the length of the array (nullptr if not
+     *      needed).
+     *  @param status
+     *      The status to receive the error (nullptr if not needed).
+     *  @return
+     *      False in the situations that inner_as_double_array() throws.
+     */
+    bool try_inner_as_double_array(
+        double *out,
+        const size_t n,
+        size_t *length,
+        xap::core::json::Status *status = nullptr
+    );
+
+    /**
+     *  Get the items of the inner array as 16-bit PCM samples (in bulk, without
+     *  throwing).
+     * 
+     *  @note
+     *      Only the first n items are converted (all of them if the array is
+     *      shorter). Numbers are clamped to [-32768, 32767] (and truncated
+     *      toward zero).
+     *  @param out
+     *      The buffer to receive the items (at least n items).
+     *  @param n
+     *      The size of the buffer.
+     *  @param length
+     *      The pointer to receive the length of the array (nullptr if not
+     *      needed).
+     *  @param status
+     *      The status to receive the error (nullptr if not needed).
+     *  @return
+     *      False in the situations that inner_as_int16_array() throws.
+     */
+    bool try_inner_as_int16_array(
+        int16_t *out,
+        const size_t n,
+        size_t *length,
+        xap::core::json::Status *status = nullptr
+    );
+
+    /**
+     *  Decode the inner base64 string into a buffer (without throwing).
+     * 
+     *  @note
+     *      Only the first n bytes are written (all of them if the decoded
+     *      data is shorter), but the whole string is always validated. The
+     *      content of the buffer is unspecified if failed.
+     *  @param out
+     *      The buffer to receive the decoded bytes (at least n bytes).
+     *  @param n
+     *      The size of the buffer.
+     *  @param length
+     *      The pointer to receive the length of the decoded data (nullptr
+     *      if not needed).
+     *  @param status
+     *      The status to receive the error (nullptr if not needed).
+     *  @return
+     *      False in the situations that inner_as_base64() throws.
+     */
+    bool try_inner_as_base64(
+        uint8_t *out,
+        const size_t n,
+        size_t *length,
+        xap::core::json::Status *status = nullptr
+    );
+
+    //
+    //  Public static functions.
+    //
+
+    /**
+     *  Get a 'Traverse' object and its type is 'null'.
+     *
+     *  @param path
+     *      The path.
+     *  @return
+     *      The 'Traverse' object.
+     */
+    static xap::core::json::Traverse null(const std::string &path = "/");
+
+    /**
+     *  Parse a JSON file (with the default parser of current thread).
+     * 
+     *  @note
+     *      See xap::core::json::Parser::parse_file().
+     *  @throw xap::core::json::Exception
+     *      Raised if the file can't be read or JSON parsing was failed
+     *      (ERROR_PARAMETER).
+     *  @param filename
+     *      The file name.
+     *  @param path
+     *      The path.
+     *  @return
+     *      Traverse object of the root.
+     */
+    static xap::core::json::Traverse from_file(
+        const std::string &filename,
+        const std::string &path = "/"
+    );
+
+private:
+
+    //
+    //  Friend classes.
+    //
+    friend class BindTable;
+    friend class DocumentPool;
+    friend class LinesReader;
+    friend class Parser;
+    friend class StreamParser;
+
+    //
+    //  Private constructor.
+    //
+
+    /**
+     *  Construct the object.
+     * 
+     *  @param p_traverse
+     *      The private traverse object.
+     */
+    Traverse(
+        const TraversePrivate &p_traverse
+    );
+
+    /**
+     *  Construct the object.
+     * 
+     *  @param p_traverse
+     *      The private traverse object (moved).
+     */
+    Traverse(
+        TraversePrivate &&p_traverse
+    );
+
+    /**
+     *  Construct the object.
+     * 
+     *  @param p_traverse
+     *      The private traverse object (ownership transferred).
+     */
+    Traverse(
+        std::unique_ptr<TraversePrivate> &&p_traverse
+    ) noexcept;
 
     //
     //  Members.
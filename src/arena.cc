@@ -0,0 +1,485 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+//
+//  Imports.
+//
+#include "xap/core/json/arena.h"
+#include "arena_p.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+namespace xap {
+namespace core {
+namespace json {
+
+//
+//  Constants.
+//
+
+//  Size of the header of a memory block (keeps the memory aligned).
+static const size_t ARENA_BLOCK_HEADER_SIZE =
+    alignof(max_align_t) * (
+        (sizeof(void*) + sizeof(size_t) + alignof(max_align_t) - 1U) /
+        alignof(max_align_t)
+    );
+
+//  Smallest block size.
+static const size_t ARENA_MIN_BLOCK_SIZE = 256U;
+
+//
+//  Private types.
+//
+
+/**
+ *  Owner of the chunk of a thread (that gives the chunk back when the thread
+ *  exits).
+ */
+struct ArenaChunkOwner {
+    //  The arena that owns the chunk.
+    std::weak_ptr<xap::core::json::ArenaPrivate> arena;
+
+    /**
+     *  Destruct the object.
+     */
+    ~ArenaChunkOwner() noexcept {
+        xap::core::json::ArenaPrivate::release_thread_chunk();
+    }
+};
+
+//
+//  Global variables.
+//
+
+//  The last generation of arenas.
+static std::atomic<uint64_t> g_arena_generation(0U);
+
+//  The chunk of current thread (kept apart from its owner, so that the
+//  allocation path reads a plain thread-local variable).
+static thread_local xap::core::json::ArenaChunk g_arena_chunk = {
+    0U,
+    nullptr,
+    nullptr,
+    0U
+};
+
+//  The owner of the chunk of current thread.
+static thread_local ArenaChunkOwner g_arena_chunk_owner;
+
+//
+//  Private functions.
+//
+
+/**
+ *  Get a new generation of arenas.
+ *
+ *  @return
+ *      The generation (never 0).
+ */
+static inline uint64_t next_arena_generation() noexcept {
+    return g_arena_generation.fetch_add(1U, std::memory_order_relaxed) + 1U;
+}
+
+/**
+ *  Align a pointer.
+ *
+ *  @param pointer
+ *      The pointer.
+ *  @param alignment
+ *      The alignment (must be a power of 2).
+ *  @return
+ *      The aligned address.
+ */
+static inline uintptr_t align_pointer(
+    const char *pointer,
+    const size_t alignment
+) noexcept {
+    return (
+        (reinterpret_cast<uintptr_t>(pointer) + alignment - 1U) &
+        ~(static_cast<uintptr_t>(alignment) - 1U)
+    );
+}
+
+//
+//  Arena constructor & destructor.
+//
+
+/**
+ *  Construct the object.
+ *
+ *  @param block_size
+ *      The size of each memory block.
+ */
+Arena::Arena(const size_t block_size) :
+    m_arena(std::make_shared<xap::core::json::ArenaPrivate>(block_size))
+{}
+
+/**
+ *  Construct (Copy) the object.
+ *
+ *  @note
+ *      The copy shares the memory with the source.
+ *  @param src
+ *      The source.
+ */
+Arena::Arena(const Arena &src) :
+    m_arena(src.m_arena)
+{}
+
+/**
+ *  Destruct the object.
+ */
+Arena::~Arena() noexcept {
+    //  Do nothing.
+}
+
+//
+//  Arena operators.
+//
+
+/**
+ *  Assign (Copy) the object.
+ *
+ *  @note
+ *      The object shares the memory with the source.
+ *  @param src
+ *      The source.
+ *  @return
+ *      Self.
+ */
+xap::core::json::Arena &Arena::operator=(const Arena &src) {
+    this->m_arena = src.m_arena;
+    return *this;
+}
+
+//
+//  Arena public methods.
+//
+
+/**
+ *  Allocate memory.
+ *
+ *  @throw std::bad_alloc
+ *      Raised if memory allocation was failed.
+ *  @param size
+ *      The size.
+ *  @param alignment
+ *      The alignment (must be a power of 2).
+ *  @return
+ *      The memory (owned by the arena).
+ */
+void *Arena::allocate(const size_t size, const size_t alignment) {
+    return this->m_arena->allocate(size, alignment);
+}
+
+/**
+ *  Get the size of allocated memory.
+ *
+ *  @return
+ *      The size.
+ */
+size_t Arena::get_allocated_size() const noexcept {
+    return this->m_arena->get_allocated_size();
+}
+
+/**
+ *  Get the size of memory blocks reserved by the arena.
+ *
+ *  @return
+ *      The size.
+ */
+size_t Arena::get_reserved_size() const noexcept {
+    return this->m_arena->get_reserved_size();
+}
+
+//
+//  ArenaPrivate constructor & destructor.
+//
+
+/**
+ *  Construct the object.
+ *
+ *  @param block_size
+ *      The size of each memory block.
+ */
+ArenaPrivate::ArenaPrivate(const size_t block_size) :
+    m_lock(),
+    m_generation(next_arena_generation()),
+    m_block_size(
+        block_size < ARENA_MIN_BLOCK_SIZE ? ARENA_MIN_BLOCK_SIZE : block_size
+    ),
+    m_blocks(nullptr),
+    m_cursor(nullptr),
+    m_limit(nullptr),
+    m_allocated_size(0U),
+    m_reserved_size(0U)
+{}
+
+/**
+ *  Destruct the object (and release all memory blocks).
+ */
+ArenaPrivate::~ArenaPrivate() noexcept {
+    Block *block = this->m_blocks;
+    while (block) {
+        Block *previous = block->previous;
+        free(block);
+        block = previous;
+    }
+}
+
+//
+//  ArenaPrivate public methods.
+//
+
+/**
+ *  Allocate memory.
+ *
+ *  @throw std::bad_alloc
+ *      Raised if memory allocation was failed.
+ *  @param size
+ *      The size.
+ *  @param alignment
+ *      The alignment (must be a power of 2).
+ *  @return
+ *      The memory.
+ */
+void *ArenaPrivate::allocate(const size_t size, const size_t alignment) {
+    //  Allocate from the chunk of current thread (without the lock).
+    xap::core::json::ArenaChunk &chunk = g_arena_chunk;
+    if (chunk.generation == this->m_generation) {
+        const uintptr_t aligned = align_pointer(chunk.cursor, alignment);
+        if (
+            aligned <= reinterpret_cast<uintptr_t>(chunk.limit) &&
+            size <= reinterpret_cast<uintptr_t>(chunk.limit) - aligned
+        ) {
+            chunk.cursor = reinterpret_cast<char*>(aligned) + size;
+            chunk.allocated_size += size;
+            return reinterpret_cast<void*>(aligned);
+        }
+    }
+    return this->allocate_chunk(size, alignment);
+}
+
+/**
+ *  Release all memory handed out (to be handed out again).
+ *
+ *  @note
+ *      The caller must make sure that none of the memory is still used. The
+ *      blocks are kept (up to a limit), and several blocks are merged into
+ *      one that is large enough for all of them, so that the next use of the
+ *      same size allocates nothing from the heap.
+ *  @throw std::bad_alloc
+ *      Raised if memory allocation was failed (the arena is empty then).
+ *  @param max_reserved_size
+ *      The largest size of memory blocks to be kept (all blocks are released
+ *      if they are larger).
+ */
+void ArenaPrivate::reset(const size_t max_reserved_size) {
+    std::lock_guard<std::mutex> guard(this->m_lock);
+    this->m_generation = next_arena_generation();
+    this->m_allocated_size = 0U;
+
+    //  One block (of any size) is reused as is.
+    Block *block = this->m_blocks;
+    if (
+        block &&
+        !block->previous &&
+        this->m_reserved_size <= max_reserved_size
+    ) {
+        this->m_cursor = reinterpret_cast<char*>(block) +
+                         ARENA_BLOCK_HEADER_SIZE;
+        this->m_limit = this->m_cursor + block->size;
+        return;
+    }
+
+    //  Otherwise, the blocks are released (and merged).
+    const size_t reserved_size = this->m_reserved_size;
+    while (block) {
+        Block *previous = block->previous;
+        free(block);
+        block = previous;
+    }
+    this->m_blocks = nullptr;
+    this->m_cursor = nullptr;
+    this->m_limit = nullptr;
+    this->m_reserved_size = 0U;
+    if (reserved_size == 0U || reserved_size > max_reserved_size) {
+        return;
+    }
+    const size_t size = reserved_size - ARENA_BLOCK_HEADER_SIZE;
+    this->m_cursor = this->allocate_block(size);
+    this->m_limit = this->m_cursor + size;
+}
+
+/**
+ *  Get the size of allocated memory.
+ *
+ *  @note
+ *      The memory allocated by other threads is counted once they switch to
+ *      another chunk (or exit).
+ *  @return
+ *      The size.
+ */
+size_t ArenaPrivate::get_allocated_size() const noexcept {
+    std::lock_guard<std::mutex> guard(this->m_lock);
+    const xap::core::json::ArenaChunk &chunk = g_arena_chunk;
+    if (chunk.generation == this->m_generation) {
+        return this->m_allocated_size + chunk.allocated_size;
+    }
+    return this->m_allocated_size;
+}
+
+/**
+ *  Get the size of memory blocks.
+ *
+ *  @return
+ *      The size.
+ */
+size_t ArenaPrivate::get_reserved_size() const noexcept {
+    std::lock_guard<std::mutex> guard(this->m_lock);
+    return this->m_reserved_size;
+}
+
+//
+//  ArenaPrivate public static functions.
+//
+
+/**
+ *  Give the chunk of current thread back to its arena.
+ */
+void ArenaPrivate::release_thread_chunk() noexcept {
+    xap::core::json::ArenaChunk &chunk = g_arena_chunk;
+    if (chunk.generation == 0U) {
+        return;
+    }
+    std::shared_ptr<xap::core::json::ArenaPrivate> arena =
+        g_arena_chunk_owner.arena.lock();
+    g_arena_chunk_owner.arena.reset();
+    if (!arena) {
+        chunk = {0U, nullptr, nullptr, 0U};
+        return;
+    }
+    std::lock_guard<std::mutex> guard(arena->m_lock);
+    arena->merge_chunk(&chunk);
+}
+
+//
+//  ArenaPrivate private methods.
+//
+
+/**
+ *  Allocate a memory block.
+ *
+ *  @throw std::bad_alloc
+ *      Raised if memory allocation was failed.
+ *  @param size
+ *      The size of the block (excluding the header).
+ *  @return
+ *      The beginning of the usable memory of the block.
+ */
+char *ArenaPrivate::allocate_block(const size_t size) {
+    Block *block = static_cast<Block*>(malloc(ARENA_BLOCK_HEADER_SIZE + size));
+    if (!block) {
+        throw std::bad_alloc();
+    }
+    block->previous = this->m_blocks;
+    block->size = size;
+    this->m_blocks = block;
+    this->m_reserved_size += ARENA_BLOCK_HEADER_SIZE + size;
+    return reinterpret_cast<char*>(block) + ARENA_BLOCK_HEADER_SIZE;
+}
+
+/**
+ *  Allocate memory from a new chunk (or a block of its own).
+ *
+ *  @throw std::bad_alloc
+ *      Raised if memory allocation was failed.
+ *  @param size
+ *      The size.
+ *  @param alignment
+ *      The alignment (must be a power of 2).
+ *  @return
+ *      The memory.
+ */
+void *ArenaPrivate::allocate_chunk(const size_t size, const size_t alignment) {
+    //  Give the chunk of another arena (or of a rewound one) back first.
+    xap::core::json::ArenaChunk &chunk = g_arena_chunk;
+    if (chunk.generation != this->m_generation) {
+        ArenaPrivate::release_thread_chunk();
+    }
+    std::lock_guard<std::mutex> guard(this->m_lock);
+
+    //  Large allocations get blocks of their own (so that the free space of
+    //  the chunk is not wasted).
+    const size_t padding = (
+        alignment > alignof(max_align_t) ? alignment - 1U : 0U
+    );
+    if (size > static_cast<size_t>(-1) - padding - ARENA_BLOCK_HEADER_SIZE) {
+        throw std::bad_alloc();
+    }
+    if (size + padding > this->m_block_size / 4U) {
+        char *memory = this->allocate_block(size + padding);
+        this->m_allocated_size += size;
+        return reinterpret_cast<void*>(align_pointer(memory, alignment));
+    }
+
+    //  Give the rest of the chunk back, and take the free space of the arena
+    //  (or a new block) as the chunk.
+    this->merge_chunk(&chunk);
+    uintptr_t aligned = align_pointer(this->m_cursor, alignment);
+    if (
+        !this->m_cursor ||
+        aligned > reinterpret_cast<uintptr_t>(this->m_limit) ||
+        size > reinterpret_cast<uintptr_t>(this->m_limit) - aligned
+    ) {
+        char *memory = this->allocate_block(this->m_block_size);
+        aligned = align_pointer(memory, alignment);
+        this->m_cursor = memory;
+        this->m_limit = memory + this->m_block_size;
+    }
+    g_arena_chunk_owner.arena = this->shared_from_this();
+    chunk.generation = this->m_generation;
+    chunk.cursor = reinterpret_cast<char*>(aligned) + size;
+    chunk.limit = this->m_limit;
+    chunk.allocated_size = 0U;
+    this->m_cursor = nullptr;
+    this->m_limit = nullptr;
+    this->m_allocated_size += size;
+    return reinterpret_cast<void*>(aligned);
+}
+
+/**
+ *  Take a chunk back (the lock must be held).
+ *
+ *  @note
+ *      The arena keeps the larger one of its free space and the rest of the
+ *      chunk. The chunk is emptied (even if it is not owned by the arena).
+ *  @param chunk
+ *      The chunk.
+ */
+void ArenaPrivate::merge_chunk(xap::core::json::ArenaChunk *chunk) noexcept {
+    if (chunk->generation == this->m_generation) {
+        this->m_allocated_size += chunk->allocated_size;
+        if (
+            !this->m_cursor ||
+            chunk->limit - chunk->cursor > this->m_limit - this->m_cursor
+        ) {
+            this->m_cursor = chunk->cursor;
+            this->m_limit = chunk->limit;
+        }
+    }
+    *chunk = {0U, nullptr, nullptr, 0U};
+}
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
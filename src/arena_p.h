@@ -0,0 +1,367 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+#ifndef XAP_CORE_JSON_ARENA_P_H__
+#define XAP_CORE_JSON_ARENA_P_H__
+
+//
+//  Imports.
+//
+#include "xap/core/json/build.h"
+
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+namespace xap {
+namespace core {
+namespace json {
+
+//
+//  Structures.
+//
+
+/**
+ *  Memory that a thread bump-allocates from (without locking the arena).
+ */
+struct ArenaChunk {
+    //  The generation of the arena that owns the chunk (0 if none).
+    uint64_t generation;
+
+    //  The free memory of the chunk.
+    char *cursor;
+    char *limit;
+
+    //  The size allocated from the chunk (not added to the arena yet).
+    size_t allocated_size;
+};
+
+//
+//  Classes.
+//
+
+/**
+ *  Private arena.
+ *
+ *  @note
+ *      Each thread allocates from a chunk of its own (the free space of a
+ *      block that it took from the arena), so the lock is only taken when a
+ *      thread switches to another chunk (or allocates a large object). The
+ *      generation of an arena is unique among all arenas and changes when
+ *      the arena is rewound, so a chunk that is left behind by an arena that
+ *      was rewound (or destructed) is never used again. An arena must be
+ *      owned by a std::shared_ptr, so that a thread can give its chunk back.
+ */
+class ArenaPrivate :
+    public std::enable_shared_from_this<xap::core::json::ArenaPrivate>
+{
+public:
+
+    /**
+     *  Construct the object.
+     *
+     *  @param block_size
+     *      The size of each memory block.
+     */
+    explicit ArenaPrivate(const size_t block_size);
+
+    /**
+     *  Destruct the object (and release all memory blocks).
+     */
+    virtual ~ArenaPrivate() noexcept;
+
+    //
+    //  Public methods.
+    //
+
+    /**
+     *  Allocate memory.
+     *
+     *  @throw std::bad_alloc
+     *      Raised if memory allocation was failed.
+     *  @param size
+     *      The size.
+     *  @param alignment
+     *      The alignment (must be a power of 2).
+     *  @return
+     *      The memory.
+     */
+    void *allocate(const size_t size, const size_t alignment);
+
+    /**
+     *  Release all memory handed out (to be handed out again).
+     *
+     *  @note
+     *      The caller must make sure that none of the memory is still used.
+     *      Several blocks are merged into one, so the next use of the same
+     *      size allocates nothing from the heap.
+     *  @throw std::bad_alloc
+     *      Raised if memory allocation was failed (the arena is empty then).
+     *  @param max_reserved_size
+     *      The largest size of memory blocks to be kept (all blocks are
+     *      released if they are larger).
+     */
+    void reset(const size_t max_reserved_size);
+
+    /**
+     *  Get the size of allocated memory.
+     *
+     *  @return
+     *      The size.
+     */
+    size_t get_allocated_size() const noexcept;
+
+    /**
+     *  Get the size of memory blocks.
+     *
+     *  @return
+     *      The size.
+     */
+    size_t get_reserved_size() const noexcept;
+
+    //
+    //  Public static functions.
+    //
+
+    /**
+     *  Give the chunk of current thread back to its arena.
+     */
+    static void release_thread_chunk() noexcept;
+
+private:
+
+    //
+    //  Private types.
+    //
+
+    /**
+     *  Header of a memory block.
+     */
+    struct Block {
+        //  The previous block.
+        Block *previous;
+
+        //  The size of the block (excluding the header).
+        size_t size;
+    };
+
+    //
+    //  Private methods.
+    //
+
+    /**
+     *  Allocate a memory block.
+     *
+     *  @throw std::bad_alloc
+     *      Raised if memory allocation was failed.
+     *  @param size
+     *      The size of the block (excluding the header).
+     *  @return
+     *      The beginning of the usable memory of the block.
+     */
+    char *allocate_block(const size_t size);
+
+    /**
+     *  Allocate memory from a new chunk (or a block of its own).
+     *
+     *  @throw std::bad_alloc
+     *      Raised if memory allocation was failed.
+     *  @param size
+     *      The size.
+     *  @param alignment
+     *      The alignment (must be a power of 2).
+     *  @return
+     *      The memory.
+     */
+    void *allocate_chunk(const size_t size, const size_t alignment);
+
+    /**
+     *  Take a chunk back (the lock must be held).
+     *
+     *  @note
+     *      The arena keeps the larger one of its free space and the rest of
+     *      the chunk. The chunk is emptied (even if it is not owned by the
+     *      arena).
+     *  @param chunk
+     *      The chunk.
+     */
+    void merge_chunk(xap::core::json::ArenaChunk *chunk) noexcept;
+
+    //
+    //  Private members.
+    //
+    mutable std::mutex m_lock;
+    uint64_t m_generation;
+    size_t m_block_size;
+    Block *m_blocks;
+    char *m_cursor;
+    char *m_limit;
+    size_t m_allocated_size;
+    size_t m_reserved_size;
+
+    //
+    //  Private constructor.
+    //
+    ArenaPrivate(const ArenaPrivate &) = delete;
+    ArenaPrivate &operator=(const ArenaPrivate &) = delete;
+};
+
+/**
+ *  Allocator (STL-compatible) that allocates from an arena.
+ *
+ *  @note
+ *      The allocator allocates from the heap if it has no arena. Otherwise,
+ *      deallocation does nothing and the allocator keeps the arena alive, so
+ *      the containers (and std::shared_ptr control blocks) that use it can
+ *      never outlive the arena.
+ */
+template <typename T>
+class ArenaAllocator {
+public:
+
+    //
+    //  Public types.
+    //
+    typedef T value_type;
+
+    /**
+     *  Construct the object (that allocates from the heap).
+     */
+    ArenaAllocator() noexcept :
+        m_arena()
+    {}
+
+    /**
+     *  Construct the object.
+     *
+     *  @param arena
+     *      The arena (nullptr to allocate from the heap).
+     */
+    explicit ArenaAllocator(
+        const std::shared_ptr<xap::core::json::ArenaPrivate> &arena
+    ) noexcept :
+        m_arena(arena)
+    {}
+
+    /**
+     *  Construct (Convert) the object.
+     *
+     *  @param src
+     *      The source.
+     */
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U> &src) noexcept :
+        m_arena(src.get_arena())
+    {}
+
+    //
+    //  Public methods.
+    //
+
+    /**
+     *  Allocate memory.
+     *
+     *  @throw std::bad_alloc
+     *      Raised if memory allocation was failed.
+     *  @param count
+     *      The count of objects.
+     *  @return
+     *      The memory.
+     */
+    T *allocate(const size_t count) {
+        if (count > static_cast<size_t>(-1) / sizeof(T)) {
+            throw std::bad_alloc();
+        }
+        if (!this->m_arena) {
+            return static_cast<T*>(::operator new(count * sizeof(T)));
+        }
+        return static_cast<T*>(
+            this->m_arena->allocate(count * sizeof(T), alignof(T))
+        );
+    }
+
+    /**
+     *  Deallocate memory.
+     *
+     *  @param pointer
+     *      The memory.
+     *  @param count
+     *      The count of objects.
+     */
+    void deallocate(T *pointer, const size_t count) noexcept {
+        (void)count;
+        if (!this->m_arena) {
+            ::operator delete(pointer);
+        }
+    }
+
+    /**
+     *  Get the arena.
+     *
+     *  @return
+     *      The arena (nullptr if the allocator allocates from the heap).
+     */
+    const std::shared_ptr<xap::core::json::ArenaPrivate> &
+    get_arena() const noexcept {
+        return this->m_arena;
+    }
+
+private:
+
+    //
+    //  Private members.
+    //
+    std::shared_ptr<xap::core::json::ArenaPrivate> m_arena;
+};
+
+//
+//  Operators.
+//
+
+/**
+ *  Check whether two allocators are interchangeable.
+ *
+ *  @param a
+ *      The first allocator.
+ *  @param b
+ *      The second allocator.
+ *  @return
+ *      True if so.
+ */
+template <typename T, typename U>
+bool operator==(
+    const ArenaAllocator<T> &a,
+    const ArenaAllocator<U> &b
+) noexcept {
+    return a.get_arena() == b.get_arena();
+}
+
+/**
+ *  Check whether two allocators are not interchangeable.
+ *
+ *  @param a
+ *      The first allocator.
+ *  @param b
+ *      The second allocator.
+ *  @return
+ *      True if so.
+ */
+template <typename T, typename U>
+bool operator!=(
+    const ArenaAllocator<T> &a,
+    const ArenaAllocator<U> &b
+) noexcept {
+    return a.get_arena() != b.get_arena();
+}
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
+
+#endif  //  #ifndef XAP_CORE_JSON_ARENA_P_H__
@@ -0,0 +1,452 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+//
+//  Imports.
+//
+#include "base64_p.h"
+#include "scanner_p.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+# define XAPCORE_JSON_BASE64_X86
+# include <immintrin.h>
+#endif  //  #if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+
+namespace xap {
+namespace core {
+namespace json {
+
+//
+//  Constants.
+//
+
+//  6-bit values of the characters (0xFF if out of the alphabet).
+static const uint8_t BASE64_VALUES[256] = {
+    0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU,
+    0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU,
+    0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU,
+    0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU,
+    0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU,
+    0xFFU, 0xFFU, 0xFFU, 0x3EU, 0xFFU, 0xFFU, 0xFFU, 0x3FU,
+    0x34U, 0x35U, 0x36U, 0x37U, 0x38U, 0x39U, 0x3AU, 0x3BU,
+    0x3CU, 0x3DU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU,
+    0xFFU, 0x00U, 0x01U, 0x02U, 0x03U, 0x04U, 0x05U, 0x06U,
+    0x07U, 0x08U, 0x09U, 0x0AU, 0x0BU, 0x0CU, 0x0DU, 0x0EU,
+    0x0FU, 0x10U, 0x11U, 0x12U, 0x13U, 0x14U, 0x15U, 0x16U,
+    0x17U, 0x18U, 0x19U, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU,
+    0xFFU, 0x1AU, 0x1BU, 0x1CU, 0x1DU, 0x1EU, 0x1FU, 0x20U,
+    0x21U, 0x22U, 0x23U, 0x24U, 0x25U, 0x26U, 0x27U, 0x28U,
+    0x29U, 0x2AU, 0x2BU, 0x2CU, 0x2DU, 0x2EU, 0x2FU, 0x30U,
+    0x31U, 0x32U, 0x33U, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU,
+    0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU,
+    0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU,
+    0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU,
+    0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU,
+    0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU,
+    0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU,
+    0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU,
+    0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU,
+    0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU,
+    0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU,
+    0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU,
+    0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU,
+    0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU,
+    0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU,
+    0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU,
+    0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU
+};
+
+#if defined(XAPCORE_JSON_BASE64_X86)
+
+//  Classes by the low nibble of a character (a character is out of the
+//  alphabet if the classes of its nibbles intersect).
+static const uint8_t BASE64_LOW_CLASSES[16] = {
+    0x15U, 0x11U, 0x11U, 0x11U, 0x11U, 0x11U, 0x11U, 0x11U,
+    0x11U, 0x11U, 0x13U, 0x1AU, 0x1BU, 0x1BU, 0x1BU, 0x1AU
+};
+
+//  Classes by the high nibble of a character.
+static const uint8_t BASE64_HIGH_CLASSES[16] = {
+    0x10U, 0x10U, 0x01U, 0x02U, 0x04U, 0x08U, 0x04U, 0x08U,
+    0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U, 0x10U
+};
+
+//  Offsets from the characters to their values by the high nibble (the
+//  index of '/' is moved down by one).
+static const int8_t BASE64_OFFSETS[16] = {
+    0, 16, 19, 4, -65, -65, -71, -71,
+    0, 0, 0, 0, 0, 0, 0, 0
+};
+
+//  Order of the decoded bytes within each 32-bit group (big-endian).
+static const int8_t BASE64_PACK_ORDER[16] = {
+    2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1
+};
+
+#endif  //  #if defined(XAPCORE_JSON_BASE64_X86)
+
+//
+//  Private functions.
+//
+
+/**
+ *  Decode an input (scalar).
+ *
+ *  @param data
+ *      The input (without padding).
+ *  @param length
+ *      The length of the input (must not be 4k + 1).
+ *  @param out
+ *      The buffer to receive the decoded bytes.
+ *  @return
+ *      True if valid.
+ */
+static bool decode_scalar(
+    const uint8_t *data,
+    const size_t length,
+    uint8_t *out
+) {
+    //  Out-of-alphabet values have the high bit set, so the values are
+    //  checked once at the end.
+    uint32_t error = 0U;
+    size_t position = 0U;
+    for (; length - position >= 4U; position += 4U) {
+        const uint32_t a = BASE64_VALUES[data[position]];
+        const uint32_t b = BASE64_VALUES[data[position + 1U]];
+        const uint32_t c = BASE64_VALUES[data[position + 2U]];
+        const uint32_t d = BASE64_VALUES[data[position + 3U]];
+        error |= a | b | c | d;
+        const uint32_t bits = (a << 18U) | (b << 12U) | (c << 6U) | d;
+        out[0] = static_cast<uint8_t>(bits >> 16U);
+        out[1] = static_cast<uint8_t>(bits >> 8U);
+        out[2] = static_cast<uint8_t>(bits);
+        out += 3U;
+    }
+
+    switch (length - position) {
+        case 2U: {
+            const uint32_t a = BASE64_VALUES[data[position]];
+            const uint32_t b = BASE64_VALUES[data[position + 1U]];
+            error |= a | b;
+            out[0] = static_cast<uint8_t>((a << 2U) | (b >> 4U));
+            break;
+        }
+        case 3U: {
+            const uint32_t a = BASE64_VALUES[data[position]];
+            const uint32_t b = BASE64_VALUES[data[position + 1U]];
+            const uint32_t c = BASE64_VALUES[data[position + 2U]];
+            error |= a | b | c;
+            const uint32_t bits = (a << 10U) | (b << 4U) | (c >> 2U);
+            out[0] = static_cast<uint8_t>(bits >> 8U);
+            out[1] = static_cast<uint8_t>(bits);
+            break;
+        }
+        default:
+            break;
+    }
+    return (error & 0x80U) == 0U;
+}
+
+#if defined(XAPCORE_JSON_BASE64_X86)
+
+/**
+ *  Decode an input (SSE4.2).
+ *
+ *  @param data
+ *      The input (without padding).
+ *  @param length
+ *      The length of the input (must not be 4k + 1).
+ *  @param out
+ *      The buffer to receive the decoded bytes.
+ *  @return
+ *      True if valid.
+ */
+__attribute__((target("sse4.2")))
+static bool decode_sse42(
+    const uint8_t *data,
+    const size_t length,
+    uint8_t *out
+) {
+    const __m128i low_nibble = _mm_set1_epi8(0x0F);
+    const __m128i slash = _mm_set1_epi8('/');
+    const __m128i low_classes = _mm_loadu_si128(
+        reinterpret_cast<const __m128i *>(BASE64_LOW_CLASSES)
+    );
+    const __m128i high_classes = _mm_loadu_si128(
+        reinterpret_cast<const __m128i *>(BASE64_HIGH_CLASSES)
+    );
+    const __m128i offsets = _mm_loadu_si128(
+        reinterpret_cast<const __m128i *>(BASE64_OFFSETS)
+    );
+    const __m128i pack_order = _mm_loadu_si128(
+        reinterpret_cast<const __m128i *>(BASE64_PACK_ORDER)
+    );
+
+    //  Each chunk of 16 characters stores 16 bytes (12 decoded), so at
+    //  least 6 characters (4 bytes) must follow.
+    __m128i error = _mm_setzero_si128();
+    size_t position = 0U;
+    for (; length - position >= 16U + 6U; position += 16U) {
+        const __m128i input = _mm_loadu_si128(
+            reinterpret_cast<const __m128i *>(data + position)
+        );
+        const __m128i high = _mm_and_si128(
+            _mm_srli_epi32(input, 4),
+            low_nibble
+        );
+        const __m128i low = _mm_and_si128(input, low_nibble);
+        error = _mm_or_si128(error, _mm_and_si128(
+            _mm_shuffle_epi8(low_classes, low),
+            _mm_shuffle_epi8(high_classes, high)
+        ));
+
+        //  Translate to 6-bit values.
+        const __m128i values = _mm_add_epi8(input, _mm_shuffle_epi8(
+            offsets,
+            _mm_add_epi8(_mm_cmpeq_epi8(input, slash), high)
+        ));
+
+        //  Pack 4 values (24 bits) into each 32-bit group.
+        const __m128i pairs = _mm_maddubs_epi16(
+            values,
+            _mm_set1_epi32(0x01400140)
+        );
+        const __m128i groups = _mm_madd_epi16(
+            pairs,
+            _mm_set1_epi32(0x00011000)
+        );
+        _mm_storeu_si128(
+            reinterpret_cast<__m128i *>(out),
+            _mm_shuffle_epi8(groups, pack_order)
+        );
+        out += 12U;
+    }
+    if (!_mm_testz_si128(error, error)) {
+        return false;
+    }
+    return decode_scalar(data + position, length - position, out);
+}
+
+/**
+ *  Decode an input (AVX2).
+ *
+ *  @param data
+ *      The input (without padding).
+ *  @param length
+ *      The length of the input (must not be 4k + 1).
+ *  @param out
+ *      The buffer to receive the decoded bytes.
+ *  @return
+ *      True if valid.
+ */
+__attribute__((target("avx2")))
+static bool decode_avx2(
+    const uint8_t *data,
+    const size_t length,
+    uint8_t *out
+) {
+    const __m256i low_nibble = _mm256_set1_epi8(0x0F);
+    const __m256i slash = _mm256_set1_epi8('/');
+    const __m256i low_classes = _mm256_broadcastsi128_si256(_mm_loadu_si128(
+        reinterpret_cast<const __m128i *>(BASE64_LOW_CLASSES)
+    ));
+    const __m256i high_classes = _mm256_broadcastsi128_si256(_mm_loadu_si128(
+        reinterpret_cast<const __m128i *>(BASE64_HIGH_CLASSES)
+    ));
+    const __m256i offsets = _mm256_broadcastsi128_si256(_mm_loadu_si128(
+        reinterpret_cast<const __m128i *>(BASE64_OFFSETS)
+    ));
+    const __m256i pack_order = _mm256_broadcastsi128_si256(_mm_loadu_si128(
+        reinterpret_cast<const __m128i *>(BASE64_PACK_ORDER)
+    ));
+    const __m256i lane_order = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7);
+
+    //  Each chunk of 32 characters stores 32 bytes (24 decoded), so at
+    //  least 11 characters (8 bytes) must follow.
+    __m256i error = _mm256_setzero_si256();
+    size_t position = 0U;
+    for (; length - position >= 32U + 11U; position += 32U) {
+        const __m256i input = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(data + position)
+        );
+        const __m256i high = _mm256_and_si256(
+            _mm256_srli_epi32(input, 4),
+            low_nibble
+        );
+        const __m256i low = _mm256_and_si256(input, low_nibble);
+        error = _mm256_or_si256(error, _mm256_and_si256(
+            _mm256_shuffle_epi8(low_classes, low),
+            _mm256_shuffle_epi8(high_classes, high)
+        ));
+
+        //  Translate to 6-bit values.
+        const __m256i values = _mm256_add_epi8(input, _mm256_shuffle_epi8(
+            offsets,
+            _mm256_add_epi8(_mm256_cmpeq_epi8(input, slash), high)
+        ));
+
+        //  Pack 4 values (24 bits) into each 32-bit group, then join the
+        //  12 bytes of both 128-bit lanes.
+        const __m256i pairs = _mm256_maddubs_epi16(
+            values,
+            _mm256_set1_epi32(0x01400140)
+        );
+        const __m256i groups = _mm256_madd_epi16(
+            pairs,
+            _mm256_set1_epi32(0x00011000)
+        );
+        _mm256_storeu_si256(
+            reinterpret_cast<__m256i *>(out),
+            _mm256_permutevar8x32_epi32(
+                _mm256_shuffle_epi8(groups, pack_order),
+                lane_order
+            )
+        );
+        out += 24U;
+    }
+    if (!_mm256_testz_si256(error, error)) {
+        return false;
+    }
+    return decode_scalar(data + position, length - position, out);
+}
+
+#endif  //  #if defined(XAPCORE_JSON_BASE64_X86)
+
+//
+//  Base64Decoder constructor & destructor.
+//
+
+/**
+ *  Construct the object (with the best kernel of current CPU).
+ */
+Base64Decoder::Base64Decoder() :
+    Base64Decoder(xap::core::json::StructuralScanner::get_best_kernel())
+{}
+
+/**
+ *  Construct the object.
+ *
+ *  @param kernel
+ *      The kernel (must be supported by current CPU).
+ */
+Base64Decoder::Base64Decoder(const xap::core::json::ScannerKernel kernel) :
+    m_kernel(kernel),
+    m_decode(decode_scalar)
+{
+#if defined(XAPCORE_JSON_BASE64_X86)
+    switch (kernel) {
+        case xap::core::json::ScannerKernel::sse42:
+            this->m_decode = decode_sse42;
+            break;
+        case xap::core::json::ScannerKernel::avx2:
+            this->m_decode = decode_avx2;
+            break;
+        default:
+            break;
+    }
+#else
+    this->m_kernel = xap::core::json::ScannerKernel::scalar;
+#endif  //  #if defined(XAPCORE_JSON_BASE64_X86)
+}
+
+/**
+ *  Destruct the object.
+ */
+Base64Decoder::~Base64Decoder() noexcept {
+    //  Do nothing.
+}
+
+//
+//  Base64Decoder public methods.
+//
+
+/**
+ *  Decode an input (without padding, see measure()).
+ *
+ *  @param data
+ *      The input.
+ *  @param length
+ *      The length of the input (must not be 4k + 1).
+ *  @param out
+ *      The buffer to receive the decoded bytes (at least length * 3 / 4
+ *      bytes).
+ *  @return
+ *      False if the input contains a character out of the alphabet.
+ */
+bool Base64Decoder::decode(
+    const char *data,
+    const size_t length,
+    uint8_t *out
+) const noexcept {
+    return this->m_decode(
+        reinterpret_cast<const uint8_t *>(data),
+        length,
+        out
+    );
+}
+
+/**
+ *  Get the kernel.
+ *
+ *  @return
+ *      The kernel.
+ */
+xap::core::json::ScannerKernel Base64Decoder::get_kernel() const noexcept {
+    return this->m_kernel;
+}
+
+//
+//  Base64Decoder public static functions.
+//
+
+/**
+ *  Measure an input.
+ *
+ *  @param data
+ *      The input.
+ *  @param length
+ *      The length of the input.
+ *  @param data_length
+ *      The pointer to receive the length of the input without padding.
+ *  @param size
+ *      The pointer to receive the count of decoded bytes.
+ *  @return
+ *      False if the length (or the padding) is invalid.
+ */
+bool Base64Decoder::measure(
+    const char *data,
+    const size_t length,
+    size_t *data_length,
+    size_t *size
+) noexcept {
+    size_t stripped = length;
+    if (stripped != 0U && data[stripped - 1U] == '=') {
+        --stripped;
+        if (stripped != 0U && data[stripped - 1U] == '=') {
+            --stripped;
+        }
+        if (length % 4U != 0U) {
+            return false;
+        }
+    }
+    if (stripped % 4U == 1U) {
+        return false;
+    }
+    *data_length = stripped;
+    *size = stripped / 4U * 3U;
+    if (stripped % 4U != 0U) {
+        //  2 or 3 characters make 1 or 2 bytes.
+        *size += stripped % 4U - 1U;
+    }
+    return true;
+}
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
@@ -0,0 +1,146 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+#ifndef XAP_CORE_JSON_BASE64_P_H__
+#define XAP_CORE_JSON_BASE64_P_H__
+
+//
+//  Imports.
+//
+#include "xap/core/json/build.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+namespace xap {
+namespace core {
+namespace json {
+
+//
+//  Declare.
+//
+enum ScannerKernel: uint8_t;
+
+//
+//  Classes.
+//
+
+/**
+ *  Base64 decoder (RFC 4648, standard alphabet).
+ *
+ *  @note
+ *      The decoder uses the same kernels as the structural scanner. The SIMD
+ *      kernels validate and translate 16 (or 32) characters at a time with
+ *      two table lookups on the nibbles of each character, then pack the
+ *      6-bit values with two multiply-adds and a shuffle. The scalar kernel
+ *      (which also decodes the tail) translates a character at a time.
+ *
+ *      The padding is optional, but if present the input must be a multiple
+ *      of 4 characters. Whitespaces are not allowed. The unused bits of the
+ *      last character are ignored.
+ */
+class Base64Decoder {
+public:
+
+    /**
+     *  Construct the object (with the best kernel of current CPU).
+     */
+    Base64Decoder();
+
+    /**
+     *  Construct the object.
+     *
+     *  @param kernel
+     *      The kernel (must be supported by current CPU).
+     */
+    explicit Base64Decoder(const xap::core::json::ScannerKernel kernel);
+
+    /**
+     *  Destruct the object.
+     */
+    virtual ~Base64Decoder() noexcept;
+
+    //
+    //  Public methods.
+    //
+
+    /**
+     *  Decode an input (without padding, see measure()).
+     *
+     *  @note
+     *      The output is unspecified if the input is invalid.
+     *  @param data
+     *      The input.
+     *  @param length
+     *      The length of the input (must not be 4k + 1).
+     *  @param out
+     *      The buffer to receive the decoded bytes (at least length * 3 / 4
+     *      bytes).
+     *  @return
+     *      False if the input contains a character out of the alphabet.
+     */
+    bool decode(
+        const char *data,
+        const size_t length,
+        uint8_t *out
+    ) const noexcept;
+
+    /**
+     *  Get the kernel.
+     *
+     *  @return
+     *      The kernel.
+     */
+    xap::core::json::ScannerKernel get_kernel() const noexcept;
+
+    //
+    //  Public static functions.
+    //
+
+    /**
+     *  Measure an input.
+     *
+     *  @param data
+     *      The input.
+     *  @param length
+     *      The length of the input.
+     *  @param data_length
+     *      The pointer to receive the length of the input without padding.
+     *  @param size
+     *      The pointer to receive the count of decoded bytes.
+     *  @return
+     *      False if the length (or the padding) is invalid.
+     */
+    static bool measure(
+        const char *data,
+        const size_t length,
+        size_t *data_length,
+        size_t *size
+    ) noexcept;
+
+private:
+
+    //
+    //  Private types.
+    //
+    typedef bool (*DecodeFunction)(
+        const uint8_t *data,
+        const size_t length,
+        uint8_t *out
+    );
+
+    //
+    //  Private members.
+    //
+    xap::core::json::ScannerKernel m_kernel;
+    DecodeFunction m_decode;
+};
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
+
+#endif  //  #ifndef XAP_CORE_JSON_BASE64_P_H__
@@ -0,0 +1,216 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+//
+//  Imports.
+//
+#include "xap/core/json/bind.h"
+#include "bind_p.h"
+#include "document_p.h"
+#include "traverse_p.h"
+#include "xap/core/json/error.h"
+
+#include <memory>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+namespace xap {
+namespace core {
+namespace json {
+
+//
+//  Constants.
+//
+
+//  Smallest count of slots of a binding table.
+static const size_t BIND_TABLE_MIN_SLOTS = 16U;
+
+//
+//  BindTable constructor & destructor.
+//
+
+/**
+ *  Construct the object.
+ *
+ *  @throw xap::core::json::Exception
+ *      Raised if a key is duplicated (ERROR_PARAMETER).
+ *  @param entries
+ *      The entries of the fields.
+ */
+BindTable::BindTable(const std::vector<Entry> &entries) :
+    m_table(new xap::core::json::BindTablePrivate(entries))
+{}
+
+/**
+ *  Destruct the object.
+ */
+BindTable::~BindTable() noexcept {
+    //  Do nothing.
+}
+
+//
+//  BindTable public methods.
+//
+
+/**
+ *  Bind a structure to a JSON object.
+ *
+ *  @throw xap::core::json::Exception
+ *      Raised in the situations described by the declaration.
+ *  @param root
+ *      The JSON object.
+ *  @param object
+ *      The structure (partially written if failed).
+ */
+void BindTable::bind(xap::core::json::Traverse &root, void *object) const {
+    xap::core::json::Status status;
+    if (!root.m_traverse->try_bind(*this, object, &status)) {
+        status.raise();
+    }
+}
+
+/**
+ *  Bind a structure to a JSON object (without throwing).
+ *
+ *  @param root
+ *      The JSON object.
+ *  @param object
+ *      The structure (partially written if failed).
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
+ *  @return
+ *      False in the situations that BindTable::bind() throws.
+ */
+bool BindTable::try_bind(
+    xap::core::json::Traverse &root,
+    void *object,
+    xap::core::json::Status *status
+) const {
+    if (status) {
+        status->clear();
+    }
+    return root.m_traverse->try_bind(*this, object, status);
+}
+
+//
+//  BindTablePrivate constructor & destructor.
+//
+
+/**
+ *  Construct the object.
+ *
+ *  @throw xap::core::json::Exception
+ *      Raised if a key is duplicated (ERROR_PARAMETER).
+ *  @param entries
+ *      The entries of the fields.
+ */
+BindTablePrivate::BindTablePrivate(
+    const std::vector<xap::core::json::BindTable::Entry> &entries
+) :
+    m_entries(entries),
+    m_hashes(),
+    m_slots(),
+    m_mask(0U)
+{
+    //  Keep the table half empty at most.
+    size_t slot_count = BIND_TABLE_MIN_SLOTS;
+    while (slot_count < entries.size() * 2U) {
+        slot_count *= 2U;
+    }
+    this->m_mask = slot_count - 1U;
+    this->m_slots.assign(slot_count, 0U);
+    this->m_hashes.reserve(entries.size());
+
+    for (size_t i = 0U; i < entries.size(); ++i) {
+        const xap::core::json::BindTable::Entry &entry = entries[i];
+        if (this->find(entry.key, entry.key_length) != NPOS) {
+            throw xap::core::json::Exception(
+                "Duplicate field.",
+                xap::core::json::ERROR_PARAMETER,
+                entry.key
+            );
+        }
+
+        const uint64_t key_hash = xap::core::json::Document::hash_key(
+            entry.key,
+            entry.key_length
+        );
+        this->m_hashes.push_back(key_hash);
+        size_t slot = static_cast<size_t>(key_hash) & this->m_mask;
+        while (this->m_slots[slot] != 0U) {
+            slot = (slot + 1U) & this->m_mask;
+        }
+        this->m_slots[slot] = static_cast<uint32_t>(i + 1U);
+    }
+}
+
+/**
+ *  Destruct the object.
+ */
+BindTablePrivate::~BindTablePrivate() noexcept {
+    //  Do nothing.
+}
+
+//
+//  BindTablePrivate public methods.
+//
+
+/**
+ *  Find the field of a key.
+ *
+ *  @param key
+ *      The key.
+ *  @param key_len
+ *      The length of the key.
+ *  @return
+ *      The index of the field (NPOS if no field matches).
+ */
+size_t BindTablePrivate::find(
+    const char *key,
+    const size_t key_len
+) const noexcept {
+    const uint64_t key_hash = xap::core::json::Document::hash_key(
+        key,
+        key_len
+    );
+    size_t slot = static_cast<size_t>(key_hash) & this->m_mask;
+    while (true) {
+        const uint32_t current = this->m_slots[slot];
+        if (current == 0U) {
+            return NPOS;
+        }
+        const size_t index = static_cast<size_t>(current - 1U);
+        const xap::core::json::BindTable::Entry &entry =
+            this->m_entries[index];
+        if (
+            this->m_hashes[index] == key_hash &&
+            entry.key_length == key_len &&
+            memcmp(entry.key, key, key_len) == 0
+        ) {
+            return index;
+        }
+        slot = (slot + 1U) & this->m_mask;
+    }
+}
+
+/**
+ *  Get the entries of the fields.
+ *
+ *  @return
+ *      The entries.
+ */
+const std::vector<xap::core::json::BindTable::Entry> &
+BindTablePrivate::get_entries() const noexcept {
+    return this->m_entries;
+}
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
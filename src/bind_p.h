@@ -0,0 +1,156 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+#ifndef XAP_CORE_JSON_BIND_P_H__
+#define XAP_CORE_JSON_BIND_P_H__
+
+//
+//  Imports.
+//
+#include "xap/core/json/bind.h"
+#include "xap/core/json/build.h"
+#include "xap/core/json/status.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <vector>
+
+namespace xap {
+namespace core {
+namespace json {
+
+//
+//  Declare.
+//
+class BindTablePrivate;
+class ExtractField;
+class TraversePrivate;
+struct SchemaFrame;
+
+//
+//  Structures.
+//
+
+/**
+ *  State of the scan of an object that is bound to a structure.
+ */
+struct BindScan {
+    //  The traverse object that binds.
+    const xap::core::json::TraversePrivate *traverse;
+
+    //  The binding table of the structure (nullptr if the fields are
+    //  extracted, the keys are then matched one by one).
+    const xap::core::json::BindTablePrivate *table;
+
+    //  The extracted fields (only if table is nullptr).
+    const xap::core::json::ExtractField *fields;
+
+    //  The count of fields.
+    size_t count;
+
+    //  The structure.
+    void *object;
+
+    //  The frame of the object (nullptr for the bound object).
+    const xap::core::json::SchemaFrame *frame;
+
+    //  The status to receive the error (nullptr if not needed).
+    xap::core::json::Status *status;
+
+    //  The fields seen (a bit per field, only for 64 fields or less, set by
+    //  TraversePrivate::bind_members()).
+    uint64_t seen;
+
+    //  The fields seen (only for more than 64 fields, nullptr otherwise).
+    bool *seen_more;
+
+    //  Whether the scan failed.
+    bool failed;
+};
+
+//
+//  Classes.
+//
+
+/**
+ *  Private binding table (dispatches keys to fields).
+ */
+class BindTablePrivate {
+public:
+
+    //
+    //  Public constants.
+    //
+
+    //  The index returned if no field matches.
+    static const size_t NPOS = static_cast<size_t>(-1);
+
+    /**
+     *  Construct the object.
+     *
+     *  @throw xap::core::json::Exception
+     *      Raised if a key is duplicated (ERROR_PARAMETER).
+     *  @param entries
+     *      The entries of the fields.
+     */
+    explicit BindTablePrivate(
+        const std::vector<xap::core::json::BindTable::Entry> &entries
+    );
+
+    /**
+     *  Destruct the object.
+     */
+    virtual ~BindTablePrivate() noexcept;
+
+    //
+    //  Public methods.
+    //
+
+    /**
+     *  Find the field of a key.
+     *
+     *  @param key
+     *      The key.
+     *  @param key_len
+     *      The length of the key.
+     *  @return
+     *      The index of the field (NPOS if no field matches).
+     */
+    size_t find(const char *key, const size_t key_len) const noexcept;
+
+    /**
+     *  Get the entries of the fields.
+     *
+     *  @return
+     *      The entries.
+     */
+    const std::vector<xap::core::json::BindTable::Entry> &
+    get_entries() const noexcept;
+
+private:
+
+    //
+    //  Private members.
+    //
+    std::vector<xap::core::json::BindTable::Entry> m_entries;
+    std::vector<uint64_t> m_hashes;
+
+    //  Open-addressing slots (the index of the field plus one, 0 if empty).
+    std::vector<uint32_t> m_slots;
+    size_t m_mask;
+
+    //
+    //  Private constructor.
+    //
+    BindTablePrivate(const BindTablePrivate &) = delete;
+    BindTablePrivate &operator=(const BindTablePrivate &) = delete;
+};
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
+
+#endif  //  #ifndef XAP_CORE_JSON_BIND_P_H__
@@ -0,0 +1,1238 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+//
+//  Imports.
+//
+#include "document_p.h"
+
+#include "json/json.h"
+
+#include <limits>
+#include <math.h>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stdint.h>
+#include <string.h>
+#include <utility>
+
+namespace xap {
+namespace core {
+namespace json {
+
+//
+//  Private functions.
+//
+
+/**
+ *  Check whether a double value is integral.
+ *
+ *  @param value
+ *      The value.
+ *  @return
+ *      True if so.
+ */
+static bool is_integral(const double value) noexcept {
+    double integral_part;
+    return modf(value, &integral_part) == 0.0;
+}
+
+/**
+ *  Check whether a number fits in a type (see Number::convert()).
+ *
+ *  @param number
+ *      The number.
+ *  @param type
+ *      The type (not used).
+ *  @return
+ *      True if so.
+ */
+static inline bool fit_number(
+    const xap::core::json::Number &number,
+    const int *type
+) noexcept {
+    (void)type;
+    return number.is_int();
+}
+static inline bool fit_number(
+    const xap::core::json::Number &number,
+    const uint *type
+) noexcept {
+    (void)type;
+    return number.is_uint();
+}
+static inline bool fit_number(
+    const xap::core::json::Number &number,
+    const int64_t *type
+) noexcept {
+    (void)type;
+    return number.is_int64();
+}
+static inline bool fit_number(
+    const xap::core::json::Number &number,
+    const uint64_t *type
+) noexcept {
+    (void)type;
+    return number.is_uint64();
+}
+static inline bool fit_number(
+    const xap::core::json::Number &number,
+    const void *type
+) noexcept {
+    //  Floating-point types (and clamped int16_t) take any number.
+    (void)number;
+    (void)type;
+    return true;
+}
+
+/**
+ *  Store a number (that fits, see fit_number()).
+ *
+ *  @param number
+ *      The number.
+ *  @param out
+ *      The pointer to receive the value.
+ */
+static inline void store_number(
+    const xap::core::json::Number &number,
+    int *out
+) noexcept {
+    *out = number.as_int();
+}
+static inline void store_number(
+    const xap::core::json::Number &number,
+    uint *out
+) noexcept {
+    *out = number.as_uint();
+}
+static inline void store_number(
+    const xap::core::json::Number &number,
+    int64_t *out
+) noexcept {
+    *out = number.as_int64();
+}
+static inline void store_number(
+    const xap::core::json::Number &number,
+    uint64_t *out
+) noexcept {
+    *out = number.as_uint64();
+}
+static inline void store_number(
+    const xap::core::json::Number &number,
+    float *out
+) noexcept {
+    *out = number.as_float();
+}
+static inline void store_number(
+    const xap::core::json::Number &number,
+    double *out
+) noexcept {
+    *out = number.as_double();
+}
+static inline void store_number(
+    const xap::core::json::Number &number,
+    int16_t *out
+) noexcept {
+    const double value = number.as_double();
+    if (value <= -32768.0) {
+        *out = -32768;
+    } else if (value >= 32767.0) {
+        *out = 32767;
+    } else {
+        *out = static_cast<int16_t>(value);
+    }
+}
+
+//
+//  Number constructor.
+//
+
+/**
+ *  Construct the object.
+ *
+ *  @param value
+ *      The value.
+ */
+Number::Number(const int64_t value) noexcept :
+    m_kind(Kind::signed_integer),
+    m_int(value)
+{}
+
+/**
+ *  Construct the object.
+ *
+ *  @param value
+ *      The value.
+ */
+Number::Number(const uint64_t value) noexcept :
+    m_kind(Kind::unsigned_integer),
+    m_uint(value)
+{}
+
+/**
+ *  Construct the object.
+ *
+ *  @param value
+ *      The value.
+ */
+Number::Number(const double value) noexcept :
+    m_kind(Kind::real),
+    m_real(value)
+{}
+
+//
+//  Number public methods.
+//
+
+/**
+ *  Check whether the value is a signed integer.
+ *
+ *  @return
+ *      True if so.
+ */
+bool Number::is_int() const noexcept {
+    switch (this->m_kind) {
+        case Kind::signed_integer:
+            return this->m_int >= std::numeric_limits<int>::min() &&
+                   this->m_int <= std::numeric_limits<int>::max();
+        case Kind::unsigned_integer:
+            return this->m_uint <= static_cast<uint64_t>(
+                std::numeric_limits<int>::max()
+            );
+        default:
+            return this->m_real >= std::numeric_limits<int>::min() &&
+                   this->m_real <= std::numeric_limits<int>::max() &&
+                   is_integral(this->m_real);
+    }
+}
+
+/**
+ *  Check whether the value is an unsigned integer.
+ *
+ *  @return
+ *      True if so.
+ */
+bool Number::is_uint() const noexcept {
+    switch (this->m_kind) {
+        case Kind::signed_integer:
+            return this->m_int >= 0 &&
+                   static_cast<uint64_t>(this->m_int) <=
+                       std::numeric_limits<uint>::max();
+        case Kind::unsigned_integer:
+            return this->m_uint <= std::numeric_limits<uint>::max();
+        default:
+            return this->m_real >= 0 &&
+                   this->m_real <= std::numeric_limits<uint>::max() &&
+                   is_integral(this->m_real);
+    }
+}
+
+/**
+ *  Check whether the value is a signed 64-bit integer.
+ *
+ *  @return
+ *      True if so.
+ */
+bool Number::is_int64() const noexcept {
+    switch (this->m_kind) {
+        case Kind::signed_integer:
+            return true;
+        case Kind::unsigned_integer:
+            return this->m_uint <= static_cast<uint64_t>(
+                std::numeric_limits<int64_t>::max()
+            );
+        default:
+            //  2^63 - 1 is rounded up to 2^63 as a double, so the limit is
+            //  exclusive.
+            return this->m_real >= static_cast<double>(
+                       std::numeric_limits<int64_t>::min()
+                   ) &&
+                   this->m_real < static_cast<double>(
+                       std::numeric_limits<int64_t>::max()
+                   ) &&
+                   is_integral(this->m_real);
+    }
+}
+
+/**
+ *  Check whether the value is an unsigned 64-bit integer.
+ *
+ *  @return
+ *      True if so.
+ */
+bool Number::is_uint64() const noexcept {
+    switch (this->m_kind) {
+        case Kind::signed_integer:
+            return this->m_int >= 0;
+        case Kind::unsigned_integer:
+            return true;
+        default:
+            //  2^64 - 1 is rounded up to 2^64 as a double, so the limit is
+            //  exclusive.
+            return this->m_real >= 0 &&
+                   this->m_real < 18446744073709551616.0 &&
+                   is_integral(this->m_real);
+    }
+}
+
+/**
+ *  Get the value as a signed integer.
+ *
+ *  @return
+ *      The value.
+ */
+int Number::as_int() const noexcept {
+    switch (this->m_kind) {
+        case Kind::signed_integer:
+            return static_cast<int>(this->m_int);
+        case Kind::unsigned_integer:
+            return static_cast<int>(this->m_uint);
+        default:
+            return static_cast<int>(this->m_real);
+    }
+}
+
+/**
+ *  Get the value as an unsigned integer.
+ *
+ *  @return
+ *      The value.
+ */
+uint Number::as_uint() const noexcept {
+    switch (this->m_kind) {
+        case Kind::signed_integer:
+            return static_cast<uint>(this->m_int);
+        case Kind::unsigned_integer:
+            return static_cast<uint>(this->m_uint);
+        default:
+            return static_cast<uint>(this->m_real);
+    }
+}
+
+/**
+ *  Get the value as a signed 64-bit integer.
+ *
+ *  @return
+ *      The value.
+ */
+int64_t Number::as_int64() const noexcept {
+    switch (this->m_kind) {
+        case Kind::signed_integer:
+            return this->m_int;
+        case Kind::unsigned_integer:
+            return static_cast<int64_t>(this->m_uint);
+        default:
+            return static_cast<int64_t>(this->m_real);
+    }
+}
+
+/**
+ *  Get the value as an unsigned 64-bit integer.
+ *
+ *  @return
+ *      The value.
+ */
+uint64_t Number::as_uint64() const noexcept {
+    switch (this->m_kind) {
+        case Kind::signed_integer:
+            return static_cast<uint64_t>(this->m_int);
+        case Kind::unsigned_integer:
+            return this->m_uint;
+        default:
+            return static_cast<uint64_t>(this->m_real);
+    }
+}
+
+/**
+ *  Get the value as float.
+ *
+ *  @return
+ *      The value.
+ */
+float Number::as_float() const noexcept {
+    switch (this->m_kind) {
+        case Kind::signed_integer:
+            return static_cast<float>(this->m_int);
+        case Kind::unsigned_integer:
+            return static_cast<float>(this->m_uint);
+        default:
+            return static_cast<float>(this->m_real);
+    }
+}
+
+/**
+ *  Get the value as double.
+ *
+ *  @return
+ *      The value.
+ */
+double Number::as_double() const noexcept {
+    switch (this->m_kind) {
+        case Kind::signed_integer:
+            return static_cast<double>(this->m_int);
+        case Kind::unsigned_integer:
+            return static_cast<double>(this->m_uint);
+        default:
+            return this->m_real;
+    }
+}
+
+/**
+ *  Get the value as a Json::Value.
+ *
+ *  @return
+ *      The value.
+ */
+Json::Value Number::to_value() const {
+    switch (this->m_kind) {
+        case Kind::signed_integer:
+            return Json::Value(static_cast<Json::Int64>(this->m_int));
+        case Kind::unsigned_integer:
+            return Json::Value(static_cast<Json::UInt64>(this->m_uint));
+        default:
+            return Json::Value(this->m_real);
+    }
+}
+
+//
+//  Number public static functions.
+//
+
+/**
+ *  Convert numbers (in bulk).
+ *
+ *  @param numbers
+ *      The numbers.
+ *  @param count
+ *      The count of numbers.
+ *  @param out
+ *      The buffer to receive the values (at least count items).
+ *  @return
+ *      The count of leading numbers converted (less than count if a number
+ *      doesn't fit).
+ */
+template <typename T>
+size_t Number::convert(
+    const xap::core::json::Number *numbers,
+    const size_t count,
+    T *out
+) noexcept {
+    for (size_t i = 0U; i < count; ++i) {
+        if (!fit_number(numbers[i], out)) {
+            return i;
+        }
+        store_number(numbers[i], out + i);
+    }
+    return count;
+}
+
+template size_t Number::convert<int>(
+    const xap::core::json::Number *numbers,
+    const size_t count,
+    int *out
+) noexcept;
+template size_t Number::convert<uint>(
+    const xap::core::json::Number *numbers,
+    const size_t count,
+    uint *out
+) noexcept;
+template size_t Number::convert<int64_t>(
+    const xap::core::json::Number *numbers,
+    const size_t count,
+    int64_t *out
+) noexcept;
+template size_t Number::convert<uint64_t>(
+    const xap::core::json::Number *numbers,
+    const size_t count,
+    uint64_t *out
+) noexcept;
+template size_t Number::convert<float>(
+    const xap::core::json::Number *numbers,
+    const size_t count,
+    float *out
+) noexcept;
+template size_t Number::convert<double>(
+    const xap::core::json::Number *numbers,
+    const size_t count,
+    double *out
+) noexcept;
+template size_t Number::convert<int16_t>(
+    const xap::core::json::Number *numbers,
+    const size_t count,
+    int16_t *out
+) noexcept;
+
+//
+//  Document constructor & destructor.
+//
+
+/**
+ *  Construct the object.
+ */
+Document::Document() :
+    m_arena(),
+    m_keys(),
+    m_member_indexes()
+{}
+
+/**
+ *  Destruct the object.
+ */
+Document::~Document() noexcept {
+    //  Do nothing.
+}
+
+//
+//  Document public methods.
+//
+
+/**
+ *  Get the modifiable value of a node.
+ *
+ *  @param node
+ *      The node.
+ *  @return
+ *      The value (nullptr if the document is read-only).
+ */
+Json::Value *Document::get_mutable_value(
+    const xap::core::json::Node node
+) noexcept {
+    (void)node;
+    return nullptr;
+}
+
+/**
+ *  Get the values of numeric items of an array node (in bulk).
+ *
+ *  @param node
+ *      The node.
+ *  @param first
+ *      The index of the first item.
+ *  @param count
+ *      The count of items (first + count must not exceed the size).
+ *  @param out
+ *      The buffer to receive the values (at least count items).
+ *  @return
+ *      The count of leading items read (less than count if an item is not
+ *      numeric).
+ */
+size_t Document::get_numbers(
+    const xap::core::json::Node node,
+    const size_t first,
+    const size_t count,
+    xap::core::json::Number *out
+) const {
+    for (size_t i = 0U; i < count; ++i) {
+        const xap::core::json::Node item = this->get_element(node, first + i);
+        if (this->get_type(item) != xap::core::json::Type::numeric) {
+            return i;
+        }
+        out[i] = this->get_number(item);
+    }
+    return count;
+}
+
+/**
+ *  Find a member of an object node (with the hash of the key).
+ *
+ *  @param node
+ *      The node.
+ *  @param key
+ *      The key.
+ *  @param key_len
+ *      The length of the key.
+ *  @param key_hash
+ *      The hash of the key (see Document::hash_key()).
+ *  @param member
+ *      The pointer to receive the node of the member.
+ *  @return
+ *      True if found.
+ */
+bool Document::find_member_hashed(
+    const xap::core::json::Node node,
+    const char *key,
+    const size_t key_len,
+    const uint64_t key_hash,
+    xap::core::json::Node *member
+) const {
+    (void)key_hash;
+    return this->find_member(node, key, key_len, member);
+}
+
+/**
+ *  Get the key of a member node (kept by the document).
+ *
+ *  @note
+ *      The key stays as long as the document. The default implementation
+ *      keeps no key.
+ *  @param member
+ *      The node of the member (found by find_member()).
+ *  @param key
+ *      The pointer to receive the key.
+ *  @param key_len
+ *      The pointer to receive the length of the key.
+ *  @return
+ *      False if the document doesn't keep the key.
+ */
+bool Document::get_member_key(
+    const xap::core::json::Node member,
+    const char **key,
+    size_t *key_len
+) const noexcept {
+    (void)member;
+    (void)key;
+    (void)key_len;
+    return false;
+}
+
+/**
+ *  Get the arena of the document.
+ *
+ *  @return
+ *      The arena (nullptr if the document allocates from the heap).
+ */
+const std::shared_ptr<xap::core::json::ArenaPrivate> &
+Document::get_arena() const noexcept {
+    return this->m_arena;
+}
+
+/**
+ *  Set the arena of the document.
+ *
+ *  @param arena
+ *      The arena (nullptr to allocate from the heap).
+ */
+void Document::set_arena(
+    const std::shared_ptr<xap::core::json::ArenaPrivate> &arena
+) noexcept {
+    this->m_arena = arena;
+}
+
+/**
+ *  Get the key table of the document.
+ *
+ *  @return
+ *      The key table (nullptr if the keys are not interned).
+ */
+const std::shared_ptr<xap::core::json::KeyTablePrivate> &
+Document::get_key_table() const noexcept {
+    return this->m_keys;
+}
+
+/**
+ *  Set the key table of the document.
+ *
+ *  @throw std::bad_alloc
+ *      Raised if memory allocation was failed.
+ *  @param keys
+ *      The key table (nullptr if the keys are not interned).
+ */
+void Document::set_key_table(
+    const std::shared_ptr<xap::core::json::KeyTablePrivate> &keys
+) {
+    this->m_keys = keys;
+}
+
+/**
+ *  Get a member of a Json::Value object (the member is added if it doesn't
+ *  exist).
+ *
+ *  @throw std::bad_alloc
+ *      Raised if memory allocation was failed.
+ *  @param object
+ *      The object (or a null value, which is turned into an object).
+ *  @param key
+ *      The key.
+ *  @param key_len
+ *      The length of the key.
+ *  @return
+ *      The member.
+ */
+Json::Value &Document::demand_member(
+    Json::Value *object,
+    const char *key,
+    const size_t key_len
+) const {
+    //  Only the keys of the global table outlive every Json::Value.
+    if (this->m_keys && this->m_keys->is_global()) {
+        const xap::core::json::KeyEntry *entry = this->m_keys->intern(
+            key,
+            key_len,
+            Document::hash_key(key, key_len)
+        );
+        if (entry && entry->is_c_string) {
+            return (*object)[Json::StaticString(entry->key)];
+        }
+    }
+    return *(object->demand(key, key + key_len));
+}
+
+//
+//  Document protected methods.
+//
+
+/**
+ *  Get the member index of an object node (the index is built on first use,
+ *  see Document::index_members()).
+ *
+ *  @param node
+ *      The node.
+ *  @param count
+ *      The count of members of the node.
+ *  @return
+ *      The index (nullptr if memory allocation was failed).
+ */
+const xap::core::json::MemberIndex *Document::get_member_index(
+    const xap::core::json::Node node,
+    const size_t count
+) const noexcept {
+    const xap::core::json::MemberIndex *index =
+        this->m_member_indexes.find(node);
+    if (index) {
+        return index;
+    }
+
+    std::lock_guard<std::mutex> guard(this->m_member_indexes.get_lock());
+
+    //  Another thread may have built the index.
+    index = this->m_member_indexes.find(node);
+    if (index) {
+        return index;
+    }
+    try {
+        std::unique_ptr<xap::core::json::MemberIndex> built(
+            new xap::core::json::MemberIndex(node, count)
+        );
+        this->index_members(node, built.get());
+        return this->m_member_indexes.insert(std::move(built));
+    } catch (std::bad_alloc &) {
+        return nullptr;
+    }
+}
+
+/**
+ *  Add the members of an object node to its member index.
+ *
+ *  @param node
+ *      The node.
+ *  @param index
+ *      The index.
+ */
+void Document::index_members(
+    const xap::core::json::Node node,
+    xap::core::json::MemberIndex *index
+) const noexcept {
+    (void)node;
+    (void)index;
+}
+
+/**
+ *  Remove all member indexes (before the document is modified).
+ */
+void Document::clear_member_indexes() noexcept {
+    this->m_member_indexes.clear();
+}
+
+//
+//  Document public static functions.
+//
+
+/**
+ *  Hash a key (8 bytes at a time).
+ *
+ *  @note
+ *      The hashes are only compared within the process, the result depends
+ *      on the byte order.
+ *  @param key
+ *      The key.
+ *  @param key_len
+ *      The length of the key.
+ *  @return
+ *      The hash.
+ */
+uint64_t Document::hash_key(const char *key, const size_t key_len) noexcept {
+    static const uint64_t MULTIPLIER = 0x9E3779B97F4A7C15ULL;
+    uint64_t hash = 14695981039346656037ULL ^ static_cast<uint64_t>(key_len);
+    size_t remaining = key_len;
+    while (remaining >= 8U) {
+        uint64_t word;
+        memcpy(&word, key, 8U);
+        hash = (hash ^ word) * MULTIPLIER;
+        hash ^= (hash >> 29);
+        key += 8U;
+        remaining -= 8U;
+    }
+    if (remaining >= 4U) {
+        //  Two (overlapping) 4-byte words.
+        uint32_t head;
+        uint32_t tail;
+        memcpy(&head, key, 4U);
+        memcpy(&tail, key + remaining - 4U, 4U);
+        hash = (
+            hash ^ ((static_cast<uint64_t>(head) << 32) | tail)
+        ) * MULTIPLIER;
+    } else if (remaining != 0U) {
+        //  The first, middle and last bytes.
+        const uint64_t word =
+            (static_cast<uint64_t>(static_cast<uint8_t>(key[0])) << 16) |
+            (
+                static_cast<uint64_t>(static_cast<uint8_t>(
+                    key[remaining >> 1U]
+                )) << 8
+            ) |
+            static_cast<uint64_t>(static_cast<uint8_t>(key[remaining - 1U]));
+        hash = (hash ^ word) * MULTIPLIER;
+    }
+
+    //  Fold the high bits into the low bits (that index hash tables).
+    hash *= MULTIPLIER;
+    hash ^= (hash >> 32);
+    return hash;
+}
+
+//
+//  ValueDocument constructor & destructor.
+//
+
+/**
+ *  Construct the object (with a 'null' root).
+ */
+ValueDocument::ValueDocument() :
+    Document(),
+    m_root()
+{}
+
+/**
+ *  Construct the object.
+ *
+ *  @param value
+ *      The root value (copied).
+ */
+ValueDocument::ValueDocument(const Json::Value &value) :
+    Document(),
+    m_root(value)
+{}
+
+/**
+ *  Construct the object.
+ *
+ *  @param value
+ *      The root value (moved).
+ */
+ValueDocument::ValueDocument(Json::Value &&value) :
+    Document(),
+    m_root(std::move(value))
+{}
+
+/**
+ *  Destruct the object.
+ */
+ValueDocument::~ValueDocument() noexcept {
+    //  Do nothing.
+}
+
+//
+//  ValueDocument public methods.
+//
+
+/**
+ *  Get the root value.
+ *
+ *  @return
+ *      The root value.
+ */
+Json::Value &ValueDocument::root() noexcept {
+    //  The root may be modified through the reference.
+    this->clear_member_indexes();
+    return this->m_root;
+}
+
+/**
+ *  Get the root node.
+ *
+ *  @return
+ *      The node.
+ */
+xap::core::json::Node ValueDocument::get_root() const noexcept {
+    return ValueDocument::to_node(&(this->m_root));
+}
+
+/**
+ *  Get the type of a node.
+ *
+ *  @param node
+ *      The node.
+ *  @return
+ *      The type.
+ */
+xap::core::json::Type ValueDocument::get_type(
+    const xap::core::json::Node node
+) const noexcept {
+    switch (ValueDocument::to_value_pointer(node)->type()) {
+        case Json::intValue:
+        case Json::uintValue:
+        case Json::realValue:
+            return xap::core::json::Type::numeric;
+        case Json::stringValue:
+            return xap::core::json::Type::string;
+        case Json::booleanValue:
+            return xap::core::json::Type::boolean;
+        case Json::arrayValue:
+            return xap::core::json::Type::array;
+        case Json::objectValue:
+            return xap::core::json::Type::object;
+        default:
+            return xap::core::json::Type::null;
+    }
+}
+
+/**
+ *  Get the value of a numeric node.
+ *
+ *  @param node
+ *      The node.
+ *  @return
+ *      The value.
+ */
+xap::core::json::Number ValueDocument::get_number(
+    const xap::core::json::Node node
+) const noexcept {
+    const Json::Value *value = ValueDocument::to_value_pointer(node);
+    switch (value->type()) {
+        case Json::intValue:
+            return xap::core::json::Number(
+                static_cast<int64_t>(value->asLargestInt())
+            );
+        case Json::uintValue:
+            return xap::core::json::Number(
+                static_cast<uint64_t>(value->asLargestUInt())
+            );
+        default:
+            return xap::core::json::Number(value->asDouble());
+    }
+}
+
+/**
+ *  Get the value of a boolean node.
+ *
+ *  @param node
+ *      The node.
+ *  @return
+ *      The value.
+ */
+bool ValueDocument::get_boolean(
+    const xap::core::json::Node node
+) const noexcept {
+    return ValueDocument::to_value_pointer(node)->asBool();
+}
+
+/**
+ *  Get the value of a string node.
+ *
+ *  @param node
+ *      The node.
+ *  @param begin
+ *      The pointer to receive the beginning of the string.
+ *  @param end
+ *      The pointer to receive the end of the string.
+ */
+void ValueDocument::get_string(
+    const xap::core::json::Node node,
+    const char **begin,
+    const char **end
+) const noexcept {
+    if (!ValueDocument::to_value_pointer(node)->getString(begin, end)) {
+        *begin = "";
+        *end = *begin;
+    }
+}
+
+/**
+ *  Get the count of items of an array node (or members of an object
+ *  node).
+ *
+ *  @param node
+ *      The node.
+ *  @return
+ *      The count.
+ */
+size_t ValueDocument::get_size(
+    const xap::core::json::Node node
+) const {
+    return static_cast<size_t>(ValueDocument::to_value_pointer(node)->size());
+}
+
+/**
+ *  Get an item of an array node.
+ *
+ *  @param node
+ *      The node.
+ *  @param index
+ *      The index of the item (must be less than the size).
+ *  @return
+ *      The node of the item.
+ */
+xap::core::json::Node ValueDocument::get_element(
+    const xap::core::json::Node node,
+    const size_t index
+) const {
+    const Json::Value *value = ValueDocument::to_value_pointer(node);
+    return ValueDocument::to_node(
+        &((*value)[static_cast<Json::ArrayIndex>(index)])
+    );
+}
+
+/**
+ *  Find a member of an object node.
+ *
+ *  @param node
+ *      The node.
+ *  @param key
+ *      The key.
+ *  @param key_len
+ *      The length of the key.
+ *  @param member
+ *      The pointer to receive the node of the member.
+ *  @return
+ *      True if found.
+ */
+bool ValueDocument::find_member(
+    const xap::core::json::Node node,
+    const char *key,
+    const size_t key_len,
+    xap::core::json::Node *member
+) const {
+    if (
+        ValueDocument::to_value_pointer(node)->size() >=
+            xap::core::json::MEMBER_INDEX_MIN_COUNT
+    ) {
+        return ValueDocument::find_member_hashed(
+            node,
+            key,
+            key_len,
+            xap::core::json::Document::hash_key(key, key_len),
+            member
+        );
+    }
+
+    const Json::Value *found =
+        ValueDocument::to_value_pointer(node)->find(key, key + key_len);
+    if (found == nullptr) {
+        return false;
+    }
+
+    *member = ValueDocument::to_node(found);
+    return true;
+}
+
+/**
+ *  Find a member of an object node (with the hash of the key).
+ *
+ *  @note
+ *      Members of a wide object are looked up by its member index instead of
+ *      walking the (ordered) map of the object.
+ *  @param node
+ *      The node.
+ *  @param key
+ *      The key.
+ *  @param key_len
+ *      The length of the key.
+ *  @param key_hash
+ *      The hash of the key (see Document::hash_key()).
+ *  @param member
+ *      The pointer to receive the node of the member.
+ *  @return
+ *      True if found.
+ */
+bool ValueDocument::find_member_hashed(
+    const xap::core::json::Node node,
+    const char *key,
+    const size_t key_len,
+    const uint64_t key_hash,
+    xap::core::json::Node *member
+) const {
+    const Json::Value *value = ValueDocument::to_value_pointer(node);
+    const size_t count = value->size();
+    if (count >= xap::core::json::MEMBER_INDEX_MIN_COUNT) {
+        const xap::core::json::MemberIndex *index =
+            this->get_member_index(node, count);
+        if (index) {
+            return index->find(key, key_len, key_hash, member);
+        }
+    }
+
+    const Json::Value *found = value->find(key, key + key_len);
+    if (found == nullptr) {
+        return false;
+    }
+
+    *member = ValueDocument::to_node(found);
+    return true;
+}
+
+/**
+ *  Visit the members of an object node.
+ *
+ *  @note
+ *      Json::Value objects keep no duplicate keys, and visit their members
+ *      in the order of the keys.
+ *  @param node
+ *      The node.
+ *  @param handler
+ *      The handler.
+ *  @param context
+ *      The context passed to the handler.
+ *  @return
+ *      False if the handler stopped the visit.
+ */
+bool ValueDocument::foreach_member(
+    const xap::core::json::Node node,
+    const xap::core::json::MemberHandler handler,
+    void *context
+) const {
+    const Json::Value *value = ValueDocument::to_value_pointer(node);
+    for (
+        Json::Value::const_iterator it = value->begin();
+        it != value->end();
+        ++it
+    ) {
+        const char *end = nullptr;
+        const char *key = it.memberName(&end);
+        if (key == nullptr) {
+            key = end = "";
+        }
+        if (!handler(
+            context,
+            key,
+            static_cast<size_t>(end - key),
+            ValueDocument::to_node(&(*it))
+        )) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ *  Copy a node (and its descendants) into a Json::Value.
+ *
+ *  @param node
+ *      The node.
+ *  @return
+ *      The value.
+ */
+Json::Value ValueDocument::to_value(const xap::core::json::Node node) const {
+    return *(ValueDocument::to_value_pointer(node));
+}
+
+/**
+ *  Get the modifiable value of a node.
+ *
+ *  @note
+ *      The document is never modified while shared (see
+ *      TraversePrivate::detach()), so handing out a modifiable value is safe.
+ *  @param node
+ *      The node.
+ *  @return
+ *      The value.
+ */
+Json::Value *ValueDocument::get_mutable_value(
+    const xap::core::json::Node node
+) noexcept {
+    //  The member indexes refer to the keys (and values) being modified.
+    this->clear_member_indexes();
+    return const_cast<Json::Value *>(ValueDocument::to_value_pointer(node));
+}
+
+//
+//  ValueDocument protected methods.
+//
+
+/**
+ *  Add the members of an object node to its member index.
+ *
+ *  @param node
+ *      The node.
+ *  @param index
+ *      The index.
+ */
+void ValueDocument::index_members(
+    const xap::core::json::Node node,
+    xap::core::json::MemberIndex *index
+) const noexcept {
+    const Json::Value *value = ValueDocument::to_value_pointer(node);
+    for (
+        Json::Value::const_iterator it = value->begin();
+        it != value->end();
+        ++it
+    ) {
+        const char *end = nullptr;
+        const char *key = it.memberName(&end);
+        if (key == nullptr) {
+            key = end = "";
+        }
+        const size_t key_len = static_cast<size_t>(end - key);
+        index->insert(
+            key,
+            key_len,
+            xap::core::json::Document::hash_key(key, key_len),
+            ValueDocument::to_node(&(*it))
+        );
+    }
+}
+
+//
+//  ValueDocument public static functions.
+//
+
+/**
+ *  Get the shared document whose root is 'null'.
+ *
+ *  @note
+ *      The returned document is always shared, so any modifier would
+ *      detach from it instead of writing to it.
+ *  @return
+ *      The document.
+ */
+const std::shared_ptr<xap::core::json::ValueDocument> &
+ValueDocument::null_document() {
+    static const std::shared_ptr<xap::core::json::ValueDocument> document =
+        std::make_shared<xap::core::json::ValueDocument>();
+    return document;
+}
+
+/**
+ *  Get the node of a value.
+ *
+ *  @param value
+ *      The value (must be owned by the document).
+ *  @return
+ *      The node.
+ */
+xap::core::json::Node ValueDocument::to_node(
+    const Json::Value *value
+) noexcept {
+    return reinterpret_cast<xap::core::json::Node>(value);
+}
+
+/**
+ *  Get the value of a node.
+ *
+ *  @param node
+ *      The node.
+ *  @return
+ *      The value.
+ */
+const Json::Value *ValueDocument::to_value_pointer(
+    const xap::core::json::Node node
+) noexcept {
+    return reinterpret_cast<const Json::Value *>(node);
+}
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
@@ -0,0 +1,840 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+#ifndef XAP_CORE_JSON_DOCUMENT_P_H__
+#define XAP_CORE_JSON_DOCUMENT_P_H__
+
+//
+//  Imports.
+//
+#include "xap/core/json/build.h"
+#include "xap/core/json/traverse.h"
+#include "arena_p.h"
+#include "key_table_p.h"
+#include "member_index_p.h"
+
+#include "json/json.h"
+
+#include <memory>
+#include <stdint.h>
+#include <stdlib.h>
+#include <utility>
+
+namespace xap {
+namespace core {
+namespace json {
+
+//
+//  Types.
+//
+
+/**
+ *  Handler of the members of an object node (see Document::foreach_member()).
+ *
+ *  @param context
+ *      The context.
+ *  @param key
+ *      The key of the member.
+ *  @param key_len
+ *      The length of the key.
+ *  @param member
+ *      The node of the member.
+ *  @return
+ *      False to stop.
+ */
+typedef bool (*MemberHandler)(
+    void *context,
+    const char *key,
+    const size_t key_len,
+    const xap::core::json::Node member
+);
+
+//
+//  Classes.
+//
+
+/**
+ *  Numeric value.
+ *
+ *  @note
+ *      The checks and conversions follow the semantics of Json::Value (for
+ *      example, 1.0 is an integer), so that all documents behave the same.
+ */
+class Number {
+public:
+
+    /**
+     *  Construct the object (uninitialized, to be assigned).
+     */
+    Number() noexcept = default;
+
+    /**
+     *  Construct the object.
+     *
+     *  @param value
+     *      The value.
+     */
+    explicit Number(const int64_t value) noexcept;
+
+    /**
+     *  Construct the object.
+     *
+     *  @param value
+     *      The value.
+     */
+    explicit Number(const uint64_t value) noexcept;
+
+    /**
+     *  Construct the object.
+     *
+     *  @param value
+     *      The value.
+     */
+    explicit Number(const double value) noexcept;
+
+    //
+    //  Public methods.
+    //
+
+    /**
+     *  Check whether the value is a signed integer.
+     *
+     *  @return
+     *      True if so.
+     */
+    bool is_int() const noexcept;
+
+    /**
+     *  Check whether the value is an unsigned integer.
+     *
+     *  @return
+     *      True if so.
+     */
+    bool is_uint() const noexcept;
+
+    /**
+     *  Check whether the value is a signed 64-bit integer.
+     *
+     *  @return
+     *      True if so.
+     */
+    bool is_int64() const noexcept;
+
+    /**
+     *  Check whether the value is an unsigned 64-bit integer.
+     *
+     *  @return
+     *      True if so.
+     */
+    bool is_uint64() const noexcept;
+
+    /**
+     *  Get the value as a signed integer.
+     *
+     *  @return
+     *      The value.
+     */
+    int as_int() const noexcept;
+
+    /**
+     *  Get the value as an unsigned integer.
+     *
+     *  @return
+     *      The value.
+     */
+    uint as_uint() const noexcept;
+
+    /**
+     *  Get the value as a signed 64-bit integer.
+     *
+     *  @return
+     *      The value.
+     */
+    int64_t as_int64() const noexcept;
+
+    /**
+     *  Get the value as an unsigned 64-bit integer.
+     *
+     *  @return
+     *      The value.
+     */
+    uint64_t as_uint64() const noexcept;
+
+    /**
+     *  Get the value as float.
+     *
+     *  @return
+     *      The value.
+     */
+    float as_float() const noexcept;
+
+    /**
+     *  Get the value as double.
+     *
+     *  @return
+     *      The value.
+     */
+    double as_double() const noexcept;
+
+    /**
+     *  Get the value as a Json::Value.
+     *
+     *  @return
+     *      The value.
+     */
+    Json::Value to_value() const;
+
+    //
+    //  Public static functions.
+    //
+
+    /**
+     *  Convert numbers (in bulk).
+     *
+     *  @note
+     *      Integer types take the numbers that fit (like is_int() and the
+     *      like), float and double take any number, and int16_t takes any
+     *      number clamped to [-32768, 32767] (and truncated toward zero).
+     *
+     *      Instantiated for int, uint, int64_t, uint64_t, float, double and
+     *      int16_t.
+     *  @param numbers
+     *      The numbers.
+     *  @param count
+     *      The count of numbers.
+     *  @param out
+     *      The buffer to receive the values (at least count items).
+     *  @return
+     *      The count of leading numbers converted (less than count if a
+     *      number doesn't fit).
+     */
+    template <typename T>
+    static size_t convert(
+        const xap::core::json::Number *numbers,
+        const size_t count,
+        T *out
+    ) noexcept;
+
+private:
+
+    //
+    //  Private types.
+    //
+    enum Kind: uint8_t {
+        signed_integer,
+        unsigned_integer,
+        real
+    };
+
+    //
+    //  Private members.
+    //
+    Kind m_kind;
+    union {
+        int64_t m_int;
+        uint64_t m_uint;
+        double m_real;
+    };
+};
+
+/**
+ *  Parsed JSON document.
+ *
+ *  @note
+ *      A document is shared (through std::shared_ptr) by the traverse object
+ *      that parsed it and by every traverse object derived from it. Derived
+ *      traverse objects only hold a handle of their node within the
+ *      document, so navigation never copies the underlying JSON values.
+ *
+ *      A document must not be modified while it is shared. Modifiers
+ *      detach (copy) the node into a new document first (copy-on-write).
+ *
+ *      Unless stated otherwise, the node passed to the accessors must have
+ *      the matching type.
+ */
+class Document {
+public:
+
+    /**
+     *  Construct the object.
+     */
+    Document();
+
+    /**
+     *  Destruct the object.
+     */
+    virtual ~Document() noexcept;
+
+    //
+    //  Public methods.
+    //
+
+    /**
+     *  Get the root node.
+     *
+     *  @return
+     *      The node.
+     */
+    virtual xap::core::json::Node get_root() const noexcept = 0;
+
+    /**
+     *  Get the type of a node.
+     *
+     *  @param node
+     *      The node.
+     *  @return
+     *      The type.
+     */
+    virtual xap::core::json::Type get_type(
+        const xap::core::json::Node node
+    ) const noexcept = 0;
+
+    /**
+     *  Get the value of a numeric node.
+     *
+     *  @param node
+     *      The node.
+     *  @return
+     *      The value.
+     */
+    virtual xap::core::json::Number get_number(
+        const xap::core::json::Node node
+    ) const noexcept = 0;
+
+    /**
+     *  Get the value of a boolean node.
+     *
+     *  @param node
+     *      The node.
+     *  @return
+     *      The value.
+     */
+    virtual bool get_boolean(
+        const xap::core::json::Node node
+    ) const noexcept = 0;
+
+    /**
+     *  Get the value of a string node.
+     *
+     *  @param node
+     *      The node.
+     *  @param begin
+     *      The pointer to receive the beginning of the string.
+     *  @param end
+     *      The pointer to receive the end of the string.
+     */
+    virtual void get_string(
+        const xap::core::json::Node node,
+        const char **begin,
+        const char **end
+    ) const noexcept = 0;
+
+    /**
+     *  Get the count of items of an array node (or members of an object
+     *  node).
+     *
+     *  @throw std::bad_alloc
+     *      Raised if memory allocation was failed.
+     *  @param node
+     *      The node.
+     *  @return
+     *      The count.
+     */
+    virtual size_t get_size(
+        const xap::core::json::Node node
+    ) const = 0;
+
+    /**
+     *  Get an item of an array node.
+     *
+     *  @throw std::bad_alloc
+     *      Raised if memory allocation was failed.
+     *  @param node
+     *      The node.
+     *  @param index
+     *      The index of the item (must be less than the size).
+     *  @return
+     *      The node of the item.
+     */
+    virtual xap::core::json::Node get_element(
+        const xap::core::json::Node node,
+        const size_t index
+    ) const = 0;
+
+    /**
+     *  Get the values of numeric items of an array node (in bulk).
+     *
+     *  @note
+     *      The default implementation reads the items one by one.
+     *  @throw std::bad_alloc
+     *      Raised if memory allocation was failed.
+     *  @param node
+     *      The node.
+     *  @param first
+     *      The index of the first item.
+     *  @param count
+     *      The count of items (first + count must not exceed the size).
+     *  @param out
+     *      The buffer to receive the values (at least count items).
+     *  @return
+     *      The count of leading items read (less than count if an item is
+     *      not numeric).
+     */
+    virtual size_t get_numbers(
+        const xap::core::json::Node node,
+        const size_t first,
+        const size_t count,
+        xap::core::json::Number *out
+    ) const;
+
+    /**
+     *  Find a member of an object node.
+     *
+     *  @throw std::bad_alloc
+     *      Raised if memory allocation was failed.
+     *  @param node
+     *      The node.
+     *  @param key
+     *      The key.
+     *  @param key_len
+     *      The length of the key.
+     *  @param member
+     *      The pointer to receive the node of the member.
+     *  @return
+     *      True if found.
+     */
+    virtual bool find_member(
+        const xap::core::json::Node node,
+        const char *key,
+        const size_t key_len,
+        xap::core::json::Node *member
+    ) const = 0;
+
+    /**
+     *  Find a member of an object node (with the hash of the key).
+     *
+     *  @note
+     *      Documents that index members by the hashes of their keys use the
+     *      given hash instead of hashing the key again. The default
+     *      implementation ignores the hash.
+     *  @throw std::bad_alloc
+     *      Raised if memory allocation was failed.
+     *  @param node
+     *      The node.
+     *  @param key
+     *      The key.
+     *  @param key_len
+     *      The length of the key.
+     *  @param key_hash
+     *      The hash of the key (see Document::hash_key()).
+     *  @param member
+     *      The pointer to receive the node of the member.
+     *  @return
+     *      True if found.
+     */
+    virtual bool find_member_hashed(
+        const xap::core::json::Node node,
+        const char *key,
+        const size_t key_len,
+        const uint64_t key_hash,
+        xap::core::json::Node *member
+    ) const;
+
+    /**
+     *  Visit the members of an object node (in the order of the input).
+     *
+     *  @note
+     *      Duplicate keys are visited as many times as they appear.
+     *  @param node
+     *      The node.
+     *  @param handler
+     *      The handler.
+     *  @param context
+     *      The context passed to the handler.
+     *  @return
+     *      False if the handler stopped the visit.
+     */
+    virtual bool foreach_member(
+        const xap::core::json::Node node,
+        const xap::core::json::MemberHandler handler,
+        void *context
+    ) const = 0;
+
+    /**
+     *  Get the key of a member node (kept by the document).
+     *
+     *  @note
+     *      The key stays as long as the document. The default implementation
+     *      keeps no key.
+     *  @param member
+     *      The node of the member (found by find_member()).
+     *  @param key
+     *      The pointer to receive the key.
+     *  @param key_len
+     *      The pointer to receive the length of the key.
+     *  @return
+     *      False if the document doesn't keep the key.
+     */
+    virtual bool get_member_key(
+        const xap::core::json::Node member,
+        const char **key,
+        size_t *key_len
+    ) const noexcept;
+
+    /**
+     *  Copy a node (and its descendants) into a Json::Value.
+     *
+     *  @param node
+     *      The node.
+     *  @return
+     *      The value.
+     */
+    virtual Json::Value to_value(const xap::core::json::Node node) const = 0;
+
+    /**
+     *  Get the modifiable value of a node.
+     *
+     *  @param node
+     *      The node.
+     *  @return
+     *      The value (nullptr if the document is read-only).
+     */
+    virtual Json::Value *get_mutable_value(
+        const xap::core::json::Node node
+    ) noexcept;
+
+    /**
+     *  Get the arena of the document.
+     *
+     *  @note
+     *      Traverse objects derived from the document (and their paths) are
+     *      allocated from the same arena.
+     *  @return
+     *      The arena (nullptr if the document allocates from the heap).
+     */
+    const std::shared_ptr<xap::core::json::ArenaPrivate> &
+    get_arena() const noexcept;
+
+    /**
+     *  Set the arena of the document.
+     *
+     *  @param arena
+     *      The arena (nullptr to allocate from the heap).
+     */
+    void set_arena(
+        const std::shared_ptr<xap::core::json::ArenaPrivate> &arena
+    ) noexcept;
+
+    /**
+     *  Get the key table of the document.
+     *
+     *  @return
+     *      The key table (nullptr if the keys are not interned).
+     */
+    const std::shared_ptr<xap::core::json::KeyTablePrivate> &
+    get_key_table() const noexcept;
+
+    /**
+     *  Set the key table of the document.
+     *
+     *  @note
+     *      Documents that tag their members with the IDs of the keys intern
+     *      the keys of the members decoded already.
+     *  @throw std::bad_alloc
+     *      Raised if memory allocation was failed.
+     *  @param keys
+     *      The key table (nullptr if the keys are not interned).
+     */
+    virtual void set_key_table(
+        const std::shared_ptr<xap::core::json::KeyTablePrivate> &keys
+    );
+
+    /**
+     *  Get a member of a Json::Value object (the member is added if it
+     *  doesn't exist).
+     *
+     *  @note
+     *      With the global key table, the key of an added member refers to
+     *      the interned key instead of a copy.
+     *  @throw std::bad_alloc
+     *      Raised if memory allocation was failed.
+     *  @param object
+     *      The object (or a null value, which is turned into an object).
+     *  @param key
+     *      The key.
+     *  @param key_len
+     *      The length of the key.
+     *  @return
+     *      The member.
+     */
+    Json::Value &demand_member(
+        Json::Value *object,
+        const char *key,
+        const size_t key_len
+    ) const;
+
+    //
+    //  Public static functions.
+    //
+
+    /**
+     *  Hash a key (8 bytes at a time).
+     *
+     *  @param key
+     *      The key.
+     *  @param key_len
+     *      The length of the key.
+     *  @return
+     *      The hash.
+     */
+    static uint64_t hash_key(const char *key, const size_t key_len) noexcept;
+
+protected:
+
+    //
+    //  Protected methods.
+    //
+
+    /**
+     *  Get the member index of an object node (the index is built on first
+     *  use, see Document::index_members()).
+     *
+     *  @note
+     *      Readers may share the document across threads, so the indexes are
+     *      looked up without lock and only built under the lock.
+     *  @param node
+     *      The node.
+     *  @param count
+     *      The count of members of the node.
+     *  @return
+     *      The index (nullptr if memory allocation was failed).
+     */
+    const xap::core::json::MemberIndex *get_member_index(
+        const xap::core::json::Node node,
+        const size_t count
+    ) const noexcept;
+
+    /**
+     *  Add the members of an object node to its member index.
+     *
+     *  @note
+     *      Members must be added in order so that the last one of duplicate
+     *      keys wins. The default implementation adds nothing.
+     *  @param node
+     *      The node.
+     *  @param index
+     *      The index.
+     */
+    virtual void index_members(
+        const xap::core::json::Node node,
+        xap::core::json::MemberIndex *index
+    ) const noexcept;
+
+    /**
+     *  Remove all member indexes (before the document is modified).
+     */
+    void clear_member_indexes() noexcept;
+
+private:
+
+    //
+    //  Private members.
+    //
+    std::shared_ptr<xap::core::json::ArenaPrivate> m_arena;
+    std::shared_ptr<xap::core::json::KeyTablePrivate> m_keys;
+    mutable xap::core::json::MemberIndexes m_member_indexes;
+
+    //
+    //  Private constructor.
+    //
+    Document(const Document &) = delete;
+    Document &operator=(const Document &) = delete;
+};
+
+/**
+ *  Document backed by a Json::Value.
+ */
+class ValueDocument: public Document {
+public:
+
+    /**
+     *  Construct the object (with a 'null' root).
+     */
+    ValueDocument();
+
+    /**
+     *  Construct the object.
+     *
+     *  @param value
+     *      The root value (copied).
+     */
+    explicit ValueDocument(const Json::Value &value);
+
+    /**
+     *  Construct the object.
+     *
+     *  @param value
+     *      The root value (moved).
+     */
+    explicit ValueDocument(Json::Value &&value);
+
+    /**
+     *  Destruct the object.
+     */
+    virtual ~ValueDocument() noexcept;
+
+    //
+    //  Public methods.
+    //
+
+    /**
+     *  Get the root value.
+     *
+     *  @return
+     *      The root value.
+     */
+    Json::Value &root() noexcept;
+
+    //
+    //  Public methods (xap::core::json::Document).
+    //
+    virtual xap::core::json::Node get_root() const noexcept override;
+    virtual xap::core::json::Type get_type(
+        const xap::core::json::Node node
+    ) const noexcept override;
+    virtual xap::core::json::Number get_number(
+        const xap::core::json::Node node
+    ) const noexcept override;
+    virtual bool get_boolean(
+        const xap::core::json::Node node
+    ) const noexcept override;
+    virtual void get_string(
+        const xap::core::json::Node node,
+        const char **begin,
+        const char **end
+    ) const noexcept override;
+    virtual size_t get_size(
+        const xap::core::json::Node node
+    ) const override;
+    virtual xap::core::json::Node get_element(
+        const xap::core::json::Node node,
+        const size_t index
+    ) const override;
+    virtual bool find_member(
+        const xap::core::json::Node node,
+        const char *key,
+        const size_t key_len,
+        xap::core::json::Node *member
+    ) const override;
+    virtual bool find_member_hashed(
+        const xap::core::json::Node node,
+        const char *key,
+        const size_t key_len,
+        const uint64_t key_hash,
+        xap::core::json::Node *member
+    ) const override;
+    virtual bool foreach_member(
+        const xap::core::json::Node node,
+        const xap::core::json::MemberHandler handler,
+        void *context
+    ) const override;
+    virtual Json::Value to_value(
+        const xap::core::json::Node node
+    ) const override;
+    virtual Json::Value *get_mutable_value(
+        const xap::core::json::Node node
+    ) noexcept override;
+
+    //
+    //  Public static functions.
+    //
+
+    /**
+     *  Get the shared document whose root is 'null'.
+     *
+     *  @note
+     *      The returned document is always shared, so any modifier would
+     *      detach from it instead of writing to it.
+     *  @return
+     *      The document.
+     */
+    static const std::shared_ptr<xap::core::json::ValueDocument> &
+    null_document();
+
+    /**
+     *  Get the node of a value.
+     *
+     *  @param value
+     *      The value (must be owned by the document).
+     *  @return
+     *      The node.
+     */
+    static xap::core::json::Node to_node(const Json::Value *value) noexcept;
+
+    /**
+     *  Get the value of a node.
+     *
+     *  @param node
+     *      The node.
+     *  @return
+     *      The value.
+     */
+    static const Json::Value *to_value_pointer(
+        const xap::core::json::Node node
+    ) noexcept;
+
+protected:
+
+    //
+    //  Protected methods (xap::core::json::Document).
+    //
+    virtual void index_members(
+        const xap::core::json::Node node,
+        xap::core::json::MemberIndex *index
+    ) const noexcept override;
+
+private:
+
+    //
+    //  Private members.
+    //
+    Json::Value m_root;
+};
+
+//
+//  Functions.
+//
+
+/**
+ *  Create a document.
+ *
+ *  @throw std::bad_alloc
+ *      Raised if memory allocation was failed.
+ *  @param arena
+ *      The arena (nullptr to allocate from the heap).
+ *  @param args
+ *      The arguments of the constructor of the document.
+ *  @return
+ *      The document.
+ */
+template <typename T, typename... Args>
+std::shared_ptr<T> make_document(
+    const std::shared_ptr<xap::core::json::ArenaPrivate> &arena,
+    Args&&... args
+) {
+    std::shared_ptr<T> document = std::allocate_shared<T>(
+        xap::core::json::ArenaAllocator<T>(arena),
+        std::forward<Args>(args)...
+    );
+    document->set_arena(arena);
+    return document;
+}
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
+
+#endif  //  #ifndef XAP_CORE_JSON_DOCUMENT_P_H__
@@ -0,0 +1,425 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+//
+//  Imports.
+//
+#include "xap/core/json/document_pool.h"
+#include "document_pool_p.h"
+#include "arena_p.h"
+#include "parser_p.h"
+#include "traverse_p.h"
+#include "xap/core/json/traverse.h"
+
+#include <atomic>
+#include <memory>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string>
+
+namespace xap {
+namespace core {
+namespace json {
+
+//
+//  Constants.
+//
+
+//  The default largest size of memory blocks kept by a rewound arena.
+static const size_t DOCUMENT_POOL_RETAINED_SIZE = 16777216U;
+
+//
+//  DocumentPool constructor & destructor.
+//
+
+/**
+ *  Construct the object (with the default backend).
+ */
+DocumentPool::DocumentPool() :
+    DocumentPool(xap::core::json::Parser::get_default_backend())
+{}
+
+/**
+ *  Construct the object.
+ *
+ *  @param backend
+ *      The backend.
+ *  @param block_size
+ *      The size of the first memory block of each arena.
+ */
+DocumentPool::DocumentPool(
+    const xap::core::json::Backend backend,
+    const size_t block_size
+) :
+    m_pool(std::make_unique<xap::core::json::DocumentPoolPrivate>(
+        backend,
+        block_size
+    ))
+{}
+
+/**
+ *  Destruct the object.
+ */
+DocumentPool::~DocumentPool() noexcept {
+    //  Do nothing.
+}
+
+//
+//  DocumentPool public methods.
+//
+
+/**
+ *  Parse a JSON document (into a recycled arena).
+ *
+ *  @throw xap::core::json::Exception
+ *      Raised if JSON parsing was failed (ERROR_PARAMETER).
+ *  @param data
+ *      The JSON data.
+ *  @param datalen
+ *      The length of JSON data.
+ *  @param path
+ *      The path.
+ *  @return
+ *      Traverse object of the root.
+ */
+xap::core::json::Traverse DocumentPool::parse(
+    const uint8_t *data,
+    const size_t datalen,
+    const std::string &path
+) {
+    return xap::core::json::Traverse(
+        this->m_pool->parse(data, datalen, path)
+    );
+}
+
+/**
+ *  Parse a JSON document (into a recycled arena).
+ *
+ *  @throw xap::core::json::Exception
+ *      Raised if JSON parsing was failed (ERROR_PARAMETER).
+ *  @param data
+ *      The JSON data.
+ *  @param datalen
+ *      The length of JSON data.
+ *  @param path
+ *      The path.
+ *  @return
+ *      Traverse object of the root.
+ */
+xap::core::json::Traverse DocumentPool::parse(
+    const char *data,
+    const size_t datalen,
+    const std::string &path
+) {
+    return xap::core::json::Traverse(
+        this->m_pool->parse(
+            reinterpret_cast<const uint8_t *>(data),
+            datalen,
+            path
+        )
+    );
+}
+
+/**
+ *  Parse a JSON document (into a recycled arena).
+ *
+ *  @throw xap::core::json::Exception
+ *      Raised if JSON parsing was failed (ERROR_PARAMETER).
+ *  @param json_string
+ *      The JSON string.
+ *  @param path
+ *      The path.
+ *  @return
+ *      Traverse object of the root.
+ */
+xap::core::json::Traverse DocumentPool::parse(
+    const std::string &json_string,
+    const std::string &path
+) {
+    return xap::core::json::Traverse(
+        this->m_pool->parse(
+            reinterpret_cast<const uint8_t *>(json_string.data()),
+            json_string.size(),
+            path
+        )
+    );
+}
+
+/**
+ *  Set the largest size of memory blocks that an arena keeps when it is
+ *  rewound.
+ *
+ *  @param size
+ *      The size (16 MiB by default).
+ */
+void DocumentPool::set_retained_size(const size_t size) noexcept {
+    this->m_pool->set_retained_size(size);
+}
+
+/**
+ *  Get the largest size of memory blocks that an arena keeps when it is
+ *  rewound.
+ *
+ *  @return
+ *      The size.
+ */
+size_t DocumentPool::get_retained_size() const noexcept {
+    return this->m_pool->get_retained_size();
+}
+
+/**
+ *  Set whether the input is validated as UTF-8.
+ *
+ *  @param validate
+ *      True if so.
+ */
+void DocumentPool::set_utf8_validation(const bool validate) noexcept {
+    this->m_pool->set_utf8_validation(validate);
+}
+
+/**
+ *  Set the key table of documents parsed afterwards.
+ *
+ *  @param keys
+ *      The key table (nullptr to not intern the keys, which is the default).
+ */
+void DocumentPool::set_key_table(
+    const xap::core::json::KeyTable *keys
+) noexcept {
+    if (keys) {
+        this->m_pool->set_key_table(keys->m_table);
+    } else {
+        this->m_pool->set_key_table(nullptr);
+    }
+}
+
+/**
+ *  Get the count of arenas (documents that are used, and the ones that can
+ *  be recycled).
+ *
+ *  @return
+ *      The count.
+ */
+size_t DocumentPool::get_arena_count() const noexcept {
+    return this->m_pool->get_arena_count();
+}
+
+/**
+ *  Get the count of arenas that can be recycled (whose documents were
+ *  released).
+ *
+ *  @return
+ *      The count.
+ */
+size_t DocumentPool::get_idle_count() const noexcept {
+    return this->m_pool->get_idle_count();
+}
+
+/**
+ *  Get the size of memory blocks reserved by all arenas.
+ *
+ *  @return
+ *      The size.
+ */
+size_t DocumentPool::get_reserved_size() const noexcept {
+    return this->m_pool->get_reserved_size();
+}
+
+//
+//  DocumentPoolPrivate constructor & destructor.
+//
+
+/**
+ *  Construct the object.
+ *
+ *  @param backend
+ *      The backend.
+ *  @param block_size
+ *      The size of the first memory block of each arena.
+ */
+DocumentPoolPrivate::DocumentPoolPrivate(
+    const xap::core::json::Backend backend,
+    const size_t block_size
+) :
+    m_parser(backend),
+    m_arenas(),
+    m_last(0U),
+    m_block_size(block_size),
+    m_retained_size(DOCUMENT_POOL_RETAINED_SIZE)
+{}
+
+/**
+ *  Destruct the object.
+ */
+DocumentPoolPrivate::~DocumentPoolPrivate() noexcept {
+    //  Do nothing.
+}
+
+//
+//  DocumentPoolPrivate public methods.
+//
+
+/**
+ *  Parse a JSON document (into a recycled arena).
+ *
+ *  @throw xap::core::json::Exception
+ *      Raised if JSON parsing was failed (ERROR_PARAMETER).
+ *  @param data
+ *      The JSON data.
+ *  @param datalen
+ *      The length of JSON data.
+ *  @param path
+ *      The path.
+ *  @return
+ *      Private traverse object of the root.
+ */
+std::unique_ptr<xap::core::json::TraversePrivate> DocumentPoolPrivate::parse(
+    const uint8_t *data,
+    const size_t datalen,
+    const std::string &path
+) {
+    //  The parser doesn't keep the arena, so that the arena is referred to
+    //  by the pool and the document only.
+    this->m_parser.set_arena(this->acquire());
+    try {
+        std::unique_ptr<xap::core::json::TraversePrivate> root =
+            this->m_parser.parse(data, datalen, path);
+        this->m_parser.set_arena(nullptr);
+        return root;
+    } catch (...) {
+        this->m_parser.set_arena(nullptr);
+        throw;
+    }
+}
+
+/**
+ *  Set the largest size of memory blocks that an arena keeps when it is
+ *  rewound.
+ *
+ *  @param size
+ *      The size.
+ */
+void DocumentPoolPrivate::set_retained_size(const size_t size) noexcept {
+    this->m_retained_size = size;
+}
+
+/**
+ *  Get the largest size of memory blocks that an arena keeps when it is
+ *  rewound.
+ *
+ *  @return
+ *      The size.
+ */
+size_t DocumentPoolPrivate::get_retained_size() const noexcept {
+    return this->m_retained_size;
+}
+
+/**
+ *  Set whether the input is validated as UTF-8.
+ *
+ *  @param validate
+ *      True if so.
+ */
+void DocumentPoolPrivate::set_utf8_validation(const bool validate) noexcept {
+    this->m_parser.set_utf8_validation(validate);
+}
+
+/**
+ *  Set the key table of documents parsed afterwards.
+ *
+ *  @param keys
+ *      The key table (nullptr if the keys are not interned).
+ */
+void DocumentPoolPrivate::set_key_table(
+    const std::shared_ptr<xap::core::json::KeyTablePrivate> &keys
+) noexcept {
+    this->m_parser.set_key_table(keys);
+}
+
+/**
+ *  Get the count of arenas.
+ *
+ *  @return
+ *      The count.
+ */
+size_t DocumentPoolPrivate::get_arena_count() const noexcept {
+    return this->m_arenas.size();
+}
+
+/**
+ *  Get the count of arenas that can be recycled.
+ *
+ *  @return
+ *      The count.
+ */
+size_t DocumentPoolPrivate::get_idle_count() const noexcept {
+    size_t count = 0U;
+    for (const auto &arena : this->m_arenas) {
+        if (arena.use_count() == 1) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+/**
+ *  Get the size of memory blocks reserved by all arenas.
+ *
+ *  @return
+ *      The size.
+ */
+size_t DocumentPoolPrivate::get_reserved_size() const noexcept {
+    size_t size = 0U;
+    for (const auto &arena : this->m_arenas) {
+        size += arena->get_reserved_size();
+    }
+    return size;
+}
+
+//
+//  DocumentPoolPrivate private methods.
+//
+
+/**
+ *  Get an arena that is no longer used (rewound), or a new one.
+ *
+ *  @throw std::bad_alloc
+ *      Raised if memory allocation was failed.
+ *  @return
+ *      The arena.
+ */
+const std::shared_ptr<xap::core::json::ArenaPrivate> &
+DocumentPoolPrivate::acquire() {
+    //  Look for an idle arena, from the last acquired one (it is likely
+    //  released already when documents are handled one after another, and
+    //  its blocks are still warm and fit the documents).
+    const size_t count = this->m_arenas.size();
+    for (size_t i = 0U; i < count; ++i) {
+        const size_t index = (this->m_last + i) % count;
+        std::shared_ptr<xap::core::json::ArenaPrivate> &arena =
+            this->m_arenas[index];
+        if (arena.use_count() != 1) {
+            continue;
+        }
+
+        //  The last owner (maybe on another thread) released the arena
+        //  before the count dropped, make its writes visible.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        arena->reset(this->m_retained_size);
+        this->m_last = index;
+        return arena;
+    }
+
+    this->m_arenas.push_back(
+        std::make_shared<xap::core::json::ArenaPrivate>(this->m_block_size)
+    );
+    this->m_last = this->m_arenas.size() - 1U;
+    return this->m_arenas.back();
+}
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
@@ -0,0 +1,184 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+#ifndef XAP_CORE_JSON_DOCUMENT_POOL_P_H__
+#define XAP_CORE_JSON_DOCUMENT_POOL_P_H__
+
+//
+//  Imports.
+//
+#include "xap/core/json/build.h"
+#include "xap/core/json/parser.h"
+#include "arena_p.h"
+#include "key_table_p.h"
+#include "parser_p.h"
+#include "traverse_p.h"
+
+#include <memory>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+namespace xap {
+namespace core {
+namespace json {
+
+//
+//  Classes.
+//
+
+/**
+ *  Private document pool.
+ *
+ *  @note
+ *      The pool shares each of its arenas with the documents parsed into it
+ *      (through the arena allocators of the documents and their traverse
+ *      objects). An arena that is referred to by the pool only is no longer
+ *      used, so it is rewound and reused.
+ */
+class DocumentPoolPrivate {
+public:
+
+    /**
+     *  Construct the object.
+     *
+     *  @param backend
+     *      The backend.
+     *  @param block_size
+     *      The size of the first memory block of each arena.
+     */
+    DocumentPoolPrivate(
+        const xap::core::json::Backend backend,
+        const size_t block_size
+    );
+
+    /**
+     *  Destruct the object.
+     */
+    virtual ~DocumentPoolPrivate() noexcept;
+
+    //
+    //  Public methods.
+    //
+
+    /**
+     *  Parse a JSON document (into a recycled arena).
+     *
+     *  @throw xap::core::json::Exception
+     *      Raised if JSON parsing was failed (ERROR_PARAMETER).
+     *  @param data
+     *      The JSON data.
+     *  @param datalen
+     *      The length of JSON data.
+     *  @param path
+     *      The path.
+     *  @return
+     *      Private traverse object of the root.
+     */
+    std::unique_ptr<xap::core::json::TraversePrivate> parse(
+        const uint8_t *data,
+        const size_t datalen,
+        const std::string &path
+    );
+
+    /**
+     *  Set the largest size of memory blocks that an arena keeps when it is
+     *  rewound.
+     *
+     *  @param size
+     *      The size.
+     */
+    void set_retained_size(const size_t size) noexcept;
+
+    /**
+     *  Get the largest size of memory blocks that an arena keeps when it is
+     *  rewound.
+     *
+     *  @return
+     *      The size.
+     */
+    size_t get_retained_size() const noexcept;
+
+    /**
+     *  Set whether the input is validated as UTF-8.
+     *
+     *  @param validate
+     *      True if so.
+     */
+    void set_utf8_validation(const bool validate) noexcept;
+
+    /**
+     *  Set the key table of documents parsed afterwards.
+     *
+     *  @param keys
+     *      The key table (nullptr if the keys are not interned).
+     */
+    void set_key_table(
+        const std::shared_ptr<xap::core::json::KeyTablePrivate> &keys
+    ) noexcept;
+
+    /**
+     *  Get the count of arenas.
+     *
+     *  @return
+     *      The count.
+     */
+    size_t get_arena_count() const noexcept;
+
+    /**
+     *  Get the count of arenas that can be recycled.
+     *
+     *  @return
+     *      The count.
+     */
+    size_t get_idle_count() const noexcept;
+
+    /**
+     *  Get the size of memory blocks reserved by all arenas.
+     *
+     *  @return
+     *      The size.
+     */
+    size_t get_reserved_size() const noexcept;
+
+private:
+
+    //
+    //  Private methods.
+    //
+
+    /**
+     *  Get an arena that is no longer used (rewound), or a new one.
+     *
+     *  @throw std::bad_alloc
+     *      Raised if memory allocation was failed.
+     *  @return
+     *      The arena.
+     */
+    const std::shared_ptr<xap::core::json::ArenaPrivate> &acquire();
+
+    //
+    //  Private members.
+    //
+    xap::core::json::ParserPrivate m_parser;
+    std::vector<std::shared_ptr<xap::core::json::ArenaPrivate>> m_arenas;
+    size_t m_last;
+    size_t m_block_size;
+    size_t m_retained_size;
+
+    //
+    //  Private constructor.
+    //
+    DocumentPoolPrivate(const DocumentPoolPrivate &) = delete;
+    DocumentPoolPrivate &operator=(const DocumentPoolPrivate &) = delete;
+};
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
+
+#endif  //  #ifndef XAP_CORE_JSON_DOCUMENT_POOL_P_H__
@@ -0,0 +1,281 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+//
+//  Imports.
+//
+#include "xap/core/json/extract.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+namespace xap {
+namespace core {
+namespace json {
+
+//
+//  Private functions.
+//
+
+/**
+ *  Get the address of the destination of an extracted field.
+ *
+ *  @param field
+ *      The destination.
+ *  @param object
+ *      Not used.
+ *  @return
+ *      The address.
+ */
+static void *locate_destination(const void *field, void *object) {
+    (void)object;
+    return const_cast<void*>(field);
+}
+
+//
+//  ExtractField constructors.
+//
+
+/**
+ *  Construct the object.
+ *
+ *  @param key
+ *      The key of the member.
+ *  @param destination
+ *      The destination (the member must be an integer that fits in int).
+ *  @param required
+ *      Whether the member must exist (and must not be null).
+ */
+ExtractField::ExtractField(
+    const char *key,
+    int *destination,
+    const bool required
+) noexcept {
+    this->initialize(
+        key,
+        xap::core::json::BindTable::Kind::int_value,
+        destination,
+        required
+    );
+}
+
+/**
+ *  Construct the object.
+ *
+ *  @param key
+ *      The key of the member.
+ *  @param destination
+ *      The destination (the member must be an integer that fits in uint).
+ *  @param required
+ *      Whether the member must exist (and must not be null).
+ */
+ExtractField::ExtractField(
+    const char *key,
+    uint *destination,
+    const bool required
+) noexcept {
+    this->initialize(
+        key,
+        xap::core::json::BindTable::Kind::uint_value,
+        destination,
+        required
+    );
+}
+
+#if defined(XAPCORE_JSON_INT64)
+
+/**
+ *  Construct the object.
+ *
+ *  @param key
+ *      The key of the member.
+ *  @param destination
+ *      The destination (the member must be an integer that fits in int64_t).
+ *  @param required
+ *      Whether the member must exist (and must not be null).
+ */
+ExtractField::ExtractField(
+    const char *key,
+    int64_t *destination,
+    const bool required
+) noexcept {
+    this->initialize(
+        key,
+        xap::core::json::BindTable::Kind::int64_value,
+        destination,
+        required
+    );
+}
+
+/**
+ *  Construct the object.
+ *
+ *  @param key
+ *      The key of the member.
+ *  @param destination
+ *      The destination (the member must be an integer that fits in
+ *      uint64_t).
+ *  @param required
+ *      Whether the member must exist (and must not be null).
+ */
+ExtractField::ExtractField(
+    const char *key,
+    uint64_t *destination,
+    const bool required
+) noexcept {
+    this->initialize(
+        key,
+        xap::core::json::BindTable::Kind::uint64_value,
+        destination,
+        required
+    );
+}
+
+#endif  //  #if defined(XAPCORE_JSON_INT64)
+
+/**
+ *  Construct the object.
+ *
+ *  @param key
+ *      The key of the member.
+ *  @param destination
+ *      The destination (the member must be numeric).
+ *  @param required
+ *      Whether the member must exist (and must not be null).
+ */
+ExtractField::ExtractField(
+    const char *key,
+    float *destination,
+    const bool required
+) noexcept {
+    this->initialize(
+        key,
+        xap::core::json::BindTable::Kind::float_value,
+        destination,
+        required
+    );
+}
+
+/**
+ *  Construct the object.
+ *
+ *  @param key
+ *      The key of the member.
+ *  @param destination
+ *      The destination (the member must be numeric).
+ *  @param required
+ *      Whether the member must exist (and must not be null).
+ */
+ExtractField::ExtractField(
+    const char *key,
+    double *destination,
+    const bool required
+) noexcept {
+    this->initialize(
+        key,
+        xap::core::json::BindTable::Kind::double_value,
+        destination,
+        required
+    );
+}
+
+/**
+ *  Construct the object.
+ *
+ *  @param key
+ *      The key of the member.
+ *  @param destination
+ *      The destination (the member must be boolean).
+ *  @param required
+ *      Whether the member must exist (and must not be null).
+ */
+ExtractField::ExtractField(
+    const char *key,
+    bool *destination,
+    const bool required
+) noexcept {
+    this->initialize(
+        key,
+        xap::core::json::BindTable::Kind::boolean_value,
+        destination,
+        required
+    );
+}
+
+/**
+ *  Construct the object.
+ *
+ *  @param key
+ *      The key of the member.
+ *  @param destination
+ *      The destination (the member must be a string).
+ *  @param required
+ *      Whether the member must exist (and must not be null).
+ */
+ExtractField::ExtractField(
+    const char *key,
+    std::string *destination,
+    const bool required
+) noexcept {
+    this->initialize(
+        key,
+        xap::core::json::BindTable::Kind::string_value,
+        destination,
+        required
+    );
+}
+
+//
+//  ExtractField public methods.
+//
+
+/**
+ *  Get the entry of the field.
+ *
+ *  @return
+ *      The entry.
+ */
+const xap::core::json::BindTable::Entry &
+ExtractField::get_entry() const noexcept {
+    return this->m_entry;
+}
+
+//
+//  ExtractField private methods.
+//
+
+/**
+ *  Initialize the entry.
+ *
+ *  @param key
+ *      The key of the member.
+ *  @param kind
+ *      The kind of the destination.
+ *  @param destination
+ *      The destination.
+ *  @param required
+ *      Whether the member must exist (and must not be null).
+ */
+void ExtractField::initialize(
+    const char *key,
+    const xap::core::json::BindTable::Kind kind,
+    void *destination,
+    const bool required
+) noexcept {
+    this->m_entry.key = key;
+    this->m_entry.key_length = strlen(key);
+    this->m_entry.kind = kind;
+    this->m_entry.required = required;
+    this->m_entry.nested = nullptr;
+    this->m_entry.locate = &locate_destination;
+    this->m_entry.field = destination;
+}
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
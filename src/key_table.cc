@@ -0,0 +1,404 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+//
+//  Imports.
+//
+#include "xap/core/json/key_table.h"
+#include "key_table_p.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace xap {
+namespace core {
+namespace json {
+
+//
+//  Constants.
+//
+
+//  The longest key to be interned.
+static const size_t KEY_TABLE_KEY_LENGTH_LIMIT = 256U;
+
+//  Count of slots of the first index.
+static const size_t KEY_TABLE_MIN_SLOTS = 64U;
+
+//  Size of each memory block of the keys.
+static const size_t KEY_TABLE_BLOCK_SIZE = 16384U;
+
+//  The largest count of keys of the global table.
+static const size_t KEY_TABLE_GLOBAL_CAPACITY = 65536U;
+
+//
+//  KeyTable constructor & destructor.
+//
+
+/**
+ *  Construct the object (an empty private table).
+ *
+ *  @param capacity
+ *      The largest count of keys.
+ */
+KeyTable::KeyTable(const size_t capacity) :
+    m_table(std::make_shared<xap::core::json::KeyTablePrivate>(
+        capacity,
+        false
+    ))
+{}
+
+/**
+ *  Construct (Copy) the object.
+ *
+ *  @note
+ *      The copy shares the keys with the source.
+ *  @param src
+ *      The source.
+ */
+KeyTable::KeyTable(const KeyTable &src) :
+    m_table(src.m_table)
+{}
+
+/**
+ *  Construct the object.
+ *
+ *  @param table
+ *      The private table (shared).
+ */
+KeyTable::KeyTable(
+    const std::shared_ptr<xap::core::json::KeyTablePrivate> &table
+) :
+    m_table(table)
+{}
+
+/**
+ *  Destruct the object.
+ */
+KeyTable::~KeyTable() noexcept {
+    //  Do nothing.
+}
+
+//
+//  KeyTable operators.
+//
+
+/**
+ *  Assign (Copy) the object.
+ *
+ *  @note
+ *      The object shares the keys with the source.
+ *  @param src
+ *      The source.
+ *  @return
+ *      Self.
+ */
+xap::core::json::KeyTable &KeyTable::operator=(const KeyTable &src) {
+    this->m_table = src.m_table;
+    return *this;
+}
+
+//
+//  KeyTable public methods.
+//
+
+/**
+ *  Get the count of keys.
+ *
+ *  @return
+ *      The count.
+ */
+size_t KeyTable::get_count() const noexcept {
+    return this->m_table->get_count();
+}
+
+/**
+ *  Get the largest count of keys.
+ *
+ *  @return
+ *      The count.
+ */
+size_t KeyTable::get_capacity() const noexcept {
+    return this->m_table->get_capacity();
+}
+
+/**
+ *  Get whether the table is the global table.
+ *
+ *  @return
+ *      True if so.
+ */
+bool KeyTable::is_global() const noexcept {
+    return this->m_table->is_global();
+}
+
+//
+//  KeyTable public static functions.
+//
+
+/**
+ *  Get the global table (process-wide, never released).
+ *
+ *  @return
+ *      The table.
+ */
+xap::core::json::KeyTable KeyTable::get_global() {
+    return xap::core::json::KeyTable(
+        xap::core::json::KeyTablePrivate::get_global()
+    );
+}
+
+//
+//  KeyTablePrivate constructor & destructor.
+//
+
+/**
+ *  Construct the object.
+ *
+ *  @param capacity
+ *      The largest count of keys.
+ *  @param global
+ *      True if the table is the global table.
+ */
+KeyTablePrivate::KeyTablePrivate(const size_t capacity, const bool global) :
+    m_lock(),
+    m_index(nullptr),
+    m_indexes(),
+    m_storage(
+        std::make_shared<xap::core::json::ArenaPrivate>(KEY_TABLE_BLOCK_SIZE)
+    ),
+    m_count(0U),
+    m_capacity(capacity),
+    m_global(global)
+{}
+
+/**
+ *  Destruct the object.
+ */
+KeyTablePrivate::~KeyTablePrivate() noexcept {
+    //  Do nothing.
+}
+
+//
+//  KeyTablePrivate public methods.
+//
+
+/**
+ *  Find a key.
+ *
+ *  @param key
+ *      The key.
+ *  @param key_len
+ *      The length of the key.
+ *  @param key_hash
+ *      The hash of the key (see Document::hash_key()).
+ *  @return
+ *      The entry (nullptr if the key is not interned).
+ */
+const xap::core::json::KeyEntry *KeyTablePrivate::find(
+    const char *key,
+    const size_t key_len,
+    const uint64_t key_hash
+) const noexcept {
+    const Index *index = this->m_index.load(std::memory_order_acquire);
+    if (index == nullptr) {
+        return nullptr;
+    }
+
+    size_t slot = static_cast<size_t>(key_hash) & index->mask;
+    while (true) {
+        const xap::core::json::KeyEntry *entry =
+            index->slots[slot].load(std::memory_order_acquire);
+        if (entry == nullptr) {
+            return nullptr;
+        }
+        if (
+            entry->hash == key_hash &&
+            static_cast<size_t>(entry->length) == key_len &&
+            memcmp(entry->key, key, key_len) == 0
+        ) {
+            return entry;
+        }
+        slot = (slot + 1U) & index->mask;
+    }
+}
+
+/**
+ *  Intern a key.
+ *
+ *  @throw std::bad_alloc
+ *      Raised if memory allocation was failed.
+ *  @param key
+ *      The key.
+ *  @param key_len
+ *      The length of the key.
+ *  @param key_hash
+ *      The hash of the key (see Document::hash_key()).
+ *  @return
+ *      The entry (nullptr if the key is too long or the table is full).
+ */
+const xap::core::json::KeyEntry *KeyTablePrivate::intern(
+    const char *key,
+    const size_t key_len,
+    const uint64_t key_hash
+) {
+    if (key_len > KEY_TABLE_KEY_LENGTH_LIMIT) {
+        return nullptr;
+    }
+    const xap::core::json::KeyEntry *found =
+        this->find(key, key_len, key_hash);
+    if (found) {
+        return found;
+    }
+
+    std::lock_guard<std::mutex> guard(this->m_lock);
+
+    //  Another thread may have interned the key.
+    found = this->find(key, key_len, key_hash);
+    if (found) {
+        return found;
+    }
+    const size_t count = this->m_count.load(std::memory_order_relaxed);
+    if (count >= this->m_capacity) {
+        return nullptr;
+    }
+
+    //  Grow the index (to keep it half empty at most). The grown index is
+    //  published after it is filled.
+    Index *index = this->m_index.load(std::memory_order_relaxed);
+    if (index == nullptr || (count + 1U) * 2U > index->mask + 1U) {
+        const size_t slot_count = (
+            index == nullptr ? KEY_TABLE_MIN_SLOTS : (index->mask + 1U) * 2U
+        );
+        std::unique_ptr<Index> grown(new Index());
+        grown->mask = slot_count - 1U;
+        grown->slots.reset(
+            new std::atomic<const xap::core::json::KeyEntry*>[slot_count]
+        );
+        for (size_t i = 0U; i < slot_count; ++i) {
+            grown->slots[i].store(nullptr, std::memory_order_relaxed);
+        }
+        if (index) {
+            for (size_t i = 0U; i <= index->mask; ++i) {
+                const xap::core::json::KeyEntry *entry =
+                    index->slots[i].load(std::memory_order_relaxed);
+                if (entry) {
+                    KeyTablePrivate::put(grown.get(), entry);
+                }
+            }
+        }
+        this->m_indexes.push_back(std::move(grown));
+        index = this->m_indexes.back().get();
+        this->m_index.store(index, std::memory_order_release);
+    }
+
+    //  Store the key (and its entry) in the arena of the table.
+    char *memory = static_cast<char*>(this->m_storage->allocate(
+        sizeof(xap::core::json::KeyEntry) + key_len + 1U,
+        alignof(xap::core::json::KeyEntry)
+    ));
+    char *copy = memory + sizeof(xap::core::json::KeyEntry);
+    memcpy(copy, key, key_len);
+    copy[key_len] = '\0';
+    xap::core::json::KeyEntry *entry =
+        new (memory) xap::core::json::KeyEntry();
+    entry->hash = key_hash;
+    entry->id = static_cast<uint32_t>(count + 1U);
+    entry->length = static_cast<uint32_t>(key_len);
+    entry->is_c_string = (memchr(key, '\0', key_len) == nullptr);
+    entry->key = copy;
+
+    KeyTablePrivate::put(index, entry);
+    this->m_count.store(count + 1U, std::memory_order_relaxed);
+    return entry;
+}
+
+/**
+ *  Get the count of keys.
+ *
+ *  @return
+ *      The count.
+ */
+size_t KeyTablePrivate::get_count() const noexcept {
+    return this->m_count.load(std::memory_order_relaxed);
+}
+
+/**
+ *  Get the largest count of keys.
+ *
+ *  @return
+ *      The count.
+ */
+size_t KeyTablePrivate::get_capacity() const noexcept {
+    return this->m_capacity;
+}
+
+/**
+ *  Get whether the table is the global table (the keys are never
+ *  released).
+ *
+ *  @return
+ *      True if so.
+ */
+bool KeyTablePrivate::is_global() const noexcept {
+    return this->m_global;
+}
+
+//
+//  KeyTablePrivate public static functions.
+//
+
+/**
+ *  Get the global table.
+ *
+ *  @return
+ *      The table.
+ */
+const std::shared_ptr<xap::core::json::KeyTablePrivate> &
+KeyTablePrivate::get_global() {
+    //  Never destructed, Json::Value trees (that may be destructed after
+    //  the static objects) refer to the keys.
+    static const std::shared_ptr<xap::core::json::KeyTablePrivate> *global =
+        new std::shared_ptr<xap::core::json::KeyTablePrivate>(
+            std::make_shared<xap::core::json::KeyTablePrivate>(
+                KEY_TABLE_GLOBAL_CAPACITY,
+                true
+            )
+        );
+    return *global;
+}
+
+//
+//  KeyTablePrivate private methods.
+//
+
+/**
+ *  Put an entry into an index (the index must not be full).
+ *
+ *  @param index
+ *      The index.
+ *  @param entry
+ *      The entry.
+ */
+void KeyTablePrivate::put(
+    xap::core::json::KeyTablePrivate::Index *index,
+    const xap::core::json::KeyEntry *entry
+) noexcept {
+    size_t slot = static_cast<size_t>(entry->hash) & index->mask;
+    while (index->slots[slot].load(std::memory_order_relaxed) != nullptr) {
+        slot = (slot + 1U) & index->mask;
+    }
+    index->slots[slot].store(entry, std::memory_order_release);
+}
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
@@ -0,0 +1,222 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+#ifndef XAP_CORE_JSON_KEY_TABLE_P_H__
+#define XAP_CORE_JSON_KEY_TABLE_P_H__
+
+//
+//  Imports.
+//
+#include "xap/core/json/build.h"
+#include "arena_p.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <vector>
+
+namespace xap {
+namespace core {
+namespace json {
+
+//
+//  Structures.
+//
+
+/**
+ *  Interned key.
+ */
+struct KeyEntry {
+    //  Hash of the key (see Document::hash_key()).
+    uint64_t hash;
+
+    //  ID of the key (starts from 1).
+    uint32_t id;
+
+    //  Length of the key.
+    uint32_t length;
+
+    //  Whether the key contains no NUL character (so it can be used as a
+    //  Json::StaticString).
+    bool is_c_string;
+
+    //  The key (terminated by NUL).
+    const char *key;
+};
+
+//
+//  Classes.
+//
+
+/**
+ *  Private key table.
+ *
+ *  @note
+ *      The keys are indexed by an open-addressing hash table of entry
+ *      pointers. Keys are only inserted (under the lock), and a grown index
+ *      is published after it is filled, so readers look keys up without
+ *      lock. Replaced indexes are kept until the table is destructed since
+ *      readers may still be using them.
+ */
+class KeyTablePrivate {
+public:
+
+    /**
+     *  Construct the object.
+     *
+     *  @param capacity
+     *      The largest count of keys.
+     *  @param global
+     *      True if the table is the global table.
+     */
+    KeyTablePrivate(const size_t capacity, const bool global);
+
+    /**
+     *  Destruct the object.
+     */
+    virtual ~KeyTablePrivate() noexcept;
+
+    //
+    //  Public methods.
+    //
+
+    /**
+     *  Find a key.
+     *
+     *  @param key
+     *      The key.
+     *  @param key_len
+     *      The length of the key.
+     *  @param key_hash
+     *      The hash of the key (see Document::hash_key()).
+     *  @return
+     *      The entry (nullptr if the key is not interned).
+     */
+    const xap::core::json::KeyEntry *find(
+        const char *key,
+        const size_t key_len,
+        const uint64_t key_hash
+    ) const noexcept;
+
+    /**
+     *  Intern a key.
+     *
+     *  @throw std::bad_alloc
+     *      Raised if memory allocation was failed.
+     *  @param key
+     *      The key.
+     *  @param key_len
+     *      The length of the key.
+     *  @param key_hash
+     *      The hash of the key (see Document::hash_key()).
+     *  @return
+     *      The entry (nullptr if the key is too long or the table is full).
+     */
+    const xap::core::json::KeyEntry *intern(
+        const char *key,
+        const size_t key_len,
+        const uint64_t key_hash
+    );
+
+    /**
+     *  Get the count of keys.
+     *
+     *  @return
+     *      The count.
+     */
+    size_t get_count() const noexcept;
+
+    /**
+     *  Get the largest count of keys.
+     *
+     *  @return
+     *      The count.
+     */
+    size_t get_capacity() const noexcept;
+
+    /**
+     *  Get whether the table is the global table (the keys are never
+     *  released).
+     *
+     *  @return
+     *      True if so.
+     */
+    bool is_global() const noexcept;
+
+    //
+    //  Public static functions.
+    //
+
+    /**
+     *  Get the global table.
+     *
+     *  @return
+     *      The table.
+     */
+    static const std::shared_ptr<xap::core::json::KeyTablePrivate> &
+    get_global();
+
+private:
+
+    //
+    //  Private structures.
+    //
+
+    /**
+     *  Index (open-addressing hash table).
+     */
+    struct Index {
+        //  Mask of slot indexes (the count of slots minus 1).
+        size_t mask;
+
+        //  Slots.
+        std::unique_ptr<std::atomic<const xap::core::json::KeyEntry*>[]>
+            slots;
+    };
+
+    //
+    //  Private methods.
+    //
+
+    /**
+     *  Put an entry into an index (the index must not be full).
+     *
+     *  @param index
+     *      The index.
+     *  @param entry
+     *      The entry.
+     */
+    static void put(
+        xap::core::json::KeyTablePrivate::Index *index,
+        const xap::core::json::KeyEntry *entry
+    ) noexcept;
+
+    //
+    //  Private members.
+    //
+    mutable std::mutex m_lock;
+    std::atomic<Index*> m_index;
+    std::vector<std::unique_ptr<Index>> m_indexes;
+    std::shared_ptr<xap::core::json::ArenaPrivate> m_storage;
+    std::atomic<size_t> m_count;
+    size_t m_capacity;
+    bool m_global;
+
+    //
+    //  Private constructor.
+    //
+    KeyTablePrivate(const KeyTablePrivate &) = delete;
+    KeyTablePrivate &operator=(const KeyTablePrivate &) = delete;
+};
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
+
+#endif  //  #ifndef XAP_CORE_JSON_KEY_TABLE_P_H__
@@ -0,0 +1,666 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+//
+//  Imports.
+//
+#include "xap/core/json/lines_reader.h"
+#include "lines_reader_p.h"
+#include "arena_p.h"
+#include "mapped_file_p.h"
+#include "parser_p.h"
+#include "traverse_p.h"
+#include "xap/core/json/error.h"
+#include "xap/core/json/traverse.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string.h>
+#include <thread>
+#include <utility>
+
+namespace xap {
+namespace core {
+namespace json {
+
+//
+//  Constants.
+//
+
+//  The (minimum) size of a batch of lines.
+static const size_t LINES_BATCH_SIZE = 65536U;
+
+//  Count of batches (per worker) that may be parsed ahead of the handler.
+static const size_t LINES_BATCHES_AHEAD = 4U;
+
+//
+//  Private functions.
+//
+
+/**
+ *  Get whether a character is a whitespace (of JSON).
+ *
+ *  @param ch
+ *      The character.
+ *  @return
+ *      True if so.
+ */
+static inline bool is_whitespace(const char ch) noexcept {
+    return ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n';
+}
+
+/**
+ *  Hand the records of a parsed batch to the handler.
+ *
+ *  @throw xap::core::json::Exception
+ *      Raised if the batch was failed.
+ *  @param batch
+ *      The batch.
+ *  @param handler
+ *      The handler of records.
+ *  @return
+ *      The count of records.
+ */
+static size_t deliver(
+    xap::core::json::LinesBatch &batch,
+    const std::function<void(
+        const size_t,
+        std::unique_ptr<xap::core::json::TraversePrivate> &&
+    )> &handler
+) {
+    const size_t count = batch.records.size();
+    for (auto &record : batch.records) {
+        handler(record.first, std::move(record.second));
+    }
+    batch.records.clear();
+    batch.records.shrink_to_fit();
+
+    if (batch.failed) {
+        throw xap::core::json::Exception(
+            batch.error_message.c_str(),
+            batch.error_code,
+            batch.error_path.c_str()
+        );
+    }
+    return count;
+}
+
+//
+//  LinesReader constructor & destructor.
+//
+
+/**
+ *  Construct the object (with the default backend and one worker per CPU
+ *  core).
+ */
+LinesReader::LinesReader() :
+    LinesReader(xap::core::json::Parser::get_default_backend())
+{}
+
+/**
+ *  Construct the object.
+ *
+ *  @param backend
+ *      The backend.
+ *  @param workers
+ *      The count of workers (0 for one worker per CPU core, 1 to parse on
+ *      the calling thread).
+ */
+LinesReader::LinesReader(
+    const xap::core::json::Backend backend,
+    const size_t workers
+) :
+    m_reader(
+        std::make_unique<xap::core::json::LinesReaderPrivate>(
+            backend,
+            workers
+        )
+    )
+{}
+
+/**
+ *  Destruct the object.
+ */
+LinesReader::~LinesReader() noexcept {
+    //  Do nothing.
+}
+
+//
+//  LinesReader public methods.
+//
+
+/**
+ *  Read JSON Lines.
+ *
+ *  @throw xap::core::json::Exception
+ *      Raised if JSON parsing of a record was failed (ERROR_PARAMETER, with
+ *      the path of the record). The records before it are handed to the
+ *      handler first. Exceptions thrown by the handler are propagated (the
+ *      remaining records are dropped).
+ *  @param data
+ *      The JSON Lines data (must be kept until this method returns).
+ *  @param datalen
+ *      The length of JSON Lines data.
+ *  @param handler
+ *      The handler of records (called with the index of the line and
+ *      Traverse object of the record).
+ *  @param path
+ *      The path.
+ *  @return
+ *      The count of records.
+ */
+size_t LinesReader::read(
+    const char *data,
+    const size_t datalen,
+    std::function<void(const size_t, xap::core::json::Traverse &)> handler,
+    const std::string &path
+) {
+    return this->m_reader->read(
+        data,
+        datalen,
+        [&handler] (
+            const size_t line,
+            std::unique_ptr<xap::core::json::TraversePrivate> &&root
+        ) {
+            xap::core::json::Traverse record(std::move(root));
+            handler(line, record);
+        },
+        path
+    );
+}
+
+/**
+ *  Read JSON Lines.
+ *
+ *  @throw xap::core::json::Exception
+ *      See read(const char*, size_t, ...).
+ *  @param data
+ *      The JSON Lines data.
+ *  @param handler
+ *      The handler of records (called with the index of the line and
+ *      Traverse object of the record).
+ *  @param path
+ *      The path.
+ *  @return
+ *      The count of records.
+ */
+size_t LinesReader::read(
+    const std::string &data,
+    std::function<void(const size_t, xap::core::json::Traverse &)> handler,
+    const std::string &path
+) {
+    return this->read(data.data(), data.size(), std::move(handler), path);
+}
+
+/**
+ *  Read a JSON Lines file (memory-mapped).
+ *
+ *  @throw xap::core::json::Exception
+ *      Raised if the file can't be read (ERROR_PARAMETER), otherwise see
+ *      read(const char*, size_t, ...).
+ *  @param filename
+ *      The file name.
+ *  @param handler
+ *      The handler of records (called with the index of the line and
+ *      Traverse object of the record).
+ *  @param path
+ *      The path.
+ *  @return
+ *      The count of records.
+ */
+size_t LinesReader::read_file(
+    const std::string &filename,
+    std::function<void(const size_t, xap::core::json::Traverse &)> handler,
+    const std::string &path
+) {
+    return this->m_reader->read_file(
+        filename,
+        [&handler] (
+            const size_t line,
+            std::unique_ptr<xap::core::json::TraversePrivate> &&root
+        ) {
+            xap::core::json::Traverse record(std::move(root));
+            handler(line, record);
+        },
+        path
+    );
+}
+
+/**
+ *  Set the count of workers.
+ *
+ *  @param workers
+ *      The count of workers (0 for one worker per CPU core, 1 to parse on
+ *      the calling thread).
+ */
+void LinesReader::set_workers(const size_t workers) {
+    this->m_reader->set_workers(workers);
+}
+
+/**
+ *  Get the count of workers.
+ *
+ *  @return
+ *      The count of workers.
+ */
+size_t LinesReader::get_workers() const noexcept {
+    return this->m_reader->get_workers();
+}
+
+/**
+ *  Set the arena of records parsed afterwards.
+ *
+ *  @param arena
+ *      The arena (nullptr to allocate from the heap, which is the default).
+ */
+void LinesReader::set_arena(const xap::core::json::Arena *arena) noexcept {
+    if (arena) {
+        this->m_reader->set_arena(arena->m_arena);
+    } else {
+        this->m_reader->set_arena(nullptr);
+    }
+}
+
+/**
+ *  Set the key table of records parsed afterwards.
+ *
+ *  @param keys
+ *      The key table (nullptr to not intern the keys, which is the default).
+ */
+void LinesReader::set_key_table(
+    const xap::core::json::KeyTable *keys
+) noexcept {
+    if (keys) {
+        this->m_reader->set_key_table(keys->m_table);
+    } else {
+        this->m_reader->set_key_table(nullptr);
+    }
+}
+
+//
+//  LinesReaderPrivate constructor & destructor.
+//
+
+/**
+ *  Construct the object.
+ *
+ *  @param backend
+ *      The backend.
+ *  @param workers
+ *      The count of workers (0 for one worker per CPU core).
+ */
+LinesReaderPrivate::LinesReaderPrivate(
+    const xap::core::json::Backend backend,
+    const size_t workers
+) :
+    m_backend(backend),
+    m_workers(1U),
+    m_parsers(),
+    m_batches(),
+    m_arena(),
+    m_keys()
+{
+    this->set_workers(workers);
+}
+
+/**
+ *  Destruct the object.
+ */
+LinesReaderPrivate::~LinesReaderPrivate() noexcept {
+    //  Do nothing.
+}
+
+//
+//  LinesReaderPrivate public methods.
+//
+
+/**
+ *  Read JSON Lines.
+ *
+ *  @throw xap::core::json::Exception
+ *      Raised if JSON parsing of a record was failed (ERROR_PARAMETER).
+ *  @param data
+ *      The JSON Lines data.
+ *  @param datalen
+ *      The length of JSON Lines data.
+ *  @param handler
+ *      The handler of records.
+ *  @param path
+ *      The path.
+ *  @return
+ *      The count of records.
+ */
+size_t LinesReaderPrivate::read(
+    const char *data,
+    const size_t datalen,
+    const std::function<void(
+        const size_t,
+        std::unique_ptr<xap::core::json::TraversePrivate> &&
+    )> &handler,
+    const std::string &path
+) {
+    this->split(data, datalen);
+    const size_t batch_count = this->m_batches.size();
+    const size_t workers = std::max<size_t>(
+        std::min(this->m_workers, batch_count),
+        1U
+    );
+    while (this->m_parsers.size() < workers) {
+        this->m_parsers.push_back(
+            std::make_unique<xap::core::json::ParserPrivate>(this->m_backend)
+        );
+        this->m_parsers.back()->set_arena(this->m_arena);
+        this->m_parsers.back()->set_key_table(this->m_keys);
+    }
+
+    size_t count = 0U;
+    if (workers == 1U) {
+        try {
+            for (xap::core::json::LinesBatch &batch : this->m_batches) {
+                parse_batch(*(this->m_parsers[0]), batch, path);
+                count += deliver(batch, handler);
+            }
+        } catch (...) {
+            this->m_batches.clear();
+            throw;
+        }
+        this->m_batches.clear();
+        return count;
+    }
+
+    //  The workers take the batches in order, but don't run further ahead of
+    //  the handler than a few batches each (so that the memory is bounded).
+    std::mutex lock;
+    std::condition_variable cond;
+    size_t next = 0U;
+    size_t delivered = 0U;
+    bool stop = false;
+    const size_t ahead = workers * LINES_BATCHES_AHEAD;
+    auto work = [&] (xap::core::json::ParserPrivate *parser) {
+        std::unique_lock<std::mutex> guard(lock);
+        while (true) {
+            cond.wait(guard, [&] {
+                return stop || next >= batch_count || next < delivered + ahead;
+            });
+            if (stop || next >= batch_count) {
+                return;
+            }
+            xap::core::json::LinesBatch &batch = this->m_batches[next++];
+            guard.unlock();
+            parse_batch(*parser, batch, path);
+            guard.lock();
+            batch.done = true;
+            cond.notify_all();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    auto join = [&] () {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stop = true;
+        }
+        cond.notify_all();
+        for (std::thread &thread : threads) {
+            thread.join();
+        }
+        this->m_batches.clear();
+    };
+    try {
+        for (size_t i = 0U; i < workers; ++i) {
+            threads.emplace_back(work, this->m_parsers[i].get());
+        }
+
+        //  Hand the records to the handler in order (on this thread).
+        for (size_t i = 0U; i < batch_count; ++i) {
+            xap::core::json::LinesBatch &batch = this->m_batches[i];
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                cond.wait(guard, [&batch] { return batch.done; });
+            }
+            count += deliver(batch, handler);
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                delivered = i + 1U;
+            }
+            cond.notify_all();
+        }
+    } catch (...) {
+        join();
+        throw;
+    }
+    join();
+    return count;
+}
+
+/**
+ *  Read a JSON Lines file.
+ *
+ *  @throw xap::core::json::Exception
+ *      Raised if the file can't be read or JSON parsing of a record was
+ *      failed (ERROR_PARAMETER).
+ *  @param filename
+ *      The file name.
+ *  @param handler
+ *      The handler of records.
+ *  @param path
+ *      The path.
+ *  @return
+ *      The count of records.
+ */
+size_t LinesReaderPrivate::read_file(
+    const std::string &filename,
+    const std::function<void(
+        const size_t,
+        std::unique_ptr<xap::core::json::TraversePrivate> &&
+    )> &handler,
+    const std::string &path
+) {
+    xap::core::json::MappedFile file;
+    std::string error;
+    if (!file.open(filename, &error)) {
+        throw xap::core::json::Exception(
+            error.c_str(),
+            xap::core::json::ERROR_PARAMETER,
+            path.c_str()
+        );
+    }
+
+    //  Records are copied by the parsers, the mapping is not needed after.
+    file.advise_sequential();
+    return this->read(file.data(), file.size(), handler, path);
+}
+
+/**
+ *  Set the count of workers.
+ *
+ *  @param workers
+ *      The count of workers (0 for one worker per CPU core).
+ */
+void LinesReaderPrivate::set_workers(const size_t workers) {
+    if (workers == 0U) {
+        this->m_workers = std::max<size_t>(
+            std::thread::hardware_concurrency(),
+            1U
+        );
+    } else {
+        this->m_workers = workers;
+    }
+}
+
+/**
+ *  Get the count of workers.
+ *
+ *  @return
+ *      The count of workers.
+ */
+size_t LinesReaderPrivate::get_workers() const noexcept {
+    return this->m_workers;
+}
+
+/**
+ *  Set the arena of records parsed afterwards.
+ *
+ *  @param arena
+ *      The arena (nullptr to allocate from the heap).
+ */
+void LinesReaderPrivate::set_arena(
+    const std::shared_ptr<xap::core::json::ArenaPrivate> &arena
+) noexcept {
+    this->m_arena = arena;
+    for (auto &parser : this->m_parsers) {
+        parser->set_arena(arena);
+    }
+}
+
+/**
+ *  Set the key table of records parsed afterwards.
+ *
+ *  @param keys
+ *      The key table (nullptr if the keys are not interned).
+ */
+void LinesReaderPrivate::set_key_table(
+    const std::shared_ptr<xap::core::json::KeyTablePrivate> &keys
+) noexcept {
+    this->m_keys = keys;
+    for (auto &parser : this->m_parsers) {
+        parser->set_key_table(keys);
+    }
+}
+
+//
+//  LinesReaderPrivate private methods.
+//
+
+/**
+ *  Split JSON Lines data into batches.
+ *
+ *  @param data
+ *      The JSON Lines data.
+ *  @param datalen
+ *      The length of JSON Lines data.
+ */
+void LinesReaderPrivate::split(const char *data, const size_t datalen) {
+    this->m_batches.clear();
+
+    const char *end = data + datalen;
+    const char *cursor = data;
+    size_t line = 0U;
+    while (cursor < end) {
+        //  Extend the batch to the end of the line at its (minimum) size.
+        const char *batch_end = end;
+        if (static_cast<size_t>(end - cursor) > LINES_BATCH_SIZE) {
+            const char *newline = static_cast<const char*>(memchr(
+                cursor + LINES_BATCH_SIZE,
+                '\n',
+                static_cast<size_t>(end - cursor) - LINES_BATCH_SIZE
+            ));
+            if (newline) {
+                batch_end = newline + 1;
+            }
+        }
+
+        xap::core::json::LinesBatch batch;
+        batch.begin = cursor;
+        batch.end = batch_end;
+        batch.first_line = line;
+        batch.done = false;
+        batch.failed = false;
+        batch.error_code = 0U;
+        this->m_batches.push_back(std::move(batch));
+
+        //  Count the lines (the index of the first line of the next batch).
+        while (cursor < batch_end) {
+            const char *newline = static_cast<const char*>(memchr(
+                cursor,
+                '\n',
+                static_cast<size_t>(batch_end - cursor)
+            ));
+            if (!newline) {
+                break;
+            }
+            ++line;
+            cursor = newline + 1;
+        }
+        cursor = batch_end;
+    }
+}
+
+/**
+ *  Parse the records of a batch.
+ *
+ *  @param parser
+ *      The parser (of the worker).
+ *  @param batch
+ *      The batch.
+ *  @param path
+ *      The path.
+ */
+void LinesReaderPrivate::parse_batch(
+    xap::core::json::ParserPrivate &parser,
+    xap::core::json::LinesBatch &batch,
+    const std::string &path
+) {
+    std::string record_path = path;
+    if (record_path.size() == 0U || *(record_path.end() - 1U) != '/') {
+        record_path.push_back('/');
+    }
+    const size_t prefix_length = record_path.size();
+
+    const char *cursor = batch.begin;
+    size_t line = batch.first_line;
+    try {
+        while (cursor < batch.end) {
+            const char *newline = static_cast<const char*>(memchr(
+                cursor,
+                '\n',
+                static_cast<size_t>(batch.end - cursor)
+            ));
+            const char *line_end = newline ? newline : batch.end;
+
+            //  Skip empty lines.
+            const char *first = cursor;
+            while (first < line_end && is_whitespace(*first)) {
+                ++first;
+            }
+            if (first != line_end) {
+                record_path.resize(prefix_length);
+                record_path.append(std::to_string(line));
+                batch.records.emplace_back(
+                    line,
+                    parser.parse(
+                        reinterpret_cast<const uint8_t*>(cursor),
+                        static_cast<size_t>(line_end - cursor),
+                        record_path
+                    )
+                );
+            }
+
+            if (!newline) {
+                break;
+            }
+            cursor = newline + 1;
+            ++line;
+        }
+    } catch (xap::core::json::Exception &error) {
+        batch.failed = true;
+        batch.error_message = error.what();
+        batch.error_code = error.get_code();
+        batch.error_path = error.get_path();
+    } catch (std::exception &error) {
+        batch.failed = true;
+        batch.error_message = error.what();
+        batch.error_code = xap::core::json::ERROR_BUG;
+        batch.error_path = record_path;
+    }
+}
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
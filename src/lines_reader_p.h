@@ -0,0 +1,226 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+#ifndef XAP_CORE_JSON_LINES_READER_P_H__
+#define XAP_CORE_JSON_LINES_READER_P_H__
+
+//
+//  Imports.
+//
+#include "xap/core/json/build.h"
+#include "xap/core/json/parser.h"
+#include "arena_p.h"
+#include "parser_p.h"
+#include "traverse_p.h"
+
+#include <functional>
+#include <memory>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace xap {
+namespace core {
+namespace json {
+
+//
+//  Structures.
+//
+
+/**
+ *  A batch of whole lines (parsed by one worker).
+ */
+struct LinesBatch {
+    //  The lines.
+    const char *begin;
+    const char *end;
+
+    //  The index of the first line.
+    size_t first_line;
+
+    //  The records (with the indexes of their lines).
+    std::vector<
+        std::pair<size_t, std::unique_ptr<xap::core::json::TraversePrivate>>
+    > records;
+
+    //  True once the batch is parsed.
+    bool done;
+
+    //  The error (if the batch was failed, the records before it are kept).
+    bool failed;
+    std::string error_message;
+    uint16_t error_code;
+    std::string error_path;
+};
+
+//
+//  Classes.
+//
+
+/**
+ *  Private JSON Lines reader.
+ */
+class LinesReaderPrivate {
+public:
+
+    /**
+     *  Construct the object.
+     *
+     *  @param backend
+     *      The backend.
+     *  @param workers
+     *      The count of workers (0 for one worker per CPU core).
+     */
+    LinesReaderPrivate(
+        const xap::core::json::Backend backend,
+        const size_t workers
+    );
+
+    /**
+     *  Destruct the object.
+     */
+    virtual ~LinesReaderPrivate() noexcept;
+
+    //
+    //  Public methods.
+    //
+
+    /**
+     *  Read JSON Lines.
+     *
+     *  @throw xap::core::json::Exception
+     *      Raised if JSON parsing of a record was failed (ERROR_PARAMETER).
+     *  @param data
+     *      The JSON Lines data.
+     *  @param datalen
+     *      The length of JSON Lines data.
+     *  @param handler
+     *      The handler of records.
+     *  @param path
+     *      The path.
+     *  @return
+     *      The count of records.
+     */
+    size_t read(
+        const char *data,
+        const size_t datalen,
+        const std::function<void(
+            const size_t,
+            std::unique_ptr<xap::core::json::TraversePrivate> &&
+        )> &handler,
+        const std::string &path
+    );
+
+    /**
+     *  Read a JSON Lines file.
+     *
+     *  @throw xap::core::json::Exception
+     *      Raised if the file can't be read or JSON parsing of a record was
+     *      failed (ERROR_PARAMETER).
+     *  @param filename
+     *      The file name.
+     *  @param handler
+     *      The handler of records.
+     *  @param path
+     *      The path.
+     *  @return
+     *      The count of records.
+     */
+    size_t read_file(
+        const std::string &filename,
+        const std::function<void(
+            const size_t,
+            std::unique_ptr<xap::core::json::TraversePrivate> &&
+        )> &handler,
+        const std::string &path
+    );
+
+    /**
+     *  Set the count of workers.
+     *
+     *  @param workers
+     *      The count of workers (0 for one worker per CPU core).
+     */
+    void set_workers(const size_t workers);
+
+    /**
+     *  Get the count of workers.
+     *
+     *  @return
+     *      The count of workers.
+     */
+    size_t get_workers() const noexcept;
+
+    /**
+     *  Set the arena of records parsed afterwards.
+     *
+     *  @param arena
+     *      The arena (nullptr to allocate from the heap).
+     */
+    void set_arena(
+        const std::shared_ptr<xap::core::json::ArenaPrivate> &arena
+    ) noexcept;
+
+    /**
+     *  Set the key table of records parsed afterwards.
+     *
+     *  @param keys
+     *      The key table (nullptr if the keys are not interned).
+     */
+    void set_key_table(
+        const std::shared_ptr<xap::core::json::KeyTablePrivate> &keys
+    ) noexcept;
+
+private:
+
+    //
+    //  Private methods.
+    //
+
+    /**
+     *  Split JSON Lines data into batches.
+     *
+     *  @param data
+     *      The JSON Lines data.
+     *  @param datalen
+     *      The length of JSON Lines data.
+     */
+    void split(const char *data, const size_t datalen);
+
+    /**
+     *  Parse the records of a batch.
+     *
+     *  @param parser
+     *      The parser (of the worker).
+     *  @param batch
+     *      The batch.
+     *  @param path
+     *      The path.
+     */
+    static void parse_batch(
+        xap::core::json::ParserPrivate &parser,
+        xap::core::json::LinesBatch &batch,
+        const std::string &path
+    );
+
+    //
+    //  Private members.
+    //
+    xap::core::json::Backend m_backend;
+    size_t m_workers;
+    std::vector<std::unique_ptr<xap::core::json::ParserPrivate>> m_parsers;
+    std::vector<xap::core::json::LinesBatch> m_batches;
+    std::shared_ptr<xap::core::json::ArenaPrivate> m_arena;
+    std::shared_ptr<xap::core::json::KeyTablePrivate> m_keys;
+};
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
+
+#endif  //  #ifndef XAP_CORE_JSON_LINES_READER_P_H__
@@ -0,0 +1,223 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+//
+//  Imports.
+//
+#include "mapped_file_p.h"
+
+#include <errno.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#if defined(XAPCORE_JSON_MMAP)
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif  //  #if defined(XAPCORE_JSON_MMAP)
+
+namespace xap {
+namespace core {
+namespace json {
+
+//
+//  Private functions.
+//
+
+/**
+ *  Format an error message.
+ *
+ *  @param what
+ *      What was failed.
+ *  @param filename
+ *      The file name.
+ *  @param code
+ *      The error number.
+ *  @param error
+ *      The pointer to receive the error message.
+ *  @return
+ *      False.
+ */
+static bool set_error(
+    const char *what,
+    const std::string &filename,
+    const int code,
+    std::string *error
+) {
+    error->assign(what);
+    error->append(" \"");
+    error->append(filename);
+    error->append("\" (");
+    error->append(strerror(code));
+    error->append(").");
+    return false;
+}
+
+//
+//  MappedFile constructor & destructor.
+//
+
+/**
+ *  Construct the object (not opened).
+ */
+MappedFile::MappedFile() noexcept :
+    m_data(nullptr),
+    m_size(0U),
+    m_mapped(false),
+    m_buffer()
+{}
+
+/**
+ *  Destruct the object (the file is unmapped).
+ */
+MappedFile::~MappedFile() noexcept {
+#if defined(XAPCORE_JSON_MMAP)
+    if (this->m_mapped) {
+        munmap(this->m_data, this->m_size);
+    }
+#endif  //  #if defined(XAPCORE_JSON_MMAP)
+}
+
+//
+//  MappedFile public methods.
+//
+
+/**
+ *  Open and map a file.
+ *
+ *  @param filename
+ *      The file name.
+ *  @param error
+ *      The pointer to receive the error message.
+ *  @return
+ *      True if succeed.
+ */
+bool MappedFile::open(const std::string &filename, std::string *error) {
+#if defined(XAPCORE_JSON_MMAP)
+    const int fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return set_error("Failed to open", filename, errno, error);
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        const int code = errno;
+        close(fd);
+        return set_error("Failed to stat", filename, code, error);
+    }
+    if (!S_ISREG(info.st_mode)) {
+        close(fd);
+        return set_error("Failed to map", filename, EINVAL, error);
+    }
+
+    //  Empty files can't be mapped.
+    if (info.st_size == 0) {
+        close(fd);
+        this->m_buffer.assign(1U, '\0');
+        this->m_data = this->m_buffer.data();
+        this->m_size = 0U;
+        return true;
+    }
+
+    //  The mapping is private, so strings can be decoded in place without
+    //  modifying the file.
+    const size_t size = static_cast<size_t>(info.st_size);
+    void *mapping = mmap(
+        nullptr,
+        size,
+        PROT_READ | PROT_WRITE,
+        MAP_PRIVATE,
+        fd,
+        0
+    );
+    const int code = errno;
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        return set_error("Failed to map", filename, code, error);
+    }
+
+    this->m_data = static_cast<char*>(mapping);
+    this->m_size = size;
+    this->m_mapped = true;
+    return true;
+#else
+    FILE *fp = fopen(filename.c_str(), "rb");
+    if (fp == nullptr) {
+        return set_error("Failed to open", filename, errno, error);
+    }
+
+    //  Read the whole file.
+    char chunk[65536];
+    size_t length;
+    while ((length = fread(chunk, 1U, sizeof(chunk), fp)) != 0U) {
+        this->m_buffer.insert(this->m_buffer.end(), chunk, chunk + length);
+    }
+    const bool failed = ferror(fp) != 0;
+    fclose(fp);
+    if (failed) {
+        return set_error("Failed to read", filename, EIO, error);
+    }
+
+    this->m_size = this->m_buffer.size();
+    this->m_buffer.push_back('\0');
+    this->m_data = this->m_buffer.data();
+    return true;
+#endif  //  #if defined(XAPCORE_JSON_MMAP)
+}
+
+/**
+ *  Get the contents.
+ *
+ *  @return
+ *      The contents (writable, the file is not affected).
+ */
+char *MappedFile::data() const noexcept {
+    return this->m_data;
+}
+
+/**
+ *  Get the size of the contents.
+ *
+ *  @return
+ *      The size.
+ */
+size_t MappedFile::size() const noexcept {
+    return this->m_size;
+}
+
+/**
+ *  Hint that the contents will be read sequentially (aggressive readahead,
+ *  e.g. while parsing).
+ */
+void MappedFile::advise_sequential() const noexcept {
+#if defined(XAPCORE_JSON_MMAP)
+    if (this->m_mapped) {
+        madvise(this->m_data, this->m_size, MADV_SEQUENTIAL);
+        madvise(this->m_data, this->m_size, MADV_WILLNEED);
+    }
+#endif  //  #if defined(XAPCORE_JSON_MMAP)
+}
+
+/**
+ *  Restore the default readahead (e.g. once parsing is done and the document
+ *  is traversed randomly).
+ */
+void MappedFile::advise_normal() const noexcept {
+#if defined(XAPCORE_JSON_MMAP)
+    if (this->m_mapped) {
+        madvise(this->m_data, this->m_size, MADV_NORMAL);
+    }
+#endif  //  #if defined(XAPCORE_JSON_MMAP)
+}
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
@@ -0,0 +1,126 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+#ifndef XAP_CORE_JSON_MAPPED_FILE_P_H__
+#define XAP_CORE_JSON_MAPPED_FILE_P_H__
+
+//
+//  Imports.
+//
+#include "xap/core/json/build.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+//
+//  Macro
+//
+
+//  Memory-mapped file check.
+#if defined(__unix__) || defined(__APPLE__)
+# define XAPCORE_JSON_MMAP
+#endif  //  #if defined(__unix__) || defined(__APPLE__)
+
+namespace xap {
+namespace core {
+namespace json {
+
+//
+//  Classes.
+//
+
+/**
+ *  Memory-mapped file.
+ *
+ *  @note
+ *      The file is mapped privately (copy-on-write): the file itself is never
+ *      modified, and only the pages that are written (e.g. strings with
+ *      escape sequences that are decoded in place) are copied into memory.
+ *      Other pages are shared with the page cache.
+ *
+ *      On platforms without mmap(), the file is read into a buffer instead.
+ */
+class MappedFile {
+public:
+
+    /**
+     *  Construct the object (not opened).
+     */
+    MappedFile() noexcept;
+
+    /**
+     *  Destruct the object (the file is unmapped).
+     */
+    virtual ~MappedFile() noexcept;
+
+    //
+    //  Public methods.
+    //
+
+    /**
+     *  Open and map a file.
+     *
+     *  @param filename
+     *      The file name.
+     *  @param error
+     *      The pointer to receive the error message.
+     *  @return
+     *      True if succeed.
+     */
+    bool open(const std::string &filename, std::string *error);
+
+    /**
+     *  Get the contents.
+     *
+     *  @return
+     *      The contents (writable, the file is not affected).
+     */
+    char *data() const noexcept;
+
+    /**
+     *  Get the size of the contents.
+     *
+     *  @return
+     *      The size.
+     */
+    size_t size() const noexcept;
+
+    /**
+     *  Hint that the contents will be read sequentially (aggressive
+     *  readahead, e.g. while parsing).
+     */
+    void advise_sequential() const noexcept;
+
+    /**
+     *  Restore the default readahead (e.g. once parsing is done and the
+     *  document is traversed randomly).
+     */
+    void advise_normal() const noexcept;
+
+private:
+
+    //
+    //  Private members.
+    //
+    char *m_data;
+    size_t m_size;
+    bool m_mapped;
+    std::vector<char> m_buffer;
+
+    //
+    //  Private constructor.
+    //
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+};
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
+
+#endif  //  #ifndef XAP_CORE_JSON_MAPPED_FILE_P_H__
@@ -0,0 +1,328 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+//
+//  Imports.
+//
+#include "member_index_p.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <utility>
+
+namespace xap {
+namespace core {
+namespace json {
+
+//
+//  Constants.
+//
+
+//  Smallest count of slots of a member index.
+static const size_t MEMBER_INDEX_MIN_SLOTS = 64U;
+
+//  Count of slots of the first table of member indexes.
+static const size_t MEMBER_INDEXES_MIN_SLOTS = 16U;
+
+//
+//  MemberIndex constructor & destructor.
+//
+
+/**
+ *  Construct the object.
+ *
+ *  @param node
+ *      The object node.
+ *  @param count
+ *      The count of members.
+ */
+MemberIndex::MemberIndex(
+    const xap::core::json::Node node,
+    const size_t count
+) :
+    m_node(node),
+    m_mask(0U),
+    m_slots()
+{
+    //  Keep the table half empty at most.
+    size_t slot_count = MEMBER_INDEX_MIN_SLOTS;
+    while (slot_count < count * 2U) {
+        slot_count *= 2U;
+    }
+    this->m_mask = slot_count - 1U;
+    this->m_slots.reset(new Slot[slot_count]());
+}
+
+/**
+ *  Destruct the object.
+ */
+MemberIndex::~MemberIndex() noexcept {
+    //  Do nothing.
+}
+
+//
+//  MemberIndex public methods.
+//
+
+/**
+ *  Add a member (the member replaces the one with the same key).
+ *
+ *  @param key
+ *      The key.
+ *  @param key_len
+ *      The length of the key.
+ *  @param key_hash
+ *      The hash of the key (see Document::hash_key()).
+ *  @param member
+ *      The node of the member.
+ */
+void MemberIndex::insert(
+    const char *key,
+    const size_t key_len,
+    const uint64_t key_hash,
+    const xap::core::json::Node member
+) noexcept {
+    const uint32_t tag = static_cast<uint32_t>(key_hash >> 32);
+    size_t slot = static_cast<size_t>(key_hash) & this->m_mask;
+    while (true) {
+        Slot &current = this->m_slots[slot];
+        if (current.key == nullptr) {
+            current.key = key;
+            current.key_length = static_cast<uint32_t>(key_len);
+            current.tag = tag;
+            current.member = member;
+            return;
+        }
+        if (
+            current.tag == tag &&
+            static_cast<size_t>(current.key_length) == key_len &&
+            memcmp(current.key, key, key_len) == 0
+        ) {
+            current.member = member;
+            return;
+        }
+        slot = (slot + 1U) & this->m_mask;
+    }
+}
+
+/**
+ *  Find a member.
+ *
+ *  @param key
+ *      The key.
+ *  @param key_len
+ *      The length of the key.
+ *  @param key_hash
+ *      The hash of the key (see Document::hash_key()).
+ *  @param member
+ *      The pointer to receive the node of the member.
+ *  @return
+ *      True if found.
+ */
+bool MemberIndex::find(
+    const char *key,
+    const size_t key_len,
+    const uint64_t key_hash,
+    xap::core::json::Node *member
+) const noexcept {
+    const uint32_t tag = static_cast<uint32_t>(key_hash >> 32);
+    size_t slot = static_cast<size_t>(key_hash) & this->m_mask;
+    while (true) {
+        const Slot &current = this->m_slots[slot];
+        if (current.key == nullptr) {
+            return false;
+        }
+        if (
+            current.tag == tag &&
+            static_cast<size_t>(current.key_length) == key_len &&
+            memcmp(current.key, key, key_len) == 0
+        ) {
+            *member = current.member;
+            return true;
+        }
+        slot = (slot + 1U) & this->m_mask;
+    }
+}
+
+/**
+ *  Get the object node.
+ *
+ *  @return
+ *      The node.
+ */
+xap::core::json::Node MemberIndex::get_node() const noexcept {
+    return this->m_node;
+}
+
+//
+//  MemberIndexes constructor & destructor.
+//
+
+/**
+ *  Construct the object.
+ */
+MemberIndexes::MemberIndexes() :
+    m_lock(),
+    m_table(nullptr),
+    m_tables(),
+    m_indexes()
+{}
+
+/**
+ *  Destruct the object.
+ */
+MemberIndexes::~MemberIndexes() noexcept {
+    //  Do nothing.
+}
+
+//
+//  MemberIndexes public methods.
+//
+
+/**
+ *  Find the index of an object node.
+ *
+ *  @param node
+ *      The object node.
+ *  @return
+ *      The index (nullptr if not built yet).
+ */
+const xap::core::json::MemberIndex *MemberIndexes::find(
+    const xap::core::json::Node node
+) const noexcept {
+    const Table *table = this->m_table.load(std::memory_order_acquire);
+    if (table == nullptr) {
+        return nullptr;
+    }
+
+    size_t slot = MemberIndexes::get_slot(node, table->mask);
+    while (true) {
+        const xap::core::json::MemberIndex *index =
+            table->slots[slot].load(std::memory_order_acquire);
+        if (index == nullptr || index->get_node() == node) {
+            return index;
+        }
+        slot = (slot + 1U) & table->mask;
+    }
+}
+
+/**
+ *  Add an index (the caller must hold the lock).
+ *
+ *  @throw std::bad_alloc
+ *      Raised if memory allocation was failed.
+ *  @param index
+ *      The index (moved).
+ *  @return
+ *      The index.
+ */
+const xap::core::json::MemberIndex *MemberIndexes::insert(
+    std::unique_ptr<xap::core::json::MemberIndex> &&index
+) {
+    const size_t count = this->m_indexes.size();
+    this->m_indexes.reserve(count + 1U);
+
+    //  Grow the table (to keep it half empty at most). The grown table is
+    //  published after it is filled.
+    Table *table = this->m_table.load(std::memory_order_relaxed);
+    if (table == nullptr || (count + 1U) * 2U > table->mask + 1U) {
+        const size_t slot_count = (
+            table == nullptr ?
+                MEMBER_INDEXES_MIN_SLOTS :
+                (table->mask + 1U) * 2U
+        );
+        std::unique_ptr<Table> grown(new Table());
+        grown->mask = slot_count - 1U;
+        grown->slots.reset(
+            new std::atomic<const xap::core::json::MemberIndex*>[slot_count]
+        );
+        for (size_t i = 0U; i < slot_count; ++i) {
+            grown->slots[i].store(nullptr, std::memory_order_relaxed);
+        }
+        for (const auto &existing : this->m_indexes) {
+            MemberIndexes::put(grown.get(), existing.get());
+        }
+        this->m_tables.push_back(std::move(grown));
+        table = this->m_tables.back().get();
+        this->m_table.store(table, std::memory_order_release);
+    }
+
+    this->m_indexes.push_back(std::move(index));
+    const xap::core::json::MemberIndex *added = this->m_indexes.back().get();
+    MemberIndexes::put(table, added);
+    return added;
+}
+
+/**
+ *  Remove all indexes (nobody may be looking indexes up).
+ */
+void MemberIndexes::clear() noexcept {
+    this->m_table.store(nullptr, std::memory_order_relaxed);
+    this->m_tables.clear();
+    this->m_indexes.clear();
+}
+
+/**
+ *  Get the lock of building indexes.
+ *
+ *  @return
+ *      The lock.
+ */
+std::mutex &MemberIndexes::get_lock() noexcept {
+    return this->m_lock;
+}
+
+//
+//  MemberIndexes private methods.
+//
+
+/**
+ *  Put an index into a table (the table must not be full).
+ *
+ *  @param table
+ *      The table.
+ *  @param index
+ *      The index.
+ */
+void MemberIndexes::put(
+    xap::core::json::MemberIndexes::Table *table,
+    const xap::core::json::MemberIndex *index
+) noexcept {
+    size_t slot = MemberIndexes::get_slot(index->get_node(), table->mask);
+    while (table->slots[slot].load(std::memory_order_relaxed) != nullptr) {
+        slot = (slot + 1U) & table->mask;
+    }
+    table->slots[slot].store(index, std::memory_order_release);
+}
+
+/**
+ *  Get the first slot of an object node.
+ *
+ *  @param node
+ *      The object node.
+ *  @param mask
+ *      The mask of slot indexes.
+ *  @return
+ *      The slot index.
+ */
+size_t MemberIndexes::get_slot(
+    const xap::core::json::Node node,
+    const size_t mask
+) noexcept {
+    //  Nodes are tape indexes or aligned pointers, mix the bits.
+    const uint64_t hash =
+        static_cast<uint64_t>(node) * 0x9E3779B97F4A7C15ULL;
+    return static_cast<size_t>(hash >> 32) & mask;
+}
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
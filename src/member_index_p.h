@@ -0,0 +1,296 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+#ifndef XAP_CORE_JSON_MEMBER_INDEX_P_H__
+#define XAP_CORE_JSON_MEMBER_INDEX_P_H__
+
+//
+//  Imports.
+//
+#include "xap/core/json/build.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <vector>
+
+namespace xap {
+namespace core {
+namespace json {
+
+//
+//  Types.
+//
+
+/**
+ *  Node handle (its meaning depends on the document that owns the node).
+ */
+typedef uintptr_t Node;
+
+//
+//  Constants.
+//
+
+//  Smallest count of members of an object whose members are looked up by a
+//  member index.
+const static size_t MEMBER_INDEX_MIN_COUNT = 32U;
+
+//
+//  Classes.
+//
+
+/**
+ *  Member index (open-addressing hash table of the members of an object).
+ *
+ *  @note
+ *      The keys are referred to (not copied), so the object must not be
+ *      modified while the index is used.
+ */
+class MemberIndex {
+public:
+
+    /**
+     *  Construct the object.
+     *
+     *  @param node
+     *      The object node.
+     *  @param count
+     *      The count of members.
+     */
+    MemberIndex(const xap::core::json::Node node, const size_t count);
+
+    /**
+     *  Destruct the object.
+     */
+    virtual ~MemberIndex() noexcept;
+
+    //
+    //  Public methods.
+    //
+
+    /**
+     *  Add a member (the member replaces the one with the same key).
+     *
+     *  @param key
+     *      The key.
+     *  @param key_len
+     *      The length of the key.
+     *  @param key_hash
+     *      The hash of the key (see Document::hash_key()).
+     *  @param member
+     *      The node of the member.
+     */
+    void insert(
+        const char *key,
+        const size_t key_len,
+        const uint64_t key_hash,
+        const xap::core::json::Node member
+    ) noexcept;
+
+    /**
+     *  Find a member.
+     *
+     *  @param key
+     *      The key.
+     *  @param key_len
+     *      The length of the key.
+     *  @param key_hash
+     *      The hash of the key (see Document::hash_key()).
+     *  @param member
+     *      The pointer to receive the node of the member.
+     *  @return
+     *      True if found.
+     */
+    bool find(
+        const char *key,
+        const size_t key_len,
+        const uint64_t key_hash,
+        xap::core::json::Node *member
+    ) const noexcept;
+
+    /**
+     *  Get the object node.
+     *
+     *  @return
+     *      The node.
+     */
+    xap::core::json::Node get_node() const noexcept;
+
+private:
+
+    //
+    //  Private structures.
+    //
+
+    /**
+     *  Slot.
+     */
+    struct Slot {
+        //  The key (nullptr if the slot is empty).
+        const char *key;
+
+        //  The length of the key.
+        uint32_t key_length;
+
+        //  The high half of the hash of the key.
+        uint32_t tag;
+
+        //  The node of the member.
+        xap::core::json::Node member;
+    };
+
+    //
+    //  Private members.
+    //
+    xap::core::json::Node m_node;
+    size_t m_mask;
+    std::unique_ptr<Slot[]> m_slots;
+
+    //
+    //  Private constructor.
+    //
+    MemberIndex(const MemberIndex &) = delete;
+    MemberIndex &operator=(const MemberIndex &) = delete;
+};
+
+/**
+ *  Member indexes of a document (looked up by their object nodes).
+ *
+ *  @note
+ *      Indexes are only added (under the lock), and a grown table is
+ *      published after it is filled, so readers look indexes up without
+ *      lock. Replaced tables are kept until the indexes are cleared since
+ *      readers may still be using them.
+ */
+class MemberIndexes {
+public:
+
+    /**
+     *  Construct the object.
+     */
+    MemberIndexes();
+
+    /**
+     *  Destruct the object.
+     */
+    virtual ~MemberIndexes() noexcept;
+
+    //
+    //  Public methods.
+    //
+
+    /**
+     *  Find the index of an object node.
+     *
+     *  @param node
+     *      The object node.
+     *  @return
+     *      The index (nullptr if not built yet).
+     */
+    const xap::core::json::MemberIndex *find(
+        const xap::core::json::Node node
+    ) const noexcept;
+
+    /**
+     *  Add an index (the caller must hold the lock).
+     *
+     *  @throw std::bad_alloc
+     *      Raised if memory allocation was failed.
+     *  @param index
+     *      The index (moved).
+     *  @return
+     *      The index.
+     */
+    const xap::core::json::MemberIndex *insert(
+        std::unique_ptr<xap::core::json::MemberIndex> &&index
+    );
+
+    /**
+     *  Remove all indexes (nobody may be looking indexes up).
+     */
+    void clear() noexcept;
+
+    /**
+     *  Get the lock of building indexes.
+     *
+     *  @return
+     *      The lock.
+     */
+    std::mutex &get_lock() noexcept;
+
+private:
+
+    //
+    //  Private structures.
+    //
+
+    /**
+     *  Table (open-addressing hash table).
+     */
+    struct Table {
+        //  Mask of slot indexes (the count of slots minus 1).
+        size_t mask;
+
+        //  Slots.
+        std::unique_ptr<std::atomic<const xap::core::json::MemberIndex*>[]>
+            slots;
+    };
+
+    //
+    //  Private methods.
+    //
+
+    /**
+     *  Put an index into a table (the table must not be full).
+     *
+     *  @param table
+     *      The table.
+     *  @param index
+     *      The index.
+     */
+    static void put(
+        xap::core::json::MemberIndexes::Table *table,
+        const xap::core::json::MemberIndex *index
+    ) noexcept;
+
+    /**
+     *  Get the first slot of an object node.
+     *
+     *  @param node
+     *      The object node.
+     *  @param mask
+     *      The mask of slot indexes.
+     *  @return
+     *      The slot index.
+     */
+    static size_t get_slot(
+        const xap::core::json::Node node,
+        const size_t mask
+    ) noexcept;
+
+    //
+    //  Private members.
+    //
+    std::mutex m_lock;
+    std::atomic<Table*> m_table;
+    std::vector<std::unique_ptr<Table>> m_tables;
+    std::vector<std::unique_ptr<xap::core::json::MemberIndex>> m_indexes;
+
+    //
+    //  Private constructor.
+    //
+    MemberIndexes(const MemberIndexes &) = delete;
+    MemberIndexes &operator=(const MemberIndexes &) = delete;
+};
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
+
+#endif  //  #ifndef XAP_CORE_JSON_MEMBER_INDEX_P_H__
@@ -0,0 +1,168 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+#ifndef XAP_CORE_JSON_NUMBER_P_H__
+#define XAP_CORE_JSON_NUMBER_P_H__
+
+//
+//  Imports.
+//
+#include "xap/core/json/build.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+namespace xap {
+namespace core {
+namespace json {
+
+//
+//  Structures.
+//
+
+/**
+ *  Decimal number (significand * 10 ^ exponent).
+ */
+struct DecimalNumber {
+    //  The first (at most) 19 significant digits.
+    uint64_t significand;
+
+    //  The decimal exponent (of the last digit kept).
+    int64_t exponent;
+
+    //  Whether the number is negative.
+    bool negative;
+
+    //  Whether more digits followed the ones kept.
+    bool truncated;
+};
+
+//
+//  Classes.
+//
+
+/**
+ *  Number decoder (of the native parser).
+ *
+ *  @note
+ *      Integers are accumulated 8 digits at a time (SWAR, no branch per
+ *      digit). Real numbers are converted with the fast path of Clinger
+ *      (exact operations on small significands and exponents) or the
+ *      algorithm of Eisel and Lemire (a 128-bit multiplication by a
+ *      truncated power of five), both correctly rounded. The rare cases
+ *      that neither can settle (subnormals, overflows and some long
+ *      significands) fall back to the standard library, in the "C"
+ *      locale.
+ */
+class NumberDecoder {
+public:
+
+    //
+    //  Public static functions.
+    //
+
+    /**
+     *  Check whether the next 8 characters are all decimal digits.
+     *
+     *  @param cursor
+     *      The first character (at least 8 characters must be readable).
+     *  @return
+     *      True if so.
+     */
+    static bool is_eight_digits(const char *cursor) noexcept;
+
+    /**
+     *  Get the value of 8 decimal digits.
+     *
+     *  @param cursor
+     *      The first digit (see is_eight_digits()).
+     *  @return
+     *      The value.
+     */
+    static uint32_t parse_eight_digits(const char *cursor) noexcept;
+
+    /**
+     *  Skip decimal digits.
+     *
+     *  @param cursor
+     *      The first character.
+     *  @param end
+     *      The end of the input.
+     *  @return
+     *      The first character that is not a decimal digit (or end).
+     */
+    static const char *skip_digits(
+        const char *cursor,
+        const char *end
+    ) noexcept;
+
+    /**
+     *  Get the value of decimal digits.
+     *
+     *  @param begin
+     *      The first digit.
+     *  @param end
+     *      The end of the digits.
+     *  @param value
+     *      The pointer to receive the value.
+     *  @return
+     *      False if the value doesn't fit in 64 bits.
+     */
+    static bool parse_digits(
+        const char *begin,
+        const char *end,
+        uint64_t *value
+    ) noexcept;
+
+    /**
+     *  Convert a decimal number into the nearest double.
+     *
+     *  @param number
+     *      The decimal number.
+     *  @param text
+     *      The number as written (only for the fallback).
+     *  @param text_len
+     *      The length of the number as written.
+     *  @param value
+     *      The pointer to receive the value.
+     *  @return
+     *      False if the number is out of range.
+     */
+    static bool to_double(
+        const xap::core::json::DecimalNumber &number,
+        const char *text,
+        const size_t text_len,
+        double *value
+    );
+
+    /**
+     *  Convert a decimal number into the nearest double (without the
+     *  fallback).
+     *
+     *  @param significand
+     *      The significand.
+     *  @param exponent
+     *      The decimal exponent.
+     *  @param negative
+     *      Whether the number is negative.
+     *  @param value
+     *      The pointer to receive the value.
+     *  @return
+     *      False if the conversion can't be settled.
+     */
+    static bool compute_double(
+        const uint64_t significand,
+        const int64_t exponent,
+        const bool negative,
+        double *value
+    ) noexcept;
+};
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
+
+#endif  //  #ifndef XAP_CORE_JSON_NUMBER_P_H__
@@ -0,0 +1,821 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+//
+//  Imports.
+//
+#include "xap/core/json/parser.h"
+#include "parser_p.h"
+#include "arena_p.h"
+#include "document_p.h"
+#include "mapped_file_p.h"
+#include "path_p.h"
+#include "tape_p.h"
+#include "traverse_p.h"
+#include "utf8_p.h"
+#include "xap/core/json/error.h"
+#include "xap/core/json/traverse.h"
+
+#include "json/json.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace xap {
+namespace core {
+namespace json {
+
+//
+//  Private variables.
+//
+
+//  The default backend.
+static std::atomic<uint8_t> g_default_backend(
+    static_cast<uint8_t>(xap::core::json::Backend::jsoncpp)
+);
+
+//  Whether parsers validate the input as UTF-8 by default.
+static std::atomic<bool> g_default_utf8_validation(false);
+
+//
+//  Parser constructor & destructor.
+//
+
+/**
+ *  Construct the object (with the default backend).
+ */
+Parser::Parser() :
+    Parser(xap::core::json::Parser::get_default_backend())
+{}
+
+/**
+ *  Construct the object.
+ *
+ *  @param backend
+ *      The backend.
+ */
+Parser::Parser(const xap::core::json::Backend backend) :
+    m_parser(std::make_unique<xap::core::json::ParserPrivate>(backend))
+{}
+
+/**
+ *  Destruct the object.
+ */
+Parser::~Parser() noexcept {
+    //  Do nothing.
+}
+
+//
+//  Parser public methods.
+//
+
+/**
+ *  Parse a JSON document.
+ *
+ *  @throw xap::core::json::Exception
+ *      Raised if JSON parsing was failed (ERROR_PARAMETER).
+ *  @param data
+ *      The JSON data.
+ *  @param datalen
+ *      The length of JSON data.
+ *  @param path
+ *      The path.
+ *  @return
+ *      Traverse object of the root.
+ */
+xap::core::json::Traverse Parser::parse(
+    const uint8_t *data,
+    const size_t datalen,
+    const std::string &path
+) {
+    return xap::core::json::Traverse(
+        this->m_parser->parse(data, datalen, path)
+    );
+}
+
+/**
+ *  Parse a JSON document.
+ *
+ *  @throw xap::core::json::Exception
+ *      Raised if JSON parsing was failed (ERROR_PARAMETER).
+ *  @param data
+ *      The JSON data.
+ *  @param datalen
+ *      The length of JSON data.
+ *  @param path
+ *      The path.
+ *  @return
+ *      Traverse object of the root.
+ */
+xap::core::json::Traverse Parser::parse(
+    const char *data,
+    const size_t datalen,
+    const std::string &path
+) {
+    return xap::core::json::Traverse(
+        this->m_parser->parse(
+            reinterpret_cast<const uint8_t *>(data),
+            datalen,
+            path
+        )
+    );
+}
+
+/**
+ *  Parse a JSON document.
+ *
+ *  @throw xap::core::json::Exception
+ *      Raised if JSON parsing was failed (ERROR_PARAMETER).
+ *  @param json_string
+ *      The JSON string.
+ *  @param path
+ *      The path.
+ *  @return
+ *      Traverse object of the root.
+ */
+xap::core::json::Traverse Parser::parse(
+    const std::string &json_string,
+    const std::string &path
+) {
+    return xap::core::json::Traverse(
+        this->m_parser->parse(
+            reinterpret_cast<const uint8_t *>(json_string.c_str()),
+            json_string.size(),
+            path
+        )
+    );
+}
+
+/**
+ *  Parse a JSON document.
+ *
+ *  @note
+ *      The native backend takes over the string instead of copying it.
+ *  @throw xap::core::json::Exception
+ *      Raised if JSON parsing was failed (ERROR_PARAMETER).
+ *  @param json_string
+ *      The JSON string (moved).
+ *  @param path
+ *      The path.
+ *  @return
+ *      Traverse object of the root.
+ */
+xap::core::json::Traverse Parser::parse(
+    std::string &&json_string,
+    const std::string &path
+) {
+    return xap::core::json::Traverse(
+        this->m_parser->parse(std::move(json_string), path)
+    );
+}
+
+/**
+ *  Parse a JSON file.
+ *
+ *  @note
+ *      The file is memory-mapped (privately) instead of being read into
+ *      memory. With the native backend, the document refers to the mapping
+ *      (strings are not copied) and keeps it until the document is released.
+ *  @throw xap::core::json::Exception
+ *      Raised if the file can't be read or JSON parsing was failed
+ *      (ERROR_PARAMETER).
+ *  @param filename
+ *      The file name.
+ *  @param path
+ *      The path.
+ *  @return
+ *      Traverse object of the root.
+ */
+xap::core::json::Traverse Parser::parse_file(
+    const std::string &filename,
+    const std::string &path
+) {
+    return xap::core::json::Traverse(
+        this->m_parser->parse_file(filename, path)
+    );
+}
+
+/**
+ *  Set the backend.
+ *
+ *  @param backend
+ *      The backend.
+ */
+void Parser::set_backend(const xap::core::json::Backend backend) noexcept {
+    this->m_parser->set_backend(backend);
+}
+
+/**
+ *  Get the backend.
+ *
+ *  @return
+ *      The backend.
+ */
+xap::core::json::Backend Parser::get_backend() const noexcept {
+    return this->m_parser->get_backend();
+}
+
+/**
+ *  Set the arena of documents parsed afterwards.
+ *
+ *  @param arena
+ *      The arena (nullptr to allocate from the heap, which is the default).
+ */
+void Parser::set_arena(const xap::core::json::Arena *arena) noexcept {
+    if (arena) {
+        this->m_parser->set_arena(arena->m_arena);
+    } else {
+        this->m_parser->set_arena(nullptr);
+    }
+}
+
+/**
+ *  Set the key table of documents parsed afterwards.
+ *
+ *  @param keys
+ *      The key table (nullptr to not intern the keys, which is the default).
+ */
+void Parser::set_key_table(const xap::core::json::KeyTable *keys) noexcept {
+    if (keys) {
+        this->m_parser->set_key_table(keys->m_table);
+    } else {
+        this->m_parser->set_key_table(nullptr);
+    }
+}
+
+/**
+ *  Set the count of threads that parse a large document whose root is an
+ *  array.
+ *
+ *  @param workers
+ *      The count of threads (0 for one thread per CPU core, 1 to parse on the
+ *      calling thread only, which is the default).
+ */
+void Parser::set_workers(const size_t workers) {
+    this->m_parser->set_workers(workers);
+}
+
+/**
+ *  Get the count of threads that parse a large document whose root is an
+ *  array.
+ *
+ *  @return
+ *      The count of threads.
+ */
+size_t Parser::get_workers() const noexcept {
+    return this->m_parser->get_workers();
+}
+
+/**
+ *  Set whether the input is validated as UTF-8.
+ *
+ *  @param validate
+ *      True if so (get_default_utf8_validation() by default).
+ */
+void Parser::set_utf8_validation(const bool validate) noexcept {
+    this->m_parser->set_utf8_validation(validate);
+}
+
+/**
+ *  Get whether the input is validated as UTF-8.
+ *
+ *  @return
+ *      True if so.
+ */
+bool Parser::get_utf8_validation() const noexcept {
+    return this->m_parser->get_utf8_validation();
+}
+
+//
+//  Parser public static functions.
+//
+
+/**
+ *  Get the default parser of current thread.
+ *
+ *  @return
+ *      The parser.
+ */
+xap::core::json::Parser &Parser::get_default() {
+    static thread_local xap::core::json::Parser parser;
+    return parser;
+}
+
+/**
+ *  Set the default backend (of parsers constructed afterwards).
+ *
+ *  @param backend
+ *      The backend.
+ */
+void Parser::set_default_backend(
+    const xap::core::json::Backend backend
+) noexcept {
+    g_default_backend.store(static_cast<uint8_t>(backend));
+}
+
+/**
+ *  Get the default backend.
+ *
+ *  @return
+ *      The backend (xap::core::json::Backend::jsoncpp if never set).
+ */
+xap::core::json::Backend Parser::get_default_backend() noexcept {
+    return static_cast<xap::core::json::Backend>(g_default_backend.load());
+}
+
+/**
+ *  Set whether parsers constructed afterwards validate the input as UTF-8.
+ *
+ *  @param validate
+ *      True if so.
+ */
+void Parser::set_default_utf8_validation(const bool validate) noexcept {
+    g_default_utf8_validation.store(validate);
+}
+
+/**
+ *  Get whether parsers constructed afterwards validate the input as UTF-8.
+ *
+ *  @return
+ *      True if so (false if never set).
+ */
+bool Parser::get_default_utf8_validation() noexcept {
+    return g_default_utf8_validation.load();
+}
+
+//
+//  ParserPrivate constructor & destructor.
+//
+
+/**
+ *  Construct the object.
+ *
+ *  @param backend
+ *      The backend.
+ */
+ParserPrivate::ParserPrivate(const xap::core::json::Backend backend) :
+    m_backend(backend),
+    m_reader(),
+    m_error(),
+    m_tape_parser(),
+    m_arena(),
+    m_keys(),
+    m_stream(),
+    m_stream_failed(false)
+{
+    Json::CharReaderBuilder builder;
+
+    //  Comments are not reachable through xap::core::json::Traverse, don't
+    //  keep them.
+    builder["collectComments"] = false;
+
+    this->m_reader.reset(builder.newCharReader());
+    this->m_tape_parser.set_lazy(backend == xap::core::json::Backend::lazy);
+    this->m_tape_parser.set_utf8_validation(
+        xap::core::json::Parser::get_default_utf8_validation()
+    );
+}
+
+/**
+ *  Destruct the object.
+ */
+ParserPrivate::~ParserPrivate() noexcept {
+    //  Do nothing.
+}
+
+//
+//  ParserPrivate public methods.
+//
+
+/**
+ *  Parse a JSON document.
+ *
+ *  @throw xap::core::json::Exception
+ *      Raised if JSON parsing was failed (ERROR_PARAMETER).
+ *  @param data
+ *      The JSON data.
+ *  @param datalen
+ *      The length of JSON data.
+ *  @param path
+ *      The path.
+ *  @return
+ *      Private traverse object of the root.
+ */
+std::unique_ptr<xap::core::json::TraversePrivate> ParserPrivate::parse(
+    const uint8_t *data,
+    const size_t datalen,
+    const std::string &path
+) {
+    if (this->m_backend != xap::core::json::Backend::jsoncpp) {
+        //  The document keeps its own copy of the input.
+        return this->finish_native(
+            this->m_tape_parser.parse(
+                reinterpret_cast<const char*>(data),
+                datalen,
+                this->m_arena,
+                &(this->m_error)
+            ),
+            path
+        );
+    }
+
+    return this->parse_jsoncpp(
+        reinterpret_cast<const char*>(data),
+        datalen,
+        path
+    );
+}
+
+/**
+ *  Parse a JSON document.
+ *
+ *  @throw xap::core::json::Exception
+ *      Raised if JSON parsing was failed (ERROR_PARAMETER).
+ *  @param json_string
+ *      The JSON string (moved).
+ *  @param path
+ *      The path.
+ *  @return
+ *      Private traverse object of the root.
+ */
+std::unique_ptr<xap::core::json::TraversePrivate> ParserPrivate::parse(
+    std::string &&json_string,
+    const std::string &path
+) {
+    if (this->m_backend != xap::core::json::Backend::jsoncpp) {
+        return this->finish_native(
+            this->m_tape_parser.parse(
+                std::move(json_string),
+                this->m_arena,
+                &(this->m_error)
+            ),
+            path
+        );
+    }
+
+    return this->parse_jsoncpp(
+        json_string.c_str(),
+        json_string.size(),
+        path
+    );
+}
+
+/**
+ *  Parse a JSON file.
+ *
+ *  @throw xap::core::json::Exception
+ *      Raised if the file can't be read or JSON parsing was failed
+ *      (ERROR_PARAMETER).
+ *  @param filename
+ *      The file name.
+ *  @param path
+ *      The path.
+ *  @return
+ *      Private traverse object of the root.
+ */
+std::unique_ptr<xap::core::json::TraversePrivate> ParserPrivate::parse_file(
+    const std::string &filename,
+    const std::string &path
+) {
+    std::shared_ptr<xap::core::json::MappedFile> file = 
+        std::make_shared<xap::core::json::MappedFile>();
+    if (!file->open(filename, &(this->m_error))) {
+        throw xap::core::json::Exception(
+            this->m_error.c_str(),
+            xap::core::json::ERROR_PARAMETER,
+            path.c_str()
+        );
+    }
+
+    //  The file is read sequentially while parsing only.
+    file->advise_sequential();
+    std::unique_ptr<xap::core::json::TraversePrivate> root;
+    if (this->m_backend != xap::core::json::Backend::jsoncpp) {
+        //  The document shares the mapping.
+        root = this->finish_native(
+            this->m_tape_parser.parse(file, this->m_arena, &(this->m_error)),
+            path
+        );
+    } else {
+        root = this->parse_jsoncpp(file->data(), file->size(), path);
+    }
+    file->advise_normal();
+    return root;
+}
+
+/**
+ *  Feed a piece of a JSON document.
+ *
+ *  @param data
+ *      The piece (copied).
+ *  @param datalen
+ *      The length of the piece.
+ *  @return
+ *      False if the document is already known to be invalid.
+ */
+bool ParserPrivate::feed(const char *data, const size_t datalen) {
+    if (this->m_stream_failed) {
+        return false;
+    }
+    this->m_stream.append(data, datalen);
+
+    //  The native backend finds the tokens of the pieces as they arrive.
+    if (
+        this->m_backend != xap::core::json::Backend::jsoncpp &&
+        !this->m_tape_parser.feed_stream(this->m_stream, &(this->m_error))
+    ) {
+        this->m_stream_failed = true;
+        return false;
+    }
+    return true;
+}
+
+/**
+ *  Parse the JSON document that was fed.
+ *
+ *  @throw xap::core::json::Exception
+ *      Raised if JSON parsing was failed (ERROR_PARAMETER).
+ *  @param path
+ *      The path.
+ *  @return
+ *      Private traverse object of the root.
+ */
+std::unique_ptr<xap::core::json::TraversePrivate> ParserPrivate::finish(
+    const std::string &path
+) {
+    //  The parser is ready for the next document afterwards.
+    std::string input;
+    input.swap(this->m_stream);
+    const bool failed = this->m_stream_failed;
+    this->m_stream_failed = false;
+    if (failed) {
+        this->m_tape_parser.reset_stream();
+        throw xap::core::json::Exception(
+            this->m_error.c_str(),
+            xap::core::json::ERROR_PARAMETER,
+            path.c_str()
+        );
+    }
+
+    if (this->m_backend != xap::core::json::Backend::jsoncpp) {
+        //  The document takes over the buffer.
+        return this->finish_native(
+            this->m_tape_parser.finish_stream(
+                std::move(input),
+                this->m_arena,
+                &(this->m_error)
+            ),
+            path
+        );
+    }
+
+    return this->parse_jsoncpp(input.data(), input.size(), path);
+}
+
+/**
+ *  Discard the JSON document that was fed.
+ */
+void ParserPrivate::reset() noexcept {
+    this->m_stream.clear();
+    this->m_stream_failed = false;
+    this->m_tape_parser.reset_stream();
+}
+
+/**
+ *  Reserve memory for the JSON document to be fed.
+ *
+ *  @param size
+ *      The (expected) size of the document.
+ */
+void ParserPrivate::reserve(const size_t size) {
+    this->m_stream.reserve(size);
+}
+
+/**
+ *  Get the size of the JSON document fed so far.
+ *
+ *  @return
+ *      The size.
+ */
+size_t ParserPrivate::get_fed_size() const noexcept {
+    return this->m_stream.size();
+}
+
+/**
+ *  Set the backend.
+ *
+ *  @param backend
+ *      The backend.
+ */
+void ParserPrivate::set_backend(
+    const xap::core::json::Backend backend
+) noexcept {
+    this->m_backend = backend;
+    this->m_tape_parser.set_lazy(backend == xap::core::json::Backend::lazy);
+}
+
+/**
+ *  Get the backend.
+ *
+ *  @return
+ *      The backend.
+ */
+xap::core::json::Backend ParserPrivate::get_backend() const noexcept {
+    return this->m_backend;
+}
+
+/**
+ *  Set the arena of documents parsed afterwards.
+ *
+ *  @param arena
+ *      The arena (nullptr to allocate from the heap).
+ */
+void ParserPrivate::set_arena(
+    const std::shared_ptr<xap::core::json::ArenaPrivate> &arena
+) noexcept {
+    this->m_arena = arena;
+}
+
+/**
+ *  Set the key table of documents parsed afterwards.
+ *
+ *  @param keys
+ *      The key table (nullptr if the keys are not interned).
+ */
+void ParserPrivate::set_key_table(
+    const std::shared_ptr<xap::core::json::KeyTablePrivate> &keys
+) noexcept {
+    this->m_keys = keys;
+}
+
+/**
+ *  Set the count of threads that parse a large document whose root is an
+ *  array.
+ *
+ *  @param workers
+ *      The count of threads (0 for one thread per CPU core).
+ */
+void ParserPrivate::set_workers(const size_t workers) {
+    if (workers == 0U) {
+        this->m_tape_parser.set_workers(std::max<size_t>(
+            std::thread::hardware_concurrency(),
+            1U
+        ));
+    } else {
+        this->m_tape_parser.set_workers(workers);
+    }
+}
+
+/**
+ *  Get the count of threads that parse a large document whose root is an
+ *  array.
+ *
+ *  @return
+ *      The count of threads.
+ */
+size_t ParserPrivate::get_workers() const noexcept {
+    return this->m_tape_parser.get_workers();
+}
+
+/**
+ *  Set whether the input is validated as UTF-8.
+ *
+ *  @param validate
+ *      True if so.
+ */
+void ParserPrivate::set_utf8_validation(const bool validate) noexcept {
+    this->m_tape_parser.set_utf8_validation(validate);
+}
+
+/**
+ *  Get whether the input is validated as UTF-8.
+ *
+ *  @return
+ *      True if so.
+ */
+bool ParserPrivate::get_utf8_validation() const noexcept {
+    return this->m_tape_parser.get_utf8_validation();
+}
+
+//
+//  ParserPrivate private methods.
+//
+
+/**
+ *  Parse a JSON document (with the jsoncpp backend).
+ *
+ *  @throw xap::core::json::Exception
+ *      Raised if JSON parsing was failed (ERROR_PARAMETER).
+ *  @param data
+ *      The JSON data.
+ *  @param datalen
+ *      The length of JSON data.
+ *  @param path
+ *      The path.
+ *  @return
+ *      Private traverse object of the root.
+ */
+std::unique_ptr<xap::core::json::TraversePrivate> ParserPrivate::parse_jsoncpp(
+    const char *data,
+    const size_t datalen,
+    const std::string &path
+) {
+    std::shared_ptr<xap::core::json::ValueDocument> document =
+        xap::core::json::make_document<xap::core::json::ValueDocument>(
+            this->m_arena
+        );
+
+    //  The keys are owned by the Json::Value (the values modified afterwards
+    //  may use interned keys).
+    document->set_key_table(this->m_keys);
+
+    //  Validate the JSON data (jsoncpp copies any byte into strings).
+    size_t error_offset;
+    if (
+        this->m_tape_parser.get_utf8_validation() &&
+        !xap::core::json::Utf8Validator::validate(
+            reinterpret_cast<const uint8_t *>(data),
+            datalen,
+            &error_offset
+        )
+    ) {
+        this->m_error = "* Offset " + std::to_string(error_offset) +
+                        "\n  Syntax error: invalid UTF-8 sequence.\n";
+        throw xap::core::json::Exception(
+            this->m_error.c_str(),
+            xap::core::json::ERROR_PARAMETER,
+            path.c_str()
+        );
+    }
+
+    //  Parse the JSON data.
+    this->m_error.clear();
+    if (!this->m_reader->parse(
+        data,
+        data + datalen,
+        &(document->root()),
+        &(this->m_error)
+    )) {
+        throw xap::core::json::Exception(
+            this->m_error.c_str(),
+            xap::core::json::ERROR_PARAMETER,
+            path.c_str()
+        );
+    }
+
+    return xap::core::json::TraversePrivate::create(
+        xap::core::json::TraversePrivate(
+            document,
+            document->get_root(),
+            xap::core::json::Path(path)
+        )
+    );
+}
+
+/**
+ *  Get the root of a document parsed with the native backend.
+ *
+ *  @throw xap::core::json::Exception
+ *      Raised if JSON parsing was failed (ERROR_PARAMETER).
+ *  @param document
+ *      The document (nullptr if JSON parsing was failed).
+ *  @param path
+ *      The path.
+ *  @return
+ *      Private traverse object of the root.
+ */
+std::unique_ptr<xap::core::json::TraversePrivate>
+ParserPrivate::finish_native(
+    const std::shared_ptr<xap::core::json::TapeDocument> &document,
+    const std::string &path
+) {
+    if (!document) {
+        throw xap::core::json::Exception(
+            this->m_error.c_str(),
+            xap::core::json::ERROR_PARAMETER,
+            path.c_str()
+        );
+    }
+    if (this->m_keys) {
+        document->set_key_table(this->m_keys);
+    }
+
+    return xap::core::json::TraversePrivate::create(
+        xap::core::json::TraversePrivate(
+            document,
+            document->get_root(),
+            xap::core::json::Path(path)
+        )
+    );
+}
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
@@ -0,0 +1,292 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+#ifndef XAP_CORE_JSON_PARSER_P_H__
+#define XAP_CORE_JSON_PARSER_P_H__
+
+//
+//  Imports.
+//
+#include "xap/core/json/build.h"
+#include "xap/core/json/parser.h"
+#include "arena_p.h"
+#include "key_table_p.h"
+#include "document_p.h"
+#include "mapped_file_p.h"
+#include "tape_parser_p.h"
+#include "traverse_p.h"
+
+#include "json/json.h"
+
+#include <memory>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string>
+
+namespace xap {
+namespace core {
+namespace json {
+
+//
+//  Classes.
+//
+
+/**
+ *  Private parser.
+ */
+class ParserPrivate {
+public:
+
+    /**
+     *  Construct the object.
+     *
+     *  @param backend
+     *      The backend.
+     */
+    explicit ParserPrivate(const xap::core::json::Backend backend);
+
+    /**
+     *  Destruct the object.
+     */
+    virtual ~ParserPrivate() noexcept;
+
+    //
+    //  Public methods.
+    //
+
+    /**
+     *  Parse a JSON document.
+     *
+     *  @throw xap::core::json::Exception
+     *      Raised if JSON parsing was failed (ERROR_PARAMETER).
+     *  @param data
+     *      The JSON data.
+     *  @param datalen
+     *      The length of JSON data.
+     *  @param path
+     *      The path.
+     *  @return
+     *      Private traverse object of the root.
+     */
+    std::unique_ptr<xap::core::json::TraversePrivate> parse(
+        const uint8_t *data,
+        const size_t datalen,
+        const std::string &path
+    );
+
+    /**
+     *  Parse a JSON document.
+     *
+     *  @throw xap::core::json::Exception
+     *      Raised if JSON parsing was failed (ERROR_PARAMETER).
+     *  @param json_string
+     *      The JSON string (moved).
+     *  @param path
+     *      The path.
+     *  @return
+     *      Private traverse object of the root.
+     */
+    std::unique_ptr<xap::core::json::TraversePrivate> parse(
+        std::string &&json_string,
+        const std::string &path
+    );
+
+    /**
+     *  Parse a JSON file.
+     *
+     *  @throw xap::core::json::Exception
+     *      Raised if the file can't be read or JSON parsing was failed
+     *      (ERROR_PARAMETER).
+     *  @param filename
+     *      The file name.
+     *  @param path
+     *      The path.
+     *  @return
+     *      Private traverse object of the root.
+     */
+    std::unique_ptr<xap::core::json::TraversePrivate> parse_file(
+        const std::string &filename,
+        const std::string &path
+    );
+
+    /**
+     *  Feed a piece of a JSON document.
+     *
+     *  @param data
+     *      The piece (copied).
+     *  @param datalen
+     *      The length of the piece.
+     *  @return
+     *      False if the document is already known to be invalid.
+     */
+    bool feed(const char *data, const size_t datalen);
+
+    /**
+     *  Parse the JSON document that was fed.
+     *
+     *  @throw xap::core::json::Exception
+     *      Raised if JSON parsing was failed (ERROR_PARAMETER).
+     *  @param path
+     *      The path.
+     *  @return
+     *      Private traverse object of the root.
+     */
+    std::unique_ptr<xap::core::json::TraversePrivate> finish(
+        const std::string &path
+    );
+
+    /**
+     *  Discard the JSON document that was fed.
+     */
+    void reset() noexcept;
+
+    /**
+     *  Reserve memory for the JSON document to be fed.
+     *
+     *  @param size
+     *      The (expected) size of the document.
+     */
+    void reserve(const size_t size);
+
+    /**
+     *  Get the size of the JSON document fed so far.
+     *
+     *  @return
+     *      The size.
+     */
+    size_t get_fed_size() const noexcept;
+
+    /**
+     *  Set the backend.
+     *
+     *  @param backend
+     *      The backend.
+     */
+    void set_backend(const xap::core::json::Backend backend) noexcept;
+
+    /**
+     *  Get the backend.
+     *
+     *  @return
+     *      The backend.
+     */
+    xap::core::json::Backend get_backend() const noexcept;
+
+    /**
+     *  Set the arena of documents parsed afterwards.
+     *
+     *  @param arena
+     *      The arena (nullptr to allocate from the heap).
+     */
+    void set_arena(
+        const std::shared_ptr<xap::core::json::ArenaPrivate> &arena
+    ) noexcept;
+
+    /**
+     *  Set the key table of documents parsed afterwards.
+     *
+     *  @param keys
+     *      The key table (nullptr if the keys are not interned).
+     */
+    void set_key_table(
+        const std::shared_ptr<xap::core::json::KeyTablePrivate> &keys
+    ) noexcept;
+
+    /**
+     *  Set the count of threads that parse a large document whose root is an
+     *  array.
+     *
+     *  @param workers
+     *      The count of threads (0 for one thread per CPU core).
+     */
+    void set_workers(const size_t workers);
+
+    /**
+     *  Get the count of threads that parse a large document whose root is an
+     *  array.
+     *
+     *  @return
+     *      The count of threads.
+     */
+    size_t get_workers() const noexcept;
+
+    /**
+     *  Set whether the input is validated as UTF-8.
+     *
+     *  @param validate
+     *      True if so.
+     */
+    void set_utf8_validation(const bool validate) noexcept;
+
+    /**
+     *  Get whether the input is validated as UTF-8.
+     *
+     *  @return
+     *      True if so.
+     */
+    bool get_utf8_validation() const noexcept;
+
+private:
+
+    //
+    //  Private methods.
+    //
+
+    /**
+     *  Parse a JSON document (with the jsoncpp backend).
+     *
+     *  @throw xap::core::json::Exception
+     *      Raised if JSON parsing was failed (ERROR_PARAMETER).
+     *  @param data
+     *      The JSON data.
+     *  @param datalen
+     *      The length of JSON data.
+     *  @param path
+     *      The path.
+     *  @return
+     *      Private traverse object of the root.
+     */
+    std::unique_ptr<xap::core::json::TraversePrivate> parse_jsoncpp(
+        const char *data,
+        const size_t datalen,
+        const std::string &path
+    );
+
+    /**
+     *  Get the root of a document parsed with the native backend.
+     *
+     *  @throw xap::core::json::Exception
+     *      Raised if JSON parsing was failed (ERROR_PARAMETER).
+     *  @param document
+     *      The document (nullptr if JSON parsing was failed).
+     *  @param path
+     *      The path.
+     *  @return
+     *      Private traverse object of the root.
+     */
+    std::unique_ptr<xap::core::json::TraversePrivate> finish_native(
+        const std::shared_ptr<xap::core::json::TapeDocument> &document,
+        const std::string &path
+    );
+
+    //
+    //  Private members.
+    //
+    xap::core::json::Backend m_backend;
+    std::unique_ptr<Json::CharReader> m_reader;
+    Json::String m_error;
+    xap::core::json::TapeParser m_tape_parser;
+    std::shared_ptr<xap::core::json::ArenaPrivate> m_arena;
+    std::shared_ptr<xap::core::json::KeyTablePrivate> m_keys;
+    std::string m_stream;
+    bool m_stream_failed;
+};
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
+
+#endif  //  #ifndef XAP_CORE_JSON_PARSER_P_H__
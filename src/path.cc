@@ -0,0 +1,404 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+//
+//  Imports.
+//
+#include "path_p.h"
+#include "arena_p.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace xap {
+namespace core {
+namespace json {
+
+//
+//  PathNode constructor.
+//
+
+/**
+ *  Construct the object (as a root).
+ *
+ *  @param prefix
+ *      The path of the root (used verbatim).
+ */
+PathNode::PathNode(const std::string &prefix) :
+    m_parent(),
+    m_owner(),
+    m_storage(prefix),
+    m_name(nullptr),
+    m_name_length(0U),
+    m_index(0U),
+    m_is_index(false),
+    m_is_stable(true)
+{}
+
+/**
+ *  Construct the object (as a key segment, with a copy of the name).
+ *
+ *  @param parent
+ *      The parent.
+ *  @param name
+ *      The name (key).
+ */
+PathNode::PathNode(
+    const std::shared_ptr<const xap::core::json::PathNode> &parent,
+    const std::string &name
+) :
+    m_parent(parent),
+    m_owner(),
+    m_storage(name),
+    m_name(nullptr),
+    m_name_length(0U),
+    m_index(0U),
+    m_is_index(false),
+    m_is_stable(parent->is_stable())
+{}
+
+/**
+ *  Construct the object (as a key segment that borrows the name).
+ *
+ *  @param parent
+ *      The parent.
+ *  @param name
+ *      The name (key).
+ *  @param name_len
+ *      The length of the name.
+ *  @param owner
+ *      The owner of the name (nullptr if the name belongs to the document).
+ */
+PathNode::PathNode(
+    const std::shared_ptr<const xap::core::json::PathNode> &parent,
+    const char *name,
+    const size_t name_len,
+    const std::shared_ptr<const void> &owner
+) :
+    m_parent(parent),
+    m_owner(owner),
+    m_storage(),
+    m_name(name),
+    m_name_length(name_len),
+    m_index(0U),
+    m_is_index(false),
+    m_is_stable(owner && parent->is_stable())
+{}
+
+/**
+ *  Construct the object (as an index segment).
+ *
+ *  @param parent
+ *      The parent.
+ *  @param index
+ *      The index.
+ */
+PathNode::PathNode(
+    const std::shared_ptr<const xap::core::json::PathNode> &parent,
+    const size_t index
+) :
+    m_parent(parent),
+    m_owner(),
+    m_storage(),
+    m_name(nullptr),
+    m_name_length(0U),
+    m_index(index),
+    m_is_index(true),
+    m_is_stable(parent->is_stable())
+{}
+
+//
+//  PathNode public methods.
+//
+
+/**
+ *  Render the path into a string.
+ *
+ *  @param out
+ *      The string to be appended.
+ */
+void PathNode::render(std::string &out) const {
+    if (!this->m_parent) {
+        out.append(this->m_storage);
+        return;
+    }
+
+    this->m_parent->render(out);
+    if (out.size() != 0U && *(out.end() - 1U) != '/') {
+        out.push_back('/');
+    }
+    if (this->m_is_index) {
+        out.append(std::to_string(this->m_index));
+    } else if (this->m_name) {
+        out.append(this->m_name, this->m_name_length);
+    } else {
+        out.append(this->m_storage);
+    }
+}
+
+/**
+ *  Get whether the node is stable (neither it nor its ancestors borrow a
+ *  name from a document).
+ *
+ *  @return
+ *      True if so.
+ */
+bool PathNode::is_stable() const noexcept {
+    return this->m_is_stable;
+}
+
+/**
+ *  Get the parent.
+ *
+ *  @return
+ *      The parent (nullptr if the node is a root).
+ */
+const std::shared_ptr<const xap::core::json::PathNode> &
+PathNode::get_parent() const noexcept {
+    return this->m_parent;
+}
+
+/**
+ *  Get a copy of the node that owns its name.
+ *
+ *  @param parent
+ *      The parent of the copy.
+ *  @return
+ *      The copy.
+ */
+xap::core::json::PathNode PathNode::own(
+    const std::shared_ptr<const xap::core::json::PathNode> &parent
+) const {
+    if (this->m_is_index) {
+        return xap::core::json::PathNode(parent, this->m_index);
+    }
+    if (this->m_name) {
+        return xap::core::json::PathNode(
+            parent,
+            std::string(this->m_name, this->m_name_length)
+        );
+    }
+    return xap::core::json::PathNode(parent, this->m_storage);
+}
+
+//
+//  Path constructor.
+//
+
+/**
+ *  Construct the object (as a root).
+ *
+ *  @param prefix
+ *      The path of the root (used verbatim).
+ */
+Path::Path(const std::string &prefix) :
+    m_node(prefix),
+    m_shared_node()
+{}
+
+/**
+ *  Construct the object.
+ *
+ *  @param node
+ *      The node (moved).
+ */
+Path::Path(xap::core::json::PathNode &&node) :
+    m_node(std::move(node)),
+    m_shared_node()
+{}
+
+//
+//  Path public methods.
+//
+
+/**
+ *  Get the path of a sub directory (with a copy of its name).
+ *
+ *  @param name
+ *      The name (key) of the sub directory.
+ *  @param arena
+ *      The arena to allocate the shared node from (nullptr to allocate from
+ *      the heap).
+ *  @return
+ *      The path.
+ */
+xap::core::json::Path Path::child(
+    const std::string &name,
+    const std::shared_ptr<xap::core::json::ArenaPrivate> &arena
+) {
+    return xap::core::json::Path(
+        xap::core::json::PathNode(this->shared_node(arena), name)
+    );
+}
+
+/**
+ *  Get the path of a sub directory (that borrows its name).
+ *
+ *  @param name
+ *      The name (key) of the sub directory.
+ *  @param name_len
+ *      The length of the name.
+ *  @param owner
+ *      The owner of the name (nullptr if the name belongs to the document).
+ *  @param arena
+ *      The arena to allocate the shared node from (nullptr to allocate from
+ *      the heap).
+ *  @return
+ *      The path.
+ */
+xap::core::json::Path Path::child(
+    const char *name,
+    const size_t name_len,
+    const std::shared_ptr<const void> &owner,
+    const std::shared_ptr<xap::core::json::ArenaPrivate> &arena
+) {
+    return xap::core::json::Path(
+        xap::core::json::PathNode(
+            this->shared_node(arena),
+            name,
+            name_len,
+            owner
+        )
+    );
+}
+
+/**
+ *  Get the path of a sub directory.
+ *
+ *  @param index
+ *      The index of the sub directory.
+ *  @param arena
+ *      The arena to allocate the shared node from (nullptr to allocate from
+ *      the heap).
+ *  @return
+ *      The path.
+ */
+xap::core::json::Path Path::child(
+    const size_t index,
+    const std::shared_ptr<xap::core::json::ArenaPrivate> &arena
+) {
+    return xap::core::json::Path(
+        xap::core::json::PathNode(this->shared_node(arena), index)
+    );
+}
+
+/**
+ *  Copy the names that the path borrows from its document, so that the path
+ *  can outlive the document (or be used with another one).
+ *
+ *  @param arena
+ *      The arena to allocate the copied nodes from (nullptr to allocate from
+ *      the heap).
+ */
+void Path::own_names(
+    const std::shared_ptr<xap::core::json::ArenaPrivate> &arena
+) {
+    const xap::core::json::PathNode &node = this->get_node();
+    if (node.is_stable()) {
+        return;
+    }
+    xap::core::json::PathNode owned = Path::own_node(node, arena);
+    this->m_node = std::move(owned);
+    this->m_shared_node.reset();
+}
+
+/**
+ *  Render the path into a string.
+ *
+ *  @return
+ *      The path string.
+ */
+std::string Path::to_string() const {
+    std::string out;
+    this->get_node().render(out);
+    return out;
+}
+
+/**
+ *  Render the path into a string.
+ *
+ *  @param out
+ *      The string to be appended.
+ */
+void Path::render(std::string &out) const {
+    this->get_node().render(out);
+}
+
+//
+//  Path private methods.
+//
+
+/**
+ *  Get the node of this path.
+ *
+ *  @return
+ *      The node.
+ */
+const xap::core::json::PathNode &Path::get_node() const noexcept {
+    return this->m_shared_node ? *(this->m_shared_node) : this->m_node;
+}
+
+/**
+ *  Get the (shared) node of this path, allocating it if needed.
+ *
+ *  @note
+ *      The node is moved into the shared allocation, so the name is never
+ *      copied.
+ *  @param arena
+ *      The arena to allocate the node from (nullptr to allocate from the
+ *      heap).
+ *  @return
+ *      The node.
+ */
+const std::shared_ptr<const xap::core::json::PathNode> &
+Path::shared_node(
+    const std::shared_ptr<xap::core::json::ArenaPrivate> &arena
+) {
+    if (!this->m_shared_node) {
+        this->m_shared_node = std::allocate_shared<
+            const xap::core::json::PathNode
+        >(
+            xap::core::json::ArenaAllocator<xap::core::json::PathNode>(arena),
+            std::move(this->m_node)
+        );
+    }
+    return this->m_shared_node;
+}
+
+//
+//  Path private static functions.
+//
+
+/**
+ *  Get a copy of a node that is stable.
+ *
+ *  @param node
+ *      The node.
+ *  @param arena
+ *      The arena to allocate the copied ancestors from (nullptr to allocate
+ *      from the heap).
+ *  @return
+ *      The copy.
+ */
+xap::core::json::PathNode Path::own_node(
+    const xap::core::json::PathNode &node,
+    const std::shared_ptr<xap::core::json::ArenaPrivate> &arena
+) {
+    std::shared_ptr<const xap::core::json::PathNode> parent =
+        node.get_parent();
+    if (parent && !parent->is_stable()) {
+        parent = std::allocate_shared<const xap::core::json::PathNode>(
+            xap::core::json::ArenaAllocator<xap::core::json::PathNode>(arena),
+            Path::own_node(*parent, arena)
+        );
+    }
+    return node.own(parent);
+}
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
@@ -0,0 +1,335 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+#ifndef XAP_CORE_JSON_PATH_P_H__
+#define XAP_CORE_JSON_PATH_P_H__
+
+//
+//  Imports.
+//
+#include "arena_p.h"
+
+#include <memory>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string>
+
+namespace xap {
+namespace core {
+namespace json {
+
+//
+//  Classes.
+//
+
+/**
+ *  Path node (one segment of a path and a link to its parent).
+ *
+ *  @note
+ *      The name of a key segment is either copied into the node, or borrowed
+ *      (referred to without copying). A borrowed name is kept alive by the
+ *      owner given with it, or, without owner, belongs to the document that
+ *      the path walks (the keys of a document stay as long as the document).
+ *      A node is stable if neither it nor its ancestors borrow a name from a
+ *      document.
+ */
+class PathNode {
+public:
+
+    /**
+     *  Construct the object (as a root).
+     *
+     *  @param prefix
+     *      The path of the root (used verbatim).
+     */
+    explicit PathNode(const std::string &prefix);
+
+    /**
+     *  Construct the object (as a key segment, with a copy of the name).
+     *
+     *  @param parent
+     *      The parent.
+     *  @param name
+     *      The name (key).
+     */
+    PathNode(
+        const std::shared_ptr<const xap::core::json::PathNode> &parent,
+        const std::string &name
+    );
+
+    /**
+     *  Construct the object (as a key segment that borrows the name).
+     *
+     *  @param parent
+     *      The parent.
+     *  @param name
+     *      The name (key).
+     *  @param name_len
+     *      The length of the name.
+     *  @param owner
+     *      The owner of the name (nullptr if the name belongs to the
+     *      document).
+     */
+    PathNode(
+        const std::shared_ptr<const xap::core::json::PathNode> &parent,
+        const char *name,
+        const size_t name_len,
+        const std::shared_ptr<const void> &owner
+    );
+
+    /**
+     *  Construct the object (as an index segment).
+     *
+     *  @param parent
+     *      The parent.
+     *  @param index
+     *      The index.
+     */
+    PathNode(
+        const std::shared_ptr<const xap::core::json::PathNode> &parent,
+        const size_t index
+    );
+
+    //
+    //  Public methods.
+    //
+
+    /**
+     *  Render the path into a string.
+     *
+     *  @param out
+     *      The string to be appended.
+     */
+    void render(std::string &out) const;
+
+    /**
+     *  Get whether the node is stable (neither it nor its ancestors borrow a
+     *  name from a document).
+     *
+     *  @return
+     *      True if so.
+     */
+    bool is_stable() const noexcept;
+
+    /**
+     *  Get the parent.
+     *
+     *  @return
+     *      The parent (nullptr if the node is a root).
+     */
+    const std::shared_ptr<const xap::core::json::PathNode> &
+    get_parent() const noexcept;
+
+    /**
+     *  Get a copy of the node that owns its name.
+     *
+     *  @param parent
+     *      The parent of the copy.
+     *  @return
+     *      The copy.
+     */
+    xap::core::json::PathNode own(
+        const std::shared_ptr<const xap::core::json::PathNode> &parent
+    ) const;
+
+private:
+
+    //
+    //  Private members.
+    //
+    std::shared_ptr<const xap::core::json::PathNode> m_parent;
+    std::shared_ptr<const void> m_owner;
+    std::string m_storage;
+    const char *m_name;
+    size_t m_name_length;
+    size_t m_index;
+    bool m_is_index;
+    bool m_is_stable;
+};
+
+/**
+ *  Path.
+ *
+ *  @note
+ *      The path is kept as a chain of segments linked to their parents and is
+ *      only rendered to a string on demand (mostly when an error is raised).
+ *      Creating a child path creates its segment only, and a key that the
+ *      document keeps is borrowed instead of copied. The node of the parent
+ *      is moved into a shared allocation the first time a child is created
+ *      from it and is shared by all its children afterwards.
+ *
+ *      A path that borrows names from a document must only be used with the
+ *      document, see own_names().
+ */
+class Path {
+public:
+
+    /**
+     *  Construct the object (as a root).
+     *
+     *  @param prefix
+     *      The path of the root (used verbatim).
+     */
+    explicit Path(const std::string &prefix = "/");
+
+    //
+    //  Public methods.
+    //
+
+    /**
+     *  Get the path of a sub directory (with a copy of its name).
+     *
+     *  @param name
+     *      The name (key) of the sub directory.
+     *  @param arena
+     *      The arena to allocate the shared node from (nullptr to allocate
+     *      from the heap).
+     *  @return
+     *      The path.
+     */
+    xap::core::json::Path child(
+        const std::string &name,
+        const std::shared_ptr<xap::core::json::ArenaPrivate> &arena
+    );
+
+    /**
+     *  Get the path of a sub directory (that borrows its name).
+     *
+     *  @param name
+     *      The name (key) of the sub directory.
+     *  @param name_len
+     *      The length of the name.
+     *  @param owner
+     *      The owner of the name (nullptr if the name belongs to the
+     *      document).
+     *  @param arena
+     *      The arena to allocate the shared node from (nullptr to allocate
+     *      from the heap).
+     *  @return
+     *      The path.
+     */
+    xap::core::json::Path child(
+        const char *name,
+        const size_t name_len,
+        const std::shared_ptr<const void> &owner,
+        const std::shared_ptr<xap::core::json::ArenaPrivate> &arena
+    );
+
+    /**
+     *  Get the path of a sub directory.
+     *
+     *  @param index
+     *      The index of the sub directory.
+     *  @param arena
+     *      The arena to allocate the shared node from (nullptr to allocate
+     *      from the heap).
+     *  @return
+     *      The path.
+     */
+    xap::core::json::Path child(
+        const size_t index,
+        const std::shared_ptr<xap::core::json::ArenaPrivate> &arena
+    );
+
+    /**
+     *  Copy the names that the path borrows from its document, so that the
+     *  path can outlive the document (or be used with another one).
+     *
+     *  @param arena
+     *      The arena to allocate the copied nodes from (nullptr to allocate
+     *      from the heap).
+     */
+    void own_names(
+        const std::shared_ptr<xap::core::json::ArenaPrivate> &arena
+    );
+
+    /**
+     *  Render the path into a string.
+     *
+     *  @return
+     *      The path string.
+     */
+    std::string to_string() const;
+
+    /**
+     *  Render the path into a string.
+     *
+     *  @param out
+     *      The string to be appended.
+     */
+    void render(std::string &out) const;
+
+private:
+
+    //
+    //  Private constructor.
+    //
+
+    /**
+     *  Construct the object.
+     *
+     *  @param node
+     *      The node (moved).
+     */
+    explicit Path(xap::core::json::PathNode &&node);
+
+    //
+    //  Private methods.
+    //
+
+    /**
+     *  Get the node of this path.
+     *
+     *  @return
+     *      The node.
+     */
+    const xap::core::json::PathNode &get_node() const noexcept;
+
+    /**
+     *  Get the (shared) node of this path, allocating it if needed.
+     *
+     *  @param arena
+     *      The arena to allocate the node from (nullptr to allocate from the
+     *      heap).
+     *  @return
+     *      The node.
+     */
+    const std::shared_ptr<const xap::core::json::PathNode> &shared_node(
+        const std::shared_ptr<xap::core::json::ArenaPrivate> &arena
+    );
+
+    //
+    //  Private static functions.
+    //
+
+    /**
+     *  Get a copy of a node that is stable.
+     *
+     *  @param node
+     *      The node.
+     *  @param arena
+     *      The arena to allocate the copied ancestors from (nullptr to
+     *      allocate from the heap).
+     *  @return
+     *      The copy.
+     */
+    static xap::core::json::PathNode own_node(
+        const xap::core::json::PathNode &node,
+        const std::shared_ptr<xap::core::json::ArenaPrivate> &arena
+    );
+
+    //
+    //  Private members.
+    //
+    xap::core::json::PathNode m_node;
+    std::shared_ptr<const xap::core::json::PathNode> m_shared_node;
+};
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
+
+#endif  //  #ifndef XAP_CORE_JSON_PATH_P_H__
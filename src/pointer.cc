@@ -0,0 +1,251 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+//
+//  Imports.
+//
+#include "xap/core/json/pointer.h"
+#include "pointer_p.h"
+#include "document_p.h"
+#include "xap/core/json/error.h"
+
+#include <memory>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace xap {
+namespace core {
+namespace json {
+
+//
+//  Private functions.
+//
+
+/**
+ *  Parse an array index (RFC 6901: "0" or digits without leading zeros).
+ *
+ *  @param key
+ *      The key.
+ *  @param index
+ *      The pointer to receive the index.
+ *  @return
+ *      True if the key is a valid array index.
+ */
+static bool parse_index(const std::string &key, size_t *index) noexcept {
+    if (key.empty() || (key[0] == '0' && key.size() != 1U)) {
+        return false;
+    }
+    size_t value = 0U;
+    for (const char ch : key) {
+        if (ch < '0' || ch > '9') {
+            return false;
+        }
+        const size_t digit = static_cast<size_t>(ch - '0');
+        if (value > (static_cast<size_t>(-1) - digit) / 10U) {
+            return false;
+        }
+        value = value * 10U + digit;
+    }
+    *index = value;
+    return true;
+}
+
+//
+//  Pointer constructor & destructor.
+//
+
+/**
+ *  Construct the object.
+ *
+ *  @throw xap::core::json::Exception
+ *      Raised if the pointer is invalid (ERROR_PARAMETER).
+ *  @param pointer
+ *      The pointer (e.g. "/request/audio/codec", "" refers to the whole
+ *      document).
+ */
+Pointer::Pointer(const std::string &pointer) :
+    m_pointer(std::make_shared<const xap::core::json::PointerPrivate>(pointer))
+{}
+
+/**
+ *  Construct (Copy) the object.
+ *
+ *  @param src
+ *      The source.
+ */
+Pointer::Pointer(const Pointer &src) :
+    m_pointer(src.m_pointer)
+{}
+
+/**
+ *  Destruct the object.
+ */
+Pointer::~Pointer() noexcept {
+    //  Do nothing.
+}
+
+//
+//  Pointer operators.
+//
+
+/**
+ *  Assign (Copy) the object.
+ *
+ *  @param src
+ *      The source.
+ *  @return
+ *      Self.
+ */
+xap::core::json::Pointer &Pointer::operator=(const Pointer &src) {
+    this->m_pointer = src.m_pointer;
+    return *this;
+}
+
+//
+//  Pointer public methods.
+//
+
+/**
+ *  Get the pointer string.
+ *
+ *  @return
+ *      The pointer string.
+ */
+const std::string &Pointer::to_string() const noexcept {
+    return this->m_pointer->get_pointer();
+}
+
+/**
+ *  Get the count of segments.
+ *
+ *  @return
+ *      The count.
+ */
+size_t Pointer::get_segment_count() const noexcept {
+    return this->m_pointer->get_segments().size();
+}
+
+//
+//  PointerPrivate constructor & destructor.
+//
+
+/**
+ *  Construct the object.
+ *
+ *  @throw xap::core::json::Exception
+ *      Raised if the pointer is invalid (ERROR_PARAMETER).
+ *  @param pointer
+ *      The pointer.
+ */
+PointerPrivate::PointerPrivate(const std::string &pointer) :
+    m_pointer(pointer),
+    m_segments(),
+    m_path()
+{
+    if (pointer.empty()) {
+        return;
+    }
+    if (pointer[0] != '/') {
+        throw xap::core::json::Exception(
+            "JSON pointer must start with '/'.",
+            xap::core::json::ERROR_PARAMETER,
+            pointer.c_str()
+        );
+    }
+
+    size_t cursor = 1U;
+    while (true) {
+        //  Unescape the segment.
+        xap::core::json::PointerSegment segment;
+        while (cursor < pointer.size() && pointer[cursor] != '/') {
+            const char ch = pointer[cursor++];
+            if (ch != '~') {
+                segment.key.push_back(ch);
+                continue;
+            }
+            if (cursor < pointer.size() && pointer[cursor] == '0') {
+                segment.key.push_back('~');
+            } else if (cursor < pointer.size() && pointer[cursor] == '1') {
+                segment.key.push_back('/');
+            } else {
+                throw xap::core::json::Exception(
+                    "Invalid escape sequence in JSON pointer.",
+                    xap::core::json::ERROR_PARAMETER,
+                    pointer.c_str()
+                );
+            }
+            ++cursor;
+        }
+
+        segment.key_hash = xap::core::json::Document::hash_key(
+            segment.key.data(),
+            segment.key.size()
+        );
+        segment.index = 0U;
+        segment.is_index = parse_index(segment.key, &(segment.index));
+        if (!this->m_segments.empty()) {
+            this->m_path.push_back('/');
+        }
+        this->m_path.append(segment.key);
+        segment.path_end = this->m_path.size();
+        this->m_segments.push_back(std::move(segment));
+
+        if (cursor == pointer.size()) {
+            break;
+        }
+        ++cursor;
+    }
+}
+
+/**
+ *  Destruct the object.
+ */
+PointerPrivate::~PointerPrivate() noexcept {
+    //  Do nothing.
+}
+
+//
+//  PointerPrivate public methods.
+//
+
+/**
+ *  Get the pointer string.
+ *
+ *  @return
+ *      The pointer string.
+ */
+const std::string &PointerPrivate::get_pointer() const noexcept {
+    return this->m_pointer;
+}
+
+/**
+ *  Get the segments.
+ *
+ *  @return
+ *      The segments.
+ */
+const std::vector<xap::core::json::PointerSegment> &
+PointerPrivate::get_segments() const noexcept {
+    return this->m_segments;
+}
+
+/**
+ *  Get the path that the pointer refers to (relative to where it is
+ *  evaluated, in the format of traverse paths).
+ *
+ *  @return
+ *      The path (unescaped segments separated by '/').
+ */
+const std::string &PointerPrivate::get_path() const noexcept {
+    return this->m_path;
+}
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
@@ -0,0 +1,122 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+#ifndef XAP_CORE_JSON_POINTER_P_H__
+#define XAP_CORE_JSON_POINTER_P_H__
+
+//
+//  Imports.
+//
+#include "xap/core/json/build.h"
+#include "xap/core/json/pointer.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+namespace xap {
+namespace core {
+namespace json {
+
+//
+//  Structures.
+//
+
+/**
+ *  Segment of a compiled pointer.
+ */
+struct PointerSegment {
+    //  Key (unescaped).
+    std::string key;
+
+    //  Hash of the key (see Document::hash_key()).
+    uint64_t key_hash;
+
+    //  Array index (only if the key is a valid array index).
+    size_t index;
+    bool is_index;
+
+    //  End of the segment within the rendered path.
+    size_t path_end;
+};
+
+//
+//  Classes.
+//
+
+/**
+ *  Private pointer.
+ */
+class PointerPrivate {
+public:
+
+    /**
+     *  Construct the object.
+     *
+     *  @throw xap::core::json::Exception
+     *      Raised if the pointer is invalid (ERROR_PARAMETER).
+     *  @param pointer
+     *      The pointer.
+     */
+    explicit PointerPrivate(const std::string &pointer);
+
+    /**
+     *  Destruct the object.
+     */
+    virtual ~PointerPrivate() noexcept;
+
+    //
+    //  Public methods.
+    //
+
+    /**
+     *  Get the pointer string.
+     *
+     *  @return
+     *      The pointer string.
+     */
+    const std::string &get_pointer() const noexcept;
+
+    /**
+     *  Get the segments.
+     *
+     *  @return
+     *      The segments.
+     */
+    const std::vector<xap::core::json::PointerSegment> &
+    get_segments() const noexcept;
+
+    /**
+     *  Get the path that the pointer refers to (relative to where it is
+     *  evaluated, in the format of traverse paths).
+     *
+     *  @return
+     *      The path (unescaped segments separated by '/').
+     */
+    const std::string &get_path() const noexcept;
+
+private:
+
+    //
+    //  Private members.
+    //
+    std::string m_pointer;
+    std::vector<xap::core::json::PointerSegment> m_segments;
+    std::string m_path;
+
+    //
+    //  Private constructor.
+    //
+    PointerPrivate(const PointerPrivate &) = delete;
+    PointerPrivate &operator=(const PointerPrivate &) = delete;
+};
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
+
+#endif  //  #ifndef XAP_CORE_JSON_POINTER_P_H__
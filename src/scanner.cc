@@ -0,0 +1,881 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+//
+//  Imports.
+//
+#include "scanner_p.h"
+
+#include <algorithm>
+#include <memory>
+#include <stddef.h>
+#include <string.h>
+#include <utility>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+# define XAPCORE_JSON_SCANNER_X86
+# include <immintrin.h>
+#endif  //  #if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+
+namespace xap {
+namespace core {
+namespace json {
+
+//
+//  Constants.
+//
+
+//  Count of blocks classified by one kernel call.
+static const size_t SCANNER_BATCH_BLOCKS = 64U;
+
+//
+//  Private functions.
+//
+
+/**
+ *  Count the trailing zero bits.
+ *
+ *  @param value
+ *      The value (must not be zero).
+ *  @return
+ *      The count.
+ */
+static inline uint32_t trailing_zeros(const uint64_t value) noexcept {
+#if defined(__GNUC__)
+    return static_cast<uint32_t>(__builtin_ctzll(value));
+#else
+    uint32_t count = 0U;
+    while (((value >> count) & 1U) == 0U) {
+        ++count;
+    }
+    return count;
+#endif
+}
+
+/**
+ *  Compute the prefix XOR of the bits (bit i of the result is the XOR of
+ *  bit 0 to bit i of the value).
+ *
+ *  @param value
+ *      The value.
+ *  @return
+ *      The prefix XOR.
+ */
+static inline uint64_t prefix_xor(uint64_t value) noexcept {
+    value ^= value << 1U;
+    value ^= value << 2U;
+    value ^= value << 4U;
+    value ^= value << 8U;
+    value ^= value << 16U;
+    value ^= value << 32U;
+    return value;
+}
+
+/**
+ *  Find the escaped characters of a block.
+ *
+ *  @note
+ *      A character is escaped if it follows an odd-length run of
+ *      backslashes. Runs are found with an addition (the carry propagates
+ *      through a run), so no loop over the bits is needed.
+ *  @param backslash
+ *      The backslashes of the block.
+ *  @param prev_escaped
+ *      Whether the first character of the block is escaped (updated for the
+ *      next block).
+ *  @return
+ *      The escaped characters.
+ */
+static inline uint64_t find_escaped(
+    uint64_t backslash,
+    uint64_t *prev_escaped
+) noexcept {
+    const uint64_t even_bits = UINT64_C(0x5555555555555555);
+
+    //  An escaped backslash doesn't start an escape sequence.
+    backslash &= ~(*prev_escaped);
+    const uint64_t follows_escape = (backslash << 1U) | *prev_escaped;
+
+    //  Runs starting on odd bits.
+    const uint64_t odd_starts = backslash & ~even_bits & ~follows_escape;
+    const uint64_t even_runs = odd_starts + backslash;
+    *prev_escaped = (even_runs < odd_starts ? 1U : 0U);
+
+    const uint64_t invert_mask = even_runs << 1U;
+    return (even_bits ^ invert_mask) & follows_escape;
+}
+
+/**
+ *  Classify blocks (scalar).
+ *
+ *  @param data
+ *      The data (block_count * 64 bytes).
+ *  @param block_count
+ *      The count of blocks.
+ *  @param blocks
+ *      The classified blocks.
+ */
+static void classify_scalar(
+    const uint8_t *data,
+    const size_t block_count,
+    xap::core::json::ScannerBlock *blocks
+) {
+    for (size_t i = 0U; i < block_count; ++i) {
+        xap::core::json::ScannerBlock &block = blocks[i];
+        block.whitespace = 0U;
+        block.operators = 0U;
+        block.quote = 0U;
+        block.backslash = 0U;
+        block.control = 0U;
+        for (size_t j = 0U; j < 64U; ++j) {
+            const uint8_t ch = data[j];
+            const uint64_t bit = UINT64_C(1) << j;
+            switch (ch) {
+                case ' ':
+                case '\t':
+                case '\n':
+                case '\r':
+                    block.whitespace |= bit;
+                    break;
+                case '{':
+                case '}':
+                case '[':
+                case ']':
+                case ':':
+                case ',':
+                    block.operators |= bit;
+                    break;
+                case '"':
+                    block.quote |= bit;
+                    break;
+                case '\\':
+                    block.backslash |= bit;
+                    break;
+                default:
+                    break;
+            }
+            if (ch < 0x20U) {
+                block.control |= bit;
+            }
+        }
+        data += 64U;
+    }
+}
+
+#if defined(XAPCORE_JSON_SCANNER_X86)
+
+/**
+ *  Classify blocks (SSE4.2).
+ *
+ *  @param data
+ *      The data (block_count * 64 bytes).
+ *  @param block_count
+ *      The count of blocks.
+ *  @param blocks
+ *      The classified blocks.
+ */
+__attribute__((target("sse4.2")))
+static void classify_sse42(
+    const uint8_t *data,
+    const size_t block_count,
+    xap::core::json::ScannerBlock *blocks
+) {
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i line_feed = _mm_set1_epi8('\n');
+    const __m128i carriage_return = _mm_set1_epi8('\r');
+    const __m128i lower_case = _mm_set1_epi8(0x20);
+    const __m128i left_brace = _mm_set1_epi8('{');
+    const __m128i right_brace = _mm_set1_epi8('}');
+    const __m128i colon = _mm_set1_epi8(':');
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i control_max = _mm_set1_epi8(0x1F);
+
+    for (size_t i = 0U; i < block_count; ++i) {
+        xap::core::json::ScannerBlock &block = blocks[i];
+        block.whitespace = 0U;
+        block.operators = 0U;
+        block.quote = 0U;
+        block.backslash = 0U;
+        block.control = 0U;
+        for (size_t j = 0U; j < 4U; ++j) {
+            const __m128i chunk = _mm_loadu_si128(
+                reinterpret_cast<const __m128i *>(data + j * 16U)
+            );
+            const uint32_t shift = static_cast<uint32_t>(j * 16U);
+
+            //  Whitespaces.
+            const __m128i whitespace = _mm_or_si128(
+                _mm_or_si128(
+                    _mm_cmpeq_epi8(chunk, space),
+                    _mm_cmpeq_epi8(chunk, tab)
+                ),
+                _mm_or_si128(
+                    _mm_cmpeq_epi8(chunk, line_feed),
+                    _mm_cmpeq_epi8(chunk, carriage_return)
+                )
+            );
+
+            //  Operators ('[' | 0x20 == '{', ']' | 0x20 == '}').
+            const __m128i folded = _mm_or_si128(chunk, lower_case);
+            const __m128i operators = _mm_or_si128(
+                _mm_or_si128(
+                    _mm_cmpeq_epi8(folded, left_brace),
+                    _mm_cmpeq_epi8(folded, right_brace)
+                ),
+                _mm_or_si128(
+                    _mm_cmpeq_epi8(chunk, colon),
+                    _mm_cmpeq_epi8(chunk, comma)
+                )
+            );
+
+            //  Control characters (unsigned <= 0x1F).
+            const __m128i control = _mm_cmpeq_epi8(
+                _mm_min_epu8(chunk, control_max),
+                chunk
+            );
+
+            block.whitespace |= static_cast<uint64_t>(
+                static_cast<uint16_t>(_mm_movemask_epi8(whitespace))
+            ) << shift;
+            block.operators |= static_cast<uint64_t>(
+                static_cast<uint16_t>(_mm_movemask_epi8(operators))
+            ) << shift;
+            block.quote |= static_cast<uint64_t>(
+                static_cast<uint16_t>(_mm_movemask_epi8(
+                    _mm_cmpeq_epi8(chunk, quote)
+                ))
+            ) << shift;
+            block.backslash |= static_cast<uint64_t>(
+                static_cast<uint16_t>(_mm_movemask_epi8(
+                    _mm_cmpeq_epi8(chunk, backslash)
+                ))
+            ) << shift;
+            block.control |= static_cast<uint64_t>(
+                static_cast<uint16_t>(_mm_movemask_epi8(control))
+            ) << shift;
+        }
+        data += 64U;
+    }
+}
+
+/**
+ *  Classify blocks (AVX2).
+ *
+ *  @param data
+ *      The data (block_count * 64 bytes).
+ *  @param block_count
+ *      The count of blocks.
+ *  @param blocks
+ *      The classified blocks.
+ */
+__attribute__((target("avx2")))
+static void classify_avx2(
+    const uint8_t *data,
+    const size_t block_count,
+    xap::core::json::ScannerBlock *blocks
+) {
+    const __m256i space = _mm256_set1_epi8(' ');
+    const __m256i tab = _mm256_set1_epi8('\t');
+    const __m256i line_feed = _mm256_set1_epi8('\n');
+    const __m256i carriage_return = _mm256_set1_epi8('\r');
+    const __m256i lower_case = _mm256_set1_epi8(0x20);
+    const __m256i left_brace = _mm256_set1_epi8('{');
+    const __m256i right_brace = _mm256_set1_epi8('}');
+    const __m256i colon = _mm256_set1_epi8(':');
+    const __m256i comma = _mm256_set1_epi8(',');
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i control_max = _mm256_set1_epi8(0x1F);
+
+    for (size_t i = 0U; i < block_count; ++i) {
+        xap::core::json::ScannerBlock &block = blocks[i];
+        block.whitespace = 0U;
+        block.operators = 0U;
+        block.quote = 0U;
+        block.backslash = 0U;
+        block.control = 0U;
+        for (size_t j = 0U; j < 2U; ++j) {
+            const __m256i chunk = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i *>(data + j * 32U)
+            );
+            const uint32_t shift = static_cast<uint32_t>(j * 32U);
+
+            //  Whitespaces.
+            const __m256i whitespace = _mm256_or_si256(
+                _mm256_or_si256(
+                    _mm256_cmpeq_epi8(chunk, space),
+                    _mm256_cmpeq_epi8(chunk, tab)
+                ),
+                _mm256_or_si256(
+                    _mm256_cmpeq_epi8(chunk, line_feed),
+                    _mm256_cmpeq_epi8(chunk, carriage_return)
+                )
+            );
+
+            //  Operators ('[' | 0x20 == '{', ']' | 0x20 == '}').
+            const __m256i folded = _mm256_or_si256(chunk, lower_case);
+            const __m256i operators = _mm256_or_si256(
+                _mm256_or_si256(
+                    _mm256_cmpeq_epi8(folded, left_brace),
+                    _mm256_cmpeq_epi8(folded, right_brace)
+                ),
+                _mm256_or_si256(
+                    _mm256_cmpeq_epi8(chunk, colon),
+                    _mm256_cmpeq_epi8(chunk, comma)
+                )
+            );
+
+            //  Control characters (unsigned <= 0x1F).
+            const __m256i control = _mm256_cmpeq_epi8(
+                _mm256_min_epu8(chunk, control_max),
+                chunk
+            );
+
+            block.whitespace |= static_cast<uint64_t>(
+                static_cast<uint32_t>(_mm256_movemask_epi8(whitespace))
+            ) << shift;
+            block.operators |= static_cast<uint64_t>(
+                static_cast<uint32_t>(_mm256_movemask_epi8(operators))
+            ) << shift;
+            block.quote |= static_cast<uint64_t>(
+                static_cast<uint32_t>(_mm256_movemask_epi8(
+                    _mm256_cmpeq_epi8(chunk, quote)
+                ))
+            ) << shift;
+            block.backslash |= static_cast<uint64_t>(
+                static_cast<uint32_t>(_mm256_movemask_epi8(
+                    _mm256_cmpeq_epi8(chunk, backslash)
+                ))
+            ) << shift;
+            block.control |= static_cast<uint64_t>(
+                static_cast<uint32_t>(_mm256_movemask_epi8(control))
+            ) << shift;
+        }
+        data += 64U;
+    }
+}
+
+#endif  //  #if defined(XAPCORE_JSON_SCANNER_X86)
+
+//
+//  StructuralScanner constructor & destructor.
+//
+
+/**
+ *  Construct the object (with the best kernel of current CPU).
+ */
+StructuralScanner::StructuralScanner() :
+    StructuralScanner(StructuralScanner::get_best_kernel())
+{}
+
+/**
+ *  Construct the object.
+ *
+ *  @param kernel
+ *      The kernel (must be supported by current CPU).
+ */
+StructuralScanner::StructuralScanner(
+    const xap::core::json::ScannerKernel kernel
+) :
+    m_kernel(kernel),
+    m_classify(classify_scalar),
+    m_indices(),
+    m_index_capacity(0U),
+    m_index_count(0U),
+    m_error_offset(0U),
+    m_error_message(nullptr),
+    m_prev_escaped(0U),
+    m_prev_in_string(0U),
+    m_prev_scalar(0U),
+    m_validate_utf8(false),
+    m_utf8(kernel)
+{
+#if defined(XAPCORE_JSON_SCANNER_X86)
+    switch (kernel) {
+        case xap::core::json::ScannerKernel::sse42:
+            this->m_classify = classify_sse42;
+            break;
+        case xap::core::json::ScannerKernel::avx2:
+            this->m_classify = classify_avx2;
+            break;
+        default:
+            break;
+    }
+#else
+    this->m_kernel = xap::core::json::ScannerKernel::scalar;
+#endif  //  #if defined(XAPCORE_JSON_SCANNER_X86)
+}
+
+/**
+ *  Destruct the object.
+ */
+StructuralScanner::~StructuralScanner() noexcept {
+    //  Do nothing.
+}
+
+//
+//  StructuralScanner public methods.
+//
+
+/**
+ *  Scan the input.
+ *
+ *  @param base
+ *      The base of offsets.
+ *  @param begin
+ *      The beginning of the input.
+ *  @param end
+ *      The end of the input (end - base must be less than 2^32).
+ *  @return
+ *      True if succeed.
+ */
+bool StructuralScanner::scan(
+    const char *base,
+    const char *begin,
+    const char *end
+) {
+    this->reset();
+    return this->finish(base, begin, end);
+}
+
+/**
+ *  Start scanning an input that arrives in pieces (see feed() and
+ *  finish()).
+ */
+void StructuralScanner::reset() noexcept {
+    this->m_index_count = 0U;
+    this->m_error_offset = 0U;
+    this->m_error_message = nullptr;
+    this->m_prev_escaped = 0U;
+    this->m_prev_in_string = 0U;
+    this->m_prev_scalar = 0U;
+    this->m_utf8.reset();
+}
+
+/**
+ *  Scan a piece of the input (whole 64-byte blocks only).
+ *
+ *  @param base
+ *      The base of offsets.
+ *  @param begin
+ *      The beginning of the piece (the end of the previous piece).
+ *  @param end
+ *      The end of the input received so far.
+ *  @param next
+ *      The pointer to receive the beginning of the bytes that were not
+ *      scanned (less than 64 bytes, to be scanned with the next piece).
+ *  @return
+ *      True if succeed.
+ */
+bool StructuralScanner::feed(
+    const char *base,
+    const char *begin,
+    const char *end,
+    const char **next
+) {
+    const uint8_t *data = reinterpret_cast<const uint8_t *>(begin);
+    const size_t length = static_cast<size_t>(end - begin) & ~size_t(63U);
+    const size_t origin = static_cast<size_t>(begin - base);
+
+    xap::core::json::ScannerBlock blocks[SCANNER_BATCH_BLOCKS];
+    size_t position = 0U;
+    while (position < length) {
+        //  Classify a batch of blocks.
+        size_t block_count = (length - position) / 64U;
+        if (block_count > SCANNER_BATCH_BLOCKS) {
+            block_count = SCANNER_BATCH_BLOCKS;
+        }
+        this->m_classify(data + position, block_count, blocks);
+        if (
+            !this->validate_utf8(
+                base,
+                begin + position,
+                begin + position + block_count * 64U,
+                data + position,
+                block_count
+            ) ||
+            !this->find_tokens(origin + position, blocks, block_count)
+        ) {
+            *next = begin + position;
+            return false;
+        }
+        position += block_count * 64U;
+    }
+
+    *next = begin + length;
+    return true;
+}
+
+/**
+ *  Scan the last piece of the input.
+ *
+ *  @param base
+ *      The base of offsets.
+ *  @param begin
+ *      The beginning of the piece (the end of the previous piece).
+ *  @param end
+ *      The end of the input (end - base must be less than 2^32).
+ *  @return
+ *      True if succeed.
+ */
+bool StructuralScanner::finish(
+    const char *base,
+    const char *begin,
+    const char *end
+) {
+    if (!this->feed(base, begin, end, &begin)) {
+        return false;
+    }
+
+    //  The last block is padded with whitespaces.
+    if (begin != end) {
+        xap::core::json::ScannerBlock block;
+        uint8_t padded[64];
+        memset(padded, ' ', sizeof(padded));
+        memcpy(padded, begin, static_cast<size_t>(end - begin));
+        this->m_classify(padded, 1U, &block);
+        if (
+            !this->validate_utf8(base, begin, end, padded, 1U) ||
+            !this->find_tokens(static_cast<size_t>(begin - base), &block, 1U)
+        ) {
+            return false;
+        }
+    }
+
+    //  The last character must be whole.
+    if (this->m_validate_utf8 && !this->m_utf8.finish()) {
+        return this->set_utf8_error(
+            base,
+            end - std::min<ptrdiff_t>(end - base, 3),
+            end
+        );
+    }
+
+    //  The last string must be closed (its opening quote is the last token).
+    if (this->m_prev_in_string != 0U) {
+        this->m_error_offset = this->m_indices[this->m_index_count - 1U];
+        this->m_error_message =
+            "Syntax error: missing '\"' to close the string.";
+        return false;
+    }
+
+    //  Terminator.
+    this->reserve(1U);
+    this->m_indices[this->m_index_count] = static_cast<uint32_t>(end - base);
+    return true;
+}
+
+/**
+ *  Get the offsets of tokens.
+ *
+ *  @note
+ *      The offsets are terminated by (end - base) of the last scan.
+ *  @return
+ *      The offsets.
+ */
+const uint32_t *StructuralScanner::get_indices() const noexcept {
+    return this->m_indices.get();
+}
+
+/**
+ *  Get the offsets of tokens (writable, e.g. to cut them into ranges by
+ *  overwriting tokens with the terminator).
+ *
+ *  @return
+ *      The offsets.
+ */
+uint32_t *StructuralScanner::get_indices() noexcept {
+    return this->m_indices.get();
+}
+
+/**
+ *  Get the count of tokens (excluding the terminator).
+ *
+ *  @return
+ *      The count.
+ */
+size_t StructuralScanner::get_index_count() const noexcept {
+    return this->m_index_count;
+}
+
+/**
+ *  Get the offset of the error of the last scan.
+ *
+ *  @return
+ *      The offset.
+ */
+size_t StructuralScanner::get_error_offset() const noexcept {
+    return this->m_error_offset;
+}
+
+/**
+ *  Get the message of the error of the last scan.
+ *
+ *  @return
+ *      The message.
+ */
+const char *StructuralScanner::get_error_message() const noexcept {
+    return this->m_error_message;
+}
+
+/**
+ *  Get the kernel.
+ *
+ *  @return
+ *      The kernel.
+ */
+xap::core::json::ScannerKernel StructuralScanner::get_kernel() const noexcept {
+    return this->m_kernel;
+}
+
+/**
+ *  Set whether the input is validated as UTF-8 (of scans started
+ *  afterwards).
+ *
+ *  @param validate
+ *      True if so (false by default).
+ */
+void StructuralScanner::set_utf8_validation(const bool validate) noexcept {
+    this->m_validate_utf8 = validate;
+}
+
+/**
+ *  Get whether the input is validated as UTF-8.
+ *
+ *  @return
+ *      True if so.
+ */
+bool StructuralScanner::get_utf8_validation() const noexcept {
+    return this->m_validate_utf8;
+}
+
+//
+//  StructuralScanner public static functions.
+//
+
+/**
+ *  Check whether a kernel is supported by current CPU.
+ *
+ *  @param kernel
+ *      The kernel.
+ *  @return
+ *      True if so.
+ */
+bool StructuralScanner::is_kernel_supported(
+    const xap::core::json::ScannerKernel kernel
+) noexcept {
+    switch (kernel) {
+        case xap::core::json::ScannerKernel::scalar:
+            return true;
+#if defined(XAPCORE_JSON_SCANNER_X86)
+        case xap::core::json::ScannerKernel::sse42:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("sse4.2");
+        case xap::core::json::ScannerKernel::avx2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2");
+#endif  //  #if defined(XAPCORE_JSON_SCANNER_X86)
+        default:
+            return false;
+    }
+}
+
+/**
+ *  Get the best kernel of current CPU.
+ *
+ *  @return
+ *      The kernel.
+ */
+xap::core::json::ScannerKernel StructuralScanner::get_best_kernel() noexcept {
+    static const xap::core::json::ScannerKernel kernel = [] {
+        if (StructuralScanner::is_kernel_supported(
+            xap::core::json::ScannerKernel::avx2
+        )) {
+            return xap::core::json::ScannerKernel::avx2;
+        }
+        if (StructuralScanner::is_kernel_supported(
+            xap::core::json::ScannerKernel::sse42
+        )) {
+            return xap::core::json::ScannerKernel::sse42;
+        }
+        return xap::core::json::ScannerKernel::scalar;
+    }();
+    return kernel;
+}
+
+//
+//  StructuralScanner private methods.
+//
+
+/**
+ *  Find the tokens of classified blocks.
+ *
+ *  @param offset
+ *      The offset of the first block.
+ *  @param blocks
+ *      The blocks.
+ *  @param block_count
+ *      The count of blocks.
+ *  @return
+ *      True if succeed.
+ */
+bool StructuralScanner::find_tokens(
+    size_t offset,
+    const xap::core::json::ScannerBlock *blocks,
+    const size_t block_count
+) {
+    //  States carried from one block to the next.
+    uint64_t prev_escaped = this->m_prev_escaped;
+    uint64_t prev_in_string = this->m_prev_in_string;
+    uint64_t prev_scalar = this->m_prev_scalar;
+
+    for (size_t i = 0U; i < block_count; ++i, offset += 64U) {
+        const xap::core::json::ScannerBlock &block = blocks[i];
+
+        //  Strings (an opening quote is within the string, the closing quote
+        //  is not).
+        const uint64_t escaped = find_escaped(block.backslash, &prev_escaped);
+        const uint64_t quote = block.quote & ~escaped;
+        const uint64_t in_string = prefix_xor(quote) ^ prev_in_string;
+        prev_in_string = static_cast<uint64_t>(
+            static_cast<int64_t>(in_string) >> 63
+        );
+        const uint64_t control = block.control & in_string & ~quote;
+        if (control != 0U) {
+            this->m_error_offset = offset + trailing_zeros(control);
+            this->m_error_message =
+                "Syntax error: control character within a string.";
+            return false;
+        }
+
+        //  The first characters of numbers and literals.
+        const uint64_t scalar = ~(block.operators | block.whitespace);
+        const uint64_t nonquote_scalar = scalar & ~quote;
+        const uint64_t follows_scalar = (nonquote_scalar << 1U) | prev_scalar;
+        prev_scalar = nonquote_scalar >> 63U;
+        const uint64_t scalar_start = scalar & ~follows_scalar;
+
+        uint64_t tokens = (
+            (block.operators | scalar_start) & ~in_string & ~quote
+        ) | quote;
+
+        //  Record the offsets.
+        this->reserve(64U);
+        uint32_t *indices = this->m_indices.get() + this->m_index_count;
+        while (tokens != 0U) {
+            *(indices++) = static_cast<uint32_t>(
+                offset + trailing_zeros(tokens)
+            );
+            tokens &= tokens - 1U;
+        }
+        this->m_index_count = static_cast<size_t>(
+            indices - this->m_indices.get()
+        );
+    }
+
+    this->m_prev_escaped = prev_escaped;
+    this->m_prev_in_string = prev_in_string;
+    this->m_prev_scalar = prev_scalar;
+    return true;
+}
+
+/**
+ *  Validate blocks as UTF-8 (if the validation is enabled).
+ *
+ *  @param base
+ *      The base of offsets.
+ *  @param begin
+ *      The first block within the input.
+ *  @param end
+ *      The end of the blocks within the input.
+ *  @param data
+ *      The blocks (the input between begin and end, or a padded copy of it).
+ *  @param block_count
+ *      The count of blocks.
+ *  @return
+ *      True if succeed.
+ */
+bool StructuralScanner::validate_utf8(
+    const char *base,
+    const char *begin,
+    const char *end,
+    const uint8_t *data,
+    const size_t block_count
+) {
+    if (!this->m_validate_utf8 || this->m_utf8.feed(data, block_count)) {
+        return true;
+    }
+    return this->set_utf8_error(base, begin, end);
+}
+
+/**
+ *  Set the error of an invalid UTF-8 sequence.
+ *
+ *  @param base
+ *      The base of offsets.
+ *  @param begin
+ *      The beginning of the invalid piece within the input.
+ *  @param end
+ *      The end of the invalid piece within the input.
+ *  @return
+ *      False.
+ */
+bool StructuralScanner::set_utf8_error(
+    const char *base,
+    const char *begin,
+    const char *end
+) noexcept {
+    //  Only the bytes since the last character that is known to be valid are
+    //  checked again.
+    const uint8_t *error = xap::core::json::Utf8Validator::find_error(
+        reinterpret_cast<const uint8_t *>(base),
+        reinterpret_cast<const uint8_t *>(begin),
+        reinterpret_cast<const uint8_t *>(end)
+    );
+    this->m_error_offset = static_cast<size_t>(
+        error - reinterpret_cast<const uint8_t *>(base)
+    );
+    this->m_error_message = "Syntax error: invalid UTF-8 sequence.";
+    return false;
+}
+
+/**
+ *  Make sure that the index buffer has room for more offsets.
+ *
+ *  @param count
+ *      The count of offsets to be added.
+ */
+void StructuralScanner::reserve(const size_t count) {
+    const size_t required = this->m_index_count + count;
+    if (required <= this->m_index_capacity) {
+        return;
+    }
+
+    size_t capacity = this->m_index_capacity * 2U;
+    if (capacity < required) {
+        capacity = required;
+    }
+    if (capacity < 1024U) {
+        capacity = 1024U;
+    }
+    std::unique_ptr<uint32_t[]> indices(new uint32_t[capacity]);
+    if (this->m_index_count != 0U) {
+        memcpy(
+            indices.get(),
+            this->m_indices.get(),
+            this->m_index_count * sizeof(uint32_t)
+        );
+    }
+    this->m_indices = std::move(indices);
+    this->m_index_capacity = capacity;
+}
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
@@ -0,0 +1,360 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+#ifndef XAP_CORE_JSON_SCANNER_P_H__
+#define XAP_CORE_JSON_SCANNER_P_H__
+
+//
+//  Imports.
+//
+#include "xap/core/json/build.h"
+#include "utf8_p.h"
+
+#include <memory>
+#include <stdint.h>
+#include <stdlib.h>
+
+namespace xap {
+namespace core {
+namespace json {
+
+//
+//  Enum.
+//
+
+/**
+ *  Scanner kernel.
+ */
+enum ScannerKernel: uint8_t {
+    scalar,
+    sse42,
+    avx2
+};
+
+//
+//  Structures.
+//
+
+/**
+ *  Character classes of a 64-byte block (one bit per byte).
+ */
+struct ScannerBlock {
+    uint64_t whitespace;
+    uint64_t operators;
+    uint64_t quote;
+    uint64_t backslash;
+    uint64_t control;
+};
+
+//
+//  Classes.
+//
+
+/**
+ *  Structural scanner (stage 1 of the native parser).
+ *
+ *  @note
+ *      The scanner classifies the input 64 bytes at a time (with SIMD
+ *      instructions if the CPU supports) and records the offsets of:
+ *
+ *          - Operators ('{', '}', '[', ']', ':' and ',') out of strings.
+ *          - Opening and closing quotes of strings.
+ *          - The first character of other tokens (numbers and literals).
+ *
+ *      So the tree construction (stage 2) jumps from token to token without
+ *      looking at whitespaces and the contents of strings. Unclosed strings
+ *      and unescaped control characters within strings are detected here,
+ *      and so are invalid UTF-8 sequences if the validation is enabled
+ *      (each batch of blocks is validated while it is still in cache).
+ */
+class StructuralScanner {
+public:
+
+    /**
+     *  Construct the object (with the best kernel of current CPU).
+     */
+    StructuralScanner();
+
+    /**
+     *  Construct the object.
+     *
+     *  @param kernel
+     *      The kernel (must be supported by current CPU).
+     */
+    explicit StructuralScanner(const xap::core::json::ScannerKernel kernel);
+
+    /**
+     *  Destruct the object.
+     */
+    virtual ~StructuralScanner() noexcept;
+
+    //
+    //  Public methods.
+    //
+
+    /**
+     *  Scan the input.
+     *
+     *  @param base
+     *      The base of offsets.
+     *  @param begin
+     *      The beginning of the input.
+     *  @param end
+     *      The end of the input (end - base must be less than 2^32).
+     *  @return
+     *      True if succeed.
+     */
+    bool scan(const char *base, const char *begin, const char *end);
+
+    /**
+     *  Start scanning an input that arrives in pieces (see feed() and
+     *  finish()).
+     */
+    void reset() noexcept;
+
+    /**
+     *  Scan a piece of the input (whole 64-byte blocks only).
+     *
+     *  @note
+     *      The offsets are relative to the base, so the input can be moved
+     *      (e.g. reallocated while growing) between pieces.
+     *  @param base
+     *      The base of offsets.
+     *  @param begin
+     *      The beginning of the piece (the end of the previous piece).
+     *  @param end
+     *      The end of the input received so far.
+     *  @param next
+     *      The pointer to receive the beginning of the bytes that were not
+     *      scanned (less than 64 bytes, to be scanned with the next piece).
+     *  @return
+     *      True if succeed.
+     */
+    bool feed(
+        const char *base,
+        const char *begin,
+        const char *end,
+        const char **next
+    );
+
+    /**
+     *  Scan the last piece of the input.
+     *
+     *  @param base
+     *      The base of offsets.
+     *  @param begin
+     *      The beginning of the piece (the end of the previous piece).
+     *  @param end
+     *      The end of the input (end - base must be less than 2^32).
+     *  @return
+     *      True if succeed.
+     */
+    bool finish(const char *base, const char *begin, const char *end);
+
+    /**
+     *  Get the offsets of tokens.
+     *
+     *  @note
+     *      The offsets are terminated by (end - base) of the last scan.
+     *  @return
+     *      The offsets.
+     */
+    const uint32_t *get_indices() const noexcept;
+
+    /**
+     *  Get the offsets of tokens (writable, e.g. to cut them into ranges by
+     *  overwriting tokens with the terminator).
+     *
+     *  @return
+     *      The offsets.
+     */
+    uint32_t *get_indices() noexcept;
+
+    /**
+     *  Get the count of tokens (excluding the terminator).
+     *
+     *  @return
+     *      The count.
+     */
+    size_t get_index_count() const noexcept;
+
+    /**
+     *  Get the offset of the error of the last scan.
+     *
+     *  @return
+     *      The offset.
+     */
+    size_t get_error_offset() const noexcept;
+
+    /**
+     *  Get the message of the error of the last scan.
+     *
+     *  @return
+     *      The message.
+     */
+    const char *get_error_message() const noexcept;
+
+    /**
+     *  Get the kernel.
+     *
+     *  @return
+     *      The kernel.
+     */
+    xap::core::json::ScannerKernel get_kernel() const noexcept;
+
+    /**
+     *  Set whether the input is validated as UTF-8 (of scans started
+     *  afterwards).
+     *
+     *  @param validate
+     *      True if so (false by default).
+     */
+    void set_utf8_validation(const bool validate) noexcept;
+
+    /**
+     *  Get whether the input is validated as UTF-8.
+     *
+     *  @return
+     *      True if so.
+     */
+    bool get_utf8_validation() const noexcept;
+
+    //
+    //  Public static functions.
+    //
+
+    /**
+     *  Check whether a kernel is supported by current CPU.
+     *
+     *  @param kernel
+     *      The kernel.
+     *  @return
+     *      True if so.
+     */
+    static bool is_kernel_supported(
+        const xap::core::json::ScannerKernel kernel
+    ) noexcept;
+
+    /**
+     *  Get the best kernel of current CPU.
+     *
+     *  @return
+     *      The kernel.
+     */
+    static xap::core::json::ScannerKernel get_best_kernel() noexcept;
+
+private:
+
+    //
+    //  Private types.
+    //
+    typedef void (*ClassifyFunction)(
+        const uint8_t *data,
+        const size_t block_count,
+        xap::core::json::ScannerBlock *blocks
+    );
+
+    //
+    //  Private methods.
+    //
+
+    /**
+     *  Make sure that the index buffer has room for more offsets.
+     *
+     *  @param count
+     *      The count of offsets to be added.
+     */
+    void reserve(const size_t count);
+
+    /**
+     *  Find the tokens of classified blocks.
+     *
+     *  @param offset
+     *      The offset of the first block.
+     *  @param blocks
+     *      The blocks.
+     *  @param block_count
+     *      The count of blocks.
+     *  @return
+     *      True if succeed.
+     */
+    bool find_tokens(
+        size_t offset,
+        const xap::core::json::ScannerBlock *blocks,
+        const size_t block_count
+    );
+
+    /**
+     *  Validate blocks as UTF-8 (if the validation is enabled).
+     *
+     *  @param base
+     *      The base of offsets.
+     *  @param begin
+     *      The first block within the input.
+     *  @param end
+     *      The end of the blocks within the input.
+     *  @param data
+     *      The blocks (the input between begin and end, or a padded copy of
+     *      it).
+     *  @param block_count
+     *      The count of blocks.
+     *  @return
+     *      True if succeed.
+     */
+    bool validate_utf8(
+        const char *base,
+        const char *begin,
+        const char *end,
+        const uint8_t *data,
+        const size_t block_count
+    );
+
+    /**
+     *  Set the error of an invalid UTF-8 sequence.
+     *
+     *  @param base
+     *      The base of offsets.
+     *  @param begin
+     *      The beginning of the invalid piece within the input.
+     *  @param end
+     *      The end of the invalid piece within the input.
+     *  @return
+     *      False.
+     */
+    bool set_utf8_error(
+        const char *base,
+        const char *begin,
+        const char *end
+    ) noexcept;
+
+    //
+    //  Private members.
+    //
+    xap::core::json::ScannerKernel m_kernel;
+    ClassifyFunction m_classify;
+    std::unique_ptr<uint32_t[]> m_indices;
+    size_t m_index_capacity;
+    size_t m_index_count;
+    size_t m_error_offset;
+    const char *m_error_message;
+    uint64_t m_prev_escaped;
+    uint64_t m_prev_in_string;
+    uint64_t m_prev_scalar;
+    bool m_validate_utf8;
+    xap::core::json::Utf8Validator m_utf8;
+
+    //
+    //  Private constructor.
+    //
+    StructuralScanner(const StructuralScanner &) = delete;
+    StructuralScanner &operator=(const StructuralScanner &) = delete;
+};
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
+
+#endif  //  #ifndef XAP_CORE_JSON_SCANNER_P_H__
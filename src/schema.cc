@@ -0,0 +1,366 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+//
+//  Imports.
+//
+#include "xap/core/json/schema.h"
+#include "schema_p.h"
+#include "document_p.h"
+#include "xap/core/json/error.h"
+
+#include <memory>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace xap {
+namespace core {
+namespace json {
+
+//
+//  Schema constructor & destructor.
+//
+
+/**
+ *  Construct the object (without fields).
+ */
+Schema::Schema() :
+    m_schema(std::make_shared<xap::core::json::SchemaPrivate>())
+{}
+
+/**
+ *  Construct (Copy) the object.
+ *
+ *  @param src
+ *      The source.
+ */
+Schema::Schema(const Schema &src) :
+    m_schema(src.m_schema)
+{}
+
+/**
+ *  Destruct the object.
+ */
+Schema::~Schema() noexcept {
+    //  Do nothing.
+}
+
+//
+//  Schema operators.
+//
+
+/**
+ *  Assign (Copy) the object.
+ *
+ *  @param src
+ *      The source.
+ *  @return
+ *      Self.
+ */
+xap::core::json::Schema &Schema::operator=(const Schema &src) {
+    this->m_schema = src.m_schema;
+    return *this;
+}
+
+//
+//  Schema public methods.
+//
+
+/**
+ *  Add a required field.
+ *
+ *  @throw xap::core::json::Exception
+ *      Raised if the name is duplicated or if an integer width is given for
+ *      a type other than Type::numeric (ERROR_PARAMETER).
+ *  @param name
+ *      The name (key) of the field.
+ *  @param type
+ *      The type.
+ *  @param width
+ *      The integer width (only for Type::numeric).
+ *  @return
+ *      Self.
+ */
+xap::core::json::Schema &Schema::required(
+    const std::string &name,
+    const xap::core::json::Type type,
+    const xap::core::json::Width width
+) {
+    this->mutate().add(name, type, width, true, nullptr);
+    return *this;
+}
+
+/**
+ *  Add a required field that is checked by a nested schema.
+ *
+ *  @throw xap::core::json::Exception
+ *      Raised if the name is duplicated or if the type is neither
+ *      Type::object nor Type::array (ERROR_PARAMETER).
+ *  @param name
+ *      The name (key) of the field.
+ *  @param type
+ *      The type (Type::object to check the members of the field, or
+ *      Type::array to check each item, which must be an object).
+ *  @param schema
+ *      The nested schema (shared, not copied).
+ *  @return
+ *      Self.
+ */
+xap::core::json::Schema &Schema::required(
+    const std::string &name,
+    const xap::core::json::Type type,
+    const Schema &schema
+) {
+    //  Keep the nested schema before this one is detached (the nested
+    //  schema can be this one).
+    const std::shared_ptr<const xap::core::json::SchemaPrivate> nested =
+        schema.m_schema;
+    this->mutate().add(
+        name,
+        type,
+        xap::core::json::Width::any,
+        true,
+        nested
+    );
+    return *this;
+}
+
+/**
+ *  Add an optional field.
+ *
+ *  @throw xap::core::json::Exception
+ *      Raised if the name is duplicated or if an integer width is given for
+ *      a type other than Type::numeric (ERROR_PARAMETER).
+ *  @param name
+ *      The name (key) of the field.
+ *  @param type
+ *      The type.
+ *  @param width
+ *      The integer width (only for Type::numeric).
+ *  @return
+ *      Self.
+ */
+xap::core::json::Schema &Schema::optional(
+    const std::string &name,
+    const xap::core::json::Type type,
+    const xap::core::json::Width width
+) {
+    this->mutate().add(name, type, width, false, nullptr);
+    return *this;
+}
+
+/**
+ *  Add an optional field that is checked by a nested schema.
+ *
+ *  @throw xap::core::json::Exception
+ *      Raised if the name is duplicated or if the type is neither
+ *      Type::object nor Type::array (ERROR_PARAMETER).
+ *  @param name
+ *      The name (key) of the field.
+ *  @param type
+ *      The type (Type::object to check the members of the field, or
+ *      Type::array to check each item, which must be an object).
+ *  @param schema
+ *      The nested schema (shared, not copied).
+ *  @return
+ *      Self.
+ */
+xap::core::json::Schema &Schema::optional(
+    const std::string &name,
+    const xap::core::json::Type type,
+    const Schema &schema
+) {
+    const std::shared_ptr<const xap::core::json::SchemaPrivate> nested =
+        schema.m_schema;
+    this->mutate().add(
+        name,
+        type,
+        xap::core::json::Width::any,
+        false,
+        nested
+    );
+    return *this;
+}
+
+/**
+ *  Get the count of fields (excluding the fields of nested schemas).
+ *
+ *  @return
+ *      The count.
+ */
+size_t Schema::get_field_count() const noexcept {
+    return this->m_schema->get_fields().size();
+}
+
+//
+//  Schema private methods.
+//
+
+/**
+ *  Get the private schema (exclusively owned) for modification.
+ *
+ *  @return
+ *      The private schema.
+ */
+xap::core::json::SchemaPrivate &Schema::mutate() {
+    //  Copies (and the schemas that nest this one) keep the fields they
+    //  have seen (copy-on-write).
+    if (this->m_schema.use_count() != 1) {
+        this->m_schema = std::make_shared<xap::core::json::SchemaPrivate>(
+            *(this->m_schema)
+        );
+    }
+    return *(this->m_schema);
+}
+
+//
+//  SchemaPrivate constructor & destructor.
+//
+
+/**
+ *  Construct the object (without fields).
+ */
+SchemaPrivate::SchemaPrivate() :
+    m_fields()
+{}
+
+/**
+ *  Construct (Copy) the object.
+ *
+ *  @param src
+ *      The source.
+ */
+SchemaPrivate::SchemaPrivate(const SchemaPrivate &src) :
+    m_fields(src.m_fields)
+{}
+
+/**
+ *  Destruct the object.
+ */
+SchemaPrivate::~SchemaPrivate() noexcept {
+    //  Do nothing.
+}
+
+//
+//  SchemaPrivate public methods.
+//
+
+/**
+ *  Add a field.
+ *
+ *  @throw xap::core::json::Exception
+ *      Raised if the field is invalid (ERROR_PARAMETER).
+ *  @param name
+ *      The name (key) of the field.
+ *  @param type
+ *      The type.
+ *  @param width
+ *      The integer width.
+ *  @param required
+ *      Whether the field is required.
+ *  @param schema
+ *      The nested schema (nullptr if not checked).
+ */
+void SchemaPrivate::add(
+    const std::string &name,
+    const xap::core::json::Type type,
+    const xap::core::json::Width width,
+    const bool required,
+    const std::shared_ptr<const xap::core::json::SchemaPrivate> &schema
+) {
+    //  Check the field.
+    if (
+        width != xap::core::json::Width::any &&
+        type != xap::core::json::Type::numeric
+    ) {
+        throw xap::core::json::Exception(
+            "Integer width is only for numeric fields.",
+            xap::core::json::ERROR_PARAMETER,
+            name.c_str()
+        );
+    }
+    if (
+        schema &&
+        type != xap::core::json::Type::object &&
+        type != xap::core::json::Type::array
+    ) {
+        throw xap::core::json::Exception(
+            "Nested schema is only for object and array fields.",
+            xap::core::json::ERROR_PARAMETER,
+            name.c_str()
+        );
+    }
+    for (const xap::core::json::SchemaField &field : this->m_fields) {
+        if (field.key == name) {
+            throw xap::core::json::Exception(
+                "Duplicate field.",
+                xap::core::json::ERROR_PARAMETER,
+                name.c_str()
+            );
+        }
+    }
+
+    xap::core::json::SchemaField field;
+    field.key = name;
+    field.key_hash = xap::core::json::Document::hash_key(
+        name.data(),
+        name.size()
+    );
+    field.type = type;
+    field.width = width;
+    field.required = required;
+    field.schema = schema;
+    this->m_fields.push_back(std::move(field));
+}
+
+/**
+ *  Get the fields.
+ *
+ *  @return
+ *      The fields.
+ */
+const std::vector<xap::core::json::SchemaField> &
+SchemaPrivate::get_fields() const noexcept {
+    return this->m_fields;
+}
+
+//
+//  SchemaPrivate public static functions.
+//
+
+/**
+ *  Render the path of a frame (the way xap::core::json::Path does).
+ *
+ *  @param frame
+ *      The frame (nullptr for the validated object).
+ *  @param out
+ *      The string to be appended (holds the path of the validated object).
+ */
+void SchemaPrivate::render(
+    const xap::core::json::SchemaFrame *frame,
+    std::string &out
+) {
+    if (frame == nullptr) {
+        return;
+    }
+
+    SchemaPrivate::render(frame->parent, out);
+    if (out.size() != 0U && *(out.end() - 1U) != '/') {
+        out.push_back('/');
+    }
+    if (frame->key) {
+        out.append(frame->key, frame->key_length);
+    } else {
+        out.append(std::to_string(frame->index));
+    }
+}
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
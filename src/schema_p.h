@@ -0,0 +1,174 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+#ifndef XAP_CORE_JSON_SCHEMA_P_H__
+#define XAP_CORE_JSON_SCHEMA_P_H__
+
+//
+//  Imports.
+//
+#include "xap/core/json/build.h"
+#include "xap/core/json/schema.h"
+#include "xap/core/json/traverse.h"
+
+#include <memory>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+namespace xap {
+namespace core {
+namespace json {
+
+//
+//  Declare.
+//
+class SchemaPrivate;
+
+//
+//  Structures.
+//
+
+/**
+ *  Field of a compiled schema.
+ */
+struct SchemaField {
+    //  Key.
+    std::string key;
+
+    //  Hash of the key (see Document::hash_key()).
+    uint64_t key_hash;
+
+    //  Type (Type::null for any type).
+    xap::core::json::Type type;
+
+    //  Integer width (only for Type::numeric).
+    xap::core::json::Width width;
+
+    //  Whether the field must exist (and must not be null).
+    bool required;
+
+    //  Nested schema of the members (Type::object) or of each item
+    //  (Type::array), nullptr if not checked.
+    std::shared_ptr<const xap::core::json::SchemaPrivate> schema;
+};
+
+/**
+ *  Frame of the depth-first walk of a schema (only used to render the path
+ *  of a failed check).
+ */
+struct SchemaFrame {
+    //  The frame of the parent (nullptr for the validated object).
+    const xap::core::json::SchemaFrame *parent;
+
+    //  The key of the member (nullptr for an array item).
+    const char *key;
+    size_t key_length;
+
+    //  The index of the array item.
+    size_t index;
+};
+
+//
+//  Classes.
+//
+
+/**
+ *  Private schema.
+ */
+class SchemaPrivate {
+public:
+
+    /**
+     *  Construct the object (without fields).
+     */
+    SchemaPrivate();
+
+    /**
+     *  Construct (Copy) the object.
+     *
+     *  @note
+     *      Nested schemas are shared with the source.
+     *  @param src
+     *      The source.
+     */
+    SchemaPrivate(const SchemaPrivate &src);
+
+    /**
+     *  Destruct the object.
+     */
+    virtual ~SchemaPrivate() noexcept;
+
+    //
+    //  Public methods.
+    //
+
+    /**
+     *  Add a field.
+     *
+     *  @throw xap::core::json::Exception
+     *      Raised if the field is invalid (ERROR_PARAMETER).
+     *  @param name
+     *      The name (key) of the field.
+     *  @param type
+     *      The type.
+     *  @param width
+     *      The integer width.
+     *  @param required
+     *      Whether the field is required.
+     *  @param schema
+     *      The nested schema (nullptr if not checked).
+     */
+    void add(
+        const std::string &name,
+        const xap::core::json::Type type,
+        const xap::core::json::Width width,
+        const bool required,
+        const std::shared_ptr<const xap::core::json::SchemaPrivate> &schema
+    );
+
+    /**
+     *  Get the fields.
+     *
+     *  @return
+     *      The fields.
+     */
+    const std::vector<xap::core::json::SchemaField> &
+    get_fields() const noexcept;
+
+    /**
+     *  Render the path of a frame (the way xap::core::json::Path does).
+     *
+     *  @param frame
+     *      The frame (nullptr for the validated object).
+     *  @param out
+     *      The string to be appended (holds the path of the validated
+     *      object).
+     */
+    static void render(
+        const xap::core::json::SchemaFrame *frame,
+        std::string &out
+    );
+
+private:
+
+    //
+    //  Private members.
+    //
+    std::vector<xap::core::json::SchemaField> m_fields;
+
+    //
+    //  Private constructor.
+    //
+    SchemaPrivate &operator=(const SchemaPrivate &) = delete;
+};
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
+
+#endif  //  #ifndef XAP_CORE_JSON_SCHEMA_P_H__
@@ -0,0 +1,143 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+//
+//  Imports.
+//
+#include "xap/core/json/status.h"
+#include "xap/core/json/error.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string>
+
+namespace xap {
+namespace core {
+namespace json {
+
+//
+//  Status constructor & destructor.
+//
+
+/**
+ *  Construct the object (succeeded).
+ */
+Status::Status() noexcept :
+    m_message(""),
+    m_code(0U),
+    m_path()
+{}
+
+/**
+ *  Construct (Copy) the object.
+ *
+ *  @param src
+ *      The source.
+ */
+Status::Status(const Status &src) :
+    m_message(src.m_message),
+    m_code(src.m_code),
+    m_path(src.m_path)
+{}
+
+/**
+ *  Destruct the object.
+ */
+Status::~Status() noexcept {
+    //  Do nothing.
+}
+
+//
+//  Status operators.
+//
+
+/**
+ *  Assign (Copy) the object.
+ *
+ *  @param src
+ *      The source.
+ *  @return
+ *      Self.
+ */
+xap::core::json::Status &Status::operator=(const Status &src) {
+    this->m_message = src.m_message;
+    this->m_code = src.m_code;
+    this->m_path = src.m_path;
+    return *this;
+}
+
+//
+//  Status public methods.
+//
+
+/**
+ *  Check whether the last call was succeeded.
+ *
+ *  @return
+ *      True if so.
+ */
+bool Status::is_ok() const noexcept {
+    return this->m_code == 0U;
+}
+
+/**
+ *  Get the error code.
+ *
+ *  @return
+ *      The error code (0 if succeeded).
+ */
+uint16_t Status::get_code() const noexcept {
+    return this->m_code;
+}
+
+/**
+ *  Get the error message.
+ *
+ *  @return
+ *      The error message ("" if succeeded).
+ */
+const char *Status::what() const noexcept {
+    return this->m_message;
+}
+
+/**
+ *  Get the path.
+ *
+ *  @return
+ *      The path ("" if succeeded).
+ */
+const char *Status::get_path() const noexcept {
+    return this->m_path.c_str();
+}
+
+/**
+ *  Reset the status to succeeded (the path buffer is kept).
+ */
+void Status::clear() noexcept {
+    this->m_message = "";
+    this->m_code = 0U;
+    this->m_path.clear();
+}
+
+/**
+ *  Raise the error as an exception (do nothing if succeeded).
+ *
+ *  @throw xap::core::json::Exception
+ *      Raised if the status is not succeeded.
+ */
+void Status::raise() const {
+    if (this->m_code != 0U) {
+        throw xap::core::json::Exception(
+            this->m_message,
+            this->m_code,
+            this->m_path.c_str()
+        );
+    }
+}
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
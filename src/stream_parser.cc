@@ -0,0 +1,167 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+//
+//  Imports.
+//
+#include "xap/core/json/stream_parser.h"
+#include "parser_p.h"
+#include "traverse_p.h"
+#include "xap/core/json/error.h"
+#include "xap/core/json/traverse.h"
+
+#include <memory>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string>
+
+namespace xap {
+namespace core {
+namespace json {
+
+//
+//  StreamParser constructor & destructor.
+//
+
+/**
+ *  Construct the object (with the default backend).
+ */
+StreamParser::StreamParser() :
+    StreamParser(xap::core::json::Parser::get_default_backend())
+{}
+
+/**
+ *  Construct the object.
+ *
+ *  @param backend
+ *      The backend.
+ */
+StreamParser::StreamParser(const xap::core::json::Backend backend) :
+    m_parser(std::make_unique<xap::core::json::ParserPrivate>(backend))
+{}
+
+/**
+ *  Destruct the object.
+ */
+StreamParser::~StreamParser() noexcept {
+    //  Do nothing.
+}
+
+//
+//  StreamParser public methods.
+//
+
+/**
+ *  Feed a piece of the JSON document.
+ *
+ *  @param data
+ *      The piece (copied).
+ *  @param datalen
+ *      The length of the piece.
+ *  @return
+ *      False if the document is already known to be invalid (finish() raises
+ *      the error).
+ */
+bool StreamParser::feed(const uint8_t *data, const size_t datalen) {
+    return this->m_parser->feed(reinterpret_cast<const char*>(data), datalen);
+}
+
+/**
+ *  Feed a piece of the JSON document.
+ *
+ *  @param data
+ *      The piece (copied).
+ *  @param datalen
+ *      The length of the piece.
+ *  @return
+ *      False if the document is already known to be invalid (finish() raises
+ *      the error).
+ */
+bool StreamParser::feed(const char *data, const size_t datalen) {
+    return this->m_parser->feed(data, datalen);
+}
+
+/**
+ *  Parse the JSON document that was fed (and get ready for the next
+ *  document).
+ *
+ *  @throw xap::core::json::Exception
+ *      Raised if JSON parsing was failed (ERROR_PARAMETER).
+ *  @param path
+ *      The path.
+ *  @return
+ *      Traverse object of the root.
+ */
+xap::core::json::Traverse StreamParser::finish(const std::string &path) {
+    return xap::core::json::Traverse(this->m_parser->finish(path));
+}
+
+/**
+ *  Discard the JSON document that was fed.
+ */
+void StreamParser::reset() noexcept {
+    this->m_parser->reset();
+}
+
+/**
+ *  Reserve memory for the JSON document to be fed (e.g. with the
+ *  Content-Length of a request), so that the buffer is not reallocated while
+ *  pieces are fed.
+ *
+ *  @param size
+ *      The (expected) size of the document.
+ */
+void StreamParser::reserve(const size_t size) {
+    this->m_parser->reserve(size);
+}
+
+/**
+ *  Get the size of the JSON document fed so far.
+ *
+ *  @return
+ *      The size.
+ */
+size_t StreamParser::get_fed_size() const noexcept {
+    return this->m_parser->get_fed_size();
+}
+
+/**
+ *  Set the arena of documents parsed afterwards.
+ *
+ *  @note
+ *      See xap::core::json::Parser::set_arena().
+ *  @param arena
+ *      The arena (nullptr to allocate from the heap, which is the default).
+ */
+void StreamParser::set_arena(const xap::core::json::Arena *arena) noexcept {
+    if (arena) {
+        this->m_parser->set_arena(arena->m_arena);
+    } else {
+        this->m_parser->set_arena(nullptr);
+    }
+}
+
+/**
+ *  Set the key table of documents parsed afterwards.
+ *
+ *  @note
+ *      See xap::core::json::Parser::set_key_table().
+ *  @param keys
+ *      The key table (nullptr to not intern the keys, which is the default).
+ */
+void StreamParser::set_key_table(
+    const xap::core::json::KeyTable *keys
+) noexcept {
+    if (keys) {
+        this->m_parser->set_key_table(keys->m_table);
+    } else {
+        this->m_parser->set_key_table(nullptr);
+    }
+}
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
@@ -0,0 +1,254 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+//
+//  Imports.
+//
+#include "xap/core/json/string_view.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+namespace xap {
+namespace core {
+namespace json {
+
+//
+//  StringView constructor.
+//
+
+/**
+ *  Construct the object (empty).
+ */
+StringView::StringView() noexcept :
+    m_data(""),
+    m_size(0U)
+{}
+
+/**
+ *  Construct the object.
+ *
+ *  @param data
+ *      The characters.
+ *  @param size
+ *      The count of characters.
+ */
+StringView::StringView(const char *data, const size_t size) noexcept :
+    m_data(data),
+    m_size(size)
+{}
+
+//
+//  StringView public methods.
+//
+
+/**
+ *  Get the characters.
+ *
+ *  @return
+ *      The characters (not NUL-terminated).
+ */
+const char *StringView::data() const noexcept {
+    return this->m_data;
+}
+
+/**
+ *  Get the count of characters.
+ *
+ *  @return
+ *      The count.
+ */
+size_t StringView::size() const noexcept {
+    return this->m_size;
+}
+
+/**
+ *  Check whether the string is empty.
+ *
+ *  @return
+ *      True if so.
+ */
+bool StringView::empty() const noexcept {
+    return this->m_size == 0U;
+}
+
+/**
+ *  Get the first character.
+ *
+ *  @return
+ *      The iterator.
+ */
+const char *StringView::begin() const noexcept {
+    return this->m_data;
+}
+
+/**
+ *  Get the end of the characters.
+ *
+ *  @return
+ *      The iterator.
+ */
+const char *StringView::end() const noexcept {
+    return this->m_data + this->m_size;
+}
+
+/**
+ *  Copy the string.
+ *
+ *  @return
+ *      The copy.
+ */
+std::string StringView::to_string() const {
+    return std::string(this->m_data, this->m_size);
+}
+
+/**
+ *  Check whether the string equals to another one.
+ *
+ *  @param other
+ *      The other string.
+ *  @param other_size
+ *      The length of the other string.
+ *  @return
+ *      True if so.
+ */
+bool StringView::equals(
+    const char *other,
+    const size_t other_size
+) const noexcept {
+    return (
+        this->m_size == other_size &&
+        (other_size == 0U || memcmp(this->m_data, other, other_size) == 0)
+    );
+}
+
+//
+//  StringView operators.
+//
+
+/**
+ *  Get a character.
+ *
+ *  @param index
+ *      The index (must be less than the size).
+ *  @return
+ *      The character.
+ */
+char StringView::operator[](const size_t index) const noexcept {
+    return this->m_data[index];
+}
+
+//
+//  Operators.
+//
+
+/**
+ *  Check whether two strings are equal.
+ *
+ *  @param a
+ *      The first string.
+ *  @param b
+ *      The second string.
+ *  @return
+ *      True if so.
+ */
+bool operator==(
+    const xap::core::json::StringView &a,
+    const xap::core::json::StringView &b
+) noexcept {
+    return a.equals(b.data(), b.size());
+}
+
+/**
+ *  Check whether two strings are equal.
+ *
+ *  @param a
+ *      The first string.
+ *  @param b
+ *      The second string.
+ *  @return
+ *      True if so.
+ */
+bool operator==(
+    const xap::core::json::StringView &a,
+    const std::string &b
+) noexcept {
+    return a.equals(b.data(), b.size());
+}
+
+/**
+ *  Check whether two strings are equal.
+ *
+ *  @param a
+ *      The first string.
+ *  @param b
+ *      The second string (NUL-terminated).
+ *  @return
+ *      True if so.
+ */
+bool operator==(
+    const xap::core::json::StringView &a,
+    const char *b
+) noexcept {
+    return a.equals(b, strlen(b));
+}
+
+/**
+ *  Check whether two strings are not equal.
+ *
+ *  @param a
+ *      The first string.
+ *  @param b
+ *      The second string.
+ *  @return
+ *      True if so.
+ */
+bool operator!=(
+    const xap::core::json::StringView &a,
+    const xap::core::json::StringView &b
+) noexcept {
+    return !a.equals(b.data(), b.size());
+}
+
+/**
+ *  Check whether two strings are not equal.
+ *
+ *  @param a
+ *      The first string.
+ *  @param b
+ *      The second string.
+ *  @return
+ *      True if so.
+ */
+bool operator!=(
+    const xap::core::json::StringView &a,
+    const std::string &b
+) noexcept {
+    return !a.equals(b.data(), b.size());
+}
+
+/**
+ *  Check whether two strings are not equal.
+ *
+ *  @param a
+ *      The first string.
+ *  @param b
+ *      The second string (NUL-terminated).
+ *  @return
+ *      True if so.
+ */
+bool operator!=(
+    const xap::core::json::StringView &a,
+    const char *b
+) noexcept {
+    return !a.equals(b, strlen(b));
+}
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
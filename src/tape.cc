@@ -0,0 +1,1088 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+//
+//  Imports.
+//
+#include "tape_p.h"
+#include "document_p.h"
+#include "key_table_p.h"
+#include "tape_parser_p.h"
+
+#include "json/json.h"
+
+#include <memory>
+#include <new>
+#include <string.h>
+#include <utility>
+#include <vector>
+
+namespace xap {
+namespace core {
+namespace json {
+
+//
+//  TapeDocument constructor & destructor.
+//
+
+/**
+ *  Construct the object.
+ *
+ *  @param arena
+ *      The arena of the tape (nullptr to allocate from the heap).
+ *  @param input
+ *      The input buffer (moved, strings of the document refer to it).
+ */
+TapeDocument::TapeDocument(
+    const std::shared_ptr<xap::core::json::ArenaPrivate> &arena,
+    std::string &&input
+) :
+    Document(),
+    m_input(std::move(input)),
+    m_input_copy(xap::core::json::ArenaAllocator<char>(arena)),
+    m_file(),
+    m_data(&(m_input[0])),
+    m_size(m_input.size()),
+    m_nodes(xap::core::json::ArenaAllocator<xap::core::json::TapeNode>(arena)),
+    m_root(0U)
+{}
+
+/**
+ *  Construct the object.
+ *
+ *  @param arena
+ *      The arena of the tape and the copy of the input (nullptr to allocate
+ *      from the heap).
+ *  @param data
+ *      The input buffer (copied, strings of the document refer to the copy).
+ *  @param datalen
+ *      The length of the input buffer.
+ */
+TapeDocument::TapeDocument(
+    const std::shared_ptr<xap::core::json::ArenaPrivate> &arena,
+    const char *data,
+    const size_t datalen
+) :
+    Document(),
+    m_input(),
+    m_input_copy(data, data + datalen, xap::core::json::ArenaAllocator<char>(
+        arena
+    )),
+    m_file(),
+    m_data(m_input_copy.data()),
+    m_size(m_input_copy.size()),
+    m_nodes(xap::core::json::ArenaAllocator<xap::core::json::TapeNode>(arena)),
+    m_root(0U)
+{}
+
+/**
+ *  Construct the object.
+ *
+ *  @param arena
+ *      The arena of the tape (nullptr to allocate from the heap).
+ *  @param file
+ *      The mapped file (shared, strings of the document refer to the
+ *      mapping).
+ */
+TapeDocument::TapeDocument(
+    const std::shared_ptr<xap::core::json::ArenaPrivate> &arena,
+    const std::shared_ptr<xap::core::json::MappedFile> &file
+) :
+    Document(),
+    m_input(),
+    m_input_copy(xap::core::json::ArenaAllocator<char>(arena)),
+    m_file(file),
+    m_data(file->data()),
+    m_size(file->size()),
+    m_nodes(xap::core::json::ArenaAllocator<xap::core::json::TapeNode>(arena)),
+    m_root(0U)
+{}
+
+/**
+ *  Destruct the object.
+ */
+TapeDocument::~TapeDocument() noexcept {
+    //  Do nothing.
+}
+
+//
+//  TapeDocument public methods.
+//
+
+/**
+ *  Get the root node.
+ *
+ *  @return
+ *      The node.
+ */
+xap::core::json::Node TapeDocument::get_root() const noexcept {
+    return this->m_root;
+}
+
+/**
+ *  Get the type of a node.
+ *
+ *  @param node
+ *      The node.
+ *  @return
+ *      The type.
+ */
+xap::core::json::Type TapeDocument::get_type(
+    const xap::core::json::Node node
+) const noexcept {
+    switch (this->m_nodes[node].type) {
+        case xap::core::json::TapeType::false_value:
+        case xap::core::json::TapeType::true_value:
+            return xap::core::json::Type::boolean;
+        case xap::core::json::TapeType::signed_value:
+        case xap::core::json::TapeType::unsigned_value:
+        case xap::core::json::TapeType::real_value:
+            return xap::core::json::Type::numeric;
+        case xap::core::json::TapeType::string_value:
+            return xap::core::json::Type::string;
+        case xap::core::json::TapeType::array_value:
+            return xap::core::json::Type::array;
+        case xap::core::json::TapeType::object_value:
+            return xap::core::json::Type::object;
+        default:
+            return xap::core::json::Type::null;
+    }
+}
+
+/**
+ *  Get the value of a numeric node.
+ *
+ *  @param node
+ *      The node.
+ *  @return
+ *      The value.
+ */
+xap::core::json::Number TapeDocument::get_number(
+    const xap::core::json::Node node
+) const noexcept {
+    const xap::core::json::TapeNode &tape_node = this->m_nodes[node];
+    switch (tape_node.type) {
+        case xap::core::json::TapeType::signed_value:
+            return xap::core::json::Number(tape_node.signed_integer);
+        case xap::core::json::TapeType::unsigned_value:
+            return xap::core::json::Number(tape_node.unsigned_integer);
+        default:
+            return xap::core::json::Number(tape_node.real);
+    }
+}
+
+/**
+ *  Get the value of a boolean node.
+ *
+ *  @param node
+ *      The node.
+ *  @return
+ *      The value.
+ */
+bool TapeDocument::get_boolean(
+    const xap::core::json::Node node
+) const noexcept {
+    return this->m_nodes[node].type == xap::core::json::TapeType::true_value;
+}
+
+/**
+ *  Get the value of a string node.
+ *
+ *  @param node
+ *      The node.
+ *  @param begin
+ *      The pointer to receive the beginning of the string.
+ *  @param end
+ *      The pointer to receive the end of the string.
+ */
+void TapeDocument::get_string(
+    const xap::core::json::Node node,
+    const char **begin,
+    const char **end
+) const noexcept {
+    const xap::core::json::TapeNode &tape_node = this->m_nodes[node];
+    *begin = this->m_data + tape_node.string.offset;
+    *end = *begin + tape_node.string.length;
+}
+
+/**
+ *  Get the count of items of an array node (or members of an object
+ *  node).
+ *
+ *  @param node
+ *      The node.
+ *  @return
+ *      The count.
+ */
+size_t TapeDocument::get_size(
+    const xap::core::json::Node node
+) const {
+    return static_cast<size_t>(this->m_nodes[node].children.count);
+}
+
+/**
+ *  Get an item of an array node.
+ *
+ *  @param node
+ *      The node.
+ *  @param index
+ *      The index of the item (must be less than the size).
+ *  @return
+ *      The node of the item.
+ */
+xap::core::json::Node TapeDocument::get_element(
+    const xap::core::json::Node node,
+    const size_t index
+) const {
+    return static_cast<xap::core::json::Node>(
+        this->m_nodes[node].children.first
+    ) + index;
+}
+
+/**
+ *  Get the values of numeric items of an array node (in bulk).
+ *
+ *  @param node
+ *      The node.
+ *  @param first
+ *      The index of the first item.
+ *  @param count
+ *      The count of items (first + count must not exceed the size).
+ *  @param out
+ *      The buffer to receive the values (at least count items).
+ *  @return
+ *      The count of leading items read (less than count if an item is not
+ *      numeric).
+ */
+size_t TapeDocument::get_numbers(
+    const xap::core::json::Node node,
+    const size_t first,
+    const size_t count,
+    xap::core::json::Number *out
+) const {
+    //  The items are contiguous on the tape (the numbers are constructed in
+    //  place rather than copied from temporaries).
+    const xap::core::json::TapeNode *items =
+        &(this->m_nodes[this->m_nodes[node].children.first + first]);
+    for (size_t i = 0U; i < count; ++i) {
+        const xap::core::json::TapeNode &item = items[i];
+        switch (item.type) {
+            case xap::core::json::TapeType::signed_value:
+                new (out + i) xap::core::json::Number(item.signed_integer);
+                break;
+            case xap::core::json::TapeType::unsigned_value:
+                new (out + i) xap::core::json::Number(item.unsigned_integer);
+                break;
+            case xap::core::json::TapeType::real_value:
+                new (out + i) xap::core::json::Number(item.real);
+                break;
+            default:
+                return i;
+        }
+    }
+    return count;
+}
+
+/**
+ *  Find a member of an object node.
+ *
+ *  @param node
+ *      The node.
+ *  @param key
+ *      The key.
+ *  @param key_len
+ *      The length of the key.
+ *  @param member
+ *      The pointer to receive the node of the member.
+ *  @return
+ *      True if found.
+ */
+bool TapeDocument::find_member(
+    const xap::core::json::Node node,
+    const char *key,
+    const size_t key_len,
+    xap::core::json::Node *member
+) const {
+    if (
+        !this->get_key_table() &&
+        this->m_nodes[node].children.count <
+            xap::core::json::MEMBER_INDEX_MIN_COUNT
+    ) {
+        return this->find_member_by_id(node, key, key_len, 0U, member);
+    }
+    return TapeDocument::find_member_hashed(
+        node,
+        key,
+        key_len,
+        xap::core::json::Document::hash_key(key, key_len),
+        member
+    );
+}
+
+/**
+ *  Find a member of an object node (with the hash of the key).
+ *
+ *  @param node
+ *      The node.
+ *  @param key
+ *      The key.
+ *  @param key_len
+ *      The length of the key.
+ *  @param key_hash
+ *      The hash of the key (see Document::hash_key()).
+ *  @param member
+ *      The pointer to receive the node of the member.
+ *  @return
+ *      True if found.
+ */
+bool TapeDocument::find_member_hashed(
+    const xap::core::json::Node node,
+    const char *key,
+    const size_t key_len,
+    const uint64_t key_hash,
+    xap::core::json::Node *member
+) const {
+    //  Members of a wide object are looked up by its member index.
+    const size_t count = this->m_nodes[node].children.count;
+    if (count >= xap::core::json::MEMBER_INDEX_MIN_COUNT) {
+        const xap::core::json::MemberIndex *index =
+            this->get_member_index(node, count);
+        if (index) {
+            return index->find(key, key_len, key_hash, member);
+        }
+    }
+
+    //  A key that is not interned (or not in the table at all) can still
+    //  match the members whose keys are not interned.
+    uint32_t key_id = 0U;
+    const std::shared_ptr<xap::core::json::KeyTablePrivate> &keys =
+        this->get_key_table();
+    if (keys) {
+        const xap::core::json::KeyEntry *entry =
+            keys->find(key, key_len, key_hash);
+        if (entry) {
+            key_id = entry->id;
+        }
+    }
+    return this->find_member_by_id(node, key, key_len, key_id, member);
+}
+
+/**
+ *  Visit the members of an object node.
+ *
+ *  @param node
+ *      The node.
+ *  @param handler
+ *      The handler.
+ *  @param context
+ *      The context passed to the handler.
+ *  @return
+ *      False if the handler stopped the visit.
+ */
+bool TapeDocument::foreach_member(
+    const xap::core::json::Node node,
+    const xap::core::json::MemberHandler handler,
+    void *context
+) const {
+    //  The handler may expand other nodes of a lazy document (which grows
+    //  the tape), so no reference to a node is kept across its calls.
+    const size_t first = this->m_nodes[node].children.first;
+    const size_t last = first + this->m_nodes[node].children.count;
+    for (size_t i = first; i < last; ++i) {
+        const xap::core::json::TapeNode &child = this->m_nodes[i];
+        if (!handler(
+            context,
+            this->m_data + child.key_offset,
+            child.key_length,
+            static_cast<xap::core::json::Node>(i)
+        )) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ *  Get the key of a member node (kept by the document).
+ *
+ *  @note
+ *      Keys refer to the input of the document (decoded in place).
+ *  @param member
+ *      The node of the member (found by find_member()).
+ *  @param key
+ *      The pointer to receive the key.
+ *  @param key_len
+ *      The pointer to receive the length of the key.
+ *  @return
+ *      Always true.
+ */
+bool TapeDocument::get_member_key(
+    const xap::core::json::Node member,
+    const char **key,
+    size_t *key_len
+) const noexcept {
+    const xap::core::json::TapeNode &tape_node = this->m_nodes[member];
+    *key = this->m_data + tape_node.key_offset;
+    *key_len = tape_node.key_length;
+    return true;
+}
+
+/**
+ *  Copy a node (and its descendants) into a Json::Value.
+ *
+ *  @param node
+ *      The node.
+ *  @return
+ *      The value.
+ */
+Json::Value TapeDocument::to_value(const xap::core::json::Node node) const {
+    return this->copy_value(node);
+}
+
+/**
+ *  Set the key table of the document (the keys of the members decoded
+ *  already are interned).
+ *
+ *  @throw std::bad_alloc
+ *      Raised if memory allocation was failed.
+ *  @param keys
+ *      The key table (nullptr if the keys are not interned).
+ */
+void TapeDocument::set_key_table(
+    const std::shared_ptr<xap::core::json::KeyTablePrivate> &keys
+) {
+    //  The IDs of another table are meaningless.
+    if (this->get_key_table()) {
+        for (xap::core::json::TapeNode &tape_node : this->m_nodes) {
+            tape_node.key_id = 0U;
+        }
+    }
+    xap::core::json::Document::set_key_table(keys);
+    if (!keys) {
+        return;
+    }
+
+    for (size_t i = 0U; i < this->m_nodes.size(); ++i) {
+        const xap::core::json::TapeNode &tape_node = this->m_nodes[i];
+        if (
+            tape_node.type == xap::core::json::TapeType::object_value &&
+            !(tape_node.flags & xap::core::json::TapeFlag::unexpanded)
+        ) {
+            this->intern_keys(
+                tape_node.children.first,
+                tape_node.children.count
+            );
+        }
+    }
+}
+
+//
+//  TapeDocument protected methods.
+//
+
+/**
+ *  Find a member of an object node (whose children are decoded).
+ *
+ *  @param node
+ *      The node.
+ *  @param key
+ *      The key.
+ *  @param key_len
+ *      The length of the key.
+ *  @param key_id
+ *      The ID of the key (0 if the key is not interned).
+ *  @param member
+ *      The pointer to receive the node of the member.
+ *  @return
+ *      True if found.
+ */
+bool TapeDocument::find_member_by_id(
+    const xap::core::json::Node node,
+    const char *key,
+    const size_t key_len,
+    const uint32_t key_id,
+    xap::core::json::Node *member
+) const noexcept {
+    const xap::core::json::TapeNode &tape_node = this->m_nodes[node];
+    const char *input = this->m_data;
+
+    //  Scan backward so that the last one of duplicate keys wins. Interned
+    //  keys are compared by their IDs.
+    size_t cursor = static_cast<size_t>(tape_node.children.first) +
+                    static_cast<size_t>(tape_node.children.count);
+    while (cursor != static_cast<size_t>(tape_node.children.first)) {
+        --cursor;
+        const xap::core::json::TapeNode &child = this->m_nodes[cursor];
+        if (
+            child.key_id != 0U ?
+                child.key_id == key_id :
+                (
+                    static_cast<size_t>(child.key_length) == key_len &&
+                    memcmp(input + child.key_offset, key, key_len) == 0
+                )
+        ) {
+            *member = static_cast<xap::core::json::Node>(cursor);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ *  Add the members of an object node (whose children are decoded) to its
+ *  member index.
+ *
+ *  @param node
+ *      The node.
+ *  @param index
+ *      The index.
+ */
+void TapeDocument::index_members(
+    const xap::core::json::Node node,
+    xap::core::json::MemberIndex *index
+) const noexcept {
+    const xap::core::json::TapeNode &tape_node = this->m_nodes[node];
+    const size_t first = tape_node.children.first;
+    for (size_t i = first; i < first + tape_node.children.count; ++i) {
+        const xap::core::json::TapeNode &child = this->m_nodes[i];
+        const char *key = this->m_data + child.key_offset;
+        index->insert(
+            key,
+            child.key_length,
+            xap::core::json::Document::hash_key(key, child.key_length),
+            static_cast<xap::core::json::Node>(i)
+        );
+    }
+}
+
+/**
+ *  Intern the keys of object members on the tape.
+ *
+ *  @throw std::bad_alloc
+ *      Raised if memory allocation was failed.
+ *  @param first
+ *      The index of the first member.
+ *  @param count
+ *      The count of members.
+ */
+void TapeDocument::intern_keys(const size_t first, const size_t count) {
+    xap::core::json::KeyTablePrivate *keys = this->get_key_table().get();
+    for (size_t i = first; i < first + count; ++i) {
+        xap::core::json::TapeNode &child = this->m_nodes[i];
+        const char *key = this->m_data + child.key_offset;
+        const xap::core::json::KeyEntry *entry = keys->intern(
+            key,
+            child.key_length,
+            xap::core::json::Document::hash_key(key, child.key_length)
+        );
+        child.key_id = (entry ? entry->id : 0U);
+    }
+}
+
+/**
+ *  Copy a node (and its descendants, which must be decoded) into a
+ *  Json::Value.
+ *
+ *  @param node
+ *      The node.
+ *  @return
+ *      The value.
+ */
+Json::Value TapeDocument::copy_value(const xap::core::json::Node node) const {
+    const xap::core::json::TapeNode &tape_node = this->m_nodes[node];
+    switch (tape_node.type) {
+        case xap::core::json::TapeType::false_value:
+            return Json::Value(false);
+        case xap::core::json::TapeType::true_value:
+            return Json::Value(true);
+        case xap::core::json::TapeType::signed_value:
+        case xap::core::json::TapeType::unsigned_value:
+        case xap::core::json::TapeType::real_value:
+            return this->get_number(node).to_value();
+        case xap::core::json::TapeType::string_value: {
+            const char *begin = this->m_data + tape_node.string.offset;
+            return Json::Value(begin, begin + tape_node.string.length);
+        }
+        case xap::core::json::TapeType::array_value: {
+            Json::Value value(Json::arrayValue);
+            value.resize(static_cast<Json::ArrayIndex>(
+                tape_node.children.count
+            ));
+            for (uint32_t i = 0U; i < tape_node.children.count; ++i) {
+                value[static_cast<Json::ArrayIndex>(i)] = this->copy_value(
+                    static_cast<xap::core::json::Node>(
+                        tape_node.children.first + i
+                    )
+                );
+            }
+            return value;
+        }
+        case xap::core::json::TapeType::object_value: {
+            Json::Value value(Json::objectValue);
+            const char *input = this->m_data;
+            for (uint32_t i = 0U; i < tape_node.children.count; ++i) {
+                const uint32_t child = tape_node.children.first + i;
+                const xap::core::json::TapeNode &child_node =
+                    this->m_nodes[child];
+                this->demand_member(
+                    &value,
+                    input + child_node.key_offset,
+                    child_node.key_length
+                ) = this->copy_value(static_cast<xap::core::json::Node>(child));
+            }
+            return value;
+        }
+        default:
+            return Json::Value();
+    }
+}
+
+//
+//  LazyDocument constructor & destructor.
+//
+
+/**
+ *  Construct the object.
+ *
+ *  @param arena
+ *      The arena of the tape (nullptr to allocate from the heap).
+ *  @param input
+ *      The input buffer (moved, strings of the document refer to it).
+ */
+LazyDocument::LazyDocument(
+    const std::shared_ptr<xap::core::json::ArenaPrivate> &arena,
+    std::string &&input
+) :
+    TapeDocument(arena, std::move(input)),
+    m_tokens(xap::core::json::ArenaAllocator<uint32_t>(arena)),
+    m_closes(xap::core::json::ArenaAllocator<uint32_t>(arena))
+{}
+
+/**
+ *  Construct the object.
+ *
+ *  @param arena
+ *      The arena of the tape and the copy of the input (nullptr to allocate
+ *      from the heap).
+ *  @param data
+ *      The input buffer (copied, strings of the document refer to the copy).
+ *  @param datalen
+ *      The length of the input buffer.
+ */
+LazyDocument::LazyDocument(
+    const std::shared_ptr<xap::core::json::ArenaPrivate> &arena,
+    const char *data,
+    const size_t datalen
+) :
+    TapeDocument(arena, data, datalen),
+    m_tokens(xap::core::json::ArenaAllocator<uint32_t>(arena)),
+    m_closes(xap::core::json::ArenaAllocator<uint32_t>(arena))
+{}
+
+/**
+ *  Construct the object.
+ *
+ *  @param arena
+ *      The arena of the tape (nullptr to allocate from the heap).
+ *  @param file
+ *      The mapped file (shared, strings of the document refer to the
+ *      mapping).
+ */
+LazyDocument::LazyDocument(
+    const std::shared_ptr<xap::core::json::ArenaPrivate> &arena,
+    const std::shared_ptr<xap::core::json::MappedFile> &file
+) :
+    TapeDocument(arena, file),
+    m_tokens(xap::core::json::ArenaAllocator<uint32_t>(arena)),
+    m_closes(xap::core::json::ArenaAllocator<uint32_t>(arena))
+{}
+
+/**
+ *  Destruct the object.
+ */
+LazyDocument::~LazyDocument() noexcept {
+    //  Do nothing.
+}
+
+//
+//  LazyDocument public methods.
+//
+
+/**
+ *  Index the (validated) input.
+ *
+ *  @param tokens
+ *      The offsets of the tokens (terminated by the length of the input).
+ *  @param count
+ *      The count of tokens (excluding the terminator).
+ *  @param closes
+ *      The index of the closing token of the container opened by each token
+ *      (only read for opening tokens).
+ *  @param root
+ *      The index of the first token of the root.
+ */
+void LazyDocument::index(
+    const uint32_t *tokens,
+    const size_t count,
+    const uint32_t *closes,
+    const size_t root
+) {
+    this->m_tokens.assign(tokens, tokens + count + 1U);
+    this->m_closes.assign(closes, closes + count);
+
+    xap::core::json::TapeNode node = xap::core::json::TapeNode();
+    this->decode_value(root, &node);
+    this->m_nodes.clear();
+    this->m_nodes.push_back(node);
+    this->m_root = 0U;
+}
+
+/**
+ *  Get the count of items of an array node (or members of an object
+ *  node).
+ *
+ *  @throw std::bad_alloc
+ *      Raised if memory allocation was failed.
+ *  @param node
+ *      The node.
+ *  @return
+ *      The count.
+ */
+size_t LazyDocument::get_size(
+    const xap::core::json::Node node
+) const {
+    const_cast<LazyDocument*>(this)->expand(node);
+    return TapeDocument::get_size(node);
+}
+
+/**
+ *  Get an item of an array node.
+ *
+ *  @throw std::bad_alloc
+ *      Raised if memory allocation was failed.
+ *  @param node
+ *      The node.
+ *  @param index
+ *      The index of the item (must be less than the size).
+ *  @return
+ *      The node of the item.
+ */
+xap::core::json::Node LazyDocument::get_element(
+    const xap::core::json::Node node,
+    const size_t index
+) const {
+    const_cast<LazyDocument*>(this)->expand(node);
+    return TapeDocument::get_element(node, index);
+}
+
+/**
+ *  Get the values of numeric items of an array node (in bulk).
+ *
+ *  @throw std::bad_alloc
+ *      Raised if memory allocation was failed.
+ *  @param node
+ *      The node.
+ *  @param first
+ *      The index of the first item.
+ *  @param count
+ *      The count of items (first + count must not exceed the size).
+ *  @param out
+ *      The buffer to receive the values (at least count items).
+ *  @return
+ *      The count of leading items read (less than count if an item is not
+ *      numeric).
+ */
+size_t LazyDocument::get_numbers(
+    const xap::core::json::Node node,
+    const size_t first,
+    const size_t count,
+    xap::core::json::Number *out
+) const {
+    const_cast<LazyDocument*>(this)->expand(node);
+    return TapeDocument::get_numbers(node, first, count, out);
+}
+
+/**
+ *  Find a member of an object node.
+ *
+ *  @throw std::bad_alloc
+ *      Raised if memory allocation was failed.
+ *  @param node
+ *      The node.
+ *  @param key
+ *      The key.
+ *  @param key_len
+ *      The length of the key.
+ *  @param member
+ *      The pointer to receive the node of the member.
+ *  @return
+ *      True if found.
+ */
+bool LazyDocument::find_member(
+    const xap::core::json::Node node,
+    const char *key,
+    const size_t key_len,
+    xap::core::json::Node *member
+) const {
+    const_cast<LazyDocument*>(this)->expand(node);
+    return TapeDocument::find_member(node, key, key_len, member);
+}
+
+/**
+ *  Find a member of an object node (with the hash of the key).
+ *
+ *  @throw std::bad_alloc
+ *      Raised if memory allocation was failed.
+ *  @param node
+ *      The node.
+ *  @param key
+ *      The key.
+ *  @param key_len
+ *      The length of the key.
+ *  @param key_hash
+ *      The hash of the key (see Document::hash_key()).
+ *  @param member
+ *      The pointer to receive the node of the member.
+ *  @return
+ *      True if found.
+ */
+bool LazyDocument::find_member_hashed(
+    const xap::core::json::Node node,
+    const char *key,
+    const size_t key_len,
+    const uint64_t key_hash,
+    xap::core::json::Node *member
+) const {
+    const_cast<LazyDocument*>(this)->expand(node);
+    return TapeDocument::find_member_hashed(
+        node,
+        key,
+        key_len,
+        key_hash,
+        member
+    );
+}
+
+/**
+ *  Visit the members of an object node.
+ *
+ *  @param node
+ *      The node.
+ *  @param handler
+ *      The handler.
+ *  @param context
+ *      The context passed to the handler.
+ *  @return
+ *      False if the handler stopped the visit.
+ */
+bool LazyDocument::foreach_member(
+    const xap::core::json::Node node,
+    const xap::core::json::MemberHandler handler,
+    void *context
+) const {
+    const_cast<LazyDocument*>(this)->expand(node);
+    return TapeDocument::foreach_member(node, handler, context);
+}
+
+/**
+ *  Copy a node (and its descendants) into a Json::Value.
+ *
+ *  @param node
+ *      The node.
+ *  @return
+ *      The value.
+ */
+Json::Value LazyDocument::to_value(const xap::core::json::Node node) const {
+    //  Decode the whole subtree first (iteratively, the nesting depth was
+    //  limited by the parser anyway).
+    LazyDocument *self = const_cast<LazyDocument*>(this);
+    std::vector<xap::core::json::Node> pending;
+    pending.push_back(node);
+    while (!pending.empty()) {
+        const xap::core::json::Node current = pending.back();
+        pending.pop_back();
+        const uint8_t type = this->m_nodes[current].type;
+        if (
+            type != xap::core::json::TapeType::array_value &&
+            type != xap::core::json::TapeType::object_value
+        ) {
+            continue;
+        }
+        self->expand(current);
+        const xap::core::json::TapeNode &tape_node = this->m_nodes[current];
+        for (uint32_t i = 0U; i < tape_node.children.count; ++i) {
+            pending.push_back(static_cast<xap::core::json::Node>(
+                tape_node.children.first + i
+            ));
+        }
+    }
+
+    return this->copy_value(node);
+}
+
+//
+//  LazyDocument private methods.
+//
+
+/**
+ *  Decode the children of a container (if not decoded yet).
+ *
+ *  @throw std::bad_alloc
+ *      Raised if memory allocation was failed.
+ *  @param node
+ *      The node.
+ */
+void LazyDocument::expand(const xap::core::json::Node node) {
+    if (!(this->m_nodes[node].flags & xap::core::json::TapeFlag::unexpanded)) {
+        return;
+    }
+    const bool is_object = (
+        this->m_nodes[node].type == xap::core::json::TapeType::object_value
+    );
+    const size_t open = this->m_nodes[node].children.first;
+    const size_t close = this->m_closes[open];
+
+    //  Append the children (the tape may be reallocated, the node is looked
+    //  up again after).
+    const size_t first = this->m_nodes.size();
+    size_t index = open + 1U;
+    while (index < close) {
+        xap::core::json::TapeNode child = xap::core::json::TapeNode();
+        if (is_object) {
+            //  Key, closing quote, colon.
+            this->decode_string(
+                index,
+                &(child.key_offset),
+                &(child.key_length)
+            );
+            index += 3U;
+        }
+        index = this->decode_value(index, &child);
+        this->m_nodes.push_back(child);
+
+        //  Skip the comma (or stop at the closing token).
+        ++index;
+    }
+
+    xap::core::json::TapeNode &tape_node = this->m_nodes[node];
+    tape_node.flags = static_cast<uint8_t>(
+        tape_node.flags & ~xap::core::json::TapeFlag::unexpanded
+    );
+    tape_node.children.first = static_cast<uint32_t>(first);
+    tape_node.children.count = static_cast<uint32_t>(
+        this->m_nodes.size() - first
+    );
+    if (is_object && this->get_key_table()) {
+        this->intern_keys(first, this->m_nodes.size() - first);
+    }
+}
+
+/**
+ *  Decode a value (a container is left unexpanded).
+ *
+ *  @param index
+ *      The index of the first token of the value.
+ *  @param node
+ *      The node to receive the value.
+ *  @return
+ *      The index of the token after the value.
+ */
+size_t LazyDocument::decode_value(
+    const size_t index,
+    xap::core::json::TapeNode *node
+) noexcept {
+    const char *token = this->m_data + this->m_tokens[index];
+    switch (*token) {
+        case '{':
+        case '[':
+            //  The children are decoded on demand (the opening token is kept
+            //  in place of the first child).
+            node->type = (
+                *token == '{' ?
+                    xap::core::json::TapeType::object_value :
+                    xap::core::json::TapeType::array_value
+            );
+            node->flags = xap::core::json::TapeFlag::unexpanded;
+            node->children.first = static_cast<uint32_t>(index);
+            node->children.count = 0U;
+            return static_cast<size_t>(this->m_closes[index]) + 1U;
+        case '"':
+            node->type = xap::core::json::TapeType::string_value;
+            this->decode_string(
+                index,
+                &(node->string.offset),
+                &(node->string.length)
+            );
+            return index + 2U;
+        case 't':
+            node->type = xap::core::json::TapeType::true_value;
+            return index + 1U;
+        case 'f':
+            node->type = xap::core::json::TapeType::false_value;
+            return index + 1U;
+        case 'n':
+            node->type = xap::core::json::TapeType::null_value;
+            return index + 1U;
+        default: {
+            //  The number was validated by the parser.
+            const char *error_message = nullptr;
+            xap::core::json::TapeParser::decode_number(
+                token,
+                this->m_data + this->m_size,
+                node,
+                &error_message
+            );
+            return index + 1U;
+        }
+    }
+}
+
+/**
+ *  Decode a string (in place).
+ *
+ *  @param index
+ *      The index of the opening quote.
+ *  @param offset
+ *      The pointer to receive the offset of the decoded string.
+ *  @param length
+ *      The pointer to receive the length of the decoded string.
+ */
+void LazyDocument::decode_string(
+    const size_t index,
+    uint32_t *offset,
+    uint32_t *length
+) noexcept {
+    char *begin = this->m_data + this->m_tokens[index] + 1U;
+    char *end = this->m_data + this->m_tokens[index + 1U];
+    *offset = static_cast<uint32_t>(begin - this->m_data);
+
+    char *read = static_cast<char*>(memchr(
+        begin,
+        '\\',
+        static_cast<size_t>(end - begin)
+    ));
+    if (read == nullptr) {
+        *length = static_cast<uint32_t>(end - begin);
+        return;
+    }
+
+    //  The escape sequences were validated by the parser.
+    const char *error_position = nullptr;
+    const char *error_message = nullptr;
+    char *write = xap::core::json::TapeParser::decode_string(
+        read,
+        end,
+        read,
+        &error_position,
+        &error_message
+    );
+    *length = static_cast<uint32_t>(write - begin);
+}
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
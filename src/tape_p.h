@@ -0,0 +1,520 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+#ifndef XAP_CORE_JSON_TAPE_P_H__
+#define XAP_CORE_JSON_TAPE_P_H__
+
+//
+//  Imports.
+//
+#include "xap/core/json/build.h"
+#include "document_p.h"
+#include "mapped_file_p.h"
+
+#include "json/json.h"
+
+#include <memory>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+namespace xap {
+namespace core {
+namespace json {
+
+//
+//  Declares.
+//
+class TapeParser;
+
+//
+//  Enum.
+//
+enum TapeType: uint8_t {
+    null_value,
+    false_value,
+    true_value,
+    signed_value,
+    unsigned_value,
+    real_value,
+    string_value,
+    array_value,
+    object_value
+};
+
+enum TapeFlag: uint8_t {
+    //  The children of the container are not decoded yet (lazy documents).
+    unexpanded = 0x01U
+};
+
+//
+//  Structures.
+//
+
+/**
+ *  Tape node (24 bytes).
+ *
+ *  @note
+ *      The children of an array (or an object) are stored contiguously on the
+ *      tape, so an array item is found by its index and an object member is
+ *      found by a linear scan over the keys (or by the member index of a
+ *      wide object).
+ *
+ *      Offsets of strings (and keys) are relative to the input buffer owned
+ *      by the document.
+ *
+ *      With a key table, members are compared by the IDs of their keys (the
+ *      ID fills the padding before the value).
+ */
+struct TapeNode {
+    //  Type (xap::core::json::TapeType).
+    uint8_t type;
+
+    //  Flags (xap::core::json::TapeFlag).
+    uint8_t flags;
+    uint8_t reserved[2];
+
+    //  Key of the node (only for members of an object).
+    uint32_t key_offset;
+    uint32_t key_length;
+
+    //  ID of the key in the key table of the document (0 if the key is not
+    //  interned).
+    uint32_t key_id;
+
+    //  Value.
+    union {
+        int64_t signed_integer;
+        uint64_t unsigned_integer;
+        double real;
+        struct {
+            uint32_t offset;
+            uint32_t length;
+        } string;
+        struct {
+            uint32_t first;
+            uint32_t count;
+        } children;
+    };
+};
+
+//
+//  Classes.
+//
+
+/**
+ *  Document backed by a flat node tape (read-only).
+ *
+ *  @note
+ *      Strings are kept in the input buffer owned by the document. Strings
+ *      that contain escape sequences are decoded in place (a decoded string
+ *      is never longer than its escaped form), so no string is allocated
+ *      separately.
+ *
+ *      Like Json::Value, the last member wins if an object has duplicate
+ *      keys.
+ */
+class TapeDocument: public Document {
+public:
+
+    /**
+     *  Construct the object.
+     *
+     *  @param arena
+     *      The arena of the tape (nullptr to allocate from the heap).
+     *  @param input
+     *      The input buffer (moved, strings of the document refer to it).
+     */
+    TapeDocument(
+        const std::shared_ptr<xap::core::json::ArenaPrivate> &arena,
+        std::string &&input
+    );
+
+    /**
+     *  Construct the object.
+     *
+     *  @param arena
+     *      The arena of the tape and the copy of the input (nullptr to
+     *      allocate from the heap).
+     *  @param data
+     *      The input buffer (copied, strings of the document refer to the
+     *      copy).
+     *  @param datalen
+     *      The length of the input buffer.
+     */
+    TapeDocument(
+        const std::shared_ptr<xap::core::json::ArenaPrivate> &arena,
+        const char *data,
+        const size_t datalen
+    );
+
+    /**
+     *  Construct the object.
+     *
+     *  @param arena
+     *      The arena of the tape (nullptr to allocate from the heap).
+     *  @param file
+     *      The mapped file (shared, strings of the document refer to the
+     *      mapping).
+     */
+    TapeDocument(
+        const std::shared_ptr<xap::core::json::ArenaPrivate> &arena,
+        const std::shared_ptr<xap::core::json::MappedFile> &file
+    );
+
+    /**
+     *  Destruct the object.
+     */
+    virtual ~TapeDocument() noexcept;
+
+    //
+    //  Public methods (xap::core::json::Document).
+    //
+    virtual xap::core::json::Node get_root() const noexcept override;
+    virtual xap::core::json::Type get_type(
+        const xap::core::json::Node node
+    ) const noexcept override;
+    virtual xap::core::json::Number get_number(
+        const xap::core::json::Node node
+    ) const noexcept override;
+    virtual bool get_boolean(
+        const xap::core::json::Node node
+    ) const noexcept override;
+    virtual void get_string(
+        const xap::core::json::Node node,
+        const char **begin,
+        const char **end
+    ) const noexcept override;
+    virtual size_t get_size(
+        const xap::core::json::Node node
+    ) const override;
+    virtual xap::core::json::Node get_element(
+        const xap::core::json::Node node,
+        const size_t index
+    ) const override;
+    virtual size_t get_numbers(
+        const xap::core::json::Node node,
+        const size_t first,
+        const size_t count,
+        xap::core::json::Number *out
+    ) const override;
+    virtual bool find_member(
+        const xap::core::json::Node node,
+        const char *key,
+        const size_t key_len,
+        xap::core::json::Node *member
+    ) const override;
+    virtual bool find_member_hashed(
+        const xap::core::json::Node node,
+        const char *key,
+        const size_t key_len,
+        const uint64_t key_hash,
+        xap::core::json::Node *member
+    ) const override;
+    virtual bool foreach_member(
+        const xap::core::json::Node node,
+        const xap::core::json::MemberHandler handler,
+        void *context
+    ) const override;
+    virtual bool get_member_key(
+        const xap::core::json::Node member,
+        const char **key,
+        size_t *key_len
+    ) const noexcept override;
+    virtual Json::Value to_value(
+        const xap::core::json::Node node
+    ) const override;
+    virtual void set_key_table(
+        const std::shared_ptr<xap::core::json::KeyTablePrivate> &keys
+    ) override;
+
+protected:
+
+    //
+    //  Friend classes.
+    //
+    friend class TapeParser;
+
+    //
+    //  Protected methods.
+    //
+
+    /**
+     *  Find a member of an object node (whose children are decoded).
+     *
+     *  @param node
+     *      The node.
+     *  @param key
+     *      The key.
+     *  @param key_len
+     *      The length of the key.
+     *  @param key_id
+     *      The ID of the key (0 if the key is not interned).
+     *  @param member
+     *      The pointer to receive the node of the member.
+     *  @return
+     *      True if found.
+     */
+    bool find_member_by_id(
+        const xap::core::json::Node node,
+        const char *key,
+        const size_t key_len,
+        const uint32_t key_id,
+        xap::core::json::Node *member
+    ) const noexcept;
+
+    /**
+     *  Add the members of an object node (whose children are decoded) to
+     *  its member index.
+     *
+     *  @param node
+     *      The node.
+     *  @param index
+     *      The index.
+     */
+    virtual void index_members(
+        const xap::core::json::Node node,
+        xap::core::json::MemberIndex *index
+    ) const noexcept override;
+
+    /**
+     *  Intern the keys of object members on the tape.
+     *
+     *  @throw std::bad_alloc
+     *      Raised if memory allocation was failed.
+     *  @param first
+     *      The index of the first member.
+     *  @param count
+     *      The count of members.
+     */
+    void intern_keys(const size_t first, const size_t count);
+
+    /**
+     *  Copy a node (and its descendants, which must be decoded) into a
+     *  Json::Value.
+     *
+     *  @param node
+     *      The node.
+     *  @return
+     *      The value.
+     */
+    Json::Value copy_value(const xap::core::json::Node node) const;
+
+    //
+    //  Protected members.
+    //
+    std::string m_input;
+    std::vector<
+        char,
+        xap::core::json::ArenaAllocator<char>
+    > m_input_copy;
+    std::shared_ptr<xap::core::json::MappedFile> m_file;
+    char *m_data;
+    size_t m_size;
+    std::vector<
+        xap::core::json::TapeNode,
+        xap::core::json::ArenaAllocator<xap::core::json::TapeNode>
+    > m_nodes;
+    xap::core::json::Node m_root;
+};
+
+/**
+ *  Document backed by a node tape that is decoded on demand (read-only).
+ *
+ *  @note
+ *      The parser only validates the input, and hands the tokens (found by
+ *      stage 1) and the position of the closing token of each container to
+ *      the document. Only the root is decoded at first. A container is
+ *      expanded (its children are decoded and appended to the tape
+ *      contiguously) when its size, an item or a member of it is first
+ *      looked up. A child container is left unexpanded, and its tokens are
+ *      skipped at once with the position of its closing token.
+ *
+ *      Looking a node up changes the document, so a lazy document must not
+ *      be traversed by more than one thread at the same time.
+ */
+class LazyDocument: public TapeDocument {
+public:
+
+    /**
+     *  Construct the object.
+     *
+     *  @param arena
+     *      The arena of the tape (nullptr to allocate from the heap).
+     *  @param input
+     *      The input buffer (moved, strings of the document refer to it).
+     */
+    LazyDocument(
+        const std::shared_ptr<xap::core::json::ArenaPrivate> &arena,
+        std::string &&input
+    );
+
+    /**
+     *  Construct the object.
+     *
+     *  @param arena
+     *      The arena of the tape and the copy of the input (nullptr to
+     *      allocate from the heap).
+     *  @param data
+     *      The input buffer (copied, strings of the document refer to the
+     *      copy).
+     *  @param datalen
+     *      The length of the input buffer.
+     */
+    LazyDocument(
+        const std::shared_ptr<xap::core::json::ArenaPrivate> &arena,
+        const char *data,
+        const size_t datalen
+    );
+
+    /**
+     *  Construct the object.
+     *
+     *  @param arena
+     *      The arena of the tape (nullptr to allocate from the heap).
+     *  @param file
+     *      The mapped file (shared, strings of the document refer to the
+     *      mapping).
+     */
+    LazyDocument(
+        const std::shared_ptr<xap::core::json::ArenaPrivate> &arena,
+        const std::shared_ptr<xap::core::json::MappedFile> &file
+    );
+
+    /**
+     *  Destruct the object.
+     */
+    virtual ~LazyDocument() noexcept;
+
+    //
+    //  Public methods.
+    //
+
+    /**
+     *  Index the (validated) input.
+     *
+     *  @param tokens
+     *      The offsets of the tokens (terminated by the length of the
+     *      input).
+     *  @param count
+     *      The count of tokens (excluding the terminator).
+     *  @param closes
+     *      The index of the closing token of the container opened by each
+     *      token (only read for opening tokens).
+     *  @param root
+     *      The index of the first token of the root.
+     */
+    void index(
+        const uint32_t *tokens,
+        const size_t count,
+        const uint32_t *closes,
+        const size_t root
+    );
+
+    //
+    //  Public methods (xap::core::json::Document).
+    //
+    virtual size_t get_size(
+        const xap::core::json::Node node
+    ) const override;
+    virtual xap::core::json::Node get_element(
+        const xap::core::json::Node node,
+        const size_t index
+    ) const override;
+    virtual size_t get_numbers(
+        const xap::core::json::Node node,
+        const size_t first,
+        const size_t count,
+        xap::core::json::Number *out
+    ) const override;
+    virtual bool find_member(
+        const xap::core::json::Node node,
+        const char *key,
+        const size_t key_len,
+        xap::core::json::Node *member
+    ) const override;
+    virtual bool find_member_hashed(
+        const xap::core::json::Node node,
+        const char *key,
+        const size_t key_len,
+        const uint64_t key_hash,
+        xap::core::json::Node *member
+    ) const override;
+    virtual bool foreach_member(
+        const xap::core::json::Node node,
+        const xap::core::json::MemberHandler handler,
+        void *context
+    ) const override;
+    virtual Json::Value to_value(
+        const xap::core::json::Node node
+    ) const override;
+
+private:
+
+    //
+    //  Private methods.
+    //
+
+    /**
+     *  Decode the children of a container (if not decoded yet).
+     *
+     *  @throw std::bad_alloc
+     *      Raised if memory allocation was failed.
+     *  @param node
+     *      The node.
+     */
+    void expand(const xap::core::json::Node node);
+
+    /**
+     *  Decode a value (a container is left unexpanded).
+     *
+     *  @param index
+     *      The index of the first token of the value.
+     *  @param node
+     *      The node to receive the value.
+     *  @return
+     *      The index of the token after the value.
+     */
+    size_t decode_value(
+        const size_t index,
+        xap::core::json::TapeNode *node
+    ) noexcept;
+
+    /**
+     *  Decode a string (in place).
+     *
+     *  @param index
+     *      The index of the opening quote.
+     *  @param offset
+     *      The pointer to receive the offset of the decoded string.
+     *  @param length
+     *      The pointer to receive the length of the decoded string.
+     */
+    void decode_string(
+        const size_t index,
+        uint32_t *offset,
+        uint32_t *length
+    ) noexcept;
+
+    //
+    //  Private members.
+    //
+    std::vector<
+        uint32_t,
+        xap::core::json::ArenaAllocator<uint32_t>
+    > m_tokens;
+    std::vector<
+        uint32_t,
+        xap::core::json::ArenaAllocator<uint32_t>
+    > m_closes;
+};
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
+
+#endif  //  #ifndef XAP_CORE_JSON_TAPE_P_H__
@@ -0,0 +1,1586 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+//
+//  Imports.
+//
+#include "tape_parser_p.h"
+#include "tape_p.h"
+#include "document_p.h"
+#include "number_p.h"
+
+#include <algorithm>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <string.h>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace xap {
+namespace core {
+namespace json {
+
+//
+//  Constants.
+//
+
+//  Maximum nesting depth (the same as the default of Json::CharReader).
+static const size_t TAPE_DEPTH_LIMIT = 1000U;
+
+//  The (minimum) size of the input for each worker of a parallel build.
+static const size_t TAPE_PARALLEL_MIN_SIZE = 131072U;
+
+//
+//  Private functions.
+//
+
+/**
+ *  Check whether a character is a JSON whitespace.
+ *
+ *  @param ch
+ *      The character.
+ *  @return
+ *      True if so.
+ */
+static inline bool is_whitespace(const char ch) noexcept {
+    return ch == ' ' || ch == '\n' || ch == '\r' || ch == '\t';
+}
+
+/**
+ *  Check whether a character is a decimal digit.
+ *
+ *  @param ch
+ *      The character.
+ *  @return
+ *      True if so.
+ */
+static inline bool is_digit(const char ch) noexcept {
+    return ch >= '0' && ch <= '9';
+}
+
+/**
+ *  Check whether a character terminates a number (or a literal).
+ *
+ *  @param ch
+ *      The character.
+ *  @return
+ *      True if so.
+ */
+static inline bool is_token_end(const char ch) noexcept {
+    switch (ch) {
+        case ' ':
+        case '\n':
+        case '\r':
+        case '\t':
+        case '{':
+        case '}':
+        case '[':
+        case ']':
+        case ':':
+        case ',':
+        case '"':
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ *  Check whether the input starts with a literal.
+ *
+ *  @param cursor
+ *      The cursor.
+ *  @param end
+ *      The end of the input.
+ *  @param literal
+ *      The literal.
+ *  @param literal_len
+ *      The length of the literal.
+ *  @return
+ *      True if so.
+ */
+static inline bool match_literal(
+    const char *cursor,
+    const char *end,
+    const char *literal,
+    const size_t literal_len
+) noexcept {
+    return static_cast<size_t>(end - cursor) >= literal_len &&
+           memcmp(cursor, literal, literal_len) == 0;
+}
+
+/**
+ *  Decode 4 hexadecimal digits.
+ *
+ *  @param cursor
+ *      The first digit (at least 4 characters must be readable).
+ *  @param value
+ *      The pointer to receive the value.
+ *  @return
+ *      True if succeed.
+ */
+static bool decode_hex4(const char *cursor, uint32_t *value) noexcept {
+    uint32_t result = 0U;
+    for (size_t i = 0U; i < 4U; ++i) {
+        const char ch = cursor[i];
+        result <<= 4U;
+        if (ch >= '0' && ch <= '9') {
+            result |= static_cast<uint32_t>(ch - '0');
+        } else if (ch >= 'a' && ch <= 'f') {
+            result |= static_cast<uint32_t>(ch - 'a' + 10);
+        } else if (ch >= 'A' && ch <= 'F') {
+            result |= static_cast<uint32_t>(ch - 'A' + 10);
+        } else {
+            return false;
+        }
+    }
+    *value = result;
+    return true;
+}
+
+/**
+ *  Encode a code point as UTF-8.
+ *
+ *  @param cursor
+ *      The output position.
+ *  @param code_point
+ *      The code point.
+ *  @return
+ *      The position after the encoded bytes.
+ */
+static char *encode_utf8(char *cursor, const uint32_t code_point) noexcept {
+    if (code_point < 0x80U) {
+        *(cursor++) = static_cast<char>(code_point);
+    } else if (code_point < 0x800U) {
+        *(cursor++) = static_cast<char>(0xC0U | (code_point >> 6U));
+        *(cursor++) = static_cast<char>(0x80U | (code_point & 0x3FU));
+    } else if (code_point < 0x10000U) {
+        *(cursor++) = static_cast<char>(0xE0U | (code_point >> 12U));
+        *(cursor++) = static_cast<char>(0x80U | ((code_point >> 6U) & 0x3FU));
+        *(cursor++) = static_cast<char>(0x80U | (code_point & 0x3FU));
+    } else {
+        *(cursor++) = static_cast<char>(0xF0U | (code_point >> 18U));
+        *(cursor++) = static_cast<char>(0x80U | ((code_point >> 12U) & 0x3FU));
+        *(cursor++) = static_cast<char>(0x80U | ((code_point >> 6U) & 0x3FU));
+        *(cursor++) = static_cast<char>(0x80U | (code_point & 0x3FU));
+    }
+    return cursor;
+}
+
+/**
+ *  Report a bad escape sequence (of decode_string()).
+ *
+ *  @param position
+ *      The position of the escape sequence.
+ *  @param message
+ *      The message.
+ *  @param error_position
+ *      The pointer to receive the position.
+ *  @param error_message
+ *      The pointer to receive the message.
+ *  @return
+ *      Always nullptr.
+ */
+static char *decode_error(
+    const char *position,
+    const char *message,
+    const char **error_position,
+    const char **error_message
+) noexcept {
+    *error_position = position;
+    *error_message = message;
+    return nullptr;
+}
+
+/**
+ *  Report a bad number (of decode_number()).
+ *
+ *  @param message
+ *      The message.
+ *  @param error_message
+ *      The pointer to receive the message.
+ *  @return
+ *      Always nullptr.
+ */
+static const char *number_error(
+    const char *message,
+    const char **error_message
+) noexcept {
+    *error_message = message;
+    return nullptr;
+}
+
+//
+//  TapeParser constructor & destructor.
+//
+
+/**
+ *  Construct the object.
+ */
+TapeParser::TapeParser() :
+    m_begin(nullptr),
+    m_end(nullptr),
+    m_error(nullptr),
+    m_index(nullptr),
+    m_index_begin(nullptr),
+    m_scanner(),
+    m_tape(),
+    m_stack(),
+    m_frames(),
+    m_closes(),
+    m_scratch(),
+    m_lazy(false),
+    m_stream_started(false),
+    m_stream_scanned(0U),
+    m_worker_count(1U),
+    m_depth_base(0U),
+    m_workers(),
+    m_worker_error()
+{}
+
+/**
+ *  Destruct the object.
+ */
+TapeParser::~TapeParser() noexcept {
+    //  Do nothing.
+}
+
+//
+//  TapeParser public methods.
+//
+
+/**
+ *  Parse a JSON document.
+ *
+ *  @param input
+ *      The JSON data (moved into the document).
+ *  @param arena
+ *      The arena of the document (nullptr to allocate from the heap).
+ *  @param error
+ *      The pointer to receive the error message.
+ *  @return
+ *      The document (nullptr if JSON parsing was failed).
+ */
+std::shared_ptr<xap::core::json::TapeDocument> TapeParser::parse(
+    std::string &&input,
+    const std::shared_ptr<xap::core::json::ArenaPrivate> &arena,
+    std::string *error
+) {
+    //  Offsets on the tape are 32-bit.
+    if (input.size() >= static_cast<size_t>(
+        std::numeric_limits<uint32_t>::max()
+    )) {
+        error->assign("Document is too large.");
+        return nullptr;
+    }
+
+    return this->create(
+        arena,
+        error,
+        false,
+        std::move(input)
+    );
+}
+
+/**
+ *  Parse a JSON document.
+ *
+ *  @param data
+ *      The JSON data (copied into the document).
+ *  @param datalen
+ *      The length of JSON data.
+ *  @param arena
+ *      The arena of the document (nullptr to allocate from the heap).
+ *  @param error
+ *      The pointer to receive the error message.
+ *  @return
+ *      The document (nullptr if JSON parsing was failed).
+ */
+std::shared_ptr<xap::core::json::TapeDocument> TapeParser::parse(
+    const char *data,
+    const size_t datalen,
+    const std::shared_ptr<xap::core::json::ArenaPrivate> &arena,
+    std::string *error
+) {
+    //  Offsets on the tape are 32-bit.
+    if (datalen >= static_cast<size_t>(
+        std::numeric_limits<uint32_t>::max()
+    )) {
+        error->assign("Document is too large.");
+        return nullptr;
+    }
+
+    return this->create(
+        arena,
+        error,
+        false,
+        data,
+        datalen
+    );
+}
+
+/**
+ *  Parse a JSON document.
+ *
+ *  @param file
+ *      The mapped file (shared with the document).
+ *  @param arena
+ *      The arena of the document (nullptr to allocate from the heap).
+ *  @param error
+ *      The pointer to receive the error message.
+ *  @return
+ *      The document (nullptr if JSON parsing was failed).
+ */
+std::shared_ptr<xap::core::json::TapeDocument> TapeParser::parse(
+    const std::shared_ptr<xap::core::json::MappedFile> &file,
+    const std::shared_ptr<xap::core::json::ArenaPrivate> &arena,
+    std::string *error
+) {
+    //  Offsets on the tape are 32-bit.
+    if (file->size() >= static_cast<size_t>(
+        std::numeric_limits<uint32_t>::max()
+    )) {
+        error->assign("Document is too large.");
+        return nullptr;
+    }
+
+    return this->create(
+        arena,
+        error,
+        false,
+        file
+    );
+}
+
+/**
+ *  Start parsing a JSON document that arrives in pieces.
+ */
+void TapeParser::reset_stream() noexcept {
+    this->m_stream_started = false;
+    this->m_stream_scanned = 0U;
+}
+
+/**
+ *  Scan the JSON data received so far (stage 1 of parsing).
+ *
+ *  @param input
+ *      The JSON data received so far (the data received before must not be
+ *      changed).
+ *  @param error
+ *      The pointer to receive the error message.
+ *  @return
+ *      False if the data is already known to be invalid.
+ */
+bool TapeParser::feed_stream(const std::string &input, std::string *error) {
+    //  Offsets on the tape are 32-bit.
+    if (input.size() >= static_cast<size_t>(
+        std::numeric_limits<uint32_t>::max()
+    )) {
+        error->assign("Document is too large.");
+        return false;
+    }
+
+    const char *base = input.data();
+    const char *end = base + input.size();
+    if (!this->m_stream_started) {
+        //  Wait until the UTF-8 BOM can be told.
+        if (
+            input.size() < 3U &&
+            input.compare(0U, input.size(), "\xEF\xBB\xBF", input.size()) == 0
+        ) {
+            return true;
+        }
+        this->m_stream_scanned = (
+            match_literal(base, end, "\xEF\xBB\xBF", 3U) ? 3U : 0U
+        );
+        this->m_stream_started = true;
+        this->m_scanner.reset();
+    }
+
+    const char *next;
+    if (!this->m_scanner.feed(
+        base,
+        base + this->m_stream_scanned,
+        end,
+        &next
+    )) {
+        this->m_begin = const_cast<char*>(base);
+        this->m_error = error;
+        return this->set_error(
+            base + this->m_scanner.get_error_offset(),
+            this->m_scanner.get_error_message()
+        );
+    }
+    this->m_stream_scanned = static_cast<size_t>(next - base);
+    return true;
+}
+
+/**
+ *  Parse a JSON document that was fed in pieces.
+ *
+ *  @param input
+ *      The whole JSON data (moved into the document, the data fed before
+ *      must not be changed).
+ *  @param arena
+ *      The arena of the document (nullptr to allocate from the heap).
+ *  @param error
+ *      The pointer to receive the error message.
+ *  @return
+ *      The document (nullptr if JSON parsing was failed).
+ */
+std::shared_ptr<xap::core::json::TapeDocument> TapeParser::finish_stream(
+    std::string &&input,
+    const std::shared_ptr<xap::core::json::ArenaPrivate> &arena,
+    std::string *error
+) {
+    if (!this->m_stream_started) {
+        return this->parse(std::move(input), arena, error);
+    }
+    this->m_stream_started = false;
+
+    //  Offsets on the tape are 32-bit.
+    if (input.size() >= static_cast<size_t>(
+        std::numeric_limits<uint32_t>::max()
+    )) {
+        error->assign("Document is too large.");
+        return nullptr;
+    }
+
+    return this->create(
+        arena,
+        error,
+        true,
+        std::move(input)
+    );
+}
+
+/**
+ *  Set the count of workers that build the tape of a large document whose
+ *  root is an array.
+ *
+ *  @param workers
+ *      The count of workers (including current thread, 1 to build all tapes
+ *      on current thread).
+ */
+void TapeParser::set_workers(const size_t workers) noexcept {
+    this->m_worker_count = std::max<size_t>(workers, 1U);
+}
+
+/**
+ *  Get the count of workers that build the tape of a large document whose
+ *  root is an array.
+ *
+ *  @return
+ *      The count of workers.
+ */
+size_t TapeParser::get_workers() const noexcept {
+    return this->m_worker_count;
+}
+
+/**
+ *  Set whether documents are parsed lazily (see
+ *  xap::core::json::LazyDocument).
+ *
+ *  @param lazy
+ *      True if so.
+ */
+void TapeParser::set_lazy(const bool lazy) noexcept {
+    this->m_lazy = lazy;
+}
+
+/**
+ *  Get whether documents are parsed lazily.
+ *
+ *  @return
+ *      True if so.
+ */
+bool TapeParser::is_lazy() const noexcept {
+    return this->m_lazy;
+}
+
+/**
+ *  Set whether the input is validated as UTF-8 (see
+ *  xap::core::json::Utf8Validator).
+ *
+ *  @param validate
+ *      True if so.
+ */
+void TapeParser::set_utf8_validation(const bool validate) noexcept {
+    this->m_scanner.set_utf8_validation(validate);
+}
+
+/**
+ *  Get whether the input is validated as UTF-8.
+ *
+ *  @return
+ *      True if so.
+ */
+bool TapeParser::get_utf8_validation() const noexcept {
+    return this->m_scanner.get_utf8_validation();
+}
+
+//
+//  TapeParser public static functions.
+//
+
+/**
+ *  Decode the escape sequences of a string.
+ *
+ *  @param read
+ *      The first character to decode (usually the first backslash).
+ *  @param end
+ *      The closing quote.
+ *  @param write
+ *      The output (read to decode in place, the output is never longer than
+ *      the input).
+ *  @param error_position
+ *      The pointer to receive the position of the bad escape sequence.
+ *  @param error_message
+ *      The pointer to receive the error message.
+ *  @return
+ *      The end of the output (nullptr if an escape sequence is bad).
+ */
+char *TapeParser::decode_string(
+    const char *read,
+    const char *end,
+    char *write,
+    const char **error_position,
+    const char **error_message
+) noexcept {
+    while (read != end) {
+        if (*read != '\\') {
+            *(write++) = *(read++);
+            continue;
+        }
+
+        //  Escape sequence (the scanner guarantees that a backslash is
+        //  followed by a character within the string).
+        const char *escape = read++;
+        switch (*(read++)) {
+            case '"':
+                *(write++) = '"';
+                break;
+            case '\\':
+                *(write++) = '\\';
+                break;
+            case '/':
+                *(write++) = '/';
+                break;
+            case 'b':
+                *(write++) = '\b';
+                break;
+            case 'f':
+                *(write++) = '\f';
+                break;
+            case 'n':
+                *(write++) = '\n';
+                break;
+            case 'r':
+                *(write++) = '\r';
+                break;
+            case 't':
+                *(write++) = '\t';
+                break;
+            case 'u': {
+                uint32_t code_point = 0U;
+                if (end - read < 4 || !decode_hex4(read, &code_point)) {
+                    return decode_error(
+                        escape,
+                        "Syntax error: bad unicode escape sequence.",
+                        error_position,
+                        error_message
+                    );
+                }
+                read += 4;
+                if (code_point >= 0xD800U && code_point <= 0xDBFFU) {
+                    //  High surrogate, a low surrogate must follow.
+                    uint32_t low = 0U;
+                    if (
+                        end - read < 6 ||
+                        read[0] != '\\' ||
+                        read[1] != 'u' ||
+                        !decode_hex4(read + 2, &low) ||
+                        low < 0xDC00U ||
+                        low > 0xDFFFU
+                    ) {
+                        return decode_error(
+                            escape,
+                            "Syntax error: bad unicode surrogate pair.",
+                            error_position,
+                            error_message
+                        );
+                    }
+                    read += 6;
+                    code_point = 0x10000U +
+                                 ((code_point - 0xD800U) << 10U) +
+                                 (low - 0xDC00U);
+                } else if (code_point >= 0xDC00U && code_point <= 0xDFFFU) {
+                    return decode_error(
+                        escape,
+                        "Syntax error: bad unicode surrogate pair.",
+                        error_position,
+                        error_message
+                    );
+                }
+                write = encode_utf8(write, code_point);
+                break;
+            }
+            default:
+                return decode_error(
+                    escape,
+                    "Syntax error: bad escape sequence.",
+                    error_position,
+                    error_message
+                );
+        }
+    }
+
+    return write;
+}
+
+/**
+ *  Decode a number.
+ *
+ *  @param begin
+ *      The first character.
+ *  @param end
+ *      The end of the input.
+ *  @param node
+ *      The node to receive the number (nullptr to check the syntax only).
+ *  @param error_message
+ *      The pointer to receive the error message.
+ *  @return
+ *      The end of the number (nullptr if failed).
+ */
+const char *TapeParser::decode_number(
+    const char *begin,
+    const char *end,
+    xap::core::json::TapeNode *node,
+    const char **error_message
+) {
+    const char *current = begin;
+
+    //  Sign.
+    const bool negative = (*current == '-');
+    if (negative) {
+        ++current;
+    }
+
+    //  Integer part.
+    const char *integer_begin = current;
+    if (current == end || !is_digit(*current)) {
+        return number_error("Syntax error: bad number.", error_message);
+    }
+    if (*current == '0') {
+        ++current;
+    } else {
+        current = xap::core::json::NumberDecoder::skip_digits(current, end);
+    }
+    const char *integer_end = current;
+
+    //  Fraction part.
+    const char *fraction_begin = current;
+    const char *fraction_end = current;
+    bool real = false;
+    if (current != end && *current == '.') {
+        ++current;
+        if (current == end || !is_digit(*current)) {
+            return number_error("Syntax error: bad number.", error_message);
+        }
+        fraction_begin = current;
+        current = xap::core::json::NumberDecoder::skip_digits(current, end);
+        fraction_end = current;
+        real = true;
+    }
+
+    //  Exponent part (saturated, far beyond the range of double).
+    int64_t exponent = 0;
+    if (current != end && (*current == 'e' || *current == 'E')) {
+        ++current;
+        bool exponent_negative = false;
+        if (current != end && (*current == '+' || *current == '-')) {
+            exponent_negative = (*current == '-');
+            ++current;
+        }
+        if (current == end || !is_digit(*current)) {
+            return number_error("Syntax error: bad number.", error_message);
+        }
+        while (current != end && is_digit(*current)) {
+            if (exponent < 0x10000000) {
+                exponent = exponent * 10 + (*current - '0');
+            }
+            ++current;
+        }
+        if (exponent_negative) {
+            exponent = -exponent;
+        }
+        real = true;
+    }
+
+    //  The number must be followed by a whitespace or an operator.
+    if (current != end && !is_token_end(*current)) {
+        return number_error("Syntax error: bad number.", error_message);
+    }
+    if (node == nullptr && !real) {
+        return current;
+    }
+
+    //  Integers are stored like Json::Value does (signed unless it only fits
+    //  in an unsigned 64-bit integer).
+    if (!real) {
+        const uint64_t int64_limit = static_cast<uint64_t>(
+            std::numeric_limits<int64_t>::max()
+        );
+        uint64_t integer = 0U;
+        if (xap::core::json::NumberDecoder::parse_digits(
+            integer_begin,
+            integer_end,
+            &integer
+        )) {
+            if (negative) {
+                if (integer <= int64_limit + 1U) {
+                    node->type = xap::core::json::TapeType::signed_value;
+                    node->signed_integer = (
+                        integer == int64_limit + 1U ?
+                            std::numeric_limits<int64_t>::min() :
+                            -static_cast<int64_t>(integer)
+                    );
+                    return current;
+                }
+            } else if (integer <= int64_limit) {
+                node->type = xap::core::json::TapeType::signed_value;
+                node->signed_integer = static_cast<int64_t>(integer);
+                return current;
+            } else {
+                node->type = xap::core::json::TapeType::unsigned_value;
+                node->unsigned_integer = integer;
+                return current;
+            }
+        }
+    }
+
+    //  Real numbers (and integers out of range): keep the first 19
+    //  significant digits, the digits after them only scale the value (and
+    //  make it inexact unless they are all zeros).
+    xap::core::json::DecimalNumber number;
+    number.significand = 0U;
+    number.exponent = exponent - static_cast<int64_t>(
+        fraction_end - fraction_begin
+    );
+    number.negative = negative;
+    number.truncated = false;
+    const char *digit = integer_begin;
+    size_t kept = 0U;
+    while (digit != fraction_end && kept != 19U) {
+        if (digit == integer_end) {
+            digit = fraction_begin;
+            continue;
+        }
+        number.significand = number.significand * 10U +
+                             static_cast<uint64_t>(*(digit++) - '0');
+        if (number.significand != 0U) {
+            ++kept;
+        }
+    }
+    if (digit == integer_end) {
+        digit = fraction_begin;
+    }
+    if (digit != fraction_end) {
+        if (digit < integer_end) {
+            number.exponent += static_cast<int64_t>(integer_end - digit) +
+                               static_cast<int64_t>(
+                                   fraction_end - fraction_begin
+                               );
+        } else {
+            number.exponent += static_cast<int64_t>(fraction_end - digit);
+        }
+        for (; digit != fraction_end; ++digit) {
+            if (*digit != '0' && digit != integer_end) {
+                number.truncated = true;
+                break;
+            }
+        }
+    }
+
+    double value = 0.0;
+    if (!xap::core::json::NumberDecoder::to_double(
+        number,
+        begin,
+        static_cast<size_t>(current - begin),
+        &value
+    )) {
+        return number_error(
+            "Syntax error: number out of range.",
+            error_message
+        );
+    }
+    if (node != nullptr) {
+        node->type = xap::core::json::TapeType::real_value;
+        node->real = value;
+    }
+    return current;
+}
+
+//
+//  TapeParser private methods.
+//
+
+/**
+ *  Create a document (of the type of the parsing mode) and build it.
+ *
+ *  @param arena
+ *      The arena of the document (nullptr to allocate from the heap).
+ *  @param error
+ *      The pointer to receive the error message.
+ *  @param streamed
+ *      Whether the input was fed in pieces.
+ *  @param args
+ *      The input of the document (see the constructors of
+ *      xap::core::json::TapeDocument).
+ *  @return
+ *      The document (nullptr if JSON parsing was failed).
+ */
+template<typename... Args>
+std::shared_ptr<xap::core::json::TapeDocument> TapeParser::create(
+    const std::shared_ptr<xap::core::json::ArenaPrivate> &arena,
+    std::string *error,
+    const bool streamed,
+    Args &&...args
+) {
+    std::shared_ptr<xap::core::json::TapeDocument> document;
+    if (this->m_lazy) {
+        document = xap::core::json::make_document<
+            xap::core::json::LazyDocument
+        >(arena, arena, std::forward<Args>(args)...);
+    } else {
+        document = xap::core::json::make_document<
+            xap::core::json::TapeDocument
+        >(arena, arena, std::forward<Args>(args)...);
+    }
+    if (!this->build(document.get(), error, streamed)) {
+        return nullptr;
+    }
+    return document;
+}
+
+/**
+ *  Build the tape of a document.
+ *
+ *  @param document
+ *      The document (with its input buffer).
+ *  @param error
+ *      The pointer to receive the error message.
+ *  @param streamed
+ *      Whether the input was fed in pieces (with feed_stream()), only the
+ *      rest of it is scanned then.
+ *  @return
+ *      True if succeed.
+ */
+bool TapeParser::build(
+    xap::core::json::TapeDocument *document,
+    std::string *error,
+    const bool streamed
+) {
+    error->clear();
+    this->m_begin = document->m_data;
+    this->m_end = this->m_begin + document->m_size;
+    this->m_error = error;
+    this->m_tape.clear();
+    this->m_stack.clear();
+    this->m_frames.clear();
+
+    //  Skip the UTF-8 BOM.
+    const char *content = this->m_begin;
+    if (match_literal(content, this->m_end, "\xEF\xBB\xBF", 3U)) {
+        content += 3;
+    }
+
+    //  Stage 1: find the tokens (or the ones after the fed pieces).
+    if (!(
+        streamed ?
+            this->m_scanner.finish(
+                this->m_begin,
+                this->m_begin + this->m_stream_scanned,
+                this->m_end
+            ) :
+            this->m_scanner.scan(this->m_begin, content, this->m_end)
+    )) {
+        this->set_error(
+            this->m_begin + this->m_scanner.get_error_offset(),
+            this->m_scanner.get_error_message()
+        );
+        return false;
+    }
+    this->m_index = this->m_scanner.get_indices();
+    this->m_index_begin = this->m_index;
+    this->m_depth_base = 0U;
+
+    //  Stage 2 (lazy): validate the tokens and find the closing tokens, the
+    //  document decodes the nodes itself.
+    if (this->m_lazy) {
+        const size_t count = this->m_scanner.get_index_count();
+        this->m_closes.resize(count);
+        if (!this->parse_value() || !this->parse_trailing()) {
+            return false;
+        }
+        static_cast<xap::core::json::LazyDocument*>(document)->index(
+            this->m_index_begin,
+            count,
+            this->m_closes.data(),
+            0U
+        );
+        return true;
+    }
+
+    //  Stage 2: build the tape (of the items of a large root array with
+    //  workers in parallel if possible).
+    const size_t workers = std::min(
+        this->m_worker_count,
+        static_cast<size_t>(this->m_end - content) / TAPE_PARALLEL_MIN_SIZE
+    );
+    if (
+        workers > 1U &&
+        this->peek_token() != this->m_end &&
+        *(this->peek_token()) == '['
+    ) {
+        const int result = this->build_parallel(document, workers);
+        if (result >= 0) {
+            return result != 0;
+        }
+    }
+    if (!this->parse_value()) {
+        return false;
+    }
+    if (!this->parse_trailing()) {
+        return false;
+    }
+
+    //  The root is the last node on the tape.
+    this->m_tape.push_back(this->m_stack.back());
+    this->m_stack.clear();
+    document->m_nodes.assign(this->m_tape.begin(), this->m_tape.end());
+    document->m_root = static_cast<xap::core::json::Node>(
+        this->m_tape.size() - 1U
+    );
+
+    return true;
+}
+
+/**
+ *  Build the tape of a document whose root is an array, with the items cut
+ *  into ranges that are built by workers in parallel.
+ *
+ *  @param document
+ *      The document (with its input buffer).
+ *  @param workers
+ *      The count of workers (including current thread).
+ *  @return
+ *      1 if succeed, 0 if failed, -1 if the array can't be cut (it must be
+ *      built on current thread then, nothing was changed).
+ */
+int TapeParser::build_parallel(
+    xap::core::json::TapeDocument *document,
+    const size_t workers
+) {
+    //  Find the commas between the items of the root array (from the tokens
+    //  only, the contents of strings are never visited), with roughly the
+    //  same count of tokens between the cuts.
+    uint32_t *indices = this->m_scanner.get_indices();
+    const size_t count = this->m_scanner.get_index_count();
+    uint32_t *open = indices + (this->m_index - indices);
+    uint32_t *close = nullptr;
+    std::vector<uint32_t*> cuts;
+    size_t depth = 0U;
+    for (uint32_t *index = open; index != indices + count; ++index) {
+        const char token = this->m_begin[*index];
+        if (token == '[' || token == '{') {
+            ++depth;
+        } else if (token == ']' || token == '}') {
+            if (--depth == 0U) {
+                close = index;
+                break;
+            }
+        } else if (
+            token == ',' &&
+            depth == 1U &&
+            static_cast<size_t>(index - open) * workers >=
+                (cuts.size() + 1U) * count
+        ) {
+            cuts.push_back(index);
+        }
+    }
+    if (close == nullptr || *(this->m_begin + *close) != ']' || cuts.empty()) {
+        //  Malformed (reported by the sequential build) or too few items.
+        return -1;
+    }
+
+    //  Terminate the ranges (so that each worker stops at the end of its
+    //  range like at the end of the input).
+    const uint32_t terminator = static_cast<uint32_t>(
+        this->m_end - this->m_begin
+    );
+    std::vector<const uint32_t*> ranges;
+    ranges.push_back(open + 1);
+    for (uint32_t *cut : cuts) {
+        *cut = terminator;
+        ranges.push_back(cut + 1);
+    }
+    *close = terminator;
+    while (this->m_workers.size() + 1U < ranges.size()) {
+        this->m_workers.push_back(std::make_unique<TapeParser>());
+    }
+
+    //  Build the ranges (the first one on current thread).
+    std::vector<xap::core::json::TapeParser*> parsers;
+    parsers.push_back(this);
+    for (size_t i = 1U; i < ranges.size(); ++i) {
+        xap::core::json::TapeParser *worker = this->m_workers[i - 1U].get();
+        worker->m_begin = this->m_begin;
+        worker->m_end = this->m_end;
+        worker->m_error = &(worker->m_worker_error);
+        worker->m_index_begin = this->m_index_begin;
+        parsers.push_back(worker);
+    }
+    std::vector<char> results(ranges.size(), 0);
+    auto run = [&parsers, &ranges, &results] (const size_t i) {
+        try {
+            results[i] = parsers[i]->build_items(ranges[i]) ? 1 : 0;
+        } catch (std::exception &error) {
+            parsers[i]->m_error->assign(error.what());
+            results[i] = 0;
+        }
+    };
+    std::vector<std::thread> threads;
+    try {
+        for (size_t i = 1U; i < ranges.size(); ++i) {
+            threads.emplace_back(run, i);
+        }
+    } catch (...) {
+        for (std::thread &thread : threads) {
+            thread.join();
+        }
+        throw;
+    }
+    run(0U);
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    for (size_t i = 0U; i < ranges.size(); ++i) {
+        if (!results[i]) {
+            if (parsers[i] != this) {
+                this->m_error->assign(*(parsers[i]->m_error));
+            }
+            return 0;
+        }
+    }
+
+    //  Only whitespaces (and NUL bytes) can follow the root array.
+    this->m_index = close + 1;
+    if (!this->parse_trailing()) {
+        return 0;
+    }
+
+    //  Stitch the tapes: the descendants built by each worker (with their
+    //  positions moved), then all items (the children of the root), then
+    //  the root.
+    size_t node_count = 1U;
+    size_t item_count = 0U;
+    for (xap::core::json::TapeParser *parser : parsers) {
+        node_count += parser->m_tape.size() + parser->m_stack.size();
+        item_count += parser->m_stack.size();
+    }
+    if (node_count >= static_cast<size_t>(
+        std::numeric_limits<uint32_t>::max()
+    )) {
+        this->m_error->assign("Document is too large.");
+        return 0;
+    }
+    document->m_nodes.clear();
+    document->m_nodes.reserve(node_count);
+    std::vector<uint32_t> shifts;
+    for (xap::core::json::TapeParser *parser : parsers) {
+        const uint32_t shift = static_cast<uint32_t>(
+            document->m_nodes.size()
+        );
+        shifts.push_back(shift);
+        for (const xap::core::json::TapeNode &node : parser->m_tape) {
+            document->m_nodes.push_back(node);
+            if (
+                node.type == xap::core::json::TapeType::array_value ||
+                node.type == xap::core::json::TapeType::object_value
+            ) {
+                document->m_nodes.back().children.first += shift;
+            }
+        }
+    }
+    xap::core::json::TapeNode root = xap::core::json::TapeNode();
+    root.type = xap::core::json::TapeType::array_value;
+    root.children.first = static_cast<uint32_t>(document->m_nodes.size());
+    root.children.count = static_cast<uint32_t>(item_count);
+    for (size_t i = 0U; i < parsers.size(); ++i) {
+        for (const xap::core::json::TapeNode &node : parsers[i]->m_stack) {
+            document->m_nodes.push_back(node);
+            if (
+                node.type == xap::core::json::TapeType::array_value ||
+                node.type == xap::core::json::TapeType::object_value
+            ) {
+                document->m_nodes.back().children.first += shifts[i];
+            }
+        }
+        parsers[i]->m_stack.clear();
+    }
+    document->m_nodes.push_back(root);
+    document->m_root = static_cast<xap::core::json::Node>(
+        document->m_nodes.size() - 1U
+    );
+
+    return 1;
+}
+
+/**
+ *  Build the tape of a range of items of the root array (the descendants
+ *  are put on the tape, the items are left on the scratch stack).
+ *
+ *  @param index
+ *      The first token of the range (the range is terminated like the
+ *      input).
+ *  @return
+ *      True if succeed.
+ */
+bool TapeParser::build_items(const uint32_t *index) {
+    this->m_error->clear();
+    this->m_index = index;
+    this->m_tape.clear();
+    this->m_stack.clear();
+    this->m_frames.clear();
+
+    //  The items are within the root array.
+    this->m_depth_base = 1U;
+    while (true) {
+        if (!this->parse_value()) {
+            return false;
+        }
+        char *cursor = this->next_token();
+        if (cursor == this->m_end) {
+            return true;
+        }
+        if (*cursor != ',') {
+            return this->set_error(
+                cursor,
+                "Syntax error: missing ',' or ']' in array declaration."
+            );
+        }
+    }
+}
+
+/**
+ *  Parse a value (the value is pushed onto the scratch stack, and its
+ *  descendants are put on the tape).
+ *
+ *  @return
+ *      True if succeed.
+ */
+bool TapeParser::parse_value() {
+    uint32_t key_offset = 0U;
+    uint32_t key_length = 0U;
+    bool has_value = false;
+    while (true) {
+        if (!has_value) {
+            //  Parse a value.
+            char *cursor = this->next_token();
+            if (cursor == this->m_end) {
+                this->set_error(
+                    cursor,
+                    "Syntax error: value, object or array expected."
+                );
+                return false;
+            }
+
+            xap::core::json::TapeNode node = xap::core::json::TapeNode();
+            node.key_offset = key_offset;
+            node.key_length = key_length;
+
+            switch (*cursor) {
+                case '{':
+                case '[': {
+                    if (
+                        this->m_frames.size() + this->m_depth_base >=
+                        TAPE_DEPTH_LIMIT
+                    ) {
+                        this->set_error(cursor, "Nesting is too deep.");
+                        return false;
+                    }
+                    const bool is_object = (*cursor == '{');
+                    Frame frame;
+                    frame.stack_begin = this->m_stack.size();
+                    frame.open_index = static_cast<uint32_t>(
+                        this->m_index - this->m_index_begin - 1
+                    );
+                    frame.key_offset = key_offset;
+                    frame.key_length = key_length;
+                    frame.is_object = is_object;
+                    this->m_frames.push_back(frame);
+
+                    const char *peek = this->peek_token();
+                    if (
+                        peek != this->m_end &&
+                        *peek == (is_object ? '}' : ']')
+                    ) {
+                        //  Empty container.
+                        this->next_token();
+                        this->close_container();
+                        has_value = true;
+                    } else if (is_object) {
+                        if (!this->parse_key(&key_offset, &key_length)) {
+                            return false;
+                        }
+                    } else {
+                        key_offset = 0U;
+                        key_length = 0U;
+                    }
+                    continue;
+                }
+                case '"':
+                    node.type = xap::core::json::TapeType::string_value;
+                    if (!this->parse_string(
+                        cursor,
+                        this->next_token(),
+                        &(node.string.offset),
+                        &(node.string.length)
+                    )) {
+                        return false;
+                    }
+                    break;
+                case 't':
+                    if (!this->parse_literal(cursor, "true", 4U)) {
+                        return false;
+                    }
+                    node.type = xap::core::json::TapeType::true_value;
+                    break;
+                case 'f':
+                    if (!this->parse_literal(cursor, "false", 5U)) {
+                        return false;
+                    }
+                    node.type = xap::core::json::TapeType::false_value;
+                    break;
+                case 'n':
+                    if (!this->parse_literal(cursor, "null", 4U)) {
+                        return false;
+                    }
+                    node.type = xap::core::json::TapeType::null_value;
+                    break;
+                default:
+                    if (*cursor != '-' && !is_digit(*cursor)) {
+                        this->set_error(
+                            cursor,
+                            "Syntax error: value, object or array expected."
+                        );
+                        return false;
+                    }
+                    if (!this->parse_number(cursor, &node)) {
+                        return false;
+                    }
+                    break;
+            }
+            if (!this->m_lazy) {
+                this->m_stack.push_back(node);
+            }
+            has_value = true;
+            continue;
+        }
+
+        //  The value is completed.
+        if (this->m_frames.empty()) {
+            break;
+        }
+
+        //  Parse the separator (or the end) of current container.
+        const bool is_object = this->m_frames.back().is_object;
+        char *cursor = this->next_token();
+        if (cursor != this->m_end && *cursor == ',') {
+            if (is_object) {
+                if (!this->parse_key(&key_offset, &key_length)) {
+                    return false;
+                }
+            } else {
+                key_offset = 0U;
+                key_length = 0U;
+            }
+            has_value = false;
+        } else if (
+            cursor != this->m_end &&
+            *cursor == (is_object ? '}' : ']')
+        ) {
+            this->close_container();
+        } else {
+            this->set_error(
+                cursor,
+                is_object ?
+                    "Syntax error: missing ',' or '}' in object declaration." :
+                    "Syntax error: missing ',' or ']' in array declaration."
+            );
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ *  Check the end of the input (only whitespaces and NUL bytes can follow the
+ *  root value).
+ *
+ *  @return
+ *      True if succeed.
+ */
+bool TapeParser::parse_trailing() {
+    const char *cursor = this->next_token();
+    while (
+        cursor != this->m_end &&
+        (is_whitespace(*cursor) || *cursor == '\0')
+    ) {
+        ++cursor;
+    }
+    if (cursor != this->m_end) {
+        return this->set_error(
+            cursor,
+            "Extra non-whitespace after JSON value."
+        );
+    }
+    return true;
+}
+
+/**
+ *  Get the next token (and move to the one after it).
+ *
+ *  @return
+ *      The token (m_end if there is no more token).
+ */
+char *TapeParser::next_token() noexcept {
+    char *token = this->m_begin + *(this->m_index);
+    if (token != this->m_end) {
+        ++(this->m_index);
+    }
+    return token;
+}
+
+/**
+ *  Get the next token (without moving).
+ *
+ *  @return
+ *      The token (m_end if there is no more token).
+ */
+char *TapeParser::peek_token() const noexcept {
+    return this->m_begin + *(this->m_index);
+}
+
+/**
+ *  Parse the key of an object member (and the colon that follows it).
+ *
+ *  @param offset
+ *      The pointer to receive the offset of the key.
+ *  @param length
+ *      The pointer to receive the length of the key.
+ *  @return
+ *      True if succeed.
+ */
+bool TapeParser::parse_key(uint32_t *offset, uint32_t *length) {
+    char *cursor = this->next_token();
+    if (cursor == this->m_end || *cursor != '"') {
+        return this->set_error(
+            cursor,
+            "Syntax error: missing '\"' to begin an object member name."
+        );
+    }
+    if (!this->parse_string(cursor, this->next_token(), offset, length)) {
+        return false;
+    }
+
+    cursor = this->next_token();
+    if (cursor == this->m_end || *cursor != ':') {
+        return this->set_error(
+            cursor,
+            "Syntax error: missing ':' after object member name."
+        );
+    }
+
+    return true;
+}
+
+/**
+ *  Parse a string (in place).
+ *
+ *  @param begin
+ *      The opening quote.
+ *  @param end
+ *      The closing quote.
+ *  @param offset
+ *      The pointer to receive the offset of the decoded string.
+ *  @param length
+ *      The pointer to receive the length of the decoded string (left
+ *      unchanged if the string is only checked).
+ *  @return
+ *      True if succeed.
+ */
+bool TapeParser::parse_string(
+    char *begin,
+    char *end,
+    uint32_t *offset,
+    uint32_t *length
+) {
+    ++begin;
+    *offset = static_cast<uint32_t>(begin - this->m_begin);
+
+    //  Most strings contain no escape sequence, they are left untouched.
+    char *read = static_cast<char *>(memchr(
+        begin,
+        '\\',
+        static_cast<size_t>(end - begin)
+    ));
+    if (read == nullptr) {
+        *length = static_cast<uint32_t>(end - begin);
+        return true;
+    }
+
+    //  Decode the rest of the string in place (or into the scratch buffer if
+    //  the string is only checked, it is decoded when it is visited then).
+    char *write = read;
+    if (this->m_lazy) {
+        this->m_scratch.resize(static_cast<size_t>(end - read));
+        write = &(this->m_scratch[0]);
+    }
+    const char *error_position = nullptr;
+    const char *error_message = nullptr;
+    write = decode_string(read, end, write, &error_position, &error_message);
+    if (write == nullptr) {
+        return this->set_error(error_position, error_message);
+    }
+    if (!this->m_lazy) {
+        *length = static_cast<uint32_t>(write - begin);
+    }
+    return true;
+}
+
+/**
+ *  Parse a literal ("true", "false" or "null").
+ *
+ *  @param cursor
+ *      The first character.
+ *  @param literal
+ *      The literal.
+ *  @param literal_len
+ *      The length of the literal.
+ *  @return
+ *      True if succeed.
+ */
+bool TapeParser::parse_literal(
+    const char *cursor,
+    const char *literal,
+    const size_t literal_len
+) {
+    if (
+        !match_literal(cursor, this->m_end, literal, literal_len) ||
+        (
+            cursor + literal_len != this->m_end &&
+            !is_token_end(cursor[literal_len])
+        )
+    ) {
+        return this->set_error(cursor, "Syntax error: bad literal.");
+    }
+    return true;
+}
+
+/**
+ *  Parse a number.
+ *
+ *  @param begin
+ *      The first character.
+ *  @param node
+ *      The node to receive the number (left unchanged if the number is only
+ *      checked).
+ *  @return
+ *      True if succeed.
+ */
+bool TapeParser::parse_number(
+    const char *begin,
+    xap::core::json::TapeNode *node
+) {
+    const char *error_message = nullptr;
+    if (decode_number(
+        begin,
+        this->m_end,
+        this->m_lazy ? nullptr : node,
+        &error_message
+    ) == nullptr) {
+        return this->set_error(begin, error_message);
+    }
+    return true;
+}
+
+/**
+ *  Close the innermost container.
+ */
+void TapeParser::close_container() {
+    const Frame frame = this->m_frames.back();
+    this->m_frames.pop_back();
+
+    //  Lazy: only the closing token (just taken) is recorded.
+    if (this->m_lazy) {
+        this->m_closes[frame.open_index] = static_cast<uint32_t>(
+            this->m_index - this->m_index_begin - 1
+        );
+        return;
+    }
+
+    //  Move the children from the scratch stack to the tape.
+    xap::core::json::TapeNode node = xap::core::json::TapeNode();
+    node.type = (
+        frame.is_object ?
+            xap::core::json::TapeType::object_value :
+            xap::core::json::TapeType::array_value
+    );
+    node.key_offset = frame.key_offset;
+    node.key_length = frame.key_length;
+    node.children.first = static_cast<uint32_t>(this->m_tape.size());
+    node.children.count = static_cast<uint32_t>(
+        this->m_stack.size() - frame.stack_begin
+    );
+    this->m_tape.insert(
+        this->m_tape.end(),
+        this->m_stack.begin() + frame.stack_begin,
+        this->m_stack.end()
+    );
+    this->m_stack.resize(frame.stack_begin);
+
+    //  The container itself is a child of its parent.
+    this->m_stack.push_back(node);
+}
+
+/**
+ *  Set the error message.
+ *
+ *  @param cursor
+ *      The position of the error.
+ *  @param message
+ *      The message.
+ *  @return
+ *      Always false.
+ */
+bool TapeParser::set_error(const char *cursor, const char *message) {
+    this->m_error->assign("* Offset ");
+    this->m_error->append(std::to_string(cursor - this->m_begin));
+    this->m_error->append("\n  ");
+    this->m_error->append(message);
+    this->m_error->append("\n");
+    return false;
+}
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
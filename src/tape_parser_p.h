@@ -0,0 +1,530 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+#ifndef XAP_CORE_JSON_TAPE_PARSER_P_H__
+#define XAP_CORE_JSON_TAPE_PARSER_P_H__
+
+//
+//  Imports.
+//
+#include "xap/core/json/build.h"
+#include "scanner_p.h"
+#include "tape_p.h"
+
+#include <memory>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+namespace xap {
+namespace core {
+namespace json {
+
+//
+//  Classes.
+//
+
+/**
+ *  Native (tape) parser.
+ *
+ *  @note
+ *      The parser accepts strict RFC 8259 JSON (no comments, no trailing
+ *      commas, no unescaped control characters within strings). A leading
+ *      UTF-8 BOM and trailing NUL bytes are ignored.
+ *
+ *      Parsing runs in two stages. xap::core::json::StructuralScanner finds
+ *      the tokens in bulk first, then the tape is built by visiting the
+ *      tokens only. The tape construction is iterative (the nesting depth is
+ *      limited, but never by the native call stack). The scratch buffers of
+ *      both stages (and the tape under construction) are reused by all
+ *      documents the parser parses, the finished tape is copied into the
+ *      document with a single allocation.
+ *
+ *      With more than one worker, the items of a large root array are cut
+ *      into ranges (at the commas found by stage 1) and the tapes of the
+ *      ranges are built in parallel, then stitched into one tape.
+ *
+ *      In lazy mode, stage 2 only validates the tokens (nothing is put on
+ *      the tape, escaped strings are decoded into a scratch buffer) and
+ *      finds the closing token of each container, the document decodes its
+ *      nodes on demand (see xap::core::json::LazyDocument).
+ */
+class TapeParser {
+public:
+
+    /**
+     *  Construct the object.
+     */
+    TapeParser();
+
+    /**
+     *  Destruct the object.
+     */
+    virtual ~TapeParser() noexcept;
+
+    //
+    //  Public methods.
+    //
+
+    /**
+     *  Parse a JSON document.
+     *
+     *  @param input
+     *      The JSON data (moved into the document).
+     *  @param arena
+     *      The arena of the document (nullptr to allocate from the heap).
+     *  @param error
+     *      The pointer to receive the error message.
+     *  @return
+     *      The document (nullptr if JSON parsing was failed).
+     */
+    std::shared_ptr<xap::core::json::TapeDocument> parse(
+        std::string &&input,
+        const std::shared_ptr<xap::core::json::ArenaPrivate> &arena,
+        std::string *error
+    );
+
+    /**
+     *  Parse a JSON document.
+     *
+     *  @param data
+     *      The JSON data (copied into the document).
+     *  @param datalen
+     *      The length of JSON data.
+     *  @param arena
+     *      The arena of the document (nullptr to allocate from the heap).
+     *  @param error
+     *      The pointer to receive the error message.
+     *  @return
+     *      The document (nullptr if JSON parsing was failed).
+     */
+    std::shared_ptr<xap::core::json::TapeDocument> parse(
+        const char *data,
+        const size_t datalen,
+        const std::shared_ptr<xap::core::json::ArenaPrivate> &arena,
+        std::string *error
+    );
+
+    /**
+     *  Parse a JSON document.
+     *
+     *  @param file
+     *      The mapped file (shared with the document).
+     *  @param arena
+     *      The arena of the document (nullptr to allocate from the heap).
+     *  @param error
+     *      The pointer to receive the error message.
+     *  @return
+     *      The document (nullptr if JSON parsing was failed).
+     */
+    std::shared_ptr<xap::core::json::TapeDocument> parse(
+        const std::shared_ptr<xap::core::json::MappedFile> &file,
+        const std::shared_ptr<xap::core::json::ArenaPrivate> &arena,
+        std::string *error
+    );
+
+    /**
+     *  Start parsing a JSON document that arrives in pieces.
+     *
+     *  @note
+     *      Feed the data received so far with feed_stream() whenever a piece
+     *      arrives, and parse the whole data with finish_stream() at the end.
+     *      The tokens are found (stage 1) while the data arrives, so only
+     *      the tape is built (stage 2) by finish_stream(). Don't parse other
+     *      documents in between.
+     */
+    void reset_stream() noexcept;
+
+    /**
+     *  Scan the JSON data received so far (stage 1 of parsing).
+     *
+     *  @param input
+     *      The JSON data received so far (the data received before must not
+     *      be changed).
+     *  @param error
+     *      The pointer to receive the error message.
+     *  @return
+     *      False if the data is already known to be invalid.
+     */
+    bool feed_stream(const std::string &input, std::string *error);
+
+    /**
+     *  Parse a JSON document that was fed in pieces.
+     *
+     *  @param input
+     *      The whole JSON data (moved into the document, the data fed before
+     *      must not be changed).
+     *  @param arena
+     *      The arena of the document (nullptr to allocate from the heap).
+     *  @param error
+     *      The pointer to receive the error message.
+     *  @return
+     *      The document (nullptr if JSON parsing was failed).
+     */
+    std::shared_ptr<xap::core::json::TapeDocument> finish_stream(
+        std::string &&input,
+        const std::shared_ptr<xap::core::json::ArenaPrivate> &arena,
+        std::string *error
+    );
+
+    /**
+     *  Set the count of workers that build the tape of a large document
+     *  whose root is an array.
+     *
+     *  @param workers
+     *      The count of workers (including current thread, 1 to build all
+     *      tapes on current thread).
+     */
+    void set_workers(const size_t workers) noexcept;
+
+    /**
+     *  Get the count of workers that build the tape of a large document
+     *  whose root is an array.
+     *
+     *  @return
+     *      The count of workers.
+     */
+    size_t get_workers() const noexcept;
+
+    /**
+     *  Set whether documents are parsed lazily (see
+     *  xap::core::json::LazyDocument).
+     *
+     *  @param lazy
+     *      True if so.
+     */
+    void set_lazy(const bool lazy) noexcept;
+
+    /**
+     *  Get whether documents are parsed lazily.
+     *
+     *  @return
+     *      True if so.
+     */
+    bool is_lazy() const noexcept;
+
+    /**
+     *  Set whether the input is validated as UTF-8 (see
+     *  xap::core::json::Utf8Validator).
+     *
+     *  @param validate
+     *      True if so.
+     */
+    void set_utf8_validation(const bool validate) noexcept;
+
+    /**
+     *  Get whether the input is validated as UTF-8.
+     *
+     *  @return
+     *      True if so.
+     */
+    bool get_utf8_validation() const noexcept;
+
+    //
+    //  Public static functions.
+    //
+
+    /**
+     *  Decode the escape sequences of a string.
+     *
+     *  @param read
+     *      The first character to decode (usually the first backslash).
+     *  @param end
+     *      The closing quote.
+     *  @param write
+     *      The output (read to decode in place, the output is never longer
+     *      than the input).
+     *  @param error_position
+     *      The pointer to receive the position of the bad escape sequence.
+     *  @param error_message
+     *      The pointer to receive the error message.
+     *  @return
+     *      The end of the output (nullptr if an escape sequence is bad).
+     */
+    static char *decode_string(
+        const char *read,
+        const char *end,
+        char *write,
+        const char **error_position,
+        const char **error_message
+    ) noexcept;
+
+    /**
+     *  Decode a number.
+     *
+     *  @param begin
+     *      The first character.
+     *  @param end
+     *      The end of the input.
+     *  @param node
+     *      The node to receive the number (nullptr to check the syntax
+     *      only).
+     *  @param error_message
+     *      The pointer to receive the error message.
+     *  @return
+     *      The end of the number (nullptr if failed).
+     */
+    static const char *decode_number(
+        const char *begin,
+        const char *end,
+        xap::core::json::TapeNode *node,
+        const char **error_message
+    );
+
+private:
+
+    //
+    //  Private types.
+    //
+
+    /**
+     *  Open container.
+     */
+    struct Frame {
+        //  Position of the first child on the scratch stack.
+        size_t stack_begin;
+
+        //  Index of the opening token.
+        uint32_t open_index;
+
+        //  Key of the container (only if its parent is an object).
+        uint32_t key_offset;
+        uint32_t key_length;
+
+        //  Whether the container is an object.
+        bool is_object;
+    };
+
+    //
+    //  Private methods.
+    //
+
+    /**
+     *  Create a document (of the type of the parsing mode) and build it.
+     *
+     *  @param arena
+     *      The arena of the document (nullptr to allocate from the heap).
+     *  @param error
+     *      The pointer to receive the error message.
+     *  @param streamed
+     *      Whether the input was fed in pieces.
+     *  @param args
+     *      The input of the document (see the constructors of
+     *      xap::core::json::TapeDocument).
+     *  @return
+     *      The document (nullptr if JSON parsing was failed).
+     */
+    template<typename... Args>
+    std::shared_ptr<xap::core::json::TapeDocument> create(
+        const std::shared_ptr<xap::core::json::ArenaPrivate> &arena,
+        std::string *error,
+        const bool streamed,
+        Args &&...args
+    );
+
+    /**
+     *  Build the tape of a document.
+     *
+     *  @param document
+     *      The document (with its input buffer).
+     *  @param error
+     *      The pointer to receive the error message.
+     *  @param streamed
+     *      Whether the input was fed in pieces (with feed_stream()), only the
+     *      rest of it is scanned then.
+     *  @return
+     *      True if succeed.
+     */
+    bool build(
+        xap::core::json::TapeDocument *document,
+        std::string *error,
+        const bool streamed
+    );
+
+    /**
+     *  Build the tape of a document whose root is an array, with the items
+     *  cut into ranges that are built by workers in parallel.
+     *
+     *  @param document
+     *      The document (with its input buffer).
+     *  @param workers
+     *      The count of workers (including current thread).
+     *  @return
+     *      1 if succeed, 0 if failed, -1 if the array can't be cut (it must
+     *      be built on current thread then, nothing was changed).
+     */
+    int build_parallel(
+        xap::core::json::TapeDocument *document,
+        const size_t workers
+    );
+
+    /**
+     *  Build the tape of a range of items of the root array (the
+     *  descendants are put on the tape, the items are left on the scratch
+     *  stack).
+     *
+     *  @param index
+     *      The first token of the range (the range is terminated like the
+     *      input).
+     *  @return
+     *      True if succeed.
+     */
+    bool build_items(const uint32_t *index);
+
+    /**
+     *  Parse a value (the value is pushed onto the scratch stack, and its
+     *  descendants are put on the tape).
+     *
+     *  @return
+     *      True if succeed.
+     */
+    bool parse_value();
+
+    /**
+     *  Check the end of the input (only whitespaces and NUL bytes can follow
+     *  the root value).
+     *
+     *  @return
+     *      True if succeed.
+     */
+    bool parse_trailing();
+
+    /**
+     *  Get the next token (and move to the one after it).
+     *
+     *  @return
+     *      The token (m_end if there is no more token).
+     */
+    char *next_token() noexcept;
+
+    /**
+     *  Get the next token (without moving).
+     *
+     *  @return
+     *      The token (m_end if there is no more token).
+     */
+    char *peek_token() const noexcept;
+
+    /**
+     *  Parse the key of an object member (and the colon that follows it).
+     *
+     *  @param offset
+     *      The pointer to receive the offset of the key.
+     *  @param length
+     *      The pointer to receive the length of the key.
+     *  @return
+     *      True if succeed.
+     */
+    bool parse_key(uint32_t *offset, uint32_t *length);
+
+    /**
+     *  Parse a string (in place).
+     *
+     *  @param begin
+     *      The opening quote.
+     *  @param end
+     *      The closing quote.
+     *  @param offset
+     *      The pointer to receive the offset of the decoded string.
+     *  @param length
+     *      The pointer to receive the length of the decoded string (left
+     *      unchanged if the string is only checked).
+     *  @return
+     *      True if succeed.
+     */
+    bool parse_string(
+        char *begin,
+        char *end,
+        uint32_t *offset,
+        uint32_t *length
+    );
+
+    /**
+     *  Parse a literal ("true", "false" or "null").
+     *
+     *  @param cursor
+     *      The first character.
+     *  @param literal
+     *      The literal.
+     *  @param literal_len
+     *      The length of the literal.
+     *  @return
+     *      True if succeed.
+     */
+    bool parse_literal(
+        const char *cursor,
+        const char *literal,
+        const size_t literal_len
+    );
+
+    /**
+     *  Parse a number.
+     *
+     *  @param begin
+     *      The first character.
+     *  @param node
+     *      The node to receive the number (left unchanged if the number is
+     *      only checked).
+     *  @return
+     *      True if succeed.
+     */
+    bool parse_number(
+        const char *begin,
+        xap::core::json::TapeNode *node
+    );
+
+    /**
+     *  Close the innermost container.
+     */
+    void close_container();
+
+    /**
+     *  Set the error message.
+     *
+     *  @param cursor
+     *      The position of the error.
+     *  @param message
+     *      The message.
+     *  @return
+     *      Always false.
+     */
+    bool set_error(const char *cursor, const char *message);
+
+    //
+    //  Private members.
+    //
+    char *m_begin;
+    char *m_end;
+    std::string *m_error;
+    const uint32_t *m_index;
+    const uint32_t *m_index_begin;
+    xap::core::json::StructuralScanner m_scanner;
+    std::vector<xap::core::json::TapeNode> m_tape;
+    std::vector<xap::core::json::TapeNode> m_stack;
+    std::vector<Frame> m_frames;
+    std::vector<uint32_t> m_closes;
+    std::string m_scratch;
+    bool m_lazy;
+    bool m_stream_started;
+    size_t m_stream_scanned;
+    size_t m_worker_count;
+    size_t m_depth_base;
+    std::vector<std::unique_ptr<xap::core::json::TapeParser>> m_workers;
+    std::string m_worker_error;
+
+    //
+    //  Private constructor.
+    //
+    TapeParser(const TapeParser &) = delete;
+    TapeParser &operator=(const TapeParser &) = delete;
+};
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
+
+#endif  //  #ifndef XAP_CORE_JSON_TAPE_PARSER_P_H__
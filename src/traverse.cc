@@ -9,16 +9,124 @@
 //
 #include "xap/core/json/traverse.h"
 #include "traverse_p.h"
+#include "base64_p.h"
 #include "xap/core/json/error.h"
+#include "xap/core/json/extract.h"
+#include "xap/core/json/parser.h"
 
 #include "json/json.h"
 
 #include <memory>
+#include <new>
+#include <stddef.h>
+#include <string.h>
+#include <utility>
+#include <vector>
 
 namespace xap {
 namespace core {
 namespace json {
 
+//
+//  Private types.
+//
+
+/**
+ *  Header of the memory of a private traverse object.
+ */
+struct TraverseMemoryHeader {
+    //  The arena (nullptr if the memory was allocated from the heap).
+    std::shared_ptr<xap::core::json::ArenaPrivate> arena;
+};
+
+//
+//  Constants.
+//
+
+//  Count of array items read at once (see
+//  TraversePrivate::try_inner_as_array()).
+static const size_t TRAVERSE_ARRAY_CHUNK_SIZE = 128U;
+
+//  Count of characters of a base64 string decoded at a time when the buffer
+//  is shorter than the decoded data (see
+//  TraversePrivate::try_inner_as_base64()).
+static const size_t TRAVERSE_BASE64_CHUNK_SIZE = 1024U;
+
+//  Size of the memory header (keeps the object aligned).
+static const size_t TRAVERSE_MEMORY_HEADER_SIZE =
+    alignof(max_align_t) * (
+        (sizeof(TraverseMemoryHeader) + alignof(max_align_t) - 1U) /
+        alignof(max_align_t)
+    );
+
+//
+//  Private functions.
+//
+
+/**
+ *  Get the error message of an array item that doesn't fit a type (the
+ *  messages match the accessors of traverse objects).
+ *
+ *  @param type
+ *      The type (not used).
+ *  @return
+ *      The message.
+ */
+static const char *get_item_message(const void *type) noexcept {
+    //  Floating-point types (and clamped int16_t).
+    (void)type;
+    return "Invalid object value.";
+}
+static const char *get_item_message(const int *type) noexcept {
+    (void)type;
+    return "Value should be integer.";
+}
+static const char *get_item_message(const uint *type) noexcept {
+    (void)type;
+    return "Value should be integer.";
+}
+static const char *get_item_message(const int64_t *type) noexcept {
+    (void)type;
+    return "Value should be integer.";
+}
+static const char *get_item_message(const uint64_t *type) noexcept {
+    (void)type;
+    return "Value should be unsigned 64-bit integer.";
+}
+
+/**
+ *  Reset a status before a non-throwing call (so that a status reused
+ *  across calls reports the last call only).
+ *
+ *  @param status
+ *      The status (nullptr if not needed).
+ */
+static inline void reset_status(xap::core::json::Status *status) noexcept {
+    if (status) {
+        status->clear();
+    }
+}
+
+/**
+ *  Get the entry of a field of a binding scan.
+ *
+ *  @param scan
+ *      The scan.
+ *  @param index
+ *      The index of the field.
+ *  @return
+ *      The entry.
+ */
+static const xap::core::json::BindTable::Entry &get_scan_entry(
+    const xap::core::json::BindScan &scan,
+    const size_t index
+) noexcept {
+    if (scan.table) {
+        return scan.table->get_entries()[index];
+    }
+    return scan.fields[index].get_entry();
+}
+
 //
 //  Traverse constructor & destructor.
 //
@@ -40,7 +148,7 @@ Traverse::Traverse(
     const size_t datalen,
     const std::string &path
 ) :
-    m_traverse(std::make_unique<xap::core::json::TraversePrivate>(
+    Traverse(xap::core::json::Parser::get_default().parse(
         data,
         datalen,
         path
@@ -64,8 +172,8 @@ Traverse::Traverse(
     const size_t datalen,
     const std::string &path
 ) :
-    m_traverse(std::make_unique<xap::core::json::TraversePrivate>(
-        reinterpret_cast<const uint8_t *>(data),
+    Traverse(xap::core::json::Parser::get_default().parse(
+        data,
         datalen,
         path
     ))
@@ -85,9 +193,8 @@ Traverse::Traverse(
     std::string json_string,
     const std::string &path
 ) :
-    m_traverse(std::make_unique<xap::core::json::TraversePrivate>(
-        reinterpret_cast<const uint8_t *>(json_string.c_str()),
-        json_string.size(),
+    Traverse(xap::core::json::Parser::get_default().parse(
+        std::move(json_string),
         path
     ))
 {}
@@ -95,15 +202,30 @@ Traverse::Traverse(
 /**
  *  Construct (Copy) the object.
  * 
+ *  @note
+ *      The copy shares the parsed document with the source (O(1)). The
+ *      document is copied only when one of them is modified.
  *  @param src
  *      The source.
  */
 Traverse::Traverse(
     const Traverse &src
 ) :
-    m_traverse(std::make_unique<xap::core::json::TraversePrivate>(
-        *(src.m_traverse)
-    ))
+    m_traverse(xap::core::json::TraversePrivate::create(*(src.m_traverse)))
+{}
+
+/**
+ *  Construct (Move) the object.
+ * 
+ *  @note
+ *      The source can only be assigned or destructed afterwards.
+ *  @param src
+ *      The source.
+ */
+Traverse::Traverse(
+    Traverse &&src
+) noexcept :
+    m_traverse(std::move(src.m_traverse))
 {}
 
 /**
@@ -115,11 +237,35 @@ Traverse::Traverse(
 Traverse::Traverse(
     const TraversePrivate &p_traverse
 ) :
-    m_traverse(std::make_unique<xap::core::json::TraversePrivate>(
-        p_traverse
+    m_traverse(xap::core::json::TraversePrivate::create(p_traverse))
+{}
+
+/**
+ *  Construct the object.
+ * 
+ *  @param p_traverse
+ *      The private traverse object (moved).
+ */
+Traverse::Traverse(
+    TraversePrivate &&p_traverse
+) :
+    m_traverse(xap::core::json::TraversePrivate::create(
+        std::move(p_traverse)
     ))
 {}
 
+/**
+ *  Construct the object.
+ * 
+ *  @param p_traverse
+ *      The private traverse object (ownership transferred).
+ */
+Traverse::Traverse(
+    std::unique_ptr<TraversePrivate> &&p_traverse
+) noexcept :
+    m_traverse(std::move(p_traverse))
+{}
+
 /**
  *  Destruct the object.
  */
@@ -127,6 +273,51 @@ Traverse::~Traverse() noexcept {
     //  Do nothing.
 }
 
+//
+//  Traverse operators.
+//
+
+/**
+ *  Assign (Copy) the object.
+ * 
+ *  @note
+ *      The object shares the parsed document with the source (O(1)).
+ *  @param src
+ *      The source.
+ *  @return
+ *      Self.
+ */
+xap::core::json::Traverse &Traverse::operator=(const Traverse &src) {
+    if (this == &src) {
+        return *this;
+    }
+
+    if (this->m_traverse) {
+        *(this->m_traverse) = *(src.m_traverse);
+    } else {
+        this->m_traverse = xap::core::json::TraversePrivate::create(
+            *(src.m_traverse)
+        );
+    }
+
+    return *this;
+}
+
+/**
+ *  Assign (Move) the object.
+ * 
+ *  @note
+ *      The source can only be assigned or destructed afterwards.
+ *  @param src
+ *      The source.
+ *  @return
+ *      Self.
+ */
+xap::core::json::Traverse &Traverse::operator=(Traverse &&src) noexcept {
+    this->m_traverse = std::move(src.m_traverse);
+    return *this;
+}
+
 //
 //  Traverse public methods.
 //
@@ -138,7 +329,7 @@ Traverse::~Traverse() noexcept {
  *      The path.
  */
 std::string Traverse::get_path() const {
-    return this->m_traverse->m_path;
+    return this->m_traverse->get_path();
 }
 
 
@@ -402,12 +593,39 @@ bool Traverse::is_null() const noexcept {
  *  @return
  *      Traverse object of sub directory.
  */
-xap::core::json::Traverse Traverse::sub(const std::string &name) {
+xap::core::json::Traverse Traverse::sub(const std::string &name) & {
     return xap::core::json::Traverse(
         this->m_traverse->sub(name)
     );
 }
 
+/**
+ *  Go to sub directory (of a temporary object).
+ * 
+ *  @note
+ *      The returned object reuses the storage of this object.
+ *  @throw xap::core::json::Exception
+ *      Raised in the following situations:
+ *
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is null.
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is not an object.
+ *  
+ *          - xap::core::json::ERROR_NOTFIND:
+ *              Sub path is not existed.
+ * 
+ *  @param name
+ *      The name (key) of sub directory.
+ *  @return
+ *      Traverse object of sub directory.
+ */
+xap::core::json::Traverse Traverse::sub(const std::string &name) && {
+    *(this->m_traverse) = this->m_traverse->sub(name);
+    return xap::core::json::Traverse(std::move(this->m_traverse));
+}
+
 /**
 *  Go to sub directory which can be non-existed.
 * 
@@ -460,7 +678,7 @@ xap::core::json::Traverse Traverse::optional_sub(
     const Traverse &default_value
 ) {
     return xap::core::json::Traverse(
-        this->m_traverse->optional_sub(name, default_value.m_traverse->m_inner)
+        this->m_traverse->optional_sub(name, *(default_value.m_traverse))
     );
 }
 
@@ -755,6 +973,152 @@ xap::core::json::Traverse Traverse::optional_sub(
     );
 }
 
+/**
+ *  Go to the value that a JSON pointer refers to.
+ * 
+ *  @note
+ *      The pointer is evaluated in a single pass. The path of the returned
+ *      object (and of the errors) is extended with the unescaped segments.
+ *  @throw xap::core::json::Exception
+ *      Raised in the following situations:
+ *
+ *          - xap::core::json::ERROR_TYPE:
+ *              A value on the way is null.
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              A value on the way is neither an object nor an array.
+ *  
+ *          - xap::core::json::ERROR_NOTFIND:
+ *              A member (or an array item) is not existed.
+ * 
+ *  @param pointer
+ *      The compiled pointer.
+ *  @return
+ *      Traverse object of the value.
+ */
+xap::core::json::Traverse Traverse::at(
+    const xap::core::json::Pointer &pointer
+) & {
+    return xap::core::json::Traverse(this->m_traverse->at(pointer));
+}
+
+/**
+ *  Go to the value that a JSON pointer refers to (from a temporary
+ *  object).
+ * 
+ *  @note
+ *      The returned object reuses the storage of this object. The pointer
+ *      is evaluated in a single pass. The path of the returned object (and
+ *      of the errors) is extended with the unescaped segments.
+ *  @throw xap::core::json::Exception
+ *      Raised in the following situations:
+ *
+ *          - xap::core::json::ERROR_TYPE:
+ *              A value on the way is null.
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              A value on the way is neither an object nor an array.
+ *  
+ *          - xap::core::json::ERROR_NOTFIND:
+ *              A member (or an array item) is not existed.
+ * 
+ *  @param pointer
+ *      The compiled pointer.
+ *  @return
+ *      Traverse object of the value.
+ */
+xap::core::json::Traverse Traverse::at(
+    const xap::core::json::Pointer &pointer
+) && {
+    *(this->m_traverse) = this->m_traverse->at(pointer);
+    return xap::core::json::Traverse(std::move(this->m_traverse));
+}
+
+/**
+ *  Go to the value that a JSON pointer refers to, which can be
+ *  non-existed.
+ * 
+ *  @note
+ *      The method will return a Traverse object with 'null' type if any
+ *      member (or array item) on the way is non-existed or null.
+ *  @throw xap::core::json::Exception
+ *      Raised if a value on the way is neither an object nor an array
+ *      (xap::core::json::ERROR_TYPE).
+ *  @param pointer
+ *      The compiled pointer.
+ *  @return
+ *      Traverse object of the value.
+ */
+xap::core::json::Traverse Traverse::optional_at(
+    const xap::core::json::Pointer &pointer
+) {
+    return xap::core::json::Traverse(this->m_traverse->optional_at(pointer));
+}
+
+/**
+ *  Validate the inner object against a schema.
+ * 
+ *  @note
+ *      The whole document is checked in a single depth-first pass (see
+ *      xap::core::json::Schema).
+ *  @throw xap::core::json::Exception
+ *      Raised in the following situations (the path of the error is the
+ *      path of the first value that failed):
+ *
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is null or is not an object.
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              A field is null (but required) or has another type.
+ *  
+ *          - xap::core::json::ERROR_NOTFIND:
+ *              A required field is not existed.
+ * 
+ *  @param schema
+ *      The schema.
+ *  @return
+ *      Self.
+ */
+xap::core::json::Traverse &Traverse::validate(
+    const xap::core::json::Schema &schema
+) {
+    this->m_traverse->validate(schema);
+    return *this;
+}
+
+/**
+ *  Extract multiple members of the inner object.
+ * 
+ *  @note
+ *      The members of the object are scanned once, and each member that
+ *      matches a field is converted and written to the destination of the
+ *      field. No traverse object is created.
+ *  @throw xap::core::json::Exception
+ *      Raised in the following situations (the path of the error is the
+ *      path of the first member that failed):
+ *
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is null or is not an object.
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              A member is null (but required) or doesn't fit the type of
+ *              its destination.
+ *  
+ *          - xap::core::json::ERROR_NOTFIND:
+ *              A required member is not existed.
+ * 
+ *  @param fields
+ *      The fields (the destinations are partially written if failed).
+ *  @return
+ *      Self.
+ */
+xap::core::json::Traverse &Traverse::extract(
+    std::initializer_list<xap::core::json::ExtractField> fields
+) {
+    this->m_traverse->extract(fields.begin(), fields.size());
+    return *this;
+}
+
 /**
  *  Set a key-value pair within an object.
  * 
@@ -778,7 +1142,7 @@ xap::core::json::Traverse &Traverse::object_set(
     const std::string &key,
     const Traverse &value
 ) {
-    this->m_traverse->object_set(key, value.m_traverse->m_inner);
+    this->m_traverse->object_set(key, value.m_traverse->to_value());
     return *this;
 }
 
@@ -824,9 +1188,8 @@ xap::core::json::Traverse &Traverse::array_foreach(
     std::function<void(xap::core::json::Traverse &)> handler
 ) {
     this->m_traverse->array_foreach(
-        [&] (const xap::core::json::TraversePrivate &item) {
-            xap::core::json::Traverse item_traverse = 
-                xap::core::json::Traverse(item);
+        [&] (xap::core::json::TraversePrivate &item) {
+            xap::core::json::Traverse item_traverse(std::move(item));
             handler(item_traverse);
         }
     );
@@ -854,7 +1217,7 @@ xap::core::json::Traverse &Traverse::array_foreach(
 xap::core::json::Traverse &Traverse::array_push_item(
     const Traverse &value
 ) {
-    this->m_traverse->array_push_item(value.m_traverse->m_inner);
+    this->m_traverse->array_push_item(value.m_traverse->to_value());
 
     return *this;
 }
@@ -879,7 +1242,7 @@ xap::core::json::Traverse &Traverse::array_push_item(
  */
 xap::core::json::Traverse Traverse::array_pop_item() {
     return xap::core::json::Traverse(
-        this->array_pop_item()
+        this->m_traverse->array_pop_item()
     );
 }
 
@@ -1035,811 +1398,2354 @@ bool Traverse::inner_as_boolean() {
  *  @return
  *      The inner.
  */
-std::string Traverse::inner_as_string() {
+std::string Traverse::inner_as_string() & {
     return this->m_traverse->inner_as_string();
 }
 
-//
-//  Traverse public static functions.
-//
-
 /**
- *  Get a 'Traverse' object and its type is 'null'.
+ *  Get the inner (of a temporary object) as string.
+ * 
+ *  @note
+ *      The parsed document is released as soon as the value was read.
+ *  @throw xap::core::json::Exception
+ *      Raised in the following situations:
  *
- *  @param path
- *      The path.
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is null.
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is not a string.
+ * 
  *  @return
- *      The 'Traverse' object.
+ *      The inner.
  */
-xap::core::json::Traverse Traverse::null(const std::string &path) {
-    return xap::core::json::Traverse(
-        xap::core::json::TraversePrivate(Json::Value::null, path)
+std::string Traverse::inner_as_string() && {
+    const std::unique_ptr<xap::core::json::TraversePrivate> p_traverse(
+        std::move(this->m_traverse)
     );
+    return p_traverse->inner_as_string();
 }
 
-//
-//  TraversePrivate constructor & destructor.
-//
-
 /**
- *  Construct the object.
+ *  Get the inner as string (without copying it).
  * 
+ *  @note
+ *      The view refers to the storage of the parsed document, see
+ *      xap::core::json::StringView for its lifetime.
  *  @throw xap::core::json::Exception
- *      Raised if JSON parsing was failed (ERROR_PARAMETER).
- *  @param data
- *      The JSON data.
- *  @param datalen
- *      The length of JSON data.
- *  @param path
- *      The path.
+ *      Raised in the following situations:
+ *
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is null.
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is not a string.
+ * 
+ *  @return
+ *      The inner.
  */
-TraversePrivate::TraversePrivate(
-    const uint8_t *data, 
-    const size_t datalen,
-    const std::string &path
-) :
-    m_inner(),
-    m_path(path),
-    m_type(xap::core::json::Type::null)
-{
-    //  Parse the JSON data.
-    Json::CharReaderBuilder builder;
-    const std::unique_ptr<Json::CharReader> reader(builder.newCharReader());
-    Json::String error;
-    if (!reader->parse(
-        reinterpret_cast<const char*>(data), 
-        reinterpret_cast<const char*>(data) + datalen, 
-        &m_inner, 
-        &error
-    )) {
-        throw xap::core::json::Exception(
-            error.c_str(),
-            xap::core::json::ERROR_PARAMETER,
-            this->m_path.c_str()
-        );
-    }
-
-    //  Prepare type.
-    this->m_type = this->get_inner_type();
+xap::core::json::StringView Traverse::inner_as_string_view() {
+    return this->m_traverse->inner_as_string_view();
 }
 
 /**
- *  Constructh the object.
+ *  Get the items of the inner array as integers (in bulk).
  * 
- *  @param value
- *      The JSON value.
- *  @param path
- *      The path.
- */
-TraversePrivate::TraversePrivate(
-    const Json::Value &value,
-    const std::string &path
-) :
-    m_inner(value),
-    m_path(path),
-    m_type(xap::core::json::Type::null)
-{
-    this->m_type = this->get_inner_type();
-}
-
-/**
- *  Construct (Copy) the object.
- * 
- *  @param src
- *      The source.
- */
-TraversePrivate::TraversePrivate(const TraversePrivate &src) :
-    m_inner(src.m_inner),
-    m_path(src.m_path),
-    m_type(src.m_type)
-{}
-
-/**
- *  Destruct the object.
- */
-TraversePrivate::~TraversePrivate() noexcept {
-    //  Do nothing.
-}
-
-//
-//  TraversePrivate public methods.
-//
-
-/**
- *  Get the path.
+ *  @note
+ *      Only the first n items are converted (all of them if the array is
+ *      shorter).
+ *  @throw xap::core::json::Exception
+ *      Raised in the following situations (the path of the error is the path of
+ *      the first item that failed):
  *
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is null or is not an array.
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              An item is null or is not an integer that fits in int.
+ * 
+ *  @param out
+ *      The buffer to receive the items (at least n items).
+ *  @param n
+ *      The size of the buffer.
  *  @return
- *      The path.
+ *      The length of the array.
  */
-std::string TraversePrivate::get_path() const {
-    return this->m_path;
+size_t Traverse::inner_as_int_array(int *out, const size_t n) {
+    return this->m_traverse->inner_as_array(out, n);
 }
 
 /**
- *  Check the type of inner object.
+ *  Get the items of the inner array as integers (in bulk).
  * 
  *  @throw xap::core::json::Exception
- *      Raised in the following situations:
- * 
+ *      Raised in the following situations (the path of the error is the path of
+ *      the first item that failed):
+ *
  *          - xap::core::json::ERROR_TYPE:
- *              The type is not null.
+ *              The inner is null or is not an array.
  * 
  *          - xap::core::json::ERROR_TYPE:
- *              The type is invalid.
+ *              An item is null or is not an integer that fits in int.
  * 
- *  @param type
- *      The expected type.
  *  @return
- *      Self.
+ *      The items.
  */
-xap::core::json::TraversePrivate &
-TraversePrivate::type_of(const xap::core::json::Type &type) {
-    if (this->m_type == xap::core::json::Type::null) {
-        return *this;
-    }
-
-    if (this->m_type == type) {
-        return *this;
-    } else {
-        throw xap::core::json::Exception(
-            "Invalid object value.",
-            xap::core::json::ERROR_TYPE,
-            this->m_path.c_str()
-        );
-    }
+std::vector<int> Traverse::inner_as_int_array() {
+    std::vector<int> items(
+        this->m_traverse->inner_as_array<int>(nullptr, 0U)
+    );
+    this->m_traverse->inner_as_array(items.data(), items.size());
+    return items;
 }
 
 /**
- *  Get the type of inner object.
+ *  Get the items of the inner array as unsigned integers (in bulk).
+ * 
+ *  @note
+ *      Only the first n items are converted (all of them if the array is
+ *      shorter).
+ *  @throw xap::core::json::Exception
+ *      Raised in the following situations (the path of the error is the path of
+ *      the first item that failed):
+ *
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is null or is not an array.
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              An item is null or is not an integer that fits in uint.
  * 
+ *  @param out
+ *      The buffer to receive the items (at least n items).
+ *  @param n
+ *      The size of the buffer.
  *  @return
- *      The type.
+ *      The length of the array.
  */
-xap::core::json::Type TraversePrivate::type() const noexcept {
-    return this->m_type;
+size_t Traverse::inner_as_uint_array(uint *out, const size_t n) {
+    return this->m_traverse->inner_as_array(out, n);
 }
 
 /**
- *  Assume that the inner object is numeric.
+ *  Get the items of the inner array as unsigned integers (in bulk).
  * 
  *  @throw xap::core::json::Exception
- *      Raised in the following situations:
- * 
+ *      Raised in the following situations (the path of the error is the path of
+ *      the first item that failed):
+ *
  *          - xap::core::json::ERROR_TYPE:
- *              The inner is not null.
+ *              The inner is null or is not an array.
  * 
  *          - xap::core::json::ERROR_TYPE:
- *              The inner is not numeric.
+ *              An item is null or is not an integer that fits in uint.
  * 
  *  @return
- *      Self.
+ *      The items.
  */
-xap::core::json::TraversePrivate &TraversePrivate::numeric() {
-    this->type_of(xap::core::json::Type::numeric);
-    return *this;
+std::vector<uint> Traverse::inner_as_uint_array() {
+    std::vector<uint> items(
+        this->m_traverse->inner_as_array<uint>(nullptr, 0U)
+    );
+    this->m_traverse->inner_as_array(items.data(), items.size());
+    return items;
 }
 
+#if defined(XAPCORE_JSON_INT64)
+
 /**
- *  Assume that the inner object is an integer.
+ *  Get the items of the inner array as signed 64-bit integers (in bulk).
  * 
+ *  @note
+ *      Only the first n items are converted (all of them if the array is
+ *      shorter).
  *  @throw xap::core::json::Exception
- *      Raised in the following situations:
- * 
+ *      Raised in the following situations (the path of the error is the path of
+ *      the first item that failed):
+ *
  *          - xap::core::json::ERROR_TYPE:
- *              The inner is not null.
+ *              The inner is null or is not an array.
  * 
  *          - xap::core::json::ERROR_TYPE:
- *              The inner is not an integer.
+ *              An item is null or is not an integer that fits in int64_t.
  * 
+ *  @param out
+ *      The buffer to receive the items (at least n items).
+ *  @param n
+ *      The size of the buffer.
  *  @return
- *      Self.
+ *      The length of the array.
  */
-xap::core::json::TraversePrivate &TraversePrivate::integer() {
-    if (this->m_type == xap::core::json::Type::null) {
-        return *this;
-    }
-
-    //  Check type.
-    if (!this->m_inner.isInt()) {
-        throw xap::core::json::Exception(
-            "Value should be integer.",
-            xap::core::json::ERROR_TYPE,
-            this->m_path.c_str()
-        );
-    }
-
-    return *this;
+size_t Traverse::inner_as_int64_array(int64_t *out, const size_t n) {
+    return this->m_traverse->inner_as_array(out, n);
 }
 
 /**
- *  Assume that the inner object is an unsigned integer.
+ *  Get the items of the inner array as signed 64-bit integers (in bulk).
  * 
  *  @throw xap::core::json::Exception
- *      Raised in the following situations:
- * 
+ *      Raised in the following situations (the path of the error is the path of
+ *      the first item that failed):
+ *
  *          - xap::core::json::ERROR_TYPE:
- *              The inner is not null.
+ *              The inner is null or is not an array.
  * 
  *          - xap::core::json::ERROR_TYPE:
- *              The inner is not an unsigned integer.
+ *              An item is null or is not an integer that fits in int64_t.
  * 
  *  @return
- *      Self.
+ *      The items.
  */
-xap::core::json::TraversePrivate 
-&TraversePrivate::unsigned_integer() {
-    if (this->m_type == xap::core::json::Type::null) {
-        return *this;
-    }
-
-    //  Check type.
-    if (!this->m_inner.isUInt()) {
-        throw xap::core::json::Exception(
-            "Value should be integer.",
-            xap::core::json::ERROR_TYPE,
-            this->m_path.c_str()
-        );
-    }
-
-    return *this;
+std::vector<int64_t> Traverse::inner_as_int64_array() {
+    std::vector<int64_t> items(
+        this->m_traverse->inner_as_array<int64_t>(nullptr, 0U)
+    );
+    this->m_traverse->inner_as_array(items.data(), items.size());
+    return items;
 }
 
-#if defined(XAPCORE_JSON_INT64)
-
 /**
- *  Assume that the inner object is a 64-bit integer.
+ *  Get the items of the inner array as unsigned 64-bit integers (in bulk).
  * 
+ *  @note
+ *      Only the first n items are converted (all of them if the array is
+ *      shorter).
  *  @throw xap::core::json::Exception
- *      Raised in the following situations:
- * 
+ *      Raised in the following situations (the path of the error is the path of
+ *      the first item that failed):
+ *
  *          - xap::core::json::ERROR_TYPE:
- *              The inner is not null.
+ *              The inner is null or is not an array.
  * 
  *          - xap::core::json::ERROR_TYPE:
- *              The inner is not an 64-bit integer.
+ *              An item is null or is not an integer that fits in uint64_t.
  * 
+ *  @param out
+ *      The buffer to receive the items (at least n items).
+ *  @param n
+ *      The size of the buffer.
  *  @return
- *      Self.
+ *      The length of the array.
  */
-xap::core::json::TraversePrivate &
-TraversePrivate::integer_64() {
-    if (this->m_type == xap::core::json::Type::null) {
-        return *this;
-    }
-
-    //  Check type.
-    if (!this->m_inner.isInt64()) {
-        throw xap::core::json::Exception(
-            "Value should be integer.",
-            xap::core::json::ERROR_TYPE,
-            this->m_path.c_str()
-        );
-    }
-
-    return *this;
+size_t Traverse::inner_as_uint64_array(uint64_t *out, const size_t n) {
+    return this->m_traverse->inner_as_array(out, n);
 }
 
 /**
- *  Assume that the inner object is an unsigned 64-bit integer.
+ *  Get the items of the inner array as unsigned 64-bit integers (in bulk).
  * 
  *  @throw xap::core::json::Exception
- *      Raised in the following situations:
- * 
+ *      Raised in the following situations (the path of the error is the path of
+ *      the first item that failed):
+ *
  *          - xap::core::json::ERROR_TYPE:
- *              The inner is not null.
+ *              The inner is null or is not an array.
  * 
  *          - xap::core::json::ERROR_TYPE:
- *              The inner is not an unsigned 64-bit integer.
+ *              An item is null or is not an integer that fits in uint64_t.
  * 
  *  @return
- *      Self.
+ *      The items.
  */
-xap::core::json::TraversePrivate &
-TraversePrivate::unsigned_integer_64() {
-    if (this->m_type == xap::core::json::Type::null) {
-        return *this;
-    }
-
-    //  Check type.
-    if (!this->m_inner.isUInt64()) {
-        throw xap::core::json::Exception(
-            "Value should be unsigned 64-bit integer.",
-            xap::core::json::ERROR_TYPE,
-            this->m_path.c_str()
-        );
-    }
-
-    return *this;
+std::vector<uint64_t> Traverse::inner_as_uint64_array() {
+    std::vector<uint64_t> items(
+        this->m_traverse->inner_as_array<uint64_t>(nullptr, 0U)
+    );
+    this->m_traverse->inner_as_array(items.data(), items.size());
+    return items;
 }
 
 #endif  //  #if defined(XAPCORE_JSON_INT64)
 
 /**
- *  Assume that the inner object is a boolean.
+ *  Get the items of the inner array as floats (in bulk).
  * 
+ *  @note
+ *      Only the first n items are converted (all of them if the array is
+ *      shorter).
  *  @throw xap::core::json::Exception
- *      Raised in the following situations:
- * 
+ *      Raised in the following situations (the path of the error is the path of
+ *      the first item that failed):
+ *
  *          - xap::core::json::ERROR_TYPE:
- *              The inner is not null.
+ *              The inner is null or is not an array.
  * 
  *          - xap::core::json::ERROR_TYPE:
- *              The inner is not a boolean.
+ *              An item is null or is not numeric.
  * 
+ *  @param out
+ *      The buffer to receive the items (at least n items).
+ *  @param n
+ *      The size of the buffer.
  *  @return
- *      Self.
+ *      The length of the array.
  */
-xap::core::json::TraversePrivate &TraversePrivate::boolean() {
-    //  Check type.
-    this->type_of(xap::core::json::Type::boolean);
-    return *this;
+size_t Traverse::inner_as_float_array(float *out, const size_t n) {
+    return this->m_traverse->inner_as_array(out, n);
 }
 
 /**
- *  Assume that the inner object is a string.
+ *  Get the items of the inner array as floats (in bulk).
  * 
  *  @throw xap::core::json::Exception
- *      Raised in the following situations:
- * 
+ *      Raised in the following situations (the path of the error is the path of
+ *      the first item that failed):
+ *
  *          - xap::core::json::ERROR_TYPE:
- *              The inner is not null.
+ *              The inner is null or is not an array.
  * 
  *          - xap::core::json::ERROR_TYPE:
- *              The inner is not a string.
+ *              An item is null or is not numeric.
  * 
  *  @return
- *      Self.
+ *      The items.
  */
-xap::core::json::TraversePrivate &TraversePrivate::string() {
-    //  Check type.
-    this->type_of(xap::core::json::Type::string);
-    return *this;
+std::vector<float> Traverse::inner_as_float_array() {
+    std::vector<float> items(
+        this->m_traverse->inner_as_array<float>(nullptr, 0U)
+    );
+    this->m_traverse->inner_as_array(items.data(), items.size());
+    return items;
 }
 
 /**
- *  Assume that the inner object is an array.
+ *  Get the items of the inner array as doubles (in bulk).
  * 
+ *  @note
+ *      Only the first n items are converted (all of them if the array is
+ *      shorter).
  *  @throw xap::core::json::Exception
- *      Raised in the following situations:
- * 
+ *      Raised in the following situations (the path of the error is the path of
+ *      the first item that failed):
+ *
  *          - xap::core::json::ERROR_TYPE:
- *              The inner is not null.
+ *              The inner is null or is not an array.
  * 
  *          - xap::core::json::ERROR_TYPE:
- *              The inner is not an array.
+ *              An item is null or is not numeric.
  * 
+ *  @param out
+ *      The buffer to receive the items (at least n items).
+ *  @param n
+ *      The size of the buffer.
  *  @return
- *      Self.
+ *      The length of the array.
  */
-xap::core::json::TraversePrivate &TraversePrivate::array() {
-    //  Check type.
-    this->type_of(xap::core::json::Type::array);
-    return *this;
+size_t Traverse::inner_as_double_array(double *out, const size_t n) {
+    return this->m_traverse->inner_as_array(out, n);
 }
 
 /**
- *  Assume that the inner object is a JSON object.
+ *  Get the items of the inner array as doubles (in bulk).
  * 
  *  @throw xap::core::json::Exception
- *      Raised in the following situations:
- * 
+ *      Raised in the following situations (the path of the error is the path of
+ *      the first item that failed):
+ *
  *          - xap::core::json::ERROR_TYPE:
- *              The inner is not null.
+ *              The inner is null or is not an array.
  * 
  *          - xap::core::json::ERROR_TYPE:
- *              The inner is not an object.
+ *              An item is null or is not numeric.
  * 
  *  @return
- *      Self.
+ *      The items.
  */
-xap::core::json::TraversePrivate &TraversePrivate::object() {
-    //  Check type.
-    this->type_of(xap::core::json::Type::object);
-    return *this;
+std::vector<double> Traverse::inner_as_double_array() {
+    std::vector<double> items(
+        this->m_traverse->inner_as_array<double>(nullptr, 0U)
+    );
+    this->m_traverse->inner_as_array(items.data(), items.size());
+    return items;
 }
 
 /**
- *  Assume that the inner object is not null.
+ *  Get the items of the inner array as 16-bit PCM samples (in bulk).
  * 
+ *  @note
+ *      Only the first n items are converted (all of them if the array is
+ *      shorter). Numbers are clamped to [-32768, 32767] (and truncated toward
+ *      zero).
  *  @throw xap::core::json::Exception
- *      Raised if value is null (xap::core::json::ERROR_TYPE).
+ *      Raised in the following situations (the path of the error is the path of
+ *      the first item that failed):
+ *
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is null or is not an array.
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              An item is null or is not numeric.
+ * 
+ *  @param out
+ *      The buffer to receive the items (at least n items).
+ *  @param n
+ *      The size of the buffer.
  *  @return
- *      Self.
+ *      The length of the array.
  */
-xap::core::json::TraversePrivate &TraversePrivate::not_null() {
-    //  Check type.
-    if (this->m_type == xap::core::json::Type::null) {
-        throw xap::core::json::Exception(
-            "Value shoud not be null.",
-            xap::core::json::ERROR_TYPE,
-            this->m_path.c_str()
-        );
-    }
-
-    return *this;
+size_t Traverse::inner_as_int16_array(int16_t *out, const size_t n) {
+    return this->m_traverse->inner_as_array(out, n);
 }
 
 /**
- *  Check whether the inner object is null.
+ *  Get the items of the inner array as 16-bit PCM samples (in bulk).
+ * 
+ *  @note
+ *      Numbers are clamped to [-32768, 32767] (and truncated toward zero).
+ *  @throw xap::core::json::Exception
+ *      Raised in the following situations (the path of the error is the path of
+ *      the first item that failed):
+ *
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is null or is not an array.
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              An item is null or is not numeric.
  * 
  *  @return
- *      True if so.
+ *      The items.
  */
-bool TraversePrivate::is_null() const noexcept {
-    return this->m_inner.isNull();
+std::vector<int16_t> Traverse::inner_as_int16_array() {
+    std::vector<int16_t> items(
+        this->m_traverse->inner_as_array<int16_t>(nullptr, 0U)
+    );
+    this->m_traverse->inner_as_array(items.data(), items.size());
+    return items;
 }
 
 /**
- *  Go to sub directory.
+ *  Decode the inner base64 string (RFC 4648) into a buffer.
  * 
+ *  @note
+ *      Only the first n bytes are written (all of them if the decoded data is
+ *      shorter), but the whole string is always validated.
  *  @throw xap::core::json::Exception
  *      Raised in the following situations:
  *
  *          - xap::core::json::ERROR_TYPE:
- *              The inner is null.
+ *              The inner is null or is not a string.
  * 
  *          - xap::core::json::ERROR_TYPE:
- *              The inner is not an object.
- *  
- *          - xap::core::json::ERROR_NOTFIND:
- *              Sub path is not existed.
+ *              The inner is not valid base64.
  * 
- *  @param name
- *      The name (key) of sub directory.
+ *  @param out
+ *      The buffer to receive the decoded bytes (at least n bytes).
+ *  @param n
+ *      The size of the buffer.
  *  @return
- *      Traverse object of sub directory.
+ *      The length of the decoded data.
  */
-xap::core::json::TraversePrivate TraversePrivate::sub(
-    const std::string &name
-) {
-    //  Check type.
-    this->not_null().object();
-
-    //  Sub path.
-    std::string sub_path = this->get_sub_path(name);
-
-    //  Check sub item.
-    const char *name_cstr = name.c_str();
-    const size_t name_size = name.size();
-    if (this->m_inner.find(name_cstr, name_cstr + name_size) == nullptr) {
-        throw xap::core::json::Exception(
-            "Sub path is not existed.",
-            xap::core::json::ERROR_NOTFIND,
-            sub_path.c_str()
-        );
-    }
-
-    //  Get sub item.
-    Json::Value sub_inner = this->m_inner[name];
-
-    return xap::core::json::TraversePrivate(
-        sub_inner,
-        sub_path
-    );
+size_t Traverse::inner_as_base64(uint8_t *out, const size_t n) {
+    return this->m_traverse->inner_as_base64(out, n);
 }
 
 /**
- *  Go to sub directory which can be non-existed.
+ *  Decode the inner base64 string (RFC 4648).
  * 
  *  @throw xap::core::json::Exception
  *      Raised in the following situations:
  *
  *          - xap::core::json::ERROR_TYPE:
- *              The inner is null.
+ *              The inner is null or is not a string.
  * 
  *          - xap::core::json::ERROR_TYPE:
- *              The inner is not an object.
+ *              The inner is not valid base64.
  * 
- *  @param name
- *      The name (key) of sub directory.
- *  @param default_value
- *      The default value if the directory doesn't existed.
  *  @return
- *      Traverse object of sub directory.
+ *      The decoded bytes.
  */
-xap::core::json::TraversePrivate TraversePrivate::optional_sub(
-    const std::string &name, 
-    const Json::Value &default_value
-) {
-    //  Check type.
-    this->not_null().object();
-    
-    //  Sub path.
-    std::string sub_path = this->get_sub_path(name);
-
-    //  Get sub item.
-    Json::Value sub_inner;
-    const char *name_cstr = name.c_str();
-    const size_t name_size = name.size();
-    if (this->m_inner.find(name_cstr, name_cstr + name_size) == nullptr) {
-        sub_inner = default_value;
-    } else {
-        sub_inner = m_inner[name];
-    }
-
-    return xap::core::json::TraversePrivate(sub_inner, sub_path);
+std::vector<uint8_t> Traverse::inner_as_base64() {
+    //  Decode once into a buffer of the upper bound of the length.
+    std::vector<uint8_t> bytes(
+        this->m_traverse->inner_as_string_view().size() / 4U * 3U + 2U
+    );
+    bytes.resize(
+        this->m_traverse->inner_as_base64(bytes.data(), bytes.size())
+    );
+    return bytes;
 }
 
+//
+//  Traverse public methods (non-throwing).
+//
+
 /**
- *  Set a key-value pair within an object.
- * 
- *  @throw xap::core::json::Exception
- *      Raised in the following situations:
- *
- *          - xap::core::json::ERROR_TYPE:
- *              The inner is null.
- * 
- *          - xap::core::json::ERROR_TYPE:
- *              The inner is not an object.
- * 
- *  @param key
- *      The key.
- *  @param value
- *      The value.
+ *  Check the type of inner object (without throwing).
+ * 
+ *  @note
+ *      The non-throwing methods report the same errors as their throwing
+ *      counterparts through a xap::core::json::Status object instead of
+ *      raising xap::core::json::Exception, so that failures don't pay
+ *      the cost of stack unwinding (e.g. when validating untrusted
+ *      input).
+ *  @param type
+ *      The expected type.
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
  *  @return
- *      Self.
+ *      False if the type is neither null nor the expected one.
  */
-xap::core::json::TraversePrivate &TraversePrivate::object_set(
-    const std::string &key,
-    const Json::Value &value
+bool Traverse::try_type_of(
+    const xap::core::json::Type &type,
+    xap::core::json::Status *status
 ) {
-    //  Check type.
-    this->not_null().object();
-
-    this->m_inner[key] = value;
-    return *this;
+    reset_status(status);
+    return this->m_traverse->try_type_of(type, status);
 }
 
 /**
- *  Get the length of an array.
- * 
- *  @throw xap::core::json::Exception
- *      Raised in the following situations:
- *
- *          - xap::core::json::ERROR_TYPE:
- *              The inner is null.
- * 
- *          - xap::core::json::ERROR_TYPE:
- *              The inner is not an array.
+ *  Check that the inner object is not null (without throwing).
  * 
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
  *  @return
- *      The length.
+ *      False if the inner is null (xap::core::json::ERROR_TYPE).
  */
-size_t TraversePrivate::array_get_length() {
-    //  Check type.
-    this->not_null().array();
-
-    return static_cast<size_t>(this->m_inner.size());
+bool Traverse::try_not_null(xap::core::json::Status *status) {
+    reset_status(status);
+    return this->m_traverse->try_not_null(status);
 }
 
 /**
- *  Iterate an array.
+ *  Go to sub directory (without throwing).
  * 
- *  @throw xap::core::json::Exception
- *      Raised in the following situations:
+ *  @throw std::bad_alloc
+ *      Raised if memory allocation was failed.
+ *  @param name
+ *      The name (key) of sub directory.
+ *  @param out
+ *      The object to receive the sub directory (can be this object, left
+ *      unchanged if failed).
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
+ *  @return
+ *      False in the following situations:
  *
  *          - xap::core::json::ERROR_TYPE:
  *              The inner is null.
  * 
  *          - xap::core::json::ERROR_TYPE:
- *              The inner is not an array.
- * 
- *  @throw std::exception
- *      Any exception rasied by handler.
- *  @param handler
- *      The callback.
- *  @return
- *      Self.
+ *              The inner is not an object.
+ *  
+ *          - xap::core::json::ERROR_NOTFIND:
+ *              Sub path is not existed.
  */
-xap::core::json::TraversePrivate &TraversePrivate::array_foreach(
-    std::function<void(const TraversePrivate &)> handler
+bool Traverse::try_sub(
+    const std::string &name,
+    xap::core::json::Traverse *out,
+    xap::core::json::Status *status
 ) {
-    //  Check type.
-    this->not_null().array();
-
-    Json::ArrayIndex length = this->m_inner.size();
-    for (Json::ArrayIndex i = 0U; i < this->m_inner.size(); ++i) {
-        handler(xap::core::json::TraversePrivate(
-            this->m_inner[i],
-            this->get_sub_path(static_cast<size_t>(i))
-        ));
+    reset_status(status);
+    if (out->m_traverse) {
+        return this->m_traverse->try_sub(name, out->m_traverse.get(), status);
     }
 
-    return *this;
+    //  The output object was moved (and can only be assigned).
+    std::unique_ptr<xap::core::json::TraversePrivate> result = 
+        xap::core::json::TraversePrivate::create(*(this->m_traverse));
+    if (!this->m_traverse->try_sub(name, result.get(), status)) {
+        return false;
+    }
+    out->m_traverse = std::move(result);
+    return true;
 }
 
 /**
- *  Push an item to an array.
- * 
- *  @throw xap::core::json::Exception
- *      Raised in the following situations:
+ *  Go to the value that a JSON pointer refers to (without throwing).
+ * 
+ *  @throw std::bad_alloc
+ *      Raised if memory allocation was failed.
+ *  @param pointer
+ *      The compiled pointer.
+ *  @param out
+ *      The object to receive the value (can be this object, left
+ *      unchanged if failed).
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
+ *  @return
+ *      False in the following situations:
  *
  *          - xap::core::json::ERROR_TYPE:
- *              The inner is null.
+ *              A value on the way is null.
  * 
  *          - xap::core::json::ERROR_TYPE:
- *              The inner is not an array.
- * 
- *  @param value
- *      The item value.
- *  @return
- *      Self.
+ *              A value on the way is neither an object nor an array.
+ *  
+ *          - xap::core::json::ERROR_NOTFIND:
+ *              A member (or an array item) is not existed.
  */
-xap::core::json::TraversePrivate &TraversePrivate::array_push_item(
-    const Json::Value &value
+bool Traverse::try_at(
+    const xap::core::json::Pointer &pointer,
+    xap::core::json::Traverse *out,
+    xap::core::json::Status *status
 ) {
-    //  Check type.
-    this->not_null().array();
+    reset_status(status);
+    if (out->m_traverse) {
+        return this->m_traverse->try_at(pointer, out->m_traverse.get(), status);
+    }
 
-    this->m_inner.append(value);
-    return *this;
+    //  The output object was moved (and can only be assigned).
+    std::unique_ptr<xap::core::json::TraversePrivate> result = 
+        xap::core::json::TraversePrivate::create(*(this->m_traverse));
+    if (!this->m_traverse->try_at(pointer, result.get(), status)) {
+        return false;
+    }
+    out->m_traverse = std::move(result);
+    return true;
 }
 
 /**
- *  Pop an item from an array.
- * 
- *  @throw xap::core::json::Exception
- *      Raised in the following situations:
- *
- *          - xap::core::json::ERROR_TYPE:
- *              The inner is null.
- * 
- *          - xap::core::json::ERROR_TYPE:
- *              The inner is not an array.
- * 
- *          - xap::core::json::ERROR_OVERFLOW:
- *              The array is empty.
+ *  Validate the inner object against a schema (without throwing).
  * 
+ *  @param schema
+ *      The schema.
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
  *  @return
- *      Traverse object of the popped item.
+ *      False in the situations that Traverse::validate() throws.
  */
-xap::core::json::TraversePrivate TraversePrivate::array_pop_item() {
-    this->not_null().array();
-
-    const Json::ArrayIndex length = this->m_inner.size();
-    if (length == 0U) {
-        throw xap::core::json::Exception(
-            "Array is empty.",
-            xap::core::json::ERROR_OVERFLOW,
-            this->m_path.c_str()
-        );
-    }
+bool Traverse::try_validate(
+    const xap::core::json::Schema &schema,
+    xap::core::json::Status *status
+) {
+    reset_status(status);
+    return this->m_traverse->try_validate(schema, status);
+}
 
-    const Json::ArrayIndex pop_index = length - 1U;
-    const Json::Value pop_item = this->m_inner[pop_index];
-    this->m_inner.resize(pop_index);
-    return xap::core::json::TraversePrivate(
-        pop_item,
-        this->get_sub_path(static_cast<size_t>(pop_index))
+/**
+ *  Extract multiple members of the inner object (without throwing).
+ * 
+ *  @param fields
+ *      The fields (the destinations are partially written if failed).
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
+ *  @return
+ *      False in the situations that Traverse::extract() throws.
+ */
+bool Traverse::try_extract(
+    std::initializer_list<xap::core::json::ExtractField> fields,
+    xap::core::json::Status *status
+) {
+    reset_status(status);
+    return this->m_traverse->try_extract(
+        fields.begin(),
+        fields.size(),
+        status
     );
 }
 
 /**
- *  Get inner as a signed integer.
- * 
- *  @throw xap::core::json::Exception
- *      Raised in the following situations:
- *
- *          - xap::core::json::ERROR_TYPE:
- *              The inner is null.
- * 
- *          - xap::core::json::ERROR_TYPE:
- *              The inner is not a signed integer.
+ *  Get the length of an array (without throwing).
  * 
+ *  @param length
+ *      The pointer to receive the length.
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
  *  @return
- *      The inner.
+ *      False if the inner is null or is not an array
+ *      (xap::core::json::ERROR_TYPE).
  */
-int TraversePrivate::inner_as_int() {
-    this->not_null().integer();
-    return this->m_inner.asInt();
+bool Traverse::try_array_get_length(
+    size_t *length,
+    xap::core::json::Status *status
+) {
+    reset_status(status);
+    return this->m_traverse->try_array_get_length(length, status);
 }
 
 /**
- *  Get inner as an unsigned integer.
- * 
- *  @throw xap::core::json::Exception
- *      Raised in the following situations:
- *
- *          - xap::core::json::ERROR_TYPE:
- *              The inner is null.
+ *  Get inner as a signed integer (without throwing).
  * 
- *          - xap::core::json::ERROR_TYPE:
- *              The inner is not an unsigned integer.
+ *  @param value
+ *      The pointer to receive the inner.
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
+ *  @return
+ *      False if the inner is null or is not a signed integer
+ *      (xap::core::json::ERROR_TYPE).
+ */
+bool Traverse::try_inner_as_int(
+    int *value,
+    xap::core::json::Status *status
+) {
+    reset_status(status);
+    return this->m_traverse->try_inner_as_int(value, status);
+}
+
+/**
+ *  Get inner as an unsigned integer (without throwing).
  * 
+ *  @param value
+ *      The pointer to receive the inner.
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
  *  @return
- *      The inner.
+ *      False if the inner is null or is not an unsigned integer
+ *      (xap::core::json::ERROR_TYPE).
  */
-uint TraversePrivate::inner_as_uint() {
-    this->not_null().unsigned_integer();
-    return this->m_inner.asUInt();
+bool Traverse::try_inner_as_uint(
+    uint *value,
+    xap::core::json::Status *status
+) {
+    reset_status(status);
+    return this->m_traverse->try_inner_as_uint(value, status);
 }
 
 #if defined(XAPCORE_JSON_INT64)
 
 /**
- *  Get inner as a signed 64-bit integer.
- * 
- *  @throw xap::core::json::Exception
- *      Raised in the following situations:
- *
- *          - xap::core::json::ERROR_TYPE:
- *              The inner is null.
- * 
- *          - xap::core::json::ERROR_TYPE:
- *              The inner is not a signed 64-bit integer.
+ *  Get inner as a signed 64-bit integer (without throwing).
  * 
+ *  @param value
+ *      The pointer to receive the inner.
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
  *  @return
- *      The inner.
+ *      False if the inner is null or is not a signed 64-bit integer
+ *      (xap::core::json::ERROR_TYPE).
  */
-int64_t TraversePrivate::inner_as_int64() {
-    this->not_null().integer_64();
-    return this->m_inner.asInt64();
+bool Traverse::try_inner_as_int64(
+    int64_t *value,
+    xap::core::json::Status *status
+) {
+    reset_status(status);
+    return this->m_traverse->try_inner_as_int64(value, status);
 }
 
 /**
- *  Get inner as a unsigned 64-bit integer.
- * 
- *  @throw xap::core::json::Exception
- *      Raised in the following situations:
- *
- *          - xap::core::json::ERROR_TYPE:
- *              The inner is null.
- * 
- *          - xap::core::json::ERROR_TYPE:
- *              The inner is not a unsigned 64-bit integer.
+ *  Get inner as an unsigned 64-bit integer (without throwing).
  * 
+ *  @param value
+ *      The pointer to receive the inner.
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
  *  @return
- *      The inner.
+ *      False if the inner is null or is not an unsigned 64-bit integer
+ *      (xap::core::json::ERROR_TYPE).
  */
-uint64_t TraversePrivate::inner_as_uint64() {
-    this->not_null().unsigned_integer_64();
-    return this->m_inner.asUInt64();
+bool Traverse::try_inner_as_uint64(
+    uint64_t *value,
+    xap::core::json::Status *status
+) {
+    reset_status(status);
+    return this->m_traverse->try_inner_as_uint64(value, status);
 }
 
 #endif  //  #if defined(XAPCORE_JSON_INT64)
 
 /**
- *  Get the inner as float.
- * 
- *  @throw xap::core::json::Exception
- *      Raised in the following situations:
- *
- *          - xap::core::json::ERROR_TYPE:
- *              The inner is null.
- * 
- *          - xap::core::json::ERROR_TYPE:
- *              The inner is not numeric.
+ *  Get inner as float (without throwing).
  * 
+ *  @param value
+ *      The pointer to receive the inner.
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
  *  @return
- *      The inner.
+ *      False if the inner is null or is not numeric
+ *      (xap::core::json::ERROR_TYPE).
  */
-float TraversePrivate::inner_as_float() {
-    this->not_null().numeric();
-    return this->m_inner.asFloat();
+bool Traverse::try_inner_as_float(
+    float *value,
+    xap::core::json::Status *status
+) {
+    reset_status(status);
+    return this->m_traverse->try_inner_as_float(value, status);
 }
 
 /**
- *  Get the inner as double.
- * 
- *  @throw xap::core::json::Exception
- *      Raised in the following situations:
- *
- *          - xap::core::json::ERROR_TYPE:
- *              The inner is null.
+ *  Get inner as double (without throwing).
  * 
- *          - xap::core::json::ERROR_TYPE:
- *              The inner is not numeric.
+ *  @param value
+ *      The pointer to receive the inner.
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
+ *  @return
+ *      False if the inner is null or is not numeric
+ *      (xap::core::json::ERROR_TYPE).
+ */
+bool Traverse::try_inner_as_double(
+    double *value,
+    xap::core::json::Status *status
+) {
+    reset_status(status);
+    return this->m_traverse->try_inner_as_double(value, status);
+}
+
+/**
+ *  Get inner as a boolean (without throwing).
  * 
+ *  @param value
+ *      The pointer to receive the inner.
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
  *  @return
- *      The inner.
+ *      False if the inner is null or is not a boolean
+ *      (xap::core::json::ERROR_TYPE).
  */
-double TraversePrivate::inner_as_double() {
-    this->not_null().numeric();
-    return this->m_inner.asDouble();
+bool Traverse::try_inner_as_boolean(
+    bool *value,
+    xap::core::json::Status *status
+) {
+    reset_status(status);
+    return this->m_traverse->try_inner_as_boolean(value, status);
 }
 
 /**
- *  Get inner as a boolean.
+ *  Get inner as string (without throwing).
+ * 
+ *  @throw std::bad_alloc
+ *      Raised if memory allocation was failed.
+ *  @param value
+ *      The pointer to receive the inner.
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
+ *  @return
+ *      False if the inner is null or is not a string
+ *      (xap::core::json::ERROR_TYPE).
+ */
+bool Traverse::try_inner_as_string(
+    std::string *value,
+    xap::core::json::Status *status
+) {
+    reset_status(status);
+    return this->m_traverse->try_inner_as_string(value, status);
+}
+
+/**
+ *  Get the inner as string without copying it (without throwing).
+ * 
+ *  @note
+ *      See inner_as_string_view() for the lifetime of the view.
+ *  @param value
+ *      The pointer to receive the inner.
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
+ *  @return
+ *      False if the inner is null or is not a string
+ *      (xap::core::json::ERROR_TYPE).
+ */
+bool Traverse::try_inner_as_string_view(
+    xap::core::json::StringView *value,
+    xap::core::json::Status *status
+) {
+    reset_status(status);
+    return this->m_traverse->try_inner_as_string_view(value, status);
+}
+
+/**
+ *  Get the items of the inner array as integers (in bulk, without throwing).
+ * 
+ *  @note
+ *      Only the first n items are converted (all of them if the array is
+ *      shorter).
+ *  @param out
+ *      The buffer to receive the items (at least n items).
+ *  @param n
+ *      The size of the buffer.
+ *  @param length
+ *      The pointer to receive the length of the array (nullptr if not needed).
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
+ *  @return
+ *      False in the situations that inner_as_int_array() throws.
+ */
+bool Traverse::try_inner_as_int_array(
+    int *out,
+    const size_t n,
+    size_t *length,
+    xap::core::json::Status *status
+) {
+    reset_status(status);
+    return this->m_traverse->try_inner_as_array(out, n, length, status);
+}
+
+/**
+ *  Get the items of the inner array as unsigned integers (in bulk, without
+ *  throwing).
+ * 
+ *  @note
+ *      Only the first n items are converted (all of them if the array is
+ *      shorter).
+ *  @param out
+ *      The buffer to receive the items (at least n items).
+ *  @param n
+ *      The size of the buffer.
+ *  @param length
+ *      The pointer to receive the length of the array (nullptr if not needed).
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
+ *  @return
+ *      False in the situations that inner_as_uint_array() throws.
+ */
+bool Traverse::try_inner_as_uint_array(
+    uint *out,
+    const size_t n,
+    size_t *length,
+    xap::core::json::Status *status
+) {
+    reset_status(status);
+    return this->m_traverse->try_inner_as_array(out, n, length, status);
+}
+
+#if defined(XAPCORE_JSON_INT64)
+
+/**
+ *  Get the items of the inner array as signed 64-bit integers (in bulk, without
+ *  throwing).
+ * 
+ *  @note
+ *      Only the first n items are converted (all of them if the array is
+ *      shorter).
+ *  @param out
+ *      The buffer to receive the items (at least n items).
+ *  @param n
+ *      The size of the buffer.
+ *  @param length
+ *      The pointer to receive the length of the array (nullptr if not needed).
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
+ *  @return
+ *      False in the situations that inner_as_int64_array() throws.
+ */
+bool Traverse::try_inner_as_int64_array(
+    int64_t *out,
+    const size_t n,
+    size_t *length,
+    xap::core::json::Status *status
+) {
+    reset_status(status);
+    return this->m_traverse->try_inner_as_array(out, n, length, status);
+}
+
+/**
+ *  Get the items of the inner array as unsigned 64-bit integers (in bulk,
+ *  without throwing).
+ * 
+ *  @note
+ *      Only the first n items are converted (all of them if the array is
+ *      shorter).
+ *  @param out
+ *      The buffer to receive the items (at least n items).
+ *  @param n
+ *      The size of the buffer.
+ *  @param length
+ *      The pointer to receive the length of the array (nullptr if not needed).
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
+ *  @return
+ *      False in the situations that inner_as_uint64_array() throws.
+ */
+bool Traverse::try_inner_as_uint64_array(
+    uint64_t *out,
+    const size_t n,
+    size_t *length,
+    xap::core::json::Status *status
+) {
+    reset_status(status);
+    return this->m_traverse->try_inner_as_array(out, n, length, status);
+}
+
+#endif  //  #if defined(XAPCORE_JSON_INT64)
+
+/**
+ *  Get the items of the inner array as floats (in bulk, without throwing).
+ * 
+ *  @note
+ *      Only the first n items are converted (all of them if the array is
+ *      shorter).
+ *  @param out
+ *      The buffer to receive the items (at least n items).
+ *  @param n
+ *      The size of the buffer.
+ *  @param length
+ *      The pointer to receive the length of the array (nullptr if not needed).
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
+ *  @return
+ *      False in the situations that inner_as_float_array() throws.
+ */
+bool Traverse::try_inner_as_float_array(
+    float *out,
+    const size_t n,
+    size_t *length,
+    xap::core::json::Status *status
+) {
+    reset_status(status);
+    return this->m_traverse->try_inner_as_array(out, n, length, status);
+}
+
+/**
+ *  Get the items of the inner array as doubles (in bulk, without throwing).
+ * 
+ *  @note
+ *      Only the first n items are converted (all of them if the array is
+ *      shorter).
+ *  @param out
+ *      The buffer to receive the items (at least n items).
+ *  @param n
+ *      The size of the buffer.
+ *  @param length
+ *      The pointer to receive the length of the array (nullptr if not needed).
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
+ *  @return
+ *      False in the situations that inner_as_double_array() throws.
+ */
+bool Traverse::try_inner_as_double_array(
+    double *out,
+    const size_t n,
+    size_t *length,
+    xap::core::json::Status *status
+) {
+    reset_status(status);
+    return this->m_traverse->try_inner_as_array(out, n, length, status);
+}
+
+/**
+ *  Get the items of the inner array as 16-bit PCM samples (in bulk, without
+ *  throwing).
+ * 
+ *  @note
+ *      Only the first n items are converted (all of them if the array is
+ *      shorter). Numbers are clamped to [-32768, 32767] (and truncated toward
+ *      zero).
+ *  @param out
+ *      The buffer to receive the items (at least n items).
+ *  @param n
+ *      The size of the buffer.
+ *  @param length
+ *      The pointer to receive the length of the array (nullptr if not needed).
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
+ *  @return
+ *      False in the situations that inner_as_int16_array() throws.
+ */
+bool Traverse::try_inner_as_int16_array(
+    int16_t *out,
+    const size_t n,
+    size_t *length,
+    xap::core::json::Status *status
+) {
+    reset_status(status);
+    return this->m_traverse->try_inner_as_array(out, n, length, status);
+}
+
+/**
+ *  Decode the inner base64 string into a buffer (without throwing).
+ * 
+ *  @note
+ *      Only the first n bytes are written (all of them if the decoded data is
+ *      shorter), but the whole string is always validated. The content of the
+ *      buffer is unspecified if failed.
+ *  @param out
+ *      The buffer to receive the decoded bytes (at least n bytes).
+ *  @param n
+ *      The size of the buffer.
+ *  @param length
+ *      The pointer to receive the length of the decoded data (nullptr if not
+ *      needed).
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
+ *  @return
+ *      False in the situations that inner_as_base64() throws.
+ */
+bool Traverse::try_inner_as_base64(
+    uint8_t *out,
+    const size_t n,
+    size_t *length,
+    xap::core::json::Status *status
+) {
+    reset_status(status);
+    return this->m_traverse->try_inner_as_base64(out, n, length, status);
+}
+
+//
+//  Traverse public static functions.
+//
+
+/**
+ *  Get a 'Traverse' object and its type is 'null'.
+ *
+ *  @param path
+ *      The path.
+ *  @return
+ *      The 'Traverse' object.
+ */
+xap::core::json::Traverse Traverse::null(const std::string &path) {
+    const std::shared_ptr<xap::core::json::ValueDocument> &document = 
+        xap::core::json::ValueDocument::null_document();
+    return xap::core::json::Traverse(
+        xap::core::json::TraversePrivate(
+            document, 
+            document->get_root(), 
+            xap::core::json::Path(path)
+        )
+    );
+}
+
+/**
+ *  Parse a JSON file (with the default parser of current thread).
+ * 
+ *  @note
+ *      See xap::core::json::Parser::parse_file().
+ *  @throw xap::core::json::Exception
+ *      Raised if the file can't be read or JSON parsing was failed
+ *      (ERROR_PARAMETER).
+ *  @param filename
+ *      The file name.
+ *  @param path
+ *      The path.
+ *  @return
+ *      Traverse object of the root.
+ */
+xap::core::json::Traverse Traverse::from_file(
+    const std::string &filename,
+    const std::string &path
+) {
+    return xap::core::json::Parser::get_default().parse_file(filename, path);
+}
+
+//
+//  TraversePrivate constructor & destructor.
+//
+
+/**
+ *  Constructh the object.
+ * 
+ *  @param value
+ *      The JSON value.
+ *  @param path
+ *      The path.
+ */
+TraversePrivate::TraversePrivate(
+    const Json::Value &value,
+    const std::string &path
+) :
+    m_document(std::make_shared<xap::core::json::ValueDocument>(value)),
+    m_node(m_document->get_root()),
+    m_path(path),
+    m_type(xap::core::json::Type::null)
+{
+    this->m_type = this->get_inner_type();
+}
+
+/**
+ *  Construct the object (as a view of a node within a document).
+ * 
+ *  @param document
+ *      The document.
+ *  @param node
+ *      The node (must be owned by the document).
+ *  @param path
+ *      The path.
+ */
+TraversePrivate::TraversePrivate(
+    const std::shared_ptr<xap::core::json::Document> &document,
+    const xap::core::json::Node node,
+    const xap::core::json::Path &path
+) :
+    m_document(document),
+    m_node(node),
+    m_path(path),
+    m_type(xap::core::json::Type::null)
+{
+    this->m_type = this->get_inner_type();
+}
+
+/**
+ *  Construct the object (as a view of a node within a document).
+ * 
+ *  @param document
+ *      The document.
+ *  @param node
+ *      The node (must be owned by the document).
+ *  @param path
+ *      The path (moved).
+ */
+TraversePrivate::TraversePrivate(
+    const std::shared_ptr<xap::core::json::Document> &document,
+    const xap::core::json::Node node,
+    xap::core::json::Path &&path
+) :
+    m_document(document),
+    m_node(node),
+    m_path(std::move(path)),
+    m_type(xap::core::json::Type::null)
+{
+    this->m_type = this->get_inner_type();
+}
+
+/**
+ *  Construct (Copy) the object.
+ * 
+ *  @note
+ *      The copy shares the document with the source.
+ *  @param src
+ *      The source.
+ */
+TraversePrivate::TraversePrivate(const TraversePrivate &src) :
+    m_document(src.m_document),
+    m_node(src.m_node),
+    m_path(src.m_path),
+    m_type(src.m_type)
+{}
+
+/**
+ *  Construct (Move) the object.
+ * 
+ *  @param src
+ *      The source.
+ */
+TraversePrivate::TraversePrivate(TraversePrivate &&src) noexcept :
+    m_document(std::move(src.m_document)),
+    m_node(src.m_node),
+    m_path(std::move(src.m_path)),
+    m_type(src.m_type)
+{}
+
+/**
+ *  Destruct the object.
+ */
+TraversePrivate::~TraversePrivate() noexcept {
+    //  Do nothing.
+}
+
+//
+//  TraversePrivate operators.
+//
+
+/**
+ *  Assign (Copy) the object.
+ * 
+ *  @note
+ *      The object shares the document with the source.
+ *  @param src
+ *      The source.
+ *  @return
+ *      Self.
+ */
+xap::core::json::TraversePrivate &
+TraversePrivate::operator=(const TraversePrivate &src) {
+    this->m_document = src.m_document;
+    this->m_node = src.m_node;
+    this->m_path = src.m_path;
+    this->m_type = src.m_type;
+    return *this;
+}
+
+/**
+ *  Assign (Move) the object.
+ * 
+ *  @param src
+ *      The source.
+ *  @return
+ *      Self.
+ */
+xap::core::json::TraversePrivate &
+TraversePrivate::operator=(TraversePrivate &&src) noexcept {
+    this->m_document = std::move(src.m_document);
+    this->m_node = src.m_node;
+    this->m_path = std::move(src.m_path);
+    this->m_type = src.m_type;
+    return *this;
+}
+
+/**
+ *  Allocate memory for an object (from the heap).
+ *
+ *  @throw std::bad_alloc
+ *      Raised if memory allocation was failed.
+ *  @param size
+ *      The size of the object.
+ *  @return
+ *      The memory.
+ */
+void *TraversePrivate::operator new(const size_t size) {
+    return TraversePrivate::operator new(size, nullptr);
+}
+
+/**
+ *  Allocate memory for an object.
+ *
+ *  @note
+ *      The object keeps the arena alive until it is deleted.
+ *  @throw std::bad_alloc
+ *      Raised if memory allocation was failed.
+ *  @param size
+ *      The size of the object.
+ *  @param arena
+ *      The arena (nullptr to allocate from the heap).
+ *  @return
+ *      The memory.
+ */
+void *TraversePrivate::operator new(
+    const size_t size,
+    const std::shared_ptr<xap::core::json::ArenaPrivate> &arena
+) {
+    void *memory;
+    if (arena) {
+        memory = arena->allocate(
+            TRAVERSE_MEMORY_HEADER_SIZE + size,
+            alignof(max_align_t)
+        );
+    } else {
+        memory = ::operator new(TRAVERSE_MEMORY_HEADER_SIZE + size);
+    }
+    new (memory) TraverseMemoryHeader{arena};
+    return static_cast<char*>(memory) + TRAVERSE_MEMORY_HEADER_SIZE;
+}
+
+/**
+ *  Deallocate the memory of an object.
+ *
+ *  @param memory
+ *      The memory.
+ */
+void TraversePrivate::operator delete(void *memory) noexcept {
+    if (!memory) {
+        return;
+    }
+    TraverseMemoryHeader *header = reinterpret_cast<TraverseMemoryHeader*>(
+        static_cast<char*>(memory) - TRAVERSE_MEMORY_HEADER_SIZE
+    );
+
+    //  The arena may be released along with the last reference to it, so
+    //  take the reference out of the memory first.
+    std::shared_ptr<xap::core::json::ArenaPrivate> arena =
+        std::move(header->arena);
+    header->~TraverseMemoryHeader();
+    if (!arena) {
+        ::operator delete(header);
+    }
+}
+
+/**
+ *  Deallocate the memory of an object (if its constructor throws).
+ *
+ *  @param memory
+ *      The memory.
+ *  @param arena
+ *      The arena.
+ */
+void TraversePrivate::operator delete(
+    void *memory,
+    const std::shared_ptr<xap::core::json::ArenaPrivate> &arena
+) noexcept {
+    (void)arena;
+    TraversePrivate::operator delete(memory);
+}
+
+//
+//  TraversePrivate public static functions.
+//
+
+/**
+ *  Allocate a copy of an object (from the arena of its document).
+ *
+ *  @throw std::bad_alloc
+ *      Raised if memory allocation was failed.
+ *  @param src
+ *      The source.
+ *  @return
+ *      The copy.
+ */
+std::unique_ptr<xap::core::json::TraversePrivate> TraversePrivate::create(
+    const TraversePrivate &src
+) {
+    return std::unique_ptr<xap::core::json::TraversePrivate>(
+        new (src.m_document->get_arena()) xap::core::json::TraversePrivate(
+            src
+        )
+    );
+}
+
+/**
+ *  Allocate an object (from the arena of its document) and move another
+ *  object into it.
+ *
+ *  @throw std::bad_alloc
+ *      Raised if memory allocation was failed.
+ *  @param src
+ *      The source.
+ *  @return
+ *      The object.
+ */
+std::unique_ptr<xap::core::json::TraversePrivate> TraversePrivate::create(
+    TraversePrivate &&src
+) {
+    //  Hold the arena, the document of the source is moved away.
+    const std::shared_ptr<xap::core::json::ArenaPrivate> arena =
+        src.m_document->get_arena();
+    return std::unique_ptr<xap::core::json::TraversePrivate>(
+        new (arena) xap::core::json::TraversePrivate(std::move(src))
+    );
+}
+
+//
+//  TraversePrivate public methods.
+//
+
+/**
+ *  Get the path.
+ *
+ *  @return
+ *      The path.
+ */
+std::string TraversePrivate::get_path() const {
+    return this->m_path.to_string();
+}
+
+/**
+ *  Check the type of inner object.
+ * 
+ *  @throw xap::core::json::Exception
+ *      Raised in the following situations:
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              The type is not null.
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              The type is invalid.
+ * 
+ *  @param type
+ *      The expected type.
+ *  @return
+ *      Self.
+ */
+xap::core::json::TraversePrivate &
+TraversePrivate::type_of(const xap::core::json::Type &type) {
+    if (this->m_type == xap::core::json::Type::null) {
+        return *this;
+    }
+
+    if (this->m_type == type) {
+        return *this;
+    } else {
+        throw xap::core::json::Exception(
+            "Invalid object value.",
+            xap::core::json::ERROR_TYPE,
+            this->m_path.to_string().c_str()
+        );
+    }
+}
+
+/**
+ *  Get the type of inner object.
+ * 
+ *  @return
+ *      The type.
+ */
+xap::core::json::Type TraversePrivate::type() const noexcept {
+    return this->m_type;
+}
+
+/**
+ *  Assume that the inner object is numeric.
+ * 
+ *  @throw xap::core::json::Exception
+ *      Raised in the following situations:
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is not null.
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is not numeric.
+ * 
+ *  @return
+ *      Self.
+ */
+xap::core::json::TraversePrivate &TraversePrivate::numeric() {
+    this->type_of(xap::core::json::Type::numeric);
+    return *this;
+}
+
+/**
+ *  Assume that the inner object is an integer.
+ * 
+ *  @throw xap::core::json::Exception
+ *      Raised in the following situations:
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is not null.
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is not an integer.
+ * 
+ *  @return
+ *      Self.
+ */
+xap::core::json::TraversePrivate &TraversePrivate::integer() {
+    if (this->m_type == xap::core::json::Type::null) {
+        return *this;
+    }
+
+    //  Check type.
+    if (
+        this->m_type != xap::core::json::Type::numeric ||
+        !this->m_document->get_number(this->m_node).is_int()
+    ) {
+        throw xap::core::json::Exception(
+            "Value should be integer.",
+            xap::core::json::ERROR_TYPE,
+            this->m_path.to_string().c_str()
+        );
+    }
+
+    return *this;
+}
+
+/**
+ *  Assume that the inner object is an unsigned integer.
+ * 
+ *  @throw xap::core::json::Exception
+ *      Raised in the following situations:
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is not null.
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is not an unsigned integer.
+ * 
+ *  @return
+ *      Self.
+ */
+xap::core::json::TraversePrivate 
+&TraversePrivate::unsigned_integer() {
+    if (this->m_type == xap::core::json::Type::null) {
+        return *this;
+    }
+
+    //  Check type.
+    if (
+        this->m_type != xap::core::json::Type::numeric ||
+        !this->m_document->get_number(this->m_node).is_uint()
+    ) {
+        throw xap::core::json::Exception(
+            "Value should be integer.",
+            xap::core::json::ERROR_TYPE,
+            this->m_path.to_string().c_str()
+        );
+    }
+
+    return *this;
+}
+
+#if defined(XAPCORE_JSON_INT64)
+
+/**
+ *  Assume that the inner object is a 64-bit integer.
+ * 
+ *  @throw xap::core::json::Exception
+ *      Raised in the following situations:
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is not null.
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is not an 64-bit integer.
+ * 
+ *  @return
+ *      Self.
+ */
+xap::core::json::TraversePrivate &
+TraversePrivate::integer_64() {
+    if (this->m_type == xap::core::json::Type::null) {
+        return *this;
+    }
+
+    //  Check type.
+    if (
+        this->m_type != xap::core::json::Type::numeric ||
+        !this->m_document->get_number(this->m_node).is_int64()
+    ) {
+        throw xap::core::json::Exception(
+            "Value should be integer.",
+            xap::core::json::ERROR_TYPE,
+            this->m_path.to_string().c_str()
+        );
+    }
+
+    return *this;
+}
+
+/**
+ *  Assume that the inner object is an unsigned 64-bit integer.
+ * 
+ *  @throw xap::core::json::Exception
+ *      Raised in the following situations:
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is not null.
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is not an unsigned 64-bit integer.
+ * 
+ *  @return
+ *      Self.
+ */
+xap::core::json::TraversePrivate &
+TraversePrivate::unsigned_integer_64() {
+    if (this->m_type == xap::core::json::Type::null) {
+        return *this;
+    }
+
+    //  Check type.
+    if (
+        this->m_type != xap::core::json::Type::numeric ||
+        !this->m_document->get_number(this->m_node).is_uint64()
+    ) {
+        throw xap::core::json::Exception(
+            "Value should be unsigned 64-bit integer.",
+            xap::core::json::ERROR_TYPE,
+            this->m_path.to_string().c_str()
+        );
+    }
+
+    return *this;
+}
+
+#endif  //  #if defined(XAPCORE_JSON_INT64)
+
+/**
+ *  Assume that the inner object is a boolean.
+ * 
+ *  @throw xap::core::json::Exception
+ *      Raised in the following situations:
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is not null.
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is not a boolean.
+ * 
+ *  @return
+ *      Self.
+ */
+xap::core::json::TraversePrivate &TraversePrivate::boolean() {
+    //  Check type.
+    this->type_of(xap::core::json::Type::boolean);
+    return *this;
+}
+
+/**
+ *  Assume that the inner object is a string.
+ * 
+ *  @throw xap::core::json::Exception
+ *      Raised in the following situations:
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is not null.
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is not a string.
+ * 
+ *  @return
+ *      Self.
+ */
+xap::core::json::TraversePrivate &TraversePrivate::string() {
+    //  Check type.
+    this->type_of(xap::core::json::Type::string);
+    return *this;
+}
+
+/**
+ *  Assume that the inner object is an array.
+ * 
+ *  @throw xap::core::json::Exception
+ *      Raised in the following situations:
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is not null.
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is not an array.
+ * 
+ *  @return
+ *      Self.
+ */
+xap::core::json::TraversePrivate &TraversePrivate::array() {
+    //  Check type.
+    this->type_of(xap::core::json::Type::array);
+    return *this;
+}
+
+/**
+ *  Assume that the inner object is a JSON object.
+ * 
+ *  @throw xap::core::json::Exception
+ *      Raised in the following situations:
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is not null.
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is not an object.
+ * 
+ *  @return
+ *      Self.
+ */
+xap::core::json::TraversePrivate &TraversePrivate::object() {
+    //  Check type.
+    this->type_of(xap::core::json::Type::object);
+    return *this;
+}
+
+/**
+ *  Assume that the inner object is not null.
+ * 
+ *  @throw xap::core::json::Exception
+ *      Raised if value is null (xap::core::json::ERROR_TYPE).
+ *  @return
+ *      Self.
+ */
+xap::core::json::TraversePrivate &TraversePrivate::not_null() {
+    //  Check type.
+    if (this->m_type == xap::core::json::Type::null) {
+        throw xap::core::json::Exception(
+            "Value shoud not be null.",
+            xap::core::json::ERROR_TYPE,
+            this->m_path.to_string().c_str()
+        );
+    }
+
+    return *this;
+}
+
+/**
+ *  Check whether the inner object is null.
+ * 
+ *  @return
+ *      True if so.
+ */
+bool TraversePrivate::is_null() const noexcept {
+    return this->m_type == xap::core::json::Type::null;
+}
+
+/**
+ *  Go to sub directory.
+ * 
+ *  @throw xap::core::json::Exception
+ *      Raised in the following situations:
+ *
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is null.
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is not an object.
+ *  
+ *          - xap::core::json::ERROR_NOTFIND:
+ *              Sub path is not existed.
+ * 
+ *  @param name
+ *      The name (key) of sub directory.
+ *  @return
+ *      Traverse object of sub directory.
+ */
+xap::core::json::TraversePrivate TraversePrivate::sub(
+    const std::string &name
+) {
+    //  Check type.
+    this->not_null().object();
+
+    //  Find sub item.
+    xap::core::json::Node sub_node;
+    if (!this->m_document->find_member(
+        this->m_node,
+        name.c_str(),
+        name.size(),
+        &sub_node
+    )) {
+        throw xap::core::json::Exception(
+            "Sub path is not existed.",
+            xap::core::json::ERROR_NOTFIND,
+            this->m_path.child(
+                name,
+                this->m_document->get_arena()
+            ).to_string().c_str()
+        );
+    }
+
+    return xap::core::json::TraversePrivate(
+        this->m_document,
+        sub_node,
+        this->member_path(sub_node, name)
+    );
+}
+
+/**
+ *  Go to sub directory which can be non-existed.
+ * 
+ *  @throw xap::core::json::Exception
+ *      Raised in the following situations:
+ *
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is null.
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is not an object.
+ * 
+ *  @param name
+ *      The name (key) of sub directory.
+ *  @param default_value
+ *      The default value if the directory doesn't existed.
+ *  @return
+ *      Traverse object of sub directory.
+ */
+xap::core::json::TraversePrivate TraversePrivate::optional_sub(
+    const std::string &name, 
+    const Json::Value &default_value
+) {
+    //  Check type.
+    this->not_null().object();
+
+    //  Find sub item.
+    xap::core::json::Node sub_node;
+    if (!this->m_document->find_member(
+        this->m_node,
+        name.c_str(),
+        name.size(),
+        &sub_node
+    )) {
+        //  The default value is within another document.
+        xap::core::json::Path sub_path = this->m_path.child(
+            name,
+            this->m_document->get_arena()
+        );
+        sub_path.own_names(this->m_document->get_arena());
+        if (default_value.isNull()) {
+            const std::shared_ptr<xap::core::json::ValueDocument> &document = 
+                xap::core::json::ValueDocument::null_document();
+            return xap::core::json::TraversePrivate(
+                document, 
+                document->get_root(), 
+                std::move(sub_path)
+            );
+        }
+        const std::shared_ptr<xap::core::json::Document> document = 
+            xap::core::json::make_document<xap::core::json::ValueDocument>(
+                this->m_document->get_arena(),
+                default_value
+            );
+        return xap::core::json::TraversePrivate(
+            document, 
+            document->get_root(), 
+            std::move(sub_path)
+        );
+    }
+
+    return xap::core::json::TraversePrivate(
+        this->m_document,
+        sub_node,
+        this->member_path(sub_node, name)
+    );
+}
+
+/**
+ *  Go to sub directory which can be non-existed.
+ * 
+ *  @throw xap::core::json::Exception
+ *      Raised in the following situations:
+ *
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is null.
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is not an object.
+ * 
+ *  @param name
+ *      The name (key) of sub directory.
+ *  @param default_value
+ *      The default value (shared, not copied) if the directory doesn't 
+ *      existed.
+ *  @return
+ *      Traverse object of sub directory.
+ */
+xap::core::json::TraversePrivate TraversePrivate::optional_sub(
+    const std::string &name, 
+    const xap::core::json::TraversePrivate &default_value
+) {
+    //  Check type.
+    this->not_null().object();
+
+    //  Find sub item.
+    xap::core::json::Node sub_node;
+    if (!this->m_document->find_member(
+        this->m_node,
+        name.c_str(),
+        name.size(),
+        &sub_node
+    )) {
+        //  The default value is within another document.
+        xap::core::json::Path sub_path = this->m_path.child(
+            name,
+            this->m_document->get_arena()
+        );
+        sub_path.own_names(this->m_document->get_arena());
+        return xap::core::json::TraversePrivate(
+            default_value.m_document,
+            default_value.m_node,
+            std::move(sub_path)
+        );
+    }
+
+    return xap::core::json::TraversePrivate(
+        this->m_document,
+        sub_node,
+        this->member_path(sub_node, name)
+    );
+}
+
+/**
+ *  Go to the value that a JSON pointer refers to.
+ * 
+ *  @throw xap::core::json::Exception
+ *      Raised in the following situations:
+ *
+ *          - xap::core::json::ERROR_TYPE:
+ *              A value on the way is null.
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              A value on the way is neither an object nor an array.
+ *  
+ *          - xap::core::json::ERROR_NOTFIND:
+ *              A member (or an array item) is not existed.
+ * 
+ *  @param pointer
+ *      The compiled pointer.
+ *  @return
+ *      Traverse object of the value.
+ */
+xap::core::json::TraversePrivate TraversePrivate::at(
+    const xap::core::json::Pointer &pointer
+) {
+    const xap::core::json::PointerPrivate &compiled = *(pointer.m_pointer);
+    if (compiled.get_segments().empty()) {
+        return *this;
+    }
+
+    xap::core::json::Node node;
+    xap::core::json::Status status;
+    if (!this->locate(compiled, false, &node, &status)) {
+        status.raise();
+    }
+    return xap::core::json::TraversePrivate(
+        this->m_document,
+        node,
+        this->pointer_path(pointer.m_pointer, compiled.get_path().size())
+    );
+}
+
+/**
+ *  Go to the value that a JSON pointer refers to, which can be
+ *  non-existed.
+ * 
+ *  @throw xap::core::json::Exception
+ *      Raised if a value on the way is neither an object nor an array
+ *      (xap::core::json::ERROR_TYPE).
+ *  @param pointer
+ *      The compiled pointer.
+ *  @return
+ *      Traverse object of the value.
+ */
+xap::core::json::TraversePrivate TraversePrivate::optional_at(
+    const xap::core::json::Pointer &pointer
+) {
+    const xap::core::json::PointerPrivate &compiled = *(pointer.m_pointer);
+    if (compiled.get_segments().empty()) {
+        return *this;
+    }
+
+    xap::core::json::Node node;
+    xap::core::json::Status status;
+    if (!this->locate(compiled, true, &node, &status)) {
+        status.raise();
+
+        //  The null value is within another document.
+        xap::core::json::Path path = this->pointer_path(
+            pointer.m_pointer,
+            compiled.get_path().size()
+        );
+        path.own_names(this->m_document->get_arena());
+        const std::shared_ptr<xap::core::json::ValueDocument> &document = 
+            xap::core::json::ValueDocument::null_document();
+        return xap::core::json::TraversePrivate(
+            document, 
+            document->get_root(), 
+            std::move(path)
+        );
+    }
+    return xap::core::json::TraversePrivate(
+        this->m_document,
+        node,
+        this->pointer_path(pointer.m_pointer, compiled.get_path().size())
+    );
+}
+
+/**
+ *  Validate the inner object against a schema.
+ * 
+ *  @throw xap::core::json::Exception
+ *      Raised in the following situations (the path of the error is the
+ *      path of the first value that failed):
+ *
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is null or is not an object.
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              A field is null (but required) or has another type.
+ *  
+ *          - xap::core::json::ERROR_NOTFIND:
+ *              A required field is not existed.
+ * 
+ *  @param schema
+ *      The schema.
+ *  @return
+ *      Self.
+ */
+xap::core::json::TraversePrivate &TraversePrivate::validate(
+    const xap::core::json::Schema &schema
+) {
+    xap::core::json::Status status;
+    if (!this->try_validate(schema, &status)) {
+        status.raise();
+    }
+    return *this;
+}
+
+/**
+ *  Extract multiple members of the inner object.
+ * 
+ *  @throw xap::core::json::Exception
+ *      Raised in the following situations (the path of the error is the
+ *      path of the first member that failed):
+ *
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is null or is not an object.
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              A member is null (but required) or doesn't fit the type of
+ *              its destination.
+ *  
+ *          - xap::core::json::ERROR_NOTFIND:
+ *              A required member is not existed.
+ * 
+ *  @param fields
+ *      The fields.
+ *  @param count
+ *      The count of fields.
+ *  @return
+ *      Self.
+ */
+xap::core::json::TraversePrivate &TraversePrivate::extract(
+    const xap::core::json::ExtractField *fields,
+    const size_t count
+) {
+    xap::core::json::Status status;
+    if (!this->try_extract(fields, count, &status)) {
+        status.raise();
+    }
+    return *this;
+}
+
+/**
+ *  Set a key-value pair within an object.
+ * 
+ *  @throw xap::core::json::Exception
+ *      Raised in the following situations:
+ *
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is null.
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is not an object.
+ * 
+ *  @param key
+ *      The key.
+ *  @param value
+ *      The value.
+ *  @return
+ *      Self.
+ */
+xap::core::json::TraversePrivate &TraversePrivate::object_set(
+    const std::string &key,
+    const Json::Value &value
+) {
+    //  Check type.
+    this->not_null().object();
+
+    Json::Value *inner = this->detach();
+    this->m_document->demand_member(inner, key.data(), key.size()) = value;
+    return *this;
+}
+
+/**
+ *  Get the length of an array.
+ * 
+ *  @throw xap::core::json::Exception
+ *      Raised in the following situations:
+ *
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is null.
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is not an array.
+ * 
+ *  @return
+ *      The length.
+ */
+size_t TraversePrivate::array_get_length() {
+    //  Check type.
+    this->not_null().array();
+
+    return this->m_document->get_size(this->m_node);
+}
+
+/**
+ *  Iterate an array.
+ * 
+ *  @throw xap::core::json::Exception
+ *      Raised in the following situations:
+ *
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is null.
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is not an array.
+ * 
+ *  @throw std::exception
+ *      Any exception rasied by handler.
+ *  @param handler
+ *      The callback.
+ *  @return
+ *      Self.
+ */
+xap::core::json::TraversePrivate &TraversePrivate::array_foreach(
+    std::function<void(TraversePrivate &)> handler
+) {
+    //  Check type.
+    this->not_null().array();
+
+    const size_t length = this->m_document->get_size(this->m_node);
+    for (size_t i = 0U; i < length; ++i) {
+        xap::core::json::TraversePrivate item(
+            this->m_document,
+            this->m_document->get_element(this->m_node, i),
+            this->m_path.child(i, this->m_document->get_arena())
+        );
+        handler(item);
+    }
+
+    return *this;
+}
+
+/**
+ *  Push an item to an array.
+ * 
+ *  @throw xap::core::json::Exception
+ *      Raised in the following situations:
+ *
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is null.
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is not an array.
+ * 
+ *  @param value
+ *      The item value.
+ *  @return
+ *      Self.
+ */
+xap::core::json::TraversePrivate &TraversePrivate::array_push_item(
+    const Json::Value &value
+) {
+    //  Check type.
+    this->not_null().array();
+
+    this->detach()->append(value);
+    return *this;
+}
+
+/**
+ *  Pop an item from an array.
+ * 
+ *  @throw xap::core::json::Exception
+ *      Raised in the following situations:
+ *
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is null.
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is not an array.
+ * 
+ *          - xap::core::json::ERROR_OVERFLOW:
+ *              The array is empty.
+ * 
+ *  @return
+ *      Traverse object of the popped item.
+ */
+xap::core::json::TraversePrivate TraversePrivate::array_pop_item() {
+    this->not_null().array();
+
+    const size_t length = this->m_document->get_size(this->m_node);
+    if (length == 0U) {
+        throw xap::core::json::Exception(
+            "Array is empty.",
+            xap::core::json::ERROR_OVERFLOW,
+            this->m_path.to_string().c_str()
+        );
+    }
+
+    Json::Value *inner = this->detach();
+
+    //  Move the popped item into a document of its own.
+    const Json::ArrayIndex pop_index = 
+        static_cast<Json::ArrayIndex>(length - 1U);
+    std::shared_ptr<xap::core::json::Document> pop_document = 
+        xap::core::json::make_document<xap::core::json::ValueDocument>(
+            this->m_document->get_arena(),
+            std::move((*inner)[pop_index])
+        );
+    pop_document->set_key_table(this->m_document->get_key_table());
+    inner->resize(pop_index);
+
+    //  The path of the item is used with another document.
+    xap::core::json::Path pop_path = this->m_path.child(
+        static_cast<size_t>(pop_index),
+        this->m_document->get_arena()
+    );
+    pop_path.own_names(this->m_document->get_arena());
+    return xap::core::json::TraversePrivate(
+        pop_document,
+        pop_document->get_root(),
+        std::move(pop_path)
+    );
+}
+
+/**
+ *  Get inner as a signed integer.
+ * 
+ *  @throw xap::core::json::Exception
+ *      Raised in the following situations:
+ *
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is null.
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is not a signed integer.
+ * 
+ *  @return
+ *      The inner.
+ */
+int TraversePrivate::inner_as_int() {
+    this->not_null().integer();
+    return this->m_document->get_number(this->m_node).as_int();
+}
+
+/**
+ *  Get inner as an unsigned integer.
+ * 
+ *  @throw xap::core::json::Exception
+ *      Raised in the following situations:
+ *
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is null.
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is not an unsigned integer.
+ * 
+ *  @return
+ *      The inner.
+ */
+uint TraversePrivate::inner_as_uint() {
+    this->not_null().unsigned_integer();
+    return this->m_document->get_number(this->m_node).as_uint();
+}
+
+#if defined(XAPCORE_JSON_INT64)
+
+/**
+ *  Get inner as a signed 64-bit integer.
+ * 
+ *  @throw xap::core::json::Exception
+ *      Raised in the following situations:
+ *
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is null.
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is not a signed 64-bit integer.
+ * 
+ *  @return
+ *      The inner.
+ */
+int64_t TraversePrivate::inner_as_int64() {
+    this->not_null().integer_64();
+    return this->m_document->get_number(this->m_node).as_int64();
+}
+
+/**
+ *  Get inner as a unsigned 64-bit integer.
+ * 
+ *  @throw xap::core::json::Exception
+ *      Raised in the following situations:
+ *
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is null.
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is not a unsigned 64-bit integer.
+ * 
+ *  @return
+ *      The inner.
+ */
+uint64_t TraversePrivate::inner_as_uint64() {
+    this->not_null().unsigned_integer_64();
+    return this->m_document->get_number(this->m_node).as_uint64();
+}
+
+#endif  //  #if defined(XAPCORE_JSON_INT64)
+
+/**
+ *  Get the inner as float.
+ * 
+ *  @throw xap::core::json::Exception
+ *      Raised in the following situations:
+ *
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is null.
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is not numeric.
+ * 
+ *  @return
+ *      The inner.
+ */
+float TraversePrivate::inner_as_float() {
+    this->not_null().numeric();
+    return this->m_document->get_number(this->m_node).as_float();
+}
+
+/**
+ *  Get the inner as double.
+ * 
+ *  @throw xap::core::json::Exception
+ *      Raised in the following situations:
+ *
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is null.
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is not numeric.
+ * 
+ *  @return
+ *      The inner.
+ */
+double TraversePrivate::inner_as_double() {
+    this->not_null().numeric();
+    return this->m_document->get_number(this->m_node).as_double();
+}
+
+/**
+ *  Get inner as a boolean.
  * 
  *  @throw xap::core::json::Exception
  *      Raised in the following situations:
@@ -1851,69 +3757,876 @@ double TraversePrivate::inner_as_double() {
  *              The inner is not a boolean.
  * 
  *  @return
- *      The inner.
+ *      The inner.
+ */
+bool TraversePrivate::inner_as_boolean() {
+    this->not_null().boolean();
+    return this->m_document->get_boolean(this->m_node);
+}
+
+/**
+ *  Get the inner as string.
+ * 
+ *  @throw xap::core::json::Exception
+ *      Raised in the following situations:
+ *
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is null.
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is not a string.
+ * 
+ *  @return
+ *      The inner.
+ */
+std::string TraversePrivate::inner_as_string() {
+    this->not_null().string();
+
+    const char *begin;
+    const char *end;
+    this->m_document->get_string(this->m_node, &begin, &end);
+    return std::string(begin, end);
+}
+
+/**
+ *  Get the inner as string (without copying it).
+ * 
+ *  @throw xap::core::json::Exception
+ *      Raised in the following situations:
+ *
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is null.
+ * 
+ *          - xap::core::json::ERROR_TYPE:
+ *              The inner is not a string.
+ * 
+ *  @return
+ *      The inner (refers to the storage of the document).
+ */
+xap::core::json::StringView TraversePrivate::inner_as_string_view() {
+    this->not_null().string();
+
+    const char *begin;
+    const char *end;
+    this->m_document->get_string(this->m_node, &begin, &end);
+    return xap::core::json::StringView(
+        begin,
+        static_cast<size_t>(end - begin)
+    );
+}
+
+/**
+ *  Get the items of the inner array (in bulk).
+ * 
+ *  @throw xap::core::json::Exception
+ *      Raised in the situations described by Traverse::inner_as_int_array()
+ *      and the like.
+ *  @param out
+ *      The buffer to receive the items (at least n items).
+ *  @param n
+ *      The size of the buffer.
+ *  @return
+ *      The length of the array.
+ */
+template <typename T>
+size_t TraversePrivate::inner_as_array(T *out, const size_t n) {
+    size_t length = 0U;
+    xap::core::json::Status status;
+    if (!this->try_inner_as_array(out, n, &length, &status)) {
+        status.raise();
+    }
+    return length;
+}
+
+/**
+ *  Decode the inner base64 string into a buffer.
+ * 
+ *  @throw xap::core::json::Exception
+ *      Raised in the situations described by Traverse::inner_as_base64().
+ *  @param out
+ *      The buffer to receive the decoded bytes (at least n bytes).
+ *  @param n
+ *      The size of the buffer.
+ *  @return
+ *      The length of the decoded data.
+ */
+size_t TraversePrivate::inner_as_base64(uint8_t *out, const size_t n) {
+    size_t length = 0U;
+    xap::core::json::Status status;
+    if (!this->try_inner_as_base64(out, n, &length, &status)) {
+        status.raise();
+    }
+    return length;
+}
+
+/**
+ *  Copy the inner object into a Json::Value.
+ * 
+ *  @return
+ *      The value.
+ */
+Json::Value TraversePrivate::to_value() const {
+    return this->m_document->to_value(this->m_node);
+}
+
+//
+//  TraversePrivate public methods (non-throwing).
+//
+
+/**
+ *  Check the type of inner object (without throwing).
+ * 
+ *  @param type
+ *      The expected type.
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
+ *  @return
+ *      False if the type is neither null nor the expected one.
+ */
+bool TraversePrivate::try_type_of(
+    const xap::core::json::Type &type,
+    xap::core::json::Status *status
+) {
+    if (
+        this->m_type == xap::core::json::Type::null || 
+        this->m_type == type
+    ) {
+        return true;
+    }
+    return this->fail(
+        "Invalid object value.",
+        xap::core::json::ERROR_TYPE,
+        nullptr,
+        0U,
+        status
+    );
+}
+
+/**
+ *  Check that the inner object is not null (without throwing).
+ * 
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
+ *  @return
+ *      False if the inner is null.
+ */
+bool TraversePrivate::try_not_null(xap::core::json::Status *status) {
+    if (this->m_type != xap::core::json::Type::null) {
+        return true;
+    }
+    return this->fail(
+        "Value shoud not be null.",
+        xap::core::json::ERROR_TYPE,
+        nullptr,
+        0U,
+        status
+    );
+}
+
+/**
+ *  Go to sub directory (without throwing).
+ * 
+ *  @throw std::bad_alloc
+ *      Raised if memory allocation was failed.
+ *  @param name
+ *      The name (key) of sub directory.
+ *  @param out
+ *      The object to receive the sub directory (can be this object, unchanged
+ *      if failed).
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
+ *  @return
+ *      False if the inner is null, is not an object or the sub path is not
+ *      existed.
+ */
+bool TraversePrivate::try_sub(
+    const std::string &name,
+    xap::core::json::TraversePrivate *out,
+    xap::core::json::Status *status
+) {
+    //  Check type.
+    if (
+        !this->try_not_null(status) || 
+        !this->try_type_of(xap::core::json::Type::object, status)
+    ) {
+        return false;
+    }
+
+    //  Find sub item (the sub path is created only if it exists).
+    xap::core::json::Node sub_node;
+    if (!this->m_document->find_member(
+        this->m_node,
+        name.c_str(),
+        name.size(),
+        &sub_node
+    )) {
+        return this->fail(
+            "Sub path is not existed.",
+            xap::core::json::ERROR_NOTFIND,
+            name.data(),
+            name.size(),
+            status
+        );
+    }
+
+    *out = xap::core::json::TraversePrivate(
+        this->m_document,
+        sub_node,
+        this->member_path(sub_node, name)
+    );
+    return true;
+}
+
+/**
+ *  Go to the value that a JSON pointer refers to (without throwing).
+ * 
+ *  @throw std::bad_alloc
+ *      Raised if memory allocation was failed.
+ *  @param pointer
+ *      The compiled pointer.
+ *  @param out
+ *      The object to receive the value (can be this object, unchanged if
+ *      failed).
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
+ *  @return
+ *      False in the situations that TraversePrivate::at() throws.
+ */
+bool TraversePrivate::try_at(
+    const xap::core::json::Pointer &pointer,
+    xap::core::json::TraversePrivate *out,
+    xap::core::json::Status *status
+) {
+    const xap::core::json::PointerPrivate &compiled = *(pointer.m_pointer);
+    if (compiled.get_segments().empty()) {
+        if (out != this) {
+            *out = *this;
+        }
+        return true;
+    }
+
+    xap::core::json::Node node;
+    if (!this->locate(compiled, false, &node, status)) {
+        return false;
+    }
+    *out = xap::core::json::TraversePrivate(
+        this->m_document,
+        node,
+        this->pointer_path(pointer.m_pointer, compiled.get_path().size())
+    );
+    return true;
+}
+
+/**
+ *  Validate the inner object against a schema (without throwing).
+ * 
+ *  @param schema
+ *      The schema.
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
+ *  @return
+ *      False in the situations that TraversePrivate::validate() throws.
+ */
+bool TraversePrivate::try_validate(
+    const xap::core::json::Schema &schema,
+    xap::core::json::Status *status
+) const {
+    if (this->m_type == xap::core::json::Type::null) {
+        return this->fail_schema(
+            "Value shoud not be null.",
+            xap::core::json::ERROR_TYPE,
+            nullptr,
+            status
+        );
+    }
+    if (this->m_type != xap::core::json::Type::object) {
+        return this->fail_schema(
+            "Invalid object value.",
+            xap::core::json::ERROR_TYPE,
+            nullptr,
+            status
+        );
+    }
+    return this->check_members(
+        *(schema.m_schema),
+        this->m_node,
+        nullptr,
+        status
+    );
+}
+
+/**
+ *  Bind a structure to the inner object (without throwing).
+ * 
+ *  @param table
+ *      The binding table of the structure.
+ *  @param object
+ *      The structure (partially written if failed).
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
+ *  @return
+ *      False in the situations that BindTable::bind() throws.
+ */
+bool TraversePrivate::try_bind(
+    const xap::core::json::BindTable &table,
+    void *object,
+    xap::core::json::Status *status
+) const {
+    if (this->m_type == xap::core::json::Type::null) {
+        return this->fail_schema(
+            "Value shoud not be null.",
+            xap::core::json::ERROR_TYPE,
+            nullptr,
+            status
+        );
+    }
+    if (this->m_type != xap::core::json::Type::object) {
+        return this->fail_schema(
+            "Invalid object value.",
+            xap::core::json::ERROR_TYPE,
+            nullptr,
+            status
+        );
+    }
+    const xap::core::json::BindTablePrivate &table_private =
+        *(table.m_table);
+    xap::core::json::BindScan scan;
+    scan.table = &table_private;
+    scan.fields = nullptr;
+    scan.count = table_private.get_entries().size();
+    scan.object = object;
+    scan.frame = nullptr;
+    scan.status = status;
+    return this->bind_members(scan, this->m_node);
+}
+
+/**
+ *  Extract multiple members of the inner object (without throwing).
+ * 
+ *  @param fields
+ *      The fields.
+ *  @param count
+ *      The count of fields.
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
+ *  @return
+ *      False in the situations that TraversePrivate::extract() throws.
+ */
+bool TraversePrivate::try_extract(
+    const xap::core::json::ExtractField *fields,
+    const size_t count,
+    xap::core::json::Status *status
+) const {
+    if (this->m_type == xap::core::json::Type::null) {
+        return this->fail_schema(
+            "Value shoud not be null.",
+            xap::core::json::ERROR_TYPE,
+            nullptr,
+            status
+        );
+    }
+    if (this->m_type != xap::core::json::Type::object) {
+        return this->fail_schema(
+            "Invalid object value.",
+            xap::core::json::ERROR_TYPE,
+            nullptr,
+            status
+        );
+    }
+    xap::core::json::BindScan scan;
+    scan.table = nullptr;
+    scan.fields = fields;
+    scan.count = count;
+    scan.object = nullptr;
+    scan.frame = nullptr;
+    scan.status = status;
+    return this->bind_members(scan, this->m_node);
+}
+
+/**
+ *  Get the length of an array (without throwing).
+ * 
+ *  @param length
+ *      The pointer to receive the length.
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
+ *  @return
+ *      False if the inner is null or is not an array.
+ */
+bool TraversePrivate::try_array_get_length(
+    size_t *length,
+    xap::core::json::Status *status
+) {
+    if (
+        !this->try_not_null(status) || 
+        !this->try_type_of(xap::core::json::Type::array, status)
+    ) {
+        return false;
+    }
+    *length = this->m_document->get_size(this->m_node);
+    return true;
+}
+
+/**
+ *  Get inner as a signed integer (without throwing).
+ * 
+ *  @param value
+ *      The pointer to receive the inner.
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
+ *  @return
+ *      False if the inner is null or is not a signed integer.
+ */
+bool TraversePrivate::try_inner_as_int(
+    int *value,
+    xap::core::json::Status *status
+) {
+    if (!this->try_not_null(status)) {
+        return false;
+    }
+    if (
+        this->m_type != xap::core::json::Type::numeric ||
+        !this->m_document->get_number(this->m_node).is_int()
+    ) {
+        return this->fail(
+            "Value should be integer.",
+            xap::core::json::ERROR_TYPE,
+            nullptr,
+            0U,
+            status
+        );
+    }
+    *value = this->m_document->get_number(this->m_node).as_int();
+    return true;
+}
+
+/**
+ *  Get inner as an unsigned integer (without throwing).
+ * 
+ *  @param value
+ *      The pointer to receive the inner.
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
+ *  @return
+ *      False if the inner is null or is not an unsigned integer.
+ */
+bool TraversePrivate::try_inner_as_uint(
+    uint *value,
+    xap::core::json::Status *status
+) {
+    if (!this->try_not_null(status)) {
+        return false;
+    }
+    if (
+        this->m_type != xap::core::json::Type::numeric ||
+        !this->m_document->get_number(this->m_node).is_uint()
+    ) {
+        return this->fail(
+            "Value should be integer.",
+            xap::core::json::ERROR_TYPE,
+            nullptr,
+            0U,
+            status
+        );
+    }
+    *value = this->m_document->get_number(this->m_node).as_uint();
+    return true;
+}
+
+#if defined(XAPCORE_JSON_INT64)
+
+/**
+ *  Get inner as a signed 64-bit integer (without throwing).
+ * 
+ *  @param value
+ *      The pointer to receive the inner.
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
+ *  @return
+ *      False if the inner is null or is not a signed 64-bit integer.
  */
-bool TraversePrivate::inner_as_boolean() {
-    this->not_null().boolean();
-    return this->m_inner.asBool();
+bool TraversePrivate::try_inner_as_int64(
+    int64_t *value,
+    xap::core::json::Status *status
+) {
+    if (!this->try_not_null(status)) {
+        return false;
+    }
+    if (
+        this->m_type != xap::core::json::Type::numeric ||
+        !this->m_document->get_number(this->m_node).is_int64()
+    ) {
+        return this->fail(
+            "Value should be integer.",
+            xap::core::json::ERROR_TYPE,
+            nullptr,
+            0U,
+            status
+        );
+    }
+    *value = this->m_document->get_number(this->m_node).as_int64();
+    return true;
 }
 
 /**
- *  Get the inner as string.
+ *  Get inner as an unsigned 64-bit integer (without throwing).
  * 
- *  @throw xap::core::json::Exception
- *      Raised in the following situations:
- *
- *          - xap::core::json::ERROR_TYPE:
- *              The inner is null.
+ *  @param value
+ *      The pointer to receive the inner.
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
+ *  @return
+ *      False if the inner is null or is not an unsigned 64-bit integer.
+ */
+bool TraversePrivate::try_inner_as_uint64(
+    uint64_t *value,
+    xap::core::json::Status *status
+) {
+    if (!this->try_not_null(status)) {
+        return false;
+    }
+    if (
+        this->m_type != xap::core::json::Type::numeric ||
+        !this->m_document->get_number(this->m_node).is_uint64()
+    ) {
+        return this->fail(
+            "Value should be unsigned 64-bit integer.",
+            xap::core::json::ERROR_TYPE,
+            nullptr,
+            0U,
+            status
+        );
+    }
+    *value = this->m_document->get_number(this->m_node).as_uint64();
+    return true;
+}
+
+#endif  //  #if defined(XAPCORE_JSON_INT64)
+
+/**
+ *  Get inner as float (without throwing).
  * 
- *          - xap::core::json::ERROR_TYPE:
- *              The inner is not a string.
+ *  @param value
+ *      The pointer to receive the inner.
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
+ *  @return
+ *      False if the inner is null or is not numeric.
+ */
+bool TraversePrivate::try_inner_as_float(
+    float *value,
+    xap::core::json::Status *status
+) {
+    if (
+        !this->try_not_null(status) || 
+        !this->try_type_of(xap::core::json::Type::numeric, status)
+    ) {
+        return false;
+    }
+    *value = this->m_document->get_number(this->m_node).as_float();
+    return true;
+}
+
+/**
+ *  Get inner as double (without throwing).
  * 
+ *  @param value
+ *      The pointer to receive the inner.
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
  *  @return
- *      The inner.
+ *      False if the inner is null or is not numeric.
  */
-std::string TraversePrivate::inner_as_string() {
-    this->not_null().string();
-    return this->m_inner.asString();
+bool TraversePrivate::try_inner_as_double(
+    double *value,
+    xap::core::json::Status *status
+) {
+    if (
+        !this->try_not_null(status) || 
+        !this->try_type_of(xap::core::json::Type::numeric, status)
+    ) {
+        return false;
+    }
+    *value = this->m_document->get_number(this->m_node).as_double();
+    return true;
 }
 
-//
-//  TraversePrivate private methods.
-//
+/**
+ *  Get inner as a boolean (without throwing).
+ * 
+ *  @param value
+ *      The pointer to receive the inner.
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
+ *  @return
+ *      False if the inner is null or is not a boolean.
+ */
+bool TraversePrivate::try_inner_as_boolean(
+    bool *value,
+    xap::core::json::Status *status
+) {
+    if (
+        !this->try_not_null(status) || 
+        !this->try_type_of(xap::core::json::Type::boolean, status)
+    ) {
+        return false;
+    }
+    *value = this->m_document->get_boolean(this->m_node);
+    return true;
+}
 
 /**
- *  Get the path of specific sub directory.
+ *  Get inner as string (without throwing).
  * 
- *  @param name 
- *      The name of sub directory.
+ *  @throw std::bad_alloc
+ *      Raised if memory allocation was failed.
+ *  @param value
+ *      The pointer to receive the inner.
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
  *  @return
- *      The sub path.
+ *      False if the inner is null or is not a string.
  */
-std::string TraversePrivate::get_sub_path(const std::string &name) const {
-    if (this->m_path.size() == 0U || *(this->m_path.end() - 1U) == '/') {
-        return m_path + name;
-    } else {
-        return m_path + std::string("/") + name;
+bool TraversePrivate::try_inner_as_string(
+    std::string *value,
+    xap::core::json::Status *status
+) {
+    xap::core::json::StringView view;
+    if (!this->try_inner_as_string_view(&view, status)) {
+        return false;
     }
+    value->assign(view.data(), view.size());
+    return true;
 }
 
 /**
- *  Get the path of specific sub directory.
+ *  Get the inner as string without copying it (without throwing).
  * 
- *  @param index 
- *      The index of sub directory.
+ *  @param value
+ *      The pointer to receive the inner (refers to the storage of the
+ *      document).
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
+ *  @return
+ *      False if the inner is null or is not a string.
+ */
+bool TraversePrivate::try_inner_as_string_view(
+    xap::core::json::StringView *value,
+    xap::core::json::Status *status
+) {
+    if (
+        !this->try_not_null(status) || 
+        !this->try_type_of(xap::core::json::Type::string, status)
+    ) {
+        return false;
+    }
+
+    const char *begin;
+    const char *end;
+    this->m_document->get_string(this->m_node, &begin, &end);
+    *value = xap::core::json::StringView(
+        begin,
+        static_cast<size_t>(end - begin)
+    );
+    return true;
+}
+
+/**
+ *  Get the items of the inner array (in bulk, without throwing).
+ * 
+ *  @param out
+ *      The buffer to receive the items (at least n items).
+ *  @param n
+ *      The size of the buffer.
+ *  @param length
+ *      The pointer to receive the length of the array (nullptr if not
+ *      needed).
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
+ *  @return
+ *      False in the situations that TraversePrivate::inner_as_array()
+ *      throws.
+ */
+template <typename T>
+bool TraversePrivate::try_inner_as_array(
+    T *out,
+    const size_t n,
+    size_t *length,
+    xap::core::json::Status *status
+) const {
+    if (this->m_type == xap::core::json::Type::null) {
+        return this->fail_schema(
+            "Value shoud not be null.",
+            xap::core::json::ERROR_TYPE,
+            nullptr,
+            status
+        );
+    }
+    if (this->m_type != xap::core::json::Type::array) {
+        return this->fail_schema(
+            "Invalid object value.",
+            xap::core::json::ERROR_TYPE,
+            nullptr,
+            status
+        );
+    }
+
+    const xap::core::json::Document *document = this->m_document.get();
+    const size_t size = document->get_size(this->m_node);
+    if (length) {
+        *length = size;
+    }
+
+    //  Read and convert the items chunk by chunk (each chunk takes one call
+    //  into the document and one conversion loop).
+    const size_t limit = n < size ? n : size;
+    xap::core::json::Number numbers[TRAVERSE_ARRAY_CHUNK_SIZE];
+    for (size_t first = 0U; first < limit; first += TRAVERSE_ARRAY_CHUNK_SIZE) {
+        const size_t count = (
+            limit - first < TRAVERSE_ARRAY_CHUNK_SIZE ?
+                limit - first :
+                TRAVERSE_ARRAY_CHUNK_SIZE
+        );
+        const size_t numeric = document->get_numbers(
+            this->m_node,
+            first,
+            count,
+            numbers
+        );
+        const size_t converted = xap::core::json::Number::convert(
+            numbers,
+            numeric,
+            out + first
+        );
+        if (converted == count) {
+            continue;
+        }
+
+        //  The item is null, is not numeric or doesn't fit.
+        const size_t index = first + converted;
+        const xap::core::json::SchemaFrame item_frame = {
+            nullptr,
+            nullptr,
+            0U,
+            index
+        };
+        const char *message = get_item_message(out);
+        if (
+            converted == numeric &&
+            document->get_type(
+                document->get_element(this->m_node, index)
+            ) == xap::core::json::Type::null
+        ) {
+            message = "Value shoud not be null.";
+        }
+        return this->fail_schema(
+            message,
+            xap::core::json::ERROR_TYPE,
+            &item_frame,
+            status
+        );
+    }
+    return true;
+}
+
+/**
+ *  Decode the inner base64 string into a buffer (without throwing).
+ * 
+ *  @param out
+ *      The buffer to receive the decoded bytes (at least n bytes).
+ *  @param n
+ *      The size of the buffer.
+ *  @param length
+ *      The pointer to receive the length of the decoded data (nullptr if not
+ *      needed).
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
  *  @return
- *      The sub path.
+ *      False in the situations that TraversePrivate::inner_as_base64()
+ *      throws.
  */
-std::string TraversePrivate::get_sub_path(const size_t index) const {
-    if (this->m_path.size() == 0U || *(this->m_path.end() - 1U) == '/') {
-        return m_path + std::to_string(index);
+bool TraversePrivate::try_inner_as_base64(
+    uint8_t *out,
+    const size_t n,
+    size_t *length,
+    xap::core::json::Status *status
+) {
+    if (
+        !this->try_not_null(status) || 
+        !this->try_type_of(xap::core::json::Type::string, status)
+    ) {
+        return false;
+    }
+
+    const char *begin;
+    const char *end;
+    this->m_document->get_string(this->m_node, &begin, &end);
+    size_t data_length = 0U;
+    size_t size = 0U;
+    if (!xap::core::json::Base64Decoder::measure(
+        begin,
+        static_cast<size_t>(end - begin),
+        &data_length,
+        &size
+    )) {
+        return this->fail(
+            "Invalid base64 value.",
+            xap::core::json::ERROR_TYPE,
+            nullptr,
+            0U,
+            status
+        );
+    }
+    if (length) {
+        *length = size;
+    }
+
+    static const xap::core::json::Base64Decoder decoder;
+    bool valid = true;
+    if (n >= size) {
+        valid = decoder.decode(begin, data_length, out);
     } else {
-        return m_path + std::string("/") + std::to_string(index);
+        //  Decode chunk by chunk into a small buffer and keep the leading
+        //  bytes (the rest of the string is still validated).
+        uint8_t chunk[TRAVERSE_BASE64_CHUNK_SIZE / 4U * 3U];
+        for (
+            size_t position = 0U;
+            valid && position < data_length;
+            position += TRAVERSE_BASE64_CHUNK_SIZE
+        ) {
+            const size_t piece = (
+                data_length - position < TRAVERSE_BASE64_CHUNK_SIZE ?
+                    data_length - position :
+                    TRAVERSE_BASE64_CHUNK_SIZE
+            );
+            valid = decoder.decode(begin + position, piece, chunk);
+            const size_t offset = position / 4U * 3U;
+            if (offset < n) {
+                const size_t piece_size = piece * 3U / 4U;
+                memcpy(
+                    out + offset,
+                    chunk,
+                    n - offset < piece_size ? n - offset : piece_size
+                );
+            }
+        }
+    }
+    if (!valid) {
+        return this->fail(
+            "Invalid base64 value.",
+            xap::core::json::ERROR_TYPE,
+            nullptr,
+            0U,
+            status
+        );
     }
+    return true;
 }
 
+//
+//  TraversePrivate private methods.
+//
+
 /**
  *  Get the inner type.
  * 
@@ -1921,28 +4634,741 @@ std::string TraversePrivate::get_sub_path(const size_t index) const {
  *      The type of inner object.
  */
 xap::core::json::Type TraversePrivate::get_inner_type() const {
-    switch (this->m_inner.type()) {
-        case Json::nullValue:
-            return xap::core::json::Type::null;
-        case Json::intValue:
-        case Json::uintValue:
-        case Json::realValue:
-            return xap::core::json::Type::numeric;
-        case Json::stringValue:
-            return xap::core::json::Type::string;
-        case Json::booleanValue:
-            return xap::core::json::Type::boolean;
-        case Json::arrayValue:
-            return xap::core::json::Type::array;
-        case Json::objectValue:
-            return xap::core::json::Type::object;
+    return this->m_document->get_type(this->m_node);
+}
+
+/**
+ *  Report an error to a status.
+ * 
+ *  @param message
+ *      The error message (a static string).
+ *  @param code
+ *      The error code.
+ *  @param segment
+ *      The segment to be appended to the path of this object (nullptr if the
+ *      error is about this object).
+ *  @param segment_len
+ *      The length of the segment.
+ *  @param status
+ *      The status (nullptr if not needed).
+ *  @return
+ *      False.
+ */
+bool TraversePrivate::fail(
+    const char *message,
+    const uint16_t code,
+    const char *segment,
+    const size_t segment_len,
+    xap::core::json::Status *status
+) const {
+    if (status == nullptr) {
+        return false;
+    }
+    status->m_message = message;
+    status->m_code = code;
+
+    //  Render the path the way xap::core::json::Path does (the buffer is
+    //  reused).
+    std::string &out = status->m_path;
+    out.clear();
+    this->m_path.render(out);
+    if (segment != nullptr) {
+        if (out.size() != 0U && *(out.end() - 1U) != '/') {
+            out.push_back('/');
+        }
+        out.append(segment, segment_len);
+    }
+    return false;
+}
+
+/**
+ *  Report an error of a schema check to a status.
+ * 
+ *  @param message
+ *      The error message (a static string).
+ *  @param code
+ *      The error code.
+ *  @param frame
+ *      The frame of the value that failed (nullptr for this object).
+ *  @param status
+ *      The status (nullptr if not needed).
+ *  @return
+ *      False.
+ */
+bool TraversePrivate::fail_schema(
+    const char *message,
+    const uint16_t code,
+    const xap::core::json::SchemaFrame *frame,
+    xap::core::json::Status *status
+) const {
+    if (status == nullptr) {
+        return false;
+    }
+    status->m_message = message;
+    status->m_code = code;
+
+    //  The buffer is reused.
+    std::string &out = status->m_path;
+    out.clear();
+    this->m_path.render(out);
+    xap::core::json::SchemaPrivate::render(frame, out);
+    return false;
+}
+
+/**
+ *  Check the members of an object node against a schema.
+ * 
+ *  @param schema
+ *      The schema.
+ *  @param node
+ *      The object node.
+ *  @param frame
+ *      The frame of the node (nullptr for this object).
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
+ *  @return
+ *      False if a check failed.
+ */
+bool TraversePrivate::check_members(
+    const xap::core::json::SchemaPrivate &schema,
+    const xap::core::json::Node node,
+    const xap::core::json::SchemaFrame *frame,
+    xap::core::json::Status *status
+) const {
+    const xap::core::json::Document *document = this->m_document.get();
+    for (const xap::core::json::SchemaField &field : schema.get_fields()) {
+        const xap::core::json::SchemaFrame member_frame = {
+            frame,
+            field.key.data(),
+            field.key.size(),
+            0U
+        };
+        xap::core::json::Node member;
+        if (!document->find_member_hashed(
+            node,
+            field.key.data(),
+            field.key.size(),
+            field.key_hash,
+            &member
+        )) {
+            if (!field.required) {
+                continue;
+            }
+            return this->fail_schema(
+                "Sub path is not existed.",
+                xap::core::json::ERROR_NOTFIND,
+                &member_frame,
+                status
+            );
+        }
+        if (!this->check_field(field, member, &member_frame, status)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ *  Check a value against a field of a schema.
+ * 
+ *  @param field
+ *      The field.
+ *  @param node
+ *      The node of the value.
+ *  @param frame
+ *      The frame of the value.
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
+ *  @return
+ *      False if a check failed.
+ */
+bool TraversePrivate::check_field(
+    const xap::core::json::SchemaField &field,
+    const xap::core::json::Node node,
+    const xap::core::json::SchemaFrame *frame,
+    xap::core::json::Status *status
+) const {
+    const xap::core::json::Document *document = this->m_document.get();
+    const xap::core::json::Type type = document->get_type(node);
+
+    //  Check type (the messages match the type checks of traverse objects).
+    if (type == xap::core::json::Type::null) {
+        if (!field.required) {
+            return true;
+        }
+        return this->fail_schema(
+            "Value shoud not be null.",
+            xap::core::json::ERROR_TYPE,
+            frame,
+            status
+        );
+    }
+    if (field.type == xap::core::json::Type::null) {
+        return true;
+    }
+    if (type != field.type) {
+        return this->fail_schema(
+            "Invalid object value.",
+            xap::core::json::ERROR_TYPE,
+            frame,
+            status
+        );
+    }
+
+    switch (type) {
+        case xap::core::json::Type::numeric: {
+            if (field.width == xap::core::json::Width::any) {
+                return true;
+            }
+            const xap::core::json::Number number = document->get_number(node);
+            bool fit;
+            switch (field.width) {
+                case xap::core::json::Width::int32:
+                    fit = number.is_int();
+                    break;
+                case xap::core::json::Width::uint32:
+                    fit = number.is_uint();
+                    break;
+                case xap::core::json::Width::int64:
+                    fit = number.is_int64();
+                    break;
+                default:
+                    fit = number.is_uint64();
+                    break;
+            }
+            if (fit) {
+                return true;
+            }
+            return this->fail_schema(
+                field.width == xap::core::json::Width::uint64 ?
+                    "Value should be unsigned 64-bit integer." :
+                    "Value should be integer.",
+                xap::core::json::ERROR_TYPE,
+                frame,
+                status
+            );
+        }
+        case xap::core::json::Type::object:
+            if (!field.schema) {
+                return true;
+            }
+            return this->check_members(*(field.schema), node, frame, status);
+        case xap::core::json::Type::array: {
+            if (!field.schema) {
+                return true;
+            }
+
+            //  Each item is an object checked by the nested schema.
+            const size_t count = document->get_size(node);
+            for (size_t i = 0U; i < count; ++i) {
+                const xap::core::json::SchemaFrame item_frame = {
+                    frame,
+                    nullptr,
+                    0U,
+                    i
+                };
+                const xap::core::json::Node item =
+                    document->get_element(node, i);
+                const xap::core::json::Type item_type =
+                    document->get_type(item);
+                if (item_type == xap::core::json::Type::null) {
+                    return this->fail_schema(
+                        "Value shoud not be null.",
+                        xap::core::json::ERROR_TYPE,
+                        &item_frame,
+                        status
+                    );
+                }
+                if (item_type != xap::core::json::Type::object) {
+                    return this->fail_schema(
+                        "Invalid object value.",
+                        xap::core::json::ERROR_TYPE,
+                        &item_frame,
+                        status
+                    );
+                }
+                if (!this->check_members(
+                    *(field.schema),
+                    item,
+                    &item_frame,
+                    status
+                )) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        default:
+            return true;
+    }
+}
+
+/**
+ *  Bind the fields of a scan to the members of an object node (in one
+ *  scan).
+ * 
+ *  @param scan
+ *      The scan (the fields, the structure, the frame and the status are
+ *      set by the caller).
+ *  @param node
+ *      The object node.
+ *  @return
+ *      False if failed.
+ */
+bool TraversePrivate::bind_members(
+    xap::core::json::BindScan &scan,
+    const xap::core::json::Node node
+) const {
+    std::unique_ptr<bool[]> seen_more;
+    if (scan.count > 64U) {
+        seen_more.reset(new bool[scan.count]());
+    }
+    scan.traverse = this;
+    scan.seen = 0U;
+    scan.seen_more = seen_more.get();
+    scan.failed = false;
+
+    //  Dispatch each member to its field.
+    this->m_document->foreach_member(
+        node,
+        &TraversePrivate::bind_member,
+        &scan
+    );
+    if (scan.failed) {
+        return false;
+    }
+
+    //  Check the required fields that were not seen.
+    for (size_t i = 0U; i < scan.count; ++i) {
+        const xap::core::json::BindTable::Entry &entry =
+            get_scan_entry(scan, i);
+        if (!entry.required) {
+            continue;
+        }
+        const bool seen = (
+            seen_more ?
+                seen_more[i] :
+                (scan.seen & (static_cast<uint64_t>(1U) << i)) != 0U
+        );
+        if (!seen) {
+            const xap::core::json::SchemaFrame member_frame = {
+                scan.frame,
+                entry.key,
+                entry.key_length,
+                0U
+            };
+            return this->fail_schema(
+                "Sub path is not existed.",
+                xap::core::json::ERROR_NOTFIND,
+                &member_frame,
+                scan.status
+            );
+        }
+    }
+    return true;
+}
+
+/**
+ *  Bind a member to its field (see Document::foreach_member()).
+ * 
+ *  @param context
+ *      The scan (xap::core::json::BindScan).
+ *  @param key
+ *      The key of the member.
+ *  @param key_len
+ *      The length of the key.
+ *  @param member
+ *      The node of the member.
+ *  @return
+ *      False if failed.
+ */
+bool TraversePrivate::bind_member(
+    void *context,
+    const char *key,
+    const size_t key_len,
+    const xap::core::json::Node member
+) {
+    xap::core::json::BindScan *scan =
+        static_cast<xap::core::json::BindScan*>(context);
+
+    //  Bound structures dispatch by the hash table, extracted fields (only
+    //  a few usually) are matched one by one.
+    size_t index;
+    if (scan->table) {
+        index = scan->table->find(key, key_len);
+        if (index == xap::core::json::BindTablePrivate::NPOS) {
+            return true;
+        }
+    } else {
+        for (index = 0U; index < scan->count; ++index) {
+            const xap::core::json::BindTable::Entry &entry =
+                scan->fields[index].get_entry();
+            if (
+                entry.key_length == key_len &&
+                memcmp(entry.key, key, key_len) == 0
+            ) {
+                break;
+            }
+        }
+        if (index == scan->count) {
+            return true;
+        }
+    }
+    if (scan->seen_more) {
+        scan->seen_more[index] = true;
+    } else {
+        scan->seen |= static_cast<uint64_t>(1U) << index;
+    }
+
+    const xap::core::json::BindTable::Entry &entry =
+        get_scan_entry(*scan, index);
+    const xap::core::json::SchemaFrame member_frame = {
+        scan->frame,
+        entry.key,
+        entry.key_length,
+        0U
+    };
+    if (!scan->traverse->bind_value(
+        entry,
+        member,
+        scan->object,
+        &member_frame,
+        scan->status
+    )) {
+        scan->failed = true;
+        return false;
+    }
+    return true;
+}
+
+/**
+ *  Convert a value and write it to a field of a structure.
+ * 
+ *  @param entry
+ *      The entry of the field.
+ *  @param node
+ *      The node of the value.
+ *  @param object
+ *      The structure.
+ *  @param frame
+ *      The frame of the value.
+ *  @param status
+ *      The status to receive the error (nullptr if not needed).
+ *  @return
+ *      False if failed.
+ */
+bool TraversePrivate::bind_value(
+    const xap::core::json::BindTable::Entry &entry,
+    const xap::core::json::Node node,
+    void *object,
+    const xap::core::json::SchemaFrame *frame,
+    xap::core::json::Status *status
+) const {
+    const xap::core::json::Document *document = this->m_document.get();
+    const xap::core::json::Type type = document->get_type(node);
+
+    //  Null values are skipped for optional fields.
+    if (type == xap::core::json::Type::null) {
+        if (!entry.required) {
+            return true;
+        }
+        return this->fail_schema(
+            "Value shoud not be null.",
+            xap::core::json::ERROR_TYPE,
+            frame,
+            status
+        );
+    }
+
+    //  Convert (the messages match the accessors of traverse objects).
+    void *target = entry.locate(entry.field, object);
+    switch (entry.kind) {
+        case xap::core::json::BindTable::Kind::int_value:
+        case xap::core::json::BindTable::Kind::uint_value:
+        case xap::core::json::BindTable::Kind::int64_value:
+        case xap::core::json::BindTable::Kind::uint64_value: {
+            if (type == xap::core::json::Type::numeric) {
+                const xap::core::json::Number number =
+                    document->get_number(node);
+                switch (entry.kind) {
+                    case xap::core::json::BindTable::Kind::int_value:
+                        if (number.is_int()) {
+                            *static_cast<int*>(target) = number.as_int();
+                            return true;
+                        }
+                        break;
+                    case xap::core::json::BindTable::Kind::uint_value:
+                        if (number.is_uint()) {
+                            *static_cast<uint*>(target) = number.as_uint();
+                            return true;
+                        }
+                        break;
+                    case xap::core::json::BindTable::Kind::int64_value:
+                        if (number.is_int64()) {
+                            *static_cast<int64_t*>(target) =
+                                number.as_int64();
+                            return true;
+                        }
+                        break;
+                    default:
+                        if (number.is_uint64()) {
+                            *static_cast<uint64_t*>(target) =
+                                number.as_uint64();
+                            return true;
+                        }
+                        break;
+                }
+            }
+            return this->fail_schema(
+                entry.kind == xap::core::json::BindTable::Kind::uint64_value ?
+                    "Value should be unsigned 64-bit integer." :
+                    "Value should be integer.",
+                xap::core::json::ERROR_TYPE,
+                frame,
+                status
+            );
+        }
+        case xap::core::json::BindTable::Kind::float_value:
+            if (type != xap::core::json::Type::numeric) {
+                break;
+            }
+            *static_cast<float*>(target) =
+                document->get_number(node).as_float();
+            return true;
+        case xap::core::json::BindTable::Kind::double_value:
+            if (type != xap::core::json::Type::numeric) {
+                break;
+            }
+            *static_cast<double*>(target) =
+                document->get_number(node).as_double();
+            return true;
+        case xap::core::json::BindTable::Kind::boolean_value:
+            if (type != xap::core::json::Type::boolean) {
+                break;
+            }
+            *static_cast<bool*>(target) = document->get_boolean(node);
+            return true;
+        case xap::core::json::BindTable::Kind::string_value: {
+            if (type != xap::core::json::Type::string) {
+                break;
+            }
+            const char *begin;
+            const char *end;
+            document->get_string(node, &begin, &end);
+            static_cast<std::string*>(target)->assign(begin, end);
+            return true;
+        }
         default:
-            throw xap::core::json::Exception(
-                "Unexpected JSON value type.",
-                xap::core::json::ERROR_BUG,
-                this->m_path.c_str()
+            if (type != xap::core::json::Type::object) {
+                break;
+            }
+            {
+                const xap::core::json::BindTablePrivate &nested =
+                    *(entry.nested->m_table);
+                xap::core::json::BindScan scan;
+                scan.table = &nested;
+                scan.fields = nullptr;
+                scan.count = nested.get_entries().size();
+                scan.object = target;
+                scan.frame = frame;
+                scan.status = status;
+                return this->bind_members(scan, node);
+            }
+    }
+    return this->fail_schema(
+        "Invalid object value.",
+        xap::core::json::ERROR_TYPE,
+        frame,
+        status
+    );
+}
+
+/**
+ *  Find the node that a JSON pointer refers to.
+ * 
+ *  @param pointer
+ *      The compiled pointer.
+ *  @param optional
+ *      Whether non-existed (or null) values on the way are allowed.
+ *  @param node
+ *      The pointer to receive the node.
+ *  @param status
+ *      The status to receive the error in the situations described by
+ *      TraversePrivate::at() (only the type errors if optional is true).
+ *  @return
+ *      False if failed or a value on the way is non-existed (or null) and
+ *      optional is true (the status is left unchanged).
+ */
+bool TraversePrivate::locate(
+    const xap::core::json::PointerPrivate &pointer,
+    const bool optional,
+    xap::core::json::Node *node,
+    xap::core::json::Status *status
+) const {
+    const xap::core::json::Document *document = this->m_document.get();
+    const char *path = pointer.get_path().data();
+    xap::core::json::Node current = this->m_node;
+    xap::core::json::Type type = this->m_type;
+    size_t path_end = 0U;
+    for (const xap::core::json::PointerSegment &segment :
+         pointer.get_segments()) {
+        bool found = false;
+        xap::core::json::Node next = current;
+        switch (type) {
+            case xap::core::json::Type::object:
+                found = document->find_member_hashed(
+                    current,
+                    segment.key.data(),
+                    segment.key.size(),
+                    segment.key_hash,
+                    &next
+                );
+                break;
+            case xap::core::json::Type::array:
+                found = (
+                    segment.is_index &&
+                    segment.index < document->get_size(current)
+                );
+                if (found) {
+                    next = document->get_element(current, segment.index);
+                }
+                break;
+            case xap::core::json::Type::null:
+                if (optional) {
+                    return false;
+                }
+                return this->fail(
+                    "Value shoud not be null.",
+                    xap::core::json::ERROR_TYPE,
+                    path_end == 0U ? nullptr : path,
+                    path_end,
+                    status
+                );
+            default:
+                return this->fail(
+                    "Invalid object value.",
+                    xap::core::json::ERROR_TYPE,
+                    path_end == 0U ? nullptr : path,
+                    path_end,
+                    status
+                );
+        }
+        if (!found) {
+            if (optional) {
+                return false;
+            }
+            return this->fail(
+                "Sub path is not existed.",
+                xap::core::json::ERROR_NOTFIND,
+                segment.path_end == 0U ? nullptr : path,
+                segment.path_end,
+                status
             );
+        }
+        current = next;
+        type = document->get_type(current);
+        path_end = segment.path_end;
+    }
+
+    //  A null value at the end is an existing value.
+    *node = current;
+    return true;
+}
+
+/**
+ *  Get the path of a member (found by find_member()).
+ * 
+ *  @note
+ *      The path borrows the key from the document if the document keeps it,
+ *      otherwise the name is copied.
+ *  @param member
+ *      The node of the member.
+ *  @param name
+ *      The name (key) of the member.
+ *  @return
+ *      The path.
+ */
+xap::core::json::Path TraversePrivate::member_path(
+    const xap::core::json::Node member,
+    const std::string &name
+) {
+    const char *key = nullptr;
+    size_t key_len = 0U;
+    if (this->m_document->get_member_key(member, &key, &key_len)) {
+        return this->m_path.child(
+            key,
+            key_len,
+            nullptr,
+            this->m_document->get_arena()
+        );
+    }
+    return this->m_path.child(name, this->m_document->get_arena());
+}
+
+/**
+ *  Get the path of a prefix of a JSON pointer.
+ * 
+ *  @note
+ *      The whole path of the pointer is borrowed (the path keeps the pointer
+ *      alive), a shorter prefix is copied.
+ *  @param pointer
+ *      The compiled pointer.
+ *  @param path_end
+ *      The end of the prefix within the path of the pointer.
+ *  @return
+ *      The path.
+ */
+xap::core::json::Path TraversePrivate::pointer_path(
+    const std::shared_ptr<const xap::core::json::PointerPrivate> &pointer,
+    const size_t path_end
+) {
+    if (path_end == 0U) {
+        return this->m_path;
+    }
+
+    //  All segments are rendered as one.
+    const std::string &path = pointer->get_path();
+    if (path_end == path.size()) {
+        return this->m_path.child(
+            path.data(),
+            path.size(),
+            pointer,
+            this->m_document->get_arena()
+        );
+    }
+    return this->m_path.child(
+        path.substr(0U, path_end),
+        this->m_document->get_arena()
+    );
+}
+
+/**
+ *  Make the inner object exclusively owned and modifiable (copy-on-write)
+ *  so that it can be modified without affecting other traverse objects.
+ * 
+ *  @return
+ *      The modifiable inner object.
+ */
+Json::Value *TraversePrivate::detach() {
+    if (this->m_document.use_count() == 1) {
+        Json::Value *inner = this->m_document->get_mutable_value(this->m_node);
+        if (inner != nullptr) {
+            return inner;
+        }
     }
+
+    //  Shared (or read-only) documents are copied.
+    //  The copy stays within the arena of the source.
+    std::shared_ptr<xap::core::json::ValueDocument> document = 
+        xap::core::json::make_document<xap::core::json::ValueDocument>(
+            this->m_document->get_arena(),
+            this->m_document->to_value(this->m_node)
+        );
+    document->set_key_table(this->m_document->get_key_table());
+    this->m_path.own_names(this->m_document->get_arena());
+    this->m_node = document->get_root();
+    this->m_document = document;
+    return &(document->root());
 }
 
 }  //  namespace json
@@ -11,11 +11,19 @@
 //  Imports.
 //
 #include "xap/core/json/build.h"
+#include "xap/core/json/status.h"
 #include "xap/core/json/traverse.h"
+#include "arena_p.h"
+#include "bind_p.h"
+#include "document_p.h"
+#include "path_p.h"
+#include "pointer_p.h"
+#include "schema_p.h"
 
 #include "json/json.h"
 
 #include <functional>
+#include <memory>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string>
@@ -42,47 +50,184 @@ public:
     /**
      *  Construct the object.
      * 
-     *  @throw xap::core::json::Exception
-     *      Raised if JSON parsing was failed (ERROR_PARAMETER).
-     *  @param data
-     *      The JSON data.
-     *  @param datalen
-     *      The length of JSON data.
+     *  @param value
+     *      The JSON value.
      *  @param path
      *      The path.
      */
     TraversePrivate(
-        const uint8_t *data, 
-        const size_t datalen,
+        const Json::Value &value,
         const std::string &path = "/"
     );
-    
+
     /**
-     *  Construct the object.
+     *  Construct the object (as a view of a node within a document).
      * 
-     *  @param value
-     *      The JSON value.
+     *  @param document
+     *      The document.
+     *  @param node
+     *      The node (must be owned by the document).
      *  @param path
      *      The path.
      */
     TraversePrivate(
-        const Json::Value &value,
-        const std::string &path = "/"
+        const std::shared_ptr<xap::core::json::Document> &document,
+        const xap::core::json::Node node,
+        const xap::core::json::Path &path
+    );
+
+    /**
+     *  Construct the object (as a view of a node within a document).
+     * 
+     *  @param document
+     *      The document.
+     *  @param node
+     *      The node (must be owned by the document).
+     *  @param path
+     *      The path (moved).
+     */
+    TraversePrivate(
+        const std::shared_ptr<xap::core::json::Document> &document,
+        const xap::core::json::Node node,
+        xap::core::json::Path &&path
     );
 
     /**
      *  Construct (Copy) the object.
      * 
+     *  @note
+     *      The copy shares the document with the source.
      *  @param src
      *      The source.
      */
     TraversePrivate(const TraversePrivate &src);
 
+    /**
+     *  Construct (Move) the object.
+     * 
+     *  @param src
+     *      The source.
+     */
+    TraversePrivate(TraversePrivate &&src) noexcept;
+
     /**
      *  Destruct the object.
      */
     virtual ~TraversePrivate() noexcept;
 
+    //
+    //  Operators.
+    //
+
+    /**
+     *  Assign (Copy) the object.
+     * 
+     *  @note
+     *      The object shares the document with the source.
+     *  @param src
+     *      The source.
+     *  @return
+     *      Self.
+     */
+    xap::core::json::TraversePrivate &operator=(const TraversePrivate &src);
+
+    /**
+     *  Assign (Move) the object.
+     * 
+     *  @param src
+     *      The source.
+     *  @return
+     *      Self.
+     */
+    xap::core::json::TraversePrivate &operator=(
+        TraversePrivate &&src
+    ) noexcept;
+
+    /**
+     *  Allocate memory for an object (from the heap).
+     *
+     *  @throw std::bad_alloc
+     *      Raised if memory allocation was failed.
+     *  @param size
+     *      The size of the object.
+     *  @return
+     *      The memory.
+     */
+    static void *operator new(const size_t size);
+
+    /**
+     *  Allocate memory for an object.
+     *
+     *  @note
+     *      The object keeps the arena alive until it is deleted.
+     *  @throw std::bad_alloc
+     *      Raised if memory allocation was failed.
+     *  @param size
+     *      The size of the object.
+     *  @param arena
+     *      The arena (nullptr to allocate from the heap).
+     *  @return
+     *      The memory.
+     */
+    static void *operator new(
+        const size_t size,
+        const std::shared_ptr<xap::core::json::ArenaPrivate> &arena
+    );
+
+    /**
+     *  Deallocate the memory of an object.
+     *
+     *  @param memory
+     *      The memory.
+     */
+    static void operator delete(void *memory) noexcept;
+
+    /**
+     *  Deallocate the memory of an object (if its constructor throws).
+     *
+     *  @param memory
+     *      The memory.
+     *  @param arena
+     *      The arena.
+     */
+    static void operator delete(
+        void *memory,
+        const std::shared_ptr<xap::core::json::ArenaPrivate> &arena
+    ) noexcept;
+
+    //
+    //  Public static functions.
+    //
+
+    /**
+     *  Allocate a copy of an object (from the arena of its document).
+     *
+     *  @throw std::bad_alloc
+     *      Raised if memory allocation was failed.
+     *  @param src
+     *      The source.
+     *  @return
+     *      The copy.
+     */
+    static std::unique_ptr<xap::core::json::TraversePrivate> create(
+        const TraversePrivate &src
+    );
+
+    /**
+     *  Allocate an object (from the arena of its document) and move another
+     *  object into it.
+     *
+     *  @throw std::bad_alloc
+     *      Raised if memory allocation was failed.
+     *  @param src
+     *      The source.
+     *  @return
+     *      The object.
+     */
+    static std::unique_ptr<xap::core::json::TraversePrivate> create(
+        TraversePrivate &&src
+    );
+
     //
     //  Public methods.
     //
@@ -345,6 +490,125 @@ public:
         const Json::Value &default_value
     );
 
+    /**
+     *  Go to sub directory which can be non-existed.
+     * 
+     *  @throw xap::core::json::Exception
+     *      Raised in the following situations:
+     *
+     *          - xap::core::json::ERROR_TYPE:
+     *              The inner is null.
+     * 
+     *          - xap::core::json::ERROR_TYPE:
+     *              The inner is not an object.
+     * 
+     *  @param name
+     *      The name (key) of sub directory.
+     *  @param default_value
+     *      The default value (shared, not copied) if the directory doesn't 
+     *      existed.
+     *  @return
+     *      Traverse object of sub directory.
+     */
+    xap::core::json::TraversePrivate optional_sub(
+        const std::string &name, 
+        const xap::core::json::TraversePrivate &default_value
+    );
+
+    /**
+     *  Go to the value that a JSON pointer refers to.
+     * 
+     *  @throw xap::core::json::Exception
+     *      Raised in the following situations:
+     *
+     *          - xap::core::json::ERROR_TYPE:
+     *              A value on the way is null.
+     * 
+     *          - xap::core::json::ERROR_TYPE:
+     *              A value on the way is neither an object nor an array.
+     *  
+     *          - xap::core::json::ERROR_NOTFIND:
+     *              A member (or an array item) is not existed.
+     * 
+     *  @param pointer
+     *      The compiled pointer.
+     *  @return
+     *      Traverse object of the value.
+     */
+    xap::core::json::TraversePrivate at(
+        const xap::core::json::Pointer &pointer
+    );
+
+    /**
+     *  Go to the value that a JSON pointer refers to, which can be
+     *  non-existed.
+     * 
+     *  @throw xap::core::json::Exception
+     *      Raised if a value on the way is neither an object nor an array
+     *      (xap::core::json::ERROR_TYPE).
+     *  @param pointer
+     *      The compiled pointer.
+     *  @return
+     *      Traverse object of the value.
+     */
+    xap::core::json::TraversePrivate optional_at(
+        const xap::core::json::Pointer &pointer
+    );
+
+    /**
+     *  Validate the inner object against a schema.
+     * 
+     *  @throw xap::core::json::Exception
+     *      Raised in the following situations (the path of the error is the
+     *      path of the first value that failed):
+     *
+     *          - xap::core::json::ERROR_TYPE:
+     *              The inner is null or is not an object.
+     * 
+     *          - xap::core::json::ERROR_TYPE:
+     *              A field is null (but required) or has another type.
+     *  
+     *          - xap::core::json::ERROR_NOTFIND:
+     *              A required field is not existed.
+     * 
+     *  @param schema
+     *      The schema.
+     *  @return
+     *      Self.
+     */
+    xap::core::json::TraversePrivate &validate(
+        const xap::core::json::Schema &schema
+    );
+
+    /**
+     *  Extract multiple members of the inner object.
+     * 
+     *  @throw xap::core::json::Exception
+     *      Raised in the following situations (the path of the error is the
+     *      path of the first member that failed):
+     *
+     *          - xap::core::json::ERROR_TYPE:
+     *              The inner is null or is not an object.
+     * 
+     *          - xap::core::json::ERROR_TYPE:
+     *              A member is null (but required) or doesn't fit the type
+     *              of its destination.
+     *  
+     *          - xap::core::json::ERROR_NOTFIND:
+     *              A required member is not existed.
+     * 
+     *  @param fields
+     *      The fields.
+     *  @param count
+     *      The count of fields.
+     *  @return
+     *      Self.
+     */
+    xap::core::json::TraversePrivate &extract(
+        const xap::core::json::ExtractField *fields,
+        const size_t count
+    );
+
     /**
      *  Set a key-value pair within an object.
      * 
@@ -406,7 +670,7 @@ public:
      *      Self.
      */
     xap::core::json::TraversePrivate &array_foreach(
-        std::function<void(const TraversePrivate &)> handler
+        std::function<void(TraversePrivate &)> handler
     );
 
     /**
@@ -590,6 +854,391 @@ public:
      */
     std::string inner_as_string();
 
+    /**
+     *  Get the inner as string (without copying it).
+     * 
+     *  @throw xap::core::json::Exception
+     *      Raised in the following situations:
+     *
+     *          - xap::core::json::ERROR_TYPE:
+     *              The inner is null.
+     * 
+     *          - xap::core::json::ERROR_TYPE:
+     *              The inner is not a string.
+     * 
+     *  @return
+     *      The inner (refers to the storage of the document).
+     */
+    xap::core::json::StringView inner_as_string_view();
+
+    /**
+     *  Get the items of the inner array (in bulk).
+     * 
+     *  @note
+     *      Instantiated for the types of Traverse::inner_as_int_array() and
+     *      the like.
+     *  @throw xap::core::json::Exception
+     *      Raised in the situations described by
+     *      Traverse::inner_as_int_array() and the like.
+     *  @param out
+     *      The buffer to receive the items (at least n items).
+     *  @param n
+     *      The size of the buffer.
+     *  @return
+     *      The length of the array.
+     */
+    template <typename T>
+    size_t inner_as_array(T *out, const size_t n);
+
+    /**
+     *  Decode the inner base64 string into a buffer.
+     * 
+     *  @throw xap::core::json::Exception
+     *      Raised in the situations described by Traverse::inner_as_base64().
+     *  @param out
+     *      The buffer to receive the decoded bytes (at least n bytes).
+     *  @param n
+     *      The size of the buffer.
+     *  @return
+     *      The length of the decoded data.
+     */
+    size_t inner_as_base64(uint8_t *out, const size_t n);
+
+    /**
+     *  Copy the inner object into a Json::Value.
+     * 
+     *  @return
+     *      The value.
+     */
+    Json::Value to_value() const;
+
+    //
+    //  Public methods (non-throwing).
+    //
+
+    /**
+     *  Check the type of inner object (without throwing).
+     * 
+     *  @param type
+     *      The expected type.
+     *  @param status
+     *      The status to receive the error (nullptr if not needed).
+     *  @return
+     *      False if the type is neither null nor the expected one.
+     */
+    bool try_type_of(
+        const xap::core::json::Type &type,
+        xap::core::json::Status *status
+    );
+
+    /**
+     *  Check that the inner object is not null (without throwing).
+     * 
+     *  @param status
+     *      The status to receive the error (nullptr if not needed).
+     *  @return
+     *      False if the inner is null.
+     */
+    bool try_not_null(xap::core::json::Status *status);
+
+    /**
+     *  Go to sub directory (without throwing).
+     * 
+     *  @throw std::bad_alloc
+     *      Raised if memory allocation was failed.
+     *  @param name
+     *      The name (key) of sub directory.
+     *  @param out
+     *      The object to receive the sub directory (can be this object,
+     *      unchanged if failed).
+     *  @param status
+     *      The status to receive the error (nullptr if not needed).
+     *  @return
+     *      False if the inner is null, is not an object or the sub path is
+     *      not existed.
+     */
+    bool try_sub(
+        const std::string &name,
+        xap::core::json::TraversePrivate *out,
+        xap::core::json::Status *status
+    );
+
+    /**
+     *  Go to the value that a JSON pointer refers to (without throwing).
+     * 
+     *  @throw std::bad_alloc
+     *      Raised if memory allocation was failed.
+     *  @param pointer
+     *      The compiled pointer.
+     *  @param out
+     *      The object to receive the value (can be this object, unchanged if
+     *      failed).
+     *  @param status
+     *      The status to receive the error (nullptr if not needed).
+     *  @return
+     *      False in the situations that TraversePrivate::at() throws.
+     */
+    bool try_at(
+        const xap::core::json::Pointer &pointer,
+        xap::core::json::TraversePrivate *out,
+        xap::core::json::Status *status
+    );
+
+    /**
+     *  Validate the inner object against a schema (without throwing).
+     * 
+     *  @param schema
+     *      The schema.
+     *  @param status
+     *      The status to receive the error (nullptr if not needed).
+     *  @return
+     *      False in the situations that TraversePrivate::validate() throws.
+     */
+    bool try_validate(
+        const xap::core::json::Schema &schema,
+        xap::core::json::Status *status
+    ) const;
+
+    /**
+     *  Bind a structure to the inner object (without throwing).
+     * 
+     *  @param table
+     *      The binding table of the structure.
+     *  @param object
+     *      The structure (partially written if failed).
+     *  @param status
+     *      The status to receive the error (nullptr if not needed).
+     *  @return
+     *      False in the situations that BindTable::bind() throws.
+     */
+    bool try_bind(
+        const xap::core::json::BindTable &table,
+        void *object,
+        xap::core::json::Status *status
+    ) const;
+
+    /**
+     *  Extract multiple members of the inner object (without throwing).
+     * 
+     *  @param fields
+     *      The fields.
+     *  @param count
+     *      The count of fields.
+     *  @param status
+     *      The status to receive the error (nullptr if not needed).
+     *  @return
+     *      False in the situations that TraversePrivate::extract() throws.
+     */
+    bool try_extract(
+        const xap::core::json::ExtractField *fields,
+        const size_t count,
+        xap::core::json::Status *status
+    ) const;
+
+    /**
+     *  Get the length of an array (without throwing).
+     * 
+     *  @param length
+     *      The pointer to receive the length.
+     *  @param status
+     *      The status to receive the error (nullptr if not needed).
+     *  @return
+     *      False if the inner is null or is not an array.
+     */
+    bool try_array_get_length(
+        size_t *length,
+        xap::core::json::Status *status
+    );
+
+    /**
+     *  Get inner as a signed integer (without throwing).
+     * 
+     *  @param value
+     *      The pointer to receive the inner.
+     *  @param status
+     *      The status to receive the error (nullptr if not needed).
+     *  @return
+     *      False if the inner is null or is not a signed integer.
+     */
+    bool try_inner_as_int(
+        int *value,
+        xap::core::json::Status *status
+    );
+
+    /**
+     *  Get inner as an unsigned integer (without throwing).
+     * 
+     *  @param value
+     *      The pointer to receive the inner.
+     *  @param status
+     *      The status to receive the error (nullptr if not needed).
+     *  @return
+     *      False if the inner is null or is not an unsigned integer.
+     */
+    bool try_inner_as_uint(
+        uint *value,
+        xap::core::json::Status *status
+    );
+
+#if defined(XAPCORE_JSON_INT64)
+
+    /**
+     *  Get inner as a signed 64-bit integer (without throwing).
+     * 
+     *  @param value
+     *      The pointer to receive the inner.
+     *  @param status
+     *      The status to receive the error (nullptr if not needed).
+     *  @return
+     *      False if the inner is null or is not a signed 64-bit integer.
+     */
+    bool try_inner_as_int64(
+        int64_t *value,
+        xap::core::json::Status *status
+    );
+
+    /**
+     *  Get inner as an unsigned 64-bit integer (without throwing).
+     * 
+     *  @param value
+     *      The pointer to receive the inner.
+     *  @param status
+     *      The status to receive the error (nullptr if not needed).
+     *  @return
+     *      False if the inner is null or is not an unsigned 64-bit integer.
+     */
+    bool try_inner_as_uint64(
+        uint64_t *value,
+        xap::core::json::Status *status
+    );
+
+#endif  //  #if defined(XAPCORE_JSON_INT64)
+
+    /**
+     *  Get inner as float (without throwing).
+     * 
+     *  @param value
+     *      The pointer to receive the inner.
+     *  @param status
+     *      The status to receive the error (nullptr if not needed).
+     *  @return
+     *      False if the inner is null or is not numeric.
+     */
+    bool try_inner_as_float(
+        float *value,
+        xap::core::json::Status *status
+    );
+
+    /**
+     *  Get inner as double (without throwing).
+     * 
+     *  @param value
+     *      The pointer to receive the inner.
+     *  @param status
+     *      The status to receive the error (nullptr if not needed).
+     *  @return
+     *      False if the inner is null or is not numeric.
+     */
+    bool try_inner_as_double(
+        double *value,
+        xap::core::json::Status *status
+    );
+
+    /**
+     *  Get inner as a boolean (without throwing).
+     * 
+     *  @param value
+     *      The pointer to receive the inner.
+     *  @param status
+     *      The status to receive the error (nullptr if not needed).
+     *  @return
+     *      False if the inner is null or is not a boolean.
+     */
+    bool try_inner_as_boolean(
+        bool *value,
+        xap::core::json::Status *status
+    );
+
+    /**
+     *  Get inner as string (without throwing).
+     * 
+     *  @throw std::bad_alloc
+     *      Raised if memory allocation was failed.
+     *  @param value
+     *      The pointer to receive the inner.
+     *  @param status
+     *      The status to receive the error (nullptr if not needed).
+     *  @return
+     *      False if the inner is null or is not a string.
+     */
+    bool try_inner_as_string(
+        std::string *value,
+        xap::core::json::Status *status
+    );
+
+    /**
+     *  Get the inner as string without copying it (without throwing).
+     * 
+     *  @param value
+     *      The pointer to receive the inner (refers to the storage of the
+     *      document).
+     *  @param status
+     *      The status to receive the error (nullptr if not needed).
+     *  @return
+     *      False if the inner is null or is not a string.
+     */
+    bool try_inner_as_string_view(
+        xap::core::json::StringView *value,
+        xap::core::json::Status *status
+    );
+
+    /**
+     *  Get the items of the inner array (in bulk, without throwing).
+     * 
+     *  @param out
+     *      The buffer to receive the items (at least n items).
+     *  @param n
+     *      The size of the buffer.
+     *  @param length
+     *      The pointer to receive the length of the array (nullptr if not
+     *      needed).
+     *  @param status
+     *      The status to receive the error (nullptr if not needed).
+     *  @return
+     *      False in the situations that TraversePrivate::inner_as_array()
+     *      throws.
+     */
+    template <typename T>
+    bool try_inner_as_array(
+        T *out,
+        const size_t n,
+        size_t *length,
+        xap::core::json::Status *status
+    ) const;
+
+    /**
+     *  Decode the inner base64 string into a buffer (without throwing).
+     * 
+     *  @param out
+     *      The buffer to receive the decoded bytes (at least n bytes).
+     *  @param n
+     *      The size of the buffer.
+     *  @param length
+     *      The pointer to receive the length of the decoded data (nullptr
+     *      if not needed).
+     *  @param status
+     *      The status to receive the error (nullptr if not needed).
+     *  @return
+     *      False in the situations that TraversePrivate::inner_as_base64()
+     *      throws.
+     */
+    bool try_inner_as_base64(
+        uint8_t *out,
+        const size_t n,
+        size_t *length,
+        xap::core::json::Status *status
+    );
+
 private:
 
     //
@@ -602,38 +1251,237 @@ private:
     //
 
     /**
-     *  Get the path of specific sub directory.
+     *  Get the inner type.
+     * 
+     *  @return
+     *      The type of inner object.
+     */
+    xap::core::json::Type get_inner_type() const;
+
+    /**
+     *  Report an error to a status.
+     * 
+     *  @param message
+     *      The error message (a static string).
+     *  @param code
+     *      The error code.
+     *  @param segment
+     *      The segment to be appended to the path of this object (nullptr if
+     *      the error is about this object).
+     *  @param segment_len
+     *      The length of the segment.
+     *  @param status
+     *      The status (nullptr if not needed).
+     *  @return
+     *      False.
+     */
+    bool fail(
+        const char *message,
+        const uint16_t code,
+        const char *segment,
+        const size_t segment_len,
+        xap::core::json::Status *status
+    ) const;
+
+    /**
+     *  Report an error of a schema check to a status.
+     * 
+     *  @param message
+     *      The error message (a static string).
+     *  @param code
+     *      The error code.
+     *  @param frame
+     *      The frame of the value that failed (nullptr for this object).
+     *  @param status
+     *      The status (nullptr if not needed).
+     *  @return
+     *      False.
+     */
+    bool fail_schema(
+        const char *message,
+        const uint16_t code,
+        const xap::core::json::SchemaFrame *frame,
+        xap::core::json::Status *status
+    ) const;
+
+    /**
+     *  Check the members of an object node against a schema.
+     * 
+     *  @param schema
+     *      The schema.
+     *  @param node
+     *      The object node.
+     *  @param frame
+     *      The frame of the node (nullptr for this object).
+     *  @param status
+     *      The status to receive the error (nullptr if not needed).
+     *  @return
+     *      False if a check failed.
+     */
+    bool check_members(
+        const xap::core::json::SchemaPrivate &schema,
+        const xap::core::json::Node node,
+        const xap::core::json::SchemaFrame *frame,
+        xap::core::json::Status *status
+    ) const;
+
+    /**
+     *  Check a value against a field of a schema.
+     * 
+     *  @param field
+     *      The field.
+     *  @param node
+     *      The node of the value.
+     *  @param frame
+     *      The frame of the value.
+     *  @param status
+     *      The status to receive the error (nullptr if not needed).
+     *  @return
+     *      False if a check failed.
+     */
+    bool check_field(
+        const xap::core::json::SchemaField &field,
+        const xap::core::json::Node node,
+        const xap::core::json::SchemaFrame *frame,
+        xap::core::json::Status *status
+    ) const;
+
+    /**
+     *  Bind the fields of a scan to the members of an object node (in one
+     *  scan).
+     * 
+     *  @param scan
+     *      The scan (the fields, the structure, the frame and the status
+     *      are set by the caller).
+     *  @param node
+     *      The object node.
+     *  @return
+     *      False if failed.
+     */
+    bool bind_members(
+        xap::core::json::BindScan &scan,
+        const xap::core::json::Node node
+    ) const;
+
+    /**
+     *  Bind a member to its field (see Document::foreach_member()).
      * 
-     *  @param name 
-     *      The name of sub directory.
+     *  @param context
+     *      The scan (xap::core::json::BindScan).
+     *  @param key
+     *      The key of the member.
+     *  @param key_len
+     *      The length of the key.
+     *  @param member
+     *      The node of the member.
+     *  @return
+     *      False if failed.
+     */
+    static bool bind_member(
+        void *context,
+        const char *key,
+        const size_t key_len,
+        const xap::core::json::Node member
+    );
+
+    /**
+     *  Convert a value and write it to a field of a structure.
+     * 
+     *  @param entry
+     *      The entry of the field.
+     *  @param node
+     *      The node of the value.
+     *  @param object
+     *      The structure.
+     *  @param frame
+     *      The frame of the value.
+     *  @param status
+     *      The status to receive the error (nullptr if not needed).
      *  @return
-     *      The sub path.
+     *      False if failed.
      */
-    std::string get_sub_path(const std::string &path) const;
+    bool bind_value(
+        const xap::core::json::BindTable::Entry &entry,
+        const xap::core::json::Node node,
+        void *object,
+        const xap::core::json::SchemaFrame *frame,
+        xap::core::json::Status *status
+    ) const;
 
     /**
-     *  Get the path of specific sub directory.
+     *  Find the node that a JSON pointer refers to.
+     * 
+     *  @param pointer
+     *      The compiled pointer.
+     *  @param optional
+     *      Whether non-existed (or null) values on the way are allowed.
+     *  @param node
+     *      The pointer to receive the node.
+     *  @param status
+     *      The status to receive the error in the situations described by
+     *      TraversePrivate::at() (only the type errors if optional is true).
+     *  @return
+     *      False if failed or a value on the way is non-existed (or null)
+     *      and optional is true (the status is left unchanged).
+     */
+    bool locate(
+        const xap::core::json::PointerPrivate &pointer,
+        const bool optional,
+        xap::core::json::Node *node,
+        xap::core::json::Status *status
+    ) const;
+
+    /**
+     *  Get the path of a member (found by find_member()).
      * 
-     *  @param index 
-     *      The index of sub directory.
+     *  @note
+     *      The path borrows the key from the document if the document keeps
+     *      it, otherwise the name is copied.
+     *  @param member
+     *      The node of the member.
+     *  @param name
+     *      The name (key) of the member.
      *  @return
-     *      The sub path.
+     *      The path.
      */
-    std::string get_sub_path(const size_t index) const;
+    xap::core::json::Path member_path(
+        const xap::core::json::Node member,
+        const std::string &name
+    );
 
     /**
-     *  Get the inner type.
+     *  Get the path of a prefix of a JSON pointer.
+     * 
+     *  @note
+     *      The whole path of the pointer is borrowed (the path keeps the
+     *      pointer alive), a shorter prefix is copied.
+     *  @param pointer
+     *      The compiled pointer.
+     *  @param path_end
+     *      The end of the prefix within the path of the pointer.
+     *  @return
+     *      The path.
+     */
+    xap::core::json::Path pointer_path(
+        const std::shared_ptr<const xap::core::json::PointerPrivate> &pointer,
+        const size_t path_end
+    );
+
+    /**
+     *  Make the inner object exclusively owned and modifiable (copy-on-write)
+     *  so that it can be modified without affecting other traverse objects.
      * 
      *  @return
-     *      The type of inner object.
+     *      The modifiable inner object.
      */
-    xap::core::json::Type get_inner_type() const;
+    Json::Value *detach();
 
     //
     //  Private members.
     //
-    Json::Value m_inner;
-    std::string m_path;
+    std::shared_ptr<xap::core::json::Document> m_document;
+    xap::core::json::Node m_node;
+    xap::core::json::Path m_path;
     xap::core::json::Type m_type;
 };
 
@@ -0,0 +1,728 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+//
+//  Imports.
+//
+#include "utf8_p.h"
+#include "scanner_p.h"
+
+#include <algorithm>
+#include <string.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+# define XAPCORE_JSON_UTF8_X86
+# include <immintrin.h>
+#endif  //  #if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+
+namespace xap {
+namespace core {
+namespace json {
+
+//
+//  Constants.
+//
+
+//  Error bits of a pair of bytes (see Utf8Validator).
+static const uint8_t UTF8_TOO_SHORT = 0x01U;
+static const uint8_t UTF8_TOO_LONG = 0x02U;
+static const uint8_t UTF8_OVERLONG_3 = 0x04U;
+static const uint8_t UTF8_TOO_LARGE = 0x08U;
+static const uint8_t UTF8_SURROGATE = 0x10U;
+static const uint8_t UTF8_OVERLONG_2 = 0x20U;
+static const uint8_t UTF8_TOO_LARGE_1000 = 0x40U;
+static const uint8_t UTF8_OVERLONG_4 = 0x40U;
+static const uint8_t UTF8_TWO_CONTS = 0x80U;
+static const uint8_t UTF8_CARRY = (
+    UTF8_TOO_SHORT | UTF8_TOO_LONG | UTF8_TWO_CONTS
+);
+
+//  Errors by the high nibble of the first byte.
+static const uint8_t UTF8_BYTE_1_HIGH[16] = {
+    //  0_______: ASCII.
+    UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+    UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG, UTF8_TOO_LONG,
+
+    //  10______: continuation.
+    UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS, UTF8_TWO_CONTS,
+
+    //  1100____, 1101____: 2-byte lead.
+    UTF8_TOO_SHORT | UTF8_OVERLONG_2,
+    UTF8_TOO_SHORT,
+
+    //  1110____: 3-byte lead.
+    UTF8_TOO_SHORT | UTF8_OVERLONG_3 | UTF8_SURROGATE,
+
+    //  1111____: 4-byte lead.
+    UTF8_TOO_SHORT | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4
+};
+
+//  Errors by the low nibble of the first byte.
+static const uint8_t UTF8_BYTE_1_LOW[16] = {
+    //  ____0000, ____0001.
+    UTF8_CARRY | UTF8_OVERLONG_3 | UTF8_OVERLONG_2 | UTF8_OVERLONG_4,
+    UTF8_CARRY | UTF8_OVERLONG_2,
+
+    //  ____001_.
+    UTF8_CARRY,
+    UTF8_CARRY,
+
+    //  ____0100, ____0101, ____011_.
+    UTF8_CARRY | UTF8_TOO_LARGE,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+
+    //  ____1___ (____1101 may start a surrogate).
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000 | UTF8_SURROGATE,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000,
+    UTF8_CARRY | UTF8_TOO_LARGE | UTF8_TOO_LARGE_1000
+};
+
+//  Errors by the high nibble of the second byte.
+static const uint8_t UTF8_BYTE_2_HIGH[16] = {
+    //  0_______: ASCII.
+    UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+    UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT,
+
+    //  1000____, 1001____, 101_____: continuation.
+    UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 |
+        UTF8_TOO_LARGE_1000 | UTF8_OVERLONG_4,
+    UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_OVERLONG_3 |
+        UTF8_TOO_LARGE,
+    UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE |
+        UTF8_TOO_LARGE,
+    UTF8_TOO_LONG | UTF8_OVERLONG_2 | UTF8_TWO_CONTS | UTF8_SURROGATE |
+        UTF8_TOO_LARGE,
+
+    //  11______: lead.
+    UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT, UTF8_TOO_SHORT
+};
+
+//  The largest bytes that don't start a character which continues past the
+//  end of a 32-byte chunk (a lead within the last 3 bytes, by position).
+static const uint8_t UTF8_INCOMPLETE_MAX[32] = {
+    0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU,
+    0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU,
+    0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU,
+    0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xEFU, 0xDFU, 0xBFU
+};
+
+//
+//  Private functions.
+//
+
+/**
+ *  Get the length of the character that starts with a byte.
+ *
+ *  @param lead
+ *      The byte.
+ *  @return
+ *      The length (0 if the byte can't start a character).
+ */
+static inline size_t get_sequence_length(const uint8_t lead) noexcept {
+    if (lead < 0x80U) {
+        return 1U;
+    }
+    if (lead < 0xC2U) {
+        return 0U;
+    }
+    if (lead < 0xE0U) {
+        return 2U;
+    }
+    if (lead < 0xF0U) {
+        return 3U;
+    }
+    if (lead < 0xF5U) {
+        return 4U;
+    }
+    return 0U;
+}
+
+/**
+ *  Check a multi-byte character (see table 3-7 of the Unicode standard).
+ *
+ *  @param sequence
+ *      The bytes of the character.
+ *  @param length
+ *      The length of the character (2 to 4, see get_sequence_length()).
+ *  @return
+ *      True if the character is valid.
+ */
+static inline bool check_sequence(
+    const uint8_t *sequence,
+    const size_t length
+) noexcept {
+    //  The second byte is narrowed by some leads (no overlong form, no
+    //  surrogate and nothing beyond U+10FFFF).
+    uint8_t minimum = 0x80U;
+    uint8_t maximum = 0xBFU;
+    switch (sequence[0]) {
+        case 0xE0U:
+            minimum = 0xA0U;
+            break;
+        case 0xEDU:
+            maximum = 0x9FU;
+            break;
+        case 0xF0U:
+            minimum = 0x90U;
+            break;
+        case 0xF4U:
+            maximum = 0x8FU;
+            break;
+        default:
+            break;
+    }
+    if (sequence[1] < minimum || sequence[1] > maximum) {
+        return false;
+    }
+    for (size_t i = 2U; i < length; ++i) {
+        if ((sequence[i] & 0xC0U) != 0x80U) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ *  Validate blocks (scalar).
+ *
+ *  @param data
+ *      The data (block_count * 64 bytes).
+ *  @param block_count
+ *      The count of blocks.
+ *  @param tail
+ *      The last 3 bytes before the data (updated for the next call).
+ *  @return
+ *      True if valid.
+ */
+static bool validate_scalar(
+    const uint8_t *data,
+    const size_t block_count,
+    uint8_t *tail
+) {
+    if (block_count == 0U) {
+        return true;
+    }
+    const size_t length = block_count * 64U;
+    size_t position = 0U;
+
+    //  The character that continues from the previous call.
+    for (size_t i = 0U; i < 3U; ++i) {
+        if (tail[i] < 0xC0U) {
+            continue;
+        }
+        const size_t sequence_length = get_sequence_length(tail[i]);
+        if (sequence_length == 0U) {
+            return false;
+        }
+        if (i + sequence_length > 3U) {
+            uint8_t sequence[4];
+            const size_t kept = 3U - i;
+            memcpy(sequence, tail + i, kept);
+            memcpy(sequence + kept, data, sequence_length - kept);
+            if (!check_sequence(sequence, sequence_length)) {
+                return false;
+            }
+            position = sequence_length - kept;
+        }
+    }
+
+    while (position < length) {
+        //  8 ASCII characters at a time.
+        if (position + 8U <= length) {
+            uint64_t word;
+            memcpy(&word, data + position, sizeof(word));
+            if ((word & UINT64_C(0x8080808080808080)) == 0U) {
+                position += 8U;
+                continue;
+            }
+        }
+
+        const uint8_t lead = data[position];
+        if (lead < 0x80U) {
+            ++position;
+            continue;
+        }
+        const size_t sequence_length = get_sequence_length(lead);
+        if (sequence_length == 0U) {
+            return false;
+        }
+        if (position + sequence_length > length) {
+            //  Checked with the next call.
+            break;
+        }
+        if (!check_sequence(data + position, sequence_length)) {
+            return false;
+        }
+        position += sequence_length;
+    }
+
+    memcpy(tail, data + length - 3U, 3U);
+    return true;
+}
+
+#if defined(XAPCORE_JSON_UTF8_X86)
+
+/**
+ *  Check a 16-byte chunk (SSE4.2).
+ *
+ *  @param input
+ *      The chunk.
+ *  @param prev_input
+ *      The previous chunk.
+ *  @return
+ *      The errors (nonzero bytes if invalid).
+ */
+__attribute__((target("sse4.2")))
+static inline __m128i check_chunk_sse42(
+    const __m128i input,
+    const __m128i prev_input
+) noexcept {
+    const __m128i low_nibble = _mm_set1_epi8(0x0F);
+    const __m128i prev1 = _mm_alignr_epi8(input, prev_input, 15);
+
+    //  Errors of 2-byte pairs.
+    const __m128i byte_1_high = _mm_shuffle_epi8(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(UTF8_BYTE_1_HIGH)),
+        _mm_and_si128(_mm_srli_epi16(prev1, 4), low_nibble)
+    );
+    const __m128i byte_1_low = _mm_shuffle_epi8(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(UTF8_BYTE_1_LOW)),
+        _mm_and_si128(prev1, low_nibble)
+    );
+    const __m128i byte_2_high = _mm_shuffle_epi8(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(UTF8_BYTE_2_HIGH)),
+        _mm_and_si128(_mm_srli_epi16(input, 4), low_nibble)
+    );
+    const __m128i special_cases = _mm_and_si128(
+        _mm_and_si128(byte_1_high, byte_1_low),
+        byte_2_high
+    );
+
+    //  The third and the fourth bytes of 3-byte and 4-byte characters must
+    //  be (and are the only) continuations that follow continuations.
+    const __m128i prev2 = _mm_alignr_epi8(input, prev_input, 14);
+    const __m128i prev3 = _mm_alignr_epi8(input, prev_input, 13);
+    const __m128i must_be_continuation = _mm_and_si128(
+        _mm_or_si128(
+            _mm_subs_epu8(prev2, _mm_set1_epi8(0xE0 - 0x80)),
+            _mm_subs_epu8(prev3, _mm_set1_epi8(0xF0 - 0x80))
+        ),
+        _mm_set1_epi8(static_cast<char>(0x80U))
+    );
+    return _mm_xor_si128(must_be_continuation, special_cases);
+}
+
+/**
+ *  Validate blocks (SSE4.2).
+ *
+ *  @param data
+ *      The data (block_count * 64 bytes).
+ *  @param block_count
+ *      The count of blocks.
+ *  @param tail
+ *      The last 3 bytes before the data (updated for the next call).
+ *  @return
+ *      True if valid.
+ */
+__attribute__((target("sse4.2")))
+static bool validate_sse42(
+    const uint8_t *data,
+    const size_t block_count,
+    uint8_t *tail
+) {
+    if (block_count == 0U) {
+        return true;
+    }
+    uint8_t last[16];
+    memset(last, 0, sizeof(last));
+    memcpy(last + 13U, tail, 3U);
+
+    const __m128i incomplete_max = _mm_loadu_si128(
+        reinterpret_cast<const __m128i *>(UTF8_INCOMPLETE_MAX + 16U)
+    );
+    __m128i prev_input = _mm_loadu_si128(
+        reinterpret_cast<const __m128i *>(last)
+    );
+    __m128i prev_incomplete = _mm_subs_epu8(prev_input, incomplete_max);
+    __m128i error = _mm_setzero_si128();
+    for (size_t i = 0U; i < block_count; ++i, data += 64U) {
+        const __m128i chunks[4] = {
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(data)),
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 16U)),
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 32U)),
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 48U))
+        };
+        const __m128i any = _mm_or_si128(
+            _mm_or_si128(chunks[0], chunks[1]),
+            _mm_or_si128(chunks[2], chunks[3])
+        );
+
+        //  ASCII only (no character may continue from the previous block).
+        if (_mm_movemask_epi8(any) == 0) {
+            error = _mm_or_si128(error, prev_incomplete);
+            prev_input = chunks[3];
+            prev_incomplete = _mm_setzero_si128();
+            continue;
+        }
+
+        for (size_t j = 0U; j < 4U; ++j) {
+            error = _mm_or_si128(
+                error,
+                check_chunk_sse42(chunks[j], prev_input)
+            );
+            prev_input = chunks[j];
+        }
+        prev_incomplete = _mm_subs_epu8(prev_input, incomplete_max);
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(last), prev_input);
+    memcpy(tail, last + 13U, 3U);
+    return _mm_testz_si128(error, error) != 0;
+}
+
+/**
+ *  Check a 32-byte chunk (AVX2).
+ *
+ *  @param input
+ *      The chunk.
+ *  @param prev_input
+ *      The previous chunk.
+ *  @return
+ *      The errors (nonzero bytes if invalid).
+ */
+__attribute__((target("avx2")))
+static inline __m256i check_chunk_avx2(
+    const __m256i input,
+    const __m256i prev_input
+) noexcept {
+    const __m256i low_nibble = _mm256_set1_epi8(0x0F);
+
+    //  Shift the previous bytes in across the 128-bit lanes.
+    const __m256i shifted = _mm256_permute2x128_si256(prev_input, input, 0x21);
+    const __m256i prev1 = _mm256_alignr_epi8(input, shifted, 15);
+
+    //  Errors of 2-byte pairs.
+    const __m256i byte_1_high = _mm256_shuffle_epi8(
+        _mm256_broadcastsi128_si256(_mm_loadu_si128(
+            reinterpret_cast<const __m128i *>(UTF8_BYTE_1_HIGH)
+        )),
+        _mm256_and_si256(_mm256_srli_epi16(prev1, 4), low_nibble)
+    );
+    const __m256i byte_1_low = _mm256_shuffle_epi8(
+        _mm256_broadcastsi128_si256(_mm_loadu_si128(
+            reinterpret_cast<const __m128i *>(UTF8_BYTE_1_LOW)
+        )),
+        _mm256_and_si256(prev1, low_nibble)
+    );
+    const __m256i byte_2_high = _mm256_shuffle_epi8(
+        _mm256_broadcastsi128_si256(_mm_loadu_si128(
+            reinterpret_cast<const __m128i *>(UTF8_BYTE_2_HIGH)
+        )),
+        _mm256_and_si256(_mm256_srli_epi16(input, 4), low_nibble)
+    );
+    const __m256i special_cases = _mm256_and_si256(
+        _mm256_and_si256(byte_1_high, byte_1_low),
+        byte_2_high
+    );
+
+    //  The third and the fourth bytes of 3-byte and 4-byte characters must
+    //  be (and are the only) continuations that follow continuations.
+    const __m256i prev2 = _mm256_alignr_epi8(input, shifted, 14);
+    const __m256i prev3 = _mm256_alignr_epi8(input, shifted, 13);
+    const __m256i must_be_continuation = _mm256_and_si256(
+        _mm256_or_si256(
+            _mm256_subs_epu8(prev2, _mm256_set1_epi8(0xE0 - 0x80)),
+            _mm256_subs_epu8(prev3, _mm256_set1_epi8(0xF0 - 0x80))
+        ),
+        _mm256_set1_epi8(static_cast<char>(0x80U))
+    );
+    return _mm256_xor_si256(must_be_continuation, special_cases);
+}
+
+/**
+ *  Validate blocks (AVX2).
+ *
+ *  @param data
+ *      The data (block_count * 64 bytes).
+ *  @param block_count
+ *      The count of blocks.
+ *  @param tail
+ *      The last 3 bytes before the data (updated for the next call).
+ *  @return
+ *      True if valid.
+ */
+__attribute__((target("avx2")))
+static bool validate_avx2(
+    const uint8_t *data,
+    const size_t block_count,
+    uint8_t *tail
+) {
+    if (block_count == 0U) {
+        return true;
+    }
+    uint8_t last[32];
+    memset(last, 0, sizeof(last));
+    memcpy(last + 29U, tail, 3U);
+
+    const __m256i incomplete_max = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i *>(UTF8_INCOMPLETE_MAX)
+    );
+    __m256i prev_input = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i *>(last)
+    );
+    __m256i prev_incomplete = _mm256_subs_epu8(prev_input, incomplete_max);
+    __m256i error = _mm256_setzero_si256();
+    for (size_t i = 0U; i < block_count; ++i, data += 64U) {
+        const __m256i low = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(data)
+        );
+        const __m256i high = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(data + 32U)
+        );
+
+        //  ASCII only (no character may continue from the previous block).
+        if (_mm256_movemask_epi8(_mm256_or_si256(low, high)) == 0) {
+            error = _mm256_or_si256(error, prev_incomplete);
+            prev_input = high;
+            prev_incomplete = _mm256_setzero_si256();
+            continue;
+        }
+
+        error = _mm256_or_si256(error, check_chunk_avx2(low, prev_input));
+        error = _mm256_or_si256(error, check_chunk_avx2(high, low));
+        prev_input = high;
+        prev_incomplete = _mm256_subs_epu8(prev_input, incomplete_max);
+    }
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(last), prev_input);
+    memcpy(tail, last + 29U, 3U);
+    return _mm256_testz_si256(error, error) != 0;
+}
+
+#endif  //  #if defined(XAPCORE_JSON_UTF8_X86)
+
+//
+//  Utf8Validator constructor & destructor.
+//
+
+/**
+ *  Construct the object (with the best kernel of current CPU).
+ */
+Utf8Validator::Utf8Validator() :
+    Utf8Validator(xap::core::json::StructuralScanner::get_best_kernel())
+{}
+
+/**
+ *  Construct the object.
+ *
+ *  @param kernel
+ *      The kernel (must be supported by current CPU).
+ */
+Utf8Validator::Utf8Validator(const xap::core::json::ScannerKernel kernel) :
+    m_kernel(kernel),
+    m_validate(validate_scalar),
+    m_tail{0U, 0U, 0U}
+{
+#if defined(XAPCORE_JSON_UTF8_X86)
+    switch (kernel) {
+        case xap::core::json::ScannerKernel::sse42:
+            this->m_validate = validate_sse42;
+            break;
+        case xap::core::json::ScannerKernel::avx2:
+            this->m_validate = validate_avx2;
+            break;
+        default:
+            break;
+    }
+#else
+    this->m_kernel = xap::core::json::ScannerKernel::scalar;
+#endif  //  #if defined(XAPCORE_JSON_UTF8_X86)
+}
+
+/**
+ *  Destruct the object.
+ */
+Utf8Validator::~Utf8Validator() noexcept {
+    //  Do nothing.
+}
+
+//
+//  Utf8Validator public methods.
+//
+
+/**
+ *  Start validating an input.
+ */
+void Utf8Validator::reset() noexcept {
+    memset(this->m_tail, 0, sizeof(this->m_tail));
+}
+
+/**
+ *  Validate a piece of the input.
+ *
+ *  @param data
+ *      The piece (block_count * 64 bytes).
+ *  @param block_count
+ *      The count of 64-byte blocks.
+ *  @return
+ *      False if the input is invalid (within the piece, or within a
+ *      character that continues from the previous piece).
+ */
+bool Utf8Validator::feed(
+    const uint8_t *data,
+    const size_t block_count
+) noexcept {
+    return this->m_validate(data, block_count, this->m_tail);
+}
+
+/**
+ *  Check whether the input ends after a whole character.
+ *
+ *  @return
+ *      True if so.
+ */
+bool Utf8Validator::finish() const noexcept {
+    return !(
+        this->m_tail[2] >= 0xC0U ||
+        this->m_tail[1] >= 0xE0U ||
+        this->m_tail[0] >= 0xF0U
+    );
+}
+
+/**
+ *  Get the kernel.
+ *
+ *  @return
+ *      The kernel.
+ */
+xap::core::json::ScannerKernel Utf8Validator::get_kernel() const noexcept {
+    return this->m_kernel;
+}
+
+//
+//  Utf8Validator public static functions.
+//
+
+/**
+ *  Validate an input.
+ *
+ *  @param data
+ *      The input.
+ *  @param datalen
+ *      The length of the input.
+ *  @param error_offset
+ *      The pointer to receive the offset of the first invalid character (if
+ *      the input is invalid).
+ *  @return
+ *      True if the input is valid.
+ */
+bool Utf8Validator::validate(
+    const uint8_t *data,
+    const size_t datalen,
+    size_t *error_offset
+) noexcept {
+    Utf8Validator validator;
+    const size_t block_count = datalen / 64U;
+    bool valid = validator.feed(data, block_count);
+
+    //  The last block is padded with whitespaces.
+    if (valid && datalen % 64U != 0U) {
+        uint8_t padded[64];
+        memset(padded, ' ', sizeof(padded));
+        memcpy(padded, data + block_count * 64U, datalen % 64U);
+        valid = validator.feed(padded, 1U);
+    }
+    if (valid && validator.finish()) {
+        return true;
+    }
+
+    *error_offset = static_cast<size_t>(
+        Utf8Validator::find_error(data, data + datalen) - data
+    );
+    return false;
+}
+
+/**
+ *  Find the first invalid character (scalar).
+ *
+ *  @param begin
+ *      The beginning of the input (or of a character within it).
+ *  @param end
+ *      The end of the input.
+ *  @return
+ *      The first invalid character (end if none).
+ */
+const uint8_t *Utf8Validator::find_error(
+    const uint8_t *begin,
+    const uint8_t *end
+) noexcept {
+    const uint8_t *cursor = begin;
+    while (cursor != end) {
+        if (*cursor < 0x80U) {
+            ++cursor;
+            continue;
+        }
+        const size_t length = get_sequence_length(*cursor);
+        if (
+            length == 0U ||
+            static_cast<size_t>(end - cursor) < length ||
+            !check_sequence(cursor, length)
+        ) {
+            return cursor;
+        }
+        cursor += length;
+    }
+    return end;
+}
+
+/**
+ *  Find the first invalid character that follows valid data.
+ *
+ *  @param base
+ *      The beginning of the input.
+ *  @param begin
+ *      The beginning of the piece that failed (the input before it is
+ *      valid).
+ *  @param end
+ *      The end of the input.
+ *  @return
+ *      The first invalid character (end if none).
+ */
+const uint8_t *Utf8Validator::find_error(
+    const uint8_t *base,
+    const uint8_t *begin,
+    const uint8_t *end
+) noexcept {
+    //  Back to the lead of the character that may continue into the piece
+    //  (the lead is at most 3 bytes before, after continuations only).
+    const uint8_t *cursor = begin;
+    const size_t backward = std::min<size_t>(
+        static_cast<size_t>(begin - base),
+        3U
+    );
+    for (size_t i = 1U; i <= backward; ++i) {
+        const uint8_t ch = *(begin - i);
+        if (ch >= 0xC0U) {
+            cursor = begin - i;
+            break;
+        }
+        if (ch < 0x80U) {
+            break;
+        }
+    }
+    return Utf8Validator::find_error(cursor, end);
+}
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
@@ -0,0 +1,187 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+#ifndef XAP_CORE_JSON_UTF8_P_H__
+#define XAP_CORE_JSON_UTF8_P_H__
+
+//
+//  Imports.
+//
+#include "xap/core/json/build.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+namespace xap {
+namespace core {
+namespace json {
+
+//
+//  Declare.
+//
+enum ScannerKernel: uint8_t;
+
+//
+//  Classes.
+//
+
+/**
+ *  UTF-8 validator.
+ *
+ *  @note
+ *      The validator checks the input 64 bytes at a time, with the same
+ *      kernels as the structural scanner. The SIMD kernels skip blocks of
+ *      ASCII characters with one test and check other blocks with three
+ *      table lookups per byte (on the high and low nibbles of the previous
+ *      byte and the high nibble of current byte, see "Validating UTF-8 In
+ *      Less Than One Instruction Per Byte" by Keiser and Lemire). The
+ *      scalar kernel walks the characters, 8 ASCII characters at a time.
+ *
+ *      Overlong forms, surrogates (U+D800 to U+DFFF), code points beyond
+ *      U+10FFFF, stray continuation bytes and truncated characters are
+ *      rejected. The kernels only tell whether a piece is valid, use
+ *      find_error() to locate the error.
+ */
+class Utf8Validator {
+public:
+
+    /**
+     *  Construct the object (with the best kernel of current CPU).
+     */
+    Utf8Validator();
+
+    /**
+     *  Construct the object.
+     *
+     *  @param kernel
+     *      The kernel (must be supported by current CPU).
+     */
+    explicit Utf8Validator(const xap::core::json::ScannerKernel kernel);
+
+    /**
+     *  Destruct the object.
+     */
+    virtual ~Utf8Validator() noexcept;
+
+    //
+    //  Public methods.
+    //
+
+    /**
+     *  Start validating an input.
+     */
+    void reset() noexcept;
+
+    /**
+     *  Validate a piece of the input.
+     *
+     *  @param data
+     *      The piece (block_count * 64 bytes).
+     *  @param block_count
+     *      The count of 64-byte blocks.
+     *  @return
+     *      False if the input is invalid (within the piece, or within a
+     *      character that continues from the previous piece).
+     */
+    bool feed(const uint8_t *data, const size_t block_count) noexcept;
+
+    /**
+     *  Check whether the input ends after a whole character.
+     *
+     *  @return
+     *      True if so.
+     */
+    bool finish() const noexcept;
+
+    /**
+     *  Get the kernel.
+     *
+     *  @return
+     *      The kernel.
+     */
+    xap::core::json::ScannerKernel get_kernel() const noexcept;
+
+    //
+    //  Public static functions.
+    //
+
+    /**
+     *  Validate an input.
+     *
+     *  @param data
+     *      The input.
+     *  @param datalen
+     *      The length of the input.
+     *  @param error_offset
+     *      The pointer to receive the offset of the first invalid character
+     *      (if the input is invalid).
+     *  @return
+     *      True if the input is valid.
+     */
+    static bool validate(
+        const uint8_t *data,
+        const size_t datalen,
+        size_t *error_offset
+    ) noexcept;
+
+    /**
+     *  Find the first invalid character (scalar).
+     *
+     *  @param begin
+     *      The beginning of the input (or of a character within it).
+     *  @param end
+     *      The end of the input.
+     *  @return
+     *      The first invalid character (end if none).
+     */
+    static const uint8_t *find_error(
+        const uint8_t *begin,
+        const uint8_t *end
+    ) noexcept;
+
+    /**
+     *  Find the first invalid character that follows valid data.
+     *
+     *  @param base
+     *      The beginning of the input.
+     *  @param begin
+     *      The beginning of the piece that failed (the input before it is
+     *      valid).
+     *  @param end
+     *      The end of the input.
+     *  @return
+     *      The first invalid character (end if none).
+     */
+    static const uint8_t *find_error(
+        const uint8_t *base,
+        const uint8_t *begin,
+        const uint8_t *end
+    ) noexcept;
+
+private:
+
+    //
+    //  Private types.
+    //
+    typedef bool (*ValidateFunction)(
+        const uint8_t *data,
+        const size_t block_count,
+        uint8_t *tail
+    );
+
+    //
+    //  Private members.
+    //
+    xap::core::json::ScannerKernel m_kernel;
+    ValidateFunction m_validate;
+    uint8_t m_tail[3];
+};
+
+}  //  namespace json
+}  //  namespace core
+}  //  namespace xap
+
+#endif  //  #ifndef XAP_CORE_JSON_UTF8_P_H__
@@ -0,0 +1,294 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+//
+//  Imports.
+//
+#include "common.h"
+
+#include <iostream>
+#include <memory>
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include <xap/core/json/all.h>
+
+//
+//  Entry.
+//
+
+int main() {
+    try {
+        //  Raw allocations.
+        {
+            xap::core::json::Arena arena(1024U);
+            xap::test::assert_equal<size_t>(
+                arena.get_reserved_size(),
+                0U,
+                "arena.get_reserved_size() != 0"
+            );
+            for (size_t i = 1U; i < 64U; ++i) {
+                void *memory = arena.allocate(i, 8U);
+                xap::test::assert_ok(
+                    reinterpret_cast<uintptr_t>(memory) % 8U == 0U,
+                    "Memory is not aligned."
+                );
+            }
+            void *memory = arena.allocate(3U, 64U);
+            xap::test::assert_ok(
+                reinterpret_cast<uintptr_t>(memory) % 64U == 0U,
+                "Memory is not aligned (64)."
+            );
+
+            //  Large allocations.
+            const size_t reserved = arena.get_reserved_size();
+            arena.allocate(100000U, 16U);
+            xap::test::assert_ok(
+                arena.get_reserved_size() >= reserved + 100000U,
+                "Large allocation is not reserved."
+            );
+
+            //  Copies share the memory.
+            xap::core::json::Arena copy(arena);
+            const size_t allocated = arena.get_allocated_size();
+            copy.allocate(10U, 1U);
+            xap::test::assert_equal<size_t>(
+                arena.get_allocated_size(),
+                allocated + 10U,
+                "The copy doesn't share the memory."
+            );
+        }
+
+        //  Threads share an arena (each allocates from a chunk of its own).
+        {
+            xap::core::json::Arena arena(1024U);
+            std::vector<std::thread> threads;
+            for (int t = 0; t < 4; ++t) {
+                threads.emplace_back([&arena, t] () {
+                    std::vector<uint8_t*> memories;
+                    for (size_t i = 0U; i < 2000U; ++i) {
+                        uint8_t *memory = static_cast<uint8_t*>(
+                            arena.allocate(1U + i % 32U, 8U)
+                        );
+                        memset(memory, t, 1U + i % 32U);
+                        memories.push_back(memory);
+                    }
+                    for (size_t i = 0U; i < memories.size(); ++i) {
+                        for (size_t j = 0U; j < 1U + i % 32U; ++j) {
+                            xap::test::assert_equal<int>(
+                                memories[i][j],
+                                t,
+                                "Memory is shared by threads."
+                            );
+                        }
+                    }
+                });
+            }
+            for (std::thread &thread : threads) {
+                thread.join();
+            }
+
+            //  The threads gave their chunks back when they exited.
+            size_t allocated = 0U;
+            for (size_t i = 0U; i < 2000U; ++i) {
+                allocated += 1U + i % 32U;
+            }
+            xap::test::assert_equal<size_t>(
+                arena.get_allocated_size(),
+                allocated * 4U,
+                "arena.get_allocated_size() != allocated * 4"
+            );
+        }
+
+        //  Switching between arenas doesn't waste the chunks.
+        {
+            xap::core::json::Arena a(1024U);
+            xap::core::json::Arena b(1024U);
+            for (size_t i = 0U; i < 1000U; ++i) {
+                a.allocate(8U, 8U);
+                b.allocate(8U, 8U);
+            }
+            xap::test::assert_ok(
+                a.get_reserved_size() < 16U * 1024U &&
+                    b.get_reserved_size() < 16U * 1024U,
+                "Chunks are wasted."
+            );
+            xap::test::assert_equal<size_t>(
+                a.get_allocated_size(),
+                8000U,
+                "a.get_allocated_size() != 8000"
+            );
+        }
+
+        const xap::core::json::Backend backends[] = {
+            xap::core::json::Backend::jsoncpp,
+            xap::core::json::Backend::native
+        };
+        for (const xap::core::json::Backend backend : backends) {
+            xap::core::json::Parser parser(backend);
+            std::unique_ptr<xap::core::json::Traverse> root;
+            {
+                xap::core::json::Arena arena;
+                parser.set_arena(&arena);
+                root.reset(new xap::core::json::Traverse(parser.parse(
+                    "{\"a_long_long_long_key\": {\"b\": [1, 2, 3]}, "
+                    "\"c\": \"a string that is longer than SSO\"}"
+                )));
+                const size_t allocated = arena.get_allocated_size();
+                xap::test::assert_ok(
+                    allocated != 0U,
+                    "The document is not allocated from the arena."
+                );
+
+                //  Derived traverse objects (and paths) are allocated from
+                //  the arena.
+                xap::core::json::Traverse b =
+                    root->sub("a_long_long_long_key").sub("b");
+                xap::test::assert_ok(
+                    arena.get_allocated_size() > allocated,
+                    "Traverse objects are not allocated from the arena."
+                );
+                xap::test::assert_equal<std::string>(
+                    b.get_path(),
+                    "/a_long_long_long_key/b",
+                    "b.get_path() != \"/a_long_long_long_key/b\""
+                );
+
+                //  Documents parsed without arena.
+                parser.set_arena(nullptr);
+                const size_t before = arena.get_allocated_size();
+                xap::core::json::Traverse other = parser.parse("[1, {}]");
+                other.array_pop_item();
+                xap::test::assert_equal<size_t>(
+                    arena.get_allocated_size(),
+                    before,
+                    "The arena is used after it was unset."
+                );
+            }
+
+            //  The document outlives the arena object.
+            xap::test::assert_equal<std::string>(
+                root->sub("c").inner_as_string(),
+                "a string that is longer than SSO",
+                "root->sub(\"c\") != \"a string that is longer than SSO\""
+            );
+            xap::core::json::Traverse b =
+                root->sub("a_long_long_long_key").sub("b");
+            xap::test::assert_equal<size_t>(
+                b.array_get_length(),
+                3U,
+                "b.array_get_length() != 3"
+            );
+
+            //  Modifiers (copy-on-write).
+            b.array_push_item(xap::core::json::Traverse("4"));
+            xap::test::assert_equal<int>(
+                b.array_pop_item().inner_as_int(),
+                4,
+                "b.array_pop_item() != 4"
+            );
+            root->object_set("d", xap::core::json::Traverse("true"));
+            xap::test::assert_ok(
+                root->sub("d").inner_as_boolean(),
+                "root->sub(\"d\") != true"
+            );
+            root.reset();
+            xap::test::assert_equal<int>(
+                b.array_pop_item().inner_as_int(),
+                3,
+                "b.array_pop_item() != 3"
+            );
+        }
+
+        //  Paths keep their segment names after the documents (and the
+        //  pointers) they were taken from are released.
+        const xap::core::json::Backend path_backends[] = {
+            xap::core::json::Backend::jsoncpp,
+            xap::core::json::Backend::native,
+            xap::core::json::Backend::lazy
+        };
+        for (const xap::core::json::Backend backend : path_backends) {
+            xap::core::json::Parser parser(backend);
+            const std::string text =
+                "{\"a_long_long_long_key\": "
+                "{\"b\": {\"c\": [1, {\"d\": true}]}}}";
+
+            //  Detached (copy-on-write) value.
+            std::unique_ptr<xap::core::json::Traverse> root(
+                new xap::core::json::Traverse(parser.parse(text))
+            );
+            xap::core::json::Traverse b =
+                root->sub("a_long_long_long_key").sub("b");
+            root.reset();
+            b.object_set("e", xap::core::json::Traverse("1"));
+            xap::test::assert_equal<std::string>(
+                b.sub("e").get_path(),
+                "/a_long_long_long_key/b/e",
+                "b.sub(\"e\").get_path() != \"/a_long_long_long_key/b/e\""
+            );
+
+            //  Default value of a missing member.
+            root.reset(new xap::core::json::Traverse(parser.parse(text)));
+            std::unique_ptr<xap::core::json::Traverse> parent(
+                new xap::core::json::Traverse(
+                    root->sub("a_long_long_long_key").sub("b")
+                )
+            );
+            root.reset();
+            xap::core::json::Traverse missing = parent->optional_sub(
+                "missing",
+                xap::core::json::Traverse("{\"f\": 2}")
+            );
+            parent.reset();
+            xap::test::assert_equal<std::string>(
+                missing.sub("f").get_path(),
+                "/a_long_long_long_key/b/missing/f",
+                "missing.sub(\"f\").get_path() != "
+                "\"/a_long_long_long_key/b/missing/f\""
+            );
+
+            //  Popped array item.
+            root.reset(new xap::core::json::Traverse(parser.parse(text)));
+            std::unique_ptr<xap::core::json::Traverse> array(
+                new xap::core::json::Traverse(
+                    root->sub("a_long_long_long_key").sub("b").sub("c")
+                )
+            );
+            root.reset();
+            xap::core::json::Traverse item = array->array_pop_item();
+            array.reset();
+            xap::test::assert_equal<std::string>(
+                item.sub("d").get_path(),
+                "/a_long_long_long_key/b/c/1/d",
+                "item.sub(\"d\").get_path() != "
+                "\"/a_long_long_long_key/b/c/1/d\""
+            );
+
+            //  Temporary pointer.
+            root.reset(new xap::core::json::Traverse(parser.parse(text)));
+            xap::core::json::Traverse d = root->at(
+                xap::core::json::Pointer("/a_long_long_long_key/b/c/1/d")
+            );
+            root.reset();
+            xap::test::assert_equal<std::string>(
+                d.get_path(),
+                "/a_long_long_long_key/b/c/1/d",
+                "d.get_path() != \"/a_long_long_long_key/b/c/1/d\""
+            );
+        }
+    } catch (xap::core::json::Exception &error) {
+        printf("Throw unexpected XAP JSON error (\"%s\").\n", error.what());
+        xap::test::assert_ok(false, "Throw unexpected XAP JSON error.");
+    } catch (std::exception &error) {
+        printf(
+            "Throw unexpected std::exception error (\"%s\").\n",
+            error.what()
+        );
+        xap::test::assert_ok(false, "Throw unexpected std::exception error.");
+    }
+}
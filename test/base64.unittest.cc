@@ -0,0 +1,326 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+//
+//  Imports.
+//
+#include "common.h"
+#include "base64_p.h"
+#include "scanner_p.h"
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include <xap/core/json/all.h>
+
+//
+//  Private functions.
+//
+
+/**
+ *  Encode data to base64 (reference of the decoder).
+ *
+ *  @param data
+ *      The data.
+ *  @param padding
+ *      True if the output is padded.
+ *  @return
+ *      The encoded data.
+ */
+static std::string reference_encode(
+    const std::vector<uint8_t> &data,
+    const bool padding
+) {
+    static const char alphabet[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string encoded;
+    for (size_t i = 0U; i < data.size(); i += 3U) {
+        uint32_t bits = static_cast<uint32_t>(data[i]) << 16U;
+        if (i + 1U < data.size()) {
+            bits |= static_cast<uint32_t>(data[i + 1U]) << 8U;
+        }
+        if (i + 2U < data.size()) {
+            bits |= data[i + 2U];
+        }
+        const size_t count = data.size() - i < 3U ? data.size() - i : 3U;
+        for (size_t j = 0U; j <= count; ++j) {
+            encoded += alphabet[(bits >> (18U - 6U * j)) & 0x3FU];
+        }
+        if (padding) {
+            encoded.append(3U - count, '=');
+        }
+    }
+    return encoded;
+}
+
+/**
+ *  Decode base64 with a decoder.
+ *
+ *  @param decoder
+ *      The decoder.
+ *  @param input
+ *      The input.
+ *  @param out
+ *      The decoded data.
+ *  @return
+ *      True if the input is valid.
+ */
+static bool decode(
+    const xap::core::json::Base64Decoder &decoder,
+    const std::string &input,
+    std::vector<uint8_t> *out
+) {
+    size_t data_length = 0U;
+    size_t size = 0U;
+    if (!xap::core::json::Base64Decoder::measure(
+        input.data(),
+        input.size(),
+        &data_length,
+        &size
+    )) {
+        return false;
+    }
+    out->resize(size);
+    return decoder.decode(input.data(), data_length, out->data());
+}
+
+//
+//  Entry.
+//
+
+int main() {
+    try {
+        //  Kernels.
+        const xap::core::json::ScannerKernel kernels[] = {
+            xap::core::json::ScannerKernel::scalar,
+            xap::core::json::ScannerKernel::sse42,
+            xap::core::json::ScannerKernel::avx2
+        };
+        const std::string invalid_characters = "-_.* \n\"\\\x80\xFF";
+        std::mt19937 random(20221016U);
+        for (const xap::core::json::ScannerKernel kernel : kernels) {
+            if (!xap::core::json::StructuralScanner::is_kernel_supported(
+                kernel
+            )) {
+                printf("Kernel %d is not supported, skipped.\n", kernel);
+                continue;
+            }
+            xap::core::json::Base64Decoder decoder(kernel);
+            xap::test::assert_ok(
+                decoder.get_kernel() == kernel,
+                "decoder.get_kernel() != kernel"
+            );
+
+            for (size_t round = 0U; round < 1000U; ++round) {
+                //  Random data (up to about 3 AVX2 chunks).
+                std::vector<uint8_t> data(random() % 100U);
+                for (uint8_t &byte : data) {
+                    byte = static_cast<uint8_t>(random());
+                }
+                std::string input = reference_encode(data, round % 2U == 0U);
+                std::vector<uint8_t> decoded;
+                xap::test::assert_ok(
+                    decode(decoder, input, &decoded),
+                    "decode() failed."
+                );
+                xap::test::assert_ok(decoded == data, "decoded != data");
+
+                //  A character out of the alphabet.
+                if (!input.empty()) {
+                    input[random() % input.size()] = invalid_characters[
+                        random() % invalid_characters.size()
+                    ];
+                    if (decode(decoder, input, &decoded)) {
+                        printf(
+                            "Accepted (kernel %d, round %zu, \"%s\").\n",
+                            kernel,
+                            round,
+                            input.c_str()
+                        );
+                    }
+                    xap::test::assert_ok(
+                        !decode(decoder, input, &decoded),
+                        "decode() succeeded."
+                    );
+                }
+            }
+        }
+
+        //  Lengths and padding.
+        {
+            xap::core::json::Base64Decoder decoder;
+            std::vector<uint8_t> decoded;
+            const char *valid_inputs[] = {"", "QQ", "QQ==", "QUI", "QUI="};
+            for (const char *input : valid_inputs) {
+                xap::test::assert_ok(
+                    decode(decoder, input, &decoded),
+                    "decode() failed."
+                );
+            }
+            const char *invalid_inputs[] = {
+                "Q", "QUJDR", "QQ=", "Q===", "====", "QUJD=", "QUJD====",
+                "QU=D", "QQ==QUJD"
+            };
+            for (const char *input : invalid_inputs) {
+                xap::test::assert_ok(
+                    !decode(decoder, input, &decoded),
+                    "decode() succeeded."
+                );
+            }
+        }
+
+        //  Accessors.
+        const xap::core::json::Backend backends[] = {
+            xap::core::json::Backend::jsoncpp,
+            xap::core::json::Backend::native,
+            xap::core::json::Backend::lazy
+        };
+        std::vector<uint8_t> long_data(3000U);
+        for (size_t i = 0U; i < long_data.size(); ++i) {
+            long_data[i] = static_cast<uint8_t>(i * 7U);
+        }
+        const std::string long_input = reference_encode(long_data, true);
+        for (const xap::core::json::Backend backend : backends) {
+            xap::core::json::Parser parser(backend);
+            xap::core::json::Traverse root = parser.parse(
+                "{\"a\": \"SGVsbG8=\", \"b\": \"SGVsbG8\", "
+                "\"c\": \"a\\/8=\", \"d\": \"" + long_input + "\", "
+                "\"e\": \"SGV*bG8=\", \"f\": \"SGVsbG8==\", "
+                "\"g\": null, \"h\": 1, \"i\": \"\"}"
+            );
+
+            //  Padded, unpadded and escaped.
+            const std::vector<uint8_t> hello = {'H', 'e', 'l', 'l', 'o'};
+            xap::test::assert_ok(
+                root.sub("a").inner_as_base64() == hello,
+                "a != Hello"
+            );
+            xap::test::assert_ok(
+                root.sub("b").inner_as_base64() == hello,
+                "b != Hello"
+            );
+            xap::test::assert_ok(
+                root.sub("c").inner_as_base64() ==
+                    std::vector<uint8_t>({0x6BU, 0xFFU}),
+                "c != 6B FF"
+            );
+            xap::test::assert_ok(
+                root.sub("i").inner_as_base64().empty(),
+                "i is not empty."
+            );
+            xap::test::assert_ok(
+                root.sub("d").inner_as_base64() == long_data,
+                "d != long_data"
+            );
+
+            //  Buffers (shorter or longer than the decoded data).
+            {
+                xap::core::json::Traverse d = root.sub("d");
+                std::vector<uint8_t> buffer(3001U, 0xAAU);
+                xap::test::assert_equal<size_t>(
+                    d.inner_as_base64(buffer.data(), 1000U),
+                    3000U,
+                    "length != 3000"
+                );
+                xap::test::assert_ok(
+                    std::equal(
+                        buffer.begin(),
+                        buffer.begin() + 1000,
+                        long_data.begin()
+                    ),
+                    "buffer[0, 1000) != long_data"
+                );
+                xap::test::assert_equal<uint8_t>(
+                    buffer[1000],
+                    0xAAU,
+                    "buffer[1000] was written."
+                );
+                xap::test::assert_equal<size_t>(
+                    d.inner_as_base64(buffer.data(), buffer.size()),
+                    3000U,
+                    "length != 3000"
+                );
+                xap::test::assert_ok(
+                    std::equal(
+                        long_data.begin(),
+                        long_data.end(),
+                        buffer.begin()
+                    ),
+                    "buffer != long_data"
+                );
+                xap::test::assert_equal<uint8_t>(
+                    buffer[3000],
+                    0xAAU,
+                    "buffer[3000] was written."
+                );
+                size_t length = 0U;
+                xap::test::assert_ok(
+                    d.try_inner_as_base64(nullptr, 0U, &length),
+                    "try_inner_as_base64() failed."
+                );
+                xap::test::assert_equal<size_t>(
+                    length,
+                    3000U,
+                    "length != 3000"
+                );
+            }
+
+            //  Malformed (even if the buffer is short), null and other
+            //  types.
+            const char *keys[] = {"e", "f", "g", "h"};
+            for (const char *key : keys) {
+                xap::core::json::Traverse sub = root.sub(key);
+                xap::core::json::Status status;
+                uint8_t buffer[1];
+                xap::test::assert_ok(
+                    !sub.try_inner_as_base64(buffer, 1U, nullptr, &status),
+                    "try_inner_as_base64() succeeded."
+                );
+                xap::test::assert_equal<uint16_t>(
+                    status.get_code(),
+                    xap::core::json::ERROR_TYPE,
+                    "status.get_code() != ERROR_TYPE"
+                );
+                xap::test::assert_equal<std::string>(
+                    status.get_path(),
+                    std::string("/") + key,
+                    "status.get_path() != key"
+                );
+                xap::test::assert_throw<xap::core::json::Exception>(
+                    [&sub] () {
+                        sub.inner_as_base64();
+                    },
+                    "inner_as_base64() doesn't throw."
+                );
+            }
+            {
+                std::string input = long_input;
+                input[2500] = '.';
+                xap::core::json::Traverse tail = parser.parse(
+                    "\"" + input + "\""
+                );
+                uint8_t buffer[16];
+                xap::test::assert_ok(
+                    !tail.try_inner_as_base64(buffer, 16U, nullptr),
+                    "try_inner_as_base64() succeeded (tail)."
+                );
+            }
+        }
+    } catch (xap::core::json::Exception &error) {
+        printf("Throw unexpected XAP JSON error (\"%s\").\n", error.what());
+        xap::test::assert_ok(false, "Throw unexpected XAP JSON error.");
+    } catch (std::exception &error) {
+        printf(
+            "Throw unexpected std::exception error (\"%s\").\n",
+            error.what()
+        );
+        xap::test::assert_ok(false, "Throw unexpected std::exception error.");
+    }
+}
@@ -0,0 +1,398 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+//
+//  Imports.
+//
+#include "common.h"
+
+#include <iostream>
+#include <stdint.h>
+#include <string>
+#include <xap/core/json/all.h>
+
+//
+//  Structures.
+//
+
+namespace sample {
+
+/**
+ *  Device.
+ */
+struct Device {
+    uint id = 0U;
+    std::string name = "unnamed";
+};
+
+XAPCORE_JSON_BIND(
+    Device,
+    xap::core::json::bind_field("id", &Device::id),
+    xap::core::json::bind_field("name", &Device::name, false)
+)
+
+/**
+ *  Message.
+ */
+struct Message {
+    int64_t timestamp = 0;
+    int level = 0;
+    uint64_t sequence = 0U;
+    bool enabled = false;
+    float ratio = 0.0F;
+    double score = 0.0;
+    Device device;
+};
+
+XAPCORE_JSON_BIND(
+    Message,
+    xap::core::json::bind_field("timestamp", &Message::timestamp),
+    xap::core::json::bind_field("level", &Message::level),
+    xap::core::json::bind_field("sequence", &Message::sequence, false),
+    xap::core::json::bind_field("enabled", &Message::enabled),
+    xap::core::json::bind_field("ratio", &Message::ratio, false),
+    xap::core::json::bind_field("score", &Message::score, false),
+    xap::core::json::bind_field("device", &Message::device)
+)
+
+/**
+ *  Pair of devices (nested structures before the last member).
+ */
+struct Pair {
+    Device x;
+    Device y;
+    int z = 0;
+};
+
+XAPCORE_JSON_BIND(
+    Pair,
+    xap::core::json::bind_field("x", &Pair::x),
+    xap::core::json::bind_field("y", &Pair::y),
+    xap::core::json::bind_field("z", &Pair::z)
+)
+
+/**
+ *  Structure with a duplicated key.
+ */
+struct Duplicated {
+    int a = 0;
+    int b = 0;
+};
+
+XAPCORE_JSON_BIND(
+    Duplicated,
+    xap::core::json::bind_field("a", &Duplicated::a),
+    xap::core::json::bind_field("a", &Duplicated::b)
+)
+
+}  //  namespace sample
+
+/**
+ *  Structure (in the global namespace) without fields.
+ */
+struct Empty {
+    int unused = 1;
+};
+
+XAPCORE_JSON_BIND(Empty)
+
+//
+//  Private functions.
+//
+
+/**
+ *  Check that binding fails.
+ *
+ *  @param backend
+ *      The backend.
+ *  @param document
+ *      The document.
+ *  @param code
+ *      The expected error code.
+ *  @param path
+ *      The expected path of the error.
+ */
+static void check_failure(
+    const xap::core::json::Backend backend,
+    const std::string &document,
+    const uint16_t code,
+    const std::string &path
+) {
+    xap::core::json::Parser parser(backend);
+    xap::core::json::Traverse root = parser.parse(document);
+
+    //  Throwing.
+    bool thrown = false;
+    try {
+        xap::core::json::bind<sample::Message>(root);
+    } catch (xap::core::json::Exception &error) {
+        thrown = true;
+        xap::test::assert_equal<uint16_t>(
+            error.get_code(),
+            code,
+            "error.get_code() != code"
+        );
+        xap::test::assert_equal<std::string>(
+            error.get_path(),
+            path,
+            "error.get_path() != path"
+        );
+    }
+    xap::test::assert_ok(thrown, "bind() doesn't throw.");
+
+    //  Non-throwing.
+    sample::Message message;
+    xap::core::json::Status status;
+    xap::test::assert_ok(
+        !xap::core::json::try_bind(root, &message, &status),
+        "try_bind() succeeded."
+    );
+    xap::test::assert_equal<uint16_t>(
+        status.get_code(),
+        code,
+        "status.get_code() != code"
+    );
+    xap::test::assert_equal<std::string>(
+        status.get_path(),
+        path,
+        "status.get_path() != path"
+    );
+    xap::test::assert_ok(
+        !xap::core::json::try_bind(root, &message),
+        "try_bind() succeeded (without status)."
+    );
+}
+
+//
+//  Entry.
+//
+
+int main() {
+    try {
+        const xap::core::json::Backend backends[] = {
+            xap::core::json::Backend::jsoncpp,
+            xap::core::json::Backend::native,
+            xap::core::json::Backend::lazy
+        };
+        for (const xap::core::json::Backend backend : backends) {
+            xap::core::json::Parser parser(backend);
+
+            //  All fields.
+            {
+                xap::core::json::Traverse root = parser.parse(
+                    "{\"timestamp\": 1650000000000, \"level\": -2, "
+                    "\"sequence\": 18446744073709551615, "
+                    "\"enabled\": true, \"ratio\": 0.5, \"score\": 1.25, "
+                    "\"unknown\": [1, {\"id\": 2}], "
+                    "\"device\": {\"name\": \"dev\", \"id\": 7}}"
+                );
+                const sample::Message message =
+                    xap::core::json::bind<sample::Message>(root);
+                xap::test::assert_equal<int64_t>(
+                    message.timestamp,
+                    1650000000000LL,
+                    "message.timestamp != 1650000000000"
+                );
+                xap::test::assert_equal<int>(
+                    message.level,
+                    -2,
+                    "message.level != -2"
+                );
+                xap::test::assert_equal<uint64_t>(
+                    message.sequence,
+                    UINT64_MAX,
+                    "message.sequence != UINT64_MAX"
+                );
+                xap::test::assert_ok(message.enabled, "!message.enabled");
+                xap::test::assert_equal<float>(
+                    message.ratio,
+                    0.5F,
+                    "message.ratio != 0.5"
+                );
+                xap::test::assert_equal<double>(
+                    message.score,
+                    1.25,
+                    "message.score != 1.25"
+                );
+                xap::test::assert_equal<uint>(
+                    message.device.id,
+                    7U,
+                    "message.device.id != 7"
+                );
+                xap::test::assert_equal<std::string>(
+                    message.device.name,
+                    "dev",
+                    "message.device.name != dev"
+                );
+
+                //  A sub directory.
+                sample::Device device;
+                xap::core::json::Traverse sub = root.sub("device");
+                xap::core::json::bind(sub, &device);
+                xap::test::assert_equal<uint>(
+                    device.id,
+                    7U,
+                    "device.id != 7"
+                );
+            }
+
+            //  Nested structures that are not the last member (the lazy
+            //  backend grows the tape while the members are visited).
+            {
+                xap::core::json::Traverse root = parser.parse(
+                    "{\"x\": {\"id\": 1, \"b\": 2, \"p\": 3, \"q\": 4, "
+                    "\"r\": 5, \"s\": 6, \"t\": 7, \"u\": 8}, "
+                    "\"y\": {\"id\": 3, \"b\": 4, "
+                    "\"c\": [1, 2, 3, 4, 5, 6, 7, 8, 9]}, \"z\": 5}"
+                );
+                const sample::Pair pair =
+                    xap::core::json::bind<sample::Pair>(root);
+                xap::test::assert_equal<uint>(pair.x.id, 1U, "pair.x.id != 1");
+                xap::test::assert_equal<uint>(pair.y.id, 3U, "pair.y.id != 3");
+                xap::test::assert_equal<int>(pair.z, 5, "pair.z != 5");
+            }
+
+            //  Optional fields can be null (or non-existed) and are left
+            //  unchanged.
+            {
+                xap::core::json::Traverse root = parser.parse(
+                    "{\"timestamp\": 0, \"level\": 3, \"enabled\": false, "
+                    "\"ratio\": null, \"device\": {\"id\": 0}}"
+                );
+                sample::Message message;
+                message.ratio = 2.0F;
+                xap::test::assert_ok(
+                    xap::core::json::try_bind(root, &message),
+                    "try_bind() failed."
+                );
+                xap::test::assert_equal<int>(
+                    message.level,
+                    3,
+                    "message.level != 3"
+                );
+                xap::test::assert_equal<float>(
+                    message.ratio,
+                    2.0F,
+                    "message.ratio != 2"
+                );
+                xap::test::assert_equal<std::string>(
+                    message.device.name,
+                    "unnamed",
+                    "message.device.name != unnamed"
+                );
+            }
+
+            //  Structures without fields.
+            {
+                xap::core::json::Traverse root = parser.parse("{\"a\": 1}");
+                const Empty empty = xap::core::json::bind<Empty>(root);
+                xap::test::assert_equal<int>(
+                    empty.unused,
+                    1,
+                    "empty.unused != 1"
+                );
+            }
+
+            //  A required field is non-existed.
+            check_failure(
+                backend,
+                "{\"timestamp\": 1, \"level\": 2, \"enabled\": true}",
+                xap::core::json::ERROR_NOTFIND,
+                "/device"
+            );
+            check_failure(
+                backend,
+                "{\"timestamp\": 1, \"level\": 2, \"enabled\": true, "
+                "\"device\": {}}",
+                xap::core::json::ERROR_NOTFIND,
+                "/device/id"
+            );
+
+            //  A required field is null.
+            check_failure(
+                backend,
+                "{\"timestamp\": null, \"level\": 2}",
+                xap::core::json::ERROR_TYPE,
+                "/timestamp"
+            );
+
+            //  A field has another type (or doesn't fit).
+            check_failure(
+                backend,
+                "{\"timestamp\": 1, \"level\": 2, \"enabled\": 1}",
+                xap::core::json::ERROR_TYPE,
+                "/enabled"
+            );
+            check_failure(
+                backend,
+                "{\"timestamp\": 1, \"level\": 4294967296}",
+                xap::core::json::ERROR_TYPE,
+                "/level"
+            );
+            check_failure(
+                backend,
+                "{\"timestamp\": 1.5}",
+                xap::core::json::ERROR_TYPE,
+                "/timestamp"
+            );
+            check_failure(
+                backend,
+                "{\"sequence\": -1}",
+                xap::core::json::ERROR_TYPE,
+                "/sequence"
+            );
+            check_failure(
+                backend,
+                "{\"timestamp\": 1, \"level\": 2, \"enabled\": true, "
+                "\"device\": {\"id\": 1, \"name\": 5}}",
+                xap::core::json::ERROR_TYPE,
+                "/device/name"
+            );
+            check_failure(
+                backend,
+                "{\"timestamp\": 1, \"level\": 2, \"enabled\": true, "
+                "\"device\": [1]}",
+                xap::core::json::ERROR_TYPE,
+                "/device"
+            );
+
+            //  The bound object itself.
+            check_failure(
+                backend,
+                "[]",
+                xap::core::json::ERROR_TYPE,
+                "/"
+            );
+            check_failure(
+                backend,
+                "null",
+                xap::core::json::ERROR_TYPE,
+                "/"
+            );
+        }
+
+        //  Duplicated keys.
+        {
+            xap::core::json::Parser parser;
+            xap::core::json::Traverse root = parser.parse("{\"a\": 1}");
+            xap::test::assert_throw<xap::core::json::Exception>(
+                [&root] () {
+                    xap::core::json::bind<sample::Duplicated>(root);
+                },
+                "Duplicate field."
+            );
+        }
+    } catch (xap::core::json::Exception &error) {
+        printf("Throw unexpected XAP JSON error (\"%s\").\n", error.what());
+        xap::test::assert_ok(false, "Throw unexpected XAP JSON error.");
+    } catch (std::exception &error) {
+        printf(
+            "Throw unexpected std::exception error (\"%s\").\n",
+            error.what()
+        );
+        xap::test::assert_ok(false, "Throw unexpected std::exception error.");
+    }
+}
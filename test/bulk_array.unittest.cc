@@ -0,0 +1,434 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+//
+//  Imports.
+//
+#include "common.h"
+
+#include <functional>
+#include <iostream>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <xap/core/json/all.h>
+
+//
+//  Private functions.
+//
+
+/**
+ *  Check that a bulk accessor fails the same way as the accessor of the
+ *  failed item.
+ *
+ *  @param root
+ *      The root (an object with member "a").
+ *  @param bulk
+ *      The bulk accessor (non-throwing, must fail).
+ *  @param item
+ *      The accessor of the failed item (must throw).
+ *  @param path
+ *      The expected path of the error.
+ */
+static void check_failure(
+    xap::core::json::Traverse &root,
+    const std::function<bool(
+        xap::core::json::Traverse &,
+        xap::core::json::Status *
+    )> &bulk,
+    const std::function<void(xap::core::json::Traverse &)> &item,
+    const std::string &path
+) {
+    std::string item_message;
+    try {
+        item(root);
+    } catch (xap::core::json::Exception &error) {
+        item_message = error.what();
+        xap::test::assert_equal<std::string>(
+            error.get_path(),
+            path,
+            "item path"
+        );
+    }
+    xap::test::assert_ok(item_message.size() != 0U, "item doesn't throw.");
+
+    xap::core::json::Traverse a = root.sub("a");
+    xap::core::json::Status status;
+    xap::test::assert_ok(!bulk(a, &status), "bulk accessor succeeded.");
+    xap::test::assert_equal<std::string>(
+        status.what(),
+        item_message,
+        "status.what() != item message"
+    );
+    xap::test::assert_equal<uint16_t>(
+        status.get_code(),
+        xap::core::json::ERROR_TYPE,
+        "status.get_code() != ERROR_TYPE"
+    );
+    xap::test::assert_equal<std::string>(
+        status.get_path(),
+        path,
+        "status.get_path() != path"
+    );
+}
+
+//
+//  Entry.
+//
+
+int main() {
+    try {
+        //  A long array (crosses several chunks).
+        std::string long_array = "{\"a\": [";
+        for (size_t i = 0U; i < 1000U; ++i) {
+            if (i != 0U) {
+                long_array += ", ";
+            }
+            long_array += std::to_string(i);
+        }
+        long_array += "]}";
+
+        const xap::core::json::Backend backends[] = {
+            xap::core::json::Backend::jsoncpp,
+            xap::core::json::Backend::native,
+            xap::core::json::Backend::lazy
+        };
+        for (const xap::core::json::Backend backend : backends) {
+            xap::core::json::Parser parser(backend);
+
+            //  All types.
+            {
+                xap::core::json::Traverse root = parser.parse(
+                    "{\"a\": [1, 2.0, 3], \"b\": [-1, 0.5, 1e10], "
+                    "\"c\": [18446744073709551615, 0], "
+                    "\"d\": [-9007199254740993, 4294967296]}"
+                );
+                xap::core::json::Traverse a = root.sub("a");
+                xap::core::json::Traverse b = root.sub("b");
+                xap::core::json::Traverse c = root.sub("c");
+                xap::core::json::Traverse d = root.sub("d");
+
+                const std::vector<int> ints = a.inner_as_int_array();
+                xap::test::assert_ok(
+                    ints == std::vector<int>({1, 2, 3}),
+                    "ints != [1, 2, 3]"
+                );
+                const std::vector<uint> uints = a.inner_as_uint_array();
+                xap::test::assert_ok(
+                    uints == std::vector<uint>({1U, 2U, 3U}),
+                    "uints != [1, 2, 3]"
+                );
+                const std::vector<int64_t> int64s = d.inner_as_int64_array();
+                xap::test::assert_ok(
+                    int64s == std::vector<int64_t>(
+                        {-9007199254740993LL, 4294967296LL}
+                    ),
+                    "int64s != [-9007199254740993, 4294967296]"
+                );
+                const std::vector<uint64_t> uint64s =
+                    c.inner_as_uint64_array();
+                xap::test::assert_ok(
+                    uint64s == std::vector<uint64_t>({UINT64_MAX, 0U}),
+                    "uint64s != [UINT64_MAX, 0]"
+                );
+                const std::vector<float> floats = b.inner_as_float_array();
+                xap::test::assert_ok(
+                    floats == std::vector<float>({-1.0F, 0.5F, 1e10F}),
+                    "floats != [-1, 0.5, 1e10]"
+                );
+                const std::vector<double> doubles =
+                    b.inner_as_double_array();
+                xap::test::assert_ok(
+                    doubles == std::vector<double>({-1.0, 0.5, 1e10}),
+                    "doubles != [-1, 0.5, 1e10]"
+                );
+            }
+
+            //  16-bit PCM samples are clamped.
+            {
+                xap::core::json::Traverse root = parser.parse(
+                    "{\"a\": [0, -1.9, 32767, 32768, -32768, -40000, "
+                    "18446744073709551615, 1e300]}"
+                );
+                xap::core::json::Traverse a = root.sub("a");
+                const std::vector<int16_t> samples = a.inner_as_int16_array();
+                xap::test::assert_ok(
+                    samples == std::vector<int16_t>({
+                        0, -1, 32767, 32767, -32768, -32768, 32767, 32767
+                    }),
+                    "samples are not clamped."
+                );
+            }
+
+            //  Buffers (shorter or longer than the array).
+            {
+                xap::core::json::Traverse root = parser.parse(long_array);
+                xap::core::json::Traverse a = root.sub("a");
+                double buffer[1001];
+                buffer[300] = -1.0;
+                xap::test::assert_equal<size_t>(
+                    a.inner_as_double_array(buffer, 300U),
+                    1000U,
+                    "length != 1000"
+                );
+                xap::test::assert_equal<double>(
+                    buffer[299],
+                    299.0,
+                    "buffer[299] != 299"
+                );
+                xap::test::assert_equal<double>(
+                    buffer[300],
+                    -1.0,
+                    "buffer[300] was written."
+                );
+                buffer[1000] = -1.0;
+                xap::test::assert_equal<size_t>(
+                    a.inner_as_double_array(buffer, 1001U),
+                    1000U,
+                    "length != 1000"
+                );
+                xap::test::assert_equal<double>(
+                    buffer[999],
+                    999.0,
+                    "buffer[999] != 999"
+                );
+                xap::test::assert_equal<double>(
+                    buffer[1000],
+                    -1.0,
+                    "buffer[1000] was written."
+                );
+                size_t length = 0U;
+                xap::test::assert_ok(
+                    a.try_inner_as_double_array(nullptr, 0U, &length),
+                    "try_inner_as_double_array() failed."
+                );
+                xap::test::assert_equal<size_t>(
+                    length,
+                    1000U,
+                    "length != 1000"
+                );
+                xap::test::assert_equal<size_t>(
+                    a.inner_as_uint_array().size(),
+                    1000U,
+                    "inner_as_uint_array().size() != 1000"
+                );
+            }
+
+            //  An item fails (in a later chunk).
+            {
+                std::string document = long_array;
+                document.replace(document.size() - 10U, 3U, "1.5");
+                xap::core::json::Traverse root = parser.parse(document);
+                check_failure(
+                    root,
+                    [] (
+                        xap::core::json::Traverse &a,
+                        xap::core::json::Status *status
+                    ) {
+                        std::vector<int> buffer(1000U);
+                        return a.try_inner_as_int_array(
+                            buffer.data(),
+                            buffer.size(),
+                            nullptr,
+                            status
+                        );
+                    },
+                    [] (xap::core::json::Traverse &root) {
+                        xap::core::json::Pointer pointer("/a/998");
+                        root.at(pointer).inner_as_int();
+                    },
+                    "/a/998"
+                );
+
+                //  Not converted.
+                xap::core::json::Traverse a = root.sub("a");
+                int buffer[998];
+                xap::test::assert_equal<size_t>(
+                    a.inner_as_int_array(buffer, 998U),
+                    1000U,
+                    "length != 1000"
+                );
+            }
+
+            //  Items that are null, have another type or don't fit.
+            {
+                xap::core::json::Traverse root = parser.parse(
+                    "{\"a\": [1, null, \"x\", -1, 1.5, true]}"
+                );
+                check_failure(
+                    root,
+                    [] (
+                        xap::core::json::Traverse &a,
+                        xap::core::json::Status *status
+                    ) {
+                        double buffer[6];
+                        return a.try_inner_as_double_array(
+                            buffer,
+                            6U,
+                            nullptr,
+                            status
+                        );
+                    },
+                    [] (xap::core::json::Traverse &root) {
+                        xap::core::json::Pointer pointer("/a/1");
+                        root.at(pointer).inner_as_double();
+                    },
+                    "/a/1"
+                );
+                check_failure(
+                    root,
+                    [] (
+                        xap::core::json::Traverse &a,
+                        xap::core::json::Status *status
+                    ) {
+                        int16_t buffer[6];
+                        return a.try_inner_as_int16_array(
+                            buffer,
+                            6U,
+                            nullptr,
+                            status
+                        );
+                    },
+                    [] (xap::core::json::Traverse &root) {
+                        xap::core::json::Pointer pointer("/a/1");
+                        root.at(pointer).inner_as_double();
+                    },
+                    "/a/1"
+                );
+
+                //  Skip the null item.
+                xap::core::json::Traverse tail = parser.parse(
+                    "{\"a\": [\"x\", -1, 1.5, true]}"
+                );
+                check_failure(
+                    tail,
+                    [] (
+                        xap::core::json::Traverse &a,
+                        xap::core::json::Status *status
+                    ) {
+                        float buffer[4];
+                        return a.try_inner_as_float_array(
+                            buffer,
+                            4U,
+                            nullptr,
+                            status
+                        );
+                    },
+                    [] (xap::core::json::Traverse &root) {
+                        xap::core::json::Pointer pointer("/a/0");
+                        root.at(pointer).inner_as_float();
+                    },
+                    "/a/0"
+                );
+                check_failure(
+                    tail,
+                    [] (
+                        xap::core::json::Traverse &a,
+                        xap::core::json::Status *status
+                    ) {
+                        uint64_t buffer[4];
+                        return a.try_inner_as_uint64_array(
+                            buffer,
+                            4U,
+                            nullptr,
+                            status
+                        );
+                    },
+                    [] (xap::core::json::Traverse &root) {
+                        xap::core::json::Pointer pointer("/a/0");
+                        root.at(pointer).inner_as_uint64();
+                    },
+                    "/a/0"
+                );
+
+                xap::core::json::Traverse numbers = parser.parse(
+                    "{\"a\": [1, -1, 1.5]}"
+                );
+                check_failure(
+                    numbers,
+                    [] (
+                        xap::core::json::Traverse &a,
+                        xap::core::json::Status *status
+                    ) {
+                        uint buffer[3];
+                        return a.try_inner_as_uint_array(
+                            buffer,
+                            3U,
+                            nullptr,
+                            status
+                        );
+                    },
+                    [] (xap::core::json::Traverse &root) {
+                        xap::core::json::Pointer pointer("/a/1");
+                        root.at(pointer).inner_as_uint();
+                    },
+                    "/a/1"
+                );
+                check_failure(
+                    numbers,
+                    [] (
+                        xap::core::json::Traverse &a,
+                        xap::core::json::Status *status
+                    ) {
+                        int64_t buffer[3];
+                        return a.try_inner_as_int64_array(
+                            buffer,
+                            3U,
+                            nullptr,
+                            status
+                        );
+                    },
+                    [] (xap::core::json::Traverse &root) {
+                        xap::core::json::Pointer pointer("/a/2");
+                        root.at(pointer).inner_as_int64();
+                    },
+                    "/a/2"
+                );
+            }
+
+            //  The inner itself.
+            {
+                xap::core::json::Traverse root = parser.parse(
+                    "{\"a\": {\"b\": 1}, \"c\": null}"
+                );
+                check_failure(
+                    root,
+                    [] (
+                        xap::core::json::Traverse &a,
+                        xap::core::json::Status *status
+                    ) {
+                        return a.try_inner_as_double_array(
+                            nullptr,
+                            0U,
+                            nullptr,
+                            status
+                        );
+                    },
+                    [] (xap::core::json::Traverse &root) {
+                        root.sub("a").array();
+                    },
+                    "/a"
+                );
+                xap::core::json::Traverse c = root.sub("c");
+                xap::test::assert_throw<xap::core::json::Exception>(
+                    [&c] () {
+                        c.inner_as_double_array();
+                    },
+                    "inner_as_double_array() doesn't throw (null)."
+                );
+            }
+        }
+    } catch (xap::core::json::Exception &error) {
+        printf("Throw unexpected XAP JSON error (\"%s\").\n", error.what());
+        xap::test::assert_ok(false, "Throw unexpected XAP JSON error.");
+    } catch (std::exception &error) {
+        printf(
+            "Throw unexpected std::exception error (\"%s\").\n",
+            error.what()
+        );
+        xap::test::assert_ok(false, "Throw unexpected std::exception error.");
+    }
+}
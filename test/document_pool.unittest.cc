@@ -0,0 +1,285 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+//
+//  Imports.
+//
+#include "common.h"
+
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include <xap/core/json/all.h>
+
+//
+//  Global variables.
+//
+
+//  Count of calls into the global allocator.
+static std::atomic<size_t> g_allocations(0U);
+
+//
+//  Global allocator.
+//
+
+void *operator new(size_t size) {
+    g_allocations.fetch_add(1U, std::memory_order_relaxed);
+    void *memory = malloc(size == 0U ? 1U : size);
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void operator delete(void *memory) noexcept {
+    free(memory);
+}
+
+void operator delete(void *memory, size_t) noexcept {
+    free(memory);
+}
+
+//
+//  Private functions.
+//
+
+/**
+ *  Parse and traverse a request.
+ *
+ *  @param pool
+ *      The pool.
+ *  @param id
+ *      The request ID.
+ */
+static void handle(xap::core::json::DocumentPool &pool, const int id) {
+    static const std::string REQUEST =
+        "{\"id\": 0, \"user\": {\"name\": \"a name longer than SSO\", "
+        "\"tags\": [\"a\", \"b\\n\", \"c\"]}, \"rate\": 0.5}";
+    xap::core::json::Traverse root = pool.parse(REQUEST);
+    xap::test::assert_equal<int>(
+        root.sub("id").inner_as_int() + id,
+        id,
+        "root.sub(\"id\") != 0"
+    );
+    xap::core::json::Traverse tags = root.sub("user").sub("tags");
+    xap::test::assert_equal<size_t>(
+        tags.array_get_length(),
+        3U,
+        "tags.array_get_length() != 3"
+    );
+    size_t newlines = 0U;
+    tags.array_foreach([&newlines] (xap::core::json::Traverse &tag) {
+        if (tag.string().inner_as_string_view() == "b\n") {
+            ++newlines;
+        }
+    });
+    xap::test::assert_equal<size_t>(newlines, 1U, "tags[1] != \"b\\n\"");
+}
+
+//
+//  Entry.
+//
+
+int main() {
+    try {
+        const xap::core::json::Backend backends[] = {
+            xap::core::json::Backend::jsoncpp,
+            xap::core::json::Backend::native,
+            xap::core::json::Backend::lazy
+        };
+        for (const xap::core::json::Backend backend : backends) {
+            xap::core::json::DocumentPool pool(backend, 4096U);
+
+            //  Released documents recycle their arena.
+            for (int i = 0; i < 16; ++i) {
+                handle(pool, i);
+            }
+            xap::test::assert_equal<size_t>(
+                pool.get_arena_count(),
+                1U,
+                "pool.get_arena_count() != 1"
+            );
+            xap::test::assert_equal<size_t>(
+                pool.get_idle_count(),
+                1U,
+                "pool.get_idle_count() != 1"
+            );
+
+            //  No allocation in steady state (the tapes, the strings and
+            //  the traverse objects are in the arena).
+            if (backend != xap::core::json::Backend::jsoncpp) {
+                const size_t before = g_allocations.load();
+                for (int i = 0; i < 16; ++i) {
+                    handle(pool, i);
+                }
+                xap::test::assert_equal<size_t>(
+                    g_allocations.load() - before,
+                    0U,
+                    "Allocations in steady state."
+                );
+            }
+
+            //  Documents that are still used keep their arena.
+            {
+                std::vector<xap::core::json::Traverse> documents;
+                for (int i = 0; i < 3; ++i) {
+                    documents.push_back(pool.parse(
+                        "{\"i\": " + std::to_string(i) + "}"
+                    ));
+                }
+                xap::test::assert_equal<size_t>(
+                    pool.get_arena_count(),
+                    3U,
+                    "pool.get_arena_count() != 3"
+                );
+                xap::test::assert_equal<size_t>(
+                    pool.get_idle_count(),
+                    0U,
+                    "pool.get_idle_count() != 0"
+                );
+                for (int i = 0; i < 3; ++i) {
+                    xap::test::assert_equal<int>(
+                        documents[static_cast<size_t>(i)]
+                            .sub("i").inner_as_int(),
+                        i,
+                        "documents[i].sub(\"i\") != i"
+                    );
+                }
+
+                //  A derived traverse object keeps the arena as well.
+                xap::core::json::Traverse i = documents[1].sub("i");
+                documents.clear();
+                xap::test::assert_equal<size_t>(
+                    pool.get_idle_count(),
+                    2U,
+                    "pool.get_idle_count() != 2"
+                );
+                handle(pool, 0);
+                xap::test::assert_equal<int>(
+                    i.inner_as_int(),
+                    1,
+                    "i != 1"
+                );
+            }
+            xap::test::assert_equal<size_t>(
+                pool.get_idle_count(),
+                3U,
+                "pool.get_idle_count() != 3"
+            );
+
+            //  Documents released on another thread.
+            {
+                xap::core::json::Traverse root = pool.parse("[1, 2, 3]");
+                std::thread worker([&root] () {
+                    xap::test::assert_equal<size_t>(
+                        root.array_get_length(),
+                        3U,
+                        "root.array_get_length() != 3"
+                    );
+                    xap::core::json::Traverse released = std::move(root);
+                });
+                worker.join();
+                xap::test::assert_equal<size_t>(
+                    pool.get_idle_count(),
+                    3U,
+                    "pool.get_idle_count() != 3 (released on a thread)"
+                );
+            }
+
+            //  Errors.
+            try {
+                pool.parse("{\"a\": ");
+                xap::test::assert_ok(false, "No error was thrown.");
+            } catch (xap::core::json::Exception &error) {
+                xap::test::assert_equal<uint16_t>(
+                    error.get_code(),
+                    xap::core::json::ERROR_PARAMETER,
+                    "error.get_code() != ERROR_PARAMETER"
+                );
+            }
+            xap::test::assert_equal<size_t>(
+                pool.get_idle_count(),
+                pool.get_arena_count(),
+                "An arena is lost by a failed parse."
+            );
+            pool.set_utf8_validation(true);
+            try {
+                pool.parse("[\"\xC0\xAF\"]");
+                xap::test::assert_ok(false, "No error was thrown (UTF-8).");
+            } catch (xap::core::json::Exception &) {
+                //  Expected.
+            }
+            pool.set_utf8_validation(false);
+
+            //  Large documents merge the blocks of an arena, and the blocks
+            //  beyond the retained size are released.
+            std::string large = "[";
+            for (int i = 0; i < 10000; ++i) {
+                large += (i == 0 ? "\"" : ", \"") + std::to_string(i) + "\"";
+            }
+            large += "]";
+            pool.parse(large, "/large").array_get_length();
+            const size_t reserved = pool.get_reserved_size();
+            xap::test::assert_equal<size_t>(
+                pool.parse(large).array_get_length(),
+                10000U,
+                "large.array_get_length() != 10000"
+            );
+            xap::test::assert_ok(
+                pool.get_reserved_size() <= reserved,
+                "The arena grows for a document of the same size."
+            );
+            pool.set_retained_size(4096U);
+            xap::test::assert_equal<size_t>(
+                pool.get_retained_size(),
+                4096U,
+                "pool.get_retained_size() != 4096"
+            );
+            for (size_t i = 0U; i < pool.get_arena_count(); ++i) {
+                handle(pool, 0);
+            }
+            //  (The jsoncpp backend allocates the values from the heap.)
+            xap::test::assert_ok(
+                backend == xap::core::json::Backend::jsoncpp ||
+                pool.get_reserved_size() < reserved,
+                "The blocks beyond the retained size are kept."
+            );
+        }
+
+        //  Documents outlive the pool.
+        {
+            std::unique_ptr<xap::core::json::Traverse> root;
+            {
+                xap::core::json::DocumentPool pool(
+                    xap::core::json::Backend::native
+                );
+                root.reset(new xap::core::json::Traverse(
+                    pool.parse("{\"a\": \"a string that is longer than SSO\"}")
+                ));
+            }
+            xap::test::assert_equal<std::string>(
+                root->sub("a").inner_as_string(),
+                "a string that is longer than SSO",
+                "root->sub(\"a\") != \"a string that is longer than SSO\""
+            );
+        }
+    } catch (xap::core::json::Exception &error) {
+        printf("Throw unexpected XAP JSON error (\"%s\").\n", error.what());
+        xap::test::assert_ok(false, "Throw unexpected XAP JSON error.");
+    } catch (std::exception &error) {
+        printf(
+            "Throw unexpected std::exception error (\"%s\").\n",
+            error.what()
+        );
+        xap::test::assert_ok(false, "Throw unexpected std::exception error.");
+    }
+}
@@ -0,0 +1,312 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+//
+//  Imports.
+//
+#include "common.h"
+
+#include <functional>
+#include <iostream>
+#include <stdint.h>
+#include <string>
+#include <xap/core/json/all.h>
+
+//
+//  Private functions.
+//
+
+/**
+ *  Check that extraction fails the same way as a chain of accessors.
+ *
+ *  @param backend
+ *      The backend.
+ *  @param document
+ *      The document.
+ *  @param extract
+ *      The extraction (returns whether succeeded, must fail).
+ *  @param chain
+ *      The chain of accessors (must throw).
+ *  @param code
+ *      The expected error code.
+ *  @param path
+ *      The expected path of the error.
+ */
+static void check_failure(
+    const xap::core::json::Backend backend,
+    const std::string &document,
+    const std::function<bool(
+        xap::core::json::Traverse &,
+        xap::core::json::Status *
+    )> &extract,
+    const std::function<void(xap::core::json::Traverse &)> &chain,
+    const uint16_t code,
+    const std::string &path
+) {
+    xap::core::json::Parser parser(backend);
+    xap::core::json::Traverse root = parser.parse(document);
+
+    //  The chain of accessors.
+    std::string chain_message;
+    uint16_t chain_code = 0U;
+    try {
+        chain(root);
+    } catch (xap::core::json::Exception &error) {
+        chain_message = error.what();
+        chain_code = error.get_code();
+        xap::test::assert_equal<std::string>(
+            error.get_path(),
+            path,
+            "chain path"
+        );
+    }
+    xap::test::assert_equal<uint16_t>(chain_code, code, "chain code");
+
+    //  The extraction.
+    xap::core::json::Status status;
+    xap::test::assert_ok(
+        !extract(root, &status),
+        "try_extract() succeeded."
+    );
+    xap::test::assert_equal<std::string>(
+        status.what(),
+        chain_message,
+        "status.what() != chain message"
+    );
+    xap::test::assert_equal<uint16_t>(
+        status.get_code(),
+        code,
+        "status.get_code() != code"
+    );
+    xap::test::assert_equal<std::string>(
+        status.get_path(),
+        path,
+        "status.get_path() != path"
+    );
+}
+
+//
+//  Entry.
+//
+
+int main() {
+    try {
+        const xap::core::json::Backend backends[] = {
+            xap::core::json::Backend::jsoncpp,
+            xap::core::json::Backend::native,
+            xap::core::json::Backend::lazy
+        };
+        for (const xap::core::json::Backend backend : backends) {
+            xap::core::json::Parser parser(backend);
+
+            //  All types.
+            {
+                xap::core::json::Traverse root = parser.parse(
+                    "{\"a\": -1, \"b\": 2, \"c\": -9007199254740993, "
+                    "\"d\": 18446744073709551615, \"e\": 0.5, "
+                    "\"f\": 1.25, \"g\": true, \"h\": \"text\", "
+                    "\"unknown\": {\"a\": 5}}"
+                );
+                int a = 0;
+                uint b = 0U;
+                int64_t c = 0;
+                uint64_t d = 0U;
+                float e = 0.0F;
+                double f = 0.0;
+                bool g = false;
+                std::string h;
+                root.extract({
+                    {"h", &h},
+                    {"g", &g},
+                    {"f", &f},
+                    {"e", &e},
+                    {"d", &d},
+                    {"c", &c},
+                    {"b", &b},
+                    {"a", &a}
+                });
+                xap::test::assert_equal<int>(a, -1, "a != -1");
+                xap::test::assert_equal<uint>(b, 2U, "b != 2");
+                xap::test::assert_equal<int64_t>(
+                    c,
+                    -9007199254740993LL,
+                    "c != -9007199254740993"
+                );
+                xap::test::assert_equal<uint64_t>(
+                    d,
+                    UINT64_MAX,
+                    "d != UINT64_MAX"
+                );
+                xap::test::assert_equal<float>(e, 0.5F, "e != 0.5");
+                xap::test::assert_equal<double>(f, 1.25, "f != 1.25");
+                xap::test::assert_ok(g, "!g");
+                xap::test::assert_equal<std::string>(h, "text", "h != text");
+            }
+
+            //  Optional members can be null (or non-existed) and leave the
+            //  destinations unchanged.
+            {
+                xap::core::json::Traverse root = parser.parse(
+                    "{\"a\": 1, \"b\": null}"
+                );
+                int a = 0;
+                int b = 7;
+                int c = 8;
+                xap::test::assert_ok(
+                    root.try_extract({
+                        {"a", &a},
+                        {"b", &b, false},
+                        {"c", &c, false}
+                    }),
+                    "try_extract() failed."
+                );
+                xap::test::assert_equal<int>(a, 1, "a != 1");
+                xap::test::assert_equal<int>(b, 7, "b != 7");
+                xap::test::assert_equal<int>(c, 8, "c != 8");
+            }
+
+            //  A required member is non-existed.
+            check_failure(
+                backend,
+                "{\"a\": 1}",
+                [] (
+                    xap::core::json::Traverse &root,
+                    xap::core::json::Status *status
+                ) {
+                    int a;
+                    std::string b;
+                    return root.try_extract({{"a", &a}, {"b", &b}}, status);
+                },
+                [] (xap::core::json::Traverse &root) {
+                    root.sub("a");
+                    root.sub("b");
+                },
+                xap::core::json::ERROR_NOTFIND,
+                "/b"
+            );
+
+            //  A required member is null.
+            check_failure(
+                backend,
+                "{\"a\": null}",
+                [] (
+                    xap::core::json::Traverse &root,
+                    xap::core::json::Status *status
+                ) {
+                    double a;
+                    return root.try_extract({{"a", &a}}, status);
+                },
+                [] (xap::core::json::Traverse &root) {
+                    root.sub("a").inner_as_double();
+                },
+                xap::core::json::ERROR_TYPE,
+                "/a"
+            );
+
+            //  A member has another type (or doesn't fit).
+            check_failure(
+                backend,
+                "{\"a\": \"1\"}",
+                [] (
+                    xap::core::json::Traverse &root,
+                    xap::core::json::Status *status
+                ) {
+                    bool a;
+                    return root.try_extract({{"a", &a}}, status);
+                },
+                [] (xap::core::json::Traverse &root) {
+                    root.sub("a").inner_as_boolean();
+                },
+                xap::core::json::ERROR_TYPE,
+                "/a"
+            );
+            check_failure(
+                backend,
+                "{\"a\": -1}",
+                [] (
+                    xap::core::json::Traverse &root,
+                    xap::core::json::Status *status
+                ) {
+                    uint a;
+                    return root.try_extract({{"a", &a}}, status);
+                },
+                [] (xap::core::json::Traverse &root) {
+                    root.sub("a").inner_as_uint();
+                },
+                xap::core::json::ERROR_TYPE,
+                "/a"
+            );
+            check_failure(
+                backend,
+                "{\"a\": 1.5}",
+                [] (
+                    xap::core::json::Traverse &root,
+                    xap::core::json::Status *status
+                ) {
+                    uint64_t a;
+                    return root.try_extract({{"a", &a}}, status);
+                },
+                [] (xap::core::json::Traverse &root) {
+                    root.sub("a").inner_as_uint64();
+                },
+                xap::core::json::ERROR_TYPE,
+                "/a"
+            );
+
+            //  The inner itself.
+            check_failure(
+                backend,
+                "[1]",
+                [] (
+                    xap::core::json::Traverse &root,
+                    xap::core::json::Status *status
+                ) {
+                    int a;
+                    return root.try_extract({{"a", &a}}, status);
+                },
+                [] (xap::core::json::Traverse &root) {
+                    root.sub("a");
+                },
+                xap::core::json::ERROR_TYPE,
+                "/"
+            );
+
+            //  Throwing.
+            {
+                xap::core::json::Traverse root = parser.parse(
+                    "{\"items\": {\"a\": true}}"
+                );
+                xap::core::json::Traverse items = root.sub("items");
+                xap::test::assert_throw<xap::core::json::Exception>(
+                    [&items] () {
+                        int a;
+                        items.extract({{"a", &a}});
+                    },
+                    "extract() doesn't throw."
+                );
+                try {
+                    int a;
+                    items.extract({{"a", &a}});
+                } catch (xap::core::json::Exception &error) {
+                    xap::test::assert_equal<std::string>(
+                        error.get_path(),
+                        "/items/a",
+                        "error.get_path() != /items/a"
+                    );
+                }
+            }
+        }
+    } catch (xap::core::json::Exception &error) {
+        printf("Throw unexpected XAP JSON error (\"%s\").\n", error.what());
+        xap::test::assert_ok(false, "Throw unexpected XAP JSON error.");
+    } catch (std::exception &error) {
+        printf(
+            "Throw unexpected std::exception error (\"%s\").\n",
+            error.what()
+        );
+        xap::test::assert_ok(false, "Throw unexpected std::exception error.");
+    }
+}
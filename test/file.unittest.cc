@@ -0,0 +1,152 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+//
+//  Imports.
+//
+#include "common.h"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdio.h>
+#include <string>
+#include <xap/core/json/all.h>
+
+//
+//  Private functions.
+//
+
+/**
+ *  Write a file.
+ *
+ *  @param filename
+ *      The file name.
+ *  @param content
+ *      The content.
+ */
+static void write_file(const char *filename, const std::string &content) {
+    std::ofstream stream(filename, std::ios::binary | std::ios::trunc);
+    stream << content;
+}
+
+/**
+ *  Read a file.
+ *
+ *  @param filename
+ *      The file name.
+ *  @return
+ *      The content.
+ */
+static std::string read_file(const char *filename) {
+    std::ifstream stream(filename, std::ios::binary);
+    std::stringstream content;
+    content << stream.rdbuf();
+    return content.str();
+}
+
+//
+//  Entry.
+//
+
+int main() {
+    const char *filename = "file.unittest.json";
+    const char *empty_filename = "file.unittest.empty.json";
+    const std::string content =
+        "{\"name\": \"a\\nb\", \"items\": [1, 2, 3], \"plain\": \"text\"}";
+    write_file(filename, content);
+    write_file(empty_filename, "");
+
+    const xap::core::json::Backend backends[] = {
+        xap::core::json::Backend::jsoncpp,
+        xap::core::json::Backend::native
+    };
+    for (const xap::core::json::Backend backend : backends) {
+        try {
+            xap::core::json::Parser parser(backend);
+            xap::core::json::Traverse plain_item =
+                xap::core::json::Traverse::null();
+            xap::core::json::StringView plain;
+            {
+                xap::core::json::Traverse root = parser.parse_file(filename);
+                xap::test::assert_equal<std::string>(
+                    root.sub("name").inner_as_string(),
+                    "a\nb",
+                    "name != \"a\\nb\""
+                );
+                xap::test::assert_equal<size_t>(
+                    root.sub("items").array_get_length(),
+                    3U,
+                    "items.length != 3"
+                );
+
+                plain_item = root.sub("plain");
+                plain = plain_item.inner_as_string_view();
+            }
+
+            //  Views outlive the root as long as the document is alive.
+            xap::test::assert_ok(plain == "text", "plain != \"text\"");
+
+            //  Decoding strings in place doesn't modify the file.
+            xap::test::assert_equal<std::string>(
+                read_file(filename),
+                content,
+                "The file was modified."
+            );
+
+            //  Errors.
+            try {
+                parser.parse_file("file.unittest.missing.json", "/missing");
+                xap::test::assert_ok(false, "Missing file was parsed.");
+            } catch (xap::core::json::Exception &error) {
+                xap::test::assert_equal<uint16_t>(
+                    error.get_code(),
+                    xap::core::json::ERROR_PARAMETER,
+                    "error.get_code() != ERROR_PARAMETER"
+                );
+                xap::test::assert_equal<std::string>(
+                    error.get_path(),
+                    "/missing",
+                    "error.get_path() != \"/missing\""
+                );
+            }
+            xap::test::assert_throw<xap::core::json::Exception>([&] {
+                parser.parse_file(empty_filename);
+            });
+            xap::test::assert_throw<xap::core::json::Exception>([&] {
+                parser.parse_file(".");
+            });
+        } catch (xap::core::json::Exception &error) {
+            printf(
+                "Throw unexpected XAP JSON error (\"%s\").\n",
+                error.what()
+            );
+            xap::test::assert_ok(false, "Throw unexpected XAP JSON error.");
+        } catch (std::exception &error) {
+            printf(
+                "Throw unexpected std::exception error (\"%s\").\n",
+                error.what()
+            );
+            xap::test::assert_ok(
+                false,
+                "Throw unexpected std::exception error."
+            );
+        }
+    }
+
+    //  The default parser.
+    xap::test::assert_equal<int>(
+        xap::core::json::Traverse::from_file(filename)
+            .sub("items")
+            .at(xap::core::json::Pointer("/2"))
+            .inner_as_int(),
+        3,
+        "items[2] != 3"
+    );
+
+    remove(filename);
+    remove(empty_filename);
+}
@@ -0,0 +1,283 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+//
+//  Imports.
+//
+#include "common.h"
+
+#include <iostream>
+#include <memory>
+#include <stdint.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include <xap/core/json/all.h>
+
+//
+//  Private functions.
+//
+
+/**
+ *  Check the members of a document.
+ *
+ *  @param root
+ *      The root.
+ */
+static void check_members(xap::core::json::Traverse &root) {
+    static const std::string LONG_KEY(300U, 'k');
+    xap::test::assert_equal<int>(
+        root.sub("timestamp").inner_as_int(),
+        1,
+        "root.sub(\"timestamp\") != 1"
+    );
+    xap::test::assert_equal<int>(
+        root.sub("device").sub("id").inner_as_int(),
+        2,
+        "root.sub(\"device\").sub(\"id\") != 2"
+    );
+
+    //  Escaped keys, keys that contain NUL and long keys.
+    xap::test::assert_equal<int>(
+        root.sub("ab").inner_as_int(),
+        3,
+        "root.sub(\"ab\") != 3"
+    );
+    xap::test::assert_equal<int>(
+        root.sub(std::string("n\0l", 3U)).inner_as_int(),
+        4,
+        "root.sub(\"n\\0l\") != 4"
+    );
+    xap::test::assert_equal<int>(
+        root.sub(LONG_KEY).inner_as_int(),
+        5,
+        "root.sub(LONG_KEY) != 5"
+    );
+
+    //  The last one of duplicate keys wins.
+    xap::test::assert_equal<int>(
+        root.sub("dup").inner_as_int(),
+        7,
+        "root.sub(\"dup\") != 7"
+    );
+
+    //  Missing keys.
+    xap::test::assert_ok(
+        root.optional_sub("device_id").is_null(),
+        "root.optional_sub(\"device_id\") is not null"
+    );
+    xap::test::assert_ok(
+        root.sub("device").optional_sub("timestamp").is_null(),
+        "root.sub(\"device\").optional_sub(\"timestamp\") is not null"
+    );
+
+    //  Pointers (with pre-hashed keys).
+    static const xap::core::json::Pointer DEVICE_ID("/device/id");
+    xap::test::assert_equal<int>(
+        root.at(DEVICE_ID).inner_as_int(),
+        2,
+        "root.at(\"/device/id\") != 2"
+    );
+}
+
+//
+//  Entry.
+//
+
+int main() {
+    try {
+        const std::string document =
+            "{\"timestamp\": 1, \"device\": {\"id\": 2}, \"a\\u0062\": 3, "
+            "\"n\\u0000l\": 4, \"" + std::string(300U, 'k') + "\": 5, "
+            "\"dup\": 6, \"dup\": 7}";
+        const xap::core::json::Backend backends[] = {
+            xap::core::json::Backend::jsoncpp,
+            xap::core::json::Backend::native,
+            xap::core::json::Backend::lazy
+        };
+        for (const xap::core::json::Backend backend : backends) {
+            //  A private table.
+            xap::core::json::Parser parser(backend);
+            std::unique_ptr<xap::core::json::Traverse> root;
+            {
+                xap::core::json::KeyTable keys;
+                parser.set_key_table(&keys);
+                root.reset(new xap::core::json::Traverse(
+                    parser.parse(document)
+                ));
+                check_members(*root);
+
+                //  The keys (excluding the long one) are interned by the
+                //  native documents.
+                xap::test::assert_equal<size_t>(
+                    keys.get_count(),
+                    backend == xap::core::json::Backend::jsoncpp ? 0U : 6U,
+                    "keys.get_count() != 6"
+                );
+                xap::test::assert_ok(
+                    !keys.is_global(),
+                    "keys.is_global() is true"
+                );
+
+                //  Documents share the table.
+                xap::core::json::Traverse other = parser.parse(document);
+                check_members(other);
+                xap::test::assert_equal<size_t>(
+                    keys.get_count(),
+                    backend == xap::core::json::Backend::jsoncpp ? 0U : 6U,
+                    "keys.get_count() != 6 (after another document)"
+                );
+            }
+
+            //  The document outlives the table object.
+            check_members(*root);
+            parser.set_key_table(nullptr);
+
+            //  Modifiers (copy-on-write).
+            xap::core::json::Traverse copy = *root;
+            copy.object_set("added", xap::core::json::Traverse("8"));
+            check_members(copy);
+            xap::test::assert_equal<int>(
+                copy.sub("added").inner_as_int(),
+                8,
+                "copy.sub(\"added\") != 8"
+            );
+            check_members(*root);
+
+            //  A full table.
+            xap::core::json::KeyTable small(2U);
+            xap::test::assert_equal<size_t>(
+                small.get_capacity(),
+                2U,
+                "small.get_capacity() != 2"
+            );
+            parser.set_key_table(&small);
+            xap::core::json::Traverse partial = parser.parse(document);
+            check_members(partial);
+            xap::test::assert_equal<size_t>(
+                small.get_count(),
+                backend == xap::core::json::Backend::jsoncpp ? 0U : 2U,
+                "small.get_count() != 2"
+            );
+            parser.set_key_table(nullptr);
+        }
+
+        //  The global table (the modified values refer to the keys).
+        {
+            xap::core::json::KeyTable global =
+                xap::core::json::KeyTable::get_global();
+            xap::test::assert_ok(global.is_global(), "global is not global");
+            for (const xap::core::json::Backend backend : backends) {
+                xap::core::json::Parser parser(backend);
+                parser.set_key_table(&global);
+                xap::core::json::Traverse root = parser.parse(document);
+                xap::core::json::Traverse copy = root;
+                copy.object_set("global", xap::core::json::Traverse("9"));
+                copy.object_set(
+                    std::string("g\0l", 3U),
+                    xap::core::json::Traverse("10")
+                );
+                check_members(copy);
+                xap::test::assert_equal<int>(
+                    copy.sub("global").inner_as_int(),
+                    9,
+                    "copy.sub(\"global\") != 9"
+                );
+                xap::test::assert_equal<int>(
+                    copy.sub(std::string("g\0l", 3U)).inner_as_int(),
+                    10,
+                    "copy.sub(\"g\\0l\") != 10"
+                );
+                xap::core::json::Traverse device = root.sub("device");
+                device.object_set("id", xap::core::json::Traverse("11"));
+                xap::test::assert_equal<int>(
+                    device.sub("id").inner_as_int(),
+                    11,
+                    "device.sub(\"id\") != 11"
+                );
+                check_members(root);
+            }
+            xap::test::assert_ok(
+                xap::core::json::KeyTable::get_global().get_count() >= 7U,
+                "The global table is not shared."
+            );
+        }
+
+        //  Threads share a table.
+        {
+            xap::core::json::KeyTable keys;
+            std::vector<std::thread> threads;
+            for (int t = 0; t < 4; ++t) {
+                threads.emplace_back([&keys, t] () {
+                    xap::core::json::Parser parser(
+                        xap::core::json::Backend::native
+                    );
+                    parser.set_key_table(&keys);
+                    for (int i = 0; i < 200; ++i) {
+                        const std::string key =
+                            "k" + std::to_string((i * 7 + t) % 300);
+                        xap::core::json::Traverse root = parser.parse(
+                            "{\"shared\": " + std::to_string(i) + ", \"" +
+                            key + "\": " + std::to_string(t) + "}"
+                        );
+                        xap::test::assert_equal<int>(
+                            root.sub("shared").inner_as_int(),
+                            i,
+                            "root.sub(\"shared\") != i"
+                        );
+                        xap::test::assert_equal<int>(
+                            root.sub(key).inner_as_int(),
+                            t,
+                            "root.sub(key) != t"
+                        );
+                    }
+                });
+            }
+            for (std::thread &thread : threads) {
+                thread.join();
+            }
+            xap::test::assert_equal<size_t>(
+                keys.get_count(),
+                301U,
+                "keys.get_count() != 301"
+            );
+
+            //  JSON Lines (records parsed by workers).
+            xap::core::json::LinesReader reader(
+                xap::core::json::Backend::native
+            );
+            reader.set_key_table(&keys);
+            std::string lines;
+            for (int i = 0; i < 1000; ++i) {
+                lines += "{\"shared\": " + std::to_string(i) +
+                         ", \"line\": true}\n";
+            }
+            int sum = 0;
+            reader.read(
+                lines,
+                [&sum] (const size_t, xap::core::json::Traverse &record) {
+                    sum += record.sub("shared").inner_as_int();
+                    record.sub("line").inner_as_boolean();
+                }
+            );
+            xap::test::assert_equal<int>(sum, 499500, "sum != 499500");
+            xap::test::assert_equal<size_t>(
+                keys.get_count(),
+                302U,
+                "keys.get_count() != 302"
+            );
+        }
+    } catch (xap::core::json::Exception &error) {
+        printf("Throw unexpected XAP JSON error (\"%s\").\n", error.what());
+        xap::test::assert_ok(false, "Throw unexpected XAP JSON error.");
+    } catch (std::exception &error) {
+        printf(
+            "Throw unexpected std::exception error (\"%s\").\n",
+            error.what()
+        );
+        xap::test::assert_ok(false, "Throw unexpected std::exception error.");
+    }
+}
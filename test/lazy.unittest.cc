@@ -0,0 +1,255 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+//
+//  Imports.
+//
+#include "common.h"
+
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <xap/core/json/all.h>
+
+//
+//  Global variables.
+//
+
+//  True if calls into the global allocator fail.
+static bool g_out_of_memory = false;
+
+//
+//  Global allocator.
+//
+
+void *operator new(size_t size) {
+    void *memory = g_out_of_memory ? nullptr : malloc(size == 0U ? 1U : size);
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void operator delete(void *memory) noexcept {
+    free(memory);
+}
+
+void operator delete(void *memory, size_t) noexcept {
+    free(memory);
+}
+
+//
+//  Entry.
+//
+
+int main() {
+    //  A wide document (most fields are never visited).
+    const size_t field_count = 500U;
+    std::string data = "{";
+    for (size_t i = 0U; i < field_count; ++i) {
+        data += "\"field" + std::to_string(i) + "\": {\"id\": " +
+                std::to_string(i) + ", \"name\": \"a\\\\n\\u00e9 " +
+                std::to_string(i) + "\", \"tags\": [1, [2, {\"x\": -1.5}]" +
+                ", \"\\\"]\"], \"empty\": {}}, ";
+    }
+    data += "\"last\": [true, false, null, \"}\"]}";
+
+    try {
+        xap::core::json::Parser parser(xap::core::json::Backend::lazy);
+        xap::test::assert_ok(
+            parser.get_backend() == xap::core::json::Backend::lazy,
+            "parser.get_backend() != lazy"
+        );
+
+        //  Visit a few fields (in any order, and more than once).
+        xap::core::json::Traverse root = parser.parse(data);
+        for (int round = 0; round < 2; ++round) {
+            xap::test::assert_equal<int>(
+                root.sub("field321").sub("id").inner_as_int(),
+                321,
+                "field321.id != 321"
+            );
+            xap::test::assert_equal<std::string>(
+                root.sub("field7").sub("name").inner_as_string(),
+                "a\\n\xC3\xA9 7",
+                "field7.name is not decoded."
+            );
+            xap::test::assert_equal<double>(
+                root.at(xap::core::json::Pointer(
+                    "/field499/tags/1/1/x"
+                )).inner_as_double(),
+                -1.5,
+                "field499.tags[1][1].x != -1.5"
+            );
+            xap::test::assert_equal<std::string>(
+                root.at(xap::core::json::Pointer(
+                    "/field7/tags/2"
+                )).inner_as_string(),
+                "\"]",
+                "field7.tags[2] != \"\\\"]\""
+            );
+            xap::test::assert_equal<std::string>(
+                root.sub("last").array_pop_item().inner_as_string(),
+                "}",
+                "last[3] != \"}\""
+            );
+        }
+        xap::test::assert_throw<xap::core::json::Exception>([&] {
+            root.sub("field500");
+        });
+        size_t index = 0U;
+        root.sub("field42").sub("tags").array_foreach(
+            [&] (xap::core::json::Traverse &item) {
+                if (index == 1U) {
+                    xap::test::assert_equal<size_t>(
+                        item.array_get_length(),
+                        2U,
+                        "field42.tags[1].length != 2"
+                    );
+                }
+                ++index;
+            }
+        );
+        xap::test::assert_equal<size_t>(index, 3U, "field42.tags.length");
+        xap::test::assert_ok(
+            root.sub("field42").sub("empty").type() ==
+                xap::core::json::Type::object,
+            "field42.empty is not an object."
+        );
+
+        //  Modifications copy a partially decoded object out of the tape.
+        xap::core::json::Traverse field = root.sub("field9");
+        xap::test::assert_equal<double>(
+            field.at(xap::core::json::Pointer(
+                "/tags/1/1/x"
+            )).inner_as_double(),
+            -1.5,
+            "field9.tags[1][1].x != -1.5"
+        );
+        field.object_set("copy", root.sub("field10"));
+        xap::test::assert_equal<std::string>(
+            field.sub("copy").sub("name").inner_as_string(),
+            "a\\n\xC3\xA9 10",
+            "field9.copy.name mismatched."
+        );
+        xap::test::assert_equal<std::string>(
+            field.sub("name").inner_as_string(),
+            "a\\n\xC3\xA9 9",
+            "field9.name mismatched."
+        );
+
+        //  Errors within subtrees that are never visited are still raised.
+        std::string invalid = data;
+        invalid.replace(invalid.find("[2, {", data.size() / 2U), 1U, "{");
+        xap::test::assert_throw<xap::core::json::Exception>([&] {
+            parser.parse(invalid);
+        });
+        invalid = data;
+        invalid.replace(invalid.find("\\u00e9", data.size() / 2U), 2U, "\\x");
+        xap::test::assert_throw<xap::core::json::Exception>([&] {
+            parser.parse(invalid);
+        });
+        xap::test::assert_throw<xap::core::json::Exception>([&] {
+            parser.parse(data.substr(0U, data.size() - 1U));
+        });
+
+        //  Containers truncated right after they open.
+        const char *truncated[] = {"[]", "{\"a\": {}"};
+        for (const char *document : truncated) {
+            xap::test::assert_throw<xap::core::json::Exception>([&] {
+                parser.parse(document, strlen(document) - 1U);
+            });
+        }
+
+        //  Running out of memory while a container is decoded raises
+        //  std::bad_alloc (like the other backends do).
+        {
+            std::string items = "[0";
+            for (int i = 1; i < 100; ++i) {
+                items += ", " + std::to_string(i);
+            }
+            items += "]";
+            xap::core::json::Traverse array = parser.parse(items);
+            bool thrown = false;
+            g_out_of_memory = true;
+            try {
+                array.array_get_length();
+            } catch (std::bad_alloc &) {
+                thrown = true;
+            }
+            g_out_of_memory = false;
+            xap::test::assert_ok(thrown, "std::bad_alloc is not raised.");
+            xap::test::assert_equal<size_t>(
+                array.array_get_length(),
+                100U,
+                "array.length != 100"
+            );
+        }
+
+        //  Scalar roots.
+        xap::test::assert_equal<std::string>(
+            parser.parse(std::string(" \"a\\tb\" ")).inner_as_string(),
+            "a\tb",
+            "root != \"a\\tb\""
+        );
+        xap::test::assert_equal<int>(
+            parser.parse(std::string("-12")).inner_as_int(),
+            -12,
+            "root != -12"
+        );
+
+        //  Streams, files and arenas.
+        xap::core::json::StreamParser stream(xap::core::json::Backend::lazy);
+        for (size_t position = 0U; position < data.size(); position += 4096U) {
+            stream.feed(
+                data.data() + position,
+                std::min<size_t>(4096U, data.size() - position)
+            );
+        }
+        xap::test::assert_equal<int>(
+            stream.finish().sub("field100").sub("id").inner_as_int(),
+            100,
+            "stream: field100.id != 100"
+        );
+
+        const char *filename = "lazy.unittest.json";
+        {
+            std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+            file << data;
+        }
+        xap::test::assert_equal<std::string>(
+            parser.parse_file(filename).sub("field3").sub(
+                "name"
+            ).inner_as_string(),
+            "a\\n\xC3\xA9 3",
+            "file: field3.name mismatched."
+        );
+        remove(filename);
+
+        xap::core::json::Arena arena;
+        parser.set_arena(&arena);
+        xap::test::assert_equal<size_t>(
+            parser.parse(data).sub("last").array_get_length(),
+            4U,
+            "arena: last.length != 4"
+        );
+        parser.set_arena(nullptr);
+    } catch (xap::core::json::Exception &error) {
+        printf("Throw unexpected XAP JSON error (\"%s\").\n", error.what());
+        xap::test::assert_ok(false, "Throw unexpected XAP JSON error.");
+    } catch (std::exception &error) {
+        printf(
+            "Throw unexpected std::exception error (\"%s\").\n",
+            error.what()
+        );
+        xap::test::assert_ok(false, "Throw unexpected std::exception error.");
+    }
+}
@@ -0,0 +1,205 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+//
+//  Imports.
+//
+#include "common.h"
+
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <stdio.h>
+#include <string>
+#include <xap/core/json/all.h>
+
+//
+//  Entry.
+//
+
+int main() {
+    //  Records (with blank lines and CRLF line breaks here and there), longer
+    //  than a few batches.
+    const size_t record_count = 1000U;
+    std::string data;
+    for (size_t i = 0U; i < record_count; ++i) {
+        data += "{\"id\": " + std::to_string(i) +
+                ", \"name\": \"record \\\"" + std::to_string(i) +
+                "\\\"\", \"tags\": [1, 2, 3], \"padding\": \"" +
+                std::string(128U, '-') + "\"}";
+        if (i % 100U == 7U) {
+            data += "\r\n  \n";
+        } else {
+            data += "\n";
+        }
+    }
+
+    const char *filename = "lines.unittest.jsonl";
+    {
+        std::ofstream stream(filename, std::ios::binary | std::ios::trunc);
+        stream << data;
+    }
+
+    const xap::core::json::Backend backends[] = {
+        xap::core::json::Backend::jsoncpp,
+        xap::core::json::Backend::native
+    };
+    const size_t workers[] = {1U, 4U};
+    for (const xap::core::json::Backend backend : backends) {
+        for (const size_t worker_count : workers) {
+            try {
+                xap::core::json::LinesReader reader(backend, worker_count);
+                xap::test::assert_equal<size_t>(
+                    reader.get_workers(),
+                    worker_count,
+                    "reader.get_workers() != worker_count"
+                );
+
+                //  Records are handed in order (with indexes of lines).
+                size_t expected_id = 0U;
+                size_t expected_line = 0U;
+                const size_t count = reader.read(
+                    data,
+                    [&] (const size_t line, xap::core::json::Traverse &record) {
+                        xap::test::assert_equal<size_t>(
+                            line,
+                            expected_line,
+                            "line != expected"
+                        );
+                        xap::test::assert_equal<uint64_t>(
+                            record.sub("id").inner_as_uint64(),
+                            expected_id,
+                            "id != expected"
+                        );
+                        xap::test::assert_equal<std::string>(
+                            record.sub("name").inner_as_string(),
+                            "record \"" + std::to_string(expected_id) + "\"",
+                            "name != expected"
+                        );
+                        expected_line += expected_id % 100U == 7U ? 2U : 1U;
+                        ++expected_id;
+                    }
+                );
+                xap::test::assert_equal<size_t>(
+                    count,
+                    record_count,
+                    "count != record_count"
+                );
+                xap::test::assert_equal<size_t>(
+                    expected_id,
+                    record_count,
+                    "Some records were not handed."
+                );
+
+                //  Files.
+                size_t total = 0U;
+                xap::test::assert_equal<size_t>(
+                    reader.read_file(
+                        filename,
+                        [&] (const size_t, xap::core::json::Traverse &record) {
+                            total += record.sub("tags").array_get_length();
+                        }
+                    ),
+                    record_count,
+                    "read_file() != record_count"
+                );
+                xap::test::assert_equal<size_t>(
+                    total,
+                    record_count * 3U,
+                    "total != record_count * 3"
+                );
+
+                //  Records before an invalid one are handed first.
+                std::string invalid = data;
+                const size_t position = invalid.find("{\"id\": 800,");
+                invalid[position] = '[';
+                size_t handled = 0U;
+                try {
+                    reader.read(
+                        invalid,
+                        [&] (const size_t, xap::core::json::Traverse &) {
+                            ++handled;
+                        },
+                        "/log"
+                    );
+                    xap::test::assert_ok(false, "Invalid record was parsed.");
+                } catch (xap::core::json::Exception &error) {
+                    xap::test::assert_equal<uint16_t>(
+                        error.get_code(),
+                        xap::core::json::ERROR_PARAMETER,
+                        "error.get_code() != ERROR_PARAMETER"
+                    );
+                    xap::test::assert_equal<std::string>(
+                        error.get_path(),
+                        "/log/808",
+                        "error.get_path() != \"/log/808\""
+                    );
+                }
+                xap::test::assert_equal<size_t>(
+                    handled,
+                    800U,
+                    "handled != 800"
+                );
+
+                //  Exceptions of the handler are propagated.
+                xap::test::assert_throw<std::runtime_error>([&] {
+                    reader.read(
+                        data,
+                        [&] (const size_t line, xap::core::json::Traverse &) {
+                            if (line == 300U) {
+                                throw std::runtime_error("Stop.");
+                            }
+                        }
+                    );
+                });
+
+                //  Trivial inputs.
+                xap::test::assert_equal<size_t>(
+                    reader.read(
+                        "",
+                        0U,
+                        [&] (const size_t, xap::core::json::Traverse &) {}
+                    ),
+                    0U,
+                    "read(\"\") != 0"
+                );
+                xap::test::assert_equal<size_t>(
+                    reader.read(
+                        std::string("1\n\n[2]"),
+                        [&] (const size_t line, xap::core::json::Traverse &) {
+                            xap::test::assert_ok(
+                                line == 0U || line == 2U,
+                                "line != 0 or 2"
+                            );
+                        }
+                    ),
+                    2U,
+                    "read(\"1\\n\\n[2]\") != 2"
+                );
+            } catch (xap::core::json::Exception &error) {
+                printf(
+                    "Throw unexpected XAP JSON error (\"%s\").\n",
+                    error.what()
+                );
+                xap::test::assert_ok(
+                    false,
+                    "Throw unexpected XAP JSON error."
+                );
+            } catch (std::exception &error) {
+                printf(
+                    "Throw unexpected std::exception error (\"%s\").\n",
+                    error.what()
+                );
+                xap::test::assert_ok(
+                    false,
+                    "Throw unexpected std::exception error."
+                );
+            }
+        }
+    }
+
+    remove(filename);
+}
@@ -0,0 +1,187 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+//
+//  Imports.
+//
+#include "common.h"
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <xap/core/json/all.h>
+
+//
+//  Constants.
+//
+
+//  Count of members of the wide object.
+static const int WIDE_COUNT = 1000;
+
+//
+//  Private functions.
+//
+
+/**
+ *  Make a wide object (member "k<i>" is <i>, and member "dup" is duplicated).
+ *
+ *  @return
+ *      The object.
+ */
+static std::string make_wide_object() {
+    std::string document = "{\"dup\": -1";
+    for (int i = 0; i < WIDE_COUNT; ++i) {
+        document += ", \"k" + std::to_string(i) + "\": " + std::to_string(i);
+    }
+    document += ", \"n\\u0000l\": -3, \"dup\": -2, \"nested\": {";
+    for (int i = 0; i < WIDE_COUNT; ++i) {
+        if (i != 0) {
+            document += ", ";
+        }
+        document += "\"n" + std::to_string(i) + "\": " + std::to_string(i);
+    }
+    document += "}}";
+    return document;
+}
+
+/**
+ *  Check the members of a wide object.
+ *
+ *  @param root
+ *      The root.
+ */
+static void check_members(xap::core::json::Traverse &root) {
+    for (int i = 0; i < WIDE_COUNT; i += 7) {
+        xap::test::assert_equal<int>(
+            root.sub("k" + std::to_string(i)).inner_as_int(),
+            i,
+            "root.sub(\"k<i>\") != i"
+        );
+        xap::test::assert_equal<int>(
+            root.sub("nested").sub("n" + std::to_string(i)).inner_as_int(),
+            i,
+            "root.sub(\"nested\").sub(\"n<i>\") != i"
+        );
+    }
+
+    //  The last one of duplicate keys wins.
+    xap::test::assert_equal<int>(
+        root.sub("dup").inner_as_int(),
+        -2,
+        "root.sub(\"dup\") != -2"
+    );
+
+    //  Keys that contain NUL.
+    xap::test::assert_equal<int>(
+        root.sub(std::string("n\0l", 3U)).inner_as_int(),
+        -3,
+        "root.sub(\"n\\0l\") != -3"
+    );
+    xap::test::assert_ok(
+        root.optional_sub("n").is_null(),
+        "root.optional_sub(\"n\") is not null"
+    );
+
+    //  Missing keys (including prefixes and keys of the nested object).
+    xap::test::assert_ok(
+        root.optional_sub("k" + std::to_string(WIDE_COUNT)).is_null(),
+        "root.optional_sub(\"k<WIDE_COUNT>\") is not null"
+    );
+    xap::test::assert_ok(
+        root.optional_sub("k").is_null(),
+        "root.optional_sub(\"k\") is not null"
+    );
+    xap::test::assert_ok(
+        root.optional_sub("n1").is_null(),
+        "root.optional_sub(\"n1\") is not null"
+    );
+    xap::test::assert_ok(
+        root.optional_sub("").is_null(),
+        "root.optional_sub(\"\") is not null"
+    );
+
+    //  Pointers (with pre-hashed keys).
+    static const xap::core::json::Pointer NESTED("/nested/n999");
+    xap::test::assert_equal<int>(
+        root.at(NESTED).inner_as_int(),
+        999,
+        "root.at(\"/nested/n999\") != 999"
+    );
+}
+
+//
+//  Entry.
+//
+
+int main() {
+    try {
+        const std::string document = make_wide_object();
+        const xap::core::json::Backend backends[] = {
+            xap::core::json::Backend::jsoncpp,
+            xap::core::json::Backend::native,
+            xap::core::json::Backend::lazy
+        };
+        for (const xap::core::json::Backend backend : backends) {
+            xap::core::json::Parser parser(backend);
+            xap::core::json::Traverse root = parser.parse(document);
+            check_members(root);
+
+            //  With a key table.
+            {
+                xap::core::json::KeyTable keys;
+                parser.set_key_table(&keys);
+                xap::core::json::Traverse interned = parser.parse(document);
+                check_members(interned);
+                parser.set_key_table(nullptr);
+            }
+
+            //  Modifiers (the indexes of the modified document are rebuilt).
+            root.object_set("added", xap::core::json::Traverse("1001"));
+            root.object_set("dup", xap::core::json::Traverse("-4"));
+            xap::test::assert_equal<int>(
+                root.sub("added").inner_as_int(),
+                1001,
+                "root.sub(\"added\") != 1001"
+            );
+            xap::test::assert_equal<int>(
+                root.sub("dup").inner_as_int(),
+                -4,
+                "root.sub(\"dup\") != -4"
+            );
+            xap::test::assert_equal<int>(
+                root.sub("k500").inner_as_int(),
+                500,
+                "root.sub(\"k500\") != 500"
+            );
+
+            //  Threads share a document (lazy documents are not shared).
+            if (backend == xap::core::json::Backend::lazy) {
+                continue;
+            }
+            xap::core::json::Traverse shared = parser.parse(document);
+            std::vector<std::thread> threads;
+            for (int t = 0; t < 4; ++t) {
+                threads.emplace_back([shared] () mutable {
+                    check_members(shared);
+                });
+            }
+            for (std::thread &thread : threads) {
+                thread.join();
+            }
+        }
+    } catch (xap::core::json::Exception &error) {
+        printf("Throw unexpected XAP JSON error (\"%s\").\n", error.what());
+        xap::test::assert_ok(false, "Throw unexpected XAP JSON error.");
+    } catch (std::exception &error) {
+        printf(
+            "Throw unexpected std::exception error (\"%s\").\n",
+            error.what()
+        );
+        xap::test::assert_ok(false, "Throw unexpected std::exception error.");
+    }
+}
@@ -0,0 +1,284 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+//
+//  Imports.
+//
+#include "common.h"
+
+#include <iostream>
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <xap/core/json/all.h>
+
+//
+//  Entry.
+//
+
+int main(int argc, char *argv[]) {
+    //  Run with the given backend ("native" by default, or "lazy" which
+    //  must behave the same).
+    xap::core::json::Backend backend = xap::core::json::Backend::native;
+    if (argc > 1 && std::string(argv[1]) == "lazy") {
+        backend = xap::core::json::Backend::lazy;
+    }
+
+    try {
+        xap::core::json::Parser parser(backend);
+        xap::test::assert_ok(
+            parser.get_backend() == backend,
+            "parser.get_backend() != backend"
+        );
+
+        //  Strings (with and without escape sequences).
+        xap::core::json::Traverse root = parser.parse(std::string(
+            "\xEF\xBB\xBF"
+            "{"
+            "\"plain\": \"abc\", "
+            "\"escaped\": \"a\\\"b\\\\c\\/d\\n\\t\", "
+            "\"unicode\": \"\\u00e9\\u4e2d\\ud83d\\ude00\", "
+            "\"nul\": \"a\\u0000b\", "
+            "\"esc\\u0061ped_key\": 1, "
+            "\"dup\": 1, \"dup\": 2, "
+            "\"empty_object\": {}, "
+            "\"empty_array\": [], "
+            "\"nested\": [[1, [2]], {\"a\": [null, true, false]}]"
+            "}  \n"
+        ));
+        xap::test::assert_equal<std::string>(
+            root.sub("plain").inner_as_string(),
+            "abc",
+            "plain != \"abc\""
+        );
+        xap::test::assert_equal<std::string>(
+            root.sub("escaped").inner_as_string(),
+            "a\"b\\c/d\n\t",
+            "escaped != \"a\\\"b\\\\c/d\\n\\t\""
+        );
+        xap::test::assert_equal<std::string>(
+            root.sub("unicode").inner_as_string(),
+            "\xC3\xA9\xE4\xB8\xAD\xF0\x9F\x98\x80",
+            "unicode is not decoded."
+        );
+        xap::test::assert_equal<std::string>(
+            root.sub("nul").inner_as_string(),
+            std::string("a\0b", 3U),
+            "nul != \"a\\0b\""
+        );
+        xap::test::assert_equal<int>(
+            root.sub("escaped_key").inner_as_int(),
+            1,
+            "escaped_key != 1"
+        );
+        xap::test::assert_equal<int>(
+            root.sub("dup").inner_as_int(),
+            2,
+            "dup != 2 (the last one should win)"
+        );
+        xap::test::assert_equal<size_t>(
+            root.sub("empty_array").array_get_length(),
+            0U,
+            "empty_array is not empty."
+        );
+        xap::test::assert_ok(
+            root.sub("empty_object").type() == xap::core::json::Type::object,
+            "empty_object is not an object."
+        );
+        xap::core::json::Traverse nested = root.sub("nested");
+        xap::test::assert_equal<size_t>(
+            nested.array_get_length(),
+            2U,
+            "nested.length != 2"
+        );
+        size_t index = 0U;
+        nested.array_foreach([&](xap::core::json::Traverse &item) {
+            if (index == 0U) {
+                xap::test::assert_equal<int>(
+                    item.array_pop_item().array_pop_item().inner_as_int(),
+                    2,
+                    "nested[0][1][0] != 2"
+                );
+            } else {
+                xap::core::json::Traverse a = item.sub("a");
+                xap::test::assert_ok(
+                    a.array_pop_item().inner_as_boolean() == false,
+                    "nested[1].a[2] != false"
+                );
+                xap::test::assert_ok(
+                    a.array_pop_item().inner_as_boolean() == true,
+                    "nested[1].a[1] != true"
+                );
+                xap::test::assert_ok(
+                    a.array_pop_item().is_null(),
+                    "nested[1].a[0] != null"
+                );
+                xap::test::assert_equal<std::string>(
+                    a.get_path(),
+                    "/nested/1/a",
+                    "a.get_path() != \"/nested/1/a\""
+                );
+            }
+            ++index;
+        });
+
+        //  Numbers.
+        xap::core::json::Traverse numbers = parser.parse(
+            "[0, -0, 2147483647, -2147483648, 4294967295, "
+            "9223372036854775807, -9223372036854775808, "
+            "18446744073709551615, 18446744073709551616, "
+            "1.5, -2.5e3, 1E2, 0.1]"
+        );
+        xap::test::assert_equal<double>(
+            numbers.array_pop_item().inner_as_double(),
+            0.1,
+            "0.1"
+        );
+        xap::test::assert_equal<int>(
+            numbers.array_pop_item().inner_as_int(),
+            100,
+            "1E2 != 100"
+        );
+        xap::test::assert_equal<double>(
+            numbers.array_pop_item().inner_as_double(),
+            -2500.0,
+            "-2.5e3"
+        );
+        xap::test::assert_throw<xap::core::json::Exception>([&] {
+            numbers.array_pop_item().integer();
+        });
+        xap::test::assert_equal<double>(
+            numbers.array_pop_item().inner_as_double(),
+            18446744073709551616.0,
+            "18446744073709551616"
+        );
+        xap::test::assert_equal<uint64_t>(
+            numbers.array_pop_item().inner_as_uint64(),
+            UINT64_C(18446744073709551615),
+            "UINT64_MAX"
+        );
+        xap::test::assert_equal<int64_t>(
+            numbers.array_pop_item().inner_as_int64(),
+            INT64_MIN,
+            "INT64_MIN"
+        );
+        xap::test::assert_equal<int64_t>(
+            numbers.array_pop_item().inner_as_int64(),
+            INT64_MAX,
+            "INT64_MAX"
+        );
+        xap::test::assert_throw<xap::core::json::Exception>([&] {
+            numbers.array_pop_item().integer();
+        });
+        xap::test::assert_equal<int>(
+            numbers.array_pop_item().inner_as_int(),
+            -2147483647 - 1,
+            "INT_MIN"
+        );
+        xap::test::assert_equal<int>(
+            numbers.array_pop_item().inner_as_int(),
+            2147483647,
+            "INT_MAX"
+        );
+        xap::test::assert_equal<int>(
+            numbers.array_pop_item().inner_as_int(),
+            0,
+            "-0 != 0"
+        );
+        xap::test::assert_equal<uint>(
+            numbers.array_pop_item().inner_as_uint(),
+            0U,
+            "0 != 0"
+        );
+
+        //  Modifications copy the object out of the tape.
+        xap::core::json::Traverse object = parser.parse(
+            "{\"a\": {\"b\": [1, 2]}}"
+        );
+        xap::core::json::Traverse a = object.sub("a");
+        a.object_set("c", object.sub("a").sub("b"));
+        xap::test::assert_equal<size_t>(
+            a.sub("c").array_get_length(),
+            2U,
+            "a.c.length != 2"
+        );
+        xap::test::assert_throw<xap::core::json::Exception>([&] {
+            object.sub("a").sub("c");
+        });
+
+        //  Strict syntax.
+        const char *invalid[] = {
+            "",
+            "{",
+            "[1, 2,]",
+            "{\"a\": 1,}",
+            "{\"a\" 1}",
+            "{a: 1}",
+            "[1] [2]",
+            "// comment\n[1]",
+            "\"a\nb\"",
+            "\"\\x\"",
+            "\"\\ud83d\"",
+            "\"\\ude00\"",
+            "01",
+            "-",
+            "1.",
+            "1e",
+            "1e400",
+            "tru",
+            "nul",
+            "'a'"
+        };
+        for (const char *data : invalid) {
+            try {
+                parser.parse(std::string(data), "/invalid");
+                printf("Parsed invalid JSON (\"%s\").\n", data);
+                xap::test::assert_ok(false, "Invalid JSON was parsed.");
+            } catch (xap::core::json::Exception &error) {
+                xap::test::assert_equal<uint16_t>(
+                    error.get_code(),
+                    xap::core::json::ERROR_PARAMETER,
+                    "error.get_code() != ERROR_PARAMETER"
+                );
+                xap::test::assert_equal<std::string>(
+                    error.get_path(),
+                    "/invalid",
+                    "error.get_path() != \"/invalid\""
+                );
+            }
+        }
+
+        //  Containers truncated right after they open (the input is copied
+        //  with its exact size, and the closing byte that follows must not
+        //  be read).
+        const char *truncated[] = {"[]", "[ ]", "{}", "{\"a\":[]}"};
+        for (const char *data : truncated) {
+            xap::test::assert_throw<xap::core::json::Exception>([&] {
+                parser.parse(data, strlen(data) - 1U);
+            });
+        }
+
+        //  Nesting depth.
+        xap::test::assert_throw<xap::core::json::Exception>([&] {
+            parser.parse(std::string(2000U, '['));
+        });
+        std::string deep = std::string(500U, '[') + std::string(500U, ']');
+        xap::test::assert_equal<size_t>(
+            parser.parse(deep).array_get_length(),
+            1U,
+            "deep.length != 1"
+        );
+    } catch (xap::core::json::Exception &error) {
+        printf("Throw unexpected XAP JSON error (\"%s\").\n", error.what());
+        xap::test::assert_ok(false, "Throw unexpected XAP JSON error.");
+    } catch (std::exception &error) {
+        printf(
+            "Throw unexpected std::exception error (\"%s\").\n",
+            error.what()
+        );
+        xap::test::assert_ok(false, "Throw unexpected std::exception error.");
+    }
+}
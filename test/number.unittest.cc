@@ -0,0 +1,278 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+//
+//  Imports.
+//
+#include "common.h"
+
+#include <cmath>
+#include <iostream>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <xap/core/json/all.h>
+
+//
+//  Private functions.
+//
+
+/**
+ *  Get the next pseudo-random number (xorshift64).
+ *
+ *  @param state
+ *      The state.
+ *  @return
+ *      The number.
+ */
+static uint64_t next_random(uint64_t &state) {
+    state ^= state << 13U;
+    state ^= state >> 7U;
+    state ^= state << 17U;
+    return state;
+}
+
+/**
+ *  Get the bits of a double.
+ *
+ *  @param value
+ *      The value.
+ *  @return
+ *      The bits.
+ */
+static uint64_t to_bits(const double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+//
+//  Entry.
+//
+
+int main() {
+    //  Real numbers: hand-picked hard cases, then random doubles (printed
+    //  with all or some of their digits) and random decimal numbers.
+    std::vector<std::string> texts = {
+        "0.0", "-0.0", "1.0", "0.1", "-2.5e3", "1E2", "1e-7", "1e22", "1e23",
+        "9007199254740993.0",
+        "9007199254740993.00000000000000000001",
+        "9007199254740992.99999999999999999999",
+        "0.1000000000000000055511151231257827021181583404541015625",
+        "123456789012345678901234567890e-10",
+        "0.000000000000000000000000000000000000012345678901234567890123",
+        "1.7976931348623157e308", "-1.7976931348623157e308",
+        "2.2250738585072014e-308", "2.2250738585072011e-308",
+        "4.9e-324", "2.4703282292062327e-324", "1e-400",
+        "18446744073709551616", "-9223372036854775809",
+        "99999999999999999999", "7.2057594037927933e16",
+        "3.0540412e5", "1.448997445238699", "4.35679577e-90",
+        "2.0000000000000004",
+        "2.00000000000000011102230246251565404236316680908203125"
+    };
+    uint64_t state = UINT64_C(0x9E3779B97F4A7C15);
+    char buffer[64];
+    for (size_t i = 0U; i < 2000U; ++i) {
+        double value;
+        do {
+            const uint64_t bits = next_random(state);
+            memcpy(&value, &bits, sizeof(value));
+        } while (std::isnan(value) || std::isinf(value));
+        snprintf(buffer, sizeof(buffer), "%.17g", value);
+        texts.push_back(buffer);
+        snprintf(
+            buffer,
+            sizeof(buffer),
+            "%.*e",
+            static_cast<int>(next_random(state) % 16U),
+            value
+        );
+        texts.push_back(buffer);
+    }
+    for (size_t i = 0U; i < 2000U; ++i) {
+        std::string text;
+        const size_t digits = 1U + next_random(state) % 28U;
+        for (size_t j = 0U; j < digits; ++j) {
+            const uint64_t digit = (
+                j == 0U ?
+                    1U + next_random(state) % 9U :
+                    next_random(state) % 10U
+            );
+            text.push_back(static_cast<char>('0' + digit));
+        }
+        text.insert(1U + next_random(state) % digits, ".");
+        if (*(text.end() - 1U) == '.') {
+            text.push_back('0');
+        }
+        text += "e" + std::to_string(
+            static_cast<int>(next_random(state) % 640U) - 320
+        );
+        texts.push_back(text);
+    }
+
+    const xap::core::json::Backend backends[] = {
+        xap::core::json::Backend::native,
+        xap::core::json::Backend::lazy
+    };
+    for (const xap::core::json::Backend backend : backends) {
+        try {
+            xap::core::json::Parser parser(backend);
+
+            //  The values are the nearest doubles (the same as strtod()),
+            //  numbers out of range are rejected.
+            std::string data = "[";
+            std::vector<std::string> accepted;
+            std::vector<double> expected;
+            for (const std::string &text : texts) {
+                const double value = strtod(text.c_str(), nullptr);
+                if (std::isinf(value)) {
+                    xap::test::assert_throw<xap::core::json::Exception>([&] {
+                        parser.parse(text);
+                    });
+                    continue;
+                }
+                if (!expected.empty()) {
+                    data += ", ";
+                }
+                data += text;
+                accepted.push_back(text);
+                expected.push_back(value);
+            }
+            data += "]";
+
+            xap::core::json::Traverse root = parser.parse(data);
+            size_t index = 0U;
+            root.array_foreach([&] (xap::core::json::Traverse &item) {
+                const double value = item.inner_as_double();
+                if (to_bits(value) != to_bits(expected[index])) {
+                    printf(
+                        "Mismatched: %s (%.17g != %.17g).\n",
+                        accepted[index].c_str(),
+                        value,
+                        expected[index]
+                    );
+                }
+                xap::test::assert_equal<uint64_t>(
+                    to_bits(value),
+                    to_bits(expected[index]),
+                    "The value is not the nearest double."
+                );
+                ++index;
+            });
+            xap::test::assert_equal<size_t>(
+                index,
+                expected.size(),
+                "Some values were not visited."
+            );
+
+            //  Integers (accumulated 8 digits at a time).
+            xap::core::json::Traverse integers = parser.parse(
+                "[12345678, 123456789012345678, 1234567890123456789, "
+                "12345678901234567890, -1234567890123456789, "
+                "18446744073709551615, 18446744073709551616, "
+                "9223372036854775807, 9223372036854775808, "
+                "-9223372036854775808, -9223372036854775809, 0, -0]"
+            );
+            xap::test::assert_equal<int64_t>(
+                integers.array_pop_item().inner_as_int64(),
+                0,
+                "-0 != 0"
+            );
+            xap::test::assert_equal<int64_t>(
+                integers.array_pop_item().inner_as_int64(),
+                0,
+                "0 != 0"
+            );
+            xap::test::assert_equal<double>(
+                integers.array_pop_item().inner_as_double(),
+                -9223372036854775809.0,
+                "-9223372036854775809"
+            );
+            xap::test::assert_equal<int64_t>(
+                integers.array_pop_item().inner_as_int64(),
+                INT64_MIN,
+                "INT64_MIN"
+            );
+            xap::test::assert_equal<uint64_t>(
+                integers.array_pop_item().inner_as_uint64(),
+                UINT64_C(9223372036854775808),
+                "INT64_MAX + 1"
+            );
+            xap::test::assert_equal<int64_t>(
+                integers.array_pop_item().inner_as_int64(),
+                INT64_MAX,
+                "INT64_MAX"
+            );
+            xap::test::assert_equal<double>(
+                integers.array_pop_item().inner_as_double(),
+                18446744073709551616.0,
+                "UINT64_MAX + 1"
+            );
+            xap::test::assert_equal<uint64_t>(
+                integers.array_pop_item().inner_as_uint64(),
+                UINT64_MAX,
+                "UINT64_MAX"
+            );
+            xap::test::assert_equal<int64_t>(
+                integers.array_pop_item().inner_as_int64(),
+                INT64_C(-1234567890123456789),
+                "-1234567890123456789"
+            );
+            xap::test::assert_equal<uint64_t>(
+                integers.array_pop_item().inner_as_uint64(),
+                UINT64_C(12345678901234567890),
+                "12345678901234567890"
+            );
+            xap::test::assert_equal<int64_t>(
+                integers.array_pop_item().inner_as_int64(),
+                INT64_C(1234567890123456789),
+                "1234567890123456789"
+            );
+            xap::test::assert_equal<int64_t>(
+                integers.array_pop_item().inner_as_int64(),
+                INT64_C(123456789012345678),
+                "123456789012345678"
+            );
+            xap::test::assert_equal<int64_t>(
+                integers.array_pop_item().inner_as_int64(),
+                12345678,
+                "12345678"
+            );
+
+            //  Bad digits within 8-digit groups.
+            const char *invalid[] = {
+                "1234567x",
+                "12345678.1234567x",
+                "123456789012345678901234567890x",
+                "1.123456781234567e",
+                "00000000"
+            };
+            for (const char *text : invalid) {
+                xap::test::assert_throw<xap::core::json::Exception>([&] {
+                    parser.parse(std::string(text));
+                });
+            }
+        } catch (xap::core::json::Exception &error) {
+            printf(
+                "Throw unexpected XAP JSON error (\"%s\").\n",
+                error.what()
+            );
+            xap::test::assert_ok(false, "Throw unexpected XAP JSON error.");
+        } catch (std::exception &error) {
+            printf(
+                "Throw unexpected std::exception error (\"%s\").\n",
+                error.what()
+            );
+            xap::test::assert_ok(
+                false,
+                "Throw unexpected std::exception error."
+            );
+        }
+    }
+}
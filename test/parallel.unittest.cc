@@ -0,0 +1,213 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+//
+//  Imports.
+//
+#include "common.h"
+
+#include <iostream>
+#include <stdint.h>
+#include <string>
+#include <xap/core/json/all.h>
+
+//
+//  Private functions.
+//
+
+/**
+ *  Check an item of the test array.
+ *
+ *  @param item
+ *      The item.
+ *  @param index
+ *      The index of the item.
+ */
+static void check_item(xap::core::json::Traverse &item, const size_t index) {
+    if (index % 10U == 3U) {
+        xap::test::assert_equal<std::string>(
+            item.inner_as_string(),
+            "[scalar, " + std::to_string(index) + "]",
+            "Scalar item mismatched."
+        );
+        return;
+    }
+    if (index % 10U == 6U) {
+        xap::test::assert_equal<size_t>(
+            item.array_get_length(),
+            0U,
+            "Empty item is not empty."
+        );
+        return;
+    }
+    xap::test::assert_equal<int64_t>(
+        item.sub("id").inner_as_int64(),
+        static_cast<int64_t>(index),
+        "id mismatched."
+    );
+    xap::test::assert_equal<std::string>(
+        item.sub("name").inner_as_string(),
+        "item \"" + std::to_string(index) + "\"",
+        "name mismatched."
+    );
+    xap::test::assert_equal<int64_t>(
+        item.at(xap::core::json::Pointer("/values/1")).inner_as_int64(),
+        -static_cast<int64_t>(index),
+        "values[1] mismatched."
+    );
+    xap::test::assert_equal<int64_t>(
+        item.at(xap::core::json::Pointer("/nested/a/0/0")).inner_as_int64(),
+        static_cast<int64_t>(index),
+        "nested.a[0][0] mismatched."
+    );
+    xap::test::assert_equal<size_t>(
+        item.at(xap::core::json::Pointer("/nested/e")).array_get_length(),
+        0U,
+        "nested.e is not empty."
+    );
+}
+
+//
+//  Entry.
+//
+
+int main() {
+    //  A root array (larger than a few ranges) of mixed items.
+    const size_t item_count = 3000U;
+    std::string data = "\xEF\xBB\xBF [";
+    for (size_t i = 0U; i < item_count; ++i) {
+        if (i != 0U) {
+            data += ",\n  ";
+        }
+        if (i % 10U == 3U) {
+            data += "\"[scalar, " + std::to_string(i) + "]\"";
+        } else if (i % 10U == 6U) {
+            data += "[ ]";
+        } else {
+            data += "{\"id\": " + std::to_string(i) +
+                    ", \"name\": \"item \\\"" + std::to_string(i) + "\\\"\"" +
+                    ", \"values\": [" + std::to_string(i) + ", -" +
+                    std::to_string(i) + ", 1.5e2, true, null]" +
+                    ", \"nested\": {\"a\": [[" + std::to_string(i) +
+                    "]], \"e\": []}, \"padding\": \"" +
+                    std::string(100U, '.') + "\"}";
+        }
+    }
+    data += "]\n";
+
+    try {
+        xap::core::json::Parser parser(xap::core::json::Backend::native);
+        xap::test::assert_equal<size_t>(
+            parser.get_workers(),
+            1U,
+            "parser.get_workers() != 1"
+        );
+        parser.set_workers(4U);
+        xap::test::assert_equal<size_t>(
+            parser.get_workers(),
+            4U,
+            "parser.get_workers() != 4"
+        );
+
+        //  The items are parsed in parallel (and stay in order).
+        for (int round = 0; round < 2; ++round) {
+            xap::core::json::Traverse root = parser.parse(data);
+            xap::test::assert_equal<size_t>(
+                root.array_get_length(),
+                item_count,
+                "root.length != item_count"
+            );
+            size_t index = 0U;
+            root.array_foreach([&] (xap::core::json::Traverse &item) {
+                check_item(item, index++);
+            });
+            xap::test::assert_equal<size_t>(
+                index,
+                item_count,
+                "Some items were not visited."
+            );
+        }
+
+        //  Roots other than arrays (and small arrays) are not affected.
+        std::string object = "{\"items\": " + data.substr(3U) + "}";
+        xap::test::assert_equal<size_t>(
+            parser.parse(object).sub("items").array_get_length(),
+            item_count,
+            "items.length != item_count"
+        );
+        xap::test::assert_equal<size_t>(
+            parser.parse(std::string("[1, 2]")).array_get_length(),
+            2U,
+            "[1, 2].length != 2"
+        );
+
+        //  Errors within any range.
+        const size_t positions[] = {
+            data.size() / 7U,
+            data.size() / 2U,
+            data.size() - 1000U
+        };
+        for (const size_t position : positions) {
+            std::string invalid = data;
+            const size_t comma = invalid.find(",\n", position);
+            invalid.insert(comma, ",");
+            xap::test::assert_throw<xap::core::json::Exception>([&] {
+                parser.parse(invalid);
+            });
+
+            invalid = data;
+            const size_t brace = invalid.find("}", position);
+            invalid[brace] = ']';
+            xap::test::assert_throw<xap::core::json::Exception>([&] {
+                parser.parse(invalid);
+            });
+        }
+        xap::test::assert_throw<xap::core::json::Exception>([&] {
+            parser.parse(data + "[]");
+        });
+        xap::test::assert_throw<xap::core::json::Exception>([&] {
+            parser.parse(data.substr(0U, data.size() - 2U));
+        });
+        xap::test::assert_throw<xap::core::json::Exception>([&] {
+            parser.parse(data.substr(0U, data.size() - 2U) + "}");
+        });
+
+        //  Items are still limited in depth (the root array counts).
+        std::string deep = data.substr(0U, data.size() - 2U) + ", " +
+                           std::string(1000U, '[') + std::string(1000U, ']') +
+                           "]";
+        xap::test::assert_throw<xap::core::json::Exception>([&] {
+            parser.parse(deep);
+        });
+        deep = data.substr(0U, data.size() - 2U) + ", " +
+               std::string(999U, '[') + std::string(999U, ']') + "]";
+        xap::test::assert_equal<size_t>(
+            parser.parse(deep).array_get_length(),
+            item_count + 1U,
+            "deep.length != item_count + 1"
+        );
+
+        //  The parser is still usable on one thread.
+        parser.set_workers(1U);
+        xap::core::json::Traverse root = parser.parse(data);
+        size_t index = 0U;
+        root.array_foreach([&] (xap::core::json::Traverse &item) {
+            check_item(item, index++);
+        });
+    } catch (xap::core::json::Exception &error) {
+        printf(
+            "Throw unexpected XAP JSON error (\"%s\").\n",
+            error.what()
+        );
+        xap::test::assert_ok(false, "Throw unexpected XAP JSON error.");
+    } catch (std::exception &error) {
+        printf(
+            "Throw unexpected std::exception error (\"%s\").\n",
+            error.what()
+        );
+        xap::test::assert_ok(false, "Throw unexpected std::exception error.");
+    }
+}
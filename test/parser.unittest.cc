@@ -0,0 +1,82 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+//
+//  Imports.
+//
+#include "common.h"
+
+#include <iostream>
+#include <string>
+#include <xap/core/json/all.h>
+
+//
+//  Entry.
+//
+
+int main() {
+    try {
+        //  A parser can be reused for many documents.
+        xap::core::json::Parser parser;
+        for (int i = 0; i < 16; ++i) {
+            std::string data = "{\"id\": " + std::to_string(i) + "}";
+            xap::core::json::Traverse root = parser.parse(data);
+            xap::test::assert_equal<int>(
+                root.sub("id").inner_as_int(),
+                i,
+                "root.sub(\"id\") != i"
+            );
+        }
+
+        //  Parse errors.
+        try {
+            parser.parse("{\"id\": ", "/message");
+            xap::test::assert_ok(false, "Invalid JSON was parsed.");
+        } catch (xap::core::json::Exception &error) {
+            xap::test::assert_equal<uint16_t>(
+                error.get_code(),
+                xap::core::json::ERROR_PARAMETER,
+                "error.get_code() != ERROR_PARAMETER"
+            );
+            xap::test::assert_equal<std::string>(
+                error.get_path(),
+                "/message",
+                "error.get_path() != \"/message\""
+            );
+        }
+
+        //  The parser is still usable after an error.
+        xap::test::assert_equal<std::string>(
+            parser.parse("[\"a\"]").array_pop_item().inner_as_string(),
+            "a",
+            "parser.parse(\"[\\\"a\\\"]\") != [\"a\"]"
+        );
+
+        //  The default parser of current thread.
+        xap::test::assert_ok(
+            &(xap::core::json::Parser::get_default()) ==
+                &(xap::core::json::Parser::get_default()),
+            "Parser::get_default() is not stable."
+        );
+        xap::test::assert_equal<std::string>(
+            xap::core::json::Parser::get_default()
+                .parse("{\"a\": \"b\"}")
+                .sub("a")
+                .inner_as_string(),
+            "b",
+            "Parser::get_default().parse() != {\"a\": \"b\"}"
+        );
+    } catch (xap::core::json::Exception &error) {
+        printf("Throw unexpected XAP JSON error (\"%s\").\n", error.what());
+        xap::test::assert_ok(false, "Throw unexpected XAP JSON error.");
+    } catch (std::exception &error) {
+        printf(
+            "Throw unexpected std::exception error (\"%s\").\n", 
+            error.what()
+        );
+        xap::test::assert_ok(false, "Throw unexpected std::exception error.");
+    }
+}
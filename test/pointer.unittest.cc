@@ -0,0 +1,254 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+//
+//  Imports.
+//
+#include "common.h"
+
+#include <iostream>
+#include <string>
+#include <xap/core/json/all.h>
+
+//
+//  Private functions.
+//
+
+/**
+ *  Check the error raised by evaluating a pointer.
+ *
+ *  @param root
+ *      The root.
+ *  @param pointer
+ *      The pointer.
+ *  @param code
+ *      The expected error code.
+ *  @param path
+ *      The expected error path.
+ */
+static void assert_pointer_error(
+    xap::core::json::Traverse &root,
+    const std::string &pointer,
+    const uint16_t code,
+    const std::string &path
+) {
+    try {
+        root.at(xap::core::json::Pointer(pointer));
+        printf("Pointer: %s\n", pointer.c_str());
+        xap::test::assert_ok(false, "No error was raised.");
+    } catch (xap::core::json::Exception &error) {
+        printf("Pointer: %s (%s)\n", pointer.c_str(), error.get_path());
+        xap::test::assert_equal<uint16_t>(
+            error.get_code(),
+            code,
+            "error.get_code() != code"
+        );
+        xap::test::assert_equal<std::string>(
+            error.get_path(),
+            path,
+            "error.get_path() != path"
+        );
+    }
+}
+
+//
+//  Entry.
+//
+
+int main() {
+    const char data[] = R"(
+        {
+            "request": {
+                "audio": {"codec": "opus", "rate": 48000},
+                "tracks": [{"id": 1}, {"id": 2}],
+                "nothing": null
+            },
+            "a/b": 1,
+            "m~n": 2,
+            "": 3,
+            "0": 4
+        }
+    )";
+
+    //  Invalid pointers.
+    const char *invalid_pointers[] = {"a", "/a~", "/a~2", "/~/b"};
+    for (const char *pointer : invalid_pointers) {
+        try {
+            xap::core::json::Pointer compiled(pointer);
+            xap::test::assert_ok(false, "Invalid pointer was compiled.");
+        } catch (xap::core::json::Exception &error) {
+            xap::test::assert_equal<uint16_t>(
+                error.get_code(),
+                xap::core::json::ERROR_PARAMETER,
+                "error.get_code() != ERROR_PARAMETER"
+            );
+        }
+    }
+
+    const xap::core::json::Backend backends[] = {
+        xap::core::json::Backend::jsoncpp,
+        xap::core::json::Backend::native
+    };
+    for (const xap::core::json::Backend backend : backends) {
+        try {
+            xap::core::json::Parser parser(backend);
+            xap::core::json::Traverse root = parser.parse(data, sizeof(data));
+
+            //  Compile once, evaluate many times.
+            const xap::core::json::Pointer codec("/request/audio/codec");
+            xap::test::assert_equal<size_t>(
+                codec.get_segment_count(),
+                3U,
+                "codec.get_segment_count() != 3"
+            );
+            for (int i = 0; i < 4; ++i) {
+                xap::core::json::Traverse value = root.at(codec);
+                xap::test::assert_equal<std::string>(
+                    value.inner_as_string(),
+                    "opus",
+                    "/request/audio/codec != \"opus\""
+                );
+                xap::test::assert_equal<std::string>(
+                    value.get_path(),
+                    "/request/audio/codec",
+                    "value.get_path() != \"/request/audio/codec\""
+                );
+            }
+
+            //  Relative to any traverse object.
+            xap::core::json::Traverse request = root.sub("request");
+            xap::test::assert_equal<int>(
+                request.at(xap::core::json::Pointer("/audio/rate"))
+                    .inner_as_int(),
+                48000,
+                "/request/audio/rate != 48000"
+            );
+            xap::test::assert_equal<int>(
+                root.sub("request")
+                    .at(xap::core::json::Pointer("/tracks/1/id"))
+                    .inner_as_int(),
+                2,
+                "/request/tracks/1/id != 2"
+            );
+            xap::test::assert_equal<std::string>(
+                request.at(xap::core::json::Pointer("/tracks/0")).get_path(),
+                "/request/tracks/0",
+                "get_path() != \"/request/tracks/0\""
+            );
+
+            //  Escapes and special keys.
+            xap::test::assert_equal<int>(
+                root.at(xap::core::json::Pointer("/a~1b")).inner_as_int(),
+                1,
+                "/a~1b != 1"
+            );
+            xap::test::assert_equal<int>(
+                root.at(xap::core::json::Pointer("/m~0n")).inner_as_int(),
+                2,
+                "/m~0n != 2"
+            );
+            xap::test::assert_equal<int>(
+                root.at(xap::core::json::Pointer("/")).inner_as_int(),
+                3,
+                "/ != 3"
+            );
+            xap::test::assert_equal<int>(
+                root.at(xap::core::json::Pointer("/0")).inner_as_int(),
+                4,
+                "/0 != 4"
+            );
+            xap::test::assert_ok(
+                root.at(xap::core::json::Pointer("")).type() ==
+                    xap::core::json::Type::object,
+                "\"\" is not the root."
+            );
+            xap::test::assert_ok(
+                root.at(xap::core::json::Pointer("/request/nothing")).is_null(),
+                "/request/nothing is not null."
+            );
+
+            //  Errors.
+            assert_pointer_error(
+                root,
+                "/request/video/codec",
+                xap::core::json::ERROR_NOTFIND,
+                "/request/video"
+            );
+            assert_pointer_error(
+                root,
+                "/request/tracks/2",
+                xap::core::json::ERROR_NOTFIND,
+                "/request/tracks/2"
+            );
+            assert_pointer_error(
+                root,
+                "/request/tracks/01",
+                xap::core::json::ERROR_NOTFIND,
+                "/request/tracks/01"
+            );
+            assert_pointer_error(
+                root,
+                "/request/tracks/-",
+                xap::core::json::ERROR_NOTFIND,
+                "/request/tracks/-"
+            );
+            assert_pointer_error(
+                root,
+                "/request/audio/codec/name",
+                xap::core::json::ERROR_TYPE,
+                "/request/audio/codec"
+            );
+            assert_pointer_error(
+                root,
+                "/request/nothing/name",
+                xap::core::json::ERROR_TYPE,
+                "/request/nothing"
+            );
+
+            //  Optional.
+            xap::core::json::Traverse missing = root.optional_at(
+                xap::core::json::Pointer("/request/nothing/name")
+            );
+            xap::test::assert_ok(missing.is_null(), "missing is not null.");
+            xap::test::assert_equal<std::string>(
+                missing.get_path(),
+                "/request/nothing/name",
+                "missing.get_path() != \"/request/nothing/name\""
+            );
+            xap::test::assert_ok(
+                root.optional_at(
+                    xap::core::json::Pointer("/request/video/codec")
+                ).is_null(),
+                "/request/video/codec is not null."
+            );
+            xap::test::assert_equal<std::string>(
+                root.optional_at(codec).inner_as_string(),
+                "opus",
+                "/request/audio/codec != \"opus\""
+            );
+            xap::test::assert_throw<xap::core::json::Exception>([&] {
+                root.optional_at(
+                    xap::core::json::Pointer("/request/audio/codec/name")
+                );
+            });
+        } catch (xap::core::json::Exception &error) {
+            printf(
+                "Throw unexpected XAP JSON error (\"%s\").\n",
+                error.what()
+            );
+            xap::test::assert_ok(false, "Throw unexpected XAP JSON error.");
+        } catch (std::exception &error) {
+            printf(
+                "Throw unexpected std::exception error (\"%s\").\n",
+                error.what()
+            );
+            xap::test::assert_ok(
+                false,
+                "Throw unexpected std::exception error."
+            );
+        }
+    }
+}
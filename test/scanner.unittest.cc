@@ -0,0 +1,213 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+//
+//  Imports.
+//
+#include "common.h"
+#include "scanner_p.h"
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+//
+//  Private functions.
+//
+
+/**
+ *  Find the tokens byte by byte (reference of the scanner).
+ *
+ *  @param input
+ *      The input.
+ *  @param indices
+ *      The offsets of the tokens.
+ *  @param error_offset
+ *      The offset of the error.
+ *  @return
+ *      True if succeed.
+ */
+static bool reference_scan(
+    const std::string &input,
+    std::vector<uint32_t> &indices,
+    size_t &error_offset
+) {
+    bool in_string = false;
+    bool escaped = false;
+    bool follows_scalar = false;
+    size_t last_quote = 0U;
+    for (size_t i = 0U; i < input.size(); ++i) {
+        const uint8_t ch = static_cast<uint8_t>(input[i]);
+        const bool is_quote = (ch == '"' && !escaped);
+        escaped = (ch == '\\' && !escaped);
+        if (in_string) {
+            if (is_quote) {
+                indices.push_back(static_cast<uint32_t>(i));
+                in_string = false;
+            } else if (ch < 0x20U) {
+                error_offset = i;
+                return false;
+            }
+            follows_scalar = (ch != '"' && ch != ' ' && ch != '\t' &&
+                              ch != '\n' && ch != '\r');
+            continue;
+        }
+        switch (ch) {
+            case '{':
+            case '}':
+            case '[':
+            case ']':
+            case ':':
+            case ',':
+                indices.push_back(static_cast<uint32_t>(i));
+                follows_scalar = false;
+                break;
+            case ' ':
+            case '\t':
+            case '\n':
+            case '\r':
+                follows_scalar = false;
+                break;
+            default:
+                if (is_quote) {
+                    indices.push_back(static_cast<uint32_t>(i));
+                    last_quote = i;
+                    in_string = true;
+                    follows_scalar = false;
+                } else {
+                    if (!follows_scalar) {
+                        indices.push_back(static_cast<uint32_t>(i));
+                    }
+                    follows_scalar = true;
+                }
+                break;
+        }
+    }
+    if (in_string) {
+        error_offset = last_quote;
+        return false;
+    }
+    return true;
+}
+
+//
+//  Entry.
+//
+
+int main() {
+    const xap::core::json::ScannerKernel kernels[] = {
+        xap::core::json::ScannerKernel::scalar,
+        xap::core::json::ScannerKernel::sse42,
+        xap::core::json::ScannerKernel::avx2
+    };
+    //  Control characters are only used in half of the rounds, otherwise
+    //  most of the inputs would be rejected.
+    const std::string alphabet = "{}[]:, \"\\\\ab1\xC3";
+    const std::string control_alphabet = alphabet + "\t\n\x01";
+    size_t accepted = 0U;
+    std::mt19937 random(20221016U);
+    for (const xap::core::json::ScannerKernel kernel : kernels) {
+        if (!xap::core::json::StructuralScanner::is_kernel_supported(kernel)) {
+            printf("Kernel %d is not supported, skipped.\n", kernel);
+            continue;
+        }
+        xap::core::json::StructuralScanner scanner(kernel);
+        xap::test::assert_ok(
+            scanner.get_kernel() == kernel,
+            "scanner.get_kernel() != kernel"
+        );
+
+        for (size_t round = 0U; round < 2000U; ++round) {
+            //  Random input (up to 5 blocks).
+            const std::string &characters = (
+                round % 2U == 0U ? alphabet : control_alphabet
+            );
+            std::string input(random() % 320U, ' ');
+            for (char &ch : input) {
+                ch = characters[random() % characters.size()];
+            }
+
+            std::vector<uint32_t> expected;
+            size_t expected_error = 0U;
+            const bool expected_ok = reference_scan(
+                input,
+                expected,
+                expected_error
+            );
+            bool ok = true;
+            if (round % 3U == 2U) {
+                //  Scan the input in pieces of random sizes.
+                const char *base = input.data();
+                const char *begin = base;
+                size_t received = 0U;
+                scanner.reset();
+                while (ok && received != input.size()) {
+                    received += std::min<size_t>(
+                        random() % 100U,
+                        input.size() - received
+                    );
+                    ok = scanner.feed(base, begin, base + received, &begin);
+                }
+                ok = ok && scanner.finish(base, begin, base + received);
+            } else {
+                ok = scanner.scan(
+                    input.data(),
+                    input.data(),
+                    input.data() + input.size()
+                );
+            }
+            xap::test::assert_equal<bool>(ok, expected_ok, "ok != expected");
+            if (!ok) {
+                xap::test::assert_equal<size_t>(
+                    scanner.get_error_offset(),
+                    expected_error,
+                    "error offset != expected"
+                );
+                continue;
+            }
+            xap::test::assert_equal<size_t>(
+                scanner.get_index_count(),
+                expected.size(),
+                "index count != expected"
+            );
+            const uint32_t *indices = scanner.get_indices();
+            for (size_t i = 0U; i < expected.size(); ++i) {
+                xap::test::assert_equal<uint32_t>(
+                    indices[i],
+                    expected[i],
+                    "index != expected"
+                );
+            }
+            xap::test::assert_equal<uint32_t>(
+                indices[expected.size()],
+                static_cast<uint32_t>(input.size()),
+                "terminator != input size"
+            );
+            ++accepted;
+        }
+    }
+    xap::test::assert_ok(accepted > 1000U, "Too few inputs were accepted.");
+
+    //  Escapes across the block boundary.
+    xap::core::json::StructuralScanner scanner;
+    std::string input = std::string(62U, ' ') + "\"\\\\\\\"\" ";
+    xap::test::assert_ok(
+        scanner.scan(input.data(), input.data(), input.data() + input.size()),
+        "scanner.scan() failed."
+    );
+    xap::test::assert_equal<size_t>(
+        scanner.get_index_count(),
+        2U,
+        "index count != 2"
+    );
+    xap::test::assert_equal<uint32_t>(
+        scanner.get_indices()[1],
+        67U,
+        "closing quote != 67"
+    );
+}
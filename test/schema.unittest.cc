@@ -0,0 +1,387 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+//
+//  Imports.
+//
+#include "common.h"
+
+#include <functional>
+#include <iostream>
+#include <string>
+#include <xap/core/json/all.h>
+
+//
+//  Private functions.
+//
+
+/**
+ *  Build the schema of a message.
+ *
+ *  @return
+ *      The schema.
+ */
+static xap::core::json::Schema make_schema() {
+    xap::core::json::Schema device;
+    device.required(
+        "id",
+        xap::core::json::Type::numeric,
+        xap::core::json::Width::uint32
+    ).optional("name", xap::core::json::Type::string);
+
+    xap::core::json::Schema tag;
+    tag.required("key", xap::core::json::Type::string)
+       .required("value", xap::core::json::Type::null);
+
+    xap::core::json::Schema schema;
+    schema.required(
+        "timestamp",
+        xap::core::json::Type::numeric,
+        xap::core::json::Width::int64
+    ).required(
+        "level",
+        xap::core::json::Type::numeric,
+        xap::core::json::Width::int32
+    ).required("enabled", xap::core::json::Type::boolean)
+     .required("device", xap::core::json::Type::object, device)
+     .optional("tags", xap::core::json::Type::array, tag)
+     .optional("ratio", xap::core::json::Type::numeric)
+     .optional("extra", xap::core::json::Type::object);
+    return schema;
+}
+
+/**
+ *  Check that a schema fails the same way as a chain of checks.
+ *
+ *  @param backend
+ *      The backend.
+ *  @param schema
+ *      The schema.
+ *  @param document
+ *      The document.
+ *  @param chain
+ *      The chain of checks (must throw).
+ *  @param code
+ *      The expected error code.
+ *  @param path
+ *      The expected path of the error.
+ */
+static void check_failure(
+    const xap::core::json::Backend backend,
+    const xap::core::json::Schema &schema,
+    const std::string &document,
+    const std::function<void(xap::core::json::Traverse &)> &chain,
+    const uint16_t code,
+    const std::string &path
+) {
+    xap::core::json::Parser parser(backend);
+    xap::core::json::Traverse root = parser.parse(document);
+
+    //  The chain of checks.
+    std::string chain_message;
+    std::string chain_path;
+    uint16_t chain_code = 0U;
+    try {
+        chain(root);
+    } catch (xap::core::json::Exception &error) {
+        chain_message = error.what();
+        chain_path = error.get_path();
+        chain_code = error.get_code();
+    }
+    xap::test::assert_equal<uint16_t>(chain_code, code, "chain code");
+    xap::test::assert_equal<std::string>(chain_path, path, "chain path");
+
+    //  The schema (throwing).
+    bool thrown = false;
+    try {
+        root.validate(schema);
+    } catch (xap::core::json::Exception &error) {
+        thrown = true;
+        xap::test::assert_equal<std::string>(
+            error.what(),
+            chain_message,
+            "error.what() != chain message"
+        );
+        xap::test::assert_equal<uint16_t>(
+            error.get_code(),
+            code,
+            "error.get_code() != code"
+        );
+        xap::test::assert_equal<std::string>(
+            error.get_path(),
+            path,
+            "error.get_path() != path"
+        );
+    }
+    xap::test::assert_ok(thrown, "validate() doesn't throw.");
+
+    //  The schema (non-throwing).
+    xap::core::json::Status status;
+    xap::test::assert_ok(
+        !root.try_validate(schema, &status),
+        "try_validate() succeeded."
+    );
+    xap::test::assert_equal<uint16_t>(
+        status.get_code(),
+        code,
+        "status.get_code() != code"
+    );
+    xap::test::assert_equal<std::string>(
+        status.get_path(),
+        path,
+        "status.get_path() != path"
+    );
+    xap::test::assert_ok(
+        !root.try_validate(schema),
+        "try_validate() succeeded (without status)."
+    );
+}
+
+//
+//  Entry.
+//
+
+int main() {
+    try {
+        const xap::core::json::Schema schema = make_schema();
+        xap::test::assert_equal<size_t>(
+            schema.get_field_count(),
+            7U,
+            "schema.get_field_count() != 7"
+        );
+
+        const xap::core::json::Backend backends[] = {
+            xap::core::json::Backend::jsoncpp,
+            xap::core::json::Backend::native,
+            xap::core::json::Backend::lazy
+        };
+        for (const xap::core::json::Backend backend : backends) {
+            xap::core::json::Parser parser(backend);
+
+            //  Valid documents.
+            {
+                xap::core::json::Traverse root = parser.parse(
+                    "{\"timestamp\": 1650000000000, \"level\": -2, "
+                    "\"enabled\": true, \"device\": {\"id\": 7}, "
+                    "\"tags\": [{\"key\": \"a\", \"value\": 1}, "
+                    "{\"key\": \"b\", \"value\": [null]}], "
+                    "\"ratio\": 0.5, \"unknown\": \"x\"}"
+                );
+                root.validate(schema);
+                xap::test::assert_ok(
+                    root.try_validate(schema),
+                    "try_validate() failed."
+                );
+
+                //  Optional fields can be null (or non-existed).
+                xap::core::json::Traverse minimal = parser.parse(
+                    "{\"timestamp\": 0, \"level\": 0, \"enabled\": false, "
+                    "\"device\": {\"id\": 0, \"name\": null}, "
+                    "\"tags\": null}"
+                );
+                minimal.validate(schema);
+
+                //  A sub directory.
+                xap::core::json::Schema device;
+                device.required("id", xap::core::json::Type::numeric);
+                root.sub("device").validate(device);
+            }
+
+            //  A required field is non-existed.
+            check_failure(
+                backend,
+                schema,
+                "{\"timestamp\": 1, \"level\": 2, \"enabled\": true}",
+                [] (xap::core::json::Traverse &root) {
+                    root.sub("device");
+                },
+                xap::core::json::ERROR_NOTFIND,
+                "/device"
+            );
+
+            //  A required field is null.
+            check_failure(
+                backend,
+                schema,
+                "{\"timestamp\": null, \"level\": 2}",
+                [] (xap::core::json::Traverse &root) {
+                    root.sub("timestamp").not_null();
+                },
+                xap::core::json::ERROR_TYPE,
+                "/timestamp"
+            );
+
+            //  A field has another type.
+            check_failure(
+                backend,
+                schema,
+                "{\"timestamp\": 1, \"level\": 2, \"enabled\": 1}",
+                [] (xap::core::json::Traverse &root) {
+                    root.sub("enabled").boolean();
+                },
+                xap::core::json::ERROR_TYPE,
+                "/enabled"
+            );
+
+            //  Integer widths.
+            check_failure(
+                backend,
+                schema,
+                "{\"timestamp\": 1, \"level\": 4294967296}",
+                [] (xap::core::json::Traverse &root) {
+                    root.sub("level").integer();
+                },
+                xap::core::json::ERROR_TYPE,
+                "/level"
+            );
+            check_failure(
+                backend,
+                schema,
+                "{\"timestamp\": 1.5}",
+                [] (xap::core::json::Traverse &root) {
+                    root.sub("timestamp").integer();
+                },
+                xap::core::json::ERROR_TYPE,
+                "/timestamp"
+            );
+
+            //  Nested objects.
+            check_failure(
+                backend,
+                schema,
+                "{\"timestamp\": 1, \"level\": 2, \"enabled\": true, "
+                "\"device\": {\"id\": -1}}",
+                [] (xap::core::json::Traverse &root) {
+                    root.sub("device").sub("id").unsigned_integer();
+                },
+                xap::core::json::ERROR_TYPE,
+                "/device/id"
+            );
+            check_failure(
+                backend,
+                schema,
+                "{\"timestamp\": 1, \"level\": 2, \"enabled\": true, "
+                "\"device\": []}",
+                [] (xap::core::json::Traverse &root) {
+                    root.sub("device").object();
+                },
+                xap::core::json::ERROR_TYPE,
+                "/device"
+            );
+
+            //  Array items.
+            check_failure(
+                backend,
+                schema,
+                "{\"timestamp\": 1, \"level\": 2, \"enabled\": true, "
+                "\"device\": {\"id\": 1}, \"tags\": [{\"key\": \"a\", "
+                "\"value\": 1}, {\"key\": \"b\"}]}",
+                [] (xap::core::json::Traverse &root) {
+                    xap::core::json::Pointer pointer("/tags/1/value");
+                    root.at(pointer);
+                },
+                xap::core::json::ERROR_NOTFIND,
+                "/tags/1/value"
+            );
+            check_failure(
+                backend,
+                schema,
+                "{\"timestamp\": 1, \"level\": 2, \"enabled\": true, "
+                "\"device\": {\"id\": 1}, \"tags\": [null]}",
+                [] (xap::core::json::Traverse &root) {
+                    xap::core::json::Pointer pointer("/tags/0/key");
+                    root.at(pointer);
+                },
+                xap::core::json::ERROR_TYPE,
+                "/tags/0"
+            );
+
+            //  The validated object itself.
+            check_failure(
+                backend,
+                schema,
+                "[]",
+                [] (xap::core::json::Traverse &root) {
+                    root.sub("timestamp");
+                },
+                xap::core::json::ERROR_TYPE,
+                "/"
+            );
+        }
+
+        //  Invalid schemas.
+        {
+            xap::core::json::Schema invalid;
+            invalid.required("a", xap::core::json::Type::string);
+            xap::test::assert_throw<xap::core::json::Exception>(
+                [&invalid] () {
+                    invalid.optional("a", xap::core::json::Type::numeric);
+                },
+                "Duplicate field."
+            );
+            xap::test::assert_throw<xap::core::json::Exception>(
+                [&invalid] () {
+                    invalid.required(
+                        "b",
+                        xap::core::json::Type::string,
+                        xap::core::json::Width::int32
+                    );
+                },
+                "Integer width for a string field."
+            );
+            xap::test::assert_throw<xap::core::json::Exception>(
+                [&invalid] () {
+                    invalid.required(
+                        "c",
+                        xap::core::json::Type::numeric,
+                        xap::core::json::Schema()
+                    );
+                },
+                "Nested schema for a numeric field."
+            );
+            xap::test::assert_equal<size_t>(
+                invalid.get_field_count(),
+                1U,
+                "invalid.get_field_count() != 1"
+            );
+        }
+
+        //  Copies share the fields until modified.
+        {
+            xap::core::json::Schema base;
+            base.required("a", xap::core::json::Type::numeric);
+            xap::core::json::Schema extended = base;
+            extended.required("b", xap::core::json::Type::numeric);
+            xap::test::assert_equal<size_t>(
+                base.get_field_count(),
+                1U,
+                "base.get_field_count() != 1"
+            );
+            xap::test::assert_equal<size_t>(
+                extended.get_field_count(),
+                2U,
+                "extended.get_field_count() != 2"
+            );
+
+            //  A schema nested into itself sees its earlier fields only.
+            base.optional("self", xap::core::json::Type::object, base);
+            xap::core::json::Parser parser;
+            xap::core::json::Traverse root = parser.parse(
+                "{\"a\": 1, \"self\": {\"a\": 2, \"self\": 3}}"
+            );
+            root.validate(base);
+        }
+    } catch (xap::core::json::Exception &error) {
+        printf("Throw unexpected XAP JSON error (\"%s\").\n", error.what());
+        xap::test::assert_ok(false, "Throw unexpected XAP JSON error.");
+    } catch (std::exception &error) {
+        printf(
+            "Throw unexpected std::exception error (\"%s\").\n",
+            error.what()
+        );
+        xap::test::assert_ok(false, "Throw unexpected std::exception error.");
+    }
+}
@@ -0,0 +1,213 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+//
+//  Imports.
+//
+#include "common.h"
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <string>
+#include <xap/core/json/all.h>
+
+//
+//  Private functions.
+//
+
+/**
+ *  Feed a document in pieces of random sizes.
+ *
+ *  @param parser
+ *      The parser.
+ *  @param data
+ *      The document.
+ *  @param random
+ *      The random generator.
+ *  @param max_piece
+ *      The maximum size of a piece.
+ *  @return
+ *      False if the parser rejected a piece.
+ */
+static bool feed_pieces(
+    xap::core::json::StreamParser &parser,
+    const std::string &data,
+    std::mt19937 &random,
+    const size_t max_piece
+) {
+    size_t position = 0U;
+    bool ok = true;
+    while (position < data.size()) {
+        const size_t length = std::min<size_t>(
+            1U + random() % max_piece,
+            data.size() - position
+        );
+        ok = parser.feed(data.data() + position, length) && ok;
+        position += length;
+    }
+    return ok;
+}
+
+//
+//  Entry.
+//
+
+int main() {
+    //  A document with strings (and escapes) longer than a scanner block.
+    std::string data = "\xEF\xBB\xBF{\"items\": [";
+    for (int i = 0; i < 200; ++i) {
+        if (i != 0) {
+            data += ", ";
+        }
+        data += "{\"id\": " + std::to_string(i) + ", \"name\": \"item \\\"" +
+                std::to_string(i) + "\\\" " + std::string(i % 90, 'x') +
+                "\", \"tags\": [true, null, -1.5e3]}";
+    }
+    data += "], \"end\": \"\\u00e9\"}";
+
+    const xap::core::json::Backend backends[] = {
+        xap::core::json::Backend::jsoncpp,
+        xap::core::json::Backend::native
+    };
+    std::mt19937 random(20221016U);
+    for (const xap::core::json::Backend backend : backends) {
+        try {
+            xap::core::json::StreamParser parser(backend);
+            const size_t max_pieces[] = {1U, 7U, 64U, 4096U, 65536U};
+            for (const size_t max_piece : max_pieces) {
+                xap::test::assert_ok(
+                    feed_pieces(parser, data, random, max_piece),
+                    "A valid piece was rejected."
+                );
+                xap::test::assert_equal<size_t>(
+                    parser.get_fed_size(),
+                    data.size(),
+                    "parser.get_fed_size() != data.size()"
+                );
+                xap::core::json::Traverse root = parser.finish();
+                xap::test::assert_equal<size_t>(
+                    parser.get_fed_size(),
+                    0U,
+                    "The parser was not reset."
+                );
+
+                xap::core::json::Traverse items = root.sub("items");
+                xap::test::assert_equal<size_t>(
+                    items.array_get_length(),
+                    200U,
+                    "items.length != 200"
+                );
+                int expected_id = 0;
+                items.array_foreach([&] (xap::core::json::Traverse &item) {
+                    xap::test::assert_equal<int>(
+                        item.sub("id").inner_as_int(),
+                        expected_id,
+                        "id != expected"
+                    );
+                    xap::test::assert_equal<std::string>(
+                        item.sub("name").inner_as_string(),
+                        "item \"" + std::to_string(expected_id) + "\" " +
+                            std::string(expected_id % 90, 'x'),
+                        "name != expected"
+                    );
+                    xap::test::assert_equal<double>(
+                        item.at(xap::core::json::Pointer("/tags/2"))
+                            .inner_as_double(),
+                        -1500.0,
+                        "tags[2] != -1500"
+                    );
+                    ++expected_id;
+                });
+                xap::test::assert_equal<std::string>(
+                    root.sub("end").inner_as_string(),
+                    "\xC3\xA9",
+                    "end != \"\\u00e9\""
+                );
+            }
+
+            //  Tiny documents (shorter than the BOM).
+            parser.feed("1", 1U);
+            xap::test::assert_equal<int>(
+                parser.finish().inner_as_int(),
+                1,
+                "1 != 1"
+            );
+            parser.feed("[", 1U);
+            parser.feed("]", 1U);
+            xap::test::assert_equal<size_t>(
+                parser.finish().array_get_length(),
+                0U,
+                "[].length != 0"
+            );
+            xap::test::assert_throw<xap::core::json::Exception>([&] {
+                parser.finish();
+            });
+
+            //  Errors are raised by finish() with the path.
+            std::string invalid = data;
+            invalid[invalid.size() / 2U] = '\x01';
+            feed_pieces(parser, invalid, random, 100U);
+            try {
+                parser.finish("/request");
+                xap::test::assert_ok(false, "Invalid document was parsed.");
+            } catch (xap::core::json::Exception &error) {
+                xap::test::assert_equal<uint16_t>(
+                    error.get_code(),
+                    xap::core::json::ERROR_PARAMETER,
+                    "error.get_code() != ERROR_PARAMETER"
+                );
+                xap::test::assert_equal<std::string>(
+                    error.get_path(),
+                    "/request",
+                    "error.get_path() != \"/request\""
+                );
+            }
+            if (backend == xap::core::json::Backend::native) {
+                //  Control characters within strings are found early.
+                parser.reserve(invalid.size());
+                xap::test::assert_ok(
+                    !parser.feed(invalid.data(), invalid.size() - 1U),
+                    "The invalid piece was accepted."
+                );
+                xap::test::assert_ok(
+                    !parser.feed(invalid.data(), 1U),
+                    "A piece was accepted after an invalid one."
+                );
+                parser.reset();
+            }
+            xap::test::assert_throw<xap::core::json::Exception>([&] {
+                parser.feed("{\"a\": [1, 2}", 12U);
+                parser.finish();
+            });
+
+            //  The parser is reusable after failures.
+            parser.feed("{\"a\": ", 6U);
+            parser.reset();
+            parser.feed("{\"b\": 2}", 8U);
+            xap::test::assert_equal<int>(
+                parser.finish().sub("b").inner_as_int(),
+                2,
+                "b != 2"
+            );
+        } catch (xap::core::json::Exception &error) {
+            printf(
+                "Throw unexpected XAP JSON error (\"%s\").\n",
+                error.what()
+            );
+            xap::test::assert_ok(false, "Throw unexpected XAP JSON error.");
+        } catch (std::exception &error) {
+            printf(
+                "Throw unexpected std::exception error (\"%s\").\n",
+                error.what()
+            );
+            xap::test::assert_ok(
+                false,
+                "Throw unexpected std::exception error."
+            );
+        }
+    }
+}
@@ -10,13 +10,26 @@
 #include "common.h"
 
 #include <iostream>
+#include <string>
+#include <vector>
 #include <xap/core/json/all.h>
 
 //
 //  Entry.
 //
 
-int main() {
+int main(int argc, char *argv[]) {
+    //  Run with the given backend ("jsoncpp" by default).
+    if (argc > 1 && std::string(argv[1]) == "native") {
+        xap::core::json::Parser::set_default_backend(
+            xap::core::json::Backend::native
+        );
+    } else if (argc > 1 && std::string(argv[1]) == "lazy") {
+        xap::core::json::Parser::set_default_backend(
+            xap::core::json::Backend::lazy
+        );
+    }
+
     const char data[] = R"(
         {
             "a": "b",
@@ -129,6 +142,181 @@ int main() {
             "i_a != 123"
         );
 
+        //  String views refer to the document.
+        xap::core::json::StringView i_a_view = root.sub("i")
+                                                   .sub("a")
+                                                   .inner_as_string_view();
+        xap::test::assert_ok(i_a_view == "123", "i_a_view != 123");
+        xap::test::assert_ok(
+            i_a_view == std::string("123"),
+            "i_a_view != std::string(\"123\")"
+        );
+        xap::test::assert_ok(i_a_view != "12", "i_a_view == 12");
+        xap::test::assert_equal<std::string>(
+            i_a_view.to_string(),
+            "123",
+            "i_a_view.to_string() != 123"
+        );
+        xap::test::assert_ok(
+            root.sub("i").sub("a").inner_as_string_view().data() ==
+                root.sub("i").sub("a").inner_as_string_view().data(),
+            "inner_as_string_view() copied the string."
+        );
+        xap::test::assert_throw<xap::core::json::Exception>([&] {
+            root.sub("c").inner_as_string_view();
+        });
+        xap::test::assert_throw<xap::core::json::Exception>([&] {
+            xap::core::json::Traverse::null().inner_as_string_view();
+        });
+
+        //  Non-throwing methods report the errors of the throwing ones.
+        xap::core::json::Status status;
+        int c = 0;
+        xap::test::assert_ok(
+            root.sub("c").try_inner_as_int(&c, &status) && c == 12,
+            "try_inner_as_int(c) != 12"
+        );
+        xap::test::assert_ok(status.is_ok(), "status is not ok.");
+        xap::test::assert_ok(
+            !root.sub("d").try_inner_as_int(&c, &status),
+            "try_inner_as_int(d) succeeded."
+        );
+        xap::test::assert_equal<uint16_t>(
+            status.get_code(),
+            xap::core::json::ERROR_TYPE,
+            "status.get_code() != ERROR_TYPE"
+        );
+        xap::test::assert_equal<std::string>(
+            status.get_path(),
+            "/d",
+            "status.get_path() != \"/d\""
+        );
+        try {
+            root.sub("d").inner_as_int();
+            xap::test::assert_ok(false, "inner_as_int(d) succeeded.");
+        } catch (xap::core::json::Exception &error) {
+            xap::test::assert_equal<std::string>(
+                status.what(),
+                error.what(),
+                "status.what() != error.what()"
+            );
+        }
+        xap::test::assert_throw<xap::core::json::Exception>([&] {
+            status.raise();
+        });
+
+        xap::core::json::Traverse sub_i_a = root;
+        xap::test::assert_ok(
+            !root.sub("i").try_sub("b", &sub_i_a, &status),
+            "try_sub(i/b) succeeded."
+        );
+        xap::test::assert_equal<uint16_t>(
+            status.get_code(),
+            xap::core::json::ERROR_NOTFIND,
+            "status.get_code() != ERROR_NOTFIND"
+        );
+        xap::test::assert_equal<std::string>(
+            status.get_path(),
+            "/i/b",
+            "status.get_path() != \"/i/b\""
+        );
+        xap::test::assert_equal<std::string>(
+            sub_i_a.get_path(),
+            "/",
+            "try_sub() changed the output on failure."
+        );
+        xap::test::assert_ok(
+            root.try_sub("i", &sub_i_a, &status) && 
+                sub_i_a.try_sub("a", &sub_i_a, &status),
+            "try_sub(i/a) failed."
+        );
+        std::string i_a_string;
+        xap::test::assert_ok(
+            sub_i_a.try_inner_as_string(&i_a_string) && i_a_string == "123",
+            "try_inner_as_string(i/a) != \"123\""
+        );
+        xap::test::assert_equal<std::string>(
+            sub_i_a.get_path(),
+            "/i/a",
+            "sub_i_a.get_path() != \"/i/a\""
+        );
+        xap::test::assert_ok(
+            !root.sub("c").try_sub("a", &sub_i_a, &status) &&
+                status.get_code() == xap::core::json::ERROR_TYPE,
+            "try_sub(c/a) didn't fail with ERROR_TYPE."
+        );
+        xap::test::assert_ok(
+            !xap::core::json::Traverse::null().try_not_null(&status) &&
+                status.get_code() == xap::core::json::ERROR_TYPE,
+            "try_not_null(null) didn't fail with ERROR_TYPE."
+        );
+
+        size_t j_length = 0U;
+        uint e = 0U;
+        bool h = true;
+        double f = 0.0;
+        xap::core::json::StringView b_view;
+        xap::test::assert_ok(
+            root.sub("j").try_array_get_length(&j_length) && j_length == 5U &&
+                root.sub("h").try_inner_as_boolean(&h) && !h &&
+                root.sub("f").try_inner_as_double(&f) && f == 1.0 &&
+                root.sub("b").try_inner_as_string_view(&b_view) &&
+                b_view == "123123",
+            "Non-throwing accessors failed."
+        );
+        xap::test::assert_ok(
+            !root.sub("a").try_array_get_length(&j_length) &&
+                !root.sub("a").try_inner_as_boolean(&h) &&
+                !root.sub("a").try_inner_as_double(&f) &&
+                !root.sub("c").try_inner_as_string_view(&b_view) &&
+                !root.sub("e").try_inner_as_uint(&e),
+            "Non-throwing accessors succeeded."
+        );
+
+        xap::core::json::Traverse j_2 = root;
+        xap::test::assert_ok(
+            root.try_at(xap::core::json::Pointer("/j/2"), &j_2, &status) &&
+                j_2.inner_as_int() == 3,
+            "try_at(/j/2) != 3"
+        );
+        xap::test::assert_ok(
+            !root.try_at(xap::core::json::Pointer("/j/9"), &j_2, &status),
+            "try_at(/j/9) succeeded."
+        );
+        xap::test::assert_equal<std::string>(
+            status.get_path(),
+            "/j/9",
+            "status.get_path() != \"/j/9\""
+        );
+        status.clear();
+        xap::test::assert_ok(status.is_ok(), "status is not cleared.");
+
+        //  A status reused across calls reports the last call only.
+        xap::test::assert_ok(
+            !root.try_at(xap::core::json::Pointer("/j/9"), &j_2, &status),
+            "try_at(/j/9) succeeded."
+        );
+        xap::test::assert_ok(
+            root.sub("c").try_inner_as_int(&c, &status),
+            "try_inner_as_int(c) failed."
+        );
+        xap::test::assert_ok(status.is_ok(), "status is not reset.");
+        xap::test::assert_equal<uint16_t>(
+            status.get_code(),
+            0U,
+            "status.get_code() != 0"
+        );
+        xap::test::assert_equal<std::string>(
+            status.what(),
+            "",
+            "status.what() != \"\""
+        );
+        xap::test::assert_equal<std::string>(
+            status.get_path(),
+            "",
+            "status.get_path() != \"\""
+        );
+
         int j_test = 1;
         root.sub("j")
             .not_null()
@@ -223,6 +411,97 @@ int main() {
             "xap::core::json::Traverse::null(\"/a/b/c\").get_path() != "
             "\"/a/b/c\""
         );
+
+        //  Paths.
+        xap::test::assert_equal<std::string>(
+            root.sub("i").sub("a").get_path(),
+            "/i/a",
+            "root.sub(\"i\").sub(\"a\").get_path() != \"/i/a\""
+        );
+        std::string j_last_path;
+        root.sub("j").array_foreach([&] (xap::core::json::Traverse &item) {
+            j_last_path = item.get_path();
+        });
+        xap::test::assert_equal<std::string>(
+            j_last_path,
+            "/j/4",
+            "Path of the last item of \"j\" != \"/j/4\""
+        );
+        xap::test::assert_equal<std::string>(
+            xap::core::json::Traverse(data, sizeof(data), "/body")
+                .sub("i")
+                .get_path(),
+            "/body/i",
+            "Path of \"i\" (with prefix \"/body\") != \"/body/i\""
+        );
+        try {
+            root.sub("i").sub("fake_key");
+            xap::test::assert_ok(false, "root.sub(\"i\").sub(\"fake_key\")");
+        } catch (xap::core::json::Exception &error) {
+            xap::test::assert_equal<std::string>(
+                error.get_path(),
+                "/i/fake_key",
+                "Path of the error != \"/i/fake_key\""
+            );
+        }
+
+        //  Move & assignment.
+        std::vector<xap::core::json::Traverse> items;
+        root.sub("j").array_foreach([&] (xap::core::json::Traverse &item) {
+            items.push_back(std::move(item));
+        });
+        xap::test::assert_equal<int>(
+            items[2].inner_as_int(),
+            3,
+            "items[2] != 3"
+        );
+        xap::core::json::Traverse assigned = xap::core::json::Traverse::null();
+        assigned = items[4];
+        xap::test::assert_equal<std::string>(
+            assigned.get_path(),
+            "/j/4",
+            "assigned.get_path() != \"/j/4\""
+        );
+        assigned = root.sub("i").sub("a");
+        xap::test::assert_equal<std::string>(
+            assigned.inner_as_string(),
+            "123",
+            "assigned.inner_as_string() != \"123\""
+        );
+        xap::test::assert_equal<std::string>(
+            root.sub("i").sub("a").get_path(),
+            "/i/a",
+            "root.sub(\"i\").sub(\"a\").get_path() != \"/i/a\""
+        );
+
+        //  Sub directories share the document, modifiers copy on write.
+        xap::core::json::Traverse i_view = root.sub("i");
+        i_view.object_set("b", xap::core::json::Traverse("7"));
+        xap::test::assert_equal<int>(
+            i_view.sub("b").inner_as_int(),
+            7,
+            "i_view.sub(\"b\") != 7"
+        );
+        xap::test::assert_throw<xap::core::json::Exception>([&] {
+            root.sub("i").sub("b");
+        }, "Modifying a sub directory changed its parent.");
+
+        xap::core::json::Traverse j_view = root.sub("j");
+        xap::test::assert_equal<int>(
+            j_view.array_pop_item().inner_as_int(),
+            5,
+            "j_view.array_pop_item() != 5"
+        );
+        xap::test::assert_equal<size_t>(
+            j_view.array_get_length(),
+            4U,
+            "j_view.array_get_length() != 4"
+        );
+        xap::test::assert_equal<size_t>(
+            root.sub("j").array_get_length(),
+            5U,
+            "root.sub(\"j\").array_get_length() != 5"
+        );
     } catch (xap::core::json::Exception &error) {
         printf("Throw unexpected XAP JSON error (\"%s\").\n", error.what());
         xap::test::assert_ok(false, "Throw unexpected XAP JSON error.");
@@ -0,0 +1,356 @@
+//
+//  Copyright 2019 - 2022 The XOrange Studio. All rights reserved.
+//  Use of this source code is governed by a BSD-style license that can be
+//  found in the LICENSE.md file.
+//
+
+//
+//  Imports.
+//
+#include "common.h"
+#include "scanner_p.h"
+#include "utf8_p.h"
+
+#include <algorithm>
+#include <iostream>
+#include <random>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <xap/core/json/all.h>
+
+//
+//  Private functions.
+//
+
+/**
+ *  Find the first invalid character by decoding code points (reference of
+ *  the validator).
+ *
+ *  @param input
+ *      The input.
+ *  @return
+ *      The offset of the first invalid character (input.size() if none).
+ */
+static size_t reference_find_error(const std::string &input) {
+    size_t position = 0U;
+    while (position < input.size()) {
+        const uint8_t lead = static_cast<uint8_t>(input[position]);
+        size_t length;
+        uint32_t code_point;
+        uint32_t minimum;
+        if (lead < 0x80U) {
+            ++position;
+            continue;
+        } else if ((lead & 0xE0U) == 0xC0U) {
+            length = 2U;
+            code_point = lead & 0x1FU;
+            minimum = 0x80U;
+        } else if ((lead & 0xF0U) == 0xE0U) {
+            length = 3U;
+            code_point = lead & 0x0FU;
+            minimum = 0x800U;
+        } else if ((lead & 0xF8U) == 0xF0U) {
+            length = 4U;
+            code_point = lead & 0x07U;
+            minimum = 0x10000U;
+        } else {
+            return position;
+        }
+        if (position + length > input.size()) {
+            return position;
+        }
+        for (size_t i = 1U; i < length; ++i) {
+            const uint8_t ch = static_cast<uint8_t>(input[position + i]);
+            if ((ch & 0xC0U) != 0x80U) {
+                return position;
+            }
+            code_point = (code_point << 6U) | (ch & 0x3FU);
+        }
+        if (
+            code_point < minimum ||
+            code_point > 0x10FFFFU ||
+            (code_point >= 0xD800U && code_point <= 0xDFFFU)
+        ) {
+            return position;
+        }
+        position += length;
+    }
+    return input.size();
+}
+
+/**
+ *  Validate an input with a validator, in pieces of random sizes.
+ *
+ *  @param validator
+ *      The validator.
+ *  @param input
+ *      The input.
+ *  @param random
+ *      The random number generator.
+ *  @return
+ *      True if the input is valid.
+ */
+static bool validate_in_pieces(
+    xap::core::json::Utf8Validator &validator,
+    const std::string &input,
+    std::mt19937 &random
+) {
+    const uint8_t *data = reinterpret_cast<const uint8_t *>(input.data());
+    const size_t block_count = input.size() / 64U;
+    validator.reset();
+    size_t position = 0U;
+    while (position < block_count) {
+        const size_t count = std::min<size_t>(
+            random() % 3U,
+            block_count - position
+        );
+        if (!validator.feed(data + position * 64U, count)) {
+            return false;
+        }
+        position += count;
+    }
+
+    if (input.size() % 64U != 0U) {
+        uint8_t padded[64];
+        memset(padded, ' ', sizeof(padded));
+        memcpy(padded, data + block_count * 64U, input.size() % 64U);
+        if (!validator.feed(padded, 1U)) {
+            return false;
+        }
+    }
+    return validator.finish();
+}
+
+//
+//  Entry.
+//
+
+int main() {
+    //  Whole characters (valid) and stray bytes (mostly invalid).
+    const std::vector<std::string> characters = {
+        "a", "\"", "\xC2\x80", "\xC3\xA9", "\xDF\xBF", "\xE0\xA0\x80",
+        "\xE2\x82\xAC", "\xED\x9F\xBF", "\xEE\x80\x80", "\xEF\xBF\xBF",
+        "\xF0\x90\x80\x80", "\xF0\x9F\x98\x80", "\xF3\xBF\xBF\xBF",
+        "\xF4\x8F\xBF\xBF"
+    };
+    const uint8_t stray_bytes[] = {
+        0x80U, 0x8FU, 0x90U, 0x9FU, 0xA0U, 0xBFU, 0xC0U, 0xC1U, 0xC2U,
+        0xDFU, 0xE0U, 0xEDU, 0xEFU, 0xF0U, 0xF4U, 0xF5U, 0xFFU
+    };
+    const xap::core::json::ScannerKernel kernels[] = {
+        xap::core::json::ScannerKernel::scalar,
+        xap::core::json::ScannerKernel::sse42,
+        xap::core::json::ScannerKernel::avx2
+    };
+    size_t accepted = 0U;
+    std::mt19937 random(20221016U);
+    for (const xap::core::json::ScannerKernel kernel : kernels) {
+        if (!xap::core::json::StructuralScanner::is_kernel_supported(kernel)) {
+            printf("Kernel %d is not supported, skipped.\n", kernel);
+            continue;
+        }
+        xap::core::json::Utf8Validator validator(kernel);
+        xap::test::assert_ok(
+            validator.get_kernel() == kernel,
+            "validator.get_kernel() != kernel"
+        );
+
+        for (size_t round = 0U; round < 1000U; ++round) {
+            //  Random input (up to about 5 blocks, long ASCII runs in some
+            //  rounds), with a stray byte in half of the rounds.
+            std::string input;
+            const size_t length = random() % 320U;
+            while (input.size() < length) {
+                if (round % 4U == 1U && random() % 8U != 0U) {
+                    input.append(random() % 64U, 'a');
+                }
+                input += characters[random() % characters.size()];
+            }
+            if (round % 2U == 0U) {
+                const size_t position = random() % (input.size() + 1U);
+                input.insert(
+                    input.begin() + position,
+                    static_cast<char>(
+                        stray_bytes[random() % sizeof(stray_bytes)]
+                    )
+                );
+            }
+
+            const size_t expected = reference_find_error(input);
+            const bool ok = validate_in_pieces(validator, input, random);
+            if (ok != (expected == input.size())) {
+                printf(
+                    "Mismatched (kernel %d, round %zu, error at %zu).\n",
+                    kernel,
+                    round,
+                    expected
+                );
+            }
+            xap::test::assert_equal<bool>(
+                ok,
+                expected == input.size(),
+                "ok != expected"
+            );
+            const uint8_t *data = reinterpret_cast<const uint8_t *>(
+                input.data()
+            );
+            xap::test::assert_equal<size_t>(
+                static_cast<size_t>(
+                    xap::core::json::Utf8Validator::find_error(
+                        data,
+                        data + input.size()
+                    ) - data
+                ),
+                expected,
+                "find_error() != expected"
+            );
+            if (ok) {
+                ++accepted;
+            }
+        }
+    }
+    xap::test::assert_ok(accepted > 500U, "Too few inputs were accepted.");
+
+    //  Invalid sequences within strings, at block and batch boundaries.
+    const char *invalid_sequences[] = {
+        "\xC0\xAF",             //  Overlong '/'.
+        "\xE0\x9F\xBF",         //  Overlong U+07FF.
+        "\xF0\x8F\xBF\xBF",     //  Overlong U+FFFF.
+        "\xED\xA0\x80",         //  Surrogate U+D800.
+        "\xF4\x90\x80\x80",     //  U+110000.
+        "\xC3",                 //  Truncated.
+        "\xE2\x82",             //  Truncated.
+        "\xA9",                 //  Stray continuation.
+        "\xC3\xA9\xA9",         //  Stray continuation.
+        "\xFF"
+    };
+    const size_t offsets[] = {0U, 61U, 62U, 63U, 64U, 4094U, 4095U};
+    const xap::core::json::Backend backends[] = {
+        xap::core::json::Backend::jsoncpp,
+        xap::core::json::Backend::native,
+        xap::core::json::Backend::lazy
+    };
+    try {
+        //  The constructors of xap::core::json::Traverse validate the input
+        //  if the default parser does.
+        xap::test::assert_ok(
+            !xap::core::json::Parser::get_default_utf8_validation(),
+            "UTF-8 validation is enabled by default."
+        );
+        xap::core::json::Parser::set_default_utf8_validation(true);
+        const std::string invalid_root = "[\"\xED\xA0\x80\"]";
+        xap::test::assert_throw<xap::core::json::Exception>([&] {
+            xap::core::json::Traverse root(
+                reinterpret_cast<const uint8_t *>(invalid_root.data()),
+                invalid_root.size()
+            );
+        });
+        const std::string valid_root = "[\"\xF0\x9F\x98\x80\"]";
+        xap::test::assert_equal<std::string>(
+            xap::core::json::Traverse(
+                reinterpret_cast<const uint8_t *>(valid_root.data()),
+                valid_root.size()
+            ).array_pop_item().inner_as_string(),
+            "\xF0\x9F\x98\x80",
+            "valid_root[0] mismatched."
+        );
+        xap::core::json::StreamParser stream;
+        stream.feed(invalid_root.data(), invalid_root.size());
+        xap::test::assert_throw<xap::core::json::Exception>([&] {
+            stream.finish();
+        });
+        xap::core::json::Parser::set_default_utf8_validation(false);
+
+        for (const xap::core::json::Backend backend : backends) {
+            xap::core::json::Parser parser(backend);
+            xap::test::assert_ok(
+                !parser.get_utf8_validation(),
+                "parser.get_utf8_validation() is true."
+            );
+
+            //  Not validated (bytes are copied as is).
+            const std::string unchecked = std::string("\"") +
+                                          invalid_sequences[3] + "\"";
+            xap::test::assert_equal<std::string>(
+                parser.parse(unchecked).inner_as_string(),
+                invalid_sequences[3],
+                "Unchecked string mismatched."
+            );
+
+            parser.set_utf8_validation(true);
+            xap::test::assert_ok(
+                parser.get_utf8_validation(),
+                "parser.get_utf8_validation() is false."
+            );
+            for (const size_t offset : offsets) {
+                //  The string starts at the offset (after a padding string).
+                const std::string prefix = (
+                    offset == 0U ?
+                        "" :
+                        "[\"" + std::string(offset - 6U, '.') + "\", "
+                ) + "\"";
+                const std::string suffix = offset == 0U ? "\"" : "\"]";
+                const std::string text = "\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80";
+                xap::core::json::Traverse root = parser.parse(
+                    prefix + text + suffix
+                );
+                if (offset != 0U) {
+                    root = root.array_pop_item();
+                }
+                xap::test::assert_equal<std::string>(
+                    root.inner_as_string(),
+                    text,
+                    "Valid string mismatched."
+                );
+
+                for (const char *sequence : invalid_sequences) {
+                    const std::string invalid = prefix + sequence + suffix;
+                    try {
+                        parser.parse(invalid, "/invalid");
+                        xap::test::assert_ok(
+                            false,
+                            "Invalid UTF-8 was accepted."
+                        );
+                    } catch (xap::core::json::Exception &error) {
+                        const std::string expected = "Offset " +
+                            std::to_string(reference_find_error(invalid)) +
+                            "\n";
+                        xap::test::assert_ok(
+                            std::string(error.what()).find(
+                                expected
+                            ) != std::string::npos,
+                            "The error offset mismatched."
+                        );
+                        xap::test::assert_equal<std::string>(
+                            error.get_path(),
+                            "/invalid",
+                            "error.get_path() != \"/invalid\""
+                        );
+                    }
+                }
+            }
+
+            //  The UTF-8 BOM and a character that ends the input.
+            xap::test::assert_equal<int>(
+                parser.parse(std::string("\xEF\xBB\xBF 1")).inner_as_int(),
+                1,
+                "BOM: root != 1"
+            );
+            xap::test::assert_throw<xap::core::json::Exception>([&] {
+                parser.parse(std::string(63U, ' ') + "1\xC3");
+            });
+        }
+    } catch (xap::core::json::Exception &error) {
+        printf("Throw unexpected XAP JSON error (\"%s\").\n", error.what());
+        xap::test::assert_ok(false, "Throw unexpected XAP JSON error.");
+    } catch (std::exception &error) {
+        printf(
+            "Throw unexpected std::exception error (\"%s\").\n",
+            error.what()
+        );
+        xap::test::assert_ok(false, "Throw unexpected std::exception error.");
+    }
+}